@@ -83,12 +83,21 @@
 
 #define SKYBOX 512
 
+// Milliseconds between checks for edited shader files, 0 disables shader hot reload
+#define SHADER_WATCH_INTERVAL 1000.0
+
+// Texture residency budget in MB, 0 disables eviction
+#define TEXTURE_BUDGET 512
+
 #define SHADOW_WIDTH 1024
 #define SHADOW_HEIGHT 1024
 #define SHADOW_ZNEAR 1.0
 #define SHADOW_ZFAR 2000.0
 #define SHADOW_ORTH_BOX 1000.0
 
+// must match NUMBER_OF_POINT_LIGHTS in the lighting shaders
+#define NUMBER_OF_POINT_LIGHTS 10
+
 // Default camera values
 #define SPEED 50.0f
 #define SPEEDRATIO 0.025f
@@ -0,0 +1,15 @@
+//
+//  CullingBase.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+#pragma once
+
+#ifndef CullingBase_h
+#define CullingBase_h
+
+#include "Common.h"
+
+#endif /* CullingBase_h */
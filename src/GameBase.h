@@ -40,5 +40,12 @@
 #include "objects/TorusKnot.h"
 #include "objects/Metaballs.h"
 #include "objects/Quad.h"
+#include "scene/SceneStore.h"
+#include "scene/SceneLoader.h"
+#include "scene/Material.h"
+#include "scene/ScenePipeline.h"
+#include "culling/FrustumCuller.h"
+#include "culling/OcclusionCuller.h"
+#include "culling/IndirectCuller.h"
 
 #endif /* GameBase_h */
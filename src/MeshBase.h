@@ -13,6 +13,7 @@
 #include "texture/Texture.h"
 #include "shaders/ShaderProgram.h"
 #include "utilities/Vertex.h"
+#include "buffers/InstanceBuffer.h"
 #include "interfaces/IGameObject.h"
 
 #endif /* MeshBase_h */
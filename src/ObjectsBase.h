@@ -15,6 +15,8 @@
 #include "shaders/ShaderProgram.h"
 #include "buffers/VertexBufferObject.h"
 #include "buffers/VertexBufferObjectIndexed.h"
+#include "buffers/InstanceBuffer.h"
+#include "buffers/GeometryArena.h"
 #include "interfaces/IGameObject.h"
 #include "utilities/Vertex.h"
 #include "utilities/Extensions.h"
@@ -0,0 +1,18 @@
+//
+//  SceneBase.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+#pragma once
+
+#ifndef SceneBase_h
+#define SceneBase_h
+
+#include "Common.h"
+#include "utilities/TextureType.h"
+#include "utilities/SceneFlag.h"
+#include "interfaces/IGameObject.h"
+
+#endif /* SceneBase_h */
@@ -1,4 +1,5 @@
 #include "FrameBufferObject.h"
+#include "../window/GLState.h"
 
 // https://learnopengl.com/#!Advanced-OpenGL/Framebuffers
 // https://learnopengl.com/#!Advanced-OpenGL/Anti-Aliasing
@@ -15,6 +16,9 @@ CFrameBufferObject::CFrameBufferObject()
     m_uiAlbedoSpecTexture = 0;
     m_uiRboDepthStencil = 0;
     m_uiRboDepth = 0;
+    m_uiNormalTexture = 0;
+    m_uiSampler = 0;
+    m_fboType = FrameBufferType::Default;
     
     for (unsigned int i = 0; i < 2; i++){
         m_uiHdrColorTextures[i] = 0;
@@ -36,6 +40,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
 {
     m_iWidth = a_iWidth;
     m_iHeight = a_iHeight;
+    m_fboType = fboType;
         
     /// The framebuffer, which regroups 0, 1, or more textures, and 0 or 1 depth buffer.
     if(m_uiFramebuffer != 0) return false;
@@ -56,13 +61,13 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenFramebuffers(1, &m_uiFramebuffer);
             
             // attach depth texture as FBO's depth buffer
-            glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
             
             // create depth texture
             // Depth texture for Shadow Mapping https://learnopengl.com/#!Advanced-Lighting/Shadows/Shadow-Mapping
             // we create a 2D texture that we'll use as the framebuffer's depth buffer:
             glGenTextures(1, &m_uiDepthTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiDepthTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiDepthTexture);
             
             //We give the texture a width and height of 1024: this is the resolution of the depth map.
             glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
@@ -87,7 +92,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 std::cout << "ERROR::FRAMEBUFFER:: Depth Mapping Framebuffer is not complete!" << std::endl;
             }
             
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             
             return depthMapFramebufferComplete;
         }
@@ -99,13 +104,13 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenFramebuffers(1, &m_uiFramebuffer);
             
             // attach depth texture as FBO's depth buffer
-            glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
             
             // create depth texture
             // Depth texture for Shadow Mapping https://learnopengl.com/#!Advanced-Lighting/Shadows/Shadow-Mapping
             // we create a 2D texture that we'll use as the framebuffer's depth buffer:
             glGenTextures(1, &m_uiDepthTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiDepthTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiDepthTexture);
             
             //We give the texture a width and height of 1024: this is the resolution of the depth map.
             glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
@@ -132,7 +137,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 std::cout << "ERROR::FRAMEBUFFER:: Depth Mapping Framebuffer is not complete!" << std::endl;
             }
             
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             
             return directionalShadowMapFramebufferComplete;
         }
@@ -148,7 +153,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             // cubemap Depth texture for point Shadow Mapping https://learnopengl.com/code_viewer_gh.php?code=src/5.advanced_lighting/3.2.1.point_shadows/point_shadows.cpp
             
             glGenTextures(1, &m_uiDepthCubeMap);
-            glBindTexture(GL_TEXTURE_CUBE_MAP, m_uiDepthCubeMap);
+            CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, m_uiDepthCubeMap);
             
             for (unsigned int i = 0; i < 6; ++i) {
                 glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
@@ -162,7 +167,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             SetSamplerObjectParameter(GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
             
             // attach depth texture as FBO's depth buffer
-            glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
             glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_uiDepthCubeMap, 0);
             
             glDrawBuffer(GL_NONE);
@@ -174,7 +179,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 std::cout << "ERROR::FRAMEBUFFER:: Cube Map Shadow Mapping Framebuffer is not complete!" << std::endl;
             }
             
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             
             return omnidirectionalShadowMapFramebufferComplete;
         }
@@ -200,11 +205,11 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenFramebuffers(1, &m_uiFramebuffer);
             
             // To bind the framebuffer we use glBindFramebuffer:
-            glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
             
             // create floating point color buffer
             glGenTextures(1, &m_uiHdrColorTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiHdrColorTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiHdrColorTexture);
             
             /*
              When the internal format of a framebuffer's colorbuffer is specified as GL_RGB16F, GL_RGBA16F, GL_RGB32F or GL_RGBA32F the framebuffer is known as a floating point framebuffer that can store floating point values outside the default range of 0.0 and 1.0. This is perfect for rendering in high dynamic range!
@@ -219,7 +224,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
             SetSamplerObjectParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             SetSamplerObjectParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             
             // create depth buffer (renderbuffer)
             glGenRenderbuffers(1, &m_uiRboDepth);
@@ -237,7 +242,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 std::cout << "ERROR::FRAMEBUFFER:: HDR Framebuffer is not complete!" << std::endl;
                 
             }
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             
             return HDRFramebufferComplete;
         }
@@ -263,13 +268,13 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenFramebuffers(1, &m_uiFramebuffer);
             
             // To bind the framebuffer we use glBindFramebuffer:
-            glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
             
             // create 2 floating point color buffers (1 for normal rendering, other for brightness treshold values)
             glGenTextures(2, m_uiHdrColorTextures);
             for (unsigned int i = 0; i < 2; i++)
             {
-                glBindTexture(GL_TEXTURE_2D, m_uiHdrColorTextures[i]);
+                CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiHdrColorTextures[i]);
                 /*
                  When the internal format of a framebuffer's colorbuffer is specified as GL_RGB16F, GL_RGBA16F, GL_RGB32F or GL_RGBA32F the framebuffer is known as a floating point framebuffer that can store floating point values outside the default range of 0.0 and 1.0. This is perfect for rendering in high dynamic range!
                  */
@@ -283,7 +288,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
                 SetSamplerObjectParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);// we clamp to the edge as the blur filter would otherwise sample repeated texture values!
                 SetSamplerObjectParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glBindTexture(GL_TEXTURE_2D, 0);
+                CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
                 
                 // attach texture to framebuffer
                 glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, m_uiHdrColorTextures[i], 0);
@@ -308,7 +313,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 std::cout << "ERROR::FRAMEBUFFER:: HDR Rendering Framebuffer is not complete!" << std::endl;
             }
             
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             
             return HDRframebufferComplete;
         }
@@ -323,9 +328,9 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             bool pingpongFramebufferComplete = false;
             for (unsigned int i = 0; i < 2; i++)
             {
-                glBindFramebuffer(GL_FRAMEBUFFER, m_uiPingpongFramebuffers[i]);
+                CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiPingpongFramebuffers[i]);
                 
-                glBindTexture(GL_TEXTURE_2D, m_uiPingpongColorTextures[i]);
+                CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiPingpongColorTextures[i]);
                 glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_iWidth, m_iHeight, 0, GL_RGB, GL_FLOAT, nullptr);
                 
                 glGenerateMipmap(GL_TEXTURE_2D);
@@ -348,7 +353,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 }
             }
             
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             
             return pingpongFramebufferComplete;
         }
@@ -357,13 +362,13 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenFramebuffers(1, &m_uiFramebuffer);
             
             // To bind the framebuffer we use glBindFramebuffer:
-            glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
             
             // create 2 floating point color buffers (1 for normal rendering, other for brightness treshold values)
             glGenTextures(2, m_uiHdrColorTextures);
             for (unsigned int i = 0; i < 2; i++)
             {
-                glBindTexture(GL_TEXTURE_2D, m_uiHdrColorTextures[i]);
+                CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiHdrColorTextures[i]);
                 /*
                  When the internal format of a framebuffer's colorbuffer is specified as GL_RGB16F, GL_RGBA16F, GL_RGB32F or GL_RGBA32F the framebuffer is known as a floating point framebuffer that can store floating point values outside the default range of 0.0 and 1.0. This is perfect for rendering in high dynamic range!
                  */
@@ -376,7 +381,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 // SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                 SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                 SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glBindTexture(GL_TEXTURE_2D, 0);
+                CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
                 
                 // attach texture to framebuffer
                 glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, m_uiHdrColorTextures[i], 0);
@@ -387,31 +392,31 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
              To get the position texture, we can use it to obtain depth values for each of the kernel samples. Note that we store the positions in a floating point data format; this way position values aren't clamped to [0.0,1.0]. Also note the texture wrapping method of GL_CLAMP_TO_EDGE. This ensures we don't accidentally oversample position/depth values in screen-space outside the texture's default coordinate region.
              */
             glGenTextures(1, &m_uiPositionTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiPositionTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiPositionTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_iWidth, m_iHeight, 0, GL_RGB, GL_FLOAT, nullptr);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, m_uiPositionTexture, 0);
             
             // - normal buffer
             // Now, create a normal texture for the FBO
             glGenTextures(1, &m_uiNormalTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiNormalTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiNormalTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_iWidth, m_iHeight, 0, GL_RGB, GL_FLOAT, nullptr);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, m_uiNormalTexture, 0);
             
             // - color + specular color buffer
             // Now, create a colot spec texture for the FBO
             glGenTextures(1, &m_uiAlbedoSpecTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiAlbedoSpecTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiAlbedoSpecTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_iWidth, m_iHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT4, m_uiAlbedoSpecTexture, 0);
             
             // tell OpenGL which color attachments we'll use (of this framebuffer) for rendering
@@ -430,7 +435,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 std::cout << "ERROR::FRAMEBUFFER:: Geometry Framebuffer is not complete!" << std::endl;
             }
             
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             
             return deferredRenderingFramebufferComplete;
         }
@@ -440,7 +445,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenFramebuffers(1, &m_uiFramebuffer);
             
             // attach depth texture as FBO's depth buffer
-            glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
             
             // - position color buffer
             /// The texture we're going to render to
@@ -448,17 +453,18 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenTextures(1, &m_uiColourTexture);
             
             /// "Bind" the newly created texture : all future texture functions will modify this texture
-            glBindTexture(GL_TEXTURE_2D, m_uiColourTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiColourTexture);
             
             /// Give an empty image to OpenGL ( the last "0" )
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_iWidth, m_iHeight, 0, GL_RGB, GL_FLOAT, nullptr);
+            // occlusion, and the view space depth the temporal ssao tiers keep with their history
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, m_iWidth, m_iHeight, 0, GL_RG, GL_FLOAT, nullptr);
             glGenerateMipmap(GL_TEXTURE_2D);
             
             // Create a sampler object and set texture properties.  Note here, we're mipmapping
             glGenSamplers(1, &m_uiSampler);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             
             glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_uiColourTexture, 0);
             
@@ -468,7 +474,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 std::cout << "ERROR::FRAMEBUFFER:: Screen Space Ambient Occlusion Mapping Framebuffer is not complete!" << std::endl;
             }
             
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             
             return ssaoMapFramebufferComplete;
         }
@@ -495,13 +501,13 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenFramebuffers(1, &m_uiFramebuffer);
             
             // To bind the framebuffer we use glBindFramebuffer:
-            glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
             
             // create 2 floating point color buffers (1 for normal rendering, other for brightness treshold values)
             glGenTextures(2, m_uiHdrColorTextures);
             for (unsigned int i = 0; i < 2; i++)
             {
-                glBindTexture(GL_TEXTURE_2D, m_uiHdrColorTextures[i]);
+                CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiHdrColorTextures[i]);
                 /*
                  When the internal format of a framebuffer's colorbuffer is specified as GL_RGB16F, GL_RGBA16F, GL_RGB32F or GL_RGBA32F the framebuffer is known as a floating point framebuffer that can store floating point values outside the default range of 0.0 and 1.0. This is perfect for rendering in high dynamic range!
                  */
@@ -514,7 +520,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                // SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                 SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                 SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glBindTexture(GL_TEXTURE_2D, 0);
+                CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
                 
                 // attach texture to framebuffer
                 glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, m_uiHdrColorTextures[i], 0);
@@ -525,33 +531,33 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
              To get the position texture, we can use it to obtain depth values for each of the kernel samples. Note that we store the positions in a floating point data format; this way position values aren't clamped to [0.0,1.0]. Also note the texture wrapping method of GL_CLAMP_TO_EDGE. This ensures we don't accidentally oversample position/depth values in screen-space outside the texture's default coordinate region.
              */
             glGenTextures(1, &m_uiPositionTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiPositionTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiPositionTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_iWidth, m_iHeight, 0, GL_RGB, GL_FLOAT, nullptr);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             SetSamplerObjectParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, m_uiPositionTexture, 0);
             
             // - normal buffer
             // Now, create a normal texture for the FBO
             glGenTextures(1, &m_uiNormalTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiNormalTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiNormalTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_iWidth, m_iHeight, 0, GL_RGB, GL_FLOAT, nullptr);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, m_uiNormalTexture, 0);
             
             // - color + specular color buffer
             // Now, create a colot spec texture for the FBO
             glGenTextures(1, &m_uiAlbedoSpecTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiAlbedoSpecTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiAlbedoSpecTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_iWidth, m_iHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT4, m_uiAlbedoSpecTexture, 0);
             
             // tell OpenGL which color attachments we'll use (of this framebuffer) for rendering
@@ -570,7 +576,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
                 std::cout << "ERROR::FRAMEBUFFER:: Geometry Framebuffer is not complete!" << std::endl;
             }
             
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             
             return gBufferComplete;
         }
@@ -583,7 +589,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenFramebuffers(1, &m_uiFramebuffer);
             
             // To bind the framebuffer we use glBindFramebuffer:
-            glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
             
             /*
              Unfortunately, we can't use our framebuffer yet because it is not complete. For a framebuffer to be complete the following requirements have to be satisfied:
@@ -627,7 +633,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             glGenTextures(1, &m_uiColourTexture);
             
             /// "Bind" the newly created texture : all future texture functions will modify this texture
-            glBindTexture(GL_TEXTURE_2D, m_uiColourTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiColourTexture);
             
             /// Give an empty image to OpenGL ( the last "0" )
             // glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, a_iWidth, a_iHeight); // The Superbible suggests this, but it is OpenGL4.2 feature
@@ -641,37 +647,37 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
             SetSamplerObjectParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             SetSamplerObjectParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             
             // - depth color buffer
             // Now, create a depth texture for the FBO
             glGenTextures(1, &m_uiDepthTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiDepthTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiDepthTexture);
             // glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, a_iWidth, a_iHeight);  // The Superbible suggests this, but it is OpenGL4.2 feature
             glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, m_iWidth, m_iHeight, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_BYTE, nullptr);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_WRAP_S, GL_REPEAT);
             SetSamplerObjectParameter(GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             
             // - normal color buffer
             // Now, create a normal texture for the FBO
             glGenTextures(1, &m_uiNormalTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiNormalTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiNormalTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_iWidth, m_iHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             
             // - color + specular color buffer
             // Now, create a colot spec texture for the FBO
             glGenTextures(1, &m_uiAlbedoSpecTexture);
-            glBindTexture(GL_TEXTURE_2D, m_uiAlbedoSpecTexture);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_uiAlbedoSpecTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_iWidth, m_iHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
             SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            CGLState::Instance().BindTexture(GL_TEXTURE_2D, 0);
             /*
              The glFrameBufferTexture2D has the following parameters:
                  target: the framebuffer type we're targeting (draw, read or both).
@@ -730,7 +736,7 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
             }
             
             // Then also be sure to unbind the framebuffer to make sure we're not accidentally rendering to the wrong framebuffer.
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
             /*
             // So, to draw the scene to a single texture we'll have to take the following steps:
             
@@ -746,11 +752,12 @@ bool CFrameBufferObject::CreateFramebuffer(const int &a_iWidth, const int &a_iHe
 }
 
 // Bind the FBO so we can render to it
-void CFrameBufferObject::Bind(bool bSetFullViewport)
+void CFrameBufferObject::Bind(bool bSetFullViewport, bool bClear)
 {
-	glBindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
+	CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiFramebuffer);
     
-    if(bSetFullViewport)glViewport(0, 0, m_iWidth, m_iHeight);
+    if(bSetFullViewport)CGLState::Instance().Viewport(0, 0, m_iWidth, m_iHeight);
+    if(!bClear) return;
 
     glm::vec4 clearColour = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
     float one = 1.0f;
@@ -761,8 +768,8 @@ void CFrameBufferObject::Bind(bool bSetFullViewport)
 // Bind the Ping Pong FBO for rendering to texture
 void CFrameBufferObject::BindPingPong(const GLuint &index, bool bSetFullViewport) {
     
-    glBindFramebuffer(GL_FRAMEBUFFER, m_uiPingpongFramebuffers[index]);
-    if(bSetFullViewport)glViewport(0, 0, m_iWidth, m_iHeight);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_uiPingpongFramebuffers[index]);
+    if(bSetFullViewport)CGLState::Instance().Viewport(0, 0, m_iWidth, m_iHeight);
     
     glm::vec4 clearColour = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
     float one = 1.0f;
@@ -773,29 +780,25 @@ void CFrameBufferObject::BindPingPong(const GLuint &index, bool bSetFullViewport
 // Binding the framebuffer color texture so it is active
 void CFrameBufferObject::BindTexture(GLuint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_uiColourTexture);
-    glBindSampler(iTextureUnit, m_uiSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_uiColourTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_uiSampler);
     glGenerateMipmap(GL_TEXTURE_2D);
 }
 
 // Binding the HDR framebuffer color texture so it is active
 void CFrameBufferObject::BindHDRTexture(GLuint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_uiHdrColorTexture);
-    glBindSampler(iTextureUnit, m_uiSampler);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    // the sampler filters linearly without mipmaps, so the chain is not rebuilt on every bind
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_uiHdrColorTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_uiSampler);
 }
 
 // Binding the HDR Render Targets framebuffer texture so it is active
 void CFrameBufferObject::BindHDRTexture(const GLuint &index, GLuint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    
-    glBindTexture(GL_TEXTURE_2D, m_uiHdrColorTextures[index]);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_uiHdrColorTextures[index]);
     
-    glBindSampler(iTextureUnit, m_uiSampler);
+    CGLState::Instance().BindSampler(iTextureUnit, m_uiSampler);
     glGenerateMipmap(GL_TEXTURE_2D);
 }
 
@@ -803,61 +806,55 @@ void CFrameBufferObject::BindHDRTexture(const GLuint &index, GLuint iTextureUnit
 void CFrameBufferObject::BindPingPongTexture(const GLuint &index, GLuint iTextureUnit)
 {
     
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_uiPingpongColorTextures[index]);
-    glBindSampler(iTextureUnit, m_uiSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_uiPingpongColorTextures[index]);
+    CGLState::Instance().BindSampler(iTextureUnit, m_uiSampler);
     glGenerateMipmap(GL_TEXTURE_2D);
 }
 
 
 void CFrameBufferObject::BindPositionTexture(GLuint iTextureUnit) {
-    glActiveTexture(GL_TEXTURE0 + iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_uiPositionTexture);
-    glBindSampler(iTextureUnit, m_uiSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_uiPositionTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_uiSampler);
     glGenerateMipmap(GL_TEXTURE_2D);
 }
 
 // Binding the framebuffer normal texture so it is active
 void CFrameBufferObject::BindNormalTexture(GLuint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_uiNormalTexture);
-    glBindSampler(iTextureUnit, m_uiSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_uiNormalTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_uiSampler);
     glGenerateMipmap(GL_TEXTURE_2D);
 }
 
 // Binding the framebuffer Albedo specular texture so it is active
 void CFrameBufferObject::BindAlbedoTexture(GLuint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_uiAlbedoSpecTexture);
-    glBindSampler(iTextureUnit, m_uiSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_uiAlbedoSpecTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_uiSampler);
     glGenerateMipmap(GL_TEXTURE_2D);
 }
 
 // Binding the depth framebuffer texture so it is active
 void CFrameBufferObject::BindDepthTexture(GLuint iTextureUnit)
 {
-	glActiveTexture(GL_TEXTURE0 + iTextureUnit);
-	glBindTexture(GL_TEXTURE_2D, m_uiDepthTexture);
-	glBindSampler(iTextureUnit, m_uiSampler);
+	CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_uiDepthTexture);
+	CGLState::Instance().BindSampler(iTextureUnit, m_uiSampler);
 }
 
 // Binding the depth cube map framebuffer texture so it is active
 void CFrameBufferObject::BindDepthCubeMap(GLuint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0 + iTextureUnit);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_uiDepthCubeMap);
-    glBindSampler(iTextureUnit, m_uiSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_CUBE_MAP, m_uiDepthCubeMap);
+    CGLState::Instance().BindSampler(iTextureUnit, m_uiSampler);
 }
 
 // Blit multisampled buffer(s) to the usual colorbuffer of intermediate FBO. Image is stored in colorBuffer texture
 void CFrameBufferObject::BlitToColorBuffer(GLuint colorbuffer)
 {
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_uiFramebuffer);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, colorbuffer);
+    CGLState::Instance().BindFramebuffer(GL_READ_FRAMEBUFFER, m_uiFramebuffer);
+    CGLState::Instance().BindFramebuffer(GL_DRAW_FRAMEBUFFER, colorbuffer);
     glBlitFramebuffer(0, 0, m_iWidth, m_iHeight, 0, 0, m_iWidth, m_iHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 // Blit multisampled buffer(s) to the usual depthbuffer of intermediate FBO. Image is stored in depthBuffer texture
@@ -865,41 +862,70 @@ void CFrameBufferObject::BlitToDepthBuffer(GLuint depthbuffer)
 {
     // copy content of geometry's depth buffer to default framebuffer's depth buffer
     // ----------------------------------------------------------------------------------
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_uiFramebuffer);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, depthbuffer); // write to default framebuffer at 0
+    CGLState::Instance().BindFramebuffer(GL_READ_FRAMEBUFFER, m_uiFramebuffer);
+    CGLState::Instance().BindFramebuffer(GL_DRAW_FRAMEBUFFER, depthbuffer); // write to default framebuffer at 0
     // blit to default framebuffer. Note that this may or may not work as the internal formats of both the FBO and default framebuffer have to match.
     // the internal formats are implementation defined. This works on all of my systems, but if it doesn't on yours you'll likely have to write to the
     // depth buffer in another shader stage (or somehow see to match the default framebuffer's internal format with the FBO's internal format).
     glBlitFramebuffer(0, 0, m_iWidth, m_iHeight, 0, 0, m_iWidth, m_iHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
 }
 
+void CFrameBufferObject::BlitToScreen(const GLint &width, const GLint &height)
+{
+    CGLState::Instance().BindFramebuffer(GL_READ_FRAMEBUFFER, m_uiFramebuffer);
+    CGLState::Instance().BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, m_iWidth, m_iHeight, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+}
+
+void CFrameBufferObject::BindHDRImage(GLuint iImageUnit, GLenum access)
+{
+    // the image format has to match the texture, see HighDynamicRangeLighting in CreateFramebuffer
+    glBindImageTexture(iImageUnit, m_uiHdrColorTexture, 0, GL_FALSE, 0, access, GL_RGBA16F);
+}
+
 // Delete the framebuffer and all attachments
 void CFrameBufferObject::Release()
 {
 	if(m_uiFramebuffer)
 	{
-		glDeleteFramebuffers(1, &m_uiFramebuffer);
+		CGLState::Instance().DeleteFramebuffers(1, &m_uiFramebuffer);
 		m_uiFramebuffer = 0;
 	}
     
-    glDeleteFramebuffers(2, m_uiPingpongFramebuffers);
+    CGLState::Instance().DeleteFramebuffers(2, m_uiPingpongFramebuffers);
     for (unsigned int i = 0; i < 2; i++){
         m_uiPingpongFramebuffers[i] = 0;
     }
 	
-	glDeleteSamplers(1, &m_uiSampler);
-    glDeleteTextures(1, &m_uiHdrColorTexture);
-    glDeleteTextures(1, &m_uiPositionTexture);
-	glDeleteTextures(1, &m_uiColourTexture);
-    glDeleteTextures(1, &m_uiAlbedoSpecTexture);
-    glDeleteTextures(1, &m_uiNormalTexture);
-	glDeleteTextures(1, &m_uiDepthTexture);
-    glDeleteTextures(1, &m_uiDepthCubeMap);
-    glDeleteTextures(2, m_uiHdrColorTextures);
-    glDeleteTextures(2, m_uiPingpongColorTextures);
+	CGLState::Instance().DeleteSamplers(1, &m_uiSampler);
+    CGLState::Instance().DeleteTextures(1, &m_uiHdrColorTexture);
+    CGLState::Instance().DeleteTextures(1, &m_uiPositionTexture);
+	CGLState::Instance().DeleteTextures(1, &m_uiColourTexture);
+    CGLState::Instance().DeleteTextures(1, &m_uiAlbedoSpecTexture);
+    CGLState::Instance().DeleteTextures(1, &m_uiNormalTexture);
+	CGLState::Instance().DeleteTextures(1, &m_uiDepthTexture);
+    CGLState::Instance().DeleteTextures(1, &m_uiDepthCubeMap);
+    CGLState::Instance().DeleteTextures(2, m_uiHdrColorTextures);
+    CGLState::Instance().DeleteTextures(2, m_uiPingpongColorTextures);
     
     glDeleteRenderbuffers(1, &m_uiRboDepthStencil);
     glDeleteRenderbuffers(1, &m_uiRboDepth);
+    
+    // the names may be handed out again, a second release must not delete someone else's objects
+    m_uiSampler = 0;
+    m_uiHdrColorTexture = 0;
+    m_uiPositionTexture = 0;
+    m_uiColourTexture = 0;
+    m_uiAlbedoSpecTexture = 0;
+    m_uiNormalTexture = 0;
+    m_uiDepthTexture = 0;
+    m_uiDepthCubeMap = 0;
+    m_uiRboDepthStencil = 0;
+    m_uiRboDepth = 0;
+    for (unsigned int i = 0; i < 2; i++){
+        m_uiHdrColorTextures[i] = 0;
+        m_uiPingpongColorTextures[i] = 0;
+    }
 }
 
 void CFrameBufferObject::SetSamplerObjectParameter(GLenum parameter, GLenum value)
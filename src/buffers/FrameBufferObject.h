@@ -11,8 +11,8 @@ public:
 	// Create a framebuffer object with a texture of a given size
 	bool CreateFramebuffer(const int &a_iWidth, const int &a_iHeight, const FrameBufferType &fboType = FrameBufferType::Default);
 
-	// Bind the FBO for rendering to texture
-	void Bind(bool bSetFullViewport = true);
+	// Bind the FBO for rendering to texture, without clearing to blend onto what it holds
+	void Bind(bool bSetFullViewport = true, bool bClear = true);
     
     // Bind the Ping Pong FBO for rendering to texture
     void BindPingPong(const GLuint &index, bool bSetFullViewport = true);
@@ -50,6 +50,12 @@ public:
     // Blit multisampled buffer(s) to the usual depthbuffer of intermediate FBO. Image is stored in depthBuffer texture
     void BlitToDepthBuffer(GLuint depthbuffer);
     
+    // Blit the colour to the default framebuffer, scaled to its size
+    void BlitToScreen(const GLint &width, const GLint &height);
+    
+    // Binding the HDR framebuffer color texture as an image a compute shader writes
+    void BindHDRImage(GLuint iImageUnit, GLenum access);
+    
 	// Delete the framebuffer
 	void Release();
 
@@ -62,11 +68,13 @@ public:
     GLuint GetHeight() const { return m_iHeight; }
     GLuint GetFrameBuffer() const { return m_uiFramebuffer; }
     GLuint GetDepthTexture() const { return m_uiDepthTexture; }
+    FrameBufferType GetType() const { return m_fboType; }
     
     
 private:
 
 	GLuint m_iWidth, m_iHeight;
+    FrameBufferType m_fboType;
 	GLuint m_uiFramebuffer;
     GLuint m_uiColourTexture;
     GLuint m_uiHdrColorTexture;
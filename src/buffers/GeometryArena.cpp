@@ -0,0 +1,312 @@
+//
+//  GeometryArena.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "GeometryArena.h"
+#include "InstanceBuffer.h"
+#include "../utilities/Vertex.h"
+#include "../window/GLState.h"
+
+/*   https://www.khronos.org/opengl/wiki/Vertex_Rendering#Base_Index
+ glDrawElementsBaseVertex adds the base vertex to every index it reads, so the indices of a mesh stay the ones it
+ was built with wherever its vertices end up in the shared buffer. Ranges are moved with glCopyBufferSubData
+ between buffers on the GPU, the data never comes back to the CPU.
+ */
+
+// starting sizes of the buffers of a layout, in vertices and indices
+#define ARENA_VERTICES (1 << 16)
+#define ARENA_INDICES (1 << 18)
+
+CGeometryArena &CGeometryArena::Instance()
+{
+    static CGeometryArena arena;
+    return arena;
+}
+
+CGeometryArena::CGeometryArena() : m_uiDefragmentations(0), m_uiGeneration(0)
+{
+    for (Pool &pool : m_pools) {
+        pool.vao = 0;
+        pool.vertexBuffer = 0;
+        pool.indexBuffer = 0;
+        pool.stride = 0;
+    }
+    m_allocations.push_back(Allocation{VertexLayout::Standard, 0, 0, 0, 0, false});
+}
+
+GLsizei CGeometryArena::GetStride(const VertexLayout &layout)
+{
+    switch (layout) {
+        case VertexLayout::Standard:
+        default:
+            return sizeof(Vertex);
+    }
+}
+
+// location 0 position, 1 texture, 2 normal, 3 tangent and 4 bitangent
+void CGeometryArena::SetVertexAttributes(const VertexLayout &layout)
+{
+    const GLsizei stride = GetStride(layout);
+    switch (layout) {
+        case VertexLayout::Standard:
+        default:
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Vertex, position));
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Vertex, texture));
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Vertex, normal));
+            glEnableVertexAttribArray(3);
+            glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Vertex, tangent));
+            glEnableVertexAttribArray(4);
+            glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Vertex, bitangent));
+            break;
+    }
+}
+
+CGeometryArena::Pool &CGeometryArena::GetPool(const VertexLayout &layout)
+{
+    Pool &pool = m_pools[static_cast<GLuint>(layout)];
+    if (pool.vao != 0)
+        return pool;
+
+    pool.stride = GetStride(layout);
+    pool.vertices = CRangeAllocator(ARENA_VERTICES);
+    pool.indices = CRangeAllocator(ARENA_INDICES);
+    pool.vertexBuffer = ResizeBuffer(0, 0, static_cast<GLsizeiptr>(ARENA_VERTICES) * pool.stride);
+    pool.indexBuffer = ResizeBuffer(0, 0, static_cast<GLsizeiptr>(ARENA_INDICES) * sizeof(GLuint));
+    glGenVertexArrays(1, &pool.vao);
+    SetupVertexArray(layout, pool);
+    return pool;
+}
+
+GLuint CGeometryArena::ResizeBuffer(const GLuint &buffer, const GLsizeiptr &copySize, const GLsizeiptr &size)
+{
+    GLuint resized;
+    glGenBuffers(1, &resized);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, resized);
+    glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STATIC_DRAW);
+    if (buffer != 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, copySize);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteBuffers(1, &buffer);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return resized;
+}
+
+void CGeometryArena::SetupVertexArray(const VertexLayout &layout, Pool &pool)
+{
+    CGLState::Instance().BindVertexArray(pool.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, pool.vertexBuffer);
+    SetVertexAttributes(layout);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.indexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+GLuint CGeometryArena::Allocate(const VertexLayout &layout, const void *vertices, const GLuint &vertexCount,
+                                const GLuint *indices, const GLuint &indexCount)
+{
+    if (vertexCount == 0 || indexCount == 0)
+        return 0;
+
+    Pool &pool = GetPool(layout);
+    GLboolean resized = false;
+    GLuint firstVertex, firstIndex;
+    if (!pool.vertices.Allocate(vertexCount, firstVertex)) {
+        const GLuint capacity = pool.vertices.GetCapacity();
+        const GLuint grow = std::max(capacity, vertexCount);
+        pool.vertexBuffer = ResizeBuffer(pool.vertexBuffer, static_cast<GLsizeiptr>(capacity) * pool.stride,
+                                         static_cast<GLsizeiptr>(capacity + grow) * pool.stride);
+        pool.vertices.Grow(grow);
+        pool.vertices.Allocate(vertexCount, firstVertex);
+        resized = true;
+    }
+    if (!pool.indices.Allocate(indexCount, firstIndex)) {
+        const GLuint capacity = pool.indices.GetCapacity();
+        const GLuint grow = std::max(capacity, indexCount);
+        pool.indexBuffer = ResizeBuffer(pool.indexBuffer, static_cast<GLsizeiptr>(capacity) * sizeof(GLuint),
+                                        static_cast<GLsizeiptr>(capacity + grow) * sizeof(GLuint));
+        pool.indices.Grow(grow);
+        pool.indices.Allocate(indexCount, firstIndex);
+        resized = true;
+    }
+    if (resized) {
+        SetupVertexArray(layout, pool);
+        m_uiGeneration++;
+    }
+
+    // the copy targets leave the element buffer of whatever VAO is bound alone
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.vertexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(firstVertex) * pool.stride,
+                    static_cast<GLsizeiptr>(vertexCount) * pool.stride, vertices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.indexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(firstIndex) * sizeof(GLuint),
+                    static_cast<GLsizeiptr>(indexCount) * sizeof(GLuint), indices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    Allocation allocation{layout, firstVertex, vertexCount, firstIndex, indexCount, true};
+    if (!m_freeHandles.empty()) {
+        GLuint handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_allocations[handle] = allocation;
+        return handle;
+    }
+    m_allocations.push_back(allocation);
+    return static_cast<GLuint>(m_allocations.size() - 1);
+}
+
+void CGeometryArena::Free(const GLuint &handle)
+{
+    if (handle == 0 || handle >= m_allocations.size() || !m_allocations[handle].live)
+        return;
+
+    Allocation &allocation = m_allocations[handle];
+    Pool &pool = m_pools[static_cast<GLuint>(allocation.layout)];
+    pool.vertices.Free(allocation.firstVertex, allocation.vertexCount);
+    pool.indices.Free(allocation.firstIndex, allocation.indexCount);
+    allocation.live = false;
+    m_freeHandles.push_back(handle);
+}
+
+void CGeometryArena::Draw(const GLuint &handle, const GLenum &mode)
+{
+    const Allocation &allocation = m_allocations[handle];
+    if (!allocation.live)
+        return;
+    CGLState::Instance().BindVertexArray(m_pools[static_cast<GLuint>(allocation.layout)].vao);
+    glDrawElementsBaseVertex(mode, allocation.indexCount, GL_UNSIGNED_INT,
+                             (void*)(static_cast<GLintptr>(allocation.firstIndex) * sizeof(GLuint)), allocation.firstVertex);
+}
+
+void CGeometryArena::DrawInstanced(const GLuint &handle, CInstanceBuffer &instances, const GLuint &first, const GLsizei &count,
+                                   const GLenum &mode)
+{
+    const Allocation &allocation = m_allocations[handle];
+    if (!allocation.live)
+        return;
+    instances.Bind(m_pools[static_cast<GLuint>(allocation.layout)].vao, first);
+    glDrawElementsInstancedBaseVertex(mode, allocation.indexCount, GL_UNSIGNED_INT,
+                                      (void*)(static_cast<GLintptr>(allocation.firstIndex) * sizeof(GLuint)), count, allocation.firstVertex);
+}
+
+GLboolean CGeometryArena::GetGeometry(const GLuint &handle, GeometryRange &geometry) const
+{
+    if (handle == 0 || handle >= m_allocations.size() || !m_allocations[handle].live)
+        return false;
+
+    const Allocation &allocation = m_allocations[handle];
+    const Pool &pool = m_pools[static_cast<GLuint>(allocation.layout)];
+    geometry.vertexArray = pool.vao;
+    geometry.vertexBuffer = pool.vertexBuffer;
+    geometry.vertexOffset = static_cast<GLintptr>(allocation.firstVertex) * pool.stride;
+    geometry.vertexSize = static_cast<GLsizeiptr>(allocation.vertexCount) * pool.stride;
+    geometry.indexBuffer = pool.indexBuffer;
+    geometry.indexOffset = static_cast<GLintptr>(allocation.firstIndex) * sizeof(GLuint);
+    geometry.count = static_cast<GLsizei>(allocation.indexCount);
+    return true;
+}
+
+GLuint CGeometryArena::Defragment(const GLfloat &threshold)
+{
+    GLuint moved = 0;
+    for (GLuint l = 0; l < static_cast<GLuint>(VertexLayout::NumberOfLayouts); ++l) {
+        Pool &pool = m_pools[l];
+        if (pool.vao == 0) continue;
+        if (std::max(pool.vertices.GetFragmentation(), pool.indices.GetFragmentation()) <= threshold) continue;
+
+        std::vector<GLuint> handles;
+        for (GLuint i = 1; i < m_allocations.size(); ++i) {
+            if (m_allocations[i].live && static_cast<GLuint>(m_allocations[i].layout) == l) handles.push_back(i);
+        }
+
+        // the ranges keep their order, each one moves down to where the one before it ends
+        GLuint vertexBuffer, indexBuffer;
+        glGenBuffers(1, &vertexBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(pool.vertices.GetCapacity()) * pool.stride, nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, pool.vertexBuffer);
+        std::sort(handles.begin(), handles.end(), [this](const GLuint &a, const GLuint &b) {
+            return m_allocations[a].firstVertex < m_allocations[b].firstVertex;
+        });
+        GLuint vertexEnd = 0;
+        for (GLuint handle : handles) {
+            Allocation &allocation = m_allocations[handle];
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(allocation.firstVertex) * pool.stride,
+                                static_cast<GLintptr>(vertexEnd) * pool.stride, static_cast<GLsizeiptr>(allocation.vertexCount) * pool.stride);
+            if (allocation.firstVertex != vertexEnd) moved++;
+            allocation.firstVertex = vertexEnd;
+            vertexEnd += allocation.vertexCount;
+        }
+
+        glGenBuffers(1, &indexBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(pool.indices.GetCapacity()) * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, pool.indexBuffer);
+        std::sort(handles.begin(), handles.end(), [this](const GLuint &a, const GLuint &b) {
+            return m_allocations[a].firstIndex < m_allocations[b].firstIndex;
+        });
+        GLuint indexEnd = 0;
+        for (GLuint handle : handles) {
+            Allocation &allocation = m_allocations[handle];
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(allocation.firstIndex) * sizeof(GLuint),
+                                static_cast<GLintptr>(indexEnd) * sizeof(GLuint), static_cast<GLsizeiptr>(allocation.indexCount) * sizeof(GLuint));
+            if (allocation.firstIndex != indexEnd) moved++;
+            allocation.firstIndex = indexEnd;
+            indexEnd += allocation.indexCount;
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        glDeleteBuffers(1, &pool.vertexBuffer);
+        glDeleteBuffers(1, &pool.indexBuffer);
+        pool.vertexBuffer = vertexBuffer;
+        pool.indexBuffer = indexBuffer;
+        pool.vertices.Reset(vertexEnd);
+        pool.indices.Reset(indexEnd);
+        SetupVertexArray(static_cast<VertexLayout>(l), pool);
+        m_uiDefragmentations++;
+        m_uiGeneration++;
+    }
+    return moved;
+}
+
+GeometryArenaStats CGeometryArena::GetStats(const VertexLayout &layout) const
+{
+    const Pool &pool = m_pools[static_cast<GLuint>(layout)];
+    GeometryArenaStats stats;
+    stats.allocations = 0;
+    for (GLuint i = 1; i < m_allocations.size(); ++i) {
+        if (m_allocations[i].live && m_allocations[i].layout == layout) stats.allocations++;
+    }
+    stats.vertexCapacity = pool.vertices.GetCapacity();
+    stats.vertexUsed = pool.vertices.GetUsed();
+    stats.vertexFreeBlocks = pool.vertices.GetFreeBlockCount();
+    stats.indexCapacity = pool.indices.GetCapacity();
+    stats.indexUsed = pool.indices.GetUsed();
+    stats.indexFreeBlocks = pool.indices.GetFreeBlockCount();
+    stats.fragmentation = std::max(pool.vertices.GetFragmentation(), pool.indices.GetFragmentation());
+    return stats;
+}
+
+void CGeometryArena::Release()
+{
+    for (Pool &pool : m_pools) {
+        if (pool.vao != 0) CGLState::Instance().DeleteVertexArrays(1, &pool.vao);
+        if (pool.vertexBuffer != 0) glDeleteBuffers(1, &pool.vertexBuffer);
+        if (pool.indexBuffer != 0) glDeleteBuffers(1, &pool.indexBuffer);
+        pool.vao = 0;
+        pool.vertexBuffer = 0;
+        pool.indexBuffer = 0;
+        pool.vertices = CRangeAllocator();
+        pool.indices = CRangeAllocator();
+    }
+    m_allocations.resize(1);
+    m_freeHandles.clear();
+    m_uiGeneration++;
+}
@@ -0,0 +1,109 @@
+//
+//  GeometryArena.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef GeometryArena_h
+#define GeometryArena_h
+
+#include "../BuffersBase.h"
+#include "../utilities/VertexLayout.h"
+#include "RangeAllocator.h"
+
+class CInstanceBuffer;
+
+// where the vertices and unsigned int indices of a mesh sit, offsets and sizes in bytes, index buffer 0 when
+// the mesh draws arrays
+struct GeometryRange {
+    GLuint vertexArray;     // the VAO of the arena the range is drawn with, 0 for meshes with buffers of their own
+    GLuint vertexBuffer;
+    GLintptr vertexOffset;
+    GLsizeiptr vertexSize;
+    GLuint indexBuffer;
+    GLintptr indexOffset;
+    GLsizei count;          // what the draw call is given
+    GLenum mode;
+};
+
+// statistics of the buffers of a layout, in vertices and indices
+struct GeometryArenaStats {
+    GLuint allocations;
+    GLuint vertexCapacity, vertexUsed, vertexFreeBlocks;
+    GLuint indexCapacity, indexUsed, indexFreeBlocks;
+    GLfloat fragmentation;      // the worse of the vertex and the index buffer, see CRangeAllocator
+};
+
+// The static meshes of a vertex layout share one vertex buffer, one index buffer and one VAO, so drawing one
+// mesh after another only moves the base vertex and the first index and the VAO stays bound. Each mesh gets a
+// range of both buffers from a free list, the buffers double when a mesh does not fit and Defragment packs the
+// live ranges to the front when freed ones leave the space scattered. A mesh keeps a handle, its ranges are
+// looked up on every draw so they can move.
+class CGeometryArena
+{
+public:
+    static CGeometryArena &Instance();
+
+    // copies the vertices and the indices, which count from the first vertex of the mesh, returns the handle
+    GLuint Allocate(const VertexLayout &layout, const void *vertices, const GLuint &vertexCount,
+                    const GLuint *indices, const GLuint &indexCount);
+    // handle 0 and handles freed already are ignored
+    void Free(const GLuint &handle);
+
+    // the VAO of the layout is left bound for the next draw
+    void Draw(const GLuint &handle, const GLenum &mode = GL_TRIANGLES);
+    void DrawInstanced(const GLuint &handle, CInstanceBuffer &instances, const GLuint &first, const GLsizei &count,
+                       const GLenum &mode = GL_TRIANGLES);
+    GLboolean GetGeometry(const GLuint &handle, GeometryRange &geometry) const;
+    // changes whenever ranges move or the buffers are replaced, what GetGeometry gave before is stale then
+    GLuint GetGeneration() const { return m_uiGeneration; }
+
+    // packs the live ranges of every layout whose free space is more fragmented than the threshold,
+    // returns how many ranges moved
+    GLuint Defragment(const GLfloat &threshold = 0.0f);
+
+    GeometryArenaStats GetStats(const VertexLayout &layout) const;
+    // bytes per vertex
+    static GLsizei GetStride(const VertexLayout &layout);
+    // points the vertex attributes of the bound VAO at the bound array buffer, every mesh of a layout uses these
+    static void SetVertexAttributes(const VertexLayout &layout);
+    GLuint GetDefragmentations() const { return m_uiDefragmentations; }
+
+    // needs the context, every handle is invalid afterwards
+    void Release();
+
+private:
+    CGeometryArena();
+    CGeometryArena(const CGeometryArena &) = delete;
+    CGeometryArena &operator=(const CGeometryArena &) = delete;
+
+    struct Pool {
+        GLuint vao, vertexBuffer, indexBuffer;
+        GLsizei stride;
+        CRangeAllocator vertices, indices;
+    };
+    struct Allocation {
+        VertexLayout layout;
+        GLuint firstVertex, vertexCount;
+        GLuint firstIndex, indexCount;
+        GLboolean live;
+    };
+
+    Pool &GetPool(const VertexLayout &layout);
+    // a new buffer of the given size in bytes with the first bytes of the old one copied into it
+    static GLuint ResizeBuffer(const GLuint &buffer, const GLsizeiptr &copySize, const GLsizeiptr &size);
+    // points the VAO at the current buffers of the pool
+    static void SetupVertexArray(const VertexLayout &layout, Pool &pool);
+
+    Pool m_pools[static_cast<GLuint>(VertexLayout::NumberOfLayouts)];
+    std::vector<Allocation> m_allocations;      // handle i is m_allocations[i], 0 is never handed out
+    std::vector<GLuint> m_freeHandles;
+    GLuint m_uiDefragmentations;
+    GLuint m_uiGeneration;
+};
+
+#endif /* GeometryArena_h */
@@ -0,0 +1,89 @@
+//
+//  InstanceBuffer.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "InstanceBuffer.h"
+#include "../window/GLState.h"
+
+/*   https://learnopengl.com/Advanced-OpenGL/Instancing
+ The instances of every group of a frame sit one after the other in the same buffer. GL 4.1 has no base instance,
+ so before each instanced draw the attribute pointers of the mesh's VAO are moved to the first instance of its group.
+ A matrix attribute takes one location per column, the divisor makes the columns advance once per instance.
+ */
+
+CInstanceBuffer::CInstanceBuffer() : m_vbo(0), m_capacity(0)
+{
+}
+
+CInstanceBuffer::~CInstanceBuffer()
+{
+    Release();
+}
+
+// Create the VBO, it is sized on the first upload
+void CInstanceBuffer::Create()
+{
+    if (m_vbo == 0) glGenBuffers(1, &m_vbo);
+}
+
+void CInstanceBuffer::Clear()
+{
+    m_instances.clear();
+}
+
+GLuint CInstanceBuffer::Add(const glm::mat4 &modelMatrix, const glm::mat3 &normalMatrix)
+{
+    m_instances.push_back(Instance{modelMatrix, normalMatrix});
+    return static_cast<GLuint>(m_instances.size() - 1);
+}
+
+// Orphan the storage of the last frame and stream the new instances into it
+void CInstanceBuffer::Upload()
+{
+    if (m_vbo == 0 || m_instances.empty())
+        return;
+
+    GLsizeiptr size = static_cast<GLsizeiptr>(m_instances.size() * sizeof(Instance));
+    if (size > m_capacity) m_capacity = size;
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, &m_instances[0]);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// The VAO stays bound for the draw that follows
+void CInstanceBuffer::Bind(const GLuint &vao, const GLuint &first)
+{
+    CGLState::Instance().BindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+    const GLsizei stride = sizeof(Instance);
+    const GLsizeiptr offset = first * sizeof(Instance);
+    for (GLuint i = 0; i < 4; ++i) {
+        GLuint location = INSTANCE_ATTRIBUTE_LOCATION + i;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + offsetof(Instance, modelMatrix) + i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+    }
+    for (GLuint i = 0; i < 3; ++i) {
+        GLuint location = INSTANCE_ATTRIBUTE_LOCATION + 4 + i;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, stride, (void*)(offset + offsetof(Instance, normalMatrix) + i * sizeof(glm::vec3)));
+        glVertexAttribDivisor(location, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Release the VBO
+void CInstanceBuffer::Release()
+{
+    if (m_vbo != 0) glDeleteBuffers(1, &m_vbo);
+    m_vbo = 0;
+    m_capacity = 0;
+    m_instances.clear();
+}
@@ -0,0 +1,47 @@
+//
+//  InstanceBuffer.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef InstanceBuffer_h
+#define InstanceBuffer_h
+
+#include "../BuffersBase.h"
+
+// first attribute location of the per instance data, locations 0 to 4 are the vertex attributes
+#define INSTANCE_ATTRIBUTE_LOCATION 5
+
+// This class streams per instance transforms to a vertex buffer read with an attribute divisor of one
+class CInstanceBuffer
+{
+public:
+    CInstanceBuffer();
+    ~CInstanceBuffer();
+
+    void Create();                                                      // Creates the VBO
+    void Clear();                                                       // Empties the instances of the last frame
+    GLuint Add(const glm::mat4 &modelMatrix, const glm::mat3 &normalMatrix); // Appends an instance, returns its index
+    void Upload();                                                      // Sends the instances to the GPU
+    void Bind(const GLuint &vao, const GLuint &first);                  // Binds the VAO and points its instance attributes at the first instance
+    void Release();                                                     // Releases the VBO
+
+    GLuint GetCount() const { return static_cast<GLuint>(m_instances.size()); }
+    GLuint GetBuffer() const { return m_vbo; }                          // VBO id, 25 floats per instance
+
+private:
+    struct Instance {
+        glm::mat4 modelMatrix;      // locations 5 to 8
+        glm::mat3 normalMatrix;     // locations 9 to 11
+    };
+
+    GLuint m_vbo;                                   // VBO id
+    GLsizeiptr m_capacity;                          // Allocated size in bytes
+    std::vector<Instance> m_instances;              // Instances waiting to be uploaded
+};
+
+#endif /* InstanceBuffer_h */
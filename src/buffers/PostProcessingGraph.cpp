@@ -0,0 +1,533 @@
+//
+//  PostProcessingGraph.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "PostProcessingGraph.h"
+
+CPostProcessingGraph::CPostProcessingGraph(CRenderGraph &graph, const PostProcessingGraphSettings &settings, const Binder &bind)
+: m_graph(graph), m_settings(settings), m_bind(bind)
+{
+    m_mode = PostProcessingEffectMode::NumberOfPPFX;
+}
+
+bool CPostProcessingGraph::Declare(const PostProcessingEffectMode &mode)
+{
+    m_mode = mode;
+    m_graph.Clear();
+
+    // the scene target and the screen come from outside the graph
+    const GLuint scene = m_graph.Import("scene", GetSceneType(mode));
+    const GLuint screen = m_graph.Import("screen", FrameBufferType::Default);
+
+    // while the stack holds effects it takes the place of any effect that could be part of it
+    if (!m_settings.stack.empty() && IsStackable(mode)) {
+        DeclareStack(scene, screen);
+        return m_graph.Compile(screen);
+    }
+
+    if (m_settings.compute && IsConvolution(mode)) {
+        DeclareConvolution(scene, screen);
+        return m_graph.Compile(screen);
+    }
+
+    switch(mode) {
+        case PostProcessingEffectMode::GaussianBlur: {
+            // Second Pass - BLUR down and back up the mip chain
+            const GLuint blur = DeclarePyramid(scene, 0);
+
+            // Third Pass - Final Blur to screen
+            AddPass(MakePass(PostProcessingPassType::GaussianBlurComposite, "gaussian blur composite", {scene, blur}, {screen}));
+            break;
+        }
+        case PostProcessingEffectMode::MotionBlur: {
+            const GLuint depth = m_graph.Create("depth", FrameBufferType::DepthMapping);
+
+            // Second Pass - Render Scene as usual, Third Pass - Motion Blur
+            AddPass(MakePass(PostProcessingPassType::MotionBlurDepth, "motion blur depth", {}, {depth}));
+            AddPass(MakePass(PostProcessingPassType::MotionBlur, "motion blur", {scene, depth}, {screen}));
+            break;
+        }
+        case PostProcessingEffectMode::Bloom: {
+            // Second Pass - BLUR Bright Parts, providing the bright parts textures at the first level
+            const GLuint blur = DeclarePyramid(scene, 1);
+
+            // Third Pass - BLOOM
+            AddPass(MakePass(PostProcessingPassType::Bloom, "bloom", {scene, blur}, {screen}));
+            break;
+        }
+        case PostProcessingEffectMode::LensFlare: {
+            // bright parts blurred down the mip chain, the flare features at the size of its first level, then composited
+            const GLuint blur = DeclarePyramid(scene, 1);
+            const GLuint flare = m_graph.Create("flare", FrameBufferType::Default, 1);
+
+            AddPass(MakePass(PostProcessingPassType::LensFlareGhost, "lens flare ghost", {blur}, {flare}));
+            AddPass(MakePass(PostProcessingPassType::LensFlare, "lens flare", {scene, flare}, {screen}));
+            break;
+        }
+        case PostProcessingEffectMode::SSAO: {
+            // the occlusion and its blur at the size and sample count of the quality tier, then the lighting
+            const GLuint occlusionBlur = m_graph.Create("occlusion blur", FrameBufferType::SSAO);
+            DeclareOcclusion(scene, occlusionBlur);
+
+            AddPass(MakePass(PostProcessingPassType::OcclusionLighting, "ssao lighting", {scene, occlusionBlur}, {screen}));
+            break;
+        }
+        case PostProcessingEffectMode::DepthTesting: {
+            const GLuint depthView = m_graph.Create("depth view", FrameBufferType::Default);
+
+            AddPass(MakePass(PostProcessingPassType::DepthTesting, "depth testing", {}, {depthView}));
+            AddPass(MakePass(PostProcessingPassType::SceneComposite, "depth testing composite", {scene, depthView}, {screen}));
+            break;
+        }
+        case PostProcessingEffectMode::DepthMapping: {
+            const GLuint depth = m_graph.Create("light depth", FrameBufferType::DepthMapping);
+
+            AddPass(MakePass(PostProcessingPassType::LightSpaceDepth, "depth mapping light space", {}, {depth}));
+            AddPass(MakePass(PostProcessingPassType::DepthMapping, "depth mapping", {scene, depth}, {screen}));
+            break;
+        }
+        case PostProcessingEffectMode::DirectionalShadowMapping: {
+            const GLuint depth = m_graph.Create("light depth", FrameBufferType::DirectionalShadowMapping);
+            const GLuint lit = m_graph.Create("shadowed scene", FrameBufferType::Default);
+
+            AddPass(MakePass(PostProcessingPassType::LightSpaceDepth, "directional shadow light space", {}, {depth}));
+            AddPass(MakePass(PostProcessingPassType::DirectionalShadowMapping, "directional shadow mapping", {depth}, {lit}));
+            AddPass(MakePass(PostProcessingPassType::SceneComposite, "directional shadow composite", {scene, lit}, {screen}));
+            break;
+        }
+        case PostProcessingEffectMode::OmnidirectionalShadowMapping: {
+            const GLuint depth = m_graph.Create("light depth cube", FrameBufferType::OmnidirectionalShadowMapping);
+            const GLuint lit = m_graph.Create("shadowed scene", FrameBufferType::Default);
+
+            AddPass(MakePass(PostProcessingPassType::OmnidirectionalLightSpaceDepth, "omnidirectional shadow light space", {}, {depth}));
+            AddPass(MakePass(PostProcessingPassType::OmnidirectionalShadowMapping, "omnidirectional shadow mapping", {depth}, {lit}));
+            AddPass(MakePass(PostProcessingPassType::SceneComposite, "omnidirectional shadow composite", {scene, lit}, {screen}));
+            break;
+        }
+        case PostProcessingEffectMode::DeferredRendering: {
+            AddPass(MakePass(PostProcessingPassType::DeferredLighting, "deferred lighting", {scene}, {screen}));
+            AddPass(MakePass(PostProcessingPassType::DeferredLamps, "deferred lamps", {scene}, {screen}));
+            break;
+        }
+        default: {
+            // most effects are one full screen pass over the scene
+            AddPass(MakePass(PostProcessingPassType::Effect, PostProcessingEffectModeToString(mode), {scene}, {screen}));
+            break;
+        }
+    }
+
+    return m_graph.Compile(screen);
+}
+
+void CPostProcessingGraph::AddPass(const PostProcessingPass &pass)
+{
+    m_graph.AddPass(pass.name, pass.reads, pass.writes, m_bind ? m_bind(pass) : std::function<void()>());
+}
+
+PostProcessingPass CPostProcessingGraph::MakePass(const PostProcessingPassType &type, const std::string &name,
+                                                  const std::vector<GLuint> &reads, const std::vector<GLuint> &writes) const
+{
+    PostProcessingPass pass;
+    pass.type = type;
+    pass.mode = m_mode;
+    pass.name = name;
+    pass.reads = reads;
+    pass.writes = writes;
+    pass.programs = type == PostProcessingPassType::Effect ? std::vector<GLuint>{GetEffectProgram(m_mode)} : GetPassPrograms(type);
+    pass.index = 0;
+    pass.sourceIndex = 0;
+    pass.level = 0;
+    pass.samples = 0;
+    pass.temporal = false;
+    pass.first = false;
+    pass.last = false;
+    pass.direction = glm::vec2(0.0f);
+    return pass;
+}
+
+/// declare the mip chain shared by blur, bloom and lens flare, returns the half size level that ends up with the result
+GLuint CPostProcessingGraph::DeclarePyramid(const GLuint &source, const GLuint &sourceIndex)
+{
+    std::vector<GLuint> mips;
+    for (GLuint level = 1; level <= m_settings.pyramidLevels; level++)
+        mips.push_back(m_graph.Create("mip " + std::to_string(level), FrameBufferType::HighDynamicRangeLighting, level));
+
+    // each level filters the one twice its size, the first one reads the scene
+    for (GLuint i = 0; i < mips.size(); i++) {
+        PostProcessingPass pass = MakePass(PostProcessingPassType::PyramidDownsample, "downsample " + std::to_string(i + 1),
+                                           {i == 0 ? source : mips[i - 1]}, {mips[i]});
+        pass.index = i;
+        pass.sourceIndex = i == 0 ? sourceIndex : 0;
+        AddPass(pass);
+    }
+
+    // and back up, every level is blended onto the one above it so the widest blur ends in the first level
+    for (GLuint i = static_cast<GLuint>(mips.size()) - 1; i > 0; i--) {
+        PostProcessingPass pass = MakePass(PostProcessingPassType::PyramidUpsample, "upsample " + std::to_string(i),
+                                           {mips[i], mips[i - 1]}, {mips[i - 1]});
+        pass.index = i;
+        AddPass(pass);
+    }
+
+    return mips[0];
+}
+
+/// declare the compute passes of a convolution effect, separable filters take one pass per direction
+void CPostProcessingGraph::DeclareConvolution(const GLuint &scene, const GLuint &screen)
+{
+    const GLuint filtered = m_graph.Create("filtered", FrameBufferType::HighDynamicRangeLighting);
+    const GLboolean separable = m_mode == PostProcessingEffectMode::KernelBlur || m_mode == PostProcessingEffectMode::Blur;
+
+    if (separable) {
+        const GLuint horizontal = m_graph.Create("horizontal", FrameBufferType::HighDynamicRangeLighting);
+        PostProcessingPass pass = MakePass(PostProcessingPassType::Convolution, "convolution horizontal", {scene}, {horizontal});
+        pass.direction = glm::vec2(1.0f, 0.0f);
+        AddPass(pass);
+
+        // the scene is read again for the part the coverage leaves unfiltered
+        pass = MakePass(PostProcessingPassType::Convolution, "convolution vertical", {scene, horizontal}, {filtered});
+        pass.direction = glm::vec2(0.0f, 1.0f);
+        pass.last = true;
+        AddPass(pass);
+    } else {
+        PostProcessingPass pass = MakePass(PostProcessingPassType::Convolution, "convolution", {scene}, {filtered});
+        pass.last = true;
+        AddPass(pass);
+    }
+
+    AddPass(MakePass(PostProcessingPassType::ConvolutionPresent, "convolution present", {filtered}, {screen}));
+}
+
+/// declare the effect stack, a run of pointwise effects is one generated pass and any other effect is a pass of its own
+void CPostProcessingGraph::DeclareStack(const GLuint &scene, const GLuint &screen)
+{
+    const std::vector<std::vector<PostProcessingEffectMode>> runs = GetStackRuns(m_settings.stack);
+
+    GLuint from = scene;
+    for (GLuint i = 0; i < runs.size(); i++) {
+        const std::vector<PostProcessingEffectMode> &run = runs[i];
+        const GLboolean last = i + 1 == runs.size();
+        const GLuint to = last ? screen : m_graph.Create("stack " + std::to_string(i + 1), FrameBufferType::Default);
+        const std::string name = run.size() == 1 ? PostProcessingEffectModeToString(run[0]) : "fused " + std::to_string(run.size());
+
+        PostProcessingPass pass = MakePass(PostProcessingPassType::Stack, "stack " + name, {from}, {to});
+        pass.first = i == 0;
+        pass.last = last;
+        pass.effects = run;
+        // a fused run renders with a program generated for it
+        if (run.size() == 1) pass.programs = {GetEffectProgram(run[0])};
+        AddPass(pass);
+        from = to;
+    }
+}
+
+/// declare the ssao passes of the quality tier, whatever the tier the occlusion ends up blurred at the window size
+void CPostProcessingGraph::DeclareOcclusion(const GLuint &scene, const GLuint &occlusion)
+{
+    const SSAOQuality quality = m_settings.ssaoQuality;
+    const GLuint level = SSAOQualityLevel(quality);
+    const GLuint samples = SSAOQualitySamples(quality);
+    const GLboolean temporal = SSAOQualityTemporal(quality);
+
+    if (level == 0) {
+        const GLuint raw = m_graph.Create("occlusion raw", FrameBufferType::SSAO);
+
+        PostProcessingPass pass = MakePass(PostProcessingPassType::Occlusion, "ssao", {scene}, {raw});
+        pass.samples = samples;
+        AddPass(pass);
+        AddPass(MakePass(PostProcessingPassType::OcclusionBlur, "ssao blur", {raw}, {occlusion}));
+        return;
+    }
+
+    const GLuint geometry = m_graph.Create("ssao geometry", FrameBufferType::GeometryBuffer, level);
+    const GLuint raw = m_graph.Create("occlusion raw", FrameBufferType::SSAO, level);
+
+    // positions and normals at the size of the tier
+    PostProcessingPass pass = MakePass(PostProcessingPassType::OcclusionDownsample, "ssao downsample", {scene}, {geometry});
+    pass.level = level;
+    AddPass(pass);
+
+    // the temporal tiers take the next part of the kernel every frame
+    pass = MakePass(PostProcessingPassType::Occlusion, "ssao", {geometry}, {raw});
+    pass.level = level;
+    pass.samples = samples;
+    pass.temporal = temporal;
+    AddPass(pass);
+
+    // the history lives outside the graph, it has to outlast the frame
+    GLuint filtered;
+    if (temporal) {
+        filtered = m_graph.Import("ssao history", FrameBufferType::SSAO);
+        pass = MakePass(PostProcessingPassType::OcclusionTemporal, "ssao temporal", {raw, geometry}, {filtered});
+        pass.samples = samples;
+    } else {
+        filtered = m_graph.Create("occlusion low blur", FrameBufferType::SSAO, level);
+        pass = MakePass(PostProcessingPassType::OcclusionBlur, "ssao blur", {raw}, {filtered});
+    }
+    pass.level = level;
+    pass.temporal = temporal;
+    AddPass(pass);
+
+    // back to the window size without blurring across depth and normal edges
+    pass = MakePass(PostProcessingPassType::OcclusionUpsample, "ssao upsample", {scene, geometry, filtered}, {occlusion});
+    pass.level = level;
+    pass.temporal = temporal;
+    AddPass(pass);
+}
+
+// the programs the passes of the effects with more than one pass render with, see Game::BindPPFXPass
+std::vector<GLuint> CPostProcessingGraph::GetPassPrograms(const PostProcessingPassType &type)
+{
+    switch(type) {
+        case PostProcessingPassType::PyramidDownsample:
+            return {87};
+        case PostProcessingPassType::PyramidUpsample:
+            return {88};
+        case PostProcessingPassType::Convolution:
+            return {89};
+        case PostProcessingPassType::GaussianBlurComposite:
+            return {41};
+        case PostProcessingPassType::MotionBlurDepth:
+            return {4};
+        case PostProcessingPassType::MotionBlur:
+            return {44};
+        case PostProcessingPassType::Bloom:
+            return {47};
+        case PostProcessingPassType::LensFlareGhost:
+            return {48};
+        case PostProcessingPassType::LensFlare:
+            return {49};
+        case PostProcessingPassType::OcclusionDownsample:
+            return {90};
+        case PostProcessingPassType::Occlusion:
+            return {56};
+        case PostProcessingPassType::OcclusionBlur:
+            return {57};
+        case PostProcessingPassType::OcclusionTemporal:
+            return {91};
+        case PostProcessingPassType::OcclusionUpsample:
+            return {92};
+        case PostProcessingPassType::OcclusionLighting:
+            return {58};
+        case PostProcessingPassType::DepthTesting:
+            return {83};
+        case PostProcessingPassType::LightSpaceDepth:
+            return {51};
+        case PostProcessingPassType::DepthMapping:
+            return {50};
+        case PostProcessingPassType::DirectionalShadowMapping:
+            return {84};
+        case PostProcessingPassType::OmnidirectionalLightSpaceDepth:
+            return {85};
+        case PostProcessingPassType::OmnidirectionalShadowMapping:
+            return {86};
+        case PostProcessingPassType::SceneComposite:
+            return {15};
+        case PostProcessingPassType::DeferredLighting:
+            return {55};
+        case PostProcessingPassType::DeferredLamps:
+            return {4};
+        default:
+            return {};
+    }
+}
+
+GLuint CPostProcessingGraph::GetEffectProgram(const PostProcessingEffectMode &mode)
+{
+    switch(mode) {
+        case PostProcessingEffectMode::PBR:
+        case PostProcessingEffectMode::IBL:
+        case PostProcessingEffectMode::BlinnPhong:
+            return 15;
+        case PostProcessingEffectMode::ColorInversion:
+            return 16;
+        case PostProcessingEffectMode::GrayScale:
+            return 17;
+        case PostProcessingEffectMode::Kernel:
+            return 18;
+        case PostProcessingEffectMode::KernelBlur:
+            return 19;
+        case PostProcessingEffectMode::SobelEdgeDetection:
+            return 21;
+        case PostProcessingEffectMode::FreiChenEdgeDetection:
+            return 22;
+        case PostProcessingEffectMode::ScreenWave:
+            return 23;
+        case PostProcessingEffectMode::Swirl:
+            return 24;
+        case PostProcessingEffectMode::NightVision:
+            return 25;
+        case PostProcessingEffectMode::LensCircle:
+            return 26;
+        case PostProcessingEffectMode::Posterization:
+            return 27;
+        case PostProcessingEffectMode::DreamVision:
+            return 28;
+        case PostProcessingEffectMode::Pixelate:
+            return 64;
+        case PostProcessingEffectMode::Pixelation:
+            return 29;
+        case PostProcessingEffectMode::KnittedPixelation:
+            return 69;
+        case PostProcessingEffectMode::FrostedGlassPixelationEffect:
+            return 30;
+        case PostProcessingEffectMode::FrostedGlassScreenWaveEffect:
+            return 31;
+        case PostProcessingEffectMode::Crosshatching:
+            return 32;
+        case PostProcessingEffectMode::PredatorsThermalVision:
+            return 33;
+        case PostProcessingEffectMode::Toonify:
+            return 34;
+        case PostProcessingEffectMode::Shockwave:
+            return 35;
+        case PostProcessingEffectMode::FishEye:
+            return 36;
+        case PostProcessingEffectMode::BarrelDistortion:
+            return 37;
+        case PostProcessingEffectMode::MultiScreenFishEye:
+            return 38;
+        case PostProcessingEffectMode::FishEyeLens:
+            return 39;
+        case PostProcessingEffectMode::FishEyeAntiFishEye:
+            return 40;
+        case PostProcessingEffectMode::Blur:
+            return 42;
+        case PostProcessingEffectMode::RadialBlur:
+            return 43;
+        case PostProcessingEffectMode::Vignetting:
+            return 45;
+        case PostProcessingEffectMode::BrightParts:
+            return 46;
+        case PostProcessingEffectMode::HDRToneMapping:
+            return 52;
+        case PostProcessingEffectMode::FXAA:
+            return 53;
+        case PostProcessingEffectMode::RainDrops:
+            return 59;
+        case PostProcessingEffectMode::PaletteQuantizationAndDithering:
+            return 61;
+        case PostProcessingEffectMode::DistortedTV:
+            return 62;
+        case PostProcessingEffectMode::RGBDisplay:
+            return 63;
+        case PostProcessingEffectMode::RetroParallax:
+            return 66;
+        case PostProcessingEffectMode::MoneyFilter:
+            return 67;
+        case PostProcessingEffectMode::MicroprismMosaic:
+            return 68;
+        case PostProcessingEffectMode::BayerMatrixDithering:
+            return 70;
+        case PostProcessingEffectMode::JuliaFreak:
+            return 71;
+        case PostProcessingEffectMode::HeartBlend:
+            return 72;
+        case PostProcessingEffectMode::EMInterference:
+            return 73;
+        case PostProcessingEffectMode::CubicLensDistortion:
+            return 74;
+        case PostProcessingEffectMode::CelShaderish:
+            return 75;
+        case PostProcessingEffectMode::CartoonVideo:
+            return 76;
+        default:
+            return 15;
+    }
+}
+
+FrameBufferType CPostProcessingGraph::GetSceneType(const PostProcessingEffectMode &mode)
+{
+    switch(mode) {
+        case PostProcessingEffectMode::GaussianBlur:
+            return FrameBufferType::HighDynamicRangeRendering;
+        case PostProcessingEffectMode::BrightParts:
+            return FrameBufferType::HighDynamicRangeRendering;
+        case PostProcessingEffectMode::Bloom:
+            return FrameBufferType::HighDynamicRangeRendering;
+        case PostProcessingEffectMode::HDRToneMapping:
+            return FrameBufferType::HighDynamicRangeLighting;
+        case PostProcessingEffectMode::LensFlare:
+            return FrameBufferType::HighDynamicRangeRendering;
+        case PostProcessingEffectMode::DeferredRendering:
+            return FrameBufferType::DeferredRendering;
+        case PostProcessingEffectMode::SSAO:
+            return FrameBufferType::GeometryBuffer;
+        default:
+            return FrameBufferType::Default;
+    }
+}
+
+bool CPostProcessingGraph::IsConvolution(const PostProcessingEffectMode &mode)
+{
+    switch(mode) {
+        case PostProcessingEffectMode::Kernel:
+        case PostProcessingEffectMode::KernelBlur:
+        case PostProcessingEffectMode::SobelEdgeDetection:
+        case PostProcessingEffectMode::FreiChenEdgeDetection:
+        case PostProcessingEffectMode::Blur:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool CPostProcessingGraph::IsStackable(const PostProcessingEffectMode &mode)
+{
+    switch(mode) {
+        case PostProcessingEffectMode::PBR:
+        case PostProcessingEffectMode::IBL:
+        case PostProcessingEffectMode::BlinnPhong:
+        case PostProcessingEffectMode::GaussianBlur:
+        case PostProcessingEffectMode::MotionBlur:
+        case PostProcessingEffectMode::BrightParts:
+        case PostProcessingEffectMode::Bloom:
+        case PostProcessingEffectMode::HDRToneMapping:
+        case PostProcessingEffectMode::LensFlare:
+        case PostProcessingEffectMode::SSAO:
+        case PostProcessingEffectMode::DepthTesting:
+        case PostProcessingEffectMode::DepthMapping:
+        case PostProcessingEffectMode::DirectionalShadowMapping:
+        case PostProcessingEffectMode::OmnidirectionalShadowMapping:
+        case PostProcessingEffectMode::DeferredRendering:
+            return false;
+        default:
+            return true;
+    }
+}
+
+const char *CPostProcessingGraph::GetStackFunction(const PostProcessingEffectMode &mode)
+{
+    switch(mode) {
+        case PostProcessingEffectMode::ColorInversion:
+            return "colorInversion";
+        case PostProcessingEffectMode::GrayScale:
+            return "grayScale";
+        case PostProcessingEffectMode::Posterization:
+            return "posterization";
+        case PostProcessingEffectMode::PredatorsThermalVision:
+            return "predatorsThermalVision";
+        case PostProcessingEffectMode::Vignetting:
+            return "vignetting";
+        case PostProcessingEffectMode::BayerMatrixDithering:
+            return "bayerMatrixDithering";
+        default:
+            return nullptr;
+    }
+}
+
+std::vector<std::vector<PostProcessingEffectMode>> CPostProcessingGraph::GetStackRuns(const std::vector<PostProcessingEffectMode> &stack)
+{
+    // an effect that reads the neighbourhood of its texels needs the whole result before it, so it splits the stack
+    std::vector<std::vector<PostProcessingEffectMode>> runs;
+    for (const PostProcessingEffectMode &effect : stack) {
+        if (runs.empty() || GetStackFunction(effect) == nullptr || GetStackFunction(runs.back().back()) == nullptr)
+            runs.push_back({});
+        runs.back().push_back(effect);
+    }
+    return runs;
+}
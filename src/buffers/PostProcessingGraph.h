@@ -0,0 +1,120 @@
+//
+//  PostProcessingGraph.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef PostProcessingGraph_h
+#define PostProcessingGraph_h
+
+#include "RenderGraph.h"
+#include "../utilities/PostProcessingEffectMode.h"
+#include "../utilities/SSAOQuality.h"
+
+// what a pass of a post processing graph does, the game turns each kind into the function the pass runs
+enum class PostProcessingPassType {
+    Effect,                         // one full screen pass of an effect over the scene, see Game::RenderPPFXScene
+    Stack,                          // a run of the effect stack, fused into one program when it holds more than one effect
+    PyramidDownsample,              // the mip chain shared by blur, bloom and lens flare
+    PyramidUpsample,
+    Convolution,                    // compute pass of a convolution effect
+    ConvolutionPresent,
+    GaussianBlurComposite,
+    MotionBlurDepth,
+    MotionBlur,
+    Bloom,
+    LensFlareGhost,
+    LensFlare,
+    OcclusionDownsample,            // ssao, the passes of a quality tier
+    Occlusion,
+    OcclusionBlur,
+    OcclusionTemporal,
+    OcclusionUpsample,
+    OcclusionLighting,
+    DepthTesting,
+    LightSpaceDepth,                // depth mapping and directional shadows
+    DepthMapping,
+    DirectionalShadowMapping,
+    OmnidirectionalLightSpaceDepth,
+    OmnidirectionalShadowMapping,
+    SceneComposite,                 // depth testing and both shadow effects, the target they rendered over the scene
+    DeferredLighting,
+    DeferredLamps,
+};
+
+// a pass as it is declared, reads and writes are the graph resources in the order the declaration lists them
+struct PostProcessingPass {
+    PostProcessingPassType type;
+    PostProcessingEffectMode mode;
+    std::string name;
+    std::vector<GLuint> reads;
+    std::vector<GLuint> writes;
+    std::vector<GLuint> programs;   // the shader programs the pass renders with, indices into the game's programs
+
+    GLuint index;                   // pyramid passes, the step from the window size, the first downsample is 0
+    GLuint sourceIndex;             // first downsample, the colour attachment of the scene it reads
+    GLuint level;                   // occlusion passes, the occlusion is 1/2^level of the window size
+    GLuint samples;                 // occlusion passes, kernel samples taken each frame
+    GLboolean temporal;             // occlusion passes of the temporal tiers
+    GLboolean first, last;          // stack runs, and the convolution pass that writes the filtered result
+    glm::vec2 direction;            // of a separable convolution pass, zero for the others
+    std::vector<PostProcessingEffectMode> effects;  // of a stack run
+};
+
+// what the passes of an effect depend on besides the effect
+struct PostProcessingGraphSettings {
+    GLboolean compute;              // convolution effects filter in compute shaders
+    GLuint pyramidLevels;           // the mip chain goes down to 1/2^pyramidLevels of the window
+    SSAOQuality ssaoQuality;
+    std::vector<PostProcessingEffectMode> stack;
+};
+
+// Declares the passes of a post processing effect into a render graph. Which passes an effect takes and the
+// targets they read and write are decided here, what a pass does is up to the binder, so a graph can be
+// built and checked without a GL context.
+class CPostProcessingGraph
+{
+public:
+    // the function a declared pass runs, an empty binder leaves the passes without one
+    typedef std::function<std::function<void()>(const PostProcessingPass &)> Binder;
+
+    CPostProcessingGraph(CRenderGraph &graph, const PostProcessingGraphSettings &settings, const Binder &bind = Binder());
+
+    // clears the graph, declares the passes of the effect and compiles them to the screen
+    bool Declare(const PostProcessingEffectMode &mode);
+
+    // the program of an effect that is one full screen pass over the scene
+    static GLuint GetEffectProgram(const PostProcessingEffectMode &mode);
+    // the scene target an effect renders the scene into
+    static FrameBufferType GetSceneType(const PostProcessingEffectMode &mode);
+    // effects that are plain convolutions over the scene and have a compute path
+    static bool IsConvolution(const PostProcessingEffectMode &mode);
+    // effects that are one full screen pass over the plain scene target, the ones the stack can hold
+    static bool IsStackable(const PostProcessingEffectMode &mode);
+    // function of a pointwise effect in PostProcessingStackShader.frag, nullptr for effects that read neighbouring texels
+    static const char *GetStackFunction(const PostProcessingEffectMode &mode);
+    // the stack split into the runs that are one pass each
+    static std::vector<std::vector<PostProcessingEffectMode>> GetStackRuns(const std::vector<PostProcessingEffectMode> &stack);
+
+private:
+    void AddPass(const PostProcessingPass &pass);
+    static std::vector<GLuint> GetPassPrograms(const PostProcessingPassType &type);
+    PostProcessingPass MakePass(const PostProcessingPassType &type, const std::string &name,
+                                const std::vector<GLuint> &reads, const std::vector<GLuint> &writes) const;
+
+    GLuint DeclarePyramid(const GLuint &source, const GLuint &sourceIndex);
+    void DeclareConvolution(const GLuint &scene, const GLuint &screen);
+    void DeclareStack(const GLuint &scene, const GLuint &screen);
+    void DeclareOcclusion(const GLuint &scene, const GLuint &occlusion);
+
+    CRenderGraph &m_graph;
+    PostProcessingGraphSettings m_settings;
+    Binder m_bind;
+    PostProcessingEffectMode m_mode;
+};
+
+#endif /* PostProcessingGraph_h */
@@ -0,0 +1,89 @@
+//
+//  RangeAllocator.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "RangeAllocator.h"
+
+CRangeAllocator::CRangeAllocator(const GLuint &capacity) : m_capacity(0), m_used(0)
+{
+    Grow(capacity);
+}
+
+GLboolean CRangeAllocator::Allocate(const GLuint &size, GLuint &offset)
+{
+    if (size == 0)
+        return false;
+
+    for (GLuint i = 0; i < m_free.size(); ++i) {
+        Block &block = m_free[i];
+        if (block.size < size) continue;
+        offset = block.offset;
+        block.offset += size;
+        block.size -= size;
+        if (block.size == 0) m_free.erase(m_free.begin() + i);
+        m_used += size;
+        return true;
+    }
+    return false;
+}
+
+void CRangeAllocator::Free(const GLuint &offset, const GLuint &size)
+{
+    if (size == 0)
+        return;
+
+    // the first free block after the range, the range goes in front of it
+    std::vector<Block>::iterator next = std::lower_bound(m_free.begin(), m_free.end(), offset,
+                                                         [](const Block &block, const GLuint &value) { return block.offset < value; });
+    const GLboolean joinsPrevious = next != m_free.begin() && (next - 1)->offset + (next - 1)->size == offset;
+    const GLboolean joinsNext = next != m_free.end() && offset + size == next->offset;
+
+    if (joinsPrevious && joinsNext) {
+        (next - 1)->size += size + next->size;
+        m_free.erase(next);
+    } else if (joinsPrevious) {
+        (next - 1)->size += size;
+    } else if (joinsNext) {
+        next->offset = offset;
+        next->size += size;
+    } else {
+        m_free.insert(next, Block{offset, size});
+    }
+    m_used -= size;
+}
+
+void CRangeAllocator::Grow(const GLuint &size)
+{
+    if (size == 0)
+        return;
+
+    if (!m_free.empty() && m_free.back().offset + m_free.back().size == m_capacity) m_free.back().size += size;
+    else m_free.push_back(Block{m_capacity, size});
+    m_capacity += size;
+}
+
+void CRangeAllocator::Reset(const GLuint &used)
+{
+    m_free.clear();
+    m_used = used;
+    if (used < m_capacity) m_free.push_back(Block{used, m_capacity - used});
+}
+
+GLuint CRangeAllocator::GetLargestFree() const
+{
+    GLuint largest = 0;
+    for (const Block &block : m_free) largest = std::max(largest, block.size);
+    return largest;
+}
+
+GLfloat CRangeAllocator::GetFragmentation() const
+{
+    const GLuint free = GetFree();
+    if (free == 0)
+        return 0.0f;
+    return 1.0f - static_cast<GLfloat>(GetLargestFree()) / static_cast<GLfloat>(free);
+}
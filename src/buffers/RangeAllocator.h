@@ -0,0 +1,49 @@
+//
+//  RangeAllocator.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef RangeAllocator_h
+#define RangeAllocator_h
+
+#include "../BuffersBase.h"
+
+// Hands out ranges of elements between 0 and its capacity, first fit. The free blocks are kept sorted by offset
+// and a returned range is merged with the free blocks on either side, so the free space is in as few blocks as
+// the live ranges allow. Nothing here touches OpenGL, see CGeometryArena for the buffers behind the ranges.
+class CRangeAllocator
+{
+public:
+    CRangeAllocator(const GLuint &capacity = 0);
+
+    // false when no free block is large enough
+    GLboolean Allocate(const GLuint &size, GLuint &offset);
+    void Free(const GLuint &offset, const GLuint &size);
+    // adds elements after the current capacity
+    void Grow(const GLuint &size);
+    // the first used elements are taken and the rest is one free block, for after the ranges were packed
+    void Reset(const GLuint &used);
+
+    GLuint GetCapacity() const { return m_capacity; }
+    GLuint GetUsed() const { return m_used; }
+    GLuint GetFree() const { return m_capacity - m_used; }
+    GLuint GetLargestFree() const;
+    GLuint GetFreeBlockCount() const { return static_cast<GLuint>(m_free.size()); }
+    // 0 when the free space is a single block, closer to 1 the more it is split into small ones
+    GLfloat GetFragmentation() const;
+
+private:
+    struct Block {
+        GLuint offset, size;
+    };
+
+    std::vector<Block> m_free;
+    GLuint m_capacity, m_used;
+};
+
+#endif /* RangeAllocator_h */
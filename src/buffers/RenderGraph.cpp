@@ -0,0 +1,173 @@
+//
+//  RenderGraph.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "RenderGraph.h"
+
+CRenderGraph::CRenderGraph()
+{
+    m_uiOutput = 0;
+    m_bCompiled = false;
+}
+
+void CRenderGraph::Clear()
+{
+    m_resources.clear();
+    m_passes.clear();
+    m_schedule.clear();
+    m_slotCounts.clear();
+    m_uiOutput = 0;
+    m_bCompiled = false;
+}
+
+GLuint CRenderGraph::AddResource(const std::string &name, const FrameBufferType &type, const GLuint &level, const GLboolean &imported)
+{
+    m_resources.push_back(Resource{name, type, level, imported, -1, -1, -1});
+    m_bCompiled = false;
+    return static_cast<GLuint>(m_resources.size() - 1);
+}
+
+GLuint CRenderGraph::Import(const std::string &name, const FrameBufferType &type)
+{
+    return AddResource(name, type, 0, true);
+}
+
+GLuint CRenderGraph::Create(const std::string &name, const FrameBufferType &type, const GLuint &level)
+{
+    return AddResource(name, type, level, false);
+}
+
+void CRenderGraph::AddPass(const std::string &name, const std::vector<GLuint> &reads, const std::vector<GLuint> &writes,
+                           const std::function<void()> &execute)
+{
+    m_passes.push_back(Pass{name, reads, writes, execute});
+    m_bCompiled = false;
+}
+
+bool CRenderGraph::Compile(const GLuint &output)
+{
+    m_schedule.clear();
+    m_slotCounts.clear();
+    m_uiOutput = output;
+    m_bCompiled = false;
+    for (Resource &resource : m_resources) {
+        resource.firstPass = -1;
+        resource.lastPass = -1;
+        resource.slot = -1;
+    }
+    if (output >= m_resources.size())
+        return false;
+
+    // walk back from the output, a pass is kept when a kept pass reads what it writes
+    std::vector<GLboolean> needed(m_resources.size(), false);
+    std::vector<GLboolean> kept(m_passes.size(), false);
+    needed[output] = true;
+    for (GLint i = static_cast<GLint>(m_passes.size()) - 1; i >= 0; --i) {
+        const Pass &pass = m_passes[i];
+        for (GLuint resource : pass.writes) {
+            if (needed[resource]) kept[i] = true;
+        }
+        if (!kept[i]) continue;
+        for (GLuint resource : pass.reads) needed[resource] = true;
+    }
+
+    // passes run in the order they were declared, lifetimes are positions in that order
+    for (GLuint i = 0; i < m_passes.size(); ++i) {
+        if (!kept[i]) continue;
+        GLint position = static_cast<GLint>(m_schedule.size());
+        m_schedule.push_back(i);
+
+        std::vector<GLuint> used = m_passes[i].reads;
+        used.insert(used.end(), m_passes[i].writes.begin(), m_passes[i].writes.end());
+        for (GLuint index : used) {
+            Resource &resource = m_resources[index];
+            if (resource.firstPass < 0) resource.firstPass = position;
+            resource.lastPass = position;
+        }
+    }
+
+    // first fit in order of first use, a slot is free again once its last user has run
+    std::vector<GLuint> order;
+    for (GLuint i = 0; i < m_resources.size(); ++i) {
+        if (!m_resources[i].imported && m_resources[i].firstPass >= 0) order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [this](GLuint a, GLuint b) {
+        return m_resources[a].firstPass < m_resources[b].firstPass;
+    });
+
+    std::map<std::pair<FrameBufferType, GLuint>, std::vector<GLint>> slotsFreeAfter;
+    for (GLuint index : order) {
+        Resource &resource = m_resources[index];
+        std::vector<GLint> &slots = slotsFreeAfter[std::make_pair(resource.type, resource.level)];
+        GLuint slot = 0;
+        while (slot < slots.size() && slots[slot] >= resource.firstPass) slot++;
+        if (slot == slots.size()) slots.push_back(-1);
+        slots[slot] = resource.lastPass;
+        resource.slot = static_cast<GLint>(slot);
+    }
+    for (auto &slots : slotsFreeAfter)
+        m_slotCounts[slots.first] = static_cast<GLuint>(slots.second.size());
+
+    m_bCompiled = true;
+    return true;
+}
+
+void CRenderGraph::Execute() const
+{
+    for (GLuint pass : m_schedule) {
+        if (m_passes[pass].execute) m_passes[pass].execute();
+    }
+}
+
+GLuint CRenderGraph::GetSlotCount(const FrameBufferType &type, const GLuint &level) const
+{
+    auto it = m_slotCounts.find(std::make_pair(type, level));
+    return it == m_slotCounts.end() ? 0 : it->second;
+}
+
+bool CRenderGraph::Validate() const
+{
+    if (!m_bCompiled) {
+        printf("Render graph: not compiled\n");
+        return false;
+    }
+
+    bool bValid = true;
+    std::vector<GLboolean> written(m_resources.size(), false);
+    for (GLuint pass : m_schedule) {
+        for (GLuint resource : m_passes[pass].reads) {
+            if (!m_resources[resource].imported && !written[resource]) {
+                printf("Render graph: pass %s reads %s before it is written\n", m_passes[pass].name.c_str(), m_resources[resource].name.c_str());
+                bValid = false;
+            }
+        }
+        for (GLuint resource : m_passes[pass].writes) written[resource] = true;
+    }
+    if (!written[m_uiOutput]) {
+        printf("Render graph: nothing writes the output %s\n", m_resources[m_uiOutput].name.c_str());
+        bValid = false;
+    }
+
+    for (GLuint i = 0; i < m_resources.size(); ++i) {
+        const Resource &a = m_resources[i];
+        if (a.imported || a.firstPass < 0) continue;
+        if (a.slot < 0 || a.slot >= static_cast<GLint>(GetSlotCount(a.type, a.level))) {
+            printf("Render graph: %s has no pool slot\n", a.name.c_str());
+            bValid = false;
+            continue;
+        }
+        for (GLuint j = i + 1; j < m_resources.size(); ++j) {
+            const Resource &b = m_resources[j];
+            if (b.imported || b.firstPass < 0 || b.type != a.type || b.level != a.level || b.slot != a.slot) continue;
+            if (a.firstPass <= b.lastPass && b.firstPass <= a.lastPass) {
+                printf("Render graph: %s and %s share a slot while both are alive\n", a.name.c_str(), b.name.c_str());
+                bValid = false;
+            }
+        }
+    }
+    return bValid;
+}
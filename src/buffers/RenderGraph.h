@@ -0,0 +1,79 @@
+//
+//  RenderGraph.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef RenderGraph_h
+#define RenderGraph_h
+
+#include "../BuffersBase.h"
+#include <functional>
+
+// Passes declare the render targets they read and write, in the order they run. Compile culls the
+// passes that do not lead to the output, works out when each transient target is first and last used
+// and gives targets of the same type and size whose lifetimes do not overlap the same pool slot. Nothing here
+// touches GL, executing a pass is up to its callback, so a graph can be built and checked without a GPU.
+class CRenderGraph
+{
+public:
+    CRenderGraph();
+
+    void Clear();
+
+    // targets that live outside the graph, like the scene framebuffers and the screen
+    GLuint Import(const std::string &name, const FrameBufferType &type);
+    // targets that only live for this graph, they are taken from the pool, level n is 1/2^n of the window size
+    GLuint Create(const std::string &name, const FrameBufferType &type, const GLuint &level = 0);
+
+    void AddPass(const std::string &name, const std::vector<GLuint> &reads, const std::vector<GLuint> &writes,
+                 const std::function<void()> &execute);
+
+    // schedules the passes the output depends on and assigns the pool slots
+    bool Compile(const GLuint &output);
+    void Execute() const;
+
+    // checks the compiled schedule and aliasing plan, prints what is wrong
+    bool Validate() const;
+
+    bool IsCompiled() const { return m_bCompiled; }
+    GLuint GetPassCount() const { return static_cast<GLuint>(m_passes.size()); }
+    const std::vector<GLuint> &GetSchedule() const { return m_schedule; }
+    const std::string &GetPassName(const GLuint &pass) const { return m_passes[pass].name; }
+    FrameBufferType GetType(const GLuint &resource) const { return m_resources[resource].type; }
+    GLuint GetLevel(const GLuint &resource) const { return m_resources[resource].level; }
+    GLboolean IsImported(const GLuint &resource) const { return m_resources[resource].imported; }
+    // pool slot among the targets of the resource's type and level, -1 for imported or unused resources
+    GLint GetSlot(const GLuint &resource) const { return m_resources[resource].slot; }
+    GLuint GetSlotCount(const FrameBufferType &type, const GLuint &level = 0) const;
+
+private:
+    struct Resource {
+        std::string name;
+        FrameBufferType type;
+        GLuint level;
+        GLboolean imported;
+        GLint firstPass, lastPass; // positions in the schedule, -1 while unused
+        GLint slot;
+    };
+    struct Pass {
+        std::string name;
+        std::vector<GLuint> reads, writes;
+        std::function<void()> execute;
+    };
+
+    GLuint AddResource(const std::string &name, const FrameBufferType &type, const GLuint &level, const GLboolean &imported);
+
+    std::vector<Resource> m_resources;
+    std::vector<Pass> m_passes;
+    std::vector<GLuint> m_schedule; // pass indices in execution order
+    std::map<std::pair<FrameBufferType, GLuint>, GLuint> m_slotCounts; // by type and level
+    GLuint m_uiOutput;
+    GLboolean m_bCompiled;
+};
+
+#endif /* RenderGraph_h */
@@ -0,0 +1,55 @@
+//
+//  RenderTargetPool.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "RenderTargetPool.h"
+#include "FrameBufferObject.h"
+
+CRenderTargetPool::CRenderTargetPool()
+{
+    m_uiWidth = 0;
+    m_uiHeight = 0;
+    m_uiAllocations = 0;
+}
+
+CRenderTargetPool::~CRenderTargetPool()
+{
+    Release();
+}
+
+GLboolean CRenderTargetPool::Resize(const GLuint &width, const GLuint &height)
+{
+    if (width == m_uiWidth && height == m_uiHeight)
+        return false;
+
+    // every size in the pool is derived from the window, none of them fit any more
+    Release();
+    m_uiWidth = width;
+    m_uiHeight = height;
+    return true;
+}
+
+CFrameBufferObject *CRenderTargetPool::Acquire(const FrameBufferType &type, const GLuint &width, const GLuint &height, const GLuint &index)
+{
+    for (const Target &target : m_targets) {
+        if (target.type == type && target.width == width && target.height == height && target.index == index)
+            return target.pFBO;
+    }
+
+    CFrameBufferObject *pFBO = new CFrameBufferObject;
+    pFBO->CreateFramebuffer(width, height, type);
+    m_targets.push_back(Target{width, height, type, index, pFBO});
+    m_uiAllocations++;
+    return pFBO;
+}
+
+void CRenderTargetPool::Release()
+{
+    for (Target &target : m_targets)
+        delete target.pFBO;
+    m_targets.clear();
+}
@@ -0,0 +1,50 @@
+//
+//  RenderTargetPool.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef RenderTargetPool_h
+#define RenderTargetPool_h
+
+#include "../BuffersBase.h"
+
+class CFrameBufferObject;
+
+// Keeps framebuffers alive across effect switches. A target is found by its size, its type, which
+// decides the formats of its attachments, and an index for effects that need several of one kind.
+// It is allocated the first time it is asked for and only freed when the window size changes.
+class CRenderTargetPool
+{
+public:
+    CRenderTargetPool();
+    ~CRenderTargetPool();
+
+    // frees every target when the size is not the one they were made for, returns true if it did
+    GLboolean Resize(const GLuint &width, const GLuint &height);
+
+    CFrameBufferObject *Acquire(const FrameBufferType &type, const GLuint &width, const GLuint &height, const GLuint &index);
+    void Release();
+
+    GLuint GetCount() const { return static_cast<GLuint>(m_targets.size()); }
+    // targets created since the start, a switch that reuses the pool adds none
+    GLuint GetAllocations() const { return m_uiAllocations; }
+
+private:
+    struct Target {
+        GLuint width, height;
+        FrameBufferType type;
+        GLuint index;
+        CFrameBufferObject *pFBO;
+    };
+
+    std::vector<Target> m_targets;
+    GLuint m_uiWidth, m_uiHeight;
+    GLuint m_uiAllocations;
+};
+
+#endif /* RenderTargetPool_h */
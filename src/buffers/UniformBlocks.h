@@ -0,0 +1,98 @@
+//
+//  UniformBlocks.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef UniformBlocks_h
+#define UniformBlocks_h
+
+#include "../BuffersBase.h"
+
+/*
+ CPU mirrors of the std140 uniform blocks declared in the shaders.
+ std140 aligns vec3 and structs to 16 bytes, a float may fill the last 4 bytes of a vec3
+ and a bool is stored as a 4 byte int, so the padding below is explicit and the sizes are checked.
+ */
+
+struct CameraBlock
+{
+    glm::vec3 position;
+    GLfloat pad0;
+    glm::vec3 front;
+    GLfloat znear;
+    GLfloat zfar;
+    GLint isMoving;
+    GLint isOrthographic;
+    GLfloat pad1;
+};
+
+struct BaseLightBlock
+{
+    glm::vec3 color;
+    GLfloat intensity;
+    GLfloat ambient;
+    GLfloat diffuse;
+    GLfloat specular;
+    GLfloat pad0;
+};
+
+struct AttenuationBlock
+{
+    GLfloat constant;
+    GLfloat linear;
+    GLfloat exponent;
+    GLfloat pad0;
+};
+
+struct DirectionalLightBlock
+{
+    BaseLightBlock base;
+    glm::vec3 direction;
+    GLfloat pad0;
+    glm::vec3 position;
+    GLfloat pad1;
+};
+
+struct PointLightBlock
+{
+    BaseLightBlock base;
+    AttenuationBlock attenuation;
+    glm::vec3 position;
+    GLfloat range;
+};
+
+struct SpotLightBlock
+{
+    PointLightBlock pointLight;
+    glm::vec3 direction;
+    GLfloat cutOff;
+    GLfloat outerCutOff;
+    GLfloat pad0[3];
+};
+
+struct LightsBlock
+{
+    DirectionalLightBlock directionalLight;
+    PointLightBlock pointLights[NUMBER_OF_POINT_LIGHTS];
+    SpotLightBlock spotLight;
+};
+
+struct ShadowBlock
+{
+    glm::mat4 lightSpaceMatrix;
+    glm::mat4 shadowMatrices[6];
+};
+
+static_assert(sizeof(CameraBlock) == 48, "CameraBlock does not match the std140 layout");
+static_assert(sizeof(DirectionalLightBlock) == 64, "DirectionalLightBlock does not match the std140 layout");
+static_assert(sizeof(PointLightBlock) == 64, "PointLightBlock does not match the std140 layout");
+static_assert(sizeof(SpotLightBlock) == 96, "SpotLightBlock does not match the std140 layout");
+static_assert(sizeof(LightsBlock) == 64 + 64 * NUMBER_OF_POINT_LIGHTS + 96, "LightsBlock does not match the std140 layout");
+static_assert(sizeof(ShadowBlock) == 448, "ShadowBlock does not match the std140 layout");
+
+#endif /* UniformBlocks_h */
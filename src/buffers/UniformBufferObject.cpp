@@ -0,0 +1,59 @@
+//
+//  UniformBufferObject.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "UniformBufferObject.h"
+
+/*   https://learnopengl.com/Advanced-OpenGL/Advanced-GLSL
+ A uniform buffer is bound to one of the indexed GL_UNIFORM_BUFFER binding points and every program links its
+ uniform block to that same binding point, so the data is uploaded once and read by all programs.
+ The block uses the std140 layout so the offsets on the CPU side are fixed and do not need to be queried.
+ */
+
+CUniformBufferObject::CUniformBufferObject() : m_ubo(0), m_bindingPoint(0), m_size(0)
+{
+}
+
+CUniformBufferObject::~CUniformBufferObject()
+{
+    Release();
+}
+
+// Create a UBO of the given size and attach it to the block's binding point
+void CUniformBufferObject::Create(const UniformBlockType &type, const GLsizeiptr &size)
+{
+    if (m_ubo == 0) glGenBuffers(1, &m_ubo);
+    m_bindingPoint = static_cast<GLuint>(type);
+    m_size = size;
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    
+    glBindBufferBase(GL_UNIFORM_BUFFER, m_bindingPoint, m_ubo);
+}
+
+// Upload new contents, the binding point keeps pointing at this buffer
+void CUniformBufferObject::UpdateData(const void *ptrData, const GLsizeiptr &size, const GLintptr &offset)
+{
+    if (m_ubo == 0 || offset + size > m_size) {
+        std::cout << "Uniform buffer update out of range: " << offset + size << " > " << m_size << std::endl;
+        return;
+    }
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, ptrData);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+// Release the UBO
+void CUniformBufferObject::Release()
+{
+    if (m_ubo != 0) glDeleteBuffers(1, &m_ubo);
+    m_ubo = 0;
+    m_size = 0;
+}
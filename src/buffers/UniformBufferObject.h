@@ -0,0 +1,36 @@
+//
+//  UniformBufferObject.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef UniformBufferObject_h
+#define UniformBufferObject_h
+
+#include "../BuffersBase.h"
+#include "../utilities/UniformBlockType.h"
+
+// This class provides a wrapper around an OpenGL Uniform Buffer Object bound to a fixed binding point
+class CUniformBufferObject
+{
+public:
+    CUniformBufferObject();
+    ~CUniformBufferObject();
+    
+    void Create(const UniformBlockType &type, const GLsizeiptr &size);  // Allocates the UBO and binds it to the block's binding point
+    void UpdateData(const void *ptrData, const GLsizeiptr &size, const GLintptr &offset = 0); // Overwrites part of the UBO
+    void Release();                                                     // Releases the UBO
+    
+    GLuint GetBindingPoint() const { return m_bindingPoint; }
+    
+private:
+    GLuint m_ubo;                                   // UBO id
+    GLuint m_bindingPoint;                          // Indexed GL_UNIFORM_BUFFER binding
+    GLsizeiptr m_size;                              // Allocated size in bytes
+};
+
+#endif /* UniformBufferObject_h */
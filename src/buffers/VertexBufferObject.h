@@ -16,6 +16,7 @@ public:
     void CopyTo(const GLenum &writetarget, const GLsizeiptr &size);
 	void AddData(void* ptrData, uint dataSize);	// Adds data to the VBO
 	void UploadDataToGPU(int usageHint);			// Uploads the VBO to the GPU
+    GLuint GetBuffer() const { return m_vbo; }      // VBO id
 
 	
 private:
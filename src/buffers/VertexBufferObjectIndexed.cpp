@@ -1,4 +1,5 @@
 #include "VertexBufferObjectIndexed.h"
+#include "GeometryArena.h"
 
 /*   https://learnopengl.com/#!Advanced-OpenGL/Advanced-Data
  A buffer in OpenGL is only an object that manages a certain piece of memory and nothing more. We give a meaning to a buffer when binding it to a specific buffer target. A buffer is only a vertex array buffer when we bind it to GL_ARRAY_BUFFER, but we could just as easily bind it to GL_ELEMENT_ARRAY_BUFFER. OpenGL internally stores a buffer per target and based on the target, processes the buffers differently.
@@ -9,6 +10,8 @@
 CVertexBufferObjectIndexed::CVertexBufferObjectIndexed()
 {
 	m_dataUploaded = false;
+    m_vboVertices = 0;
+    m_vboIndices = 0;
 }
 
 CVertexBufferObjectIndexed::~CVertexBufferObjectIndexed()
@@ -114,6 +117,20 @@ void CVertexBufferObjectIndexed::UploadDataToGPU(int iUsageHint)
 	m_indexData.clear();
 }
 
+// Static meshes share the buffers of the arena instead of creating their own, nothing needs to be bound and
+// the handle is what draws them. Afterwards, the data can be cleared.
+GLuint CVertexBufferObjectIndexed::UploadDataToArena(const VertexLayout &layout)
+{
+    GLuint handle = CGeometryArena::Instance().Allocate(layout, m_vertexData.data(),
+                                                       static_cast<GLuint>(m_vertexData.size() / CGeometryArena::GetStride(layout)),
+                                                       reinterpret_cast<const GLuint*>(m_indexData.data()),
+                                                       static_cast<GLuint>(m_indexData.size() / sizeof(GLuint)));
+    m_dataUploaded = handle != 0;
+    m_vertexData.clear();
+    m_indexData.clear();
+    return handle;
+}
+
 // Adds data to the VBO.  
 void CVertexBufferObjectIndexed::AddVertexData(void* ptrVertexData, uint uiVertexDataSize)
 {
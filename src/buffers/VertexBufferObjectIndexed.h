@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../BuffersBase.h"
+#include "../utilities/VertexLayout.h"
 
 class CVertexBufferObjectIndexed
 {
@@ -16,6 +17,9 @@ public:
 	void AddVertexData(void* pVertexData, uint vertexDataSize);	// Adds vertex data
 	void AddIndexData(void* pIndexData, uint indexDataSize);	// Adds index data
 	void UploadDataToGPU(int iUsageHint);			// Upload the VBO to the GPU
+    GLuint UploadDataToArena(const VertexLayout &layout);    // Copies the data into the geometry arena, returns the handle
+    GLuint GetVertexBuffer() const { return m_vboVertices; }   // VBO id for vertices
+    GLuint GetIndexBuffer() const { return m_vboIndices; }     // VBO id for indices
     
 
 private:
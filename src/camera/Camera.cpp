@@ -484,6 +484,26 @@ glm::mat4 CCamera::GetViewProjection() const {
     return this->m_perspectiveProjectionMatrix * this->m_viewMatrix;
 }
 
+void CCamera::GetFrustumPlanes(glm::vec4 planes[6]) const {
+    ExtractFrustumPlanes(GetViewProjection(), planes);
+}
+
+// http://www8.cs.umu.se/kurser/5DV051/HT12/lab/plane_extraction.pdf
+// A point p is inside when -w <= x, y, z <= w for (x, y, z, w) = M p, so every plane is the last row of M plus or
+// minus one of the others. The planes are normalised so plane.xyz . p + plane.w is a distance in world units.
+void CCamera::ExtractFrustumPlanes(const glm::mat4 &viewProjection, glm::vec4 planes[6]) {
+    glm::mat4 m = glm::transpose(viewProjection); // rows of the matrix as columns
+    planes[0] = m[3] + m[0];   // left
+    planes[1] = m[3] - m[0];   // right
+    planes[2] = m[3] + m[1];   // bottom
+    planes[3] = m[3] - m[1];   // top
+    planes[4] = m[3] + m[2];   // near
+    planes[5] = m[3] - m[2];   // far
+    for (GLuint i = 0; i < 6; ++i) {
+        planes[i] /= glm::length(glm::vec3(planes[i]));
+    }
+}
+
 // The normal matrix is used to transform normals to eye coordinates -- part of lighting calculations
 glm::mat3 CCamera::ComputeNormalMatrix(const glm::mat4 &modelMatrix)
 {
@@ -22,6 +22,7 @@ public:
     glm::vec3 GetView() const;                        // Gets the position of the camera view point
     glm::vec3 GetStrafeVector() const;                // Gets the camera strafe vector
     glm::mat4 GetViewProjection() const;
+    void GetFrustumPlanes(glm::vec4 planes[6]) const;   // Gets the planes of the perspective view frustum in world space
 	glm::mat4* GetPerspectiveProjectionMatrix();	    // Gets the camera perspective projection matrix
 	glm::mat4* GetOrthographicProjectionMatrix();	    // Gets the camera orthographic projection matrix
 	glm::mat4 GetViewMatrix() const;				    // Gets the camera view matrix - note this is not stored in the class but returned using
@@ -87,6 +88,9 @@ public:
     
     glm::mat3 ComputeNormalMatrix(const glm::mat4 &modelMatrix);
     
+    // Extract the left, right, bottom, top, near and far planes of any view projection, normals point inwards
+    static void ExtractFrustumPlanes(const glm::mat4 &viewProjection, glm::vec4 planes[6]);
+    
     void Release();
     
 private:
@@ -7,6 +7,7 @@
 //
 
 #include "Button.h"
+#include "../window/GLState.h"
 
 
 CButton::CButton(std::string label, GUIBoxData *data,
@@ -27,7 +28,7 @@ void CButton::Create() {
    
     // make and bind the VAO
     glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     m_vbo.Create();
     m_vbo.Bind();
@@ -70,7 +71,7 @@ void CButton::Create() {
                           (void*)0                      // array buffer offset
                           );
     
-    glBindVertexArray(0);
+    CGLState::Instance().BindVertexArray(0);
     
     m_isActive = true;
 }
@@ -101,20 +102,20 @@ void CButton::Render(CFreeTypeFont *font, CShaderProgram *hudProgram, const std:
         hudProgram->UseProgram();
         hudProgram->SetUniform("bUseScreenQuad", true);
         hudProgram->SetUniform("material.bUseTexture", false);
-        hudProgram->SetUniform(material+".color", backgroundColor);
+        hudProgram->SetUniform(CUniformName(material, ".color"), backgroundColor);
         
-        glBindVertexArray(m_vao);
+        CGLState::Instance().BindVertexArray(m_vao);
         // Draw the triangle !
         // https://www.youtube.com/watch?v=4qECwne-CD8
         // https://stackoverflow.com/questions/39430404/drawing-pixels-in-opengl
         glDrawArrays(GL_TRIANGLE_STRIP, 0, m_numTriangles);
-        glBindVertexArray(0);
+        CGLState::Instance().BindVertexArray(0);
         
         if (*m_isEnabled == true)
         {
             GLuint VertexArrayID;
             glGenVertexArrays(1, &VertexArrayID);
-            glBindVertexArray(VertexArrayID);
+            CGLState::Instance().BindVertexArray(VertexArrayID);
             
             GLfloat xP = m_posX;
             GLfloat yP = m_posY;
@@ -156,16 +157,16 @@ void CButton::Render(CFreeTypeFont *font, CShaderProgram *hudProgram, const std:
                                   sizeof(glm::vec2),            // stride
                                   (void*)0                      // array buffer offset
                                   );
-            hudProgram->SetUniform(material+".color", buttonColor);
+            hudProgram->SetUniform(CUniformName(material, ".color"), buttonColor);
             glDrawArrays(GL_TRIANGLE_STRIP, 0, g_quad_vertex_buffer_data.size());
-            glBindVertexArray(0);
+            CGLState::Instance().BindVertexArray(0);
         }
         
         // Highlight button text
         if (m_isInside) {
-            hudProgram->SetUniform(material+".color", textHighlightedColor);
+            hudProgram->SetUniform(CUniformName(material, ".color"), textHighlightedColor);
         } else {
-            hudProgram->SetUniform(material+".color", textColor);
+            hudProgram->SetUniform(CUniformName(material, ".color"), textColor);
         }
         
         // Draw text inside button
@@ -7,6 +7,7 @@
 //
 
 #include "Control.h"
+#include "../window/GLState.h"
 
 std::list<CControl *> CControl::m_controls;
 
@@ -105,7 +106,7 @@ void CControl::Clear() {
 
 void CControl::Release() {
     this->m_controls.remove(this);
-    glDeleteVertexArrays(1, &m_vao);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vao);
     m_vbo.Release();
     m_isActive = false;
 }
@@ -7,6 +7,7 @@
 //
 
 #include "ListBox.h"
+#include "../window/GLState.h"
 
 CListBox::CListBox(GUIBoxData *data, GLint itemHeight,
                    const GUIMode &mode, const GLboolean & create, const PostProcessingEffectMode &ppfxMode):
@@ -27,7 +28,7 @@ CControl(data, mode, ppfxMode) {
 void CListBox::Create() {
     // make and bind the VAO
     glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     m_vbo.Create();
     m_vbo.Bind();
@@ -70,7 +71,7 @@ void CListBox::Create() {
                           (void*)0                      // array buffer offset
                           );
     
-    glBindVertexArray(0);
+    CGLState::Instance().BindVertexArray(0);
     
     m_isActive = true;
 }
@@ -106,14 +107,14 @@ void CListBox::Render(CFreeTypeFont *font, CShaderProgram *hudProgram, const std
         hudProgram->UseProgram();
         hudProgram->SetUniform("bUseScreenQuad", true);
         hudProgram->SetUniform("material.bUseTexture", false);
-        hudProgram->SetUniform(material+".color", backgroundColor);
+        hudProgram->SetUniform(CUniformName(material, ".color"), backgroundColor);
     
-        glBindVertexArray(m_vao);
+        CGLState::Instance().BindVertexArray(m_vao);
         // Draw the triangle !
         // https://www.youtube.com/watch?v=4qECwne-CD8
         // https://stackoverflow.com/questions/39430404/drawing-pixels-in-opengl
         glDrawArrays(GL_TRIANGLE_STRIP, 0, m_numTriangles);
-        glBindVertexArray(0);
+        CGLState::Instance().BindVertexArray(0);
     
     
         if (*m_currentIndex >= 0) {
@@ -122,7 +123,7 @@ void CListBox::Render(CFreeTypeFont *font, CShaderProgram *hudProgram, const std
             
             GLuint VertexArrayID;
             glGenVertexArrays(1, &VertexArrayID);
-            glBindVertexArray(VertexArrayID);
+            CGLState::Instance().BindVertexArray(VertexArrayID);
             
             GLfloat xP = m_posX;
             GLfloat yP = currentY;
@@ -164,17 +165,17 @@ void CListBox::Render(CFreeTypeFont *font, CShaderProgram *hudProgram, const std
                                   sizeof(glm::vec2),            // stride
                                   (void*)0                      // array buffer offset
                                   );
-            hudProgram->SetUniform(material+".color", boxColor);
+            hudProgram->SetUniform(CUniformName(material, ".color"), boxColor);
             glDrawArrays(GL_TRIANGLE_STRIP, 0, g_quad_vertex_buffer_data.size());
-            glBindVertexArray(0);
+            CGLState::Instance().BindVertexArray(0);
         }
     
         for (int i = 0; i < (int)m_items.size(); i++) {
             // Highlight current button
             if (*m_currentIndex == i) {
-                hudProgram->SetUniform(material+".color", textHighlightedColor);
+                hudProgram->SetUniform(CUniformName(material, ".color"), textHighlightedColor);
             } else {
-                hudProgram->SetUniform(material+".color", textColor);
+                hudProgram->SetUniform(CUniformName(material, ".color"), textColor);
             }
             
             // Draw text inside button
@@ -7,6 +7,7 @@
 //
 
 #include "Slider.h"
+#include "../window/GLState.h"
 
 CSlider::CSlider(std::string label, GLfloat min, GLfloat max, GLuint tickSize,
                  GUIBoxData *data, const GUIMode &mode, const GLboolean & create, const PostProcessingEffectMode &ppfxMode) :
@@ -29,7 +30,7 @@ CControl(data, mode, ppfxMode) {
 void CSlider::Create() {
     // make and bind the VAO
     glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     m_vbo.Create();
     m_vbo.Bind();
@@ -72,7 +73,7 @@ void CSlider::Create() {
                           (void*)0                      // array buffer offset
                           );
     
-    glBindVertexArray(0);
+    CGLState::Instance().BindVertexArray(0);
     
     m_isActive = true;
 }
@@ -118,21 +119,21 @@ void CSlider::Render(CFreeTypeFont *font, CShaderProgram *hudProgram, const std:
         hudProgram->UseProgram();
         hudProgram->SetUniform("bUseScreenQuad", true);
         hudProgram->SetUniform("material.bUseTexture", false);
-        hudProgram->SetUniform(material+".color", backgroundColor);
+        hudProgram->SetUniform(CUniformName(material, ".color"), backgroundColor);
         
-        glBindVertexArray(m_vao);
+        CGLState::Instance().BindVertexArray(m_vao);
         // Draw the triangle !
         // https://www.youtube.com/watch?v=4qECwne-CD8
         // https://stackoverflow.com/questions/39430404/drawing-pixels-in-opengl
         glDrawArrays(GL_TRIANGLE_STRIP, 0, m_numTriangles);
-        glBindVertexArray(0);
+        CGLState::Instance().BindVertexArray(0);
         
         // Slider bar
         {
             GLfloat currentX = (*m_current - m_min) / (m_max - m_min) * (GLfloat)(m_width - m_tickSize) + (GLfloat)m_posX;
             GLuint VertexArrayID;
             glGenVertexArrays(1, &VertexArrayID);
-            glBindVertexArray(VertexArrayID);
+            CGLState::Instance().BindVertexArray(VertexArrayID);
             
             GLfloat xP = m_posX; //(GLfloat)currentX;
             GLfloat yP = m_posY;
@@ -174,16 +175,16 @@ void CSlider::Render(CFreeTypeFont *font, CShaderProgram *hudProgram, const std:
                                   sizeof(glm::vec2),            // stride
                                   (void*)0                      // array buffer offset
                                   );
-            hudProgram->SetUniform(material+".color", sliderColor);
+            hudProgram->SetUniform(CUniformName(material, ".color"), sliderColor);
             glDrawArrays(GL_TRIANGLE_STRIP, 0, g_quad_vertex_buffer_data.size());
-            glBindVertexArray(0);
+            CGLState::Instance().BindVertexArray(0);
         }
         
         // Highlight button
         if (m_isInside) {
-            hudProgram->SetUniform(material+".color", textHighlightedColor);
+            hudProgram->SetUniform(CUniformName(material, ".color"), textHighlightedColor);
         } else {
-            hudProgram->SetUniform(material+".color", textColor);
+            hudProgram->SetUniform(CUniformName(material, ".color"), textColor);
         }
         
         // Draw text inside button
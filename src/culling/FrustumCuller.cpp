@@ -0,0 +1,165 @@
+//
+//  FrustumCuller.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "FrustumCuller.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define FRUSTUM_CULLER_SSE
+#endif
+
+/*   https://fgiesen.wordpress.com/2010/10/17/view-frustum-culling/
+ A box is outside when it is completely behind one of the planes. Its centre is dot(n, c) + d in front of the plane and
+ the box reaches dot(|n|, e) towards it, a sphere reaches its radius, so the bounds are outside as soon as
+ dot(n, c) + d + dot(|n|, e) + r < 0 for any plane. Bounds that cross a plane are kept.
+ */
+
+CFrustumCuller::CFrustumCuller()
+{
+    for (GLuint i = 0; i < 6; ++i) m_planes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    m_uiVisible = 0;
+    m_uiCulled = 0;
+    m_uiFrameVisible = 0;
+    m_uiFrameCulled = 0;
+}
+
+void CFrustumCuller::SetPlanes(const glm::vec4 planes[6])
+{
+    for (GLuint i = 0; i < 6; ++i) m_planes[i] = planes[i];
+}
+
+void CFrustumCuller::Clear()
+{
+    m_centreX.clear();
+    m_centreY.clear();
+    m_centreZ.clear();
+    m_extentX.clear();
+    m_extentY.clear();
+    m_extentZ.clear();
+    m_radius.clear();
+    m_visible.clear();
+}
+
+GLuint CFrustumCuller::AddBox(const glm::vec3 &min, const glm::vec3 &max)
+{
+    glm::vec3 centre = (min + max) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+    m_centreX.push_back(centre.x);
+    m_centreY.push_back(centre.y);
+    m_centreZ.push_back(centre.z);
+    m_extentX.push_back(extent.x);
+    m_extentY.push_back(extent.y);
+    m_extentZ.push_back(extent.z);
+    m_radius.push_back(0.0f);
+    return static_cast<GLuint>(m_radius.size() - 1);
+}
+
+GLuint CFrustumCuller::AddSphere(const glm::vec3 &centre, const GLfloat &radius)
+{
+    m_centreX.push_back(centre.x);
+    m_centreY.push_back(centre.y);
+    m_centreZ.push_back(centre.z);
+    m_extentX.push_back(0.0f);
+    m_extentY.push_back(0.0f);
+    m_extentZ.push_back(0.0f);
+    m_radius.push_back(radius);
+    return static_cast<GLuint>(m_radius.size() - 1);
+}
+
+GLuint CFrustumCuller::Cull()
+{
+    const GLuint count = GetCount();
+    m_visible.assign(count, 1);
+
+    GLuint i = 0;
+#ifdef FRUSTUM_CULLER_SSE
+    // four bounds per iteration, the lanes that end up behind a plane are set in the outside mask
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(&m_centreX[i]);
+        const __m128 cy = _mm_loadu_ps(&m_centreY[i]);
+        const __m128 cz = _mm_loadu_ps(&m_centreZ[i]);
+        const __m128 ex = _mm_loadu_ps(&m_extentX[i]);
+        const __m128 ey = _mm_loadu_ps(&m_extentY[i]);
+        const __m128 ez = _mm_loadu_ps(&m_extentZ[i]);
+        const __m128 r = _mm_loadu_ps(&m_radius[i]);
+
+        __m128 outside = zero;
+        for (GLuint p = 0; p < 6; ++p) {
+            const glm::vec4 &plane = m_planes[p];
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+                                         _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), cz), _mm_set1_ps(plane.w)));
+            __m128 reach = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), ex), _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), ey)),
+                                      _mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), ez), r));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, reach), zero));
+        }
+
+        int mask = _mm_movemask_ps(outside);
+        for (GLuint lane = 0; lane < 4; ++lane) {
+            if (mask & (1 << lane)) m_visible[i + lane] = 0;
+        }
+    }
+#endif
+
+    // the rest, or all of them without SSE, laid out so the compiler can vectorise it too
+    for (; i < count; ++i) {
+        for (GLuint p = 0; p < 6; ++p) {
+            const glm::vec4 &plane = m_planes[p];
+            GLfloat distance = plane.x * m_centreX[i] + plane.y * m_centreY[i] + plane.z * m_centreZ[i] + plane.w;
+            GLfloat reach = std::abs(plane.x) * m_extentX[i] + std::abs(plane.y) * m_extentY[i] + std::abs(plane.z) * m_extentZ[i] + m_radius[i];
+            if (distance + reach < 0.0f) {
+                m_visible[i] = 0;
+                break;
+            }
+        }
+    }
+
+    GLuint visible = 0;
+    for (GLubyte v : m_visible) visible += v;
+    m_uiVisible += visible;
+    m_uiCulled += count - visible;
+    return visible;
+}
+
+GLboolean CFrustumCuller::TestBox(const glm::vec3 &min, const glm::vec3 &max)
+{
+    glm::vec3 centre = (min + max) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+    for (GLuint p = 0; p < 6; ++p) {
+        glm::vec3 normal = glm::vec3(m_planes[p]);
+        if (glm::dot(normal, centre) + m_planes[p].w + glm::dot(glm::abs(normal), extent) < 0.0f) {
+            m_uiCulled++;
+            return false;
+        }
+    }
+    m_uiVisible++;
+    return true;
+}
+
+// Arvo's method, each axis of the world box gathers the extent along the absolute rows of the matrix
+void CFrustumCuller::TransformBounds(const glm::mat4 &model, const glm::vec3 &min, const glm::vec3 &max,
+                                     glm::vec3 &worldMin, glm::vec3 &worldMax)
+{
+    glm::vec3 centre = (min + max) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+
+    glm::mat3 absolute;
+    for (GLuint c = 0; c < 3; ++c) absolute[c] = glm::abs(glm::vec3(model[c]));
+    glm::vec3 worldCentre = glm::vec3(model * glm::vec4(centre, 1.0f));
+    glm::vec3 worldExtent = absolute * extent;
+    worldMin = worldCentre - worldExtent;
+    worldMax = worldCentre + worldExtent;
+}
+
+void CFrustumCuller::BeginFrame()
+{
+    m_uiFrameVisible = m_uiVisible;
+    m_uiFrameCulled = m_uiCulled;
+    m_uiVisible = 0;
+    m_uiCulled = 0;
+}
@@ -0,0 +1,60 @@
+//
+//  FrustumCuller.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef FrustumCuller_h
+#define FrustumCuller_h
+
+#include "../CullingBase.h"
+
+// Tests world space bounds against the six planes of a frustum, see CCamera::ExtractFrustumPlanes. A batch of bounds
+// is kept as separate arrays of centres, extents and radii so Cull can test four of them per SIMD instruction,
+// a box has no radius and a sphere has no extent, so both go through the same test.
+class CFrustumCuller
+{
+public:
+    CFrustumCuller();
+
+    void SetPlanes(const glm::vec4 planes[6]);
+    const glm::vec4 *GetPlanes() const { return m_planes; }
+
+    // the batch, Add returns the index Cull reports the bounds at
+    void Clear();
+    GLuint AddBox(const glm::vec3 &min, const glm::vec3 &max);
+    GLuint AddSphere(const glm::vec3 &centre, const GLfloat &radius);
+    // tests every bounds of the batch, returns how many are visible
+    GLuint Cull();
+    GLboolean IsVisible(const GLuint &index) const { return m_visible[index] != 0; }
+    GLuint GetCount() const { return static_cast<GLuint>(m_radius.size()); }
+
+    // a single box outside a batch, counted like the batch ones
+    GLboolean TestBox(const glm::vec3 &min, const glm::vec3 &max);
+
+    // the world space box around a local box moved by the model matrix
+    static void TransformBounds(const glm::mat4 &model, const glm::vec3 &min, const glm::vec3 &max,
+                                glm::vec3 &worldMin, glm::vec3 &worldMax);
+
+    // the counters now report the previous frame
+    void BeginFrame();
+    GLuint GetVisible() const { return m_uiFrameVisible; }
+    GLuint GetCulled() const { return m_uiFrameCulled; }
+
+private:
+    glm::vec4 m_planes[6];
+
+    std::vector<GLfloat> m_centreX, m_centreY, m_centreZ;
+    std::vector<GLfloat> m_extentX, m_extentY, m_extentZ;
+    std::vector<GLfloat> m_radius;
+    std::vector<GLubyte> m_visible;
+
+    GLuint m_uiVisible, m_uiCulled;
+    GLuint m_uiFrameVisible, m_uiFrameCulled;
+};
+
+#endif /* FrustumCuller_h */
@@ -0,0 +1,195 @@
+//
+//  IndirectCuller.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "IndirectCuller.h"
+#include "../interfaces/IGameObject.h"
+#include "../buffers/GeometryArena.h"
+#include "../shaders/ShaderProgram.h"
+#include "../utilities/Vertex.h"
+
+/*   https://www.khronos.org/opengl/wiki/Vertex_Rendering#Indirect_rendering
+ A multi draw indirect call reads its draws from a buffer of DrawElementsIndirectCommand, so a compute shader can
+ decide which of them draw anything by writing their instance counts without the CPU reading the result back.
+ Every command draws the instance at its base instance, the instance attributes have a divisor of one so that is
+ the transform of its object. The meshes of the geometry arena share its VAO, so the commands only point at their
+ ranges with the first index and the base vertex, like CGeometryArena::Draw does, and no geometry is copied.
+ */
+
+CIndirectCuller::CIndirectCuller() : m_vao(0), m_generation(0)
+{
+}
+
+CIndirectCuller::~CIndirectCuller()
+{
+    Release();
+}
+
+GLboolean CIndirectCuller::IsSupported()
+{
+    return GLEW_VERSION_4_3 ? true : false;
+}
+
+void CIndirectCuller::Create(const std::vector<IGameObject*> &meshes)
+{
+    for (IGameObject *pMesh : meshes) {
+        Range range;
+        if (HasMesh(pMesh) || !GetRange(pMesh, range)) continue;
+        // the arena has a VAO per vertex layout and the meshes of the scene are all laid out as Vertex
+        if (m_vao != 0 && range.vertexArray != m_vao) continue;
+        m_vao = range.vertexArray;
+        m_ranges[pMesh] = range;
+    }
+    m_generation = CGeometryArena::Instance().GetGeneration();
+    if (m_ranges.empty())
+        return;
+
+    // the instance attributes always start at the first instance, the base instance of a command picks its own
+    m_instances.Create();
+}
+
+// only indexed meshes of the arena, the ones with buffers of their own would need a VAO of their own
+GLboolean CIndirectCuller::GetRange(IGameObject *pMesh, Range &range)
+{
+    GeometryRange geometry;
+    if (!pMesh->GetGeometry(geometry) || geometry.vertexArray == 0 || geometry.indexBuffer == 0 || geometry.count < 3)
+        return false;
+    if (geometry.mode != GL_TRIANGLES && geometry.mode != GL_TRIANGLE_STRIP)
+        return false;
+
+    range.firstIndex = static_cast<GLuint>(geometry.indexOffset / sizeof(GLuint));
+    range.count = static_cast<GLuint>(geometry.count);
+    range.baseVertex = static_cast<GLint>(geometry.vertexOffset / sizeof(Vertex));
+    range.mode = geometry.mode;
+    range.vertexArray = geometry.vertexArray;
+    return true;
+}
+
+void CIndirectCuller::GetCommands(const Batch &batch, std::vector<Command> &commands) const
+{
+    commands.clear();
+    for (GLuint i = 0; i < batch.meshes.size(); ++i) {
+        const Range &range = m_ranges.at(batch.meshes[i]);
+        commands.push_back(Command{range.count, 1, range.firstIndex, range.baseVertex, i});
+    }
+}
+
+void CIndirectCuller::Refresh()
+{
+    const GLuint generation = CGeometryArena::Instance().GetGeneration();
+    if (generation == m_generation)
+        return;
+    m_generation = generation;
+
+    // a mesh keeps its primitive, only where its range starts changes
+    for (std::pair<IGameObject* const, Range> &mesh : m_ranges) {
+        GetRange(mesh.first, mesh.second);
+    }
+    std::vector<Command> commands;
+    for (const Batch &batch : m_batches) {
+        if (batch.meshes.empty()) continue;
+        GetCommands(batch, commands);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, batch.commands);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(Command), &commands[0]);
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+GLuint CIndirectCuller::AddBatch(const std::vector<IndirectObject> &objects)
+{
+    std::vector<IndirectObject> sorted;
+    for (const IndirectObject &object : objects) {
+        if (HasMesh(object.pMesh)) sorted.push_back(object);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [this](const IndirectObject &a, const IndirectObject &b) {
+        if (a.material != b.material) return a.material < b.material;
+        const Range &rangeA = m_ranges.at(a.pMesh), &rangeB = m_ranges.at(b.pMesh);
+        if (rangeA.mode != rangeB.mode) return rangeA.mode < rangeB.mode;
+        return rangeA.firstIndex < rangeB.firstIndex;
+    });
+
+    Batch batch;
+    std::vector<glm::vec4> bounds;
+    for (GLuint i = 0; i < sorted.size(); ++i) {
+        const GLenum mode = m_ranges.at(sorted[i].pMesh).mode;
+        bounds.push_back(glm::vec4(sorted[i].boundsMin, 0.0f));
+        bounds.push_back(glm::vec4(sorted[i].boundsMax, 0.0f));
+        batch.meshes.push_back(sorted[i].pMesh);
+        batch.items.push_back(sorted[i].item);
+        if (batch.runs.empty() || batch.runs.back().material != sorted[i].material || batch.runs.back().mode != mode) {
+            batch.runs.push_back(Run{sorted[i].material, mode, i, 0});
+        }
+        batch.runs.back().count++;
+    }
+    std::vector<Command> commands;
+    GetCommands(batch, commands);
+
+    glGenBuffers(1, &batch.bounds);
+    glGenBuffers(1, &batch.commands);
+    if (!commands.empty()) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, batch.bounds);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, bounds.size() * sizeof(glm::vec4), &bounds[0], GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        // the compute shader rewrites the instance counts every frame
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, batch.commands);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(Command), &commands[0], GL_DYNAMIC_COPY);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    m_batches.push_back(batch);
+    return static_cast<GLuint>(m_batches.size() - 1);
+}
+
+void CIndirectCuller::Cull(CShaderProgram *pCullProgram, const GLuint &batch, const glm::vec4 planes[6])
+{
+    const Batch &b = m_batches[batch];
+    const GLuint count = static_cast<GLuint>(b.items.size());
+    if (count == 0 || m_instances.GetCount() < count)
+        return;
+    Refresh();
+    m_instances.Upload();
+
+    glm::vec4 frustum[6];
+    for (GLuint i = 0; i < 6; ++i) frustum[i] = planes[i];
+    pCullProgram->UseProgram();
+    pCullProgram->SetUniform("planes", frustum, 6);
+    pCullProgram->SetUniform("objectCount", static_cast<GLint>(count));
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, b.bounds);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_instances.GetBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, b.commands);
+
+    // 64 objects per work group, see SceneCullShader.comp
+    glDispatchCompute((count + 63) / 64, 1, 1);
+
+    // the draws read the commands that were just written
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+}
+
+void CIndirectCuller::Draw(const GLuint &batch, const GLuint &run)
+{
+    const Batch &b = m_batches[batch];
+    const Run &r = b.runs[run];
+    // the instanced draws of the arena point the same VAO at their own instances, the VAO is left bound like theirs
+    m_instances.Bind(m_vao, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, b.commands);
+    glMultiDrawElementsIndirect(r.mode, GL_UNSIGNED_INT, (void*)(r.first * sizeof(Command)), r.count, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void CIndirectCuller::Release()
+{
+    for (Batch &batch : m_batches) {
+        glDeleteBuffers(1, &batch.bounds);
+        glDeleteBuffers(1, &batch.commands);
+    }
+    m_batches.clear();
+    m_ranges.clear();
+    m_instances.Release();
+
+    // the VAO belongs to the arena
+    m_vao = 0;
+}
@@ -0,0 +1,108 @@
+//
+//  IndirectCuller.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef IndirectCuller_h
+#define IndirectCuller_h
+
+#include "../CullingBase.h"
+#include "../buffers/InstanceBuffer.h"
+
+class IGameObject;
+class CShaderProgram;
+
+// an object of a batch, item is whatever the caller knows the object by
+struct IndirectObject {
+    IGameObject *pMesh;
+    GLuint material;
+    glm::vec3 boundsMin, boundsMax;     // object space
+    GLuint item;
+};
+
+// GPU driven drawing. The meshes are drawn straight from the VAO of the geometry arena, the command of an object
+// gives the first index and the base vertex of its mesh there, and a batch keeps the object space boxes and the
+// draw commands of its objects on the GPU. Every frame only the transforms are sent, SceneCullShader.comp tests
+// the boxes against the frustum and writes the instance count of every command, then each run of objects sharing
+// a material and a primitive is one glMultiDrawElementsIndirect call.
+class CIndirectCuller
+{
+public:
+    CIndirectCuller();
+    ~CIndirectCuller();
+
+    // compute shaders, storage buffers and multi draw indirect are all core in GL 4.3
+    static GLboolean IsSupported();
+
+    // takes the meshes that draw from the geometry arena, the others are left out
+    void Create(const std::vector<IGameObject*> &meshes);
+    GLboolean HasMesh(IGameObject *pMesh) const { return m_ranges.find(pMesh) != m_ranges.end(); }
+
+    // the objects are ordered by material, primitive and mesh and uploaded once, objects of other meshes are dropped
+    GLuint AddBatch(const std::vector<IndirectObject> &objects);
+    GLuint GetObjectCount(const GLuint &batch) const { return static_cast<GLuint>(m_batches[batch].items.size()); }
+    GLuint GetItem(const GLuint &batch, const GLuint &i) const { return m_batches[batch].items[i]; }
+    GLuint GetRunCount(const GLuint &batch) const { return static_cast<GLuint>(m_batches[batch].runs.size()); }
+    GLuint GetRunMaterial(const GLuint &batch, const GLuint &run) const { return m_batches[batch].runs[run].material; }
+
+    // filled with the transforms of a batch in the order of GetItem before culling it
+    CInstanceBuffer &GetInstances() { return m_instances; }
+    // uploads the instances and sets the instance count of every command, 0 for the boxes outside the planes
+    void Cull(CShaderProgram *pCullProgram, const GLuint &batch, const glm::vec4 planes[6]);
+    // one multi draw of the commands of a run, the program and material are bound by the caller
+    void Draw(const GLuint &batch, const GLuint &run);
+
+    GLuint GetMeshCount() const { return static_cast<GLuint>(m_ranges.size()); }
+
+    void Release();
+
+private:
+    CIndirectCuller(const CIndirectCuller &) = delete;
+    CIndirectCuller &operator=(const CIndirectCuller &) = delete;
+
+    // DrawElementsIndirectCommand
+    struct Command {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+    // where a mesh sits in the buffers of the arena, in indices and vertices
+    struct Range {
+        GLuint firstIndex, count;
+        GLint baseVertex;
+        GLenum mode;
+        GLuint vertexArray;
+    };
+    struct Run {
+        GLuint material;
+        GLenum mode;
+        GLuint first, count;
+    };
+    struct Batch {
+        GLuint bounds, commands;        // storage buffer of min and max pairs, indirect buffer
+        std::vector<IGameObject*> meshes;
+        std::vector<GLuint> items;
+        std::vector<Run> runs;
+    };
+
+    static GLboolean GetRange(IGameObject *pMesh, Range &range);
+    // the commands of a batch from the ranges its meshes have now, one instance each
+    void GetCommands(const Batch &batch, std::vector<Command> &commands) const;
+    // looks the ranges up again once the arena has moved them and rewrites the commands of every batch
+    void Refresh();
+
+    GLuint m_vao;                       // of the arena, shared with every mesh drawn from it
+    GLuint m_generation;                // of the arena when the ranges were looked up
+    std::map<IGameObject*, Range> m_ranges;
+    std::vector<Batch> m_batches;
+    CInstanceBuffer m_instances;
+};
+
+#endif /* IndirectCuller_h */
@@ -0,0 +1,312 @@
+//
+//  OcclusionCuller.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "OcclusionCuller.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define OCCLUSION_CULLER_SSE
+#endif
+
+/*   https://software.intel.com/content/www/us/en/develop/articles/software-occlusion-culling.html
+ Triangles are clipped the cheap way, one that reaches behind the eye is not drawn at all, which only ever lets more
+ objects through. A pixel is covered when its centre is inside the three edges and keeps the nearest depth drawn
+ into it. The depth of the screen space triangle is a plane, so both the edges and the depth step by a constant
+ along a row, four pixels at a time.
+ */
+
+#define OCCLUSION_NEAR_W 1e-4f
+
+COcclusionCuller::COcclusionCuller(const GLuint &width, const GLuint &height, const GLuint &threads)
+{
+    // the rows are filled four pixels at a time
+    m_width = std::max((width + 3u) & ~3u, 4u);
+    m_height = std::max(height, 1u);
+    m_viewProjection = glm::mat4(1.0f);
+
+    GLuint w = m_width, h = m_height;
+    while (true) {
+        m_levels.push_back(std::vector<GLfloat>(w * h, 1.0f));
+        m_levelWidths.push_back(w);
+        m_levelHeights.push_back(h);
+        if (w == 1 && h == 1) break;
+        w = std::max((w + 1) / 2, 1u);
+        h = std::max((h + 1) / 2, 1u);
+    }
+
+    m_generation = 0;
+    m_pending = 0;
+    m_bStop = false;
+    m_bands = threads > 0 ? threads : std::min(std::max(std::thread::hardware_concurrency(), 1u), 4u);
+    m_bands = std::min(m_bands, m_height);
+    for (GLuint band = 1; band < m_bands; ++band)
+        m_workers.push_back(std::thread(&COcclusionCuller::Run, this, band));
+
+    m_uiTriangles = 0;
+    m_uiTested = 0;
+    m_uiOccluded = 0;
+    m_uiFrameTriangles = 0;
+    m_uiFrameTested = 0;
+    m_uiFrameOccluded = 0;
+}
+
+COcclusionCuller::~COcclusionCuller()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_start.notify_all();
+    for (std::thread &worker : m_workers)
+        worker.join();
+}
+
+void COcclusionCuller::Begin(const glm::mat4 &viewProjection)
+{
+    m_viewProjection = viewProjection;
+    m_triangles.clear();
+}
+
+void COcclusionCuller::AddOccluder(const std::vector<glm::vec3> &triangles, const glm::mat4 &model)
+{
+    const glm::mat4 transform = m_viewProjection * model;
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+        AddTriangle(transform * glm::vec4(triangles[i], 1.0f),
+                    transform * glm::vec4(triangles[i + 1], 1.0f),
+                    transform * glm::vec4(triangles[i + 2], 1.0f));
+    }
+}
+
+void COcclusionCuller::AddTriangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c)
+{
+    if (a.w < OCCLUSION_NEAR_W || b.w < OCCLUSION_NEAR_W || c.w < OCCLUSION_NEAR_W)
+        return;
+
+    // clip space to buffer pixels, depth to 0 near and 1 far
+    const glm::vec4 clip[3] = {a, b, c};
+    glm::vec3 v[3];
+    for (GLuint i = 0; i < 3; ++i) {
+        glm::vec3 ndc = glm::vec3(clip[i]) / clip[i].w;
+        v[i] = glm::vec3((ndc.x * 0.5f + 0.5f) * m_width, (ndc.y * 0.5f + 0.5f) * m_height, glm::max(ndc.z * 0.5f + 0.5f, 0.0f));
+    }
+    if (v[0].z > 1.0f && v[1].z > 1.0f && v[2].z > 1.0f)
+        return;
+
+    // like the gl face culling only counter clockwise triangles are drawn, the back of an occluder may be open
+    const GLfloat area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+    if (area < 1e-6f)
+        return;
+
+    Triangle triangle;
+    triangle.minX = std::max(static_cast<GLint>(std::floor(std::min(v[0].x, std::min(v[1].x, v[2].x)))), 0);
+    triangle.maxX = std::min(static_cast<GLint>(std::ceil(std::max(v[0].x, std::max(v[1].x, v[2].x)))), static_cast<GLint>(m_width) - 1);
+    triangle.minY = std::max(static_cast<GLint>(std::floor(std::min(v[0].y, std::min(v[1].y, v[2].y)))), 0);
+    triangle.maxY = std::min(static_cast<GLint>(std::ceil(std::max(v[0].y, std::max(v[1].y, v[2].y)))), static_cast<GLint>(m_height) - 1);
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+        return;
+
+    // edge i is opposite vertex i, its value at a point divided by the area is the weight of vertex i there
+    for (GLuint i = 0; i < 3; ++i) {
+        const glm::vec3 &from = v[(i + 1) % 3];
+        const glm::vec3 &to = v[(i + 2) % 3];
+        triangle.edgeA[i] = from.y - to.y;
+        triangle.edgeB[i] = to.x - from.x;
+        triangle.edgeC[i] = from.x * to.y - from.y * to.x;
+    }
+    triangle.depthA = (triangle.edgeA[0] * v[0].z + triangle.edgeA[1] * v[1].z + triangle.edgeA[2] * v[2].z) / area;
+    triangle.depthB = (triangle.edgeB[0] * v[0].z + triangle.edgeB[1] * v[1].z + triangle.edgeB[2] * v[2].z) / area;
+    triangle.depthC = (triangle.edgeC[0] * v[0].z + triangle.edgeC[1] * v[1].z + triangle.edgeC[2] * v[2].z) / area;
+    m_triangles.push_back(triangle);
+}
+
+void COcclusionCuller::Rasterize()
+{
+    std::fill(m_levels[0].begin(), m_levels[0].end(), 1.0f);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = static_cast<GLuint>(m_workers.size());
+        m_generation++;
+    }
+    m_start.notify_all();
+    RasterizeBand(0);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_pending == 0; });
+    }
+
+    BuildPyramid();
+    m_uiTriangles += static_cast<GLuint>(m_triangles.size());
+}
+
+void COcclusionCuller::Run(const GLuint band)
+{
+    GLuint generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [this, generation]() { return m_bStop || m_generation != generation; });
+            if (m_bStop) return;
+            generation = m_generation;
+        }
+
+        RasterizeBand(band);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0) m_done.notify_one();
+    }
+}
+
+void COcclusionCuller::RasterizeBand(const GLuint &band)
+{
+    const GLint bandMinY = static_cast<GLint>(band * m_height / m_bands);
+    const GLint bandMaxY = static_cast<GLint>((band + 1) * m_height / m_bands) - 1;
+    for (const Triangle &triangle : m_triangles) {
+        GLint minY = std::max(triangle.minY, bandMinY);
+        GLint maxY = std::min(triangle.maxY, bandMaxY);
+        if (minY <= maxY) RasterizeTriangle(triangle, minY, maxY);
+    }
+}
+
+void COcclusionCuller::RasterizeTriangle(const Triangle &triangle, const GLint &minY, const GLint &maxY)
+{
+    std::vector<GLfloat> &depth = m_levels[0];
+    const GLint startX = triangle.minX & ~3;
+
+    for (GLint y = minY; y <= maxY; ++y) {
+        const GLfloat py = y + 0.5f;
+        GLfloat *row = &depth[y * m_width];
+        GLint x = startX;
+#ifdef OCCLUSION_CULLER_SSE
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        __m128 rowEdge[3], stepEdge[3];
+        for (GLuint i = 0; i < 3; ++i) {
+            rowEdge[i] = _mm_set1_ps(triangle.edgeB[i] * py + triangle.edgeC[i]);
+            stepEdge[i] = _mm_set1_ps(triangle.edgeA[i]);
+        }
+        const __m128 rowDepth = _mm_set1_ps(triangle.depthB * py + triangle.depthC);
+        const __m128 stepDepth = _mm_set1_ps(triangle.depthA);
+        for (; x <= triangle.maxX; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<GLfloat>(x)), offsets);
+            __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepEdge[0], px), rowEdge[0]), zero);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepEdge[1], px), rowEdge[1]), zero));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepEdge[2], px), rowEdge[2]), zero));
+            if (_mm_movemask_ps(inside) == 0) continue;
+
+            const __m128 z = _mm_max_ps(_mm_add_ps(_mm_mul_ps(stepDepth, px), rowDepth), zero);
+            const __m128 current = _mm_loadu_ps(row + x);
+            const __m128 nearest = _mm_min_ps(current, z);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+        }
+#endif
+        for (; x <= triangle.maxX; ++x) {
+            const GLfloat px = x + 0.5f;
+            GLboolean inside = true;
+            for (GLuint i = 0; i < 3; ++i)
+                inside = inside && triangle.edgeA[i] * px + triangle.edgeB[i] * py + triangle.edgeC[i] >= 0.0f;
+            if (!inside) continue;
+
+            const GLfloat z = std::max(triangle.depthA * px + triangle.depthB * py + triangle.depthC, 0.0f);
+            row[x] = std::min(row[x], z);
+        }
+    }
+}
+
+void COcclusionCuller::BuildPyramid()
+{
+    for (GLuint level = 1; level < m_levels.size(); ++level) {
+        const std::vector<GLfloat> &below = m_levels[level - 1];
+        const GLuint belowWidth = m_levelWidths[level - 1], belowHeight = m_levelHeights[level - 1];
+        std::vector<GLfloat> &current = m_levels[level];
+        for (GLuint y = 0; y < m_levelHeights[level]; ++y) {
+            const GLuint y0 = y * 2, y1 = std::min(y * 2 + 1, belowHeight - 1);
+            for (GLuint x = 0; x < m_levelWidths[level]; ++x) {
+                const GLuint x0 = x * 2, x1 = std::min(x * 2 + 1, belowWidth - 1);
+                current[y * m_levelWidths[level] + x] = std::max(std::max(below[y0 * belowWidth + x0], below[y0 * belowWidth + x1]),
+                                                                 std::max(below[y1 * belowWidth + x0], below[y1 * belowWidth + x1]));
+            }
+        }
+    }
+}
+
+GLboolean COcclusionCuller::IsVisible(const glm::vec3 &min, const glm::vec3 &max)
+{
+    m_uiTested++;
+
+    // the screen rectangle and nearest depth of the box, a box reaching behind the eye is never hidden
+    glm::vec2 rectMin(std::numeric_limits<GLfloat>::max()), rectMax(-std::numeric_limits<GLfloat>::max());
+    GLfloat nearest = std::numeric_limits<GLfloat>::max();
+    for (GLuint corner = 0; corner < 8; ++corner) {
+        glm::vec3 point((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+        glm::vec4 clip = m_viewProjection * glm::vec4(point, 1.0f);
+        if (clip.w < OCCLUSION_NEAR_W) return true;
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        glm::vec2 pixel((ndc.x * 0.5f + 0.5f) * m_width, (ndc.y * 0.5f + 0.5f) * m_height);
+        rectMin = glm::min(rectMin, pixel);
+        rectMax = glm::max(rectMax, pixel);
+        nearest = std::min(nearest, ndc.z * 0.5f + 0.5f);
+    }
+
+    rectMin = glm::max(rectMin, glm::vec2(0.0f));
+    rectMax = glm::min(rectMax, glm::vec2(m_width - 1, m_height - 1));
+    if (rectMin.x > rectMax.x || rectMin.y > rectMax.y || nearest > 1.0f)
+        return true;
+
+    // the level where the rectangle spans at most two texels each way
+    GLfloat size = std::max(std::max(rectMax.x - rectMin.x, rectMax.y - rectMin.y), 1.0f);
+    GLuint level = std::min(static_cast<GLuint>(std::ceil(std::log2(size))), GetLevelCount() - 1);
+    GLuint x0 = static_cast<GLuint>(rectMin.x) >> level, x1 = static_cast<GLuint>(rectMax.x) >> level;
+    GLuint y0 = static_cast<GLuint>(rectMin.y) >> level, y1 = static_cast<GLuint>(rectMax.y) >> level;
+
+    GLfloat furthest = 0.0f;
+    for (GLuint y = y0; y <= y1; ++y)
+        for (GLuint x = x0; x <= x1; ++x)
+            furthest = std::max(furthest, GetDepth(x, y, level));
+
+    if (nearest > furthest) {
+        m_uiOccluded++;
+        return false;
+    }
+    return true;
+}
+
+GLfloat COcclusionCuller::GetDepth(const GLuint &x, const GLuint &y, const GLuint &level) const
+{
+    const GLuint clampedX = std::min(x, m_levelWidths[level] - 1);
+    const GLuint clampedY = std::min(y, m_levelHeights[level] - 1);
+    return m_levels[level][clampedY * m_levelWidths[level] + clampedX];
+}
+
+void COcclusionCuller::GetDebugImage(std::vector<GLubyte> &pixels) const
+{
+    // perspective depth bunches up near 1, so the drawn range is stretched over the whole grey scale
+    const std::vector<GLfloat> &depth = m_levels[0];
+    GLfloat nearest = 1.0f, furthest = 0.0f;
+    for (GLfloat z : depth) {
+        if (z >= 1.0f) continue;
+        nearest = std::min(nearest, z);
+        furthest = std::max(furthest, z);
+    }
+    const GLfloat range = std::max(furthest - nearest, 1e-6f);
+
+    pixels.resize(depth.size());
+    for (size_t i = 0; i < depth.size(); ++i) {
+        pixels[i] = depth[i] >= 1.0f ? 0 : static_cast<GLubyte>(255.0f - 223.0f * (depth[i] - nearest) / range);
+    }
+}
+
+void COcclusionCuller::BeginFrame()
+{
+    m_uiFrameTriangles = m_uiTriangles;
+    m_uiFrameTested = m_uiTested;
+    m_uiFrameOccluded = m_uiOccluded;
+    m_uiTriangles = 0;
+    m_uiTested = 0;
+    m_uiOccluded = 0;
+}
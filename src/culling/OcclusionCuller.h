@@ -0,0 +1,94 @@
+//
+//  OcclusionCuller.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef OcclusionCuller_h
+#define OcclusionCuller_h
+
+#include "../CullingBase.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define OCCLUSION_WIDTH 256
+#define OCCLUSION_HEIGHT 128
+
+// Software occlusion culling. A few large occluders are rasterized on the CPU into a small depth buffer, the
+// rows are split in bands and every band is filled by its own thread. A pyramid keeps the furthest depth of each
+// 2x2 block of the level below, so a box is hidden when its nearest point is behind the furthest occluder depth
+// of the one or two texels of the level its screen rectangle fits in. Nothing here touches OpenGL.
+class COcclusionCuller
+{
+public:
+    // threads 0 uses the cores of the machine, up to four
+    COcclusionCuller(const GLuint &width = OCCLUSION_WIDTH, const GLuint &height = OCCLUSION_HEIGHT, const GLuint &threads = 0);
+    ~COcclusionCuller();
+
+    // starts a new buffer seen through the view projection, the occluders added before are dropped
+    void Begin(const glm::mat4 &viewProjection);
+    // triangles as three points each, in the space the model matrix moves to the world
+    void AddOccluder(const std::vector<glm::vec3> &triangles, const glm::mat4 &model);
+    // fills the depth buffer with the occluders and builds the pyramid
+    void Rasterize();
+
+    // false when the world box is behind the occluders
+    GLboolean IsVisible(const glm::vec3 &min, const glm::vec3 &max);
+
+    GLuint GetWidth() const { return m_width; }
+    GLuint GetHeight() const { return m_height; }
+    GLuint GetLevelCount() const { return static_cast<GLuint>(m_levels.size()); }
+    // depth between 0 and 1 of a texel of a pyramid level, 1 where no occluder was drawn
+    GLfloat GetDepth(const GLuint &x, const GLuint &y, const GLuint &level = 0) const;
+    // one byte per texel of the buffer, brighter is nearer and black is empty, bottom row first
+    void GetDebugImage(std::vector<GLubyte> &pixels) const;
+
+    // the counters now report the previous frame
+    void BeginFrame();
+    GLuint GetTriangles() const { return m_uiFrameTriangles; }
+    GLuint GetTested() const { return m_uiFrameTested; }
+    GLuint GetOccluded() const { return m_uiFrameOccluded; }
+
+private:
+    COcclusionCuller(const COcclusionCuller &) = delete;
+    COcclusionCuller &operator=(const COcclusionCuller &) = delete;
+
+    // a triangle in buffer pixels, set up once and shared by the bands
+    struct Triangle {
+        GLfloat edgeA[3], edgeB[3], edgeC[3];  // inside where every a x + b y + c is positive
+        GLfloat depthA, depthB, depthC;         // depth = a x + b y + c
+        GLint minX, maxX, minY, maxY;
+    };
+
+    void AddTriangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c);
+    void RasterizeBand(const GLuint &band);
+    void RasterizeTriangle(const Triangle &triangle, const GLint &minY, const GLint &maxY);
+    void BuildPyramid();
+    void Run(const GLuint band);
+
+    GLuint m_width, m_height;
+    glm::mat4 m_viewProjection;
+    std::vector<Triangle> m_triangles;
+    std::vector<std::vector<GLfloat>> m_levels;   // level 0 is the depth buffer
+    std::vector<GLuint> m_levelWidths, m_levelHeights;
+
+    // the workers fill bands 1 and up while the calling thread fills band 0
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    GLuint m_generation;
+    GLuint m_pending;
+    GLboolean m_bStop;
+    GLuint m_bands;
+
+    GLuint m_uiTriangles, m_uiTested, m_uiOccluded;
+    GLuint m_uiFrameTriangles, m_uiFrameTested, m_uiFrameOccluded;
+};
+
+#endif /* OcclusionCuller_h */
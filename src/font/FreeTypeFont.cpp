@@ -1,4 +1,5 @@
 #include "FreeTypeFont.h"
+#include "../window/GLState.h"
 
 CFreeTypeFont::CFreeTypeFont()
 {
@@ -93,7 +94,7 @@ bool CFreeTypeFont::LoadFont(std::string file, int ipixelSize, const TextureType
 	m_loadedPixelSize = ipixelSize;
 
 	glGenVertexArrays(1, &m_vao);
-	glBindVertexArray(m_vao);
+	CGLState::Instance().BindVertexArray(m_vao);
 	m_vbo.Create();
 	m_vbo.Bind();
 
@@ -118,7 +119,7 @@ void CFreeTypeFont::Print(CShaderProgram* program, std::string text, int x, int
 	if(!m_isLoaded)
 		return;
 
-	glBindVertexArray(m_vao);
+	CGLState::Instance().BindVertexArray(m_vao);
     
 	int iCurX = x, iCurY = y;
 	if (pixelSize == -1)
@@ -165,7 +166,7 @@ void CFreeTypeFont::Release()
     for (int i = 0; i < 128; i++)
         m_charTextures[i].Release();
     m_vbo.Release();
-    glDeleteVertexArrays(1, &m_vao);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vao);
 }
 
 // Gets the width of text
@@ -7,6 +7,7 @@
 //
 
 #include "Game.h"
+#include "../buffers/UniformBlocks.h"
 
 void Game::InitialiseCamera(const GLuint &width, const GLuint &height, const glm::vec3 & position){
     m_viewPointAngle = 0.0f;
@@ -22,16 +23,24 @@ void Game::InitialiseCamera(const GLuint &width, const GLuint &height, const glm
                       (GLfloat)ZNEAR,                   // zNear
                       (GLfloat)ZFAR                     // zFar
                       );
+    
+    m_pCameraUBO->Create(UniformBlockType::Camera, sizeof(CameraBlock));
 }
 
-void Game::SetCameraUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, CCamera *camera) {
-    pShaderProgram->UseProgram();
-    pShaderProgram->SetUniform(uniformName+".position", camera->GetPosition());
-    pShaderProgram->SetUniform(uniformName+".front", camera->GetForward());
-    pShaderProgram->SetUniform(uniformName+".znear", camera->GetNearPlane());
-    pShaderProgram->SetUniform(uniformName+".zfar", camera->GetFarPlane());
-    pShaderProgram->SetUniform(uniformName+".isOrthographic", m_isOrthographicCamera);
-    pShaderProgram->SetUniform(uniformName+".isMoving", camera->IsMoving());
+// Camera block, uploaded once per frame and shared by every program declaring CameraBlock
+void Game::UpdateCameraUniformBlock(CCamera *camera) {
+    CameraBlock block = {};
+    block.position = camera->GetPosition();
+    block.front = camera->GetForward();
+    block.znear = camera->GetNearPlane();
+    block.zfar = camera->GetFarPlane();
+    block.isMoving = camera->IsMoving() ? 1 : 0;
+    block.isOrthographic = m_isOrthographicCamera ? 1 : 0;
+    m_pCameraUBO->UpdateData(&block, sizeof(block));
+    
+    // every object of every pass is drawn with the same view, it is inverted here once
+    m_viewMatrix = camera->GetViewMatrix();
+    m_inverseViewMatrix = glm::inverse(m_viewMatrix);
 }
 
 void Game::UpdateCamera(const GLdouble & deltaTime, const MouseState &mouseState, const KeyboardState &keyboardState, const GLboolean & mouseMove) {
@@ -9,6 +9,7 @@
 // https://www.youtube.com/watch?v=L2aiuDDFNIk
 
 #include "Game.h"
+#include "../window/GLState.h"
 
 // Controls
 CControl *controlled = nullptr; // hold the current control that is beign manipulated
@@ -595,6 +596,16 @@ void Game::LoadControls() {
     CSlider *ssaoNoise = (CSlider *)AddControl(new CSlider("Noise", 0.0f, 12.0f, 5, guiBox,
                                                             GUIMode::DYNAMIC, false, PostProcessingEffectMode::SSAO));
     ssaoNoise->SetValue(&m_ssaoNoiseSize);
+    guiBox->y += guiBox->height + 5;
+    
+    guiBox->height = itemHeight * static_cast<GLint>(SSAOQuality::NumberOfTiers);
+    CListBox * ssaoQuality = (CListBox *)AddControl(new CListBox(guiBox, itemHeight,
+                                                                 GUIMode::DYNAMIC, false, PostProcessingEffectMode::SSAO));
+    for (GLuint i = 0; i < static_cast<GLuint>(SSAOQuality::NumberOfTiers); i++) {
+        ssaoQuality->AddItem(SSAOQualityToString(static_cast<SSAOQuality>(i)));
+    }
+    ssaoQuality->SetValue(&m_ssaoQuality, &m_ssaoQualityChanged);
+    guiBox->height = itemHeight;
     
     // Fast Approximate Anti Aliasing
     guiBox->y = rightStartingY + ppfxY + guiBox->height + spaceAtCoverage;
@@ -711,11 +722,11 @@ void Game::RenderControls() {
     CShaderProgram *hudProgram = (*m_pShaderPrograms)[0];
     SetMaterialUniform(hudProgram, "material", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
     
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    CGLState::Instance().Disable(GL_DEPTH_TEST);
+    CGLState::Instance().Enable(GL_BLEND);
     //glBlendFunc(GL_SRC_ALPHA, GL_ONE);          // Type Of Blending To Perform
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_TEXTURE_2D);                   // disable texture mapping
+    CGLState::Instance().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    CGLState::Instance().Disable(GL_TEXTURE_2D);                   // disable texture mapping
     glShadeModel(GL_SMOOTH);
     
     for (std::list<CControl *>::iterator it = CControl::m_controls.begin(); it != CControl::m_controls.end(); it++) {
@@ -747,9 +758,9 @@ void Game::RenderControls() {
         }
         
     }
-    glDisable(GL_BLEND);                // Re-Disable Blending
-    glEnable(GL_DEPTH_TEST);            // Re-Enable Depth Testing
-    glEnable(GL_TEXTURE_2D);            // Re-Enable Texture Mapping
+    CGLState::Instance().Disable(GL_BLEND);                // Re-Disable Blending
+    CGLState::Instance().Enable(GL_DEPTH_TEST);            // Re-Enable Depth Testing
+    CGLState::Instance().Enable(GL_TEXTURE_2D);            // Re-Enable Texture Mapping
     
      
     for (std::list<CControl *>::iterator it = CControl::m_controls.begin(); it != CControl::m_controls.end(); it++) {
@@ -1015,6 +1026,21 @@ void Game::UpdateKeyBoardControls(KeyboardState &state) {
             case GLFW_KEY_O:
                 state.m_isSlowMotion = !state.m_isSlowMotion;
                 break;
+            case GLFW_KEY_C:
+                m_useCulling = !m_useCulling;
+                break;
+            case GLFW_KEY_N:
+                m_useOcclusionCulling = !m_useOcclusionCulling;
+                break;
+            case GLFW_KEY_V:
+                m_showOcclusionBuffer = !m_showOcclusionBuffer;
+                break;
+            case GLFW_KEY_G:
+                m_useIndirect = !m_useIndirect;
+                break;
+            case GLFW_KEY_M:
+                m_pipelineScene = !m_pipelineScene;
+                break;
             case GLFW_KEY_Q:
                 std::get<0>(m_pointLights[m_pointLightIndex]).y += 25.0f;
                 break;
@@ -1033,6 +1059,21 @@ void Game::UpdateKeyBoardControls(KeyboardState &state) {
             case GLFW_KEY_D:
                 std::get<0>(m_pointLights[m_pointLightIndex]).z += 25.0f;
                 break;
+            case GLFW_KEY_P:
+                // push the current effect onto the effect stack
+                if (IsPPFXStackable(m_currentPPFXMode)) {
+                    m_ppfxStack.push_back(m_currentPPFXMode);
+                    m_ppfxStackChanged = true;
+                } else {
+                    printf("%s can not be stacked\n", PostProcessingEffectToString(m_currentPPFXMode));
+                }
+                break;
+            case GLFW_KEY_BACKSPACE:
+                if (!m_ppfxStack.empty()) {
+                    m_ppfxStack.pop_back();
+                    m_ppfxStackChanged = true;
+                }
+                break;
             default:
                 break;
         }
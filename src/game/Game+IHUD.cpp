@@ -7,6 +7,7 @@
 //
 
 #include "Game.h"
+#include "../window/GLState.h"
 
 void Game::RenderHUD(){
     
@@ -15,11 +16,11 @@ void Game::RenderHUD(){
     GLint height = m_gameWindow->GetHeight();
     glm::mat4 orthoMatrix =  glm::ortho(0.0f, GLfloat(width), 0.0f, GLfloat(height));
     
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    CGLState::Instance().Disable(GL_DEPTH_TEST);
+    CGLState::Instance().Enable(GL_BLEND);
     //glBlendFunc(GL_SRC_ALPHA, GL_ONE);          // Type Of Blending To Perform
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_TEXTURE_2D);                   // disable texture mapping
+    CGLState::Instance().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    CGLState::Instance().Disable(GL_TEXTURE_2D);                   // disable texture mapping
     glShadeModel(GL_SMOOTH);
     
     hudProgram->UseProgram();
@@ -29,9 +30,26 @@ void Game::RenderHUD(){
     // render labels
     RenderLabels(m_pFtFont, hudProgram, width, height, m_framesPerSecond, m_enableHud);
     
-    glDisable(GL_BLEND);                // Re-Disable Blending
-    glEnable(GL_DEPTH_TEST);            // Re-Enable Depth Testing
-    glEnable(GL_TEXTURE_2D);            // Re-Enable Texture Mapping
+    // the occlusion buffer of the last scene layer at twice its size in the bottom right corner, V shows it
+    if (m_showOcclusionBuffer) {
+        const GLint bufferWidth = m_pOcclusionCuller->GetWidth(), bufferHeight = m_pOcclusionCuller->GetHeight();
+        m_pOcclusionCuller->GetDebugImage(m_occlusionImage);
+        m_pOcclusionTexture->CreateFromData(&m_occlusionImage[0], bufferWidth, bufferHeight, 8, GL_RED, TextureType::DEPTH, false);
+        m_pOcclusionTexture->BindTexture2DToTextureType();
+        
+        glm::mat4 modelView = glm::translate(glm::mat4(1.0f), glm::vec3(GLfloat(width - bufferWidth - 20), GLfloat(bufferHeight + 20), 0.0f));
+        modelView = glm::scale(modelView, glm::vec3(GLfloat(bufferWidth), GLfloat(bufferHeight), 1.0f));
+        hudProgram->SetUniform("bUseScreenQuad", false);
+        hudProgram->SetUniform("material.bUseTexture", true);
+        hudProgram->SetUniform("matrices.modelViewMatrix", modelView);
+        SetMaterialUniform(hudProgram, "material", glm::vec4(1.0f));
+        m_pQuad->Render(false);
+        SetMaterialUniform(hudProgram, "material", m_textColor);
+    }
+    
+    CGLState::Instance().Disable(GL_BLEND);                // Re-Disable Blending
+    CGLState::Instance().Enable(GL_DEPTH_TEST);            // Re-Enable Depth Testing
+    CGLState::Instance().Enable(GL_TEXTURE_2D);            // Re-Enable Texture Mapping
     
 }
 
@@ -45,6 +63,94 @@ void Game::RenderLabels(CFreeTypeFont *font, CShaderProgram *fontProgram, const
             fontProgram->SetUniform("material.bUseTexture", true);
             font->Render(fontProgram, 20, 20, 20, "FPS: %d", framesPerSecond);
             font->Render(fontProgram, (width / 2) - 100, height - 20, 20, "%s", PostProcessingEffectToString(m_currentPPFXMode));
+            
+            // texture memory per category
+            const CTextureResidency &residency = CTextureResidency::Instance();
+            const GLfloat mb = 1024.0f * 1024.0f;
+            font->Render(fontProgram, 20, 40, 15, "Textures: %.1f / %.1f MB, evicted %d, restreamed %d",
+                         residency.GetUsage() / mb, residency.GetBudget() / mb, residency.GetEvictions(), residency.GetRestreams());
+            for (GLuint i = 0; i < static_cast<GLuint>(TextureCategory::NumberOfCategories); ++i) {
+                TextureCategory category = static_cast<TextureCategory>(i);
+                font->Render(fontProgram, 20, 60 + (i * 15), 15, "%s: %.1f MB", residency.CategoryToString(category), residency.GetUsage(category) / mb);
+            }
+            
+            // gl calls that reached the driver last frame and the redundant ones dropped
+            const CGLState &state = CGLState::Instance();
+            font->Render(fontProgram, 20, 60 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "GL state: %d issued, %d filtered", state.GetIssued(), state.GetFiltered());
+            
+            // uniform values sent last frame and the ones that repeated what the program already had
+            font->Render(fontProgram, 20, 75 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "Uniforms: %d bytes uploaded, %d unchanged", CShaderProgram::GetUploadedBytes(), CShaderProgram::GetSkippedUploads());
+            
+            // scene objects of the last instanced layer and the draws they took
+            font->Render(fontProgram, 20, 90 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "Instancing: %d objects in %d draws", m_instancedObjectCount, m_instancedDrawCount);
+            
+            // binds the sorted scene objects needed last frame
+            font->Render(fontProgram, 20, 105 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "Render queue: %d program, %d material, %d mesh changes", m_renderQueue.GetProgramChanges(),
+                         m_renderQueue.GetMaterialChanges(), m_renderQueue.GetMeshChanges());
+            
+            // objects of every pass last frame inside and outside their frustum, C turns culling off
+            font->Render(fontProgram, 20, 120 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "Culling: %d visible, %d culled%s", m_pFrustumCuller->GetVisible(), m_pFrustumCuller->GetCulled(),
+                         m_useCulling ? "" : " (off)");
+            
+            // boxes tested against the occlusion buffer last frame and the ones behind its occluders, N turns it off
+            font->Render(fontProgram, 20, 135 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "Occlusion: %d triangles, %d of %d occluded%s", m_pOcclusionCuller->GetTriangles(),
+                         m_pOcclusionCuller->GetOccluded(), m_pOcclusionCuller->GetTested(), m_useOcclusionCulling ? "" : " (off)");
+            
+            // objects of the last GPU driven layer and the multi draws they took, G goes back to the CPU path
+            font->Render(fontProgram, 20, 150 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "GPU culling: %d objects in %d multi draws%s", m_indirectObjectCount, m_indirectDrawCount,
+                         !m_indirectSupported ? " (needs GL 4.3)" : (m_useIndirect ? "" : " (off)"));
+            
+            // how full the shared static mesh buffers are and how scattered their free space is
+            const CGeometryArena &arena = CGeometryArena::Instance();
+            const GeometryArenaStats geometry = arena.GetStats(VertexLayout::Standard);
+            const GLfloat vertexMb = CGeometryArena::GetStride(VertexLayout::Standard) / mb;
+            font->Render(fontProgram, 20, 165 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "Geometry: %d meshes, %.1f / %.1f MB, %d free blocks, %.0f%% fragmented, %d defragmentations",
+                         geometry.allocations, geometry.vertexUsed * vertexMb + geometry.indexUsed * sizeof(GLuint) / mb,
+                         geometry.vertexCapacity * vertexMb + geometry.indexCapacity * sizeof(GLuint) / mb,
+                         geometry.vertexFreeBlocks + geometry.indexFreeBlocks, geometry.fragmentation * 100.0f,
+                         arena.GetDefragmentations());
+            
+            // work UpdateScene did this frame against the passes that drew the scene, none of it repeats per pass
+            font->Render(fontProgram, 20, 180 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "Update: %d metaball steps, %d surfaces, %d transforms recomputed for %d scene passes",
+                         m_pMetaballs->GetUpdates(), m_pMetaballs->GetPolygonisations(), m_sceneTransforms, m_scenePasses);
+            
+            // averages of the current mode of the scene pipeline next to the other one, M switches between them
+            const ScenePipelineStats &current = m_scenePipeline.GetStats(m_scenePipeline.IsRunning());
+            const ScenePipelineStats &other = m_scenePipeline.GetStats(!m_scenePipeline.IsRunning());
+            font->Render(fontProgram, 20, 195 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                         "Pipeline: %s %.2f ms (%.0f fps), latency %.2f ms, simulation %.2f ms, waited %.2f ms | %s %.2f ms, latency %.2f ms",
+                         m_scenePipeline.IsRunning() ? "pipelined" : "serial", current.frameTime,
+                         current.frameTime > 0.0 ? 1000.0 / current.frameTime : 0.0, current.latency, current.simulationTime,
+                         current.waitTime, m_scenePipeline.IsRunning() ? "serial" : "pipelined", other.frameTime, other.latency);
+            
+            // gpu time of every ssao tier used so far
+            if (m_currentPPFXMode == PostProcessingEffectMode::SSAO) {
+                for (GLuint i = 0; i < static_cast<GLuint>(SSAOQuality::NumberOfTiers); ++i) {
+                    font->Render(fontProgram, 20, 210 + ((static_cast<GLint>(TextureCategory::NumberOfCategories) + i) * 15), 15,
+                                 "SSAO %s: %.2f ms%s", SSAOQualityToString(static_cast<SSAOQuality>(i)), m_ssaoTimers[i].GetElapsed(),
+                                 i == m_ssaoQuality ? " <" : "");
+                }
+            }
+            
+            // the effect stack, P adds the current effect and backspace removes the last one
+            if (UsesPPFXStack(m_currentPPFXMode)) {
+                std::string stack;
+                for (const PostProcessingEffectMode &effect : m_ppfxStack)
+                    stack += (stack.empty() ? "" : " > ") + std::string(PostProcessingEffectToString(effect));
+                font->Render(fontProgram, 20, 210 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15, "Stack: %s", stack.c_str());
+                font->Render(fontProgram, 20, 225 + (static_cast<GLint>(TextureCategory::NumberOfCategories) * 15), 15,
+                             "Stack: %d passes, %d saved, %.1f MB instead of %.1f MB", m_ppfxStackPasses, m_ppfxStackSaved,
+                             m_ppfxStackFusedBandwidth, m_ppfxStackBandwidth);
+            }
         }
     }
     
@@ -7,88 +7,113 @@
 //
 
 #include "Game.h"
+#include "../buffers/UniformBlocks.h"
 
-void Game::SetLightUniform(CShaderProgram *pShaderProgram, const GLboolean &useDir, const GLboolean &usePoint,
-                           const GLboolean &useSpot, const GLboolean &useSmoothSpot, const GLboolean& useBlinn) {
-    pShaderProgram->UseProgram();
-    pShaderProgram->SetUniform("bUseDirectionalLight", useDir);
-    pShaderProgram->SetUniform("bUsePointLight", usePoint);
-    pShaderProgram->SetUniform("bUseSpotlight", useSpot);
-    pShaderProgram->SetUniform("bUseSmoothSpot", useSmoothSpot);
-    pShaderProgram->SetUniform("bUseBlinn", useBlinn);
+void Game::InitialiseLights() {
+    m_pLightsUBO->Create(UniformBlockType::Lights, sizeof(LightsBlock));
+    m_pShadowUBO->Create(UniformBlockType::Shadow, sizeof(ShadowBlock));
 }
 
-void Game::SetHRDLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
-                        const GLfloat & exposure, const GLfloat & gamma, const GLboolean &useHDR) {
+void Game::SetHRDLightUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName,
+                        const GLfloat & exposure, const GLfloat & gamma) {
     pShaderProgram->UseProgram();
-    pShaderProgram->SetUniform(uniformName + ".exposure", exposure);
-    pShaderProgram->SetUniform(uniformName + ".gamma", gamma);
-    pShaderProgram->SetUniform(uniformName + ".bHDR", useHDR);
+    pShaderProgram->SetUniform(CUniformName(uniformName, ".exposure"), exposure);
+    pShaderProgram->SetUniform(CUniformName(uniformName, ".gamma"), gamma);
 }
 
-void Game::SetDirectionalLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
-                                      const DirectionalLight& directionalLight, const glm::vec3& direction, const glm::vec3 &position) {
+void Game::SetShadowUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName, const GLfloat &bias) {
     pShaderProgram->UseProgram();
-    pShaderProgram->SetUniform(uniformName + ".base.color", directionalLight.color);
-    pShaderProgram->SetUniform(uniformName + ".base.intensity", directionalLight.intensity);
-    pShaderProgram->SetUniform(uniformName + ".base.ambient", m_ambient);
-    pShaderProgram->SetUniform(uniformName + ".base.diffuse", m_diffuse);
-    pShaderProgram->SetUniform(uniformName + ".base.specular", m_specular);
-    pShaderProgram->SetUniform(uniformName + ".direction", direction);
-    pShaderProgram->SetUniform(uniformName + ".position", position);
-    
+    pShaderProgram->SetUniform(CUniformName(uniformName, ".znear"), (GLfloat)SHADOW_ZNEAR);
+    pShaderProgram->SetUniform(CUniformName(uniformName, ".zfar"), (GLfloat)SHADOW_ZFAR);
+    pShaderProgram->SetUniform(CUniformName(uniformName, ".bias"), bias);
+    pShaderProgram->SetUniform(CUniformName(uniformName, ".bFromLightOrCamera"), m_fromLightPosition);
+    pShaderProgram->SetUniform(CUniformName(uniformName, ".bShowDepth"), m_showDepth);
 }
 
-void Game::SetPointLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, const PointLight& pointLight)
-{
-    // POINT LIGHT
-    pShaderProgram->UseProgram();
-    pShaderProgram->SetUniform(uniformName + ".base.color", pointLight.color);
-    pShaderProgram->SetUniform(uniformName + ".base.intensity", pointLight.intensity);
-    pShaderProgram->SetUniform(uniformName + ".base.ambient", m_ambient);
-    pShaderProgram->SetUniform(uniformName + ".base.diffuse", m_diffuse);
-    pShaderProgram->SetUniform(uniformName + ".base.specular", m_specular);
-    pShaderProgram->SetUniform(uniformName + ".attenuation.constant", pointLight.attenuation.constant);
-    pShaderProgram->SetUniform(uniformName + ".attenuation.linear", pointLight.attenuation.linear);
-    pShaderProgram->SetUniform(uniformName + ".attenuation.exponent", pointLight.attenuation.exponent);
+// Lights block, every light is uploaded once per frame, the program variant chooses which ones are used
+void Game::UpdateLightUniformBlock(CCamera *camera) {
+    LightsBlock block = {};
     
-    pShaderProgram->SetUniform(uniformName + ".position", pointLight.position);
-    pShaderProgram->SetUniform(uniformName + ".range", pointLight.range);
-}
-
-void Game::SetSpotLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, const SpotLight& spotLight, CCamera *camera)
-{
-    // SPOT LIGHT
-    pShaderProgram->UseProgram();
-    pShaderProgram->SetUniform(uniformName + ".pointLight.base.color", spotLight.color);
-    pShaderProgram->SetUniform(uniformName + ".pointLight.base.intensity", spotLight.intensity);
-    pShaderProgram->SetUniform(uniformName + ".pointLight.base.ambient", m_ambient);
-    pShaderProgram->SetUniform(uniformName + ".pointLight.base.diffuse", m_diffuse);
-    pShaderProgram->SetUniform(uniformName + ".pointLight.base.specular", m_specular);
+    // the shadow casting light, the last enabled light wins
+    GLboolean castShadow = false;
+    glm::vec3 shadowLightPos;
     
-    pShaderProgram->SetUniform(uniformName + ".pointLight.attenuation.constant", spotLight.attenuation.constant);
-    pShaderProgram->SetUniform(uniformName + ".pointLight.attenuation.linear", spotLight.attenuation.linear);
-    pShaderProgram->SetUniform(uniformName + ".pointLight.attenuation.exponent", spotLight.attenuation.exponent);
+    // Directional light
+    glm::vec3 dirLightPos = std::get<0>(m_pointLights.back());
+    DirectionalLight dirLight(m_dirColor, m_dirIntensity);
+    block.directionalLight.base = { dirLight.color, dirLight.intensity, m_ambient, m_diffuse, m_specular, 0.0f };
+    block.directionalLight.direction = m_directionalLightDirection;
+    block.directionalLight.position = dirLightPos;
+    if (m_useDir) {
+        castShadow = true;
+        shadowLightPos = dirLightPos;
+    }
     
-    pShaderProgram->SetUniform(uniformName + ".pointLight.position", spotLight.position);
-    pShaderProgram->SetUniform(uniformName + ".pointLight.range", spotLight.range);
-    pShaderProgram->SetUniform(uniformName + ".direction", camera->GetForward() );
-    pShaderProgram->SetUniform(uniformName + ".cutOff", spotLight.cutOff);
-    pShaderProgram->SetUniform(uniformName + ".outerCutOff", spotLight.outerCutOff);
-
-}
+    // Point Light
+    for (auto it = m_pointLights.begin(); it != m_pointLights.end() && it - m_pointLights.begin() < NUMBER_OF_POINT_LIGHTS; ++it) {
+        auto i = std::distance(m_pointLights.begin(), it);
+        glm::vec3 position = std::get<0>(*it);
+        if (m_pHeightmapTerrain->IsHeightMapRendered()) {
+            position = glm::vec3(position.x, position.y+m_pHeightmapTerrain->ReturnGroundHeight(position), position.z);
+        }
+        glm::vec3 color = glm::vec3(std::get<1>(*it));
+        PointLight pointLight(color, m_pointIntensity, Attenuation(m_constant, m_linear, m_exponent), position);
+        PointLightBlock &pointBlock = block.pointLights[i];
+        pointBlock.base = { pointLight.color, pointLight.intensity, m_ambient, m_diffuse, m_specular, 0.0f };
+        pointBlock.attenuation = { pointLight.attenuation.constant, pointLight.attenuation.linear, pointLight.attenuation.exponent, 0.0f };
+        pointBlock.position = pointLight.position;
+        pointBlock.range = pointLight.range;
+        if (m_usePoint) {
+            castShadow = true;
+            shadowLightPos = position;
+        }
+    }
+    
+    //Spot Light
+    GLfloat cutOff = glm::cos(glm::radians(m_spotCutOff));
+    GLfloat outerCutOff = glm::cos(glm::radians(m_spotOuterCutOff));
+    SpotLight spotLight(m_spotColor, m_spotIntensity, Attenuation(m_constant, m_linear, m_exponent), camera->GetPosition(), cutOff, outerCutOff);
+    PointLightBlock &spotBlock = block.spotLight.pointLight;
+    spotBlock.base = { spotLight.color, spotLight.intensity, m_ambient, m_diffuse, m_specular, 0.0f };
+    spotBlock.attenuation = { spotLight.attenuation.constant, spotLight.attenuation.linear, spotLight.attenuation.exponent, 0.0f };
+    spotBlock.position = spotLight.position;
+    spotBlock.range = spotLight.range;
+    block.spotLight.direction = camera->GetForward();
+    block.spotLight.cutOff = spotLight.cutOff;
+    block.spotLight.outerCutOff = spotLight.outerCutOff;
+    if (m_useSpot) {
+        castShadow = true;
+        shadowLightPos = camera->GetPosition();
+    }
+    
+    m_pLightsUBO->UpdateData(&block, sizeof(block));
+    
+    if (castShadow) UpdateShadowUniformBlock(shadowLightPos);
+    
+    //Attenuation courtesy of http://wiki.ogre3d.org/tiki-index.php?page=-Point+Light+Attenuation
+    /*
+     lights, with courtesy of Ogre3D's wiki:
+     
+     Distance    Constant      Linear      Quadratic
+     7              1.0         0.7         1.8
+     13             1.0         0.35        0.44
+     20             1.0         0.22        0.20
+     32             1.0         0.14        0.07
+     50             1.0         0.09        0.032
+     65             1.0         0.07        0.017
+     100            1.0         0.045       0.0075
+     160            1.0         0.027       0.0028
+     200            1.0         0.022       0.0019
+     325            1.0         0.014       0.0007
+     600            1.0         0.007       0.0002
+     3250           1.0         0.0014      0.000007
 
-void Game::SetShadowUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, const GLfloat &bias) {
-    pShaderProgram->UseProgram();
-    pShaderProgram->SetUniform(uniformName+".znear", (GLfloat)SHADOW_ZNEAR);
-    pShaderProgram->SetUniform(uniformName+".zfar", (GLfloat)SHADOW_ZFAR);
-    pShaderProgram->SetUniform(uniformName+".bias", bias);
-    pShaderProgram->SetUniform(uniformName+".bFromLightOrCamera", m_fromLightPosition);
-    pShaderProgram->SetUniform(uniformName+".bShowDepth", m_showDepth);
+     */
 }
 
-void Game::SetShadowMatrix(CShaderProgram *pShaderProgram, const glm::vec3 &lightPosition) {
-    pShaderProgram->UseProgram();
+// Shadow block, light space matrices for the current shadow effect, shared by the depth and shadow mapping programs
+void Game::UpdateShadowUniformBlock(const glm::vec3 &lightPosition) {
+    ShadowBlock block = {};
     
     switch(m_currentPPFXMode) {
         case PostProcessingEffectMode::DepthMapping: {
@@ -105,11 +130,9 @@ void Game::SetShadowMatrix(CShaderProgram *pShaderProgram, const glm::vec3 &ligh
             glm::mat4 lightView = glm::lookAt(lightPos,                     // The  eye is the position of the camera's viewpoint,
                                               glm::vec3(0.0f),              // The center is where you are looking at (a position which in this case is the center of the screen). If you want to use a direction vector D instead of a center position, you can simply use eye + D as the center position, where D can be a unit vector for example.
                                               glm::vec3(0.0f, 1.0f, 0.0f)); // The up vector is basically a vector defining your world's "upwards" direction. In almost all normal cases, this will be the vector (0, 1, 0) i.e. towards positive Y.
-            glm::mat4 lightSpaceMatrix = lightProjection * (m_fromLightPosition ? lightView : m_pCamera->GetViewMatrix());
-            CShaderProgram *pLightSpaceProgram = (*m_pShaderPrograms)[51];
-            pLightSpaceProgram->UseProgram();
-            pLightSpaceProgram->SetUniform("matrices.lightSpaceMatrix", lightSpaceMatrix);
-            
+            block.lightSpaceMatrix = lightProjection * (m_fromLightPosition ? lightView : m_pCamera->GetViewMatrix());
+            m_pShadowUBO->UpdateData(&block.lightSpaceMatrix, sizeof(block.lightSpaceMatrix), offsetof(ShadowBlock, lightSpaceMatrix));
+            m_shadowCullMatrix = block.lightSpaceMatrix;
             return;
         }
         case PostProcessingEffectMode::DirectionalShadowMapping: {
@@ -124,8 +147,9 @@ void Game::SetShadowMatrix(CShaderProgram *pShaderProgram, const glm::vec3 &ligh
             glm::mat4 lightView = glm::lookAt(lightPos,                     // The  eye is the position of the camera's viewpoint,
                                               glm::vec3(0.0f),  // THIS COULD BE OUR SHADOW PROBLEM             // The center is where you are looking at (a position which in this case is the center of the screen). If you want to use a direction vector D instead of a center position, you can simply use eye + D as the center position, where D can be a unit vector for example.
                                               glm::vec3(0.0f, 1.0f, 0.0f)); // The up vector is basically a vector defining your world's "upwards" direction. In almost all normal cases, this will be the vector (0, 1, 0) i.e. towards positive Y.
-            glm::mat4 lightSpaceMatrix = lightProjection * (m_fromLightPosition ? lightView : m_pCamera->GetViewMatrix());
-            pShaderProgram->SetUniform("matrices.lightSpaceMatrix", lightSpaceMatrix);
+            block.lightSpaceMatrix = lightProjection * (m_fromLightPosition ? lightView : m_pCamera->GetViewMatrix());
+            m_pShadowUBO->UpdateData(&block.lightSpaceMatrix, sizeof(block.lightSpaceMatrix), offsetof(ShadowBlock, lightSpaceMatrix));
+            m_shadowCullMatrix = block.lightSpaceMatrix;
             return;
         }
         case PostProcessingEffectMode::OmnidirectionalShadowMapping: {
@@ -141,8 +165,14 @@ void Game::SetShadowMatrix(CShaderProgram *pShaderProgram, const glm::vec3 &ligh
             shadowTransforms.push_back(shadowProj * glm::lookAt(lightPosition, lightPosition + glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f)));
             
             for (unsigned int i = 0; i < 6; ++i) {
-                pShaderProgram->SetUniform("shadowMatrices[" + std::to_string(i) + "]", shadowTransforms[i]);
+                block.shadowMatrices[i] = shadowTransforms[i];
             }
+            m_pShadowUBO->UpdateData(block.shadowMatrices, sizeof(block.shadowMatrices), offsetof(ShadowBlock, shadowMatrices));
+            
+            // the six faces together see everything within the far plane of the light, cull against that box
+            GLfloat reach = (GLfloat)SHADOW_ZFAR;
+            m_shadowCullMatrix = glm::ortho(-reach, reach, -reach, reach, -reach, reach)
+                * glm::lookAt(lightPosition, lightPosition + glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
             return;
         }
         default: return;
@@ -150,62 +180,6 @@ void Game::SetShadowMatrix(CShaderProgram *pShaderProgram, const glm::vec3 &ligh
     
 }
 
-void Game::RenderLight(CShaderProgram *pShaderProgram,
-                        const std::string &dirName,
-                        const std::string &pointName,
-                        const std::string &spotName,
-                        CCamera *camera,
-                        const GLboolean &useShadowMatrix) {
-    pShaderProgram->UseProgram();
-    glm::vec3 dirLightPos = std::get<0>(m_pointLights.back());
-                            
-    // Directional light
-    DirectionalLight dirLight(m_dirColor, m_dirIntensity);
-    SetDirectionalLightUniform(pShaderProgram, dirName, dirLight, m_directionalLightDirection, dirLightPos);
-    if (useShadowMatrix && m_useDir) SetShadowMatrix(pShaderProgram, dirLightPos);
-
-    // Point Light
-    for (auto it = m_pointLights.begin(); it != m_pointLights.end(); ++it) {
-        auto i = std::distance(m_pointLights.begin(), it);
-        std::string uniformName = pointName+"[" + std::to_string(i) + "]";
-        glm::vec3 position = std::get<0>(*it);
-        if (m_pHeightmapTerrain->IsHeightMapRendered()) {
-            position = glm::vec3(position.x, position.y+m_pHeightmapTerrain->ReturnGroundHeight(position), position.z);
-        }
-        glm::vec3 color = glm::vec3(std::get<1>(*it));
-        PointLight pointLight(color, m_pointIntensity, Attenuation(m_constant, m_linear, m_exponent), position);
-        SetPointLightUniform(pShaderProgram, uniformName, pointLight);
-        if (useShadowMatrix && m_usePoint) SetShadowMatrix(pShaderProgram, position);
-    }
-    
-    //Spot Light
-    GLfloat cutOff = glm::cos(glm::radians(m_spotCutOff));
-    GLfloat outerCutOff = glm::cos(glm::radians(m_spotOuterCutOff));
-    SpotLight spotLight(m_spotColor, m_spotIntensity, Attenuation(m_constant, m_linear, m_exponent), camera->GetPosition(), cutOff, outerCutOff);
-    SetSpotLightUniform(pShaderProgram, spotName, spotLight, m_pCamera);
-    if (useShadowMatrix && m_useSpot) SetShadowMatrix(pShaderProgram, camera->GetPosition());
-
-    //Attenuation courtesy of http://wiki.ogre3d.org/tiki-index.php?page=-Point+Light+Attenuation
-    /*
-     lights, with courtesy of Ogre3D's wiki:
-     
-     Distance    Constant      Linear      Quadratic
-     7              1.0         0.7         1.8
-     13             1.0         0.35        0.44
-     20             1.0         0.22        0.20
-     32             1.0         0.14        0.07
-     50             1.0         0.09        0.032
-     65             1.0         0.07        0.017
-     100            1.0         0.045       0.0075
-     160            1.0         0.027       0.0028
-     200            1.0         0.022       0.0019
-     325            1.0         0.014       0.0007
-     600            1.0         0.007       0.0002
-     3250           1.0         0.0014      0.000007
-
-     */
-}
-
 void Game::RenderLamp(CShaderProgram *pShaderProgram, const glm::vec3 &position, const glm::vec3 & scale) {
     glm::vec3 pos = position;
     if (m_pHeightmapTerrain->IsHeightMapRendered()) {
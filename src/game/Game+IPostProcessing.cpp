@@ -7,6 +7,11 @@
 //
 
 #include "Game.h"
+#include "../window/GLState.h"
+#include "../shaders/ShaderPrewarmer.h"
+
+// pool index of the targets kept from one frame to the next, past the ones the graph slots use
+static const GLuint PPFX_HISTORY_INDEX = 64;
 
 /// initialise frame buffer elements
 void Game::InitialiseFrameBuffers(const GLuint &width , const GLuint &height) {
@@ -16,6 +21,11 @@ void Game::InitialiseFrameBuffers(const GLuint &width , const GLuint &height) {
     m_changePPFXMode = false;
     m_prevPPFXMode = false;
     m_nextPPFXMode = false;
+    m_ppfxStackChanged = false;
+    m_ppfxStackPasses = 0;
+    m_ppfxStackSaved = 0;
+    m_ppfxStackBandwidth = 0.0f;
+    m_ppfxStackFusedBandwidth = 0.0f;
     
     m_screenWaveOffset = 1.0f;
     m_swirlRadius = 0.0f;
@@ -102,6 +112,12 @@ void Game::InitialiseFrameBuffers(const GLuint &width , const GLuint &height) {
         m_ssaoNoise.push_back(noise);
     }
     
+    m_ssaoQuality = static_cast<GLuint>(SSAOQuality::Full);
+    m_ssaoQualityChanged = false;
+    m_ssaoFrame = 0;
+    m_ssaoHistoryValid = false;
+    m_ssaoPreviousView = glm::mat4(1.0f);
+    
     
     // Depth and Shadow Mapping
     m_fromLightPosition = true;
@@ -112,36 +128,25 @@ void Game::InitialiseFrameBuffers(const GLuint &width , const GLuint &height) {
     m_ffaaOffset = 50.0f;
     
     
-    // framebuffers
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
-    m_pFBOs.push_back(new CFrameBufferObject);
+    // framebuffers come from the pool when an effect first needs them
+    m_ppfxPyramidLevels = 6; // down to 1/64 of the window
+    m_ppfxGraphMode = PostProcessingEffectMode::NumberOfPPFX;
+    m_ppfxSwitching = false;
+    m_ppfxSwitchAllocations = 0;
+    
+    // convolution effects filter in compute shaders where the context has them, GL 4.1 keeps the fragment shaders
+    m_ppfxCompute = GLEW_ARB_compute_shader && GLEW_ARB_shader_image_load_store;
+    printf("Post processing convolutions: %s\n", m_ppfxCompute ? "compute shaders" : "fragment shaders");
 }
 
-/// create frame buffers
+/// fit the frame buffer pool to the window
 void Game::LoadFrameBuffers(const GLuint &width , const GLuint &height) {
 
-    m_pFBOs[0]->CreateFramebuffer(width, height, FrameBufferType::Default);
-    m_pFBOs[1]->CreateFramebuffer(width, height, FrameBufferType::DeferredRendering);
-    m_pFBOs[2]->CreateFramebuffer(width, height, FrameBufferType::PingPongRendering);
-    m_pFBOs[3]->CreateFramebuffer(width, height, FrameBufferType::DepthMapping);
-    m_pFBOs[4]->CreateFramebuffer(width, height, FrameBufferType::Default);
-    m_pFBOs[5]->CreateFramebuffer(width, height, FrameBufferType::SSAO);
-    m_pFBOs[6]->CreateFramebuffer(width, height, FrameBufferType::SSAO);
-    m_pFBOs[7]->CreateFramebuffer(width, height, FrameBufferType::DirectionalShadowMapping);
-    m_pFBOs[8]->CreateFramebuffer(width, height, FrameBufferType::OmnidirectionalShadowMapping);
-    m_pFBOs[9]->CreateFramebuffer(width, height, FrameBufferType::HighDynamicRangeRendering);
-    m_pFBOs[10]->CreateFramebuffer(width, height, FrameBufferType::HighDynamicRangeLighting);
-    m_pFBOs[11]->CreateFramebuffer(width, height, FrameBufferType::GeometryBuffer);
+    // only a new window size throws the pooled targets away
+    if (m_ppfxTargets.Resize(width, height) && m_ppfxTargets.GetAllocations() > 0) {
+        printf("Post processing targets released for %dx%d\n", width, height);
+        m_ssaoHistoryValid = false;
+    }
 }
 
 
@@ -172,833 +177,942 @@ void Game::ChangePPFXScene(PostProcessingEffectMode &mode) {
 /// actvate frame buffer and stop rendering to the default framebuffer
 void Game::BindPPFXFBO(const PostProcessingEffectMode &mode) {
     
-    // start by deleting the current fbos when the ppfx mode is changed and then we render again
+    // the pooled targets are kept when the ppfx mode is changed, they are only made again for another window size
+    LoadFrameBuffers(m_gameWindow->GetWidth(), m_gameWindow->GetHeight());
+    
+    // time the switch until the new effect has rendered, the targets it has not used before are allocated on the way
     if (m_changePPFXMode == true) {
-        
-        const GLint width = m_gameWindow->GetWidth();
-        const GLint height = m_gameWindow->GetHeight();
-        
-        for (GLuint i = 0; i < m_pFBOs.size(); i++) {
-            m_pFBOs[i]->Release();
-        }
-        
-        currentFBO->Release();
-        
-        LoadFrameBuffers(width, height);
-        
+        m_ppfxSwitchTimer.Start();
+        m_ppfxSwitchAllocations = m_ppfxTargets.GetAllocations();
+        m_ppfxSwitching = true;
         m_changePPFXMode = false;
     }
     
     FrameBufferType fboType = GetFBOtype(mode);
     
-    switch(fboType) {
-        case FrameBufferType::Default:
-            currentFBO = m_pFBOs[0];
-            // //bind to framebuffer and draw scene as we normally would to color texture
-            //binding the fbo as render target stops rendering to the default framebuffer and you'll see that your screen turns black because the scene is no longer rendered to the default framebuffer. all rendering operations will store their result in the attachments of the newly created framebuffer.
-            currentFBO->Bind(true);     // prepare frame buffer 0
-            break;
-        case FrameBufferType::HighDynamicRangeRendering:
-            currentFBO = m_pFBOs[9];
-            currentFBO->Bind(true);     // prepare frame buffer 1
-            break;
-        case FrameBufferType::HighDynamicRangeLighting:
-            currentFBO = m_pFBOs[10];
-            currentFBO->Bind(true);     // prepare frame buffer 4
-            break;
-        case FrameBufferType::DeferredRendering:
-            currentFBO = m_pFBOs[1];
-            currentFBO->Bind(true);     // prepare frame buffer 1
-            break;
-        case FrameBufferType::GeometryBuffer:
-            currentFBO = m_pFBOs[11];
-            currentFBO->Bind(true);     // prepare frame buffer 1
-            break;
-        default: break;
+    // bind to framebuffer and draw scene as we normally would to color texture
+    // binding the fbo as render target stops rendering to the default framebuffer and you'll see that your screen turns black because the scene is no longer rendered to the default framebuffer. all rendering operations will store their result in the attachments of the newly created framebuffer.
+    currentFBO = GetSceneFBO(fboType);
+    currentFBO->Bind(true);
+
+}
+
+/// declare the passes of an effect, the scene target and the screen come from outside the graph
+void Game::BuildPPFXGraph(CRenderGraph &graph, const PostProcessingEffectMode &mode) {
+    
+    CPostProcessingGraph(graph, GetPPFXGraphSettings(), [this](const PostProcessingPass &pass) {
+        return BindPPFXPass(pass);
+    }).Declare(mode);
+    
+    if (UsesPPFXStack(mode)) {
+        // every pass reads and writes the whole rgba8 target once, neighbourhood taps mostly hit the texture cache
+        const GLuint runs = static_cast<GLuint>(CPostProcessingGraph::GetStackRuns(m_ppfxStack).size());
+        const GLfloat pass = m_gameWindow->GetWidth() * m_gameWindow->GetHeight() * 8.0f / (1024.0f * 1024.0f);
+        m_ppfxStackPasses = runs;
+        m_ppfxStackSaved = static_cast<GLuint>(m_ppfxStack.size()) - runs;
+        m_ppfxStackBandwidth = m_ppfxStack.size() * pass;
+        m_ppfxStackFusedBandwidth = runs * pass;
+    }
+}
+
+/// what the graphs of the effects depend on besides the effect
+PostProcessingGraphSettings Game::GetPPFXGraphSettings() {
+    return PostProcessingGraphSettings{m_ppfxCompute, m_ppfxPyramidLevels, static_cast<SSAOQuality>(m_ssaoQuality), m_ppfxStack};
+}
+
+/// the function a declared pass runs, the resources it uses are the ones it was declared with
+std::function<void()> Game::BindPPFXPass(const PostProcessingPass &pass) {
+    
+    const PostProcessingEffectMode mode = pass.mode;
+    const std::vector<GLuint> reads = pass.reads;
+    const std::vector<GLuint> writes = pass.writes;
+    
+    switch(pass.type) {
+        case PostProcessingPassType::Effect:
+            return [this, reads, mode]() {
+                currentFBO = GetPPFXTarget(reads[0]);
+                RenderPPFXScene(mode);
+            };
+        case PostProcessingPassType::Stack: {
+            const std::vector<PostProcessingEffectMode> run = pass.effects;
+            const GLuint from = reads[0], to = writes[0];
+            const GLboolean first = pass.first, last = pass.last;
+            return [this, run, from, to, first, last]() {
+                if (!last) {
+                    currentFBO = GetPPFXTarget(to);
+                    currentFBO->Bind(true);
+                } else if (!first) {
+                    ResetFrameBuffer(); // back to the screen after the stack targets
+                }
+                
+                currentFBO = GetPPFXTarget(from);
+                if (run.size() == 1) {
+                    RenderPPFXScene(run[0]);
+                    return;
+                }
+                CShaderProgram *pStackProgram = GetPPFXStackProgram(run);
+                SetPostProcessingStackUniform(pStackProgram);
+                RenderToScreen(pStackProgram);
+            };
+        }
+        case PostProcessingPassType::PyramidDownsample: {
+            const GLuint from = reads[0], to = writes[0], i = pass.index, sourceIndex = pass.sourceIndex;
+            const GLuint program = pass.programs[0];
+            return [this, program, from, to, i, sourceIndex]() {
+                CShaderProgram *pDownsampleProgram = (*m_pShaderPrograms)[program];
+                SetBloomDownsampleUniform(pDownsampleProgram, i == 0);
+                
+                currentFBO = GetPPFXTarget(to);
+                currentFBO->Bind(true);
+                
+                currentFBO = GetPPFXTarget(from);
+                RenderToScreen(pDownsampleProgram, m_ppfxGraph.GetType(from), sourceIndex, TextureType::DEPTH);
+            };
+        }
+        case PostProcessingPassType::PyramidUpsample: {
+            const GLuint from = reads[0], to = writes[0], i = pass.index;
+            const GLuint program = pass.programs[0];
+            return [this, program, from, to, i]() {
+                CShaderProgram *pUpsampleProgram = (*m_pShaderPrograms)[program];
+                
+                currentFBO = GetPPFXTarget(from);
+                SetBloomUpsampleUniform(pUpsampleProgram, glm::vec2(1.0f / currentFBO->GetWidth(), 1.0f / currentFBO->GetHeight()));
+                
+                currentFBO = GetPPFXTarget(to);
+                currentFBO->Bind(true, false); // keep the downsampled level to blend onto
+                
+                currentFBO = GetPPFXTarget(from);
+                RenderToScreen(pUpsampleProgram, FrameBufferType::HighDynamicRangeLighting, 0, TextureType::DEPTH);
+                if (i == 1) ResetFrameBuffer();
+            };
+        }
+        case PostProcessingPassType::Convolution: {
+            const GLuint from = reads.back(), to = writes[0];
+            const glm::vec2 direction = pass.direction;
+            const GLboolean final = pass.last;
+            const GLuint program = pass.programs[0];
+            return [this, program, mode, from, to, direction, final]() {
+                DispatchPPFXConvolution((*m_pShaderPrograms)[program], mode, GetPPFXTarget(from), GetPPFXTarget(to), direction, final);
+            };
+        }
+        case PostProcessingPassType::ConvolutionPresent: {
+            const GLuint filtered = reads[0];
+            return [this, filtered]() {
+                GLint width, height;
+                m_gameWindow->GetFramebufferSize(width, height);
+                GetPPFXTarget(filtered)->BlitToScreen(width, height);
+            };
+        }
+        case PostProcessingPassType::GaussianBlurComposite: {
+            const GLuint scene = reads[0], blur = reads[1];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene, blur]() {
+                CShaderProgram *pGaussianBlurProgram = (*m_pShaderPrograms)[program];
+                
+                currentFBO = GetPPFXTarget(scene);
+                currentFBO->BindHDRTexture(0, static_cast<GLint>(TextureType::AMBIENT)); // bind the earlier (scene rendering) rendering from the hrd frame buffer
+                
+                // taking the blured texture and showing it after setviewport, one more pass smooths the half size texels
+                currentFBO = GetPPFXTarget(blur);
+                SetGaussianBlurUniform(pGaussianBlurProgram, true);
+                RenderToScreen(pGaussianBlurProgram, FrameBufferType::HighDynamicRangeLighting, 0, TextureType::DEPTH);
+            };
+        }
+        case PostProcessingPassType::MotionBlurDepth: {
+            const GLuint depth = writes[0];
+            const GLuint program = pass.programs[0];
+            return [this, program, depth]() {
+                currentFBO = GetPPFXTarget(depth);
+                currentFBO->Bind(true); // prepare depth frame buffer
+                RenderScene(true, true, program);
+                ResetFrameBuffer();
+            };
+        }
+        case PostProcessingPassType::MotionBlur: {
+            const GLuint scene = reads[0], depth = reads[1];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene, depth]() {
+                CShaderProgram *pMotionBlurProgram = (*m_pShaderPrograms)[program];
+                SetMotionBlurUniform(pMotionBlurProgram);
+                
+                // bind depth texture
+                currentFBO = GetPPFXTarget(depth);
+                currentFBO->BindDepthTexture(static_cast<GLint>(TextureType::DEPTH));
+                
+                currentFBO = GetPPFXTarget(scene);
+                RenderToScreen(pMotionBlurProgram, FrameBufferType::Default, 0, TextureType::AMBIENT);
+            };
+        }
+        case PostProcessingPassType::Bloom: {
+            const GLuint scene = reads[0], blur = reads[1];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene, blur]() {
+                CShaderProgram *pBloomProgram = (*m_pShaderPrograms)[program];
+                SetBloomUniform(pBloomProgram);
+                
+                currentFBO = GetPPFXTarget(scene);
+                currentFBO->BindHDRTexture(0, static_cast<GLint>(TextureType::AMBIENT)); // bind the earlier (scene rendering) rendering from the hrd frame buffer
+                
+                currentFBO = GetPPFXTarget(blur);
+                RenderToScreen(pBloomProgram, FrameBufferType::HighDynamicRangeLighting, 0, TextureType::DEPTH);
+            };
+        }
+        case PostProcessingPassType::LensFlareGhost: {
+            /*
+             The screen space technique comprises the following 4 steps:
+             
+             1. Downsample the scene image.     // Bright parts
+             2. Blur.                           // Blur image
+             3. Generate lens flare features.   // Lens flare
+             4. Upsample/composite.             // Bring all together
+             
+             There are a couple of important considerations to make regarding the overall rendering pipeline:
+             
+             - Any post process motion blur or depth of field effect must be applied prior to combining the lens flare, so that the lens flare features don't participate in those effects. Technically the lens flare features would exhibit some motion blur, however it's incompatible with post process motion techniques. As a compromise, you could implement the lens flare using an accumulation buffer.
+             - The lens flare should be applied before any tonemapping operation. This makes physical sense, as tonemapping simulates the reaction of the film/CMOS to the incoming light, of which the lens flare is a constituent part
+             */
+            const GLuint blur = reads[0], flare = writes[0];
+            const GLuint program = pass.programs[0];
+            return [this, program, blur, flare]() {
+                currentFBO = GetPPFXTarget(flare);
+                currentFBO->Bind(true); // prepare flare frame buffer
+                
+                CShaderProgram *pLensFlareGhostProgram = (*m_pShaderPrograms)[program];
+                SetLensFlareGhostUniform(pLensFlareGhostProgram);
+                
+                currentFBO = GetPPFXTarget(blur);
+                RenderToScreen(pLensFlareGhostProgram, FrameBufferType::HighDynamicRangeLighting, 0, TextureType::DEPTH);
+                ResetFrameBuffer();
+            };
+        }
+        case PostProcessingPassType::LensFlare: {
+            const GLuint scene = reads[0], flare = reads[1];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene, flare]() {
+                CShaderProgram *pLensFlareProgram = (*m_pShaderPrograms)[program];
+                SetLensFlareUniform(pLensFlareProgram);
+                
+                currentFBO = GetPPFXTarget(flare);
+                currentFBO->BindTexture(static_cast<GLint>(TextureType::LENS));
+                
+                currentFBO = GetPPFXTarget(scene);
+                RenderToScreen(pLensFlareProgram, FrameBufferType::HighDynamicRangeRendering, 0, TextureType::AMBIENT);
+            };
+        }
+        case PostProcessingPassType::OcclusionDownsample: {
+            const GLuint scene = reads[0], geometry = writes[0], level = pass.level;
+            CGPUTimer *pTimer = &m_ssaoTimers[m_ssaoQuality];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene, geometry, level, pTimer]() {
+                pTimer->Begin();
+                currentFBO = GetPPFXTarget(geometry);
+                currentFBO->Bind(true);
+                
+                CShaderProgram *pDownsampleProgram = (*m_pShaderPrograms)[program];
+                SetScreenSpaceAmbientOcclusionDownsampleUniform(pDownsampleProgram, 1 << level);
+                
+                currentFBO = GetPPFXTarget(scene);
+                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::DISPLACEMENT));
+                currentFBO->BindNormalTexture(static_cast<GLint>(TextureType::NORMAL));
+                RenderToScreen(pDownsampleProgram, FrameBufferType::GeometryBuffer, 0, TextureType::AMBIENT, true);
+            };
+        }
+        case PostProcessingPassType::Occlusion: {
+            // In reality, light scatters in all kinds of directions with varying intensities so the indirectly lit parts of a scene should also have varying intensities, instead of a constant ambient component. One type of indirect lighting approximation is called ambient occlusion that tries to approximate indirect lighting by darkening creases, holes and surfaces that are close to each other. These areas are largely occluded by surrounding geometry and thus light rays have less places to escape, hence the areas appear darker.
+            const GLuint geometry = reads[0], raw = writes[0], samples = pass.samples;
+            const GLboolean full = pass.level == 0, temporal = pass.temporal;
+            CGPUTimer *pTimer = &m_ssaoTimers[m_ssaoQuality];
+            const GLuint program = pass.programs[0];
+            return [this, program, geometry, raw, samples, full, temporal, pTimer]() {
+                // the full tier reads the scene itself, the others the geometry of their size
+                if (full) pTimer->Begin();
+                currentFBO = GetPPFXTarget(raw);
+                currentFBO->Bind(true);     // prepare occlusion frame buffer
+                m_gameWindow->ClearBuffers(ClearBuffersType::COLORSTENCIL);
+                
+                // the temporal tiers take the next part of the kernel every frame
+                CShaderProgram *pScreenSpaceAmbientOcclusionProgram = (*m_pShaderPrograms)[program];
+                SetScreenSpaceAmbientOcclusionUniform(pScreenSpaceAmbientOcclusionProgram, glm::vec2(currentFBO->GetWidth(), currentFBO->GetHeight()),
+                                                      samples, temporal ? m_ssaoFrame : 0);
+                
+                // Bind Textures
+                currentFBO = GetPPFXTarget(geometry);
+                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::DISPLACEMENT));
+                currentFBO->BindNormalTexture(static_cast<GLint>(TextureType::NORMAL));
+                RenderToScreen(pScreenSpaceAmbientOcclusionProgram, FrameBufferType::GeometryBuffer, 0, TextureType::AMBIENT, true);
+                if (full) ResetFrameBuffer();
+            };
+        }
+        case PostProcessingPassType::OcclusionBlur: {
+            const GLuint raw = reads[0], blurred = writes[0];
+            const GLboolean full = pass.level == 0;
+            CGPUTimer *pTimer = &m_ssaoTimers[m_ssaoQuality];
+            const GLuint program = pass.programs[0];
+            return [this, program, raw, blurred, full, pTimer]() {
+                currentFBO = GetPPFXTarget(blurred);
+                currentFBO->Bind(true);     // prepare occlusion blur frame buffer
+                if (full) m_gameWindow->ClearBuffers(ClearBuffersType::COLORSTENCIL);
+                
+                CShaderProgram *pScreenSpaceAmbientOcclusionBlurProgram= (*m_pShaderPrograms)[program];
+                SetScreenSpaceAmbientOcclusionBlurUniform(pScreenSpaceAmbientOcclusionBlurProgram);
+                
+                currentFBO = GetPPFXTarget(raw);
+                RenderToScreen(pScreenSpaceAmbientOcclusionBlurProgram, FrameBufferType::SSAO, 0, TextureType::AO);
+                
+                // the full tier ends here, the others are upsampled after
+                if (full) {
+                    ResetFrameBuffer();
+                    pTimer->End();
+                }
+            };
+        }
+        case PostProcessingPassType::OcclusionTemporal: {
+            const GLuint raw = reads[0], geometry = reads[1], samples = pass.samples;
+            const GLuint program = pass.programs[0];
+            return [this, program, raw, geometry, samples]() {
+                GetSSAOHistory(m_ssaoFrame)->Bind(true);
+                
+                CShaderProgram *pTemporalProgram = (*m_pShaderPrograms)[program];
+                SetScreenSpaceAmbientOcclusionTemporalUniform(pTemporalProgram, samples);
+                
+                GetSSAOHistory(m_ssaoFrame + 1)->BindTexture(static_cast<GLint>(TextureType::DEPTH));
+                currentFBO = GetPPFXTarget(geometry);
+                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::DISPLACEMENT));
+                currentFBO = GetPPFXTarget(raw);
+                RenderToScreen(pTemporalProgram, FrameBufferType::SSAO, 0, TextureType::AO);
+                
+                m_ssaoPreviousView = m_pCamera->GetViewMatrix();
+                m_ssaoHistoryValid = true;
+            };
+        }
+        case PostProcessingPassType::OcclusionUpsample: {
+            const GLuint scene = reads[0], geometry = reads[1], filtered = reads[2], occlusion = writes[0];
+            const GLboolean temporal = pass.temporal;
+            CGPUTimer *pTimer = &m_ssaoTimers[m_ssaoQuality];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene, geometry, filtered, occlusion, temporal, pTimer]() {
+                currentFBO = GetPPFXTarget(occlusion);
+                currentFBO->Bind(true);
+                
+                CShaderProgram *pUpsampleProgram = (*m_pShaderPrograms)[program];
+                SetScreenSpaceAmbientOcclusionUpsampleUniform(pUpsampleProgram);
+                
+                currentFBO = GetPPFXTarget(geometry);
+                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::HEIGHT));
+                currentFBO->BindNormalTexture(static_cast<GLint>(TextureType::EMISSION));
+                currentFBO = GetPPFXTarget(scene);
+                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::DISPLACEMENT));
+                currentFBO->BindNormalTexture(static_cast<GLint>(TextureType::NORMAL));
+                
+                currentFBO = temporal ? GetSSAOHistory(m_ssaoFrame) : GetPPFXTarget(filtered);
+                RenderToScreen(pUpsampleProgram, FrameBufferType::SSAO, 0, TextureType::AO);
+                ResetFrameBuffer();
+                pTimer->End();
+                m_ssaoFrame++;
+            };
+        }
+        case PostProcessingPassType::OcclusionLighting: {
+            const GLuint scene = reads[0], occlusionBlur = reads[1];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene, occlusionBlur]() {
+                CShaderProgram *pScreenSpaceAmbientOcclusionLightingProgram= (*m_pShaderPrograms)[program];
+                SetScreenSpaceAmbientOcclusionLightingUniform(pScreenSpaceAmbientOcclusionLightingProgram);
+                
+                // Render Lighting Scene
+                SetMaterialUniform(pScreenSpaceAmbientOcclusionLightingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, true);
+                SetFogMaterialUniform(pScreenSpaceAmbientOcclusionLightingProgram, "fog", m_fogColor);
+                SetHRDLightUniform(pScreenSpaceAmbientOcclusionLightingProgram, m_hdrName, m_exposure, m_gama);
+                
+                currentFBO = GetPPFXTarget(occlusionBlur);
+                currentFBO->BindTexture(static_cast<GLint>(TextureType::AO));
+                
+                currentFBO = GetPPFXTarget(scene);
+                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::DISPLACEMENT));
+                currentFBO->BindNormalTexture(static_cast<GLint>(TextureType::NORMAL));
+                currentFBO->BindAlbedoTexture(static_cast<GLint>(TextureType::DIFFUSE));
+                RenderToScreen(pScreenSpaceAmbientOcclusionLightingProgram, FrameBufferType::GeometryBuffer, 0, TextureType::AMBIENT, true);
+            };
+        }
+        case PostProcessingPassType::DepthTesting: {
+            const GLuint depthView = writes[0];
+            const GLuint program = pass.programs[0];
+            return [this, program, depthView]() {
+                currentFBO = GetPPFXTarget(depthView);
+                currentFBO->Bind(true); // prepare another framebuffer
+                
+                m_gameWindow->ClearBuffers(ClearBuffersType::COLORDEPTHSTENCIL);
+                RenderScene(true, true, program);
+                ResetFrameBuffer();
+            };
+        }
+        case PostProcessingPassType::LightSpaceDepth: {
+            const GLuint depth = writes[0];
+            const GLuint program = pass.programs[0];
+            return [this, program, depth]() {
+                currentFBO = GetPPFXTarget(depth);
+                currentFBO->Bind(false); // prepare depth frame buffer
+                m_gameWindow->SetViewport(SHADOW_WIDTH, SHADOW_HEIGHT);
+                m_gameWindow->ClearBuffers(ClearBuffersType::DEPTH);
+                
+                // light space matrix comes from the shadow block
+                m_cullFromLight = true;
+                RenderScene(true, false, program);
+                m_cullFromLight = false;
+                ResetFrameBuffer();
+            };
+        }
+        case PostProcessingPassType::DepthMapping: {
+            const GLuint scene = reads[0], depth = reads[1];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene, depth]() {
+                CShaderProgram *pDepthMappingProgram = (*m_pShaderPrograms)[program];
+                SetShadowUniform(pDepthMappingProgram, "shadow", m_dirShadowBias);
+                SetMaterialUniform(pDepthMappingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
+                SetDepthMappingUniform(pDepthMappingProgram);
+                
+                // bind depth texture
+                currentFBO = GetPPFXTarget(depth);
+                currentFBO->BindDepthTexture(static_cast<GLint>(TextureType::DEPTH));
+                
+                currentFBO = GetPPFXTarget(scene); // scene texture
+                RenderToScreen(pDepthMappingProgram, FrameBufferType::Default, 0, TextureType::AMBIENT);
+            };
+        }
+        case PostProcessingPassType::DirectionalShadowMapping: {
+            const GLuint depth = reads[0], lit = writes[0];
+            const GLuint program = pass.programs[0];
+            return [this, program, depth, lit]() {
+                m_gameWindow->SetViewport();
+                m_gameWindow->ClearBuffers(ClearBuffersType::COLORDEPTHSTENCIL);
+                
+                // render next scene to framebuffer
+                currentFBO = GetPPFXTarget(lit);
+                currentFBO->Bind(true);
+                
+                // bind depth texture
+                currentFBO = GetPPFXTarget(depth); // depth mapping texture
+                currentFBO->BindDepthTexture(static_cast<GLint>(TextureType::DEPTH));
+                
+                // use depth mapping quad
+                CShaderProgram *pDirectionalShadowMappingProgram = (*m_pShaderPrograms)[program];
+                SetMaterialUniform(pDirectionalShadowMappingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
+                SetFogMaterialUniform(pDirectionalShadowMappingProgram, "fog", m_fogColor);
+                SetShadowUniform(pDirectionalShadowMappingProgram, "shadow", m_dirShadowBias);
+                SetHRDLightUniform(pDirectionalShadowMappingProgram, m_hdrName, m_exposure, m_gama);
+                
+                RenderScene(true, false, program);
+                ResetFrameBuffer();
+            };
+        }
+        case PostProcessingPassType::OmnidirectionalLightSpaceDepth: {
+            const GLuint depth = writes[0];
+            const GLuint program = pass.programs[0];
+            return [this, program, depth]() {
+                
+                // configure global opengl state
+                // -----------------------------
+                m_gameWindow->ClearBuffers(ClearBuffersType::COLORDEPTHSTENCIL);
+                
+                
+                // 1. render scene to depth cubemap
+                // --------------------------------
+                currentFBO = GetPPFXTarget(depth);
+                currentFBO->Bind(false); // prepare depth frame buffer
+                m_gameWindow->SetViewport(SHADOW_WIDTH, SHADOW_HEIGHT);
+                m_gameWindow->ClearBuffers(ClearBuffersType::DEPTH);
+                
+                CShaderProgram *pLightSpaceProgram = (*m_pShaderPrograms)[program];
+                pLightSpaceProgram->UseProgram();
+                
+                SetMaterialUniform(pLightSpaceProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
+                SetShadowUniform(pLightSpaceProgram, "shadow", m_orthShadowBias);
+                
+                m_cullFromLight = true;
+                RenderScene(true, false, program);
+                m_cullFromLight = false;
+                ResetFrameBuffer();
+            };
+        }
+        case PostProcessingPassType::OmnidirectionalShadowMapping: {
+            const GLuint depth = reads[0], lit = writes[0];
+            const GLuint program = pass.programs[0];
+            return [this, program, depth, lit]() {
+                
+                // render next scene to framebuffer
+                currentFBO = GetPPFXTarget(lit);
+                currentFBO->Bind(true);
+                
+                // bind depth texture
+                currentFBO = GetPPFXTarget(depth); // depth mapping texture
+                currentFBO->BindDepthCubeMap(static_cast<GLint>(TextureType::SHADOWMAP));
+                
+                // 2. render scene as normal
+                // -------------------------
+                CShaderProgram *pOmnidirectionalShadowMappingProgram = (*m_pShaderPrograms)[program];
+                SetMaterialUniform(pOmnidirectionalShadowMappingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
+                SetFogMaterialUniform(pOmnidirectionalShadowMappingProgram, "fog", m_fogColor);
+                SetShadowUniform(pOmnidirectionalShadowMappingProgram, "shadow", m_orthShadowBias);
+                SetHRDLightUniform(pOmnidirectionalShadowMappingProgram, m_hdrName, m_exposure, m_gama);
+                
+                RenderScene(true, false, program);
+                ResetFrameBuffer();
+            };
+        }
+        case PostProcessingPassType::SceneComposite: {
+            const GLuint scene = reads[0], rendered = reads[1];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene, rendered]() {
+                // bind the target rendered over the scene
+                currentFBO = GetPPFXTarget(rendered);
+                currentFBO->BindTexture(static_cast<GLint>(TextureType::DIFFUSE)); // bind to diffuse texture
+                
+                currentFBO = GetPPFXTarget(scene); // scene texture
+                CShaderProgram *pImageProcessingProgram = (*m_pShaderPrograms)[program];
+                RenderToScreen(pImageProcessingProgram, FrameBufferType::Default, 0, TextureType::AMBIENT);
+            };
+        }
+        case PostProcessingPassType::DeferredLighting: {
+            const GLuint scene = reads[0];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene]() {
+                CShaderProgram *pDeferredRenderingProgram= (*m_pShaderPrograms)[program];
+                SetMaterialUniform(pDeferredRenderingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
+                SetDeferredRenderingUniform(pDeferredRenderingProgram);
+                
+                // Render Lighting Scene
+                SetHRDLightUniform(pDeferredRenderingProgram, m_hdrName, m_exposure, m_gama);
+                
+                // Bind Textures
+                currentFBO = GetPPFXTarget(scene);
+                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::DISPLACEMENT));
+                currentFBO->BindNormalTexture(static_cast<GLint>(TextureType::NORMAL));
+                currentFBO->BindAlbedoTexture(static_cast<GLint>(TextureType::DIFFUSE));
+                
+                RenderToScreen(pDeferredRenderingProgram, FrameBufferType::DeferredRendering, 0, TextureType::AMBIENT);
+            };
+        }
+        case PostProcessingPassType::DeferredLamps: {
+            const GLuint scene = reads[0];
+            const GLuint program = pass.programs[0];
+            return [this, program, scene]() {
+                // Blit to default frame buffer
+                currentFBO = GetPPFXTarget(scene);
+                currentFBO->BlitToDepthBuffer(0);
+                
+                /// Render Lamps
+                CShaderProgram *pLampProgram = (*m_pShaderPrograms)[program];
+                for (auto it = m_pointLights.begin(); it != m_pointLights.end(); ++it) {
+                    glm::vec3 position = std::get<0>(*it);
+                    glm::vec4 color = std::get<1>(*it);
+                    SetMaterialUniform(pLampProgram, "material", color);
+                    RenderLamp(pLampProgram, position, glm::vec3(10.0f));
+                }
+            };
+        }
+        default:
+            return std::function<void()>();
     }
+}
+
+/// run one compute pass of a convolution effect, the scene is read again for the part the coverage leaves unfiltered
+void Game::DispatchPPFXConvolution(CShaderProgram *pConvolutionProgram, const PostProcessingEffectMode &mode,
+                                   CFrameBufferObject *pSource, CFrameBufferObject *pDestination,
+                                   const glm::vec2 &direction, const GLboolean &final) {
+    
+    SetConvolutionUniform(pConvolutionProgram, mode, direction, final);
+    
+    CFrameBufferObject *pScene = GetSceneFBO(GetFBOtype(mode));
+    pScene->BindTexture(static_cast<GLint>(TextureType::AMBIENT));
+    if (pSource == pScene) pSource->BindTexture(static_cast<GLint>(TextureType::DEPTH));
+    else pSource->BindHDRTexture(static_cast<GLint>(TextureType::DEPTH));
+    pDestination->BindHDRImage(0, GL_WRITE_ONLY);
+    
+    // one work group per 16x16 tile, see ConvolutionShader.comp
+    glDispatchCompute((pDestination->GetWidth() + 15) / 16, (pDestination->GetHeight() + 15) / 16, 1);
+    
+    // the next pass samples the result or blits it
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+}
+
+/// effects that are plain convolutions over the scene and have a compute path
+GLboolean Game::IsPPFXConvolution(const PostProcessingEffectMode &mode) {
+    return CPostProcessingGraph::IsConvolution(mode);
+}
+
+/// the generated program of a run of pointwise effects, built the first time the run is rendered
+CShaderProgram * Game::GetPPFXStackProgram(const std::vector<PostProcessingEffectMode> &effects) {
+    
+    std::string stack = "PPFX_STACK";
+    for (const PostProcessingEffectMode &effect : effects)
+        stack += std::string(" c = ") + CPostProcessingGraph::GetStackFunction(effect) + "(c, uv);";
+    
+    auto it = m_ppfxStackPrograms.find(stack);
+    if (it != m_ppfxStackPrograms.end())
+        return (*m_pShaderPrograms)[it->second];
+    
+    CShader vertex, fragment;
+    vertex.LoadShader(m_shaderPath + "PostProcessingStackShader.vert", GL_VERTEX_SHADER);
+    fragment.LoadShader(m_shaderPath + "PostProcessingStackShader.frag", GL_FRAGMENT_SHADER, {stack});
+    
+    CShaderProgram *pStackProgram = new CShaderProgram;
+    pStackProgram->CreateProgram();
+    pStackProgram->AddShaderToProgram(&vertex);
+    pStackProgram->AddShaderToProgram(&fragment);
+    if (pStackProgram->LinkProgram()) pStackProgram->FinishLink();
+    vertex.DeleteShader();
+    fragment.DeleteShader();
+    
+    // kept after the fixed programs, so the indices of those do not move and reload and release cover this one too
+    m_ppfxStackPrograms[stack] = static_cast<GLuint>(m_pShaderPrograms->size());
+    m_pShaderPrograms->push_back(pStackProgram);
+    printf("Post processing stack program generated for %d fused effects\n", static_cast<GLint>(effects.size()));
+    return pStackProgram;
+}
+
+/// effects that are one full screen pass over the plain scene target, see RenderPPFXScene
+GLboolean Game::IsPPFXStackable(const PostProcessingEffectMode &mode) {
+    return CPostProcessingGraph::IsStackable(mode);
+}
+
+/// effects whose output texel only depends on the same texel of the input, these can be fused
+GLboolean Game::IsPPFXPointwise(const PostProcessingEffectMode &mode) {
+    return CPostProcessingGraph::GetStackFunction(mode) != nullptr;
+}
+
+/// while the stack holds effects it takes the place of any effect that could be part of it
+GLboolean Game::UsesPPFXStack(const PostProcessingEffectMode &mode) {
+    return !m_ppfxStack.empty() && IsPPFXStackable(mode);
+}
+
+/// the occlusion the temporal ssao tiers accumulate, one target for this frame and one for the frame before
+CFrameBufferObject * Game::GetSSAOHistory(const GLuint &frame) {
+    
+    const GLuint level = SSAOQualityLevel(static_cast<SSAOQuality>(m_ssaoQuality));
+    const GLuint width = std::max(m_gameWindow->GetWidth() >> level, 1);
+    const GLuint height = std::max(m_gameWindow->GetHeight() >> level, 1);
+    return m_ppfxTargets.Acquire(FrameBufferType::SSAO, width, height, PPFX_HISTORY_INDEX + (frame & 1));
+}
+
+/// the framebuffer behind a resource of the current graph, transient targets are created on first use
+CFrameBufferObject * Game::GetPPFXTarget(const GLuint &resource) {
+    
+    const FrameBufferType type = m_ppfxGraph.GetType(resource);
+    if (m_ppfxGraph.IsImported(resource)) return GetSceneFBO(type);
+    
+    // index 0 of every type is the scene target, the slots of the graph come after it
+    const GLuint level = m_ppfxGraph.GetLevel(resource);
+    const GLuint width = std::max(m_gameWindow->GetWidth() >> level, 1);
+    const GLuint height = std::max(m_gameWindow->GetHeight() >> level, 1);
+    return m_ppfxTargets.Acquire(type, width, height, m_ppfxGraph.GetSlot(resource) + 1);
+}
 
+/// the framebuffer the scene is rendered into for an effect
+CFrameBufferObject * Game::GetSceneFBO(const FrameBufferType &type) {
+    return m_ppfxTargets.Acquire(type, m_gameWindow->GetWidth(), m_gameWindow->GetHeight(), 0);
 }
 
-/// render to post processing effect scene
+/// render a single pass effect over the scene target in currentFBO, see BuildPPFXGraph
 void Game::RenderPPFXScene(const PostProcessingEffectMode &mode) {
     
+    // the program the graph declared the pass of the effect with
+    CShaderProgram *pEffectProgram = (*m_pShaderPrograms)[CPostProcessingGraph::GetEffectProgram(mode)];
+    
     switch(mode) {
         case PostProcessingEffectMode::PBR: {
-            currentFBO = m_pFBOs[0];
             currentFBO->BindTexture(static_cast<GLint>(TextureType::DIFFUSE)); // bind to diffuse texture as well
-            CShaderProgram *pImageProcessingProgram = (*m_pShaderPrograms)[15];
+            CShaderProgram *pImageProcessingProgram = pEffectProgram;
             RenderToScreen(pImageProcessingProgram);
             return;
         }
         case PostProcessingEffectMode::IBL: {
-            currentFBO = m_pFBOs[0];
             currentFBO->BindTexture(static_cast<GLint>(TextureType::DIFFUSE)); // bind to diffuse texture as well
-            CShaderProgram *pImageProcessingProgram = (*m_pShaderPrograms)[15];
+            CShaderProgram *pImageProcessingProgram = pEffectProgram;
             RenderToScreen(pImageProcessingProgram);
             return;
         }
         case PostProcessingEffectMode::BlinnPhong: {
-            currentFBO = m_pFBOs[0];
             currentFBO->BindTexture(static_cast<GLint>(TextureType::DIFFUSE)); // bind to diffuse texture as well
-            CShaderProgram *pImageProcessingProgram = (*m_pShaderPrograms)[15];
+            CShaderProgram *pImageProcessingProgram = pEffectProgram;
             RenderToScreen(pImageProcessingProgram);
             return;
         }
         case PostProcessingEffectMode::ColorInversion: {
             
-            CShaderProgram *pColorInversionProgram = (*m_pShaderPrograms)[16];
+            CShaderProgram *pColorInversionProgram = pEffectProgram;
             SetColorInversionUniform(pColorInversionProgram);
             RenderToScreen(pColorInversionProgram);
             return;
         }
         case PostProcessingEffectMode::GrayScale: {
             
-            CShaderProgram *pGrayScaleProgram = (*m_pShaderPrograms)[17];
+            CShaderProgram *pGrayScaleProgram = pEffectProgram;
             SetGrayScaleUniform(pGrayScaleProgram);
             RenderToScreen(pGrayScaleProgram);
             return;
         }
         case PostProcessingEffectMode::Kernel: {
-            CShaderProgram *pKernelProgram = (*m_pShaderPrograms)[18];
+            CShaderProgram *pKernelProgram = pEffectProgram;
             SetKernelUniform(pKernelProgram);
             RenderToScreen(pKernelProgram);
             return;
         }
         case PostProcessingEffectMode::KernelBlur: {
-            CShaderProgram *pKernelBlurProgram = (*m_pShaderPrograms)[19];
+            CShaderProgram *pKernelBlurProgram = pEffectProgram;
             SetKernelBlurUniform(pKernelBlurProgram);
             RenderToScreen(pKernelBlurProgram);
             return;
         }
         case PostProcessingEffectMode::SobelEdgeDetection: {
-            CShaderProgram *pSobelEdgeDetectionProgram = (*m_pShaderPrograms)[21];
+            CShaderProgram *pSobelEdgeDetectionProgram = pEffectProgram;
             SetEdgeDetectionUniform(pSobelEdgeDetectionProgram);
             RenderToScreen(pSobelEdgeDetectionProgram);
             return;
         }
         case PostProcessingEffectMode::FreiChenEdgeDetection: {
-            CShaderProgram *pFreiChenEdgeDetectionProgram = (*m_pShaderPrograms)[22];
+            CShaderProgram *pFreiChenEdgeDetectionProgram = pEffectProgram;
             SetEdgeDetectionUniform(pFreiChenEdgeDetectionProgram);
             RenderToScreen(pFreiChenEdgeDetectionProgram);
             return;
         }
         case PostProcessingEffectMode::ScreenWave: {
-            CShaderProgram *pScreenWaveProgram = (*m_pShaderPrograms)[23];
+            CShaderProgram *pScreenWaveProgram = pEffectProgram;
             SetScreenWaveUniform(pScreenWaveProgram);
             RenderToScreen(pScreenWaveProgram);
             return;
         }
         case PostProcessingEffectMode::Swirl: {
-            CShaderProgram *pSwirlProgram = (*m_pShaderPrograms)[24];
+            CShaderProgram *pSwirlProgram = pEffectProgram;
             SetSwirlUniform(pSwirlProgram);
             RenderToScreen(pSwirlProgram);
             return;
         }
         case PostProcessingEffectMode::NightVision: {
-            CShaderProgram *pNightVisionProgram = (*m_pShaderPrograms)[25];
+            CShaderProgram *pNightVisionProgram = pEffectProgram;
             SetNightVisionUniform(pNightVisionProgram);
             RenderToScreen(pNightVisionProgram);
             return;
         }
         case PostProcessingEffectMode::LensCircle: {
-            CShaderProgram *pLensCircleProgram = (*m_pShaderPrograms)[26];
+            CShaderProgram *pLensCircleProgram = pEffectProgram;
             SetLensCircleUniform(pLensCircleProgram);
             RenderToScreen(pLensCircleProgram);
             return;
         }
         case PostProcessingEffectMode::Posterization: {
-            CShaderProgram *pPosterizationProgram = (*m_pShaderPrograms)[27];
+            CShaderProgram *pPosterizationProgram = pEffectProgram;
             SetPosterizationUniform(pPosterizationProgram);
             RenderToScreen(pPosterizationProgram);
             return;
         }
         case PostProcessingEffectMode::DreamVision: {
-            CShaderProgram *pDreamVisionProgram = (*m_pShaderPrograms)[28];
+            CShaderProgram *pDreamVisionProgram = pEffectProgram;
             SetDreamVisionUniform(pDreamVisionProgram);
             RenderToScreen(pDreamVisionProgram);
             return;
         }
         case PostProcessingEffectMode::Pixelate: {
-            CShaderProgram *pPixelateProgram = (*m_pShaderPrograms)[64];
+            CShaderProgram *pPixelateProgram = pEffectProgram;
             SetPixelateUniform(pPixelateProgram);
             RenderToScreen(pPixelateProgram);
             return;
         }
         case PostProcessingEffectMode::Pixelation: {
-            CShaderProgram *pPixelationProgram = (*m_pShaderPrograms)[29];
+            CShaderProgram *pPixelationProgram = pEffectProgram;
             SetPixelationUniform(pPixelationProgram);
             RenderToScreen(pPixelationProgram);
             return;
         }
         case PostProcessingEffectMode::KnittedPixelation: {
-            CShaderProgram *pKnittedPixelationProgram = (*m_pShaderPrograms)[69];
+            CShaderProgram *pKnittedPixelationProgram = pEffectProgram;
             SetKnittedPixelationUniform(pKnittedPixelationProgram);
             RenderToScreen(pKnittedPixelationProgram);
             return;
         }
         case PostProcessingEffectMode::FrostedGlassPixelationEffect: {
-            CShaderProgram *pFrostedGlassProgram = (*m_pShaderPrograms)[30];
+            CShaderProgram *pFrostedGlassProgram = pEffectProgram;
             SetFrostedGlassEffectUniform(pFrostedGlassProgram);
             RenderToScreen(pFrostedGlassProgram);
             return;
         }
         case PostProcessingEffectMode::FrostedGlassScreenWaveEffect: {
-            CShaderProgram *pFrostedGlassExtraProgram = (*m_pShaderPrograms)[31];
+            CShaderProgram *pFrostedGlassExtraProgram = pEffectProgram;
             SetFrostedGlassUniform(pFrostedGlassExtraProgram);
             RenderToScreen(pFrostedGlassExtraProgram);
             return;
         }
         case PostProcessingEffectMode::Crosshatching: {
-            CShaderProgram *pCrosshatchingProgram = (*m_pShaderPrograms)[32];
+            CShaderProgram *pCrosshatchingProgram = pEffectProgram;
             SetCrosshatchingUniform(pCrosshatchingProgram);
             RenderToScreen(pCrosshatchingProgram);
             return;
         }
         case PostProcessingEffectMode::PredatorsThermalVision: {
-            CShaderProgram *pPredatorsThermalVisionProgram = (*m_pShaderPrograms)[33];
+            CShaderProgram *pPredatorsThermalVisionProgram = pEffectProgram;
             SetPredatorsThermalVisionUniform(pPredatorsThermalVisionProgram);
             RenderToScreen(pPredatorsThermalVisionProgram);
             return;
         }
         case PostProcessingEffectMode::Toonify: {
-            CShaderProgram *pToonifyProgram = (*m_pShaderPrograms)[34];
+            CShaderProgram *pToonifyProgram = pEffectProgram;
             SetToonifyUniform(pToonifyProgram);
             RenderToScreen(pToonifyProgram);
             return;
         }
         case PostProcessingEffectMode::Shockwave: {
-            CShaderProgram *pShockwaveProgram = (*m_pShaderPrograms)[35];
+            CShaderProgram *pShockwaveProgram = pEffectProgram;
             SetShockwaveUniform(pShockwaveProgram);
             RenderToScreen(pShockwaveProgram);
             return;
         }
         case PostProcessingEffectMode::FishEye: {
-            CShaderProgram *pFishEyeProgram = (*m_pShaderPrograms)[36];
+            CShaderProgram *pFishEyeProgram = pEffectProgram;
             SetFishEyeUniform(pFishEyeProgram);
             RenderToScreen(pFishEyeProgram);
             return;
         }
         case PostProcessingEffectMode::BarrelDistortion: {
-            CShaderProgram *pBarrelDistortionProgram = (*m_pShaderPrograms)[37];
+            CShaderProgram *pBarrelDistortionProgram = pEffectProgram;
             SetBarrelDistortionUniform(pBarrelDistortionProgram);
             RenderToScreen(pBarrelDistortionProgram);
             return;
         }
         case PostProcessingEffectMode::MultiScreenFishEye: {
-            CShaderProgram *pMultiScreenFishEyeProgram = (*m_pShaderPrograms)[38];
+            CShaderProgram *pMultiScreenFishEyeProgram = pEffectProgram;
             SetMultiScreenFishEyeUniform(pMultiScreenFishEyeProgram);
             RenderToScreen(pMultiScreenFishEyeProgram);
             return;
         }
         case PostProcessingEffectMode::FishEyeLens: {
-            CShaderProgram *pFishEyeLensProgram = (*m_pShaderPrograms)[39];
+            CShaderProgram *pFishEyeLensProgram = pEffectProgram;
             SetFishEyeLensUniform(pFishEyeLensProgram);
             RenderToScreen(pFishEyeLensProgram);
             return;
         }
         case PostProcessingEffectMode::FishEyeAntiFishEye: {
-            CShaderProgram *pFishEyeAntiFishEyeProgram = (*m_pShaderPrograms)[40];
+            CShaderProgram *pFishEyeAntiFishEyeProgram = pEffectProgram;
             SetFishEyeAntiFishEyeUniform(pFishEyeAntiFishEyeProgram);
             RenderToScreen(pFishEyeAntiFishEyeProgram);
             return;
         }
-        case PostProcessingEffectMode::GaussianBlur: {
-            CShaderProgram *pGaussianBlurProgram = (*m_pShaderPrograms)[41];
-            pGaussianBlurProgram->UseProgram();
-            bool horizontal = true; // 0 is false aand 1 is true
-            
-            // Second Pass - BLUR in many iterations
-            {
-                bool first_iteration = true;
-                int amount = 9; // number of times we blur
-                for (GLuint i = 0; i < amount; i++)
-                {
-                    currentFBO = m_pFBOs[2];
-                    currentFBO->BindPingPong(horizontal, true); // prepare ping pong frame buffer
-                    
-                    SetGaussianBlurUniform(pGaussianBlurProgram, horizontal);
-                    
-                    // blur textures that are in the depthMap texture unit
-                    if (first_iteration) {
-                        currentFBO = m_pFBOs[9];
-                        RenderToScreen(pGaussianBlurProgram, FrameBufferType::HighDynamicRangeRendering, 0, TextureType::DEPTH);
-                    } else {
-                        currentFBO = m_pFBOs[2];
-                        RenderToScreen(pGaussianBlurProgram, FrameBufferType::PingPongRendering, !horizontal, TextureType::DEPTH);
-                    }
-                    
-                    horizontal = !horizontal;
-                    if (first_iteration) first_iteration = false;
-                }
-            }
-            ResetFrameBuffer();
-            
-            // Third Pass - Final Blur to screen
-            {
-                currentFBO = m_pFBOs[9];
-                currentFBO->BindHDRTexture(0, static_cast<GLint>(TextureType::AMBIENT)); // bind the earlier (scene rendering) rendering from the hrd frame buffer
-                
-                // taking the blured texture and showing it after setviewport
-                currentFBO = m_pFBOs[2];
-                SetGaussianBlurUniform(pGaussianBlurProgram, horizontal);
-                RenderToScreen(pGaussianBlurProgram, FrameBufferType::PingPongRendering, horizontal, TextureType::DEPTH);
-            }
-            return;
-        }
         case PostProcessingEffectMode::Blur: {
-            CShaderProgram *pBlurProgram = (*m_pShaderPrograms)[42];
+            CShaderProgram *pBlurProgram = pEffectProgram;
             SetBlurUniform(pBlurProgram);
             RenderToScreen(pBlurProgram);
             return;
         }
         case PostProcessingEffectMode::RadialBlur: {
-            CShaderProgram *pRadialBlurProgram = (*m_pShaderPrograms)[43];
+            CShaderProgram *pRadialBlurProgram = pEffectProgram;
             SetRadialBlurUniform(pRadialBlurProgram);
             RenderToScreen(pRadialBlurProgram);
             return;
         }
-        case PostProcessingEffectMode::MotionBlur: {
-            // Second Pass - Render Scene as usual
-            {
-                currentFBO = m_pFBOs[3];
-                currentFBO->Bind(true); // prepare depth frame buffer (3)
-                RenderScene(true, 51);
-            }
-            
-            ResetFrameBuffer();
-            
-            // Third Pass - Motion Blur
-            {
-                CShaderProgram *pMotionBlurProgram = (*m_pShaderPrograms)[44];
-                SetMotionBlurUniform(pMotionBlurProgram);
-                SetCameraUniform(pMotionBlurProgram, "camera", m_pCamera);
-                
-                // bind depth texture
-                currentFBO = m_pFBOs[3];
-                currentFBO->BindDepthTexture(static_cast<GLint>(TextureType::DEPTH));
-                
-                currentFBO = m_pFBOs[0];
-                RenderToScreen(pMotionBlurProgram, FrameBufferType::Default, 0, TextureType::AMBIENT);
-            }
-            return;
-        }
         case PostProcessingEffectMode::Vignetting: {
-            CShaderProgram *pVignettingProgram = (*m_pShaderPrograms)[45];
+            CShaderProgram *pVignettingProgram = pEffectProgram;
             SetVignettingUniform(pVignettingProgram);
             RenderToScreen(pVignettingProgram);
             return;
         }
         case PostProcessingEffectMode::BrightParts: {
-            CShaderProgram *pBrightPartsProgram = (*m_pShaderPrograms)[46];
+            CShaderProgram *pBrightPartsProgram = pEffectProgram;
             SetBrightPartsUniform(pBrightPartsProgram);
             
-            currentFBO = m_pFBOs[9];
             currentFBO->BindHDRTexture(0, static_cast<GLint>(TextureType::AMBIENT)); // bind the earlier (scene rendering) rendering from the hrd frame buff
             RenderToScreen(pBrightPartsProgram, FrameBufferType::HighDynamicRangeRendering, 1, TextureType::DEPTH);
             return;
         }
-        case PostProcessingEffectMode::Bloom: {
-            
-            bool horizontal = true; // 0 is false aand 1 is true
-            // Second Pass - BLUR Bright Parts
-            {
-                CShaderProgram *pGaussianBlurProgram = (*m_pShaderPrograms)[41];
-                pGaussianBlurProgram->UseProgram();
-                
-                bool first_iteration = true;
-                int amount = 10; // number of times we blur
-                for (GLuint i = 0; i < amount; i++)
-                {
-                    currentFBO = m_pFBOs[2];
-                    currentFBO->BindPingPong(horizontal, true); // prepare ping pong frame buffer
-                    
-                    SetGaussianBlurUniform(pGaussianBlurProgram, horizontal);
-                    
-                    // blur textures that are in the depthMap texture unit
-                    if (first_iteration) {
-                        currentFBO = m_pFBOs[9];
-                        RenderToScreen(pGaussianBlurProgram, FrameBufferType::HighDynamicRangeRendering, 1, TextureType::DEPTH); // providing the bright parts textures at the first iteration
-                    } else {
-                        currentFBO = m_pFBOs[2];
-                        RenderToScreen(pGaussianBlurProgram, FrameBufferType::PingPongRendering, !horizontal, TextureType::DEPTH);
-                    }
-                    horizontal = !horizontal;
-                    if (first_iteration) first_iteration = false;
-                }
-            }
-            
-            ResetFrameBuffer();
-            
-            // Third Pass - BLOOM
-            {
-                CShaderProgram *pBloomProgram = (*m_pShaderPrograms)[47];
-                SetBloomUniform(pBloomProgram);
-                
-                currentFBO = m_pFBOs[9];
-                currentFBO->BindHDRTexture(0, static_cast<GLint>(TextureType::AMBIENT)); // bind the earlier (scene rendering) rendering from the hrd frame buffer
-                
-                currentFBO = m_pFBOs[2];
-                RenderToScreen(pBloomProgram, FrameBufferType::PingPongRendering, !horizontal, TextureType::DEPTH);
-            }
-            return;
-        }
         case PostProcessingEffectMode::HDRToneMapping: {
-            CShaderProgram *pHDRToneMappingProgram = (*m_pShaderPrograms)[52];
+            CShaderProgram *pHDRToneMappingProgram = pEffectProgram;
             SetHRDToneMappingUniform(pHDRToneMappingProgram);
             
-            currentFBO = m_pFBOs[10];
             RenderToScreen(pHDRToneMappingProgram, FrameBufferType::HighDynamicRangeLighting, 0, TextureType::AMBIENT);
             return;
         }
-        case PostProcessingEffectMode::LensFlare: {
-            /*
-             The screen space technique comprises the following 4 steps:
-             
-             1. Downsample the scene image.     // Bright parts
-             2. Blur.                           // Blur image
-             3. Generate lens flare features.   // Lens flare
-             4. Upsample/composite.             // Bring all together
-             
-             There are a couple of important considerations to make regarding the overall rendering pipeline:
-             
-             - Any post process motion blur or depth of field effect must be applied prior to combining the lens flare, so that the lens flare features don't participate in those effects. Technically the lens flare features would exhibit some motion blur, however it's incompatible with post process motion techniques. As a compromise, you could implement the lens flare using an accumulation buffer.
-             - The lens flare should be applied before any tonemapping operation. This makes physical sense, as tonemapping simulates the reaction of the film/CMOS to the incoming light, of which the lens flare is a constituent part
-             */
-            bool horizontal = true; // 0 is false aand 1 is true
-            // Second Pass - BLUR Bright Parts
-            {
-                CShaderProgram *pGaussianBlurProgram = (*m_pShaderPrograms)[41];
-                pGaussianBlurProgram->UseProgram();
-                
-                bool first_iteration = true;
-                int amount = 10; // number of times we blur
-                for (GLuint i = 0; i < amount; i++)
-                {
-                    currentFBO = m_pFBOs[2];
-                    currentFBO->BindPingPong(horizontal, true); // prepare ping pong frame buffer
-                    
-                    SetGaussianBlurUniform(pGaussianBlurProgram, horizontal);
-                    
-                    // blur textures that are in the depthMap texture unit
-                    if (first_iteration) {
-                        currentFBO = m_pFBOs[9];
-                        RenderToScreen(pGaussianBlurProgram, FrameBufferType::HighDynamicRangeRendering, 1, TextureType::DEPTH); // providing the bright parts textures at the first iteration
-                    } else {
-                        currentFBO = m_pFBOs[2];
-                        RenderToScreen(pGaussianBlurProgram, FrameBufferType::PingPongRendering, !horizontal, TextureType::DEPTH);
-                    }
-                    horizontal = !horizontal;
-                    if (first_iteration) first_iteration = false;
-                }
-            }
-            
-            ResetFrameBuffer();
-            
-            // Third Pass - Flare Ghost
-            {
-                currentFBO = m_pFBOs[4];
-                currentFBO->Bind(true); // prepare default frame buffer (5)
-                
-                CShaderProgram *pLensFlareGhostProgram = (*m_pShaderPrograms)[48];
-                SetLensFlareGhostUniform(pLensFlareGhostProgram);
-                
-                currentFBO = m_pFBOs[2];
-                RenderToScreen(pLensFlareGhostProgram, FrameBufferType::PingPongRendering, !horizontal, TextureType::DEPTH);
-            }
-            
-            ResetFrameBuffer();
-            
-            // Forth Pass - Lens Flare Composition
-            {
-                CShaderProgram *pLensFlareProgram = (*m_pShaderPrograms)[49];
-                SetLensFlareUniform(pLensFlareProgram);
-                
-                currentFBO = m_pFBOs[4];
-                currentFBO->BindTexture(static_cast<GLint>(TextureType::LENS));
-                
-                currentFBO = m_pFBOs[9];
-                RenderToScreen(pLensFlareProgram, FrameBufferType::HighDynamicRangeRendering, 0, TextureType::AMBIENT);
-            }
-            return;
-        }
-        case PostProcessingEffectMode::SSAO: {
-            /*
-             In reality, light scatters in all kinds of directions with varying intensities so the indirectly lit parts of a scene should also have varying intensities, instead of a constant ambient component. One type of indirect lighting approximation is called ambient occlusion that tries to approximate indirect lighting by darkening creases, holes and surfaces that are close to each other. These areas are largely occluded by surrounding geometry and thus light rays have less places to escape, hence the areas appear darker.
-             */
-            // Second Pass - Screen Space Ambient Occlusion
-            {
-                
-                currentFBO = m_pFBOs[5];
-                currentFBO->Bind(true);     // prepare frame buffer 5
-                m_gameWindow->ClearBuffers(ClearBuffersType::COLORSTENCIL);
-                
-                CShaderProgram *pScreenSpaceAmbientOcclusionProgram = (*m_pShaderPrograms)[56];
-                SetScreenSpaceAmbientOcclusionUniform(pScreenSpaceAmbientOcclusionProgram);
-
-                // Bind Textures
-                currentFBO = m_pFBOs[11];
-                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::DISPLACEMENT));
-                currentFBO->BindNormalTexture(static_cast<GLint>(TextureType::NORMAL));
-                RenderToScreen(pScreenSpaceAmbientOcclusionProgram, FrameBufferType::GeometryBuffer, 0, TextureType::AMBIENT, true);
-                
-            }
-            
-            ResetFrameBuffer();
-            
-            // Third Pass - Screen Space Ambient Occlusion Blur
-            {
-                currentFBO = m_pFBOs[6];
-                currentFBO->Bind(true);     // prepare frame buffer 5
-                m_gameWindow->ClearBuffers(ClearBuffersType::COLORSTENCIL);
-                
-                CShaderProgram *pScreenSpaceAmbientOcclusionBlurProgram= (*m_pShaderPrograms)[57];
-                SetScreenSpaceAmbientOcclusionBlurUniform(pScreenSpaceAmbientOcclusionBlurProgram);
-                
-                currentFBO = m_pFBOs[5];
-                RenderToScreen(pScreenSpaceAmbientOcclusionBlurProgram, FrameBufferType::SSAO, 0, TextureType::AO);
-            }
-            
-            ResetFrameBuffer();
-            
-            // Fourth Pass - Screen Space Ambient Occlusion Lighting
-            {
-                CShaderProgram *pScreenSpaceAmbientOcclusionLightingProgram= (*m_pShaderPrograms)[58];
-                SetScreenSpaceAmbientOcclusionLightingUniform(pScreenSpaceAmbientOcclusionLightingProgram);
-                
-                // Render Lighting Scene
-                SetCameraUniform(pScreenSpaceAmbientOcclusionLightingProgram, "camera", m_pCamera);
-                SetLightUniform(pScreenSpaceAmbientOcclusionLightingProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-                SetMaterialUniform(pScreenSpaceAmbientOcclusionLightingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, true);
-                SetFogMaterialUniform(pScreenSpaceAmbientOcclusionLightingProgram, "fog", m_fogColor, m_useFog);
-                SetHRDLightUniform(pScreenSpaceAmbientOcclusionLightingProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-                RenderLight(pScreenSpaceAmbientOcclusionLightingProgram, m_dirName, m_pointName, m_spotName, m_pCamera);
-                
-                currentFBO = m_pFBOs[6];
-                currentFBO->BindTexture(static_cast<GLint>(TextureType::AO));
-                
-                currentFBO = m_pFBOs[11];
-                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::DISPLACEMENT));
-                currentFBO->BindNormalTexture(static_cast<GLint>(TextureType::NORMAL));
-                currentFBO->BindAlbedoTexture(static_cast<GLint>(TextureType::DIFFUSE));
-                RenderToScreen(pScreenSpaceAmbientOcclusionLightingProgram, FrameBufferType::GeometryBuffer, 0, TextureType::AMBIENT, true);
-            }
-        
-            return;
-        }
         case PostProcessingEffectMode::FXAA: {
-            CShaderProgram *pFastApproximateAntiAliasingProgram = (*m_pShaderPrograms)[53];
+            CShaderProgram *pFastApproximateAntiAliasingProgram = pEffectProgram;
             SetFastApproximateAntiAliasingUniform(pFastApproximateAntiAliasingProgram);
             RenderToScreen(pFastApproximateAntiAliasingProgram);
             return;
         }
-        case PostProcessingEffectMode::DepthTesting: {
-            
-            // Second Pass
-            {
-                currentFBO = m_pFBOs[4];
-                currentFBO->Bind(true); // prepare another framebuffer
-                
-                m_gameWindow->ClearBuffers(ClearBuffersType::COLORDEPTHSTENCIL);
-                RenderScene(true, true, 83);
-            }
-            
-            ResetFrameBuffer();
-           
-            // Third Pass - Render to quad
-            {
-                // bind depth texture
-                currentFBO = m_pFBOs[4];
-                currentFBO->BindTexture(static_cast<GLint>(TextureType::DIFFUSE)); // bind to diffuse texture
-                
-                currentFBO = m_pFBOs[0]; // scene texture
-                CShaderProgram *pImageProcessingProgram = (*m_pShaderPrograms)[15];
-                RenderToScreen(pImageProcessingProgram, FrameBufferType::Default, 0, TextureType::AMBIENT);
-            }
-            
-            return;
-        }
-        case PostProcessingEffectMode::DepthMapping: {
-            
-            // Second Pass - Render Scene to light space
-            {
-                currentFBO = m_pFBOs[3];
-                currentFBO->Bind(false); // prepare depth frame buffer (3)
-                m_gameWindow->SetViewport(SHADOW_WIDTH, SHADOW_HEIGHT);
-                m_gameWindow->ClearBuffers(ClearBuffersType::DEPTH);
-                
-                
-                CShaderProgram *pLightSpaceProgram = (*m_pShaderPrograms)[51];
-                RenderLight(pLightSpaceProgram, m_dirName, m_pointName, m_spotName, m_pCamera, true);
-                RenderScene(true, false, 51);
-            }
-            
-            ResetFrameBuffer();
-            
-            // Third Pass - DepthMapping
-            {
-                CShaderProgram *pDepthMappingProgram = (*m_pShaderPrograms)[50];
-                SetCameraUniform(pDepthMappingProgram, "camera", m_pCamera);
-                SetShadowUniform(pDepthMappingProgram, "shadow", m_dirShadowBias);
-                SetMaterialUniform(pDepthMappingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
-                SetDepthMappingUniform(pDepthMappingProgram);
-                
-                // bind depth texture
-                currentFBO = m_pFBOs[3];
-                currentFBO->BindDepthTexture(static_cast<GLint>(TextureType::DEPTH));
-                
-                currentFBO = m_pFBOs[0]; // scene texture
-                RenderToScreen(pDepthMappingProgram, FrameBufferType::Default, 0, TextureType::AMBIENT);
-            }
-            return;
-        }
-        case PostProcessingEffectMode::DirectionalShadowMapping: {
-           
-            // Second Pass - Render Scene to light space
-            {
-                currentFBO = m_pFBOs[7];
-                currentFBO->Bind(false); // prepare depth frame buffer (7)
-                m_gameWindow->SetViewport(SHADOW_WIDTH, SHADOW_HEIGHT);
-                m_gameWindow->ClearBuffers(ClearBuffersType::DEPTH);
-                
-                CShaderProgram *pLightSpaceProgram = (*m_pShaderPrograms)[51];
-                RenderLight(pLightSpaceProgram, m_dirName, m_pointName, m_spotName, m_pCamera, true);
-                
-                RenderScene(true, false, 51);
-            }
-            
-            ResetFrameBuffer();
-            
-            // Shadow Mapping
-            {
-                m_gameWindow->SetViewport();
-                m_gameWindow->ClearBuffers(ClearBuffersType::COLORDEPTHSTENCIL);
-                
-                // render next scene to framebuffer
-                currentFBO = m_pFBOs[4];
-                currentFBO->Bind(true);
-                
-                // bind depth texture
-                currentFBO = m_pFBOs[7]; // depth mapping texture
-                currentFBO->BindDepthTexture(static_cast<GLint>(TextureType::DEPTH));
-                
-                // use depth mapping quad
-                CShaderProgram *pDirectionalShadowMappingProgram = (*m_pShaderPrograms)[84];
-                SetCameraUniform(pDirectionalShadowMappingProgram, "camera", m_pCamera);
-                SetMaterialUniform(pDirectionalShadowMappingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
-                SetFogMaterialUniform(pDirectionalShadowMappingProgram, "fog", m_fogColor, m_useFog);
-                SetShadowUniform(pDirectionalShadowMappingProgram, "shadow", m_dirShadowBias);
-                SetLightUniform(pDirectionalShadowMappingProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-                SetHRDLightUniform(pDirectionalShadowMappingProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-                RenderLight(pDirectionalShadowMappingProgram, m_dirName, m_pointName, m_spotName, m_pCamera, true);
-                
-                RenderScene(true, false, 84);
-            }
-            
-            ResetFrameBuffer();
-            
-            // Third Pass - Render to quad
-            {
-                // bind depth texture
-                currentFBO = m_pFBOs[4];
-                currentFBO->BindTexture(static_cast<GLint>(TextureType::DIFFUSE)); // bind to diffuse texture
-                
-                currentFBO = m_pFBOs[0]; // scene texture
-                CShaderProgram *pImageProcessingProgram = (*m_pShaderPrograms)[15];
-                RenderToScreen(pImageProcessingProgram, FrameBufferType::Default, 0, TextureType::AMBIENT);
-            }
-            return;
-        }
-        case PostProcessingEffectMode::OmnidirectionalShadowMapping: {
-            GLfloat near_plane = (GLfloat)SHADOW_ZNEAR; // how short the light ray goes
-            GLfloat far_plane = (GLfloat)SHADOW_ZFAR; //how far the light ray goes
-            
-            // Second Pass - Render Scene to light space
-            {
-                
-                // configure global opengl state
-                // -----------------------------
-                m_gameWindow->ClearBuffers(ClearBuffersType::COLORDEPTHSTENCIL);
-                
-
-                // 1. render scene to depth cubemap
-                // --------------------------------
-                currentFBO = m_pFBOs[8];
-                currentFBO->Bind(false); // prepare depth frame buffer (7)
-                m_gameWindow->SetViewport(SHADOW_WIDTH, SHADOW_HEIGHT);
-                m_gameWindow->ClearBuffers(ClearBuffersType::DEPTH);
-                
-                CShaderProgram *pLightSpaceProgram = (*m_pShaderPrograms)[85];
-                pLightSpaceProgram->UseProgram();
-
-                SetMaterialUniform(pLightSpaceProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
-                SetShadowUniform(pLightSpaceProgram, "shadow", m_orthShadowBias);
-                SetLightUniform(pLightSpaceProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-                RenderLight(pLightSpaceProgram, m_dirName, m_pointName, m_spotName, m_pCamera, true);
-                
-                RenderScene(true, false, 85);
-               
-            }
-            
-            ResetFrameBuffer();
-            
-            // Shadow Mapping
-            {
-                
-                // render next scene to framebuffer
-                currentFBO = m_pFBOs[4];
-                currentFBO->Bind(true);
-                
-                // bind depth texture
-                currentFBO = m_pFBOs[8]; // depth mapping texture
-                currentFBO->BindDepthCubeMap(static_cast<GLint>(TextureType::SHADOWMAP));
-                
-                // 2. render scene as normal
-                // -------------------------
-                CShaderProgram *pOmnidirectionalShadowMappingProgram = (*m_pShaderPrograms)[86];
-                SetCameraUniform(pOmnidirectionalShadowMappingProgram, "camera", m_pCamera);
-                SetMaterialUniform(pOmnidirectionalShadowMappingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
-                SetFogMaterialUniform(pOmnidirectionalShadowMappingProgram, "fog", m_fogColor, m_useFog);
-                SetShadowUniform(pOmnidirectionalShadowMappingProgram, "shadow", m_orthShadowBias);
-                SetLightUniform(pOmnidirectionalShadowMappingProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-                SetHRDLightUniform(pOmnidirectionalShadowMappingProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-                RenderLight(pOmnidirectionalShadowMappingProgram, m_dirName, m_pointName, m_spotName, m_pCamera, false);
-                
-                RenderScene(true, false, 86);
-            }
-            
-            ResetFrameBuffer();
-            
-            // Third Pass - Render to quad
-            {
-                // bind depth texture
-                currentFBO = m_pFBOs[4];
-                currentFBO->BindTexture(static_cast<GLint>(TextureType::DIFFUSE)); // bind to diffuse texture
-                
-                currentFBO = m_pFBOs[0]; // scene texture
-                CShaderProgram *pImageProcessingProgram = (*m_pShaderPrograms)[15];
-                RenderToScreen(pImageProcessingProgram, FrameBufferType::Default, 0, TextureType::AMBIENT);
-            }
-            return;
-        }
-        case PostProcessingEffectMode::DeferredRendering: {
-            // Second Pass - Deferred Rendering
-            {
-                CShaderProgram *pDeferredRenderingProgram= (*m_pShaderPrograms)[55];
-                SetMaterialUniform(pDeferredRenderingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, false);
-                SetDeferredRenderingUniform(pDeferredRenderingProgram);
-                
-                // Render Lighting Scene
-                SetCameraUniform(pDeferredRenderingProgram, "camera", m_pCamera);
-                SetLightUniform(pDeferredRenderingProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-                SetHRDLightUniform(pDeferredRenderingProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-                RenderLight(pDeferredRenderingProgram, m_dirName, m_pointName, m_spotName, m_pCamera);
-                
-                // Bind Textures
-                currentFBO = m_pFBOs[1];
-                currentFBO->BindPositionTexture(static_cast<GLint>(TextureType::DISPLACEMENT));
-                currentFBO->BindNormalTexture(static_cast<GLint>(TextureType::NORMAL));
-                currentFBO->BindAlbedoTexture(static_cast<GLint>(TextureType::DIFFUSE));
-                
-                RenderToScreen(pDeferredRenderingProgram, FrameBufferType::DeferredRendering, 0, TextureType::AMBIENT);
-                
-            }
-            
-            // Blit to default frame buffer
-            currentFBO->BlitToDepthBuffer(0);
-            
-            {
-                /// Render Lamps
-                CShaderProgram *pLampProgram = (*m_pShaderPrograms)[4];
-                for (auto it = m_pointLights.begin(); it != m_pointLights.end(); ++it) {
-                    glm::vec3 position = std::get<0>(*it);
-                    glm::vec4 color = std::get<1>(*it);
-                    SetMaterialUniform(pLampProgram, "material", color);
-                    RenderLamp(pLampProgram, position, glm::vec3(10.0f));
-                }
-            }
-            
-            return;
-        }
         case PostProcessingEffectMode::RainDrops: {
-            CShaderProgram *pRainDropsProgram = (*m_pShaderPrograms)[59];
+            CShaderProgram *pRainDropsProgram = pEffectProgram;
             SetRainDropsUniform(pRainDropsProgram);
             RenderToScreen(pRainDropsProgram);
             return;
         }
         case PostProcessingEffectMode::PaletteQuantizationAndDithering: {
-            CShaderProgram *pPaletteQuantizationAndDitheringProgram = (*m_pShaderPrograms)[61];
+            CShaderProgram *pPaletteQuantizationAndDitheringProgram = pEffectProgram;
             SetPaletteQuantizationAndDitheringUniform(pPaletteQuantizationAndDitheringProgram);
             RenderToScreen(pPaletteQuantizationAndDitheringProgram);
             return;
         }
         case PostProcessingEffectMode::DistortedTV: {
-            CShaderProgram *pDistortedTVProgram = (*m_pShaderPrograms)[62];
+            CShaderProgram *pDistortedTVProgram = pEffectProgram;
             SetDistortedTVUniform(pDistortedTVProgram);
             RenderToScreen(pDistortedTVProgram);
             return;
         }
         case PostProcessingEffectMode::RGBDisplay: {
-            CShaderProgram *pRGBDisplayProgram = (*m_pShaderPrograms)[63];
+            CShaderProgram *pRGBDisplayProgram = pEffectProgram;
             SetRGBDisplayUniform(pRGBDisplayProgram);
             RenderToScreen(pRGBDisplayProgram);
             return;
         }
         case PostProcessingEffectMode::RetroParallax: {
-            CShaderProgram *pScaryRetroParallaxProgram = (*m_pShaderPrograms)[66];
+            CShaderProgram *pScaryRetroParallaxProgram = pEffectProgram;
             SetScaryRetroParallaxUniform(pScaryRetroParallaxProgram);
             RenderToScreen(pScaryRetroParallaxProgram);
             return;
         }
         case PostProcessingEffectMode::MoneyFilter: {
-            CShaderProgram *pMoneyFilterProgram = (*m_pShaderPrograms)[67];
+            CShaderProgram *pMoneyFilterProgram = pEffectProgram;
             SetMoneyFilterUniform(pMoneyFilterProgram);
             RenderToScreen(pMoneyFilterProgram);
             return;
         }
         case PostProcessingEffectMode::MicroprismMosaic: {
-            CShaderProgram *pMicroprismMosaicProgram = (*m_pShaderPrograms)[68];
+            CShaderProgram *pMicroprismMosaicProgram = pEffectProgram;
             SetMicroprismMosaicUniform(pMicroprismMosaicProgram);
             RenderToScreen(pMicroprismMosaicProgram);
             return;
         }
         case PostProcessingEffectMode::BayerMatrixDithering: {
-            CShaderProgram *pBayerMatrixDitheringProgram = (*m_pShaderPrograms)[70];
+            CShaderProgram *pBayerMatrixDitheringProgram = pEffectProgram;
             SetBayerMatrixDitheringUniform(pBayerMatrixDitheringProgram);
             RenderToScreen(pBayerMatrixDitheringProgram);
             return;
         }
         case PostProcessingEffectMode::JuliaFreak: {
-            CShaderProgram *pJuliaFreakProgram = (*m_pShaderPrograms)[71];
+            CShaderProgram *pJuliaFreakProgram = pEffectProgram;
             SetJuliaFreakUniform(pJuliaFreakProgram);
             RenderToScreen(pJuliaFreakProgram);
             return;
         }
         case PostProcessingEffectMode::HeartBlend: {
-            CShaderProgram *pHeartBlendProgram = (*m_pShaderPrograms)[72];
+            CShaderProgram *pHeartBlendProgram = pEffectProgram;
             SetHeartBlendUniform(pHeartBlendProgram);
             RenderToScreen(pHeartBlendProgram);
             return;
         }
         case PostProcessingEffectMode::EMInterference: {
-            CShaderProgram *pEMInterferencedProgram = (*m_pShaderPrograms)[73];
+            CShaderProgram *pEMInterferencedProgram = pEffectProgram;
             SetEMInterferenceUniform(pEMInterferencedProgram);
             RenderToScreen(pEMInterferencedProgram);
             return;
         }
         case PostProcessingEffectMode::CubicLensDistortion: {
-            CShaderProgram *pCubicLensDistortionProgram = (*m_pShaderPrograms)[74];
+            CShaderProgram *pCubicLensDistortionProgram = pEffectProgram;
             SetCubicLensDistortionUniform(pCubicLensDistortionProgram);
             RenderToScreen(pCubicLensDistortionProgram);
             return;
         }
         case PostProcessingEffectMode::CelShaderish: {
-            CShaderProgram *pCelShaderishProgram = (*m_pShaderPrograms)[75];
+            CShaderProgram *pCelShaderishProgram = pEffectProgram;
             SetCelShaderishUniform(pCelShaderishProgram);
             RenderToScreen(pCelShaderishProgram);
             return;
         }
         case PostProcessingEffectMode::CartoonVideo: {
-            CShaderProgram *pCartoonVideoProgram = (*m_pShaderPrograms)[76];
+            CShaderProgram *pCartoonVideoProgram = pEffectProgram;
             SetCartoonVideoUniform(pCartoonVideoProgram);
             RenderToScreen(pCartoonVideoProgram);
             return;
@@ -1050,7 +1164,7 @@ void Game::ResetFrameBuffer(const GLboolean &clearBuffers) {
     // Unbind to render to our default framebuffer or switching back to the default buffer at 0.
     // To make sure all rendering operations will have a visual impact on the main window we need to make the default framebuffer active again by binding to 0:
     // essentially, we just bind back to default framebuffer and draw a quad plane with the attached framebuffer color texture
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
     
     m_gameWindow->SetViewport();
     
@@ -1058,7 +1172,7 @@ void Game::ResetFrameBuffer(const GLboolean &clearBuffers) {
     if (clearBuffers) m_gameWindow->ClearBuffers(ClearBuffersType::COLORDEPTHSTENCIL);
     
     // disable depth test so screen-space quad isn't discarded due to depth test.
-    glDisable(GL_DEPTH_TEST);
+    CGLState::Instance().Disable(GL_DEPTH_TEST);
 
 }
 
@@ -1067,336 +1181,65 @@ void Game::RenderPPFX(const PostProcessingEffectMode &mode)
 {
     //  Post Processing Effects
     // render the result on the default frame buffer using a full screen quad with post proccessing effects
-    switch(mode) {
-        case PostProcessingEffectMode::PBR:
-            RenderPPFXScene(PostProcessingEffectMode::PBR);
-            break;
-        case PostProcessingEffectMode::IBL:
-            RenderPPFXScene(PostProcessingEffectMode::IBL);
-            break;
-        case PostProcessingEffectMode::BlinnPhong:
-            RenderPPFXScene(PostProcessingEffectMode::BlinnPhong);
-            break;
-        case PostProcessingEffectMode::ColorInversion:
-            RenderPPFXScene(PostProcessingEffectMode::ColorInversion);
-            break;
-        case PostProcessingEffectMode::GrayScale:
-            RenderPPFXScene(PostProcessingEffectMode::GrayScale);
-            break;
-        case PostProcessingEffectMode::Kernel:
-            RenderPPFXScene(PostProcessingEffectMode::Kernel);
-            break;
-        case PostProcessingEffectMode::KernelBlur:
-            RenderPPFXScene(PostProcessingEffectMode::KernelBlur);
-            break;
-        case PostProcessingEffectMode::SobelEdgeDetection:
-            RenderPPFXScene(PostProcessingEffectMode::SobelEdgeDetection);
-            break;
-        case PostProcessingEffectMode::FreiChenEdgeDetection:
-            RenderPPFXScene(PostProcessingEffectMode::FreiChenEdgeDetection);
-            break;
-        case PostProcessingEffectMode::ScreenWave:
-            RenderPPFXScene(PostProcessingEffectMode::ScreenWave);
-            break;
-        case PostProcessingEffectMode::Swirl:
-            RenderPPFXScene(PostProcessingEffectMode::Swirl);
-            break;
-        case PostProcessingEffectMode::NightVision:
-            RenderPPFXScene(PostProcessingEffectMode::NightVision);
-            break;
-        case PostProcessingEffectMode::LensCircle:
-            RenderPPFXScene(PostProcessingEffectMode::LensCircle);
-            break;
-        case PostProcessingEffectMode::Posterization:
-            RenderPPFXScene(PostProcessingEffectMode::Posterization);
-            break;
-        case PostProcessingEffectMode::DreamVision:
-            RenderPPFXScene(PostProcessingEffectMode::DreamVision);
-            break;
-        case PostProcessingEffectMode::Pixelate:
-            RenderPPFXScene(PostProcessingEffectMode::Pixelate);
-            break;
-        case PostProcessingEffectMode::Pixelation:
-            RenderPPFXScene(PostProcessingEffectMode::Pixelation);
-            break;
-        case PostProcessingEffectMode::KnittedPixelation:
-            RenderPPFXScene(PostProcessingEffectMode::KnittedPixelation);
-            break;
-        case PostProcessingEffectMode::FrostedGlassPixelationEffect:
-            RenderPPFXScene(PostProcessingEffectMode::FrostedGlassPixelationEffect);
-            break;
-        case PostProcessingEffectMode::FrostedGlassScreenWaveEffect:
-            RenderPPFXScene(PostProcessingEffectMode::FrostedGlassScreenWaveEffect);
-            break;
-        case PostProcessingEffectMode::Crosshatching:
-            RenderPPFXScene(PostProcessingEffectMode::Crosshatching);
-            break;
-        case PostProcessingEffectMode::PredatorsThermalVision:
-            RenderPPFXScene(PostProcessingEffectMode::PredatorsThermalVision);
-            break;
-        case PostProcessingEffectMode::Toonify:
-            RenderPPFXScene(PostProcessingEffectMode::Toonify);
-            break;
-        case PostProcessingEffectMode::Shockwave:
-            RenderPPFXScene(PostProcessingEffectMode::Shockwave);
-            break;
-        case PostProcessingEffectMode::FishEye:
-            RenderPPFXScene(PostProcessingEffectMode::FishEye);
-            break;
-        case PostProcessingEffectMode::BarrelDistortion:
-            RenderPPFXScene(PostProcessingEffectMode::BarrelDistortion);
-            break;
-        case PostProcessingEffectMode::MultiScreenFishEye:
-            RenderPPFXScene(PostProcessingEffectMode::MultiScreenFishEye);
-            break;
-        case PostProcessingEffectMode::FishEyeLens:
-            RenderPPFXScene(PostProcessingEffectMode::FishEyeLens);
-            break;
-        case PostProcessingEffectMode::FishEyeAntiFishEye:
-            RenderPPFXScene(PostProcessingEffectMode::FishEyeAntiFishEye);
-            break;
-        case PostProcessingEffectMode::GaussianBlur:
-            RenderPPFXScene(PostProcessingEffectMode::GaussianBlur);
-            break;
-        case PostProcessingEffectMode::Blur:
-            RenderPPFXScene(PostProcessingEffectMode::Blur);
-            break;
-        case PostProcessingEffectMode::RadialBlur:
-            RenderPPFXScene(PostProcessingEffectMode::RadialBlur);
-            break;
-        case PostProcessingEffectMode::MotionBlur:
-            RenderPPFXScene(PostProcessingEffectMode::MotionBlur);
-            break;
-        case PostProcessingEffectMode::Vignetting:
-            RenderPPFXScene(PostProcessingEffectMode::Vignetting);
-            break;
-        case PostProcessingEffectMode::BrightParts:
-            RenderPPFXScene(PostProcessingEffectMode::BrightParts);
-            break;
-        case PostProcessingEffectMode::Bloom:
-            RenderPPFXScene(PostProcessingEffectMode::Bloom);
-            break;
-        case PostProcessingEffectMode::HDRToneMapping:
-            RenderPPFXScene(PostProcessingEffectMode::HDRToneMapping);
-            break;
-        case PostProcessingEffectMode::LensFlare:
-            RenderPPFXScene(PostProcessingEffectMode::LensFlare);
-            break;
-        case PostProcessingEffectMode::SSAO:
-            RenderPPFXScene(PostProcessingEffectMode::SSAO);
-            break;
-        case PostProcessingEffectMode::FXAA:
-            RenderPPFXScene(PostProcessingEffectMode::FXAA);
-            break;
-        case PostProcessingEffectMode::DepthTesting:
-            RenderPPFXScene(PostProcessingEffectMode::DepthTesting);
-            break;
-        case PostProcessingEffectMode::DepthMapping:
-            RenderPPFXScene(PostProcessingEffectMode::DepthMapping);
-            break;
-        case PostProcessingEffectMode::DirectionalShadowMapping:
-            RenderPPFXScene(PostProcessingEffectMode::DirectionalShadowMapping);
-            break;
-        case PostProcessingEffectMode::OmnidirectionalShadowMapping:
-            RenderPPFXScene(PostProcessingEffectMode::OmnidirectionalShadowMapping);
-            break;
-        case PostProcessingEffectMode::DeferredRendering:
-            RenderPPFXScene(PostProcessingEffectMode::DeferredRendering);
-            break;
-        case PostProcessingEffectMode::RainDrops:
-            RenderPPFXScene(PostProcessingEffectMode::RainDrops);
-            break;
-        case PostProcessingEffectMode::PaletteQuantizationAndDithering:
-            RenderPPFXScene(PostProcessingEffectMode::PaletteQuantizationAndDithering);
-            break;
-        case PostProcessingEffectMode::DistortedTV:
-            RenderPPFXScene(PostProcessingEffectMode::DistortedTV);
-            break;
-        case PostProcessingEffectMode::RGBDisplay:
-            RenderPPFXScene(PostProcessingEffectMode::RGBDisplay);
-            break;
-        case PostProcessingEffectMode::RetroParallax:
-            RenderPPFXScene(PostProcessingEffectMode::RetroParallax);
-            break;
-        case PostProcessingEffectMode::MoneyFilter:
-            RenderPPFXScene(PostProcessingEffectMode::MoneyFilter);
-            break;
-        case PostProcessingEffectMode::MicroprismMosaic:
-            RenderPPFXScene(PostProcessingEffectMode::MicroprismMosaic);
-            break;
-        case PostProcessingEffectMode::BayerMatrixDithering:
-            RenderPPFXScene(PostProcessingEffectMode::BayerMatrixDithering);
-            break;
-        case PostProcessingEffectMode::JuliaFreak:
-            RenderPPFXScene(PostProcessingEffectMode::JuliaFreak);
-            break;
-        case PostProcessingEffectMode::HeartBlend:
-            RenderPPFXScene(PostProcessingEffectMode::HeartBlend);
-            break;
-        case PostProcessingEffectMode::EMInterference:
-            RenderPPFXScene(PostProcessingEffectMode::EMInterference);
-            break;
-        case PostProcessingEffectMode::CubicLensDistortion:
-            RenderPPFXScene(PostProcessingEffectMode::CubicLensDistortion);
-            break;
-        case PostProcessingEffectMode::CelShaderish:
-            RenderPPFXScene(PostProcessingEffectMode::CelShaderish);
-            break;
-        case PostProcessingEffectMode::CartoonVideo:
-            RenderPPFXScene(PostProcessingEffectMode::CartoonVideo);
-            break;
+    if (!m_ppfxGraph.IsCompiled() || m_ppfxGraphMode != mode || m_ssaoQualityChanged || m_ppfxStackChanged) {
+        BuildPPFXGraph(m_ppfxGraph, mode);
+        m_ppfxGraphMode = mode;
+        m_ssaoQualityChanged = false;
+        m_ssaoHistoryValid = false; // what the history holds was not seen by this graph
+        m_ppfxStackChanged = false;
+        
+        if (UsesPPFXStack(mode)) {
+            printf("Post processing stack of %d effects in %d passes, %d saved, %.1f MB a frame instead of %.1f MB\n",
+                   static_cast<GLint>(m_ppfxStack.size()), m_ppfxStackPasses, m_ppfxStackSaved, m_ppfxStackFusedBandwidth, m_ppfxStackBandwidth);
+        }
     }
+    m_ppfxGraph.Execute();
     
+    if (m_ppfxSwitching) {
+        printf("Post processing switched to %s in %.2f ms, %d targets allocated, %d pooled\n", PostProcessingEffectToString(mode),
+               m_ppfxSwitchTimer.Elapsed(), m_ppfxTargets.GetAllocations() - m_ppfxSwitchAllocations, m_ppfxTargets.GetCount());
+        m_ppfxSwitching = false;
+    }
 }
 
 /// convert post processing effect to string
 const char * const Game::PostProcessingEffectToString(const PostProcessingEffectMode &mode){
-    
-    //  Post Processing Effects
-    // render the result on the default frame buffer using a full screen quad with post proccessing effects
-    switch(mode) {
-        case PostProcessingEffectMode::PBR:
-        return "Physically Based Rendering";
-        case PostProcessingEffectMode::IBL:
-        return "Image Based Lighting";
-        case PostProcessingEffectMode::BlinnPhong:
-        return "Blinn-Phong Lighting";
-        case PostProcessingEffectMode::ColorInversion:
-        return "Color Inversion";
-        case PostProcessingEffectMode::GrayScale:
-        return "GrayScale";
-        case PostProcessingEffectMode::Kernel:
-        return "Kernel";
-        case PostProcessingEffectMode::KernelBlur:
-        return "Kernel Blur";
-        case PostProcessingEffectMode::SobelEdgeDetection:
-        return "Sobel Edge Detection";
-        case PostProcessingEffectMode::FreiChenEdgeDetection:
-        return "Frei-Chen Edge Detection";
-        case PostProcessingEffectMode::ScreenWave:
-        return "Screen Wave";
-        case PostProcessingEffectMode::Swirl:
-        return "Swirl";
-        case PostProcessingEffectMode::NightVision:
-        return "Night Vision";
-        case PostProcessingEffectMode::LensCircle:
-        return "Lens Circle";
-        case PostProcessingEffectMode::Posterization:
-        return "Posterization";
-        case PostProcessingEffectMode::DreamVision:
-        return "Dream Vision";
-        case PostProcessingEffectMode::Pixelate:
-        return "Pixelate";
-        case PostProcessingEffectMode::Pixelation:
-        return "Pixelation";
-        case PostProcessingEffectMode::KnittedPixelation:
-        return "Knitted Pixelation";
-        case PostProcessingEffectMode::FrostedGlassPixelationEffect:
-        return "Frosted Glass Pixelation Effect";
-        case PostProcessingEffectMode::FrostedGlassScreenWaveEffect:
-        return "Frosted Glass Screen Wave Effect";
-        case PostProcessingEffectMode::Crosshatching:
-        return "Crosshatching";
-        case PostProcessingEffectMode::PredatorsThermalVision:
-        return "Predators Thermal Vision";
-        case PostProcessingEffectMode::Toonify:
-        return "Toonify";
-        case PostProcessingEffectMode::Shockwave:
-        return "Shockwave";
-        case PostProcessingEffectMode::FishEye:
-        return "Fish Eye";
-        case PostProcessingEffectMode::BarrelDistortion:
-        return "Barrel Distortion";
-        case PostProcessingEffectMode::MultiScreenFishEye:
-        return "Multi-Screen Fish Eye";
-        case PostProcessingEffectMode::FishEyeLens:
-        return "Fish Eye Lens";
-        case PostProcessingEffectMode::FishEyeAntiFishEye:
-        return "Fish Eye / Anti-Fish Eye";
-        case PostProcessingEffectMode::GaussianBlur:
-        return "Gaussian Blur";
-        case PostProcessingEffectMode::Blur:
-        return "Blur";
-        case PostProcessingEffectMode::RadialBlur:
-        return "Radial Blur";
-        case PostProcessingEffectMode::MotionBlur:
-        return "Motion Blur";
-        case PostProcessingEffectMode::Vignetting:
-            return "Vignetting";
-        case PostProcessingEffectMode::BrightParts:
-            return "Bright Parts";
-        case PostProcessingEffectMode::Bloom:
-            return "Bloom";
-        case PostProcessingEffectMode::HDRToneMapping:
-            return "HDR Tone Mapping";
-        case PostProcessingEffectMode::LensFlare:
-            return "Lens Flare";
-        case PostProcessingEffectMode::SSAO:
-            return "Screen Space Ambient Occlusion";
-        case PostProcessingEffectMode::FXAA:
-            return "Fast Approximate Anti-Aliasing (FXAA)";
-        case PostProcessingEffectMode::DepthTesting:
-            return "Depth Testing";
-        case PostProcessingEffectMode::DepthMapping:
-            return "Depth Mapping";
-        case PostProcessingEffectMode::DirectionalShadowMapping:
-            return "Directional Shadow Mapping";
-        case PostProcessingEffectMode::OmnidirectionalShadowMapping:
-            return "Omnidirectional Shadow Mapping";
-        case PostProcessingEffectMode::DeferredRendering:
-            return "Deferred Rendering";
-        case PostProcessingEffectMode::RainDrops:
-            return "Rain Drops";
-        case PostProcessingEffectMode::PaletteQuantizationAndDithering:
-            return "Palette Quantization And Dithering";
-        case PostProcessingEffectMode::DistortedTV:
-            return "Distorted TV";
-        case PostProcessingEffectMode::RGBDisplay:
-            return "RGB Display";
-        case PostProcessingEffectMode::RetroParallax:
-            return "Retro Parallax";
-        case PostProcessingEffectMode::MoneyFilter:
-            return "Money Filter";
-        case PostProcessingEffectMode::MicroprismMosaic:
-            return "Microprism Mosaic";
-        case PostProcessingEffectMode::BayerMatrixDithering:
-            return "Bayer Matrix Dithering";
-        case PostProcessingEffectMode::JuliaFreak:
-            return "Julia Freak";
-        case PostProcessingEffectMode::HeartBlend:
-            return "Heart Blend";
-        case PostProcessingEffectMode::EMInterference:
-            return "EM Interference";
-        case PostProcessingEffectMode::CubicLensDistortion:
-            return "Cubic Lens Distortion";
-        case PostProcessingEffectMode::CelShaderish:
-            return "Cel Shaderish";
-        case PostProcessingEffectMode::CartoonVideo:
-            return "Cartoon Video";
-        default: return "";
-    }
-    
+    return PostProcessingEffectModeToString(mode);
 }
 
 FrameBufferType Game::GetFBOtype(const PostProcessingEffectMode &mode){
+    return CPostProcessingGraph::GetSceneType(mode);
+}
+
+// The shader programs the passes of an effect render with, as its graph declares them
+std::vector<GLuint> Game::GetPPFXPrograms(const PostProcessingEffectMode &mode){
     
-    switch(mode) {
-        case PostProcessingEffectMode::GaussianBlur:
-            return FrameBufferType::HighDynamicRangeRendering;
-        case PostProcessingEffectMode::BrightParts:
-            return FrameBufferType::HighDynamicRangeRendering;
-        case PostProcessingEffectMode::Bloom:
-            return FrameBufferType::HighDynamicRangeRendering;
-        case PostProcessingEffectMode::HDRToneMapping:
-            return FrameBufferType::HighDynamicRangeLighting;
-        case PostProcessingEffectMode::LensFlare:
-            return FrameBufferType::HighDynamicRangeRendering;
-        case PostProcessingEffectMode::DeferredRendering:
-            return FrameBufferType::DeferredRendering;
-        case PostProcessingEffectMode::SSAO:
-            return FrameBufferType::GeometryBuffer;
-        default:
-            return FrameBufferType::Default;
+    // the passes the graph culls render nothing, the fused runs of the stack generate their programs themselves
+    std::vector<std::vector<GLuint>> passPrograms;
+    CRenderGraph graph;
+    CPostProcessingGraph(graph, GetPPFXGraphSettings(), [&passPrograms](const PostProcessingPass &pass) {
+        passPrograms.push_back(pass.programs);
+        return std::function<void()>();
+    }).Declare(mode);
+    
+    std::vector<GLuint> programs;
+    for (GLuint pass : graph.GetSchedule()) {
+        for (GLuint program : passPrograms[pass]) {
+            if (std::find(programs.begin(), programs.end(), program) == programs.end()) programs.push_back(program);
+        }
     }
+    return programs;
 }
 
+// Effects whose programs are not built yet are asked for first and shown as the plain scene until they are
+PostProcessingEffectMode Game::GetReadyPPFXMode(const PostProcessingEffectMode &mode){
+    
+    GLboolean ready = true;
+    for (GLuint index : GetPPFXPrograms(mode)) {
+        CShaderProgram *pShaderProgram = (*m_pShaderPrograms)[index];
+        if (pShaderProgram->IsLinked()) continue;
+        CShaderPrewarmer::Instance().Request(pShaderProgram, true);
+        ready = false;
+    }
+    return ready ? mode : PostProcessingEffectMode::PBR;
+}
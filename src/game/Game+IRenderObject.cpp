@@ -7,6 +7,7 @@
 //
 
 #include "Game.h"
+#include "../window/GLState.h"
 
 void Game::RenderQuad(CShaderProgram *pShaderProgram, const glm::vec3 & position,
                 const glm::vec3 & scale, const GLboolean &bindTexture) {
@@ -48,7 +49,7 @@ void Game::RenderSkyBox(CShaderProgram *pShaderProgram) {
     ResetSkyBox(pShaderProgram);
 
     // draw skybox as last
-    glDepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+    CGLState::Instance().DepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
     pShaderProgram->UseProgram();
     pShaderProgram->SetUniform("bUseEnvCubemap", false);
     pShaderProgram->SetUniform("matrices.projMatrix", m_pCamera->GetPerspectiveProjectionMatrix());
@@ -61,14 +62,14 @@ void Game::RenderSkyBox(CShaderProgram *pShaderProgram) {
     pShaderProgram->SetUniform("matrices.modelMatrix", model);
     pShaderProgram->SetUniform("matrices.normalMatrix", m_pCamera->ComputeNormalMatrix(model));
     m_pSkybox->Render(true, SkyboxType::Default);
-    glDepthFunc(GL_LESS); // set depth function back to default
+    CGLState::Instance().DepthFunc(GL_LESS); // set depth function back to default
     
 }
 
 void Game::RenderEnvSkyBox(CShaderProgram *pShaderProgram) {
     ResetSkyBox(pShaderProgram);
     // draw skybox as last
-    glDepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
+    CGLState::Instance().DepthFunc(GL_LEQUAL);  // change depth function so depth test passes when values are equal to depth buffer's content
     pShaderProgram->UseProgram();
     pShaderProgram->SetUniform("bUseEnvCubemap", true);
     pShaderProgram->SetUniform("matrices.projMatrix", m_pCamera->GetPerspectiveProjectionMatrix());
@@ -82,7 +83,7 @@ void Game::RenderEnvSkyBox(CShaderProgram *pShaderProgram) {
     pShaderProgram->SetUniform("matrices.normalMatrix", m_pCamera->ComputeNormalMatrix(model));
     
     m_pIrrSkybox->Render(true, m_useIrradianceMap ? SkyboxType::PrefilterMap : SkyboxType::EnvironmentMap);
-    glDepthFunc(GL_LESS); // set depth function back to default
+    CGLState::Instance().DepthFunc(GL_LESS); // set depth function back to default
 }
 
 void Game::RenderTerrain(CShaderProgram *pShaderProgram, const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale, const GLboolean &useHeightMap) {
@@ -94,6 +95,8 @@ void Game::RenderTerrain(CShaderProgram *pShaderProgram, const glm::vec3 & posit
     if (useHeightMap == true) {
         // Render the height map terrain
         m_pHeightmapTerrain->Transform(position, rotation, scale);
+        m_pTerrainOccluder = m_pHeightmapTerrain;
+        if (IsCulled(m_pHeightmapTerrain)) return;
         glm::mat4 model = m_pHeightmapTerrain->Model();
         pShaderProgram->SetUniform("matrices.modelMatrix", model);
         pShaderProgram->SetUniform("matrices.normalMatrix", m_pCamera->ComputeNormalMatrix(model));
@@ -103,6 +106,8 @@ void Game::RenderTerrain(CShaderProgram *pShaderProgram, const glm::vec3 & posit
 //        glEnable (GL_BLEND);
 //        glBlendFunc (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         m_pPlanarTerrain->Transform(position, rotation, glm::vec3(scale));
+        m_pTerrainOccluder = m_pPlanarTerrain;
+        if (IsCulled(m_pPlanarTerrain)) return;
         
         glm::mat4 terrainModel = m_pPlanarTerrain->Model();
         pShaderProgram->SetUniform("matrices.modelMatrix", terrainModel);
@@ -113,56 +118,186 @@ void Game::RenderTerrain(CShaderProgram *pShaderProgram, const glm::vec3 & posit
     
 }
 
-void  Game::RenderPrimitive(CShaderProgram *pShaderProgram, IGameObject *object, const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale, const GLboolean &useTexture) {
+void  Game::RenderPrimitive(CShaderProgram *pShaderProgram, IGameObject *object, const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale, const GLboolean &useTexture, const GLboolean &cull) {
     glm::vec3 translation = position;
     if (m_pHeightmapTerrain->IsHeightMapRendered()) {
         translation = glm::vec3(position.x, position.y+m_pHeightmapTerrain->ReturnGroundHeight(position), position.z);
     }
     
-    pShaderProgram->UseProgram();
-    pShaderProgram->SetUniform("matrices.projMatrix", m_pCamera->GetPerspectiveProjectionMatrix());
-    pShaderProgram->SetUniform("matrices.viewMatrix", m_pCamera->GetViewMatrix());
-    glm::mat4 inverseViewMatrix = glm::inverse(m_pCamera->GetViewMatrix());
-    pShaderProgram->SetUniform("matrices.inverseViewMatrix", inverseViewMatrix);
-    
     object->Transform(translation, rotation, scale);
+    if (cull && IsCulled(object)) return;
     
     glm::mat4 model = object->Model();
-    pShaderProgram->SetUniform("matrices.modelMatrix", model);
-    pShaderProgram->SetUniform("matrices.normalMatrix", m_pCamera->ComputeNormalMatrix(model));
+    SetMatrixUniforms(pShaderProgram, model, m_pCamera->ComputeNormalMatrix(model));
     object->Render(useTexture);
 }
 
-void Game::RenderModel(CShaderProgram *pShaderProgram, CModel * model, const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale) {
+void Game::RenderModel(CShaderProgram *pShaderProgram, CModel * model, const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale, const GLboolean &cull) {
     glm::vec3 translation = position;
     if (m_pHeightmapTerrain->IsHeightMapRendered()) {
         translation = glm::vec3(position.x, position.y+m_pHeightmapTerrain->ReturnGroundHeight(position), position.z);
     }
     
+    model->Transform(translation, rotation, scale);
+    if (cull && IsCulled(model)) return;
+    
+    glm::mat4 m = model->Model();
+    SetMatrixUniforms(pShaderProgram, m, m_pCamera->ComputeNormalMatrix(m));
+    model->Render(pShaderProgram);
+}
+
+// the camera and the model matrices of a program about to draw an object
+void Game::SetMatrixUniforms(CShaderProgram *pShaderProgram, const glm::mat4 &model, const glm::mat3 &normalMatrix) {
     pShaderProgram->UseProgram();
     pShaderProgram->SetUniform("matrices.projMatrix", m_pCamera->GetPerspectiveProjectionMatrix());
-    pShaderProgram->SetUniform("matrices.viewMatrix", m_pCamera->GetViewMatrix());
+    pShaderProgram->SetUniform("matrices.viewMatrix", m_viewMatrix);
+    pShaderProgram->SetUniform("matrices.inverseViewMatrix", m_inverseViewMatrix);
     
-    glm::mat4 inverseViewMatrix = glm::inverse(m_pCamera->GetViewMatrix());
-    pShaderProgram->SetUniform("matrices.inverseViewMatrix", inverseViewMatrix);
+    pShaderProgram->SetUniform("matrices.modelMatrix", model);
+    pShaderProgram->SetUniform("matrices.normalMatrix", normalMatrix);
+}
+
+// the object's box after its transform against the planes RenderScene set, objects without bounds are always drawn
+GLboolean Game::IsCulled(IGameObject *object) {
+    glm::vec3 min, max;
+    if (!m_useCulling || !object->GetBounds(min, max)) return false;
     
-    model->Transform(translation, rotation, scale);
+    glm::vec3 worldMin, worldMax;
+    CFrustumCuller::TransformBounds(object->Model(), min, max, worldMin, worldMax);
+    return !m_pFrustumCuller->TestBox(worldMin, worldMax);
+}
+
+void Game::RenderSceneObject(CShaderProgram *pShaderProgram, const GLuint &object, const glm::vec3 &offset) {
+    const SceneMesh &mesh = m_pSceneStore->GetMesh(m_pSceneStore->GetMeshIds()[object]);
+    const glm::mat4 model = GetSceneObjectModel(object, offset);
     
-    glm::mat4 m = model->Model();
-    pShaderProgram->SetUniform("matrices.modelMatrix", m);
-    pShaderProgram->SetUniform("matrices.normalMatrix", m_pCamera->ComputeNormalMatrix(m));
-    model->Render(pShaderProgram);
+    // the meshes carry no textures of their own, the material binds them,
+    // RenderSceneLayer has culled the scene objects already
+    m_pSceneStore->GetMaterial(m_pSceneStore->GetMaterialIds()[object])->Bind();
+    SetMatrixUniforms(pShaderProgram, model, m_pSceneFrame->normals[object]);
+    if (mesh.pModel != nullptr) {
+        mesh.pModel->SetModel(model);
+        mesh.pModel->Render(pShaderProgram);
+    } else {
+        mesh.pObject->SetModel(model);
+        mesh.pObject->Render(false);
+    }
+}
+
+// the batch of the visible objects of a layer drawn with the layer's program, made the first time it is asked for
+GLint Game::GetIndirectBatch(const std::string &layer, const GLuint &first, const GLuint &count) {
+    std::map<std::string, GLint>::const_iterator it = m_indirectBatches.find(layer);
+    if (it != m_indirectBatches.end())
+        return it->second;
+    
+    const std::vector<GLint> &programs = m_pSceneStore->GetPrograms();
+    const std::vector<GLuint> &flags = m_pSceneStore->GetFlags();
+    m_indirectObjects.resize(m_pSceneStore->GetObjectCount(), 0);
+    std::vector<IndirectObject> objects;
+    for (GLuint i = first; i < first + count; ++i) {
+        if (!(flags[i] & SceneFlagBit(SceneFlag::Visible)) || programs[i] >= 0) continue;
+        const SceneMesh &mesh = m_pSceneStore->GetMesh(m_pSceneStore->GetMeshIds()[i]);
+        if (!m_pIndirectCuller->HasMesh(mesh.pObject)) continue;
+        objects.push_back(IndirectObject{mesh.pObject, m_pSceneStore->GetMaterialIds()[i], mesh.boundsMin, mesh.boundsMax, i});
+        m_indirectObjects[i] = 1;
+    }
+    
+    GLint batch = objects.empty() ? -1 : static_cast<GLint>(m_pIndirectCuller->AddBatch(objects));
+    m_indirectBatches[layer] = batch;
+    return batch;
+}
+
+// only the transforms of the batch are sent, the compute shader picks the objects that are drawn
+void Game::RenderSceneIndirect(CShaderProgram *pInstancedProgram, const GLuint &batch, const glm::vec3 &offset) {
+    CInstanceBuffer &instances = m_pIndirectCuller->GetInstances();
+    instances.Clear();
+    const GLuint count = m_pIndirectCuller->GetObjectCount(batch);
+    for (GLuint i = 0; i < count; ++i) {
+        const GLuint object = m_pIndirectCuller->GetItem(batch, i);
+        instances.Add(GetSceneObjectModel(object, offset), m_pSceneFrame->normals[object]);
+    }
+    
+    // planes that keep everything when culling is off
+    glm::vec4 planes[6];
+    for (GLuint i = 0; i < 6; ++i) planes[i] = m_useCulling ? m_pFrustumCuller->GetPlanes()[i] : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    m_pIndirectCuller->Cull((*m_pShaderPrograms)[95], batch, planes);
+    
+    pInstancedProgram->UseProgram();
+    pInstancedProgram->SetUniform("matrices.projMatrix", m_pCamera->GetPerspectiveProjectionMatrix());
+    pInstancedProgram->SetUniform("matrices.viewMatrix", m_viewMatrix);
+    pInstancedProgram->SetUniform("matrices.inverseViewMatrix", m_inverseViewMatrix);
+    
+    m_indirectObjectCount = count;
+    m_indirectDrawCount = 0;
+    for (GLuint run = 0; run < m_pIndirectCuller->GetRunCount(batch); ++run) {
+        m_pSceneStore->GetMaterial(m_pIndirectCuller->GetRunMaterial(batch, run))->Bind();
+        m_pIndirectCuller->Draw(batch, run);
+        m_indirectDrawCount++;
+    }
+}
+
+void Game::RenderSceneInstanced(CShaderProgram *pInstancedProgram, CShaderProgram *pShaderProgram,
+                                const std::vector<GLuint> &objects, const glm::vec3 &offset) {
+    const std::vector<GLuint> &meshIds = m_pSceneStore->GetMeshIds();
+    const std::vector<GLuint> &materialIds = m_pSceneStore->GetMaterialIds();
+    
+    // the objects come from the render queue, those of the same mesh and material are next to each other
+    // and each run is one instanced draw, the transforms are worked out like RenderPrimitive does
+    m_pInstanceBuffer->Clear();
+    for (GLuint object : objects) {
+        // moving a model up or down leaves its normal matrix alone
+        m_pInstanceBuffer->Add(GetSceneObjectModel(object, offset), m_pSceneFrame->normals[object]);
+    }
+    m_pInstanceBuffer->Upload();
+    
+    pInstancedProgram->UseProgram();
+    pInstancedProgram->SetUniform("matrices.projMatrix", m_pCamera->GetPerspectiveProjectionMatrix());
+    pInstancedProgram->SetUniform("matrices.viewMatrix", m_viewMatrix);
+    pInstancedProgram->SetUniform("matrices.inverseViewMatrix", m_inverseViewMatrix);
+    
+    m_instancedObjectCount = static_cast<GLuint>(objects.size());
+    m_instancedDrawCount = 0;
+    GLuint start = 0;
+    while (start < objects.size()) {
+        GLuint object = objects[start];
+        GLuint end = start + 1;
+        while (end < objects.size() && meshIds[objects[end]] == meshIds[object] && materialIds[objects[end]] == materialIds[object]) end++;
+        
+        m_pSceneStore->GetMaterial(materialIds[object])->Bind();
+        if (m_pSceneStore->GetMesh(meshIds[object]).pObject->RenderInstanced(*m_pInstanceBuffer, start, end - start)) {
+            m_instancedDrawCount++;
+        } else {
+            // meshes without an instanced path are drawn one by one with the regular program
+            for (GLuint i = start; i < end; ++i) {
+                RenderSceneObject(pShaderProgram, objects[i], offset);
+                m_instancedDrawCount++;
+            }
+            pInstancedProgram->UseProgram();
+        }
+        start = end;
+    }
+}
+
+// the transform of a scene object including the spin and the ground height, from the frame UpdateScene acquired
+glm::mat4 Game::GetSceneObjectModel(const GLuint &object, const glm::vec3 &offset) {
+    glm::mat4 model = m_pSceneFrame->worlds[object];
+    model[3] += glm::vec4(offset, 0.0f);
+    return model;
+}
+
+// the world box of the scene store moved the same way
+void Game::GetSceneObjectBounds(const GLuint &object, const glm::vec3 &offset, glm::vec3 &min, glm::vec3 &max) {
+    glm::vec3 translation = offset;
+    translation.y += m_pSceneFrame->groundHeights[object];
+    min = m_pSceneStore->GetBoundsMin()[object] + translation;
+    max = m_pSceneStore->GetBoundsMax()[object] + translation;
 }
 
 void Game::RenderMetalBalls(CShaderProgram *pShaderProgram, const glm::vec3 & position, const glm::vec3 & scale, const GLboolean &useTexture) {
     
     pShaderProgram->UseProgram();
     
-    // Update the metaballs' positions
-    float time = (float)m_deltaTime / 1000.0f * 2.0f * 3.14159f * 0.5f;
-    m_pMetaballs->Update(time);
-    
-    // Render the metalballs
+    // Render the metalballs, UpdateScene has moved them this frame already
     RenderPrimitive(pShaderProgram, m_pMetaballs, position, glm::vec3(0.0f), scale, useTexture);
 }
 
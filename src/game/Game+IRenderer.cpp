@@ -7,193 +7,218 @@
 //
 
 #include "Game.h"
+#include "../window/GLState.h"
+#include "../shaders/ShaderPrewarmer.h"
 
-void Game::RenderPBRScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex, const GLfloat zfront, const GLfloat zback) {
+void Game::RenderPBRScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex) {
     GLfloat yPos = m_currentPPFXMode == PostProcessingEffectMode::SSAO ? (m_useTerrain ? -100.0f : -800.0f) : 0.0f;
     
-    // 1 - 10
-    RenderPrimitive(pShaderProgram, m_pSpherePBR1, glm::vec3(50.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot1, glm::vec3(50.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
-    RenderPrimitive(pShaderProgram, m_pSpherePBR2, glm::vec3(-50.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot2, glm::vec3(-50.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
-    RenderPrimitive(pShaderProgram, m_pSpherePBR3, glm::vec3(150.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot3, glm::vec3(150.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
-    RenderPrimitive(pShaderProgram, m_pSpherePBR4, glm::vec3(-150.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot4, glm::vec3(-150.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
-    RenderPrimitive(pShaderProgram, m_pSpherePBR5, glm::vec3(250.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot5, glm::vec3(250.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
-    RenderPrimitive(pShaderProgram, m_pSpherePBR6, glm::vec3(-250.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot6, glm::vec3(-250.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
-    RenderPrimitive(pShaderProgram, m_pSpherePBR7, glm::vec3(350.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot7, glm::vec3(350.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
-    RenderPrimitive(pShaderProgram, m_pSpherePBR8, glm::vec3(-350.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot8, glm::vec3(-350.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
-    RenderPrimitive(pShaderProgram, m_pSpherePBR9, glm::vec3(450.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot9, glm::vec3(450.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
-    RenderPrimitive(pShaderProgram, m_pSpherePBR10, glm::vec3(-450.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-    RenderModel(pShaderProgram, m_teapot10, glm::vec3(-450.0f, yPos+10, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    
+    RenderSceneLayer(pShaderProgram, "pbr", toCustomShader, toCustomShaderIndex, glm::vec3(0.0f, yPos, 0.0f));
 }
 
 
-void Game::RenderRandomScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex, const GLfloat zfront, const GLfloat zback)  {
+void Game::RenderRandomScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex)  {
     GLfloat yPos = m_currentPPFXMode == PostProcessingEffectMode::SSAO ? (m_useTerrain ? -100.0f : -800.0f) : 0.0f;
     const GLboolean useAO = m_currentPPFXMode == PostProcessingEffectMode::SSAO;
     GLboolean isPBR =
     m_currentPPFXMode == PostProcessingEffectMode::PBR
     || m_currentPPFXMode == PostProcessingEffectMode::IBL;
     
-    /// Bump Mapping
-    {
-        CShaderProgram *pBumpMappingProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 7];
-        SetCameraUniform(pBumpMappingProgram, "camera", m_pCamera);
-        SetLightUniform(pBumpMappingProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-        SetMaterialUniform(pBumpMappingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
-        SetFogMaterialUniform(pBumpMappingProgram, "fog", m_fogColor, m_useFog);
-        SetHRDLightUniform(pBumpMappingProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-        RenderLight(pBumpMappingProgram, m_dirName, m_pointName, m_spotName, m_pCamera);
-        
-        // 11
-        RenderPrimitive(pBumpMappingProgram, m_pSpherePBR11, glm::vec3(50.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-        //RenderPrimitive(pBumpMappingProgram, m_pTorus, glm::vec3(50.0f, 0.0f, zback), glm::vec3(0.0f), glm::vec3(10.0f));
-        RenderPrimitive(pBumpMappingProgram, m_pTorusKnot, glm::vec3(50.0f, 0.0f, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-    }
-    
+    RenderSceneLayer(pShaderProgram, "random", toCustomShader, toCustomShaderIndex, glm::vec3(0.0f, yPos, 0.0f));
     
-    /// Environment Mapping
+    /// MetalBalls
     {
         CShaderProgram *pEnvironmentMapProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 9];
-        SetCameraUniform(pEnvironmentMapProgram, "camera", m_pCamera);
-        SetMaterialUniform(pEnvironmentMapProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
-        SetHRDLightUniform(pEnvironmentMapProgram, "hrdlight", m_exposure, m_gama, m_HDR);
-        SetEnvironmentMapUniform(pEnvironmentMapProgram, m_useRefraction);
-        SetFogMaterialUniform(pEnvironmentMapProgram, "fog", m_fogColor, m_useFog);
-        
-        // 12
-        RenderPrimitive(pEnvironmentMapProgram, m_pSpherePBR12, glm::vec3(-50.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f), false);
-        RenderPrimitive(pEnvironmentMapProgram, m_pCube12, glm::vec3(-50.0f, 0.0f, zback), glm::vec3(0.0f), glm::vec3(30.0f), false);
+        SetMaterialUniform(isPBR ? pShaderProgram : pEnvironmentMapProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
+        RenderMetalBalls(isPBR ? pShaderProgram : pEnvironmentMapProgram, glm::vec3(-380.0f, 0.0f, 500.0f), glm::vec3(100.0f), isPBR ? m_materialUseTexture : false);
+    }
+}
+
+
+void Game::RenderSceneLayer(CShaderProgram *pShaderProgram, const std::string &layer, const GLboolean &toCustomShader,
+                            const GLint &toCustomShaderIndex, const glm::vec3 &offset) {
+    GLuint first, count;
+    if (!m_pSceneStore->GetLayer(layer, first, count))
+        return;
+    
+    const std::vector<GLint> &programs = m_pSceneStore->GetPrograms();
+    const std::vector<GLuint> &flags = m_pSceneStore->GetFlags();
+    const GLuint visible = SceneFlagBit(SceneFlag::Visible);
+    
+    const GLboolean useOcclusion = m_useCulling && m_useOcclusionCulling && !m_cullFromLight;
+    const GLuint occluder = SceneFlagBit(SceneFlag::Occluder) | visible;
+    
+    // the objects of the scene program are grouped into instanced draws when it has an instanced variant
+    // that is built already, until then they are drawn one by one below
+    GLint instancedIndex = -1;
+    if (pShaderProgram == (*m_pShaderPrograms)[3]) instancedIndex = 93;
+    else if (pShaderProgram == (*m_pShaderPrograms)[5]) instancedIndex = 94;
+    CShaderProgram *pInstancedProgram = instancedIndex < 0 ? nullptr : (*m_pShaderPrograms)[instancedIndex];
+    if (pInstancedProgram != nullptr && !pInstancedProgram->IsLinked()) {
+        CShaderPrewarmer::Instance().Request(pInstancedProgram, true);
+        pInstancedProgram = nullptr;
     }
     
-    
-    /// Parallax Normal Mapping
-    {
-        CShaderProgram *pParallaxNormalMappingProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 8];
-        SetCameraUniform(pParallaxNormalMappingProgram, "camera", m_pCamera);
-        SetLightUniform(pParallaxNormalMappingProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-        SetMaterialUniform(pParallaxNormalMappingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
-        SetParallaxMapUniform(pParallaxNormalMappingProgram, m_parallaxHeightScale);
-        SetFogMaterialUniform(pParallaxNormalMappingProgram, "fog", m_fogColor, m_useFog);
-        SetHRDLightUniform(pParallaxNormalMappingProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-        RenderLight(pParallaxNormalMappingProgram, m_dirName, m_pointName, m_spotName, m_pCamera);
-        
-        // 13
-        RenderPrimitive(pParallaxNormalMappingProgram, m_pSpherePBR13, glm::vec3(150.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-        RenderPrimitive(pParallaxNormalMappingProgram, m_pCube13, glm::vec3(150.0f, 0.0f, zback), glm::vec3(0.0f), glm::vec3(30.0f));
+    // with GL 4.3 the instanced objects whose meshes are in the shared buffers are culled and drawn on the GPU,
+    // the rest of them keep going through the queue
+    GLint indirectBatch = -1;
+    if (pInstancedProgram != nullptr && m_indirectSupported && m_useIndirect) {
+        CShaderProgram *pCullProgram = (*m_pShaderPrograms)[95];
+        if (pCullProgram->IsLinked()) indirectBatch = GetIndirectBatch(layer, first, count);
+        else CShaderPrewarmer::Instance().Request(pCullProgram, true);
     }
     
-    /// Chromatic Aberration Mapping
-    {
-        CShaderProgram *pChromaticAberrationProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 10];
-        SetCameraUniform(pChromaticAberrationProgram, "camera", m_pCamera);
-        SetMaterialUniform(pChromaticAberrationProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
-        SetFogMaterialUniform(pChromaticAberrationProgram, "fog", m_fogColor, m_useFog);
-        SetHRDLightUniform(pChromaticAberrationProgram, "hrdlight", m_exposure, m_gama, m_HDR);
-        SetChromaticAberrationUniform(pChromaticAberrationProgram, glm::vec2(0.3f, 1.5f));
-        
-        // 14
-        RenderPrimitive(pChromaticAberrationProgram, m_pSpherePBR14, glm::vec3(-150.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-        RenderPrimitive(pChromaticAberrationProgram, m_pCube14, glm::vec3(-150.0f, 0.0f, zback), glm::vec3(0.0f), glm::vec3(30.0f));
+    // the world boxes of the layer are culled in one batch, moved like RenderPrimitive moves the objects. Hidden
+    // objects and the ones the GPU culls are left out, unless they are occluders, so each object is tested and
+    // counted once
+    glm::vec3 boundsMin, boundsMax;
+    if (m_useCulling) {
+        m_pFrustumCuller->Clear();
+        m_cullIndices.assign(count, -1);
+        for (GLuint i = first; i < first + count; ++i) {
+            const GLboolean drawn = (flags[i] & visible) && !(indirectBatch >= 0 && m_indirectObjects[i]);
+            if (!drawn && !(useOcclusion && (flags[i] & occluder) == occluder)) continue;
+            GetSceneObjectBounds(i, offset, boundsMin, boundsMax);
+            m_cullIndices[i - first] = static_cast<GLint>(m_pFrustumCuller->AddBox(boundsMin, boundsMax));
+        }
+        m_pFrustumCuller->Cull();
     }
     
-    /// Discard
-    {
-        CShaderProgram *pDiscardProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 81];
-        glEnable (GL_BLEND);
-        glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
-        
-        SetCameraUniform(pDiscardProgram, "camera", m_pCamera);
-        SetLightUniform(pDiscardProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-        SetMaterialUniform(pDiscardProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
-        SetDisintegrationUniform(pDiscardProgram);
-        SetFogMaterialUniform(pDiscardProgram, "fog", m_fogColor, m_useFog);
-        SetHRDLightUniform(pDiscardProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-        RenderLight(pDiscardProgram, m_dirName, m_pointName, m_spotName, m_pCamera);
-
-        // 15
-        RenderPrimitive(pDiscardProgram, m_pSpherePBR15, glm::vec3(250.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-        RenderModel(pDiscardProgram, m_teapot15, glm::vec3(250.0f, 0.0f, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-
-        // Add Discard Lights
-        glDisable (GL_BLEND);
+    // from the camera the terrain and the visible occluders of the layer are drawn into the occlusion buffer
+    if (useOcclusion) {
+        m_pOcclusionCuller->Begin(m_pCamera->GetViewProjection());
+        m_occluderTriangles.clear();
+        if (m_pTerrainOccluder != nullptr && m_pTerrainOccluder->GetOccluder(m_occluderTriangles)) {
+            m_pOcclusionCuller->AddOccluder(m_occluderTriangles, m_pTerrainOccluder->Model());
+        }
+        for (GLuint i = first; i < first + count; ++i) {
+            if ((flags[i] & occluder) != occluder || !m_pFrustumCuller->IsVisible(m_cullIndices[i - first])) continue;
+            m_occluderTriangles.clear();
+            if (!m_pSceneStore->GetMesh(m_pSceneStore->GetMeshIds()[i]).pObject->GetOccluder(m_occluderTriangles)) continue;
+            m_pOcclusionCuller->AddOccluder(m_occluderTriangles, GetSceneObjectModel(i, offset));
+        }
+        m_pOcclusionCuller->Rasterize();
     }
     
-    /// Toon / Cell Program
-    {
-        CShaderProgram *pToonProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 14];
-        SetCameraUniform(pToonProgram, "camera", m_pCamera);
-        SetMaterialUniform(pToonProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
-        SetFogMaterialUniform(pToonProgram, "fog", m_fogColor, m_useFog);
-        SetLightUniform(pToonProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-        SetHRDLightUniform(pToonProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-        RenderLight(pToonProgram, m_dirName, m_pointName, m_spotName, m_pCamera);
+    // opaque objects are ordered by program, material and mesh, the blended discard ones back to front,
+    // the scene program is 0 in the key so its objects come first
+    const glm::vec3 cameraPosition = m_pCamera->GetPosition();
+    const GLfloat farPlane = m_pCamera->GetFarPlane();
+    m_renderQueue.Clear();
+    for (GLuint i = first; i < first + count; ++i) {
+        if (!(flags[i] & visible)) continue;
+        if (indirectBatch >= 0 && m_indirectObjects[i]) continue;
+        if (m_useCulling && !m_pFrustumCuller->IsVisible(m_cullIndices[i - first])) continue;
+        if (useOcclusion) {
+            GetSceneObjectBounds(i, offset, boundsMin, boundsMax);
+            if (!m_pOcclusionCuller->IsVisible(boundsMin, boundsMax)) continue;
+        }
         
-        // 16
-        RenderPrimitive(pToonProgram, m_pSpherePBR16, glm::vec3(-250.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-        RenderModel(pToonProgram, m_teapot16, glm::vec3(-250.0f, 0.0f, zback), glm::vec3(0.0f), glm::vec3(1.0f));
+        // from where the object is drawn, on the ground when the height map is on
+        const glm::vec3 position = glm::vec3(m_pSceneFrame->worlds[i][3]) + offset;
+        GLfloat depth = glm::length(position - cameraPosition) / farPlane;
+        GLuint program = static_cast<GLuint>(programs[i] + 1);
+        GLuint material = m_pSceneStore->GetMaterialIds()[i];
+        GLuint mesh = m_pSceneStore->GetMeshIds()[i];
+        if (programs[i] == 81) m_renderQueue.Push(CRenderQueue::TransparentKey(depth, program, material, mesh), i);
+        else m_renderQueue.Push(CRenderQueue::OpaqueKey(program, material, mesh, depth), i);
     }
+    m_renderQueue.Sort();
     
-    
-    /// Porcupine Rendering
-    {
-        CShaderProgram *pPorcupineRenderingProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 12];
-        SetMaterialUniform(pPorcupineRenderingProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
-        SetPorcupineRenderingUniform(pPorcupineRenderingProgram, glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), m_magnitude);
-        // 17
-        RenderPrimitive(pPorcupineRenderingProgram, m_pSpherePBR17, glm::vec3(350.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f), false);
-        RenderModel(pPorcupineRenderingProgram, m_teapot17, glm::vec3(350.0f, 0.0f, zback), glm::vec3(0.0f), glm::vec3(1.0f));
-
+    if (indirectBatch >= 0) {
+        SetSceneProgramUniform(pInstancedProgram, instancedIndex);
+        RenderSceneIndirect(pInstancedProgram, static_cast<GLuint>(indirectBatch), offset);
     }
     
-    /// FireBall
-    {
-        CShaderProgram *pFireBallProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 54];
-        SetMaterialUniform(pFireBallProgram, "material", glm::vec4(0.3f, 0.1f, 0.7f, 1.0f), m_materialShininess, m_uvTiling, useAO);
-        SetFireBallUniform(pFireBallProgram);
-        
-        // 18
-        RenderPrimitive(pFireBallProgram, m_pSpherePBR18, glm::vec3(-380.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
+    GLuint queued = 0;
+    if (pInstancedProgram != nullptr) {
+        m_instancedObjects.clear();
+        while (queued < m_renderQueue.GetCount() && programs[m_renderQueue.GetItem(queued)] < 0) {
+            m_instancedObjects.push_back(m_renderQueue.GetItem(queued++));
+        }
+        if (!m_instancedObjects.empty()) {
+            SetSceneProgramUniform(pInstancedProgram, instancedIndex);
+            RenderSceneInstanced(pInstancedProgram, pShaderProgram, m_instancedObjects, offset);
+        }
     }
     
-    /// MetalBalls
-    {
-        CShaderProgram *pEnvironmentMapProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 9];
-        SetMaterialUniform(isPBR ? pShaderProgram : pEnvironmentMapProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
-        RenderMetalBalls(isPBR ? pShaderProgram : pEnvironmentMapProgram, glm::vec3(-380.0f, 0.0f, zback), glm::vec3(100.0f), isPBR ? m_materialUseTexture : false);
+    // the uniforms of a program are set once per run of its objects
+    GLint currentProgram = -1;
+    CShaderProgram *pProgram = pShaderProgram;
+    for (; queued < m_renderQueue.GetCount(); ++queued) {
+        GLuint i = m_renderQueue.GetItem(queued);
+        if (programs[i] != currentProgram) {
+            if (currentProgram == 81) CGLState::Instance().Disable(GL_BLEND);
+            currentProgram = programs[i];
+            pProgram = currentProgram < 0 ? pShaderProgram : (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : currentProgram];
+            if (currentProgram >= 0) SetSceneProgramUniform(pProgram, currentProgram);
+        }
+        RenderSceneObject(pProgram, i, offset);
     }
+    if (currentProgram == 81) CGLState::Instance().Disable(GL_BLEND);
+}
+
+
+void Game::SetSceneProgramUniform(CShaderProgram *pShaderProgram, const GLint &programIndex) {
+    const GLboolean useAO = m_currentPPFXMode == PostProcessingEffectMode::SSAO;
     
-    /// Wireframe Rendering
-    {
-        CShaderProgram *pWireframeProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 13];
-        SetCameraUniform(pWireframeProgram, "camera", m_pCamera);
-        SetMaterialUniform(pWireframeProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
-        SetFogMaterialUniform(pWireframeProgram, "fog", m_fogColor, m_useFog);
-        SetWireframeUniform(pWireframeProgram, true, 0.15f);
-        SetLightUniform(pWireframeProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-        SetHRDLightUniform(pWireframeProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-        RenderLight(pWireframeProgram, m_dirName, m_pointName, m_spotName, m_pCamera);
-        
-        // 19
-        RenderPrimitive(pWireframeProgram, m_pSpherePBR19, glm::vec3(450.0f, yPos+30, zfront), glm::vec3(0.0f, m_sphereRotation, 0.0f), glm::vec3(30.0f));
-        RenderModel(pWireframeProgram, m_teapot19, glm::vec3(450.0f, 0.0f, zback), glm::vec3(0.0f), glm::vec3(1.0f));
+    SetMaterialUniform(pShaderProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
+    switch (programIndex) {
+        case 7: /// Bump Mapping
+            SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+            SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama);
+            break;
+        case 9: /// Environment Mapping
+            SetHRDLightUniform(pShaderProgram, "hrdlight", m_exposure, m_gama);
+            SetEnvironmentMapUniform(pShaderProgram, m_useRefraction);
+            SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+            break;
+        case 8: /// Parallax Normal Mapping
+            SetParallaxMapUniform(pShaderProgram, m_parallaxHeightScale);
+            SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+            SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama);
+            break;
+        case 10: /// Chromatic Aberration Mapping
+            SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+            SetHRDLightUniform(pShaderProgram, "hrdlight", m_exposure, m_gama);
+            SetChromaticAberrationUniform(pShaderProgram, glm::vec2(0.3f, 1.5f));
+            break;
+        case 81: /// Discard
+            CGLState::Instance().Enable(GL_BLEND);
+            CGLState::Instance().BlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+            SetDisintegrationUniform(pShaderProgram);
+            SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+            SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama);
+            break;
+        case 14: /// Toon / Cell Program
+            SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+            SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama);
+            break;
+        case 12: /// Porcupine Rendering
+            SetPorcupineRenderingUniform(pShaderProgram, glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), m_magnitude);
+            break;
+        case 54: /// FireBall
+            SetMaterialUniform(pShaderProgram, "material", glm::vec4(0.3f, 0.1f, 0.7f, 1.0f), m_materialShininess, m_uvTiling, useAO);
+            SetFireBallUniform(pShaderProgram);
+            break;
+        case 13: /// Wireframe Rendering
+            SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+            SetWireframeUniform(pShaderProgram, true, 0.15f);
+            SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama);
+            break;
+        case 93: /// Instanced Physically Based Rendering, the same uniforms RenderScene gives the PBR program
+            SetMaterialUniform(pShaderProgram, "material", m_materialColor, m_materialShininess, 1.0f, useAO);
+            SetPBRMaterialUniform(pShaderProgram, "material", m_albedo, m_metallic, m_roughness, m_ao, m_useIrradiance);
+            SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+            SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama);
+            break;
+        case 94: /// Instanced Blinn Phong Lighting, the same uniforms RenderScene gives the Light program
+            SetPBRMaterialUniform(pShaderProgram, "material", m_albedo, m_metallic, m_roughness, m_ao, m_useIrradiance);
+            SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+            SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama);
+            break;
+        default:
+            break;
     }
 }
 
@@ -223,8 +248,8 @@ void Game::RenderTerrainScene(CShaderProgram *pShaderProgram, const GLfloat yPos
         } else {
             /// InterioBox
             
-            glEnable(GL_CULL_FACE);
-            glCullFace(GL_FRONT);
+            CGLState::Instance().Enable(GL_CULL_FACE);
+            CGLState::Instance().CullFace(GL_FRONT);
             //glDisable(GL_CULL_FACE); // note that we disable culling here since we render 'inside' the cube instead of the usual 'outside' which throws off the normal culling methods.
             pShaderProgram->UseProgram();
             pShaderProgram->SetUniform("bReverseNormals", 1); // A small little hack to invert normals when drawing cube from the inside so lighting still works.
@@ -232,7 +257,7 @@ void Game::RenderTerrainScene(CShaderProgram *pShaderProgram, const GLfloat yPos
             RenderPrimitive(pShaderProgram, m_pInteriorBox, glm::vec3(0.0f,  0.0f,  0.0f ), glm::vec3(0.0f), glm::vec3(100.0f, 80.0f, 80.0f)); // Render Big cube underneath
             pShaderProgram->SetUniform("bReverseNormals", 0); // and of course disable it
             //glEnable(GL_CULL_FACE);
-            glCullFace(GL_BACK);
+            CGLState::Instance().CullFace(GL_BACK);
             
         }
     }
@@ -240,11 +265,68 @@ void Game::RenderTerrainScene(CShaderProgram *pShaderProgram, const GLfloat yPos
     
 }
 
+// Once a frame before the first pass, the shadow passes and the scene pass draw what is made here however many
+// of them the effect needs
+void Game::UpdateScene() {
+    m_pMetaballs->BeginFrame();
+    m_scenePasses = 0;
+    
+    if (m_pipelineScene && !m_scenePipeline.IsRunning()) m_scenePipeline.Start();
+    else if (!m_pipelineScene && m_scenePipeline.IsRunning()) m_scenePipeline.Stop();
+    
+    // the first pass drawing the metaballs polygonises the surface of the frame
+    m_pSceneFrame = &m_scenePipeline.Acquire(static_cast<GLfloat>(m_deltaTime), m_pHeightmapTerrain->IsHeightMapRendered());
+    m_pMetaballs->SetSurfaceBalls(m_pSceneFrame->balls);
+    m_sceneTransforms = m_pSceneFrame->transforms;
+}
+
+// runs on the worker of the scene pipeline when it is started, on the GL thread otherwise, so it only reads the
+// scene store and the height map, which do not change after loading, and what nothing else touches
+void Game::SimulateScene(SceneFrame &frame) {
+    m_sphereRotation += frame.deltaTime * 0.02f;
+    
+    // Update the metaballs' positions
+    float time = frame.deltaTime / 1000.0f * 2.0f * 3.14159f * 0.5f;
+    m_pMetaballs->Update(time);
+    frame.numBalls = m_pMetaballs->GetBalls(frame.balls);
+    
+    // the layer offsets only move objects up and down, which leaves the ground height under them the same
+    const std::vector<glm::vec3> &positions = m_pSceneStore->GetPositions();
+    const std::vector<glm::vec3> &rotations = m_pSceneStore->GetRotations();
+    const std::vector<glm::vec3> &scales = m_pSceneStore->GetScales();
+    const std::vector<GLuint> &flags = m_pSceneStore->GetFlags();
+    if (m_sceneHierarchy.GetSize() != positions.size()) {
+        m_sceneHierarchy.Clear();
+        for (GLuint i = 0; i < positions.size(); ++i) m_sceneHierarchy.Add();
+    }
+    frame.groundHeights.resize(positions.size());
+    for (GLuint i = 0; i < positions.size(); ++i) {
+        glm::vec3 rotation = rotations[i];
+        if (flags[i] & SceneFlagBit(SceneFlag::Spin)) {
+            rotation.y += m_sphereRotation;
+        }
+        frame.groundHeights[i] = frame.onHeightMap ? m_pHeightmapTerrain->ReturnGroundHeight(positions[i]) : 0.0f;
+        m_sceneHierarchy.SetLocal(i, positions[i] + glm::vec3(0.0f, frame.groundHeights[i], 0.0f), rotation, scales[i]);
+    }
+    
+    // only the spinning objects change from one frame to the next, the others keep their matrices
+    frame.transforms = m_sceneHierarchy.Update();
+    frame.worlds = m_sceneHierarchy.GetWorlds();
+    frame.normals = m_sceneHierarchy.GetNormals();
+}
+
 void Game::RenderScene(const GLboolean &toCustomShader, const GLboolean &includeLampsAndSkybox, const GLint &toCustomShaderIndex) {
     const GLboolean useAO = m_currentPPFXMode == PostProcessingEffectMode::SSAO;
-    const GLfloat zfront = -200.0f;
-    const GLfloat zback = 300.0f;
-    m_sphereRotation += m_deltaTime * 0.02f;
+    m_scenePasses++;
+    
+    /// Culling, the light space passes draw what the light sees rather than the camera
+    {
+        glm::vec4 planes[6];
+        if (m_cullFromLight) CCamera::ExtractFrustumPlanes(m_shadowCullMatrix, planes);
+        else m_pCamera->GetFrustumPlanes(planes);
+        m_pFrustumCuller->SetPlanes(planes);
+        m_pTerrainOccluder = nullptr;
+    }
    
     /// Skybox
     {
@@ -255,8 +337,8 @@ void Game::RenderScene(const GLboolean &toCustomShader, const GLboolean &include
         GLint shyboxIndex = includeLampsAndSkybox ? (toCustomShader ? toCustomShaderIndex : 1) : 1;
         CShaderProgram *pSkyBoxProgram = (*m_pShaderPrograms)[shyboxIndex];
         SetMaterialUniform(pSkyBoxProgram, "material");
-        SetFogMaterialUniform(pSkyBoxProgram, "fog", m_fogColor, m_useFog);
-        SetHRDLightUniform(pSkyBoxProgram, "hrdlight", m_exposure, m_gama, m_HDR);
+        SetFogMaterialUniform(pSkyBoxProgram, "fog", m_fogColor);
+        SetHRDLightUniform(pSkyBoxProgram, "hrdlight", m_exposure, m_gama);
         
         if (m_currentPPFXMode == PostProcessingEffectMode::IBL) {
             RenderEnvSkyBox(pSkyBoxProgram);
@@ -273,10 +355,9 @@ void Game::RenderScene(const GLboolean &toCustomShader, const GLboolean &include
     if (isPBR) {
         ///  Physically Based Rendering
         pShaderProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 3];
-        SetCameraUniform(pShaderProgram, "camera", m_pCamera);
         SetMaterialUniform(pShaderProgram, "material", m_materialColor, m_materialShininess, 1.0f, useAO);
         SetPBRMaterialUniform(pShaderProgram, "material", m_albedo, m_metallic, m_roughness, m_ao, m_useIrradiance);
-        SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor, m_useFog);
+        SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
         
         if (m_currentPPFXMode == PostProcessingEffectMode::IBL) {
             GLint irradianceTextureUnit = static_cast<GLint>(TextureType::IRRADIANCEMAP);
@@ -290,21 +371,16 @@ void Game::RenderScene(const GLboolean &toCustomShader, const GLboolean &include
         }
         
         // Render Lights
-        SetLightUniform(pShaderProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
-        SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-        RenderLight(pShaderProgram, m_dirName, m_pointName, m_spotName, m_pCamera);
+        SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama);
         
     } else {
         
         /// Blinn Phong Lighting
         pShaderProgram = (*m_pShaderPrograms)[toCustomShader ? toCustomShaderIndex : 5];
-        SetCameraUniform(pShaderProgram, "camera", m_pCamera);
-        SetLightUniform(pShaderProgram, m_useDir, m_usePoint, m_useSpot, m_useSmoothSpot, m_useBlinn);
         SetMaterialUniform(pShaderProgram, "material", m_materialColor, m_materialShininess, m_uvTiling, useAO);
         SetPBRMaterialUniform(pShaderProgram, "material", m_albedo, m_metallic, m_roughness, m_ao, m_useIrradiance);
-        SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor, m_useFog);
-        SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama, m_HDR);
-        RenderLight(pShaderProgram, m_dirName, m_pointName, m_spotName, m_pCamera);
+        SetFogMaterialUniform(pShaderProgram, "fog", m_fogColor);
+        SetHRDLightUniform(pShaderProgram, m_hdrName, m_exposure, m_gama);
         /*
          // Render Wooden Boxes
          for ( GLuint i = 0; i < m_woodenBoxesPosition.size(); ++i){
@@ -322,14 +398,13 @@ void Game::RenderScene(const GLboolean &toCustomShader, const GLboolean &include
     }
     
     RenderTerrainScene(pShaderProgram, -100.0f);
-    RenderPBRScene(pShaderProgram, toCustomShader, toCustomShaderIndex, zfront, zback);
-    //RenderRandomScene(pShaderProgram, toCustomShader, toCustomShaderIndex, zfront-200, zback+200);
+    RenderPBRScene(pShaderProgram, toCustomShader, toCustomShaderIndex);
+    //RenderRandomScene(pShaderProgram, toCustomShader, toCustomShaderIndex);
     
     /// Render Lamps
     {
         GLint lampsIndex = includeLampsAndSkybox ? (toCustomShader ? toCustomShaderIndex : 4) : 4;
         CShaderProgram *pLampProgram = (*m_pShaderPrograms)[lampsIndex];
-        SetCameraUniform(pLampProgram, "camera", m_pCamera);
         for (auto it = m_pointLights.begin(); it != m_pointLights.end(); ++it) {
             glm::vec3 position = std::get<0>(*it);
             glm::vec4 color = std::get<1>(*it);
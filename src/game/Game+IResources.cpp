@@ -16,6 +16,9 @@ void Game::InitialiseResources()
     m_gameManager = new CGameManager;
     m_pGameTimer = new CHighResolutionTimer;
     m_pCamera = new CCamera;
+    m_pCameraUBO = new CUniformBufferObject;
+    m_pLightsUBO = new CUniformBufferObject;
+    m_pShadowUBO = new CUniformBufferObject;
     m_pShaderPrograms = new std::vector <CShaderProgram *>;
     m_pFtFont = new CFreeTypeFont;
     m_pAudio = new CAudio;
@@ -26,52 +29,20 @@ void Game::InitialiseResources()
     m_pPlanarTerrain = new CPlane;
     m_pHeightmapTerrain = new CHeightMapTerrain;
     
-    m_teapot1 = new CModel;
-    m_teapot2 = new CModel;
-    m_teapot3 = new CModel;
-    m_teapot4 = new CModel;
-    m_teapot5 = new CModel;
-    m_teapot6 = new CModel;
-    m_teapot7 = new CModel;
-    m_teapot8 = new CModel;
-    m_teapot9 = new CModel;
-    m_teapot10 = new CModel;
-    m_teapot15 = new CModel;
-    m_teapot16 = new CModel;
-    m_teapot17 = new CModel;
-    m_teapot19 = new CModel;
     m_trolley = new CModel;
     m_lamborginhi = new CModel;
     
-    m_pSpherePBR1 = new CSphere;
-    m_pSpherePBR2 = new CSphere;
-    m_pSpherePBR3 = new CSphere;
-    m_pSpherePBR4 = new CSphere;
-    m_pSpherePBR5 = new CSphere;
-    m_pSpherePBR6 = new CSphere;
-    m_pSpherePBR7 = new CSphere;
-    m_pSpherePBR8 = new CSphere;
-    m_pSpherePBR9 = new CSphere;
-    m_pSpherePBR10 = new CSphere;
-    m_pSpherePBR11 = new CSphere;
-    m_pSpherePBR12 = new CSphere;
-    m_pSpherePBR13 = new CSphere;
-    m_pSpherePBR14 = new CSphere;
-    m_pSpherePBR15 = new CSphere;
-    m_pSpherePBR16 = new CSphere;
-    m_pSpherePBR17 = new CSphere;
-    m_pSpherePBR18 = new CSphere;
-    m_pSpherePBR19 = new CSphere;
+    m_pSceneStore = new CSceneStore;
+    m_pInstanceBuffer = new CInstanceBuffer;
+    m_pFrustumCuller = new CFrustumCuller;
+    m_pOcclusionCuller = new COcclusionCuller;
+    m_pOcclusionTexture = new CTexture;
+    m_pIndirectCuller = new CIndirectCuller;
     
-    m_pCube12 = new CCube(1.0f);
-    m_pCube13 = new CCube(1.0f);
-    m_pCube14 = new CCube(1.0f);
     m_pInteriorBox = new CCube(10.0f);
     m_pWoodenBox = new CCube(1.0f);
     m_pLamp = new CCube(1.0f);
     
-    m_pTorus = new CTorus;
-    m_pTorusKnot = new CTorusKnot;
     m_pMetaballs = new CMetaballs;
 }
 
@@ -138,269 +109,31 @@ void Game::LoadResources(const std::string &path)
     // https://www.textures.com/browse/pbr-materials/114558
     // https://3dtextures.me/
     // https://freepbr.com/
-    m_pSpherePBR1->Create(path+"/textures/pbr/gold/",
-                          {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                              { "metallic.png",  TextureType::METALNESS },           // metallic map
-                              { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                              { "normal.png", TextureType::NORMAL},          // normalMap 3
-                              { "ao.png",   TextureType::AO },                          // aoMap 4
-                              { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                              { "diffuse.png",   TextureType::DIFFUSE},
-                              { "specular.png",   TextureType::SPECULAR}
-                          }, 50, 50);
-    m_teapot1->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/gold/",
-                      {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                          { "metallic.png",  TextureType::METALNESS },           // metallic map
-                          { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.png", TextureType::NORMAL},          // normalMap 3
-                          { "ao.png",   TextureType::AO },                          // aoMap 4
-                          { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.png",   TextureType::DIFFUSE},
-                          { "specular.png",   TextureType::SPECULAR}
-                      });
-    
-    m_pSpherePBR2->Create(path+"/textures/pbr/copper/",
-                          {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                              { "metallic.png",  TextureType::METALNESS },           // metallic map
-                              { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                              { "normal.png", TextureType::NORMAL},          // normalMap 3
-                              { "ao.png",   TextureType::AO },                          // aoMap 4
-                              { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                              { "diffuse.png",   TextureType::DIFFUSE},
-                              { "specular.png",   TextureType::SPECULAR}
-                          }, 50, 50);
-    m_teapot2->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/copper/",
-                      {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                          { "metallic.png",  TextureType::METALNESS },           // metallic map
-                          { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.png", TextureType::NORMAL},          // normalMap 3
-                          { "ao.png",   TextureType::AO },                          // aoMap 4
-                          { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.png",   TextureType::DIFFUSE},
-                          { "specular.png",   TextureType::SPECULAR}
-                      });
-    
-    m_pSpherePBR3->Create(path+"/textures/pbr/plastic/",
-                          {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                              { "metallic.png",  TextureType::METALNESS },           // metallic map
-                              { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                              { "normal.png", TextureType::NORMAL},          // normalMap 3
-                              { "ao.png",   TextureType::AO },                          // aoMap 4
-                              { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                              { "diffuse.png",   TextureType::DIFFUSE},
-                              { "specular.png",   TextureType::SPECULAR}
-                          }, 50, 50);
-    m_teapot3->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/plastic/",
-                      {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                          { "metallic.png",  TextureType::METALNESS },           // metallic map
-                          { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.png", TextureType::NORMAL},          // normalMap 3
-                          { "ao.png",   TextureType::AO },                          // aoMap 4
-                          { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.png",   TextureType::DIFFUSE},
-                          { "specular.png",   TextureType::SPECULAR}
-                      });
-    
-    m_pSpherePBR4->Create(path+"/textures/pbr/granite/",
-                          {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                              { "metallic.png",  TextureType::METALNESS },           // metallic map
-                              { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                              { "normal.png", TextureType::NORMAL},          // normalMap 3
-                              { "ao.png",   TextureType::AO },                          // aoMap 4
-                              { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                              { "diffuse.png",   TextureType::DIFFUSE},
-                              { "specular.png",   TextureType::SPECULAR}
-                          }, 50, 50);
-    m_teapot4->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/granite/",
-                      {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                          { "metallic.png",  TextureType::METALNESS },           // metallic map
-                          { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.png", TextureType::NORMAL},          // normalMap 3
-                          { "ao.png",   TextureType::AO },                          // aoMap 4
-                          { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.png",   TextureType::DIFFUSE},
-                          { "specular.png",   TextureType::SPECULAR}
-                      });
- 
-    m_pSpherePBR5->Create(path+"/textures/pbr/marble/",
-                          {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                              { "metallic.png",  TextureType::METALNESS },           // metallic map
-                              { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                              { "normal.png", TextureType::NORMAL},          // normalMap 3
-                              { "ao.png",   TextureType::AO },                          // aoMap 4
-                              { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                              { "diffuse.png",   TextureType::DIFFUSE},
-                              { "specular.png",   TextureType::SPECULAR}
-                          }, 50, 50);
-    m_teapot5->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/marble/",
-                      {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                          { "metallic.png",  TextureType::METALNESS },           // metallic map
-                          { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.png", TextureType::NORMAL},          // normalMap 3
-                          { "ao.png",   TextureType::AO },                          // aoMap 4
-                          { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.png",   TextureType::DIFFUSE},
-                          { "specular.png",   TextureType::SPECULAR}
-                      });
-    
-    m_pSpherePBR6->Create(path+"/textures/pbr/aluminum/",
-                          {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                              { "metallic.png",  TextureType::METALNESS },           // metallic map
-                              { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                              { "normal.png", TextureType::NORMAL},          // normalMap 3
-                              { "ao.png",   TextureType::AO },                          // aoMap 4
-                              { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                              { "diffuse.png",   TextureType::DIFFUSE},
-                              { "specular.png",   TextureType::SPECULAR}
-                          }, 50, 50);
-    m_teapot6->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/aluminum/",
-                      {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                          { "metallic.png",  TextureType::METALNESS },           // metallic map
-                          { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.png", TextureType::NORMAL},          // normalMap 3
-                          { "ao.png",   TextureType::AO },                          // aoMap 4
-                          { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.png",   TextureType::DIFFUSE},
-                          { "specular.png",   TextureType::SPECULAR}
-                      });
-    
-    m_pSpherePBR7->Create(path+"/textures/pbr/metal/",
-                          {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                              { "metallic.png",  TextureType::METALNESS },           // metallic map
-                              { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                              { "normal.png", TextureType::NORMAL},          // normalMap 3
-                              { "ao.png",   TextureType::AO },                          // aoMap 4
-                              { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                              { "diffuse.png",   TextureType::DIFFUSE},
-                              { "specular.png",   TextureType::SPECULAR}
-                          }, 50, 50);
-    m_teapot7->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/metal/",
-                      {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                          { "metallic.png",  TextureType::METALNESS },           // metallic map
-                          { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.png", TextureType::NORMAL},          // normalMap 3
-                          { "ao.png",   TextureType::AO },                          // aoMap 4
-                          { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.png",   TextureType::DIFFUSE},
-                          { "specular.png",   TextureType::SPECULAR}
-                      });
-    
-    m_pSpherePBR8->Create(path+"/textures/pbr/iron/",
-                          {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                              { "metallic.png",  TextureType::METALNESS },           // metallic map
-                              { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                              { "normal.png", TextureType::NORMAL},          // normalMap 3
-                              { "ao.png",   TextureType::AO },                          // aoMap 4
-                              { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                              { "diffuse.png",   TextureType::DIFFUSE},
-                              { "specular.png",   TextureType::SPECULAR}
-                          }, 50, 50);
-    m_teapot8->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/iron/",
-                      {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                          { "metallic.png",  TextureType::METALNESS },           // metallic map
-                          { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.png", TextureType::NORMAL},          // normalMap 3
-                          { "ao.png",   TextureType::AO },                          // aoMap 4
-                          { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.png",   TextureType::DIFFUSE},
-                          { "specular.png",   TextureType::SPECULAR}
-                      });
-    
-    m_pSpherePBR9->Create(path+"/textures/pbr/blackmarble/",
-                           {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                               { "metallic.png",  TextureType::METALNESS },           // metallic map
-                               { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                               { "normal.png", TextureType::NORMAL},          // normalMap 3
-                               { "ao.png",   TextureType::AO },                          // aoMap 4
-                               { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                               { "diffuse.png",   TextureType::DIFFUSE},
-                               { "specular.png",   TextureType::SPECULAR}
-                           }, 50, 50);
-    m_teapot9->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/blackmarble/",
-                      {   { "albedo.png", TextureType::ALBEDO },           // albedo map
-                          { "metallic.png",  TextureType::METALNESS },           // metallic map
-                          { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.png", TextureType::NORMAL},          // normalMap 3
-                          { "ao.png",   TextureType::AO },                          // aoMap 4
-                          { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.png",   TextureType::DIFFUSE},
-                          { "specular.png",   TextureType::SPECULAR}
-                      });
-  
-    m_pSpherePBR10->Create(path+"/textures/pbr/rustedmetal/",
-                           {   { "albedo.jpg", TextureType::ALBEDO },           // albedo map
-                               { "metallic.jpg",  TextureType::METALNESS },           // metallic map
-                               { "roughness.jpg",   TextureType::ROUGHNESS},         // roughness map
-                               { "normal.jpg", TextureType::NORMAL},          // normalMap 3
-                               { "ao.jpg",   TextureType::AO },                          // aoMap 4
-                               { "ambient.jpg", TextureType::AMBIENT },            // ambientMap 0
-                               { "diffuse.jpg",   TextureType::DIFFUSE},
-                               { "specular.jpg",   TextureType::SPECULAR}
-                           }, 50, 50);
-    m_teapot10->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/rustedmetal/",
-                       {   { "albedo.jpg", TextureType::ALBEDO },           // albedo map
-                           { "metallic.jpg",  TextureType::METALNESS },           // metallic map
-                           { "roughness.jpg",   TextureType::ROUGHNESS},         // roughness map
-                           { "normal.jpg", TextureType::NORMAL},          // normalMap 3
-                           { "ao.jpg",   TextureType::AO },                          // aoMap 4
-                           { "ambient.jpg", TextureType::AMBIENT },            // ambientMap 0
-                           { "diffuse.jpg",   TextureType::DIFFUSE},
-                           { "specular.jpg",   TextureType::SPECULAR}
-                      });
-  
-    
-    m_pSpherePBR11->Create(path+"/textures/pbr/circleplate/",
-                           {
-                               { "albedo.png", TextureType::ALBEDO },           // albedo map
-                               { "metallic.png",  TextureType::METALNESS },           // metallic map
-                               { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                               { "normal.png", TextureType::NORMAL},          // normalMap 3
-                               { "ao.png",   TextureType::AO },                          // aoMap 4
-                               { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                               { "diffuse.png",   TextureType::DIFFUSE},
-                               { "specular.png",   TextureType::SPECULAR},
-                               { "bump.png", TextureType::DISPLACEMENT},
-                           }, 50, 50);
-    m_pTorus->Create(path+"/textures/pbr/circleplate/",
-                     {
-                         { "albedo.png", TextureType::ALBEDO },           // albedo map
-                         { "metallic.png",  TextureType::METALNESS },           // metallic map
-                         { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                         { "normal.png", TextureType::NORMAL},          // normalMap 3
-                         { "ao.png",   TextureType::AO },                          // aoMap 4
-                         { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                         { "diffuse.png",   TextureType::DIFFUSE},
-                         { "specular.png",   TextureType::SPECULAR},
-                         { "bump.png", TextureType::DISPLACEMENT},
-                    }, 50, 50, 2.0f, 1.0f);
-    m_pTorusKnot->Create(path+"/textures/pbr/circleplate/",
-                         {
-                             { "albedo.png", TextureType::ALBEDO },           // albedo map
-                             { "metallic.png",  TextureType::METALNESS },           // metallic map
-                             { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                             { "normal.png", TextureType::NORMAL},          // normalMap 3
-                             { "ao.png",   TextureType::AO },                          // aoMap 4
-                             { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                             { "diffuse.png",   TextureType::DIFFUSE},
-                             { "specular.png",   TextureType::SPECULAR},
-                             { "bump.png", TextureType::DISPLACEMENT}
-                         },
-                         1024,         // in: Number of steps in the torus knot
-                         32,           // in: Number of facets
-                         20.0f,        // in: Scale of the knot
-                         0.1f,         // in: Thickness of the knot
-                         0.0f,         // in: Number of clumps in the knot
-                         0.0f,         // in: Offset of the clump (in 0..2pi)
-                         0.0f,         // in: Scale of a clump
-                         2.0f,         // in: U coordinate scale
-                         32.0f,        // in: V coordinate scale
-                         7.0f,         // in: P parameter of the knot
-                         -2.0f         // in: Q parameter of the knot
-                         );
     
+    // the spheres, teapots and other scene objects are described in resources/scenes
+    // a scene file that does not parse would leave the store partly filled
+    CSceneLoader sceneLoader;
+    if (!sceneLoader.Load(path+"/scenes/default.scene", path, static_cast<GLuint>(m_pShaderPrograms->size()), *m_pSceneStore))
+        throw std::runtime_error("Scene file could not be loaded: " + path + "/scenes/default.scene");
+    m_pInstanceBuffer->Create();
+    
+    // the meshes the batches of the GPU driven path draw from, the batches are made when a layer is first drawn
+    if (m_indirectSupported) {
+        std::vector<IGameObject*> meshes;
+        for (GLuint i = 0; i < m_pSceneStore->GetMeshCount(); ++i) meshes.push_back(m_pSceneStore->GetMesh(i).pObject);
+        m_pIndirectCuller->Create(meshes);
+        printf("GPU driven scene: %d meshes draw from the geometry arena\n", m_pIndirectCuller->GetMeshCount());
+    }
+    
+    // the occlusion buffer is shown with the hud program, which reads the red channel of the depth map
+    m_occlusionImage.assign(m_pOcclusionCuller->GetWidth() * m_pOcclusionCuller->GetHeight(), 0);
+    m_pOcclusionTexture->CreateFromData(&m_occlusionImage[0], m_pOcclusionCuller->GetWidth(), m_pOcclusionCuller->GetHeight(),
+                                        8, GL_RED, TextureType::DEPTH, false);
+    m_pOcclusionTexture->SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    m_pOcclusionTexture->SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    m_pOcclusionTexture->SetSamplerObjectParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    m_pOcclusionTexture->SetSamplerObjectParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     
-    m_pSpherePBR12->Create("", {}, 50, 50);
-    m_pCube12->Create("", { });
     m_pMetaballs->Create(100.0f, 10, 0, 32, path+"/textures/pbr/metalpainted/",
                          {   { "albedo.jpg", TextureType::ALBEDO },           // albedo map
                              { "metallic.jpg",  TextureType::METALNESS },           // metallic map
@@ -415,127 +148,8 @@ void Game::LoadResources(const std::string &path)
                              CMarchingCubes::BuildTables();
                          }
     
-    
-    m_pSpherePBR13->Create(path+"/textures/pbr/brick/",
-                           {
-                               { "albedo.jpg", TextureType::ALBEDO },           // albedo map
-                               { "metallic.jpg",  TextureType::METALNESS },           // metallic map
-                               { "roughness.jpg",   TextureType::ROUGHNESS},         // roughness map
-                               { "normal.jpg", TextureType::NORMAL},          // normalMap 3
-                               { "ao.jpg",   TextureType::AO },                          // aoMap 4
-                               { "ambient.jpg", TextureType::AMBIENT },            // ambientMap 0
-                               { "diffuse.jpg",   TextureType::DIFFUSE},
-                               { "specular.jpg",   TextureType::SPECULAR},
-                               { "bump.jpg", TextureType::DISPLACEMENT},
-                               { "height.jpg", TextureType::HEIGHT }
-                           }, 50, 50);
-    m_pCube13->Create(path+"/textures/pbr/brick/",
-                     {
-                         { "albedo.jpg", TextureType::ALBEDO },           // albedo map
-                         { "metallic.jpg",  TextureType::METALNESS },           // metallic map
-                         { "roughness.jpg",   TextureType::ROUGHNESS},         // roughness map
-                         { "normal.jpg", TextureType::NORMAL},          // normalMap 3
-                         { "ao.jpg",   TextureType::AO },                          // aoMap 4
-                         { "ambient.jpg", TextureType::AMBIENT },            // ambientMap 0
-                         { "diffuse.jpg",   TextureType::DIFFUSE},
-                         { "specular.jpg",   TextureType::SPECULAR},
-                         { "bump.jpg", TextureType::DISPLACEMENT},
-                         { "height.jpg", TextureType::HEIGHT }
-                     });
-
-    
-    m_pSpherePBR14->Create(path+"/textures/",
-                           {   { "clean-gray-paper.png", TextureType::DIFFUSE},
-                               { "moon_surface.jpg", TextureType::GLOSSINESS},
-                           }, 50, 50);
-    m_pCube14->Create(path+"/textures/",
-                           {   { "clean-gray-paper.png", TextureType::DIFFUSE},
-                               { "moon_surface.jpg", TextureType::GLOSSINESS},
-                           });
-    
-    
-    m_pSpherePBR15->Create(path+"/textures/pbr/dirtpile/",
-                          {
-                              { "albedo.jpg", TextureType::ALBEDO },           // albedo map
-                              { "metallic.jpg",  TextureType::METALNESS },           // metallic map
-                              { "roughness.jpg",   TextureType::ROUGHNESS},         // roughness map
-                              { "normal.jpg", TextureType::NORMAL},          // normalMap 3
-                              { "ao.jpg",   TextureType::AO },                          // aoMap 4
-                              { "ambient.jpg", TextureType::AMBIENT },            // ambientMap 0
-                              { "diffuse.jpg",   TextureType::DIFFUSE},
-                              { "specular.jpg",   TextureType::SPECULAR},
-                              { "moss.png", TextureType::DISPLACEMENT }
-                          }, 50, 50);
-    m_teapot15->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/dirtpile/",
-                      {
-                          { "albedo.jpg", TextureType::ALBEDO },           // albedo map
-                          { "metallic.jpg",  TextureType::METALNESS },           // metallic map
-                          { "roughness.jpg",   TextureType::ROUGHNESS},         // roughness map
-                          { "normal.jpg", TextureType::NORMAL},          // normalMap 3
-                          { "ao.jpg",   TextureType::AO },                          // aoMap 4
-                          { "ambient.jpg", TextureType::AMBIENT },            // ambientMap 0
-                          { "diffuse.jpg",   TextureType::DIFFUSE},
-                          { "specular.jpg",   TextureType::SPECULAR},
-                          { "moss.png", TextureType::DISPLACEMENT }
-                      });
-    
-    m_pSpherePBR16->Create(path+"/textures/pbr/metalpainted/",
-                           {   { "albedo.jpg", TextureType::ALBEDO},              // albedo map
-                               { "ambient.jpg", TextureType::AMBIENT },            // ambientMap 0
-                               { "diffuse.jpg", TextureType::DIFFUSE},
-                               { "metallic.jpg",  TextureType::METALNESS },           // metallic map
-                               { "roughness.jpg",   TextureType::ROUGHNESS},         // roughness map
-                               { "normal.jpg", TextureType::NORMAL},                  // normalMap 3
-                               { "ao.jpg",   TextureType::AO },           // aoMap 4
-                               { "specular.jpg",   TextureType::SPECULAR }
-                           }, 50, 50);
-    m_teapot16->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/metalpainted/",
-                       {   { "albedo.jpg", TextureType::ALBEDO},              // albedo map
-                           { "ambient.jpg", TextureType::AMBIENT },            // ambientMap 0
-                           { "diffuse.jpg", TextureType::DIFFUSE},
-                           { "metallic.jpg",  TextureType::METALNESS },           // metallic map
-                           { "roughness.jpg",   TextureType::ROUGHNESS},         // roughness map
-                           { "normal.jpg", TextureType::NORMAL},                  // normalMap 3
-                           { "ao.jpg",   TextureType::AO },           // aoMap 4
-                           { "specular.jpg",   TextureType::SPECULAR }
-                       });
-    
-    
-    m_pSpherePBR17->Create(path+"/textures/", {}, 50, 50);
-    m_teapot17->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/", {});
-    
-    
-    m_pSpherePBR18->Create(path+"/textures/pbr/fireball/",
-                           {
-                               { "explosion.png", TextureType::DISPLACEMENT }
-                           }, 50, 50);
-    
-    
-    
-    m_pSpherePBR19->Create(path+"/textures/pbr/diamondplate/",
-    {
-        { "albedo.png", TextureType::ALBEDO },           // albedo map
-        { "metallic.png",  TextureType::METALNESS },           // metallic map
-        { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-        { "normal.png", TextureType::NORMAL},          // normalMap 3
-        { "ao.png",   TextureType::AO },                          // aoMap 4
-        { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-        { "diffuse.png",   TextureType::DIFFUSE},
-        { "specular.png",   TextureType::SPECULAR},
-        { "bump.png", TextureType::DISPLACEMENT}
-    }, 50, 50);
-    m_teapot19->Create(path+"/models/teapot/utah-teapot.obj", path+"/textures/pbr/diamondplate/",
-                       {
-                           { "albedo.png", TextureType::ALBEDO },           // albedo map
-                           { "metallic.png",  TextureType::METALNESS },           // metallic map
-                           { "roughness.png",   TextureType::ROUGHNESS},         // roughness map
-                           { "normal.png", TextureType::NORMAL},          // normalMap 3
-                           { "ao.png",   TextureType::AO },                          // aoMap 4
-                           { "ambient.png", TextureType::AMBIENT },            // ambientMap 0
-                           { "diffuse.png",   TextureType::DIFFUSE},
-                           { "specular.png",   TextureType::SPECULAR},
-                           { "bump.png", TextureType::DISPLACEMENT}
-                       });
+    // the scene objects and the metaballs are all loaded, frames can be simulated from here on
+    m_scenePipeline.Create([this](SceneFrame &frame) { SimulateScene(frame); });
     
     
     m_trolley->Create(path+"/models/trolley/Industrial_Trolley.obj", path+"/models/trolley/",
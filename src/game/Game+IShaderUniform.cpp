@@ -9,9 +9,8 @@
 #include "Game.h"
 
 /// Shaders Uniforms
-void Game::SetTerrainUniform(CShaderProgram *pShaderProgram, const GLboolean &useHeightMap) {
+void Game::SetTerrainUniform(CShaderProgram *pShaderProgram) {
     pShaderProgram->UseProgram();
-    pShaderProgram->SetUniform("bUseHeightMap", useHeightMap);
     pShaderProgram->SetUniform("fMinHeight", m_heightMapMinHeight);
     pShaderProgram->SetUniform("fMaxHeight", m_heightMapMaxHeight);
     
@@ -353,6 +352,18 @@ void Game::SetVignettingUniform(CShaderProgram *pShaderProgram){
     pShaderProgram->SetUniform("coverage", m_coverage); // between 0 and 1
 }
 
+// the fused effects share one program, their uniforms carry the effect name
+void Game::SetPostProcessingStackUniform(CShaderProgram *pShaderProgram){
+    pShaderProgram->UseProgram();
+    pShaderProgram->SetUniform("posterizationGamma", m_posterizationGama);
+    pShaderProgram->SetUniform("posterizationColors", m_posterizationColors);
+    pShaderProgram->SetUniform("vignettingTint", m_vignettingTint);
+    pShaderProgram->SetUniform("vignettingSepia", m_vignettingSepia);
+    pShaderProgram->SetUniform("vignettingRadius", m_vignettingRadius);
+    pShaderProgram->SetUniform("vignettingSoftness", m_vignettingSoftness);
+    pShaderProgram->SetUniform("coverage", m_coverage); // between 0 and 1
+}
+
 void Game::SetBrightPartsUniform(CShaderProgram *pShaderProgram){
     pShaderProgram->UseProgram();
     pShaderProgram->SetUniform("bSmoothGradient", m_brightPartsSmoothGradient);
@@ -364,14 +375,52 @@ void Game::SetBloomUniform(CShaderProgram *pShaderProgram){
     pShaderProgram->UseProgram();
     pShaderProgram->SetUniform("coverage", m_coverage); // between 0 and 1
     // HDR Light
-    SetHRDLightUniform(pShaderProgram, "hrdlight", m_exposure, m_gama, m_HDR);
+    SetHRDLightUniform(pShaderProgram, "hrdlight", m_exposure, m_gama);
+}
+
+void Game::SetBloomDownsampleUniform(CShaderProgram *pShaderProgram, const GLboolean &firstLevel){
+    pShaderProgram->UseProgram();
+    pShaderProgram->SetUniform("bFirstLevel", firstLevel);
+}
+
+void Game::SetBloomUpsampleUniform(CShaderProgram *pShaderProgram, const glm::vec2 &filterRadius){
+    pShaderProgram->UseProgram();
+    pShaderProgram->SetUniform("filterRadius", filterRadius); // one texel of the smaller level
+    pShaderProgram->SetUniform("weight", 0.5f);
+}
+
+void Game::SetConvolutionUniform(CShaderProgram *pShaderProgram, const PostProcessingEffectMode &mode,
+                                 const glm::vec2 &direction, const GLboolean &final){
+    // the kernels of the fragment shaders step 1/300 of the screen, in whole texels here
+    glm::vec2 kernelSpacing = glm::clamp(glm::round(glm::vec2(m_gameWindow->GetWidth(), m_gameWindow->GetHeight()) / 300.0f), 1.0f, 12.0f);
+    
+    GLint filterType = 0, radius = 1;
+    glm::vec2 spacing = glm::vec2(1.0f);
+    switch(mode) {
+        case PostProcessingEffectMode::Kernel: filterType = 0; spacing = kernelSpacing; break;
+        case PostProcessingEffectMode::KernelBlur: filterType = 1; spacing = kernelSpacing; break;
+        case PostProcessingEffectMode::SobelEdgeDetection: filterType = 2; break;
+        case PostProcessingEffectMode::FreiChenEdgeDetection: filterType = 3; break;
+        case PostProcessingEffectMode::Blur: filterType = 4; radius = 3; break;
+        default: break;
+    }
+    
+    pShaderProgram->UseProgram();
+    pShaderProgram->SetUniform("filterType", filterType);
+    pShaderProgram->SetUniform("radius", radius);
+    pShaderProgram->SetUniform("spacing", spacing);
+    pShaderProgram->SetUniform("direction", direction);
+    pShaderProgram->SetUniform("bFinal", final);
+    pShaderProgram->SetUniform("coverage", m_coverage); // between 0 and 1
+    pShaderProgram->SetUniform("guiColor", m_guiColor);
+    pShaderProgram->SetUniform("blurColor", glm::vec4(1.0f));
 }
 
 void Game::SetHRDToneMappingUniform(CShaderProgram *pShaderProgram){
     pShaderProgram->UseProgram();
     pShaderProgram->SetUniform("coverage", m_coverage); // between 0 and 1
     // HDR Light
-    SetHRDLightUniform(pShaderProgram, "hrdlight", m_exposure, m_gama, m_HDR);
+    SetHRDLightUniform(pShaderProgram, "hrdlight", m_exposure, m_gama);
 }
 
 void Game::SetLensFlareGhostUniform(CShaderProgram *pShaderProgram){
@@ -451,20 +500,27 @@ void Game::SetDeferredRenderingUniform(CShaderProgram *pShaderProgram) {
     pShaderProgram->SetUniform("coverage", m_coverage); // between 0 and 1
 }
 
-void Game::SetScreenSpaceAmbientOcclusionUniform(CShaderProgram *pShaderProgram) {
+void Game::SetScreenSpaceAmbientOcclusionUniform(CShaderProgram *pShaderProgram, const glm::vec2 &size,
+                                                 const GLuint &samples, const GLuint &frame) {
     m_textures[7]->BindCustomTexture2DToTextureType();        // bind SSAO noise texture
 
     pShaderProgram->UseProgram();
     pShaderProgram->SetUniform("projection", *m_pCamera->GetPerspectiveProjectionMatrix());
     pShaderProgram->SetUniform("radius", m_ssaoRadius);
     pShaderProgram->SetUniform("bias", m_ssaoBias);
-    pShaderProgram->SetUniform("width", (float)m_gameWindow->GetWidth());
-    pShaderProgram->SetUniform("height", (float)m_gameWindow->GetHeight());
+    pShaderProgram->SetUniform("width", size.x);
+    pShaderProgram->SetUniform("height", size.y);
     pShaderProgram->SetUniform("noiseSize", m_ssaoNoiseSize);
     
-    // Send kernel + rotation
+    // the samples are every n-th of the kernel, every frame starts one further along and moves the noise,
+    // so the temporal tiers have taken the whole kernel after n frames, frame 0 starts at the first sample
+    pShaderProgram->SetUniform("sampleCount", static_cast<GLint>(samples));
+    pShaderProgram->SetUniform("sampleOffset", static_cast<GLint>(frame % std::max(m_ssaoKernelSamples / samples, 1u)));
+    pShaderProgram->SetUniform("noiseOffset", glm::vec2(frame % 4, (frame / 4) % 4));
+    
+    // Send kernel + rotation, the samples only reach the driver when the kernel changes
     for (GLuint i = 0; i < m_ssaoKernelSamples; ++i) {
-        pShaderProgram->SetUniform("samples[" + std::to_string(i) + "]", m_ssaoKernel[i]);
+        pShaderProgram->SetUniform(CUniformName("samples", i), m_ssaoKernel[i]);
     }
 }
 
@@ -473,6 +529,25 @@ void Game::SetScreenSpaceAmbientOcclusionBlurUniform(CShaderProgram *pShaderProg
     pShaderProgram->SetUniform("noiseSize", m_ssaoNoiseSize);
 }
 
+void Game::SetScreenSpaceAmbientOcclusionDownsampleUniform(CShaderProgram *pShaderProgram, const GLint &footprint) {
+    pShaderProgram->UseProgram();
+    pShaderProgram->SetUniform("footprint", footprint);
+}
+
+void Game::SetScreenSpaceAmbientOcclusionTemporalUniform(CShaderProgram *pShaderProgram, const GLuint &samples) {
+    glm::mat4 view = m_pCamera->GetViewMatrix();
+    
+    pShaderProgram->UseProgram();
+    pShaderProgram->SetUniform("projection", *m_pCamera->GetPerspectiveProjectionMatrix());
+    pShaderProgram->SetUniform("viewToPreviousView", m_ssaoPreviousView * glm::inverse(view));
+    pShaderProgram->SetUniform("blend", std::max(samples / static_cast<GLfloat>(m_ssaoKernelSamples), 0.1f)); // the whole kernel is seen over this many frames
+    pShaderProgram->SetUniform("bReset", !m_ssaoHistoryValid);
+}
+
+void Game::SetScreenSpaceAmbientOcclusionUpsampleUniform(CShaderProgram *pShaderProgram) {
+    pShaderProgram->UseProgram();
+}
+
 void Game::SetScreenSpaceAmbientOcclusionLightingUniform(CShaderProgram *pShaderProgram) {
     pShaderProgram->UseProgram();
     pShaderProgram->SetUniform("bUseLight", m_ssaoNoiseUseLight);
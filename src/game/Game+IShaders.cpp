@@ -7,9 +7,21 @@
 //
 
 #include "Game.h"
+#include "../shaders/ShaderCache.h"
+#include "../shaders/ShaderPreprocessor.h"
+#include "../shaders/ShaderPrewarmer.h"
+#include "../utilities/ShaderFeature.h"
 
 void Game::LoadShaderPrograms(const std::string &path) {
     
+    CHighResolutionTimer timer;
+    timer.Start();
+    
+    // linked programs are kept on disk, only changed shaders get compiled
+    CShaderCache &cache = CShaderCache::Instance();
+    cache.Initialise(path+"/shaders/cache");
+    m_shaderPath = path+"/shaders/";
+    
     // Load shaders
     std::vector<CShader> shShaders;
     std::vector<std::string> sShaderFileNames;
@@ -192,6 +204,20 @@ void Game::LoadShaderPrograms(const std::string &path) {
     sShaderFileNames.push_back("OmnidirectionalShadowDepthShader.frag");
     sShaderFileNames.push_back("OmnidirectionalShadowMappingShader.vert");// 86
     sShaderFileNames.push_back("OmnidirectionalShadowMappingShader.frag");
+    sShaderFileNames.push_back("BloomDownsampleShader.vert");// 87
+    sShaderFileNames.push_back("BloomDownsampleShader.frag");
+    sShaderFileNames.push_back("BloomUpsampleShader.vert");// 88
+    sShaderFileNames.push_back("BloomUpsampleShader.frag");
+    sShaderFileNames.push_back("ScreenSpaceAmbientOcclusionDownsampleShader.vert");// 90
+    sShaderFileNames.push_back("ScreenSpaceAmbientOcclusionDownsampleShader.frag");
+    sShaderFileNames.push_back("ScreenSpaceAmbientOcclusionTemporalShader.vert");// 91
+    sShaderFileNames.push_back("ScreenSpaceAmbientOcclusionTemporalShader.frag");
+    sShaderFileNames.push_back("ScreenSpaceAmbientOcclusionUpsampleShader.vert");// 92
+    sShaderFileNames.push_back("ScreenSpaceAmbientOcclusionUpsampleShader.frag");
+    // compute shaders need GL 4.3, without them the convolution effects keep their fragment shaders,
+    // the file is loaded last so the indices of the others do not depend on it
+    if (m_ppfxCompute)
+        sShaderFileNames.push_back("ConvolutionShader.comp");// 89
     
     
     for (int i = 0; i < (int) sShaderFileNames.size(); i++) {
@@ -201,6 +227,7 @@ void Game::LoadShaderPrograms(const std::string &path) {
         else if (sExt == "frag") iShaderType = GL_FRAGMENT_SHADER;
         else if (sExt == "geom") iShaderType = GL_GEOMETRY_SHADER;
         else if (sExt == "tcnl") iShaderType = GL_TESS_CONTROL_SHADER;
+        else if (sExt == "comp") iShaderType = GL_COMPUTE_SHADER;
         else iShaderType = GL_TESS_EVALUATION_SHADER;
         
         CShader shader;
@@ -209,6 +236,18 @@ void Game::LoadShaderPrograms(const std::string &path) {
         shShaders.push_back(shader);
     }
     
+    // instanced variants of the PBR and Blinn Phong vertex shaders, they read the model and normal matrix per instance
+    CShader shPBRInstanced, shLightInstanced;
+    shPBRInstanced.LoadShader(path+"/shaders/PhysicallyBasedRenderingShader.vert", GL_VERTEX_SHADER, {"INSTANCED"});
+    shLightInstanced.LoadShader(path+"/shaders/LightShader.vert", GL_VERTEX_SHADER, {"INSTANCED"});
+    
+    // scene objects are culled on the GPU and drawn with multi draw indirect where the context is GL 4.3
+    m_indirectSupported = CIndirectCuller::IsSupported();
+    printf("Scene object culling: %s\n", m_indirectSupported ? "compute shader and multi draw indirect" : "CPU");
+    CShader shSceneCull;
+    if (m_indirectSupported)
+        shSceneCull.LoadShader(path+"/shaders/SceneCullShader.comp", GL_COMPUTE_SHADER);
+    
     // Create a shader program for fonts
     CShaderProgram *pFontProgram = new CShaderProgram;
     pFontProgram->CreateProgram();
@@ -340,308 +379,271 @@ void Game::LoadShaderPrograms(const std::string &path) {
     pImageProcessingShader->LinkProgram();
     m_pShaderPrograms->push_back(pImageProcessingShader);
     
+    // Effect programs only keep their shader files here, they are built on first use or by the prewarmer
     // Create the Color Inversion shader program
     CShaderProgram *pColorInversionShader = new CShaderProgram;
-    pColorInversionShader->CreateProgram();
     pColorInversionShader->AddShaderToProgram(&shShaders[35]);
     pColorInversionShader->AddShaderToProgram(&shShaders[36]);
-    pColorInversionShader->LinkProgram();
+    pColorInversionShader->DeferLink();
     m_pShaderPrograms->push_back(pColorInversionShader);
     
     // Create the Gray Scale shader program
     CShaderProgram *pGrayScaleShader = new CShaderProgram;
-    pGrayScaleShader->CreateProgram();
     pGrayScaleShader->AddShaderToProgram(&shShaders[37]);
     pGrayScaleShader->AddShaderToProgram(&shShaders[38]);
-    pGrayScaleShader->LinkProgram();
+    pGrayScaleShader->DeferLink();
     m_pShaderPrograms->push_back(pGrayScaleShader);
     
     // Create the Kernel Shader shader program
     CShaderProgram *pKernelShader = new CShaderProgram;
-    pKernelShader->CreateProgram();
     pKernelShader->AddShaderToProgram(&shShaders[39]);
     pKernelShader->AddShaderToProgram(&shShaders[40]);
-    pKernelShader->LinkProgram();
+    pKernelShader->DeferLink();
     m_pShaderPrograms->push_back(pKernelShader);
     
     // Create the Kernel Blur Shader shader program
     CShaderProgram *pKernelBlurShader = new CShaderProgram;
-    pKernelBlurShader->CreateProgram();
     pKernelBlurShader->AddShaderToProgram(&shShaders[41]);
     pKernelBlurShader->AddShaderToProgram(&shShaders[42]);
-    pKernelBlurShader->LinkProgram();
+    pKernelBlurShader->DeferLink();
     m_pShaderPrograms->push_back(pKernelBlurShader);
     
     // Create the Edge Detection Shader shader program
     CShaderProgram *pEdgeDetectionShader = new CShaderProgram;
-    pEdgeDetectionShader->CreateProgram();
     pEdgeDetectionShader->AddShaderToProgram(&shShaders[43]);
     pEdgeDetectionShader->AddShaderToProgram(&shShaders[44]);
-    pEdgeDetectionShader->LinkProgram();
+    pEdgeDetectionShader->DeferLink();
     m_pShaderPrograms->push_back(pEdgeDetectionShader);
     
     // Create the Sobel Edge Detection Shader shader program
     CShaderProgram *pSobelEdgeDetectionShader = new CShaderProgram;
-    pSobelEdgeDetectionShader->CreateProgram();
     pSobelEdgeDetectionShader->AddShaderToProgram(&shShaders[45]);
     pSobelEdgeDetectionShader->AddShaderToProgram(&shShaders[46]);
-    pSobelEdgeDetectionShader->LinkProgram();
+    pSobelEdgeDetectionShader->DeferLink();
     m_pShaderPrograms->push_back(pSobelEdgeDetectionShader);
     
     // Create the Frei-Chen Edge Detection Shader shader program
     CShaderProgram *pFreiChenEdgeDetectionShader = new CShaderProgram;
-    pFreiChenEdgeDetectionShader->CreateProgram();
     pFreiChenEdgeDetectionShader->AddShaderToProgram(&shShaders[47]);
     pFreiChenEdgeDetectionShader->AddShaderToProgram(&shShaders[48]);
-    pFreiChenEdgeDetectionShader->LinkProgram();
+    pFreiChenEdgeDetectionShader->DeferLink();
     m_pShaderPrograms->push_back(pEdgeDetectionShader);
     
     // Create the Screen Wave shader program
     CShaderProgram *pScreenWaveShader = new CShaderProgram;
-    pScreenWaveShader->CreateProgram();
     pScreenWaveShader->AddShaderToProgram(&shShaders[49]);
     pScreenWaveShader->AddShaderToProgram(&shShaders[50]);
-    pScreenWaveShader->LinkProgram();
+    pScreenWaveShader->DeferLink();
     m_pShaderPrograms->push_back(pScreenWaveShader);
     
     // Create the Swirl shader program
     CShaderProgram *pSwirlShader = new CShaderProgram;
-    pSwirlShader->CreateProgram();
     pSwirlShader->AddShaderToProgram(&shShaders[51]);
     pSwirlShader->AddShaderToProgram(&shShaders[52]);
-    pSwirlShader->LinkProgram();
+    pSwirlShader->DeferLink();
     m_pShaderPrograms->push_back(pSwirlShader);
     
     // Create the Night Vision Lens program
     CShaderProgram *pNightVisionLensShader = new CShaderProgram;
-    pNightVisionLensShader->CreateProgram();
     pNightVisionLensShader->AddShaderToProgram(&shShaders[53]);
     pNightVisionLensShader->AddShaderToProgram(&shShaders[54]);
-    pNightVisionLensShader->LinkProgram();
+    pNightVisionLensShader->DeferLink();
     m_pShaderPrograms->push_back(pNightVisionLensShader);
     
     // Create the Lens Circle shader program
     CShaderProgram *pLensCircleShader = new CShaderProgram;
-    pLensCircleShader->CreateProgram();
     pLensCircleShader->AddShaderToProgram(&shShaders[55]);
     pLensCircleShader->AddShaderToProgram(&shShaders[56]);
-    pLensCircleShader->LinkProgram();
+    pLensCircleShader->DeferLink();
     m_pShaderPrograms->push_back(pLensCircleShader);
     
     // Create the Posterization shader program
     CShaderProgram *pPosterizationShader = new CShaderProgram;
-    pPosterizationShader->CreateProgram();
     pPosterizationShader->AddShaderToProgram(&shShaders[57]);
     pPosterizationShader->AddShaderToProgram(&shShaders[58]);
-    pPosterizationShader->LinkProgram();
+    pPosterizationShader->DeferLink();
     m_pShaderPrograms->push_back(pPosterizationShader);
     
     // Create the Dream Vision shader program
     CShaderProgram *pDreamVisionShader = new CShaderProgram;
-    pDreamVisionShader->CreateProgram();
     pDreamVisionShader->AddShaderToProgram(&shShaders[59]);
     pDreamVisionShader->AddShaderToProgram(&shShaders[60]);
-    pDreamVisionShader->LinkProgram();
+    pDreamVisionShader->DeferLink();
     m_pShaderPrograms->push_back(pDreamVisionShader);
     
     // Create the Pixelation shader program
     CShaderProgram *pPixelationShader = new CShaderProgram;
-    pPixelationShader->CreateProgram();
     pPixelationShader->AddShaderToProgram(&shShaders[61]);
     pPixelationShader->AddShaderToProgram(&shShaders[62]);
-    pPixelationShader->LinkProgram();
+    pPixelationShader->DeferLink();
     m_pShaderPrograms->push_back(pPixelationShader);
     
     // Create the Frosted Glass Effect shader program
     CShaderProgram *pFrostedGlassEffectShader = new CShaderProgram;
-    pFrostedGlassEffectShader->CreateProgram();
     pFrostedGlassEffectShader->AddShaderToProgram(&shShaders[63]);
     pFrostedGlassEffectShader->AddShaderToProgram(&shShaders[64]);
-    pFrostedGlassEffectShader->LinkProgram();
+    pFrostedGlassEffectShader->DeferLink();
     m_pShaderPrograms->push_back(pFrostedGlassEffectShader);
     
     // Create the Frosted Glass shader program
     CShaderProgram *pFrostedGlassShader = new CShaderProgram;
-    pFrostedGlassShader->CreateProgram();
     pFrostedGlassShader->AddShaderToProgram(&shShaders[65]);
     pFrostedGlassShader->AddShaderToProgram(&shShaders[66]);
-    pFrostedGlassShader->LinkProgram();
+    pFrostedGlassShader->DeferLink();
     m_pShaderPrograms->push_back(pFrostedGlassShader);
     
     // Create the Crosshatching shader program
     CShaderProgram *pCrosshatchingShader = new CShaderProgram;
-    pCrosshatchingShader->CreateProgram();
     pCrosshatchingShader->AddShaderToProgram(&shShaders[67]);
     pCrosshatchingShader->AddShaderToProgram(&shShaders[68]);
-    pCrosshatchingShader->LinkProgram();
+    pCrosshatchingShader->DeferLink();
     m_pShaderPrograms->push_back(pCrosshatchingShader);
     
     // Create the Predators Thermal Vision shader program
     CShaderProgram *pPredatorsThermalVisionShader = new CShaderProgram;
-    pPredatorsThermalVisionShader->CreateProgram();
     pPredatorsThermalVisionShader->AddShaderToProgram(&shShaders[69]);
     pPredatorsThermalVisionShader->AddShaderToProgram(&shShaders[70]);
-    pPredatorsThermalVisionShader->LinkProgram();
+    pPredatorsThermalVisionShader->DeferLink();
     m_pShaderPrograms->push_back(pPredatorsThermalVisionShader);
     
     // Create the Toonify shader program
     CShaderProgram *pToonifyShader = new CShaderProgram;
-    pToonifyShader->CreateProgram();
     pToonifyShader->AddShaderToProgram(&shShaders[71]);
     pToonifyShader->AddShaderToProgram(&shShaders[72]);
-    pToonifyShader->LinkProgram();
+    pToonifyShader->DeferLink();
     m_pShaderPrograms->push_back(pToonifyShader);
     
     // Create the Shockwave shader program
     CShaderProgram *pShockwaveShader = new CShaderProgram;
-    pShockwaveShader->CreateProgram();
     pShockwaveShader->AddShaderToProgram(&shShaders[73]);
     pShockwaveShader->AddShaderToProgram(&shShaders[74]);
-    pShockwaveShader->LinkProgram();
+    pShockwaveShader->DeferLink();
     m_pShaderPrograms->push_back(pShockwaveShader);
 
     // Create the Fish Eye shader program
     CShaderProgram *pFishEyeShader = new CShaderProgram;
-    pFishEyeShader->CreateProgram();
     pFishEyeShader->AddShaderToProgram(&shShaders[75]);
     pFishEyeShader->AddShaderToProgram(&shShaders[76]);
-    pFishEyeShader->LinkProgram();
+    pFishEyeShader->DeferLink();
     m_pShaderPrograms->push_back(pFishEyeShader);
     
     // Create the Barrel Distortion Pixel shader program
     CShaderProgram *pBarrelDistortionPixelShader = new CShaderProgram;
-    pBarrelDistortionPixelShader->CreateProgram();
     pBarrelDistortionPixelShader->AddShaderToProgram(&shShaders[77]);
     pBarrelDistortionPixelShader->AddShaderToProgram(&shShaders[78]);
-    pBarrelDistortionPixelShader->LinkProgram();
+    pBarrelDistortionPixelShader->DeferLink();
     m_pShaderPrograms->push_back(pBarrelDistortionPixelShader);
     
     // Create the Multi Screen Fish Eye shader program
     CShaderProgram *pMultiScreenFishEyeShader = new CShaderProgram;
-    pMultiScreenFishEyeShader->CreateProgram();
     pMultiScreenFishEyeShader->AddShaderToProgram(&shShaders[79]);
     pMultiScreenFishEyeShader->AddShaderToProgram(&shShaders[80]);
-    pMultiScreenFishEyeShader->LinkProgram();
+    pMultiScreenFishEyeShader->DeferLink();
     m_pShaderPrograms->push_back(pMultiScreenFishEyeShader);
     
     // Create the Fish Eye Lens shader program
     CShaderProgram *pFishEyeLensShader = new CShaderProgram;
-    pFishEyeLensShader->CreateProgram();
     pFishEyeLensShader->AddShaderToProgram(&shShaders[81]);
     pFishEyeLensShader->AddShaderToProgram(&shShaders[82]);
-    pFishEyeLensShader->LinkProgram();
+    pFishEyeLensShader->DeferLink();
     m_pShaderPrograms->push_back(pFishEyeLensShader);
     
     // Create the Multi Screen Fish Eye shader program
     CShaderProgram *pFishEyeAntiFishEyeShader = new CShaderProgram;
-    pFishEyeAntiFishEyeShader->CreateProgram();
     pFishEyeAntiFishEyeShader->AddShaderToProgram(&shShaders[83]);
     pFishEyeAntiFishEyeShader->AddShaderToProgram(&shShaders[84]);
-    pFishEyeAntiFishEyeShader->LinkProgram();
+    pFishEyeAntiFishEyeShader->DeferLink();
     m_pShaderPrograms->push_back(pFishEyeAntiFishEyeShader);
     
     // Create the Gaussian Blur shader program
     CShaderProgram *pGaussianBlurShader = new CShaderProgram;
-    pGaussianBlurShader->CreateProgram();
     pGaussianBlurShader->AddShaderToProgram(&shShaders[85]);
     pGaussianBlurShader->AddShaderToProgram(&shShaders[86]);
-    pGaussianBlurShader->LinkProgram();
+    pGaussianBlurShader->DeferLink();
     m_pShaderPrograms->push_back(pGaussianBlurShader);
     
     // Create the Blur shader program
     CShaderProgram *pBlurShader = new CShaderProgram;
-    pBlurShader->CreateProgram();
     pBlurShader->AddShaderToProgram(&shShaders[87]);
     pBlurShader->AddShaderToProgram(&shShaders[88]);
-    pBlurShader->LinkProgram();
+    pBlurShader->DeferLink();
     m_pShaderPrograms->push_back(pBlurShader);
     
     // Create the Radial Blur shader program
     CShaderProgram *pRadialBlurShader = new CShaderProgram;
-    pRadialBlurShader->CreateProgram();
     pRadialBlurShader->AddShaderToProgram(&shShaders[89]);
     pRadialBlurShader->AddShaderToProgram(&shShaders[90]);
-    pRadialBlurShader->LinkProgram();
+    pRadialBlurShader->DeferLink();
     m_pShaderPrograms->push_back(pRadialBlurShader);
     
     // Create the Motion Blur shader program
     CShaderProgram *pMotionBlurShader = new CShaderProgram;
-    pMotionBlurShader->CreateProgram();
     pMotionBlurShader->AddShaderToProgram(&shShaders[91]);
     pMotionBlurShader->AddShaderToProgram(&shShaders[92]);
-    pMotionBlurShader->LinkProgram();
+    pMotionBlurShader->DeferLink();
     m_pShaderPrograms->push_back(pMotionBlurShader);
     
     // Create the Vignetting shader program
     CShaderProgram *pVignettingShader = new CShaderProgram;
-    pVignettingShader->CreateProgram();
     pVignettingShader->AddShaderToProgram(&shShaders[93]);
     pVignettingShader->AddShaderToProgram(&shShaders[94]);
-    pVignettingShader->LinkProgram();
+    pVignettingShader->DeferLink();
     m_pShaderPrograms->push_back(pVignettingShader);
     
     // Create the Bright Parts shader program
     CShaderProgram *pBrightPartsShader = new CShaderProgram;
-    pBrightPartsShader->CreateProgram();
     pBrightPartsShader->AddShaderToProgram(&shShaders[95]);
     pBrightPartsShader->AddShaderToProgram(&shShaders[96]);
-    pBrightPartsShader->LinkProgram();
+    pBrightPartsShader->DeferLink();
     m_pShaderPrograms->push_back(pBrightPartsShader);
     
     // Create the Bloom shader program
     CShaderProgram *pBloomShader = new CShaderProgram;
-    pBloomShader->CreateProgram();
     pBloomShader->AddShaderToProgram(&shShaders[97]);
     pBloomShader->AddShaderToProgram(&shShaders[98]);
-    pBloomShader->LinkProgram();
+    pBloomShader->DeferLink();
     m_pShaderPrograms->push_back(pBloomShader);
     
     // Create the lens Flare Ghost shader program
     CShaderProgram *pLensFlareGhostShader = new CShaderProgram;
-    pLensFlareGhostShader->CreateProgram();
     pLensFlareGhostShader->AddShaderToProgram(&shShaders[99]);
     pLensFlareGhostShader->AddShaderToProgram(&shShaders[100]);
-    pLensFlareGhostShader->LinkProgram();
+    pLensFlareGhostShader->DeferLink();
     m_pShaderPrograms->push_back(pLensFlareGhostShader);
     
     // Create the lens Flare shader program
     CShaderProgram *pLensFlareShader = new CShaderProgram;
-    pLensFlareShader->CreateProgram();
     pLensFlareShader->AddShaderToProgram(&shShaders[101]);
     pLensFlareShader->AddShaderToProgram(&shShaders[102]);
-    pLensFlareShader->LinkProgram();
+    pLensFlareShader->DeferLink();
     m_pShaderPrograms->push_back(pLensFlareShader);
     
     // Create the Depth Mapping shader program
     CShaderProgram *pDepthMappingShader = new CShaderProgram;
-    pDepthMappingShader->CreateProgram();
     pDepthMappingShader->AddShaderToProgram(&shShaders[103]);
     pDepthMappingShader->AddShaderToProgram(&shShaders[104]);
-    pDepthMappingShader->LinkProgram();
+    pDepthMappingShader->DeferLink();
     m_pShaderPrograms->push_back(pDepthMappingShader);
     
     // Create the Directional Shadow Depth Shader program
     CShaderProgram *pLightSpaceShader = new CShaderProgram;
-    pLightSpaceShader->CreateProgram();
     pLightSpaceShader->AddShaderToProgram(&shShaders[105]);
     pLightSpaceShader->AddShaderToProgram(&shShaders[106]);
-    pLightSpaceShader->LinkProgram();
+    pLightSpaceShader->DeferLink();
     m_pShaderPrograms->push_back(pLightSpaceShader);
     
     // Create the Tone Mapping shader program
     CShaderProgram *pToneMappingShader = new CShaderProgram;
-    pToneMappingShader->CreateProgram();
     pToneMappingShader->AddShaderToProgram(&shShaders[107]);
     pToneMappingShader->AddShaderToProgram(&shShaders[108]);
-    pToneMappingShader->LinkProgram();
+    pToneMappingShader->DeferLink();
     m_pShaderPrograms->push_back(pToneMappingShader);
     
     // Create the Tone Mapping shader program
     CShaderProgram *pFastApproximateAntiAliasingShader = new CShaderProgram;
-    pFastApproximateAntiAliasingShader->CreateProgram();
     pFastApproximateAntiAliasingShader->AddShaderToProgram(&shShaders[109]);
     pFastApproximateAntiAliasingShader->AddShaderToProgram(&shShaders[110]);
-    pFastApproximateAntiAliasingShader->LinkProgram();
+    pFastApproximateAntiAliasingShader->DeferLink();
     m_pShaderPrograms->push_back(pFastApproximateAntiAliasingShader);
     
     // Create the Fire Ball shader program
@@ -654,177 +656,155 @@ void Game::LoadShaderPrograms(const std::string &path) {
     
     // Create the Deferred Rendering shader program
     CShaderProgram *pDeferredRenderingProgram = new CShaderProgram;
-    pDeferredRenderingProgram->CreateProgram();
     pDeferredRenderingProgram->AddShaderToProgram(&shShaders[113]);
     pDeferredRenderingProgram->AddShaderToProgram(&shShaders[114]);
-    pDeferredRenderingProgram->LinkProgram();
+    pDeferredRenderingProgram->DeferLink();
     m_pShaderPrograms->push_back(pDeferredRenderingProgram);
  
     // Create the Screen Space Ambient Occlusion shader program
     CShaderProgram *pScreenSpaceAmbientOcclusionProgram = new CShaderProgram;
-    pScreenSpaceAmbientOcclusionProgram->CreateProgram();
     pScreenSpaceAmbientOcclusionProgram->AddShaderToProgram(&shShaders[115]);
     pScreenSpaceAmbientOcclusionProgram->AddShaderToProgram(&shShaders[116]);
-    pScreenSpaceAmbientOcclusionProgram->LinkProgram();
+    pScreenSpaceAmbientOcclusionProgram->DeferLink();
     m_pShaderPrograms->push_back(pScreenSpaceAmbientOcclusionProgram);
     
     // Create the Screen Space Ambient Occlusion Blur shader program
     CShaderProgram *pScreenSpaceAmbientOcclusionBlurProgram = new CShaderProgram;
-    pScreenSpaceAmbientOcclusionBlurProgram->CreateProgram();
     pScreenSpaceAmbientOcclusionBlurProgram->AddShaderToProgram(&shShaders[117]);
     pScreenSpaceAmbientOcclusionBlurProgram->AddShaderToProgram(&shShaders[118]);
-    pScreenSpaceAmbientOcclusionBlurProgram->LinkProgram();
+    pScreenSpaceAmbientOcclusionBlurProgram->DeferLink();
     m_pShaderPrograms->push_back(pScreenSpaceAmbientOcclusionBlurProgram);
     
     // Create the Screen Space Ambient Occlusion Lighting shader program
     CShaderProgram *pScreenSpaceAmbientOcclusionLightingProgram = new CShaderProgram;
-    pScreenSpaceAmbientOcclusionLightingProgram->CreateProgram();
     pScreenSpaceAmbientOcclusionLightingProgram->AddShaderToProgram(&shShaders[119]);
     pScreenSpaceAmbientOcclusionLightingProgram->AddShaderToProgram(&shShaders[120]);
-    pScreenSpaceAmbientOcclusionLightingProgram->LinkProgram();
+    pScreenSpaceAmbientOcclusionLightingProgram->DeferLink();
     m_pShaderPrograms->push_back(pScreenSpaceAmbientOcclusionLightingProgram);
     
     CShaderProgram *pRainDropsProgram = new CShaderProgram;
-    pRainDropsProgram->CreateProgram();
     pRainDropsProgram->AddShaderToProgram(&shShaders[121]);
     pRainDropsProgram->AddShaderToProgram(&shShaders[122]);
-    pRainDropsProgram->LinkProgram();
+    pRainDropsProgram->DeferLink();
     m_pShaderPrograms->push_back(pRainDropsProgram);
 
     // Create the Jupiter Color shader program
     CShaderProgram *pJupiterColorProgram = new CShaderProgram;
-    pJupiterColorProgram->CreateProgram();
     pJupiterColorProgram->AddShaderToProgram(&shShaders[123]);
     pJupiterColorProgram->AddShaderToProgram(&shShaders[124]);
-    pJupiterColorProgram->LinkProgram();
+    pJupiterColorProgram->DeferLink();
     m_pShaderPrograms->push_back(pJupiterColorProgram);
     
     // Create the Palette Quantization And Dithering program
     CShaderProgram *pPaletteQuantizationAndDitheringProgram = new CShaderProgram;
-    pPaletteQuantizationAndDitheringProgram->CreateProgram();
     pPaletteQuantizationAndDitheringProgram->AddShaderToProgram(&shShaders[125]);
     pPaletteQuantizationAndDitheringProgram->AddShaderToProgram(&shShaders[126]);
-    pPaletteQuantizationAndDitheringProgram->LinkProgram();
+    pPaletteQuantizationAndDitheringProgram->DeferLink();
     m_pShaderPrograms->push_back(pPaletteQuantizationAndDitheringProgram);
     
     // Create the DistortedTV program
     CShaderProgram *pDistortedTVProgram = new CShaderProgram;
-    pDistortedTVProgram->CreateProgram();
     pDistortedTVProgram->AddShaderToProgram(&shShaders[127]);
     pDistortedTVProgram->AddShaderToProgram(&shShaders[128]);
-    pDistortedTVProgram->LinkProgram();
+    pDistortedTVProgram->DeferLink();
     m_pShaderPrograms->push_back(pDistortedTVProgram);
     
     // Create the RGBDisplay program
     CShaderProgram *pRGBDisplayProgram = new CShaderProgram;
-    pRGBDisplayProgram->CreateProgram();
     pRGBDisplayProgram->AddShaderToProgram(&shShaders[129]);
     pRGBDisplayProgram->AddShaderToProgram(&shShaders[130]);
-    pRGBDisplayProgram->LinkProgram();
+    pRGBDisplayProgram->DeferLink();
     m_pShaderPrograms->push_back(pRGBDisplayProgram);
     
     // Create the Pixelate program
     CShaderProgram *pPixelateProgram = new CShaderProgram;
-    pPixelateProgram->CreateProgram();
     pPixelateProgram->AddShaderToProgram(&shShaders[131]);
     pPixelateProgram->AddShaderToProgram(&shShaders[132]);
-    pPixelateProgram->LinkProgram();
+    pPixelateProgram->DeferLink();
     m_pShaderPrograms->push_back(pPixelateProgram);
     
     // Create the Retro Parallax program
     CShaderProgram *pRetroParallaxProgram = new CShaderProgram;
-    pRetroParallaxProgram->CreateProgram();
     pRetroParallaxProgram->AddShaderToProgram(&shShaders[133]);
     pRetroParallaxProgram->AddShaderToProgram(&shShaders[134]);
-    pRetroParallaxProgram->LinkProgram();
+    pRetroParallaxProgram->DeferLink();
     m_pShaderPrograms->push_back(pRetroParallaxProgram);
     
     // Create the Scary Retro Parallax program
     CShaderProgram *pScaryRetroParallaxProgram = new CShaderProgram;
-    pScaryRetroParallaxProgram->CreateProgram();
     pScaryRetroParallaxProgram->AddShaderToProgram(&shShaders[135]);
     pScaryRetroParallaxProgram->AddShaderToProgram(&shShaders[136]);
-    pScaryRetroParallaxProgram->LinkProgram();
+    pScaryRetroParallaxProgram->DeferLink();
     m_pShaderPrograms->push_back(pScaryRetroParallaxProgram);
     
     // Create the Scary MoneyFilter program
     CShaderProgram *pMoneyFilterProgram = new CShaderProgram;
-    pMoneyFilterProgram->CreateProgram();
     pMoneyFilterProgram->AddShaderToProgram(&shShaders[137]);
     pMoneyFilterProgram->AddShaderToProgram(&shShaders[138]);
-    pMoneyFilterProgram->LinkProgram();
+    pMoneyFilterProgram->DeferLink();
     m_pShaderPrograms->push_back(pMoneyFilterProgram);
     
     // Create the Microprism Mosaic program
     CShaderProgram *pMicroprismMosaicProgram = new CShaderProgram;
-    pMicroprismMosaicProgram->CreateProgram();
     pMicroprismMosaicProgram->AddShaderToProgram(&shShaders[139]);
     pMicroprismMosaicProgram->AddShaderToProgram(&shShaders[140]);
-    pMicroprismMosaicProgram->LinkProgram();
+    pMicroprismMosaicProgram->DeferLink();
     m_pShaderPrograms->push_back(pMicroprismMosaicProgram);
     
     // Create the Knitted Pixelation program
     CShaderProgram *pKnittedPixelationProgram = new CShaderProgram;
-    pKnittedPixelationProgram->CreateProgram();
     pKnittedPixelationProgram->AddShaderToProgram(&shShaders[141]);
     pKnittedPixelationProgram->AddShaderToProgram(&shShaders[142]);
-    pKnittedPixelationProgram->LinkProgram();
+    pKnittedPixelationProgram->DeferLink();
     m_pShaderPrograms->push_back(pKnittedPixelationProgram);
     
     // Create the Bayer Matrix Dithering program
     CShaderProgram *pBayerMatrixDitheringProgram = new CShaderProgram;
-    pBayerMatrixDitheringProgram->CreateProgram();
     pBayerMatrixDitheringProgram->AddShaderToProgram(&shShaders[143]);
     pBayerMatrixDitheringProgram->AddShaderToProgram(&shShaders[144]);
-    pBayerMatrixDitheringProgram->LinkProgram();
+    pBayerMatrixDitheringProgram->DeferLink();
     m_pShaderPrograms->push_back(pBayerMatrixDitheringProgram);
     
     // Create the Julia Freak program
     CShaderProgram *pJuliaFreakProgram = new CShaderProgram;
-    pJuliaFreakProgram->CreateProgram();
     pJuliaFreakProgram->AddShaderToProgram(&shShaders[145]);
     pJuliaFreakProgram->AddShaderToProgram(&shShaders[146]);
-    pJuliaFreakProgram->LinkProgram();
+    pJuliaFreakProgram->DeferLink();
     m_pShaderPrograms->push_back(pJuliaFreakProgram);
     
     // Create the Heart Blend program
     CShaderProgram *pJHeartBlendProgram = new CShaderProgram;
-    pJHeartBlendProgram->CreateProgram();
     pJHeartBlendProgram->AddShaderToProgram(&shShaders[147]);
     pJHeartBlendProgram->AddShaderToProgram(&shShaders[148]);
-    pJHeartBlendProgram->LinkProgram();
+    pJHeartBlendProgram->DeferLink();
     m_pShaderPrograms->push_back(pJHeartBlendProgram);
     
     // Create the EM Interference program
     CShaderProgram *pEMInterferenceProgram = new CShaderProgram;
-    pEMInterferenceProgram->CreateProgram();
     pEMInterferenceProgram->AddShaderToProgram(&shShaders[149]);
     pEMInterferenceProgram->AddShaderToProgram(&shShaders[150]);
-    pEMInterferenceProgram->LinkProgram();
+    pEMInterferenceProgram->DeferLink();
     m_pShaderPrograms->push_back(pEMInterferenceProgram);
     
     // Create the Cubic Lens Distortion program
     CShaderProgram *pCubicLensDistortionProgram = new CShaderProgram;
-    pCubicLensDistortionProgram->CreateProgram();
     pCubicLensDistortionProgram->AddShaderToProgram(&shShaders[151]);
     pCubicLensDistortionProgram->AddShaderToProgram(&shShaders[152]);
-    pCubicLensDistortionProgram->LinkProgram();
+    pCubicLensDistortionProgram->DeferLink();
     m_pShaderPrograms->push_back(pCubicLensDistortionProgram);
     
     // Create the Cel Shaderish program
     CShaderProgram *pCelShaderishProgram = new CShaderProgram;
-    pCelShaderishProgram->CreateProgram();
     pCelShaderishProgram->AddShaderToProgram(&shShaders[153]);
     pCelShaderishProgram->AddShaderToProgram(&shShaders[154]);
-    pCelShaderishProgram->LinkProgram();
+    pCelShaderishProgram->DeferLink();
     m_pShaderPrograms->push_back(pCelShaderishProgram);
     
     // Create the Cartoon Video program
     CShaderProgram *pCartoonVideoProgram = new CShaderProgram;
-    pCartoonVideoProgram->CreateProgram();
     pCartoonVideoProgram->AddShaderToProgram(&shShaders[155]);
     pCartoonVideoProgram->AddShaderToProgram(&shShaders[156]);
-    pCartoonVideoProgram->LinkProgram();
+    pCartoonVideoProgram->DeferLink();
     m_pShaderPrograms->push_back(pCartoonVideoProgram);
     
     // Create the EquirectangularToCubemap Shader
@@ -879,37 +859,178 @@ void Game::LoadShaderPrograms(const std::string &path) {
     
     // Depth Testing Shader
     CShaderProgram *pDepthTestingProgram = new CShaderProgram;
-    pDepthTestingProgram->CreateProgram();
     pDepthTestingProgram->AddShaderToProgram(&shShaders[170]);
     pDepthTestingProgram->AddShaderToProgram(&shShaders[171]);
-    pDepthTestingProgram->LinkProgram();
+    pDepthTestingProgram->DeferLink();
     m_pShaderPrograms->push_back(pDepthTestingProgram);
     
     // // Create the Directional Shadow Mapping Shader program
     CShaderProgram *pDirectionalShadowMappingProgram = new CShaderProgram;
-    pDirectionalShadowMappingProgram->CreateProgram();
     pDirectionalShadowMappingProgram->AddShaderToProgram(&shShaders[172]);
     pDirectionalShadowMappingProgram->AddShaderToProgram(&shShaders[173]);
-    pDirectionalShadowMappingProgram->LinkProgram();
+    pDirectionalShadowMappingProgram->DeferLink();
     m_pShaderPrograms->push_back(pDirectionalShadowMappingProgram);
     
     // Omnidirectional Shadow Depth Shader
     CShaderProgram *pOmnidirectionalShadowDepthProgram = new CShaderProgram;
-    pOmnidirectionalShadowDepthProgram->CreateProgram();
     pOmnidirectionalShadowDepthProgram->AddShaderToProgram(&shShaders[174]);
     pOmnidirectionalShadowDepthProgram->AddShaderToProgram(&shShaders[175]);
     pOmnidirectionalShadowDepthProgram->AddShaderToProgram(&shShaders[176]);
-    pOmnidirectionalShadowDepthProgram->LinkProgram();
+    pOmnidirectionalShadowDepthProgram->DeferLink();
     m_pShaderPrograms->push_back(pOmnidirectionalShadowDepthProgram);
     
     // Omnidirectional Shadow Mapping Shader
     CShaderProgram *pOmnidirectionalShadowMappingProgram = new CShaderProgram;
-    pOmnidirectionalShadowMappingProgram->CreateProgram();
     pOmnidirectionalShadowMappingProgram->AddShaderToProgram(&shShaders[177]);
     pOmnidirectionalShadowMappingProgram->AddShaderToProgram(&shShaders[178]);
-    pOmnidirectionalShadowMappingProgram->LinkProgram();
+    pOmnidirectionalShadowMappingProgram->DeferLink();
     m_pShaderPrograms->push_back(pOmnidirectionalShadowMappingProgram);
+    
+    // Bloom Downsample Shader
+    CShaderProgram *pBloomDownsampleProgram = new CShaderProgram;
+    pBloomDownsampleProgram->AddShaderToProgram(&shShaders[179]);
+    pBloomDownsampleProgram->AddShaderToProgram(&shShaders[180]);
+    pBloomDownsampleProgram->DeferLink();
+    m_pShaderPrograms->push_back(pBloomDownsampleProgram);
+    
+    // Bloom Upsample Shader
+    CShaderProgram *pBloomUpsampleProgram = new CShaderProgram;
+    pBloomUpsampleProgram->AddShaderToProgram(&shShaders[181]);
+    pBloomUpsampleProgram->AddShaderToProgram(&shShaders[182]);
+    pBloomUpsampleProgram->DeferLink();
+    m_pShaderPrograms->push_back(pBloomUpsampleProgram);
+    
+    // Convolution Compute Shader, left empty when compute is not available so the indices stay the same
+    CShaderProgram *pConvolutionProgram = new CShaderProgram;
+    if (m_ppfxCompute) {
+        pConvolutionProgram->AddShaderToProgram(&shShaders[189]);
+        pConvolutionProgram->DeferLink();
+    }
+    m_pShaderPrograms->push_back(pConvolutionProgram);
+    
+    // Screen Space Ambient Occlusion Downsample Shader
+    CShaderProgram *pScreenSpaceAmbientOcclusionDownsampleProgram = new CShaderProgram;
+    pScreenSpaceAmbientOcclusionDownsampleProgram->AddShaderToProgram(&shShaders[183]);
+    pScreenSpaceAmbientOcclusionDownsampleProgram->AddShaderToProgram(&shShaders[184]);
+    pScreenSpaceAmbientOcclusionDownsampleProgram->DeferLink();
+    m_pShaderPrograms->push_back(pScreenSpaceAmbientOcclusionDownsampleProgram);
+    
+    // Screen Space Ambient Occlusion Temporal Shader
+    CShaderProgram *pScreenSpaceAmbientOcclusionTemporalProgram = new CShaderProgram;
+    pScreenSpaceAmbientOcclusionTemporalProgram->AddShaderToProgram(&shShaders[185]);
+    pScreenSpaceAmbientOcclusionTemporalProgram->AddShaderToProgram(&shShaders[186]);
+    pScreenSpaceAmbientOcclusionTemporalProgram->DeferLink();
+    m_pShaderPrograms->push_back(pScreenSpaceAmbientOcclusionTemporalProgram);
+    
+    // Screen Space Ambient Occlusion Upsample Shader
+    CShaderProgram *pScreenSpaceAmbientOcclusionUpsampleProgram = new CShaderProgram;
+    pScreenSpaceAmbientOcclusionUpsampleProgram->AddShaderToProgram(&shShaders[187]);
+    pScreenSpaceAmbientOcclusionUpsampleProgram->AddShaderToProgram(&shShaders[188]);
+    pScreenSpaceAmbientOcclusionUpsampleProgram->DeferLink();
+    m_pShaderPrograms->push_back(pScreenSpaceAmbientOcclusionUpsampleProgram);
+    
+    // Instanced Physically Based Rendering Shader
+    CShaderProgram *pPBRInstancedProgram = new CShaderProgram;
+    pPBRInstancedProgram->AddShaderToProgram(&shPBRInstanced);
+    pPBRInstancedProgram->AddShaderToProgram(&shShaders[7]);
+    pPBRInstancedProgram->DeferLink();
+    m_pShaderPrograms->push_back(pPBRInstancedProgram);
+    
+    // Instanced Blinn Phong Light Shader
+    CShaderProgram *pLightInstancedProgram = new CShaderProgram;
+    pLightInstancedProgram->AddShaderToProgram(&shLightInstanced);
+    pLightInstancedProgram->AddShaderToProgram(&shShaders[11]);
+    pLightInstancedProgram->DeferLink();
+    m_pShaderPrograms->push_back(pLightInstancedProgram);
+    
+    // Scene Cull Compute Shader, left empty without GL 4.3 like the convolution program
+    CShaderProgram *pSceneCullProgram = new CShaderProgram;
+    if (m_indirectSupported) {
+        pSceneCullProgram->AddShaderToProgram(&shSceneCull);
+        pSceneCullProgram->DeferLink();
+    }
+    m_pShaderPrograms->push_back(pSceneCullProgram);
+    
+    // wait for the programs the driver is still compiling in the background
+    GLboolean bPending = true;
+    while (bPending) {
+        bPending = false;
+        for (CShaderProgram *pProgram : *m_pShaderPrograms) {
+            if (!pProgram->IsLinkPending()) continue;
+            if (pProgram->IsLinkComplete()) pProgram->FinishLink();
+            else bPending = true;
+        }
+        if (bPending) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    
+    for (GLuint i = 0; i < shShaders.size(); i++) {
+        shShaders[i].DeleteShader();
+    }
+    shPBRInstanced.DeleteShader();
+    shLightInstanced.DeleteShader();
+    if (m_indirectSupported) shSceneCull.DeleteShader();
+    
+    GLuint uiDeferred = 0;
+    for (CShaderProgram *pProgram : *m_pShaderPrograms) {
+        if (!pProgram->IsLinked()) uiDeferred++;
+    }
+    
+    std::cout << "Shader programs: " << m_pShaderPrograms->size() - uiDeferred << " ready in " << timer.Elapsed() << " ms ("
+    << cache.GetHits() << " from cache, " << cache.GetMisses() << " compiled), " << uiDeferred << " deferred" << std::endl;
+}
+
+// Starts building the deferred effect programs once the first frame is up, so start up only pays for the scene
+void Game::PrewarmShaderPrograms() {
+    if (m_shaderPrewarmStarted) return;
+    m_shaderPrewarmStarted = true;
+    
+    CShaderPrewarmer &prewarmer = CShaderPrewarmer::Instance();
+    prewarmer.Start(m_gameWindow->CreateSharedContext());
+    for (CShaderProgram *pProgram : *m_pShaderPrograms)
+        prewarmer.Request(pProgram, false);
+}
+
+// Adopts the programs finished since the last frame
+void Game::UpdateShaderPrograms() {
+    CShaderPrewarmer::Instance().Update();
 }
 
 
 
+
+// Polls the shader files every SHADER_WATCH_INTERVAL and relinks only the programs built from the edited ones
+void Game::ReloadChangedShaderPrograms() {
+    if (SHADER_WATCH_INTERVAL <= 0.0) return;
+    
+    m_shaderWatchTime += m_deltaTime;
+    if (m_shaderWatchTime < SHADER_WATCH_INTERVAL) return;
+    m_shaderWatchTime = 0.0;
+    
+    std::vector<std::string> changed = CShaderPreprocessor::Instance().PollChanges();
+    if (changed.empty()) return;
+    
+    for (const std::string &file : changed)
+        std::cout << "Shader changed: " << file << std::endl;
+    
+    for (CShaderProgram *pProgram : *m_pShaderPrograms) {
+        for (const std::string &file : changed) {
+            if (pProgram->DependsOn(file)) {
+                pProgram->Reload();
+                break;
+            }
+        }
+    }
+}
+
+// Picks the feature set for this frame, each program switches to the matching variant the next time it is used
+void Game::UpdateShaderFeatures() {
+    GLuint features = 0;
+    if (m_useDir) features |= ShaderFeatureBit(ShaderFeature::DirectionalLight);
+    if (m_usePoint) features |= ShaderFeatureBit(ShaderFeature::PointLight);
+    if (m_useSpot) features |= ShaderFeatureBit(ShaderFeature::SpotLight);
+    if (m_useSmoothSpot) features |= ShaderFeatureBit(ShaderFeature::SmoothSpot);
+    if (m_useBlinn) features |= ShaderFeatureBit(ShaderFeature::Blinn);
+    if (m_HDR) features |= ShaderFeatureBit(ShaderFeature::HDR);
+    if (m_useFog) features |= ShaderFeatureBit(ShaderFeature::Fog);
+    CShaderProgram::SetFeatures(features);
+}
@@ -1,5 +1,7 @@
 
 #include "Game.h"
+#include "../window/GLState.h"
+#include "../shaders/ShaderPrewarmer.h"
 
 // Constructor
 Game::Game()
@@ -29,6 +31,7 @@ Game::Game()
     
     //camera setting
     m_pCamera = nullptr;
+    m_pCameraUBO = nullptr;
     m_isOrthographicCamera = true;
     
     // materials
@@ -54,9 +57,14 @@ Game::Game()
     
     // shader programs
     m_pShaderPrograms = nullptr;
+    m_shaderWatchTime = 0.0;
+    m_shaderPrewarmStarted = false;
+    m_shaderPath = "";
     
     // lights
     m_pLamp = nullptr;
+    m_pLightsUBO = nullptr;
+    m_pShadowUBO = nullptr;
     m_ambient = 0.4f;
     m_diffuse = 2.5f;
     m_specular = 0.6f;
@@ -74,14 +82,12 @@ Game::Game()
     m_exponent = 0.0019f;
     
     // Dir Light
-    m_dirName = "R_directionallight";
     m_useDir = true;
     m_dirColor = glm::vec3(0.95f, 0.9f, 1.0f);
     m_dirIntensity = 0.4f;
     m_directionalLightDirection = glm::vec3(-0.2f, -1.0f, -0.3f),
     
     // Point Light
-    m_pointName = "R_pointlight";
     m_usePoint = false;
     m_pointIntensity = 18.0f;
     
@@ -100,7 +106,6 @@ Game::Game()
     m_pointLightIndex = m_pointLights.size() - 1;
     
     // Spot Light
-    m_spotName = "R_spotlight";
     m_useSpot = false;
     m_spotColor = glm::vec3(0.3f, 0.5f, 1.0f);;
     m_spotIntensity = 40.4f;
@@ -128,49 +133,37 @@ Game::Game()
     m_heightMapMaxHeight = 100.0f;
     
     //models
-    m_teapot1 = nullptr;
-    m_teapot2 = nullptr;
-    m_teapot3 = nullptr;
-    m_teapot4 = nullptr;
-    m_teapot5 = nullptr;
-    m_teapot6 = nullptr;
-    m_teapot7 = nullptr;
-    m_teapot8 = nullptr;
-    m_teapot10 = nullptr;
-    m_teapot15 = nullptr;
-    m_teapot16 = nullptr;
-    m_teapot17 = nullptr;
-    m_teapot19 = nullptr;
-    
     m_trolley = nullptr;
     m_lamborginhi = nullptr;
     
-    //sphere object
+    // scene objects
+    m_pSceneStore = nullptr;
     m_sphereRotation = 0.0f;
-    m_pSpherePBR1 = nullptr;
-    m_pSpherePBR2 = nullptr;
-    m_pSpherePBR3 = nullptr;
-    m_pSpherePBR4 = nullptr;
-    m_pSpherePBR5 = nullptr;
-    m_pSpherePBR6 = nullptr;
-    m_pSpherePBR7 = nullptr;
-    m_pSpherePBR8 = nullptr;
-    m_pSpherePBR9 = nullptr;
-    m_pSpherePBR10 = nullptr;
-    m_pSpherePBR11 = nullptr;
-    m_pSpherePBR12 = nullptr;
-    m_pSpherePBR13 = nullptr;
-    m_pSpherePBR14 = nullptr;
-    m_pSpherePBR15 = nullptr;
-    m_pSpherePBR16 = nullptr;
-    m_pSpherePBR17 = nullptr;
-    m_pSpherePBR18 = nullptr;
-    m_pSpherePBR19 = nullptr;
+    m_sceneTransforms = 0;
+    m_scenePasses = 0;
+    m_pSceneFrame = nullptr;
+    m_pipelineScene = false;
+    m_viewMatrix = glm::mat4(1.0f);
+    m_inverseViewMatrix = glm::mat4(1.0f);
+    m_pInstanceBuffer = nullptr;
+    m_instancedObjectCount = 0;
+    m_instancedDrawCount = 0;
+    m_pFrustumCuller = nullptr;
+    m_useCulling = true;
+    m_cullFromLight = false;
+    m_shadowCullMatrix = glm::mat4(1.0f);
+    m_pOcclusionCuller = nullptr;
+    m_useOcclusionCulling = true;
+    m_pTerrainOccluder = nullptr;
+    m_showOcclusionBuffer = false;
+    m_pOcclusionTexture = nullptr;
+    m_pIndirectCuller = nullptr;
+    m_indirectSupported = false;
+    m_useIndirect = true;
+    m_indirectObjectCount = 0;
+    m_indirectDrawCount = 0;
     
     //cube object
-    m_pCube12 = nullptr;
-    m_pCube13 = nullptr;
-    m_pCube14 = nullptr;
     m_pInteriorBox = nullptr;
     
     // woodenBox
@@ -186,12 +179,6 @@ Game::Game()
         glm::vec3(  -220.0f,  210.0f, 133.0f  ),
     };
     
-    //torus object
-    m_pTorus = nullptr;
-    
-    //torusknot object
-    m_pTorusKnot = nullptr;
-    
     // metalballs
     m_pMetaballs = nullptr;
     
@@ -214,8 +201,14 @@ Game::Game()
 // Destructor
 Game::~Game()
 {
+    // the simulation thread reads the scene objects deleted below
+    m_scenePipeline.Stop();
+    
     //delete objects when desrtuctor occurs
     delete m_pCamera;
+    delete m_pCameraUBO;
+    delete m_pLightsUBO;
+    delete m_pShadowUBO;
     delete m_pFtFont;
     delete m_pAudio;
     delete m_pSkybox;
@@ -223,62 +216,31 @@ Game::~Game()
     delete m_pIrrSkybox;
     delete m_pPlanarTerrain;
     delete m_pHeightmapTerrain;
-    delete m_teapot1;
-    delete m_teapot2;
-    delete m_teapot3;
-    delete m_teapot4;
-    delete m_teapot5;
-    delete m_teapot6;
-    delete m_teapot7;
-    delete m_teapot8;
-    delete m_teapot9;
-    delete m_teapot10;
-    delete m_teapot15;
-    delete m_teapot16;
-    delete m_teapot17;
-    delete m_teapot19;
-    
     delete m_trolley;
     delete m_lamborginhi;
-    delete m_pSpherePBR1;
-    delete m_pSpherePBR2;
-    delete m_pSpherePBR3;
-    delete m_pSpherePBR4;
-    delete m_pSpherePBR5;
-    delete m_pSpherePBR6;
-    delete m_pSpherePBR7;
-    delete m_pSpherePBR8;
-    delete m_pSpherePBR9;
-    delete m_pSpherePBR10;
-    delete m_pSpherePBR11;
-    delete m_pSpherePBR12;
-    delete m_pSpherePBR13;
-    delete m_pSpherePBR14;
-    delete m_pSpherePBR15;
-    delete m_pSpherePBR16;
-    delete m_pSpherePBR17;
-    delete m_pSpherePBR18;
-    delete m_pSpherePBR19;
-    
-    delete m_pCube12;
-    delete m_pCube13;
-    delete m_pCube14;
+    delete m_pSceneStore;
+    delete m_pInstanceBuffer;
+    delete m_pFrustumCuller;
+    delete m_pOcclusionCuller;
+    if (m_pOcclusionTexture != nullptr) m_pOcclusionTexture->Release();
+    delete m_pOcclusionTexture;
+    delete m_pIndirectCuller;
+    
     delete m_pInteriorBox;
     
     delete m_pLamp;
     delete m_pWoodenBox;
     
-    delete m_pTorus;
-    delete m_pTorusKnot;
     delete m_pMetaballs;
     delete m_pQuad;
     
-    for (GLuint i = 0; i < m_pFBOs.size(); i++) {
-        // delete current buffers
-        m_pFBOs[i]->Release();
-        delete m_pFBOs[i];
-    }
-    m_pFBOs.clear();
+    // every static mesh is gone, release the buffers they shared
+    CGeometryArena::Instance().Release();
+    
+    // delete current buffers
+    m_ppfxTargets.Release();
+    for (CGPUTimer &timer : m_ssaoTimers)
+        timer.Release();
     
     if (m_pShaderPrograms != nullptr) {
         for (unsigned int i = 0; i < m_pShaderPrograms->size(); i++)
@@ -305,16 +267,45 @@ void Game::PreRendering() {
     
     // update audio
     UpdateAudio();
+    
+    // advance the simulations and place the scene objects, the passes of Render only read them
+    UpdateScene();
+    
+    // hand over the programs built in the background since the last frame
+    UpdateShaderPrograms();
+    
+    // rebuild programs whose shader files were edited
+    ReloadChangedShaderPrograms();
+    
+    // stream textures back in and evict down to the texture budget
+    CTextureResidency::Instance().Update();
 }
 
 // Render scene method runs
 void Game::Render()
 {
     
+    // the state counters now report the previous frame
+    CGLState::Instance().BeginFrame();
+    CShaderProgram::BeginFrame();
+    m_renderQueue.BeginFrame();
+    m_pFrustumCuller->BeginFrame();
+    m_pOcclusionCuller->BeginFrame();
+    
+    // choose the shader variants for this frame before any program is used
+    UpdateShaderFeatures();
+    
     ChangePPFXScene( m_currentPPFXMode );
     
+    // an effect still being built is skipped for this frame
+    const PostProcessingEffectMode mode = GetReadyPPFXMode( m_currentPPFXMode );
+    
+    // upload camera, lights and shadow matrices once, every program reads them from the shared blocks
+    UpdateCameraUniformBlock(m_pCamera);
+    UpdateLightUniformBlock(m_pCamera);
+    
     // bind framebuffer
-    BindPPFXFBO( m_currentPPFXMode );
+    BindPPFXFBO( mode );
     
     // Clear screen
     m_gameWindow->ClearBuffers(ClearBuffersType::COLORDEPTHSTENCIL);
@@ -325,7 +316,7 @@ void Game::Render()
     ResetFrameBuffer();
     
     // Post Processing Effects
-    RenderPPFX( m_currentPPFXMode );
+    RenderPPFX( mode );
     
     // Draw the 2D graphics after the 3D graphics
     RenderHUD();
@@ -337,6 +328,12 @@ void Game::Render()
 void Game::PostRendering() {
     ResetCamera(m_deltaTime);
     ClearControls();
+    
+    // pack the shared mesh buffers once freed meshes leave less than half their free space in one block
+    CGeometryArena::Instance().Defragment(0.5f);
+    
+    // the first frame is on screen, build the remaining programs in the background
+    PrewarmShaderPrograms();
 }
 
 // The game loop runs repeatedly until game over
@@ -347,6 +344,7 @@ void Game::GameLoop()
     PreRendering();
     Render();
     PostRendering();
+    m_scenePipeline.EndFrame();
     m_deltaTime = m_pGameTimer->Elapsed();
 }
 
@@ -357,6 +355,7 @@ void Game::Execute(const std::string &filepath, const GLuint &width, const GLuin
     InitialiseGameWindow("OpenGL Window", filepath, width, height);
     InitialiseFrameBuffers(width, height);
     InitialiseCamera(width, height, glm::vec3(0.0f, 0.0f, 200.0f));
+    InitialiseLights();
     InitialiseAudio(filepath);
     
     LoadShaderPrograms(filepath);
@@ -389,6 +388,9 @@ void Game::Execute(const std::string &filepath, const GLuint &width, const GLuin
     
     RemoveControls();
     
+    CShaderPrewarmer::Instance().Stop();
+    m_scenePipeline.Stop();
+    
     m_gameWindow->DestroyWindow();
     
     return;
@@ -65,49 +65,60 @@ private:
     float m_heightMapMinHeight, m_heightMapMaxHeight;
     
     //models
-    CModel * m_teapot1;
-    CModel * m_teapot2;
-    CModel * m_teapot3;
-    CModel * m_teapot4;
-    CModel * m_teapot5;
-    CModel * m_teapot6;
-    CModel * m_teapot7;
-    CModel * m_teapot8;
-    CModel * m_teapot9;
-    CModel * m_teapot10;
-    CModel * m_teapot15;
-    CModel * m_teapot16;
-    CModel * m_teapot17;
-    CModel * m_teapot19;
     CModel * m_lamborginhi;
     CModel * m_trolley;
     
-    //sphere objects
+    // scene objects, see resources/scenes
+    CSceneStore *m_pSceneStore;
     GLfloat m_sphereRotation;
-    CSphere *m_pSpherePBR1;
-    CSphere *m_pSpherePBR2;
-    CSphere *m_pSpherePBR3;
-    CSphere *m_pSpherePBR4;
-    CSphere *m_pSpherePBR5;
-    CSphere *m_pSpherePBR6;
-    CSphere *m_pSpherePBR7;
-    CSphere *m_pSpherePBR8;
-    CSphere *m_pSpherePBR9;
-    CSphere *m_pSpherePBR10;
-    CSphere *m_pSpherePBR11;
-    CSphere *m_pSpherePBR12;
-    CSphere *m_pSpherePBR13;
-    CSphere *m_pSpherePBR14;
-    CSphere *m_pSpherePBR15;
-    CSphere *m_pSpherePBR16;
-    CSphere *m_pSpherePBR17;
-    CSphere *m_pSpherePBR18;
-    CSphere *m_pSpherePBR19;
+    
+    // a node for every scene object placed on the ground under it, without the offset of its layer,
+    // SimulateScene moves them and copies them into a frame of the pipeline
+    CTransformHierarchy m_sceneHierarchy;
+    GLuint m_sceneTransforms, m_scenePasses;    // this frame, m_sceneTransforms counts the recomputed nodes
+    
+    // the passes read the frame UpdateScene acquired, with m_pipelineScene the next one is simulated on a
+    // worker meanwhile, M switches between the two
+    CScenePipeline m_scenePipeline;
+    const SceneFrame *m_pSceneFrame;
+    GLboolean m_pipelineScene;
+    
+    // the camera of the frame, UpdateCameraUniformBlock sets them before the first pass
+    glm::mat4 m_viewMatrix, m_inverseViewMatrix;
+    
+    // scene objects of the PBR and Blinn Phong programs are drawn one instanced draw per mesh and material
+    CInstanceBuffer *m_pInstanceBuffer;
+    std::vector<GLuint> m_instancedObjects;
+    GLuint m_instancedObjectCount, m_instancedDrawCount;
+    
+    // draw order of the scene objects, see RenderSceneLayer
+    CRenderQueue m_renderQueue;
+    
+    // objects outside the frustum of the camera, or of the light in the light space passes, are not drawn
+    CFrustumCuller *m_pFrustumCuller;
+    GLboolean m_useCulling;
+    GLboolean m_cullFromLight;
+    glm::mat4 m_shadowCullMatrix;
+    std::vector<GLint> m_cullIndices;           // of each object of the layer being drawn, where the culler batch has it, -1 if not tested
+    
+    // objects of a scene layer behind its occluders and the terrain are not drawn either
+    COcclusionCuller *m_pOcclusionCuller;
+    GLboolean m_useOcclusionCulling;
+    IGameObject *m_pTerrainOccluder;            // the terrain RenderScene drew, if any
+    std::vector<glm::vec3> m_occluderTriangles;
+    GLboolean m_showOcclusionBuffer;
+    CTexture *m_pOcclusionTexture;
+    std::vector<GLubyte> m_occlusionImage;
+    
+    // with GL 4.3 the objects of the instanced programs are culled by a compute shader and drawn with multi draw indirect
+    CIndirectCuller *m_pIndirectCuller;
+    GLboolean m_indirectSupported;
+    GLboolean m_useIndirect;
+    std::map<std::string, GLint> m_indirectBatches;     // batch of each layer, -1 when it has none
+    std::vector<GLubyte> m_indirectObjects;             // the scene objects a batch draws
+    GLuint m_indirectObjectCount, m_indirectDrawCount;
     
     //cube objects
-    CCube * m_pCube12;
-    CCube * m_pCube13;
-    CCube * m_pCube14;
     CCube * m_pInteriorBox;
     
     // lamp
@@ -117,12 +128,6 @@ private:
     CCube *m_pWoodenBox;
     std::vector<glm::vec3> m_woodenBoxesPosition;
     
-    //torus object
-    CTorus * m_pTorus;
-    
-    //torus knot
-    CTorusKnot * m_pTorusKnot;
-    
     // metal ball
     CMetaballs *m_pMetaballs;
 
@@ -143,7 +148,7 @@ protected:
     
     /// Camera
     void InitialiseCamera(const GLuint &width, const GLuint &height, const glm::vec3 &position) override;
-    void SetCameraUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, CCamera *camera) override;
+    void UpdateCameraUniformBlock(CCamera *camera) override;
     void UpdateCamera(const GLdouble & deltaTime, const MouseState &mouseState,
     const KeyboardState &keyboardState, const GLboolean & mouseMove) override;
     void ResetCamera(const GLdouble & deltaTime) override;
@@ -174,34 +179,24 @@ protected:
                         const GLuint &framesPerSecond, const bool &enableHud) override;
     
     /// Lights
-    void SetLightUniform(CShaderProgram *pShaderProgram, const GLboolean &useDir, const GLboolean &usePoint,
-    const GLboolean &useSpot, const GLboolean &useSmoothSpot, const GLboolean& useBlinn) override;
-    void SetHRDLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
-    const GLfloat & exposure, const GLfloat & gamma, const GLboolean &useHDR) override;
-    void SetDirectionalLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
-    const DirectionalLight& directionalLight, const glm::vec3& direction, const glm::vec3 &position) override;
-    void SetPointLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, const PointLight& pointLight) override;
-    void SetSpotLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, const SpotLight& spotLight, CCamera *camera) override;
-    void SetShadowUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, const GLfloat &bias) override;
-    void SetShadowMatrix(CShaderProgram *pShaderProgram, const glm::vec3 &lightPosition) override;
-    void RenderLight(CShaderProgram *pShaderProgram,
-                        const std::string &dirName,
-                        const std::string &pointName,
-                        const std::string &spotName,
-                        CCamera *camera,
-                        const GLboolean &useShadowMatrix = false) override;
+    void InitialiseLights() override;
+    void SetHRDLightUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName,
+    const GLfloat & exposure, const GLfloat & gamma) override;
+    void SetShadowUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName, const GLfloat &bias) override;
+    void UpdateLightUniformBlock(CCamera *camera) override;
+    void UpdateShadowUniformBlock(const glm::vec3 &lightPosition) override;
     void RenderLamp(CShaderProgram *pShaderProgram, const glm::vec3 &position, const glm::vec3 & scale) override;
     
     /// Materials
-    void SetMaterialUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
+    void SetMaterialUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName,
                             const glm::vec4 &color = glm::vec4(1.0f), const GLfloat &shininess = 32.0f,
                             const GLfloat &uvTiling = 1.0f, const GLboolean &useAO = false,
                             const glm::vec4 &guiColor = glm::vec4(0.5f)) override;
-    void SetPBRMaterialUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
+    void SetPBRMaterialUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName,
                                 const GLfloat &albedo, const GLfloat &metallic, const GLfloat &roughness,
                                 const GLfloat &ao, const GLboolean &useIrradiance) override;
-    void SetFogMaterialUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
-                                const glm::vec3 &color, const GLboolean &bUseFog) override;
+    void SetFogMaterialUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName,
+                                const glm::vec3 &color) override;
     
     /// Post processing
     void InitialiseFrameBuffers(const GLuint &width, const GLuint &height) override;
@@ -213,17 +208,38 @@ protected:
     const GLuint &bufferIndex = 0, const TextureType &textureType = TextureType::AMBIENT,
     const GLboolean &useAO = false) override;
     void RenderPPFX(const PostProcessingEffectMode &mode) override;
+    void BuildPPFXGraph(CRenderGraph &graph, const PostProcessingEffectMode &mode) override;
+    PostProcessingGraphSettings GetPPFXGraphSettings() override;
+    std::function<void()> BindPPFXPass(const PostProcessingPass &pass) override;
+    CFrameBufferObject * GetSSAOHistory(const GLuint &frame) override;
+    void DispatchPPFXConvolution(CShaderProgram *pConvolutionProgram, const PostProcessingEffectMode &mode,
+                                 CFrameBufferObject *pSource, CFrameBufferObject *pDestination,
+                                 const glm::vec2 &direction, const GLboolean &final) override;
+    GLboolean IsPPFXConvolution(const PostProcessingEffectMode &mode) override;
+    CShaderProgram * GetPPFXStackProgram(const std::vector<PostProcessingEffectMode> &effects) override;
+    GLboolean IsPPFXStackable(const PostProcessingEffectMode &mode) override;
+    GLboolean IsPPFXPointwise(const PostProcessingEffectMode &mode) override;
+    GLboolean UsesPPFXStack(const PostProcessingEffectMode &mode) override;
+    CFrameBufferObject * GetPPFXTarget(const GLuint &resource) override;
+    CFrameBufferObject * GetSceneFBO(const FrameBufferType &type) override;
     void ResetFrameBuffer(const GLboolean &clearBuffers = true) override;
     const char * const PostProcessingEffectToString(const PostProcessingEffectMode &mode) override;
     FrameBufferType GetFBOtype(const PostProcessingEffectMode &mode) override;
+    std::vector<GLuint> GetPPFXPrograms(const PostProcessingEffectMode &mode) override;
+    PostProcessingEffectMode GetReadyPPFXMode(const PostProcessingEffectMode &mode) override;
     
     /// Renderer
     void PreRendering() override;
     void Render() override;
     void PostRendering() override;
+    void UpdateScene();
+    void SimulateScene(SceneFrame &frame);
     void RenderScene(const GLboolean &toCustomShader = false, const GLboolean &includeLampsAndSkybox = false, const GLint &toCustomShaderIndex = 4) override;
-    void RenderPBRScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex, const GLfloat zfront, const GLfloat zback) override;
-    void RenderRandomScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex, const GLfloat zfront, const GLfloat zback) override;
+    void RenderPBRScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex) override;
+    void RenderRandomScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex) override;
+    void RenderSceneLayer(CShaderProgram *pShaderProgram, const std::string &layer, const GLboolean &toCustomShader,
+                          const GLint &toCustomShaderIndex, const glm::vec3 &offset) override;
+    void SetSceneProgramUniform(CShaderProgram *pShaderProgram, const GLint &programIndex) override;
     void RenderTerrainScene(CShaderProgram *pShaderProgram, const GLfloat yPos) override;
     
     /// Render Object
@@ -237,11 +253,21 @@ protected:
                         const GLboolean &useHeightMap) override;
     void RenderPrimitive(CShaderProgram *pShaderProgram, IGameObject *object,
                             const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale,
-                            const GLboolean &useTexture = true) override;
+                            const GLboolean &useTexture = true, const GLboolean &cull = true) override;
     void RenderMetalBalls(CShaderProgram *pShaderProgram, const glm::vec3 & position,
                             const glm::vec3 & scale, const GLboolean &useTexture) override;
     void RenderModel(CShaderProgram *pShaderProgram, CModel * model,
-                        const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale);
+                        const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale,
+                        const GLboolean &cull = true);
+    GLboolean IsCulled(IGameObject *object);
+    void SetMatrixUniforms(CShaderProgram *pShaderProgram, const glm::mat4 &model, const glm::mat3 &normalMatrix);
+    void GetSceneObjectBounds(const GLuint &object, const glm::vec3 &offset, glm::vec3 &min, glm::vec3 &max);
+    glm::mat4 GetSceneObjectModel(const GLuint &object, const glm::vec3 &offset);
+    void RenderSceneObject(CShaderProgram *pShaderProgram, const GLuint &object, const glm::vec3 &offset) override;
+    GLint GetIndirectBatch(const std::string &layer, const GLuint &first, const GLuint &count);
+    void RenderSceneIndirect(CShaderProgram *pInstancedProgram, const GLuint &batch, const glm::vec3 &offset);
+    void RenderSceneInstanced(CShaderProgram *pInstancedProgram, CShaderProgram *pShaderProgram,
+                              const std::vector<GLuint> &objects, const glm::vec3 &offset) override;
     
     /// Resources
     void InitialiseResources() override;
@@ -249,9 +275,13 @@ protected:
     
     /// Shaders
     void LoadShaderPrograms(const std::string &path) override;
+    void ReloadChangedShaderPrograms() override;
+    void UpdateShaderFeatures() override;
+    void PrewarmShaderPrograms() override;
+    void UpdateShaderPrograms() override;
     
     /// Shader Uniform
-    void SetTerrainUniform(CShaderProgram *pShaderProgram, const GLboolean &useHeightMap) override;
+    void SetTerrainUniform(CShaderProgram *pShaderProgram) override;
     void SetEnvironmentMapUniform(CShaderProgram *pShaderProgram, const GLboolean &useRefraction) override;
     void SetParallaxMapUniform(CShaderProgram *pShaderProgram, const GLfloat &heightScale) override;
     void SetExplosionUniform(CShaderProgram *pShaderProgram,
@@ -298,14 +328,23 @@ protected:
     void SetMotionBlurUniform(CShaderProgram *pShaderProgram) override;
     void SetDepthMappingUniform(CShaderProgram *pShaderProgram) override;
     void SetVignettingUniform(CShaderProgram *pShaderProgram) override;
+    void SetPostProcessingStackUniform(CShaderProgram *pShaderProgram) override;
     void SetBrightPartsUniform(CShaderProgram *pShaderProgram) override;
     void SetBloomUniform(CShaderProgram *pShaderProgram) override;
+    void SetBloomDownsampleUniform(CShaderProgram *pShaderProgram, const GLboolean &firstLevel) override;
+    void SetBloomUpsampleUniform(CShaderProgram *pShaderProgram, const glm::vec2 &filterRadius) override;
+    void SetConvolutionUniform(CShaderProgram *pShaderProgram, const PostProcessingEffectMode &mode,
+                               const glm::vec2 &direction, const GLboolean &final) override;
     void SetHRDToneMappingUniform(CShaderProgram *pShaderProgram) override;
     void SetLensFlareGhostUniform(CShaderProgram *pShaderProgram) override;
     void SetLensFlareUniform(CShaderProgram *pShaderProgram) override;
     void SetFastApproximateAntiAliasingUniform(CShaderProgram *pShaderProgram) override;
     void SetDeferredRenderingUniform(CShaderProgram *pShaderProgram) override;
-    void SetScreenSpaceAmbientOcclusionUniform(CShaderProgram *pShaderProgram) override;
+    void SetScreenSpaceAmbientOcclusionUniform(CShaderProgram *pShaderProgram, const glm::vec2 &size,
+                                               const GLuint &samples, const GLuint &frame) override;
+    void SetScreenSpaceAmbientOcclusionDownsampleUniform(CShaderProgram *pShaderProgram, const GLint &footprint) override;
+    void SetScreenSpaceAmbientOcclusionTemporalUniform(CShaderProgram *pShaderProgram, const GLuint &samples) override;
+    void SetScreenSpaceAmbientOcclusionUpsampleUniform(CShaderProgram *pShaderProgram) override;
     void SetScreenSpaceAmbientOcclusionBlurUniform(CShaderProgram *pShaderProgram) override;
     void SetScreenSpaceAmbientOcclusionLightingUniform(CShaderProgram *pShaderProgram) override;
     void SetRainDropsUniform(CShaderProgram *pShaderProgram) override;
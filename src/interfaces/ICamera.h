@@ -13,12 +13,14 @@
 
 #include "../camera/Camera.h"
 #include "../shaders/ShaderProgram.h"
+#include "../buffers/UniformBufferObject.h"
 
 struct ICamera {
     CCamera *m_pCamera;
+    CUniformBufferObject *m_pCameraUBO;
     GLfloat m_viewPointAngle;
     virtual void InitialiseCamera(const GLuint &width, const GLuint &height, const glm::vec3 &position) = 0;
-    virtual void SetCameraUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, CCamera *camera) = 0;
+    virtual void UpdateCameraUniformBlock(CCamera *camera) = 0;
     virtual void UpdateCamera(const GLdouble & deltaTime, const MouseState &mouseState, const KeyboardState &keyboardState,
                             const GLboolean & mouseMove) = 0;
     virtual void ResetCamera(const GLdouble & deltaTime) = 0;
@@ -13,14 +13,29 @@
 
 #include "../utilities/Transform.h"
 
+class CInstanceBuffer;
+struct GeometryRange;
+
 class IGameObject {
 public:
     //GameObject();
-    //virtual ~GameObject() = default;
+    virtual ~IGameObject() = default;
     virtual void Render(const GLboolean &useTexture) = 0;
     virtual void Transform(const glm::vec3 &position, const glm::vec3 &rotation, const glm::vec3 &scale) = 0;
+    // draws count instances starting at first in the instance buffer, false when the object can not be instanced
+    virtual GLboolean RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count) { return false; }
+    // object space box around the object before its transform, false when it has none and can not be culled
+    virtual GLboolean GetBounds(glm::vec3 &min, glm::vec3 &max) const { return false; }
+    // a few object space triangles inside the object for the occlusion buffer, counter clockwise from the side
+    // they hide things on, false when the object hides nothing
+    virtual GLboolean GetOccluder(std::vector<glm::vec3> &triangles) const { return false; }
+    // where the object draws from, vertices laid out as Vertex and unsigned int indices, see GeometryRange,
+    // false when the geometry can not be shared
+    virtual GLboolean GetGeometry(GeometryRange &geometry) const { return false; }
     
     glm::mat4 Model() const { return transform.GetModel(); }
+    // places the object with a model matrix made earlier instead of Transform
+    void SetModel(const glm::mat4 &model) { transform.SetMatrix(model); }
 protected:
     virtual void Release() = 0;
     CTransform transform;
@@ -12,6 +12,7 @@
 #define ILights_h
 
 #include "../lighting/Lighting.h"
+#include "../buffers/UniformBufferObject.h"
 
 struct ILights
 {
@@ -22,6 +23,10 @@ struct ILights
     GLfloat m_specular;
     GLboolean m_useBlinn;
     
+    // per frame blocks shared by all programs
+    CUniformBufferObject *m_pLightsUBO;
+    CUniformBufferObject *m_pShadowUBO;
+    
     // HDR
     GLfloat m_exposure, m_gama;
     GLboolean m_HDR;
@@ -33,21 +38,18 @@ struct ILights
     GLfloat m_exponent;
     
     // Directional Light
-    std::string m_dirName;
     GLboolean m_useDir;
     glm::vec3 m_dirColor;
     GLfloat m_dirIntensity;
     glm::vec3 m_directionalLightDirection;
     
     // Point Light
-    std::string m_pointName;
     GLboolean m_usePoint;
     GLfloat m_pointIntensity;
     GLuint m_pointLightIndex = 0;
     std::vector<std::tuple<glm::vec3, glm::vec4>> m_pointLights;
     
     // Spot Light
-    std::string m_spotName;
     GLboolean m_useSpot;
     GLboolean m_useSmoothSpot;
     glm::vec3 m_spotColor;
@@ -56,23 +58,12 @@ struct ILights
     GLfloat m_spotOuterCutOff;
     
     // Uniform
-    virtual void SetLightUniform(CShaderProgram *pShaderProgram, const GLboolean &useDir, const GLboolean &usePoint,
-                                 const GLboolean &useSpot, const GLboolean &useSmoothSpot, const GLboolean& useBlinn) = 0;
-    virtual void SetHRDLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
-                                    const GLfloat & exposure, const GLfloat & gamma, const GLboolean &useHDR) = 0;
-    virtual void SetDirectionalLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
-                                            const DirectionalLight& directionalLight, const glm::vec3& direction, const glm::vec3 &position) = 0;
-    virtual void SetPointLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, const PointLight& pointLight) = 0;
-    virtual void SetSpotLightUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, const SpotLight& spotLight,
-                                     CCamera *camera) = 0;
-    virtual void SetShadowUniform(CShaderProgram *pShaderProgram, const std::string &uniformName, const GLfloat &bias) = 0;
-    virtual void SetShadowMatrix(CShaderProgram *pShaderProgram, const glm::vec3 &lightPosition) = 0;
-    virtual void RenderLight(CShaderProgram *pShaderProgram,
-                                const std::string &dirName,
-                                const std::string &pointName,
-                                const std::string &spotName,
-                                CCamera *camera,
-                                const GLboolean &useShadowMatrix) = 0;
+    virtual void InitialiseLights() = 0;
+    virtual void SetHRDLightUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName,
+                                    const GLfloat & exposure, const GLfloat & gamma) = 0;
+    virtual void SetShadowUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName, const GLfloat &bias) = 0;
+    virtual void UpdateLightUniformBlock(CCamera *camera) = 0;
+    virtual void UpdateShadowUniformBlock(const glm::vec3 &lightPosition) = 0;
     virtual void RenderLamp(CShaderProgram *pShaderProgram, const glm::vec3 &position, const glm::vec3 & scale) = 0;
 };
 
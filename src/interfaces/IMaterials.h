@@ -19,14 +19,14 @@ struct IMaterials {
     GLboolean m_useIrradianceMap, m_materialUseTexture, m_materialUseColor, m_useIrradiance;
     GLboolean m_useFog;
     glm::vec3 m_fogColor;
-    virtual void SetMaterialUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
+    virtual void SetMaterialUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName,
                                     const glm::vec4 &color, const GLfloat &shininess,
                                     const GLfloat &uvTiling, const GLboolean &useAO, const glm::vec4 &guiColor) = 0;
-    virtual void SetPBRMaterialUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
+    virtual void SetPBRMaterialUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName,
                                        const GLfloat &albedo, const GLfloat &metallic, const GLfloat &roughness,
                                        const GLfloat &ao, const GLboolean &useIrradiance) = 0;
-    virtual void SetFogMaterialUniform(CShaderProgram *pShaderProgram, const std::string &uniformName,
-                                        const glm::vec3 &color, const GLboolean &bUseFog) = 0;
+    virtual void SetFogMaterialUniform(CShaderProgram *pShaderProgram, const CUniformName &uniformName,
+                                        const glm::vec3 &color) = 0;
 };
 
 #endif /* IMaterials_h */
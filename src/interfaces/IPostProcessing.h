@@ -14,15 +14,34 @@
 #include "../utilities/PostProcessingEffectMode.h"
 #include "../shaders/ShaderProgram.h"
 #include "../buffers/FrameBufferObject.h"
+#include "../buffers/PostProcessingGraph.h"
+#include "../buffers/RenderTargetPool.h"
+#include "../timer/HighResolutionTimer.h"
+#include "../timer/GPUTimer.h"
+#include "../utilities/SSAOQuality.h"
 
 struct IPostProcessing {
     PostProcessingEffectMode m_currentPPFXMode;
     CFrameBufferObject *currentFBO;
-    std::vector<CFrameBufferObject*> m_pFBOs;
+    CRenderTargetPool m_ppfxTargets; // scene and graph targets, kept across effect switches
+    CRenderGraph m_ppfxGraph;
+    PostProcessingEffectMode m_ppfxGraphMode;
+    GLuint m_ppfxPyramidLevels; // mip chain shared by blur, bloom and lens flare
+    GLboolean m_ppfxCompute; // convolution effects run as compute shaders
+    CHighResolutionTimer m_ppfxSwitchTimer;
+    GLboolean m_ppfxSwitching;
+    GLuint m_ppfxSwitchAllocations;
     GLboolean m_changePPFXMode, m_prevPPFXMode, m_nextPPFXMode;
     GLuint m_PPFXOption;
     GLfloat m_coverage;
     
+    // Effect stack, runs of pointwise effects are fused into one generated pass
+    std::vector<PostProcessingEffectMode> m_ppfxStack;
+    GLboolean m_ppfxStackChanged;
+    std::map<std::string, GLuint> m_ppfxStackPrograms; // generated programs by their PPFX_STACK define, indices into the shader programs
+    GLuint m_ppfxStackPasses, m_ppfxStackSaved;
+    GLfloat m_ppfxStackBandwidth, m_ppfxStackFusedBandwidth; // MB read and written a frame, one pass per effect and fused
+    
     // Screen Wave
     GLfloat m_screenWaveOffset;
     
@@ -101,6 +120,12 @@ struct IPostProcessing {
     GLuint m_ssaoKernelSamples, m_ssaoNoiseSamples;
     GLfloat m_ssaoBias, m_ssaoRadius, m_ssaoNoiseSize;
     GLboolean m_ssaoNoiseUseLight;
+    GLuint m_ssaoQuality; // SSAOQuality, the graph is built again when it changes
+    GLboolean m_ssaoQualityChanged;
+    GLuint m_ssaoFrame; // selects the kernel samples and the history target of the temporal tiers
+    GLboolean m_ssaoHistoryValid;
+    glm::mat4 m_ssaoPreviousView;
+    CGPUTimer m_ssaoTimers[static_cast<GLuint>(SSAOQuality::NumberOfTiers)];
     
     // Depth and Shadow Mapping
     GLboolean m_isOrthographicCamera, m_fromLightPosition, m_showDepth;
@@ -114,9 +139,25 @@ struct IPostProcessing {
     virtual void RenderToScreen(CShaderProgram *pShaderProgram, const FrameBufferType &fboType,
                                 const GLuint &bufferIndex, const TextureType &textureType, const GLboolean &useAO) = 0;
     virtual void RenderPPFX(const PostProcessingEffectMode &mode) = 0;
+    virtual void BuildPPFXGraph(CRenderGraph &graph, const PostProcessingEffectMode &mode) = 0;
+    virtual PostProcessingGraphSettings GetPPFXGraphSettings() = 0;
+    virtual std::function<void()> BindPPFXPass(const PostProcessingPass &pass) = 0;
+    virtual CFrameBufferObject * GetSSAOHistory(const GLuint &frame) = 0;
+    virtual void DispatchPPFXConvolution(CShaderProgram *pConvolutionProgram, const PostProcessingEffectMode &mode,
+                                         CFrameBufferObject *pSource, CFrameBufferObject *pDestination,
+                                         const glm::vec2 &direction, const GLboolean &final) = 0;
+    virtual GLboolean IsPPFXConvolution(const PostProcessingEffectMode &mode) = 0;
+    virtual CShaderProgram * GetPPFXStackProgram(const std::vector<PostProcessingEffectMode> &effects) = 0;
+    virtual GLboolean IsPPFXStackable(const PostProcessingEffectMode &mode) = 0;
+    virtual GLboolean IsPPFXPointwise(const PostProcessingEffectMode &mode) = 0;
+    virtual GLboolean UsesPPFXStack(const PostProcessingEffectMode &mode) = 0;
+    virtual CFrameBufferObject * GetPPFXTarget(const GLuint &resource) = 0;
+    virtual CFrameBufferObject * GetSceneFBO(const FrameBufferType &type) = 0;
     virtual void ResetFrameBuffer(const GLboolean &clearBuffers) = 0;
     virtual const char * const PostProcessingEffectToString(const PostProcessingEffectMode &mode) = 0;
     virtual FrameBufferType GetFBOtype(const PostProcessingEffectMode &mode) = 0;
+    virtual std::vector<GLuint> GetPPFXPrograms(const PostProcessingEffectMode &mode) = 0;
+    virtual PostProcessingEffectMode GetReadyPPFXMode(const PostProcessingEffectMode &mode) = 0;
 };
 
 #endif /* IPostProcessing_h */
@@ -23,9 +23,12 @@ struct IRenderObject
     virtual void ResetSkyBox(CShaderProgram *pShaderProgram) = 0;
     virtual void RenderTerrain(CShaderProgram *pShaderProgram, const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale, const GLboolean &useHeightMap) = 0;
     virtual void RenderPrimitive(CShaderProgram *pShaderProgram, IGameObject *object, const glm::vec3 & position,
-                                const glm::vec3 & rotation, const glm::vec3 & scale, const GLboolean &useTexture) = 0;
+                                const glm::vec3 & rotation, const glm::vec3 & scale, const GLboolean &useTexture, const GLboolean &cull) = 0;
     virtual void RenderMetalBalls(CShaderProgram *pShaderProgram, const glm::vec3 & position,
                                   const glm::vec3 & scale, const GLboolean &useTexture) = 0;
+    virtual void RenderSceneObject(CShaderProgram *pShaderProgram, const GLuint &object, const glm::vec3 &offset) = 0;
+    virtual void RenderSceneInstanced(CShaderProgram *pInstancedProgram, CShaderProgram *pShaderProgram,
+                                      const std::vector<GLuint> &objects, const glm::vec3 &offset) = 0;
 };
 
 #endif /* IRenderObject_h */
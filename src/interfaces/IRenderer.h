@@ -19,8 +19,13 @@ struct IRenderer
     virtual void Render() = 0;
     virtual void PostRendering() = 0;
     virtual void RenderScene(const GLboolean &toCustomShader, const GLboolean &includeLampsAndSkybox, const GLint &toCustomShaderIndex) = 0;
-    virtual void RenderPBRScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex, const GLfloat zfront, const GLfloat zback) = 0;
-    virtual void RenderRandomScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex, const GLfloat zfront, const GLfloat zback) = 0;
+    virtual void RenderPBRScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex) = 0;
+    virtual void RenderRandomScene(CShaderProgram *pShaderProgram, const GLboolean &toCustomShader, const GLint &toCustomShaderIndex) = 0;
+    // draws the objects of a scene store layer, moved by offset
+    virtual void RenderSceneLayer(CShaderProgram *pShaderProgram, const std::string &layer, const GLboolean &toCustomShader,
+                                  const GLint &toCustomShaderIndex, const glm::vec3 &offset) = 0;
+    // sets the uniforms an effect program of the scene store needs before its objects are drawn
+    virtual void SetSceneProgramUniform(CShaderProgram *pShaderProgram, const GLint &programIndex) = 0;
     virtual void RenderTerrainScene(CShaderProgram *pShaderProgram, const GLfloat yPos) = 0;
 };
 
@@ -16,7 +16,7 @@
 struct IShaderUniform {
     GLboolean m_useRefraction;
     GLfloat m_parallaxHeightScale, m_uvTiling, m_magnitude;
-    virtual void SetTerrainUniform(CShaderProgram *pShaderProgram, const GLboolean &useHeightMap) = 0;
+    virtual void SetTerrainUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetEnvironmentMapUniform(CShaderProgram *pShaderProgram, const GLboolean &useRefraction) = 0;
     virtual void SetParallaxMapUniform(CShaderProgram *pShaderProgram, const GLfloat &heightScale) = 0;
     virtual void SetExplosionUniform(CShaderProgram *pShaderProgram,
@@ -63,14 +63,23 @@ struct IShaderUniform {
     virtual void SetMotionBlurUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetDepthMappingUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetVignettingUniform(CShaderProgram *pShaderProgram) = 0;
+    virtual void SetPostProcessingStackUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetBrightPartsUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetBloomUniform(CShaderProgram *pShaderProgram) = 0;
+    virtual void SetBloomDownsampleUniform(CShaderProgram *pShaderProgram, const GLboolean &firstLevel) = 0;
+    virtual void SetBloomUpsampleUniform(CShaderProgram *pShaderProgram, const glm::vec2 &filterRadius) = 0;
+    virtual void SetConvolutionUniform(CShaderProgram *pShaderProgram, const PostProcessingEffectMode &mode,
+                                       const glm::vec2 &direction, const GLboolean &final) = 0;
     virtual void SetHRDToneMappingUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetLensFlareGhostUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetLensFlareUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetFastApproximateAntiAliasingUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetDeferredRenderingUniform(CShaderProgram *pShaderProgram) = 0;
-    virtual void SetScreenSpaceAmbientOcclusionUniform(CShaderProgram *pShaderProgram) = 0;
+    virtual void SetScreenSpaceAmbientOcclusionUniform(CShaderProgram *pShaderProgram, const glm::vec2 &size,
+                                                       const GLuint &samples, const GLuint &frame) = 0;
+    virtual void SetScreenSpaceAmbientOcclusionDownsampleUniform(CShaderProgram *pShaderProgram, const GLint &footprint) = 0;
+    virtual void SetScreenSpaceAmbientOcclusionTemporalUniform(CShaderProgram *pShaderProgram, const GLuint &samples) = 0;
+    virtual void SetScreenSpaceAmbientOcclusionUpsampleUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetScreenSpaceAmbientOcclusionBlurUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetScreenSpaceAmbientOcclusionLightingUniform(CShaderProgram *pShaderProgram) = 0;
     virtual void SetRainDropsUniform(CShaderProgram *pShaderProgram) = 0;
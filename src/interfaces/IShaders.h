@@ -15,7 +15,14 @@
 
 struct IShaders {
     std::vector <CShaderProgram *> *m_pShaderPrograms;
+    GLdouble m_shaderWatchTime;
+    GLboolean m_shaderPrewarmStarted;
+    std::string m_shaderPath; // where the shader files are, for the programs generated while running
     virtual void LoadShaderPrograms(const std::string &path) = 0;
+    virtual void ReloadChangedShaderPrograms() = 0;
+    virtual void UpdateShaderFeatures() = 0;
+    virtual void PrewarmShaderPrograms() = 0;
+    virtual void UpdateShaderPrograms() = 0;
 };
 
 #endif /* IShaders_h */
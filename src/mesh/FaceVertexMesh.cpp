@@ -1,8 +1,10 @@
 #include "FaceVertexMesh.h"
-#define BUFFER_OFFSET(i) ((char *)NULL + (i))
+#include "../buffers/GeometryArena.h"
 
 CFaceVertexMesh::CFaceVertexMesh()
-{}
+{
+    m_uiGeometry = 0;
+}
 
 CFaceVertexMesh::~CFaceVertexMesh()
 {
@@ -70,57 +72,22 @@ bool CFaceVertexMesh::CreateFromTriangleList(const std::vector<Vertex> &vertices
 	ComputeVertexNormals();
 	ComputeTextureCoordsXZ(20.0f, 20.0f);
 	
-	// Create a VAO 
-	glGenVertexArrays(1, &m_uiVAO);
-	glBindVertexArray(m_uiVAO);
-
-	// Create a VBO for the vertex data
-	glGenBuffers(1, &m_uiVBOVertices);
-	glBindBuffer(GL_ARRAY_BUFFER, m_uiVBOVertices);
-
-	// Fill the vertices VBO
-	glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), &m_vertices[0], GL_STATIC_DRAW);
-
-	// Generate a VGO for the indices and bind it
-	glGenBuffers(1, &m_uiVBOIndices);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uiVBOIndices);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * m_triangles.size(), &m_triangles[0], GL_STATIC_DRAW);
-
-    //vertex
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), 0);
+	// Copy the vertices and indices into the shared buffers, replacing the ones of an earlier list
+	CGeometryArena::Instance().Free(m_uiGeometry);
+	m_uiGeometry = CGeometryArena::Instance().Allocate(VertexLayout::Standard, &m_vertices[0], (GLuint) m_vertices.size(),
+	                                                   &m_triangles[0], (GLuint) m_triangles.size());
     
-    //texcoord
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE,  sizeof(Vertex), (const GLvoid*)12);
-    
-    //normal
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE,  sizeof(Vertex), (const GLvoid*)20);
-    
-    //tangent
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE,  sizeof(Vertex), (const GLvoid*)32);
-    
-    //bitangent
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)44);
-    
-    
-	return true;
+	return m_uiGeometry != 0;
 }
 
 void CFaceVertexMesh::Render()
 {
-	glBindVertexArray(m_uiVAO);
-
 	// Draw
-	glDrawElements(GL_TRIANGLES, m_triangles.size(), GL_UNSIGNED_INT, BUFFER_OFFSET(0));
+	CGeometryArena::Instance().Draw(m_uiGeometry);
 
 }
 
 void CFaceVertexMesh::Release() {
-    glDeleteVertexArrays(1, &m_uiVAO);
-    glDeleteBuffers(1, &m_uiVBOVertices);
-    glDeleteBuffers(1, &m_uiVBOIndices);
+    CGeometryArena::Instance().Free(m_uiGeometry);
+    m_uiGeometry = 0;
 }
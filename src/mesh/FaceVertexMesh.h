@@ -21,7 +21,5 @@ private:
 	std::vector<Vertex> m_vertices;			// A list of vertices
 	std::vector<unsigned int> m_triangles;		// Stores vertex IDs -- every three makes a triangle
 	std::vector<TriangleList> m_onTriangle;	// For each vertex, stores a list of triangle IDs saying which triangles the vertex is on
-	GLuint m_uiVAO;
-    GLuint m_uiVBOVertices;
-    GLuint m_uiVBOIndices;
+	GLuint m_uiGeometry;	// handle in CGeometryArena
 };
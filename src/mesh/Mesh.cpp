@@ -1,11 +1,11 @@
 
 #include "Mesh.h"
+#include "../window/GLState.h"
+#include "../buffers/GeometryArena.h"
 
 Mesh::Mesh()
 {
-    m_vao = INVALID_OGL_VALUE;
-    m_vbo = INVALID_OGL_VALUE;
-    m_ibo = INVALID_OGL_VALUE;
+    m_geometry = 0;
     m_numIndices, m_numFaces = 0;
     m_vertices.clear();
     m_textures.clear();
@@ -14,9 +14,7 @@ Mesh::Mesh()
 };
 
 Mesh::Mesh(const Mesh &other) {
-    this -> m_vao = other.m_vao;
-    this -> m_vbo = other.m_vbo;
-    this -> m_ibo = other.m_ibo;
+    this -> m_geometry = other.m_geometry;
     this -> m_numIndices = other.m_numIndices;
     this -> m_numFaces = other.m_numFaces;
     this -> m_materialIndex = other.m_materialIndex;
@@ -25,9 +23,7 @@ Mesh::Mesh(const Mesh &other) {
 }
 
 Mesh &Mesh::operator=(const Mesh &other){
-    this -> m_vao = other.m_vao;
-    this -> m_vbo = other.m_vbo;
-    this -> m_ibo = other.m_ibo;
+    this -> m_geometry = other.m_geometry;
     this -> m_numIndices = other.m_numIndices;
     this -> m_numFaces = other.m_numFaces;
     this -> m_materialIndex = other.m_materialIndex;
@@ -64,40 +60,10 @@ Mesh::Mesh(const std::vector<Vertex>& Vertices,
 
      */
     
-    glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
-    
-
-    glGenBuffers(1, &m_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * Vertices.size(), &Vertices[0], GL_STATIC_DRAW);
-
-    glGenBuffers(1, &m_ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * m_numIndices, &Indices[0], GL_STATIC_DRAW);
-
-
-    //vertex
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), 0);
-    
-    //texcoord
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE,  sizeof(Vertex), (const GLvoid*)12);
-    
-    //normal
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE,  sizeof(Vertex), (const GLvoid*)20);
-    
-    //tangent
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE,  sizeof(Vertex), (const GLvoid*)32);
-    
-    //bitangent
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)44);
-    
-    glBindVertexArray(0);
+    // the vertices and indices go into ranges of the buffers every static mesh shares, vertex, texcoord,
+    // normal, tangent and bitangent are set up once on the VAO of the layout
+    m_geometry = CGeometryArena::Instance().Allocate(VertexLayout::Standard, &Vertices[0], static_cast<GLuint>(Vertices.size()),
+                                                     &Indices[0], m_numIndices);
 }
 
 void Mesh::Render(CShaderProgram *pShaderProgram, const GLboolean &useTexture) {
@@ -113,16 +79,24 @@ void Mesh::Render(CShaderProgram *pShaderProgram, const GLboolean &useTexture) {
     }
 
     // draw mesh
-    glBindVertexArray(m_vao);
-    
-    glDrawElements(GL_TRIANGLES, m_numIndices, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    CGeometryArena::Instance().Draw(m_geometry);
     
     // always good practice to set everything back to defaults once configured.
-    glActiveTexture(GL_TEXTURE0);
+    CGLState::Instance().ActiveTexture(0);
     
 }
 
+void Mesh::RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count) {
+    CGeometryArena::Instance().DrawInstanced(m_geometry, instances, first, count);
+}
+
+void Mesh::GetBounds(glm::vec3 &min, glm::vec3 &max) const {
+    for (const Vertex &vertex : m_vertices) {
+        min = glm::min(min, vertex.position);
+        max = glm::max(max, vertex.position);
+    }
+}
+
 // Release memory on the GPU
 void Mesh::Release()
 {
@@ -134,14 +108,7 @@ void Mesh::Release()
     }
     m_textures.clear();
     
-    glDeleteVertexArrays(1, &m_vao);
-    
-    if (m_vbo != INVALID_OGL_VALUE)
-        glDeleteBuffers(1, &m_vbo);
-    //m_vbo.Release();
-    
-    
-    if (m_ibo != INVALID_OGL_VALUE)
-        glDeleteBuffers(1, &m_ibo);
-    //m_ebo.Release();
+    // the handle could be given to another mesh once freed, so it is only freed once
+    CGeometryArena::Instance().Free(m_geometry);
+    m_geometry = 0;
 }
@@ -31,12 +31,13 @@ public:
           const GLuint & numFaces
     );
     void Render(CShaderProgram *pShaderProgram, const GLboolean &useTexture = true);
+    void RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count);
+    // grows min and max to contain every vertex of the mesh
+    void GetBounds(glm::vec3 &min, glm::vec3 &max) const;
     void Release();
 
 private:
-    GLuint m_vao;
-    GLuint m_vbo;
-    GLuint m_ibo;
+    GLuint m_geometry;  // handle in CGeometryArena, shared by the copies of the mesh
     GLuint m_numIndices;
     GLuint m_numFaces;
     std::vector<Vertex> m_vertices;
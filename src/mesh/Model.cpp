@@ -415,6 +415,24 @@ void CModel::RenderWithMeshTexture(CShaderProgram *pShaderProgram, const GLboole
     }
 }
 
+// the textures are bound by whoever groups the instances
+GLboolean CModel::RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count) {
+    for (unsigned int i = 0 ; i < m_meshes.size(); i++) {
+        m_meshes[i]->RenderInstanced(instances, first, count);
+    }
+    return true;
+}
+
+GLboolean CModel::GetBounds(glm::vec3 &min, glm::vec3 &max) const {
+    min = glm::vec3(std::numeric_limits<float>::max());
+    max = glm::vec3(-std::numeric_limits<float>::max());
+    for (unsigned int i = 0 ; i < m_meshes.size(); i++) {
+        m_meshes[i]->GetBounds(min, max);
+    }
+    if (m_meshes.empty()) min = max = glm::vec3(0.0f);
+    return !m_meshes.empty();
+}
+
 void CModel::Render(const GLboolean &useTexture) {}
 
 void CModel::Release()
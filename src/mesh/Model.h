@@ -18,6 +18,9 @@ public:
     glm::mat4 Model() const { return transform.GetModel(); }
     void Render(CShaderProgram *pShaderProgram, const GLboolean &useTexture = true);
     void RenderWithMeshTexture(CShaderProgram *pShaderProgram, const GLboolean &useTexture = true);
+    GLboolean RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count) override;
+    // object space box around all the meshes of the model
+    GLboolean GetBounds(glm::vec3 &min, glm::vec3 &max) const override;
     void Release();
 private:
     /*  Model Data */
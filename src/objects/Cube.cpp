@@ -7,6 +7,7 @@
 //
 
 #include "Cube.h"
+#include "../window/GLState.h"
 
 #define _USE_MATH_DEFINES
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
@@ -42,7 +43,7 @@ void CCube::Create(const std::string &directory, const std::map<std::string, Tex
     
     // make and bind the VAO
     glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
 
     m_vbo.Create();
     m_vbo.Bind();
@@ -300,28 +301,8 @@ void CCube::Create(const std::string &directory, const std::map<std::string, Tex
 
     m_numTriangles = cubeVertices.size();
    
-    // 4 vector3 plus 1 vector2
-    // https://stackoverflow.com/questions/22296510/what-does-stride-mean-in-opengles
-    // https://www.opengl.org/discussion_boards/showthread.php/156620-glVertexPointer-Stride
-	GLsizei stride = (4 * sizeof(glm::vec3)) + sizeof(glm::vec2);
-
-	// Vertex positions
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, 0);
-	// Texture coordinates
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)sizeof(glm::vec3));
-	// Normal vectors
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3) + sizeof(glm::vec2)));
-    
-    // Tangents
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)));
-    
-    // Bitangents
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)+sizeof(glm::vec3)));
+    // laid out as Vertex, the same attributes as the meshes of the geometry arena
+    CGeometryArena::SetVertexAttributes(VertexLayout::Standard);
 }
 
 void CCube::Transform(const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale) {
@@ -337,7 +318,7 @@ void CCube::Transform(const glm::vec3 & position, const glm::vec3 & rotation, co
 void CCube::Render(const GLboolean &useTexture)
 {
     // bind the VAO (the triangle)
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     if (useTexture){
         for (GLuint i = 0; i < m_textures.size(); ++i){
@@ -346,10 +327,57 @@ void CCube::Render(const GLboolean &useTexture)
     }
     glDrawArrays( GL_TRIANGLES, 0, m_numTriangles ); // draw the vertixes
     
-    glBindVertexArray(0);
+    CGLState::Instance().BindVertexArray(0);
     
 }
 
+// Render count instances of the cube, the textures are bound by whoever groups the instances
+GLboolean CCube::RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count)
+{
+    instances.Bind(m_vao, first);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, m_numTriangles, count);
+    CGLState::Instance().BindVertexArray(0);
+    return true;
+}
+
+// The cube reaches its size from the origin on every axis
+GLboolean CCube::GetBounds(glm::vec3 &min, glm::vec3 &max) const
+{
+    min = glm::vec3(-size);
+    max = glm::vec3(size);
+    return true;
+}
+
+// The cube draws its vertices as plain triangles
+GLboolean CCube::GetGeometry(GeometryRange &geometry) const
+{
+    geometry.vertexArray = 0;
+    geometry.vertexBuffer = m_vbo.GetBuffer();
+    geometry.vertexOffset = 0;
+    geometry.vertexSize = m_numTriangles * sizeof(Vertex);
+    geometry.indexBuffer = 0;
+    geometry.indexOffset = 0;
+    geometry.count = m_numTriangles;
+    geometry.mode = GL_TRIANGLES;
+    return true;
+}
+
+// The cube is solid, its twelve faces hide what is behind them, counter clockwise seen from outside
+GLboolean CCube::GetOccluder(std::vector<glm::vec3> &triangles) const
+{
+    const glm::vec3 corners[8] = {
+        glm::vec3(-size, -size, -size), glm::vec3(size, -size, -size), glm::vec3(size, size, -size), glm::vec3(-size, size, -size),
+        glm::vec3(-size, -size, size), glm::vec3(size, -size, size), glm::vec3(size, size, size), glm::vec3(-size, size, size)
+    };
+    const GLuint faces[6][4] = { {3, 2, 1, 0}, {6, 7, 4, 5}, {7, 3, 0, 4}, {2, 6, 5, 1}, {7, 6, 2, 3}, {0, 1, 5, 4} };
+    for (GLuint i = 0; i < 6; ++i) {
+        const GLuint *face = faces[i];
+        triangles.insert(triangles.end(), { corners[face[0]], corners[face[1]], corners[face[2]],
+                                            corners[face[0]], corners[face[2]], corners[face[3]] });
+    }
+    return true;
+}
+
 // Release memory on the GPU 
 void CCube::Release()
 {
@@ -359,7 +387,7 @@ void CCube::Release()
     }
     m_textures.clear();
     
-    glDeleteVertexArrays(1, &m_vao);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vao);
     
     m_vbo.Release();
     
@@ -19,6 +19,10 @@ public:
                    const glm::vec3 & scale = glm::vec3(1, 1, 1));
     
     void Render(const GLboolean &useTexture = true);
+    GLboolean RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count) override;
+    GLboolean GetBounds(glm::vec3 &min, glm::vec3 &max) const override;
+    GLboolean GetGeometry(GeometryRange &geometry) const override;
+    GLboolean GetOccluder(std::vector<glm::vec3> &triangles) const override;
     GLfloat GetSize() const { return size; }
     void Release();
     
@@ -7,6 +7,7 @@
 //
 
 #include "EquirectangularCube.h"
+#include "../window/GLState.h"
 
 #define _USE_MATH_DEFINES
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
@@ -88,7 +89,7 @@ void CEquirectangularCube::Create(const std::string &directory, const std::map<s
     m_numTriangles = 36;
     
     glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     glGenBuffers(1, &m_vbo);
     glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
@@ -107,7 +108,7 @@ void CEquirectangularCube::Create(const std::string &directory, const std::map<s
     glEnableVertexAttribArray(2);
     glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(5 * sizeof(float)));
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    CGLState::Instance().BindVertexArray(0);
     
 }
 
@@ -124,7 +125,7 @@ void CEquirectangularCube::Transform(const glm::vec3 & position, const glm::vec3
 void CEquirectangularCube::Render(const GLboolean &useTexture)
 {
     // bind the VAO (the triangle)
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     if (useTexture){
         for (GLuint i = 0; i < m_textures.size(); ++i){
@@ -133,7 +134,7 @@ void CEquirectangularCube::Render(const GLboolean &useTexture)
     }
     glDrawArrays( GL_TRIANGLES, 0, m_numTriangles ); // draw the vertixes
     
-    glBindVertexArray(0);
+    CGLState::Instance().BindVertexArray(0);
     
 }
 
@@ -146,7 +147,7 @@ void CEquirectangularCube::Release()
     }
     m_textures.clear();
     
-    glDeleteVertexArrays(1, &m_vao);
-    glDeleteVertexArrays(1, &m_vbo);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vao);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vbo);
     
 }
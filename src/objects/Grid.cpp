@@ -1,5 +1,6 @@
 
 #include "Grid.h"
+#include "../window/GLState.h"
 
 CGrid::CGrid()
 {
@@ -21,7 +22,7 @@ void CGrid::Create(float fWidth, float fHeight, int iLines)
 
 	// Use VAO to store state associated with vertices
 	glGenVertexArrays(1, &m_vao);
-	glBindVertexArray(m_vao);
+	CGLState::Instance().BindVertexArray(m_vao);
 
 	// Create a VBO
 	m_vbo.Create();
@@ -104,13 +105,13 @@ void CGrid::Render(const GLboolean &useTexture)
 		return;
 
 	glLineWidth(1.0);
-	glBindVertexArray(m_vao);
+	CGLState::Instance().BindVertexArray(m_vao);
 	glDrawArrays(GL_LINES, 0, m_iVertices);
 }
 
 // Release resources
 void CGrid::Release()
 {
-	glDeleteVertexArrays(1, &m_vao);
+	CGLState::Instance().DeleteVertexArrays(1, &m_vao);
 	m_vbo.Release();
 }
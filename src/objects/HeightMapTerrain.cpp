@@ -99,6 +99,8 @@ GLboolean CHeightMapTerrain::Create(const char *terrainFilename, const std::map<
 	m_origin = origin;
 	m_terrainSizeX = terrainSizeX;
 	m_terrainSizeZ = terrainSizeZ;
+	m_boundsMin = glm::vec3(std::numeric_limits<float>::max());
+	m_boundsMax = glm::vec3(-std::numeric_limits<float>::max());
 	
 	// Allocate memory and initialize to store the image
 	m_heightMap = new float[m_width * m_height];
@@ -133,6 +135,8 @@ GLboolean CHeightMapTerrain::Create(const char *terrainFilename, const std::map<
 			// Scale the terrain and store for later
 			pWorld.y *= terrainHeightScale;	 
 			m_heightMap[index] = pWorld.y;
+			m_boundsMin = glm::min(m_boundsMin, pWorld);
+			m_boundsMax = glm::max(m_boundsMax, pWorld);
 
 			// Store the point in a vector
 			Vertex v = Vertex(pWorld, glm::vec2(0.0, 0.0), glm::vec3(0.0, 0.0, 0.0), glm::vec3(0.0, 0.0, 0.0), glm::vec3(0.0, 0.0, 0.0));
@@ -158,6 +162,7 @@ GLboolean CHeightMapTerrain::Create(const char *terrainFilename, const std::map<
 
 	// Create a face vertex mesh
 	m_mesh.CreateFromTriangleList(vertices, triangles);
+	CreateOccluder(32);
 
     // Load a texture for texture mapping the mesh
     m_textureFileNames = textureFilenames;
@@ -233,6 +238,60 @@ GLboolean CHeightMapTerrain::IsHeightMapRendered() {
     return m_isRendered;
 }
 
+// The mesh is built in world coordinates, so its box is the one found while reading the heights
+GLboolean CHeightMapTerrain::GetBounds(glm::vec3 &min, glm::vec3 &max) const
+{
+    min = m_boundsMin;
+    max = m_boundsMax;
+    return m_heightMap != nullptr;
+}
+
+GLboolean CHeightMapTerrain::GetOccluder(std::vector<glm::vec3> &triangles) const
+{
+    triangles.insert(triangles.end(), m_occluder.begin(), m_occluder.end());
+    return !m_occluder.empty();
+}
+
+// A coarse grid over the terrain, every grid point is as low as the lowest height around it so the grid stays
+// under the real surface and never hides anything the terrain does not
+void CHeightMapTerrain::CreateOccluder(const GLint &cells)
+{
+    m_occluder.clear();
+    if (m_width < 2 || m_height < 2) return;
+    
+    std::vector<float> lowest((cells + 1) * (cells + 1), std::numeric_limits<float>::max());
+    for (int z = 0; z < m_height; z++) {
+        for (int x = 0; x < m_width; x++) {
+            // the texel belongs to the cell it is in and to the grid points on the corners of that cell
+            int cellX = std::min(x * cells / (m_width - 1), cells - 1);
+            int cellZ = std::min(z * cells / (m_height - 1), cells - 1);
+            float height = m_heightMap[x + z * m_width];
+            for (int corner = 0; corner < 4; corner++) {
+                int index = (cellX + (corner & 1)) + (cellZ + (corner >> 1)) * (cells + 1);
+                lowest[index] = std::min(lowest[index], height);
+            }
+        }
+    }
+    
+    std::vector<glm::vec3> points((cells + 1) * (cells + 1));
+    for (int z = 0; z <= cells; z++) {
+        for (int x = 0; x <= cells; x++) {
+            glm::vec3 pImage = glm::vec3(float(x * (m_width - 1)) / cells, 0.0f, float(z * (m_height - 1)) / cells);
+            glm::vec3 pWorld = ImageToWorldCoordinates(pImage);
+            pWorld.y = lowest[x + z * (cells + 1)];
+            points[x + z * (cells + 1)] = pWorld;
+        }
+    }
+    
+    for (int z = 0; z < cells; z++) {
+        for (int x = 0; x < cells; x++) {
+            int index = x + z * (cells + 1);
+            m_occluder.insert(m_occluder.end(), { points[index], points[index + cells + 2], points[index + 1],
+                                                  points[index], points[index + cells + 1], points[index + cells + 2] });
+        }
+    }
+}
+
 // Release memory on the GPU 
 void CHeightMapTerrain::Release()
 {
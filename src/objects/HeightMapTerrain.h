@@ -16,6 +16,8 @@ public:
                    const glm::vec3 & scale = glm::vec3(1, 1, 1));
     
     void Render(const GLboolean &useTexture = true);
+    GLboolean GetBounds(glm::vec3 &min, glm::vec3 &max) const override;
+    GLboolean GetOccluder(std::vector<glm::vec3> &triangles) const override;
     void Release();
     GLboolean IsHeightMapRendered();
     
@@ -27,11 +29,14 @@ private:
 	GLuint m_hTexture;
 	GLfloat m_terrainSizeX, m_terrainSizeZ;
 	glm::vec3 m_origin;
+	glm::vec3 m_boundsMin, m_boundsMax;
+	std::vector<glm::vec3> m_occluder;
     std::map<std::string, TextureType> m_textureFileNames;
     std::vector<CTexture*> m_textures;
     
 	FIBITMAP* m_dib;
 
+	void CreateOccluder(const GLint &cells);
 	glm::vec3 WorldToImageCoordinates(glm::vec3 p);
 	glm::vec3 ImageToWorldCoordinates(glm::vec3 p);
 	GLboolean GetImageBytes(char *terrainFilename, BYTE **bDataPointer, GLuint &width, GLuint &height);
@@ -1,5 +1,6 @@
 
 #include "Metaballs.h"
+#include "../window/GLState.h"
 
 // http://www.humus.name/index.php?page=3D&ID=57
 // http://www.angelcode.com/dev/metaballs/metaballs.html
@@ -8,8 +9,12 @@
 //=============================================================================
 CMetaballs::CMetaballs()
 {
-    m_vao = 0;
     m_textures = {};
+    m_nNumBatches = 0;
+    m_bSurfaceDirty = true;
+    m_nUpdates = 0;
+    m_nPolygonisations = 0;
+    m_nDraws = 0;
 }
 
 CMetaballs::~CMetaballs(){
@@ -69,7 +74,7 @@ void CMetaballs::Create(const float &level, const int &numberOfBalls, const int
         m_Balls[i].t = float(Extensions::randFloat())/RAND_MAX;
 		m_Balls[i].m = 1;
 	}
-    
+    memcpy(m_SurfaceBalls, m_Balls, m_nNumBalls*sizeof(SBall));
 }
 
 //=============================================================================
@@ -151,8 +156,56 @@ void CMetaballs::Update(const GLfloat &fDeltaTime)
 	}
 }
 
+//=============================================================================
+int CMetaballs::GetBalls(SBall *pBalls) const
+{
+	memcpy(pBalls, m_Balls, m_nNumBalls*sizeof(SBall));
+	return m_nNumBalls;
+}
+
+//=============================================================================
+void CMetaballs::SetSurfaceBalls(const SBall *pBalls)
+{
+	// balls that did not move keep the surface they have
+	if( memcmp(m_SurfaceBalls, pBalls, m_nNumBalls*sizeof(SBall)) == 0 )
+		return;
+
+	memcpy(m_SurfaceBalls, pBalls, m_nNumBalls*sizeof(SBall));
+	m_bSurfaceDirty = true;
+	m_nUpdates++;
+}
+
+//=============================================================================
+void CMetaballs::BeginFrame()
+{
+	m_nUpdates = 0;
+	m_nPolygonisations = 0;
+	m_nDraws = 0;
+}
+
 //=============================================================================
 void CMetaballs::Render(const GLboolean &useTexture)
+{
+	// the shadow passes and the scene pass of a frame share one surface
+	if( m_bSurfaceDirty )
+		Polygonise();
+
+    if (useTexture){
+        for (GLuint i = 0; i < m_textures.size(); ++i){
+            m_textures[i]->BindTexture2DToTextureType();
+        }
+    }
+    
+    // Render the metalBalls as a set of triangles
+    for (GLuint i = 0; i < m_nNumBatches; ++i) {
+        CGLState::Instance().BindVertexArray(m_batches[i].vao);
+        glDrawElements(GL_TRIANGLES, m_batches[i].numIndices, GL_UNSIGNED_INT, 0);
+    }
+    m_nDraws++;
+}
+
+//=============================================================================
+void CMetaballs::Polygonise()
 {
     
 	int nCase,x,y,z = 0;
@@ -179,6 +232,7 @@ void CMetaballs::Render(const GLboolean &useTexture)
     
     
     ClearVectors();
+    m_nNumBatches = 0;
     
     
 	// Clear status grids
@@ -188,9 +242,9 @@ void CMetaballs::Render(const GLboolean &useTexture)
     // we render each ball
 	for( int i = 0; i < m_nNumBalls; i++ )
 	{
-		x = ConvertWorldCoordinateToGridPoint(m_Balls[i].p[0]);   /// first method
-		y = ConvertWorldCoordinateToGridPoint(m_Balls[i].p[1]);
-		z = ConvertWorldCoordinateToGridPoint(m_Balls[i].p[2]);
+		x = ConvertWorldCoordinateToGridPoint(m_SurfaceBalls[i].p[0]);   /// first method
+		y = ConvertWorldCoordinateToGridPoint(m_SurfaceBalls[i].p[1]);
+		z = ConvertWorldCoordinateToGridPoint(m_SurfaceBalls[i].p[2]);
 
 		// Work our way out from the center of the ball until the surface is
 		// reached. If the voxel at the surface is already computed then this
@@ -204,7 +258,7 @@ void CMetaballs::Render(const GLboolean &useTexture)
 				break;
 			}
 
-			nCase = ComputeGridVoxel(x,y,z, useTexture);
+			nCase = ComputeGridVoxel(x,y,z);
 			if( nCase < 255 )
 				break;
 
@@ -225,7 +279,7 @@ void CMetaballs::Render(const GLboolean &useTexture)
 			y = m_pOpenVoxels[m_nNumOpenVoxels*3 + 1];
 			z = m_pOpenVoxels[m_nNumOpenVoxels*3 + 2];
 
-			nCase = ComputeGridVoxel(x,y,z, useTexture);  ////  grid voxel
+			nCase = ComputeGridVoxel(x,y,z);  ////  grid voxel
 
 			AddNeighborsToList(nCase,x,y,z);   ////  neighbors
 		}
@@ -242,8 +296,10 @@ void CMetaballs::Render(const GLboolean &useTexture)
     pDev->DrawIndexedPrimitive(D3DPT_TRIANGLELIST, 0, m_nNumVertices, 0, m_nNumIndices/3); ////<d3dx8.h>
      */
     
-    // Render the last triangles
-    DrawElements(useTexture);
+    // Upload the last triangles
+    UploadBatch();
+    m_bSurfaceDirty = false;
+    m_nPolygonisations++;
 }
 
 //=============================================================================
@@ -305,13 +361,13 @@ float CMetaballs::ComputeEnergy(float x, float y, float z)
 		// 
 		//   e += mass/distance^2 
 
-		fSqDist = (m_Balls[i].p[0] - x)*(m_Balls[i].p[0] - x) +
-		          (m_Balls[i].p[1] - y)*(m_Balls[i].p[1] - y) +
-		          (m_Balls[i].p[2] - z)*(m_Balls[i].p[2] - z);
+		fSqDist = (m_SurfaceBalls[i].p[0] - x)*(m_SurfaceBalls[i].p[0] - x) +
+		          (m_SurfaceBalls[i].p[1] - y)*(m_SurfaceBalls[i].p[1] - y) +
+		          (m_SurfaceBalls[i].p[2] - z)*(m_SurfaceBalls[i].p[2] - z);
 
 		if( fSqDist < 0.0001f ) fSqDist = 0.0001f;
 
-		fEnergy += m_Balls[i].m / fSqDist;
+		fEnergy += m_SurfaceBalls[i].m / fSqDist;
 	}
 
 	return fEnergy;
@@ -328,15 +384,15 @@ void CMetaballs::ComputeNormal(SVertex *pVertex)
 		//
 		//   n += 2 * mass * vector / distance^4
 
-		float x = pVertex->v[0] - m_Balls[i].p[0];
-		float y = pVertex->v[1] - m_Balls[i].p[1];
-		float z = pVertex->v[2] - m_Balls[i].p[2];
+		float x = pVertex->v[0] - m_SurfaceBalls[i].p[0];
+		float y = pVertex->v[1] - m_SurfaceBalls[i].p[1];
+		float z = pVertex->v[2] - m_SurfaceBalls[i].p[2];
 
 		fSqDist = x*x + y*y + z*z;
 
-		pVertex->n[0] += 2 * m_Balls[i].m * x / (fSqDist * fSqDist);
-		pVertex->n[1] += 2 * m_Balls[i].m * y / (fSqDist * fSqDist);
-		pVertex->n[2] += 2 * m_Balls[i].m * z / (fSqDist * fSqDist);
+		pVertex->n[0] += 2 * m_SurfaceBalls[i].m * x / (fSqDist * fSqDist);
+		pVertex->n[1] += 2 * m_SurfaceBalls[i].m * y / (fSqDist * fSqDist);
+		pVertex->n[2] += 2 * m_SurfaceBalls[i].m * z / (fSqDist * fSqDist);
 	}
 
     /*
@@ -396,7 +452,7 @@ float CMetaballs::ComputeGridPointEnergy(int x, int y, int z)
 }
 
 //=============================================================================
-int CMetaballs::ComputeGridVoxel(int x, int y, int z, const bool &useTexture)
+int CMetaballs::ComputeGridVoxel(int x, int y, int z)
 {
 	float b[8];
 
@@ -513,8 +569,8 @@ int CMetaballs::ComputeGridVoxel(int x, int y, int z, const bool &useTexture)
          
          
          */
-        // first draw elements, Render the computed triangles
-        DrawElements(useTexture);
+        // the buffers are full, keep the computed triangles as one piece of the surface
+        UploadBatch();
         
         ClearVectors();
         
@@ -622,20 +678,25 @@ inline void CMetaballs::SetGridVoxelInList(int x, int y, int z)
 }
 
 
-// Render the metalballs as a set of triangles
-void CMetaballs::DrawElements(const GLboolean &useTexture){
+// Upload the triangles computed so far as the next piece of the surface
+void CMetaballs::UploadBatch(){
     
-    // Release memory on the GPU 
-    glDeleteVertexArrays(1, &m_vao);
-    m_vbo.Release();
-    //m_ballsTexture.Release();
+    if (m_nNumIndices == 0)
+        return;
     
-    // make and bind the VAO
-    glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
-    
-    m_vbo.Create();
-    m_vbo.Bind();
+    // make the VAO of a new piece, the ones of earlier frames are filled again
+    if (m_nNumBatches == m_batches.size()) {
+        SBatch batch;
+        glGenVertexArrays(1, &batch.vao);
+        batch.pVbo = new CVertexBufferObjectIndexed;
+        batch.pVbo->Create();
+        batch.numIndices = 0;
+        m_batches.push_back(batch);
+    }
+    SBatch &batch = m_batches[m_nNumBatches++];
+    CGLState::Instance().BindVertexArray(batch.vao);
+    CVertexBufferObjectIndexed &vbo = *batch.pVbo;
+    vbo.Bind();
     
     
     // Compute vertex attributes and store in VBO
@@ -645,19 +706,20 @@ void CMetaballs::DrawElements(const GLboolean &useTexture){
         glm::vec2 t = m_pTextureAttribute[vert];
         glm::vec3 n = m_pNormalAttribute[vert];
     
-        m_vbo.AddVertexData(&v, sizeof(glm::vec3));
-        m_vbo.AddVertexData(&t, sizeof(glm::vec2));
-        m_vbo.AddVertexData(&n, sizeof(glm::vec3));
+        vbo.AddVertexData(&v, sizeof(glm::vec3));
+        vbo.AddVertexData(&t, sizeof(glm::vec2));
+        vbo.AddVertexData(&n, sizeof(glm::vec3));
         
     }
     
     // Compute indices and store in VBO 
     for (int ind = 0; ind < m_nNumIndices; ind++) {
         unsigned int index = m_pIndices[ind];
-        m_vbo.AddIndexData(&index, sizeof(unsigned int));
+        vbo.AddIndexData(&index, sizeof(unsigned int));
     }
     
-    m_vbo.UploadDataToGPU(GL_STATIC_DRAW);
+    vbo.UploadDataToGPU(GL_DYNAMIC_DRAW);
+    batch.numIndices = m_nNumIndices;
     
     GLsizei stride = 2*sizeof(glm::vec3)+sizeof(glm::vec2);
     
@@ -681,17 +743,6 @@ void CMetaballs::DrawElements(const GLboolean &useTexture){
     std::cout << "n: " << m_pNormalAttribute.size() << std::endl;
     */
     
-    glBindVertexArray(m_vao);
-    if (useTexture){
-        for (GLuint i = 0; i < m_textures.size(); ++i){
-            m_textures[i]->BindTexture2DToTextureType();
-        }
-    }
-    
-    // Render the metalBalls as a set of triangles
-    glDrawElements(GL_TRIANGLES, m_nNumIndices, GL_UNSIGNED_INT, 0);
-    //pDev->DrawIndexedPrimitive(D3DPT_TRIANGLELIST, 0, m_nNumVertices, 0, m_nNumIndices/3);
-    
 }
 
 void CMetaballs::Transform(const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale) {
@@ -703,6 +754,14 @@ void CMetaballs::Transform(const glm::vec3 & position, const glm::vec3 & rotatio
     transform.Scale(scale);
 }
 
+// The balls never leave the grid, which spans -1 to 1
+GLboolean CMetaballs::GetBounds(glm::vec3 &min, glm::vec3 &max) const
+{
+    min = glm::vec3(-1.0f);
+    max = glm::vec3(1.0f);
+    return true;
+}
+
 void CMetaballs::Release() {
     delete m_pOpenVoxels;
     delete m_pfGridEnergy;
@@ -716,7 +775,11 @@ void CMetaballs::Release() {
     }
     m_textures.clear();
     
-    glDeleteVertexArrays(1, &m_vao);
-    
-    m_vbo.Release();
+    for (SBatch &batch : m_batches) {
+        CGLState::Instance().DeleteVertexArrays(1, &batch.vao);
+        batch.pVbo->Release();
+        delete batch.pVbo;
+    }
+    m_batches.clear();
+    m_nNumBatches = 0;
 }
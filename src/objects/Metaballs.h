@@ -34,7 +34,16 @@ public:
     void Create(const float &level, const int &numberOfBalls, const int &gridSize, const int &maxOpenVoxels, const std::string &directory,
                 const std::map<std::string, TextureType> &textureFiles);
 	void Compute();
+	// moves the balls, touches nothing Render uses so it can run off the GL thread
 	void Update(const GLfloat &fDeltaTime);
+    // copies the balls Update moved into pBalls, room for MAX_BALLS, returns how many there are
+    int GetBalls(SBall *pBalls) const;
+    // the balls the surface is built around, the next Render polygonises when they moved
+    void SetSurfaceBalls(const SBall *pBalls);
+    // rebuilds the surface around the surface balls, Render does it when they moved
+    void Polygonise();
+    // the counters below start again
+    void BeginFrame();
 
     void SetGridSize(const int &nSize);
     void ClearVectors();
@@ -43,15 +52,21 @@ public:
                    const glm::vec3 & rotation = glm::vec3(0, 0, 0),
                    const glm::vec3 & scale = glm::vec3(1, 1, 1));
     
+    // draws the surface, every pass of a frame draws the one polygonised for the last surface balls
     void Render(const GLboolean &useTexture = true);
-    void DrawElements(const GLboolean &useTexture);
+    GLboolean GetBounds(glm::vec3 &min, glm::vec3 &max) const override;
     void Release();
     
+    GLuint GetUpdates() const { return m_nUpdates; }
+    GLuint GetPolygonisations() const { return m_nPolygonisations; }
+    GLuint GetDraws() const { return m_nDraws; }
+    
 protected:
 	float ComputeEnergy(float x, float y, float z);
 	void  ComputeNormal(SVertex *pVertex);
 	float ComputeGridPointEnergy(int x, int y, int z);
-	int   ComputeGridVoxel(int x, int y, int z, const bool &useTexture);
+	int   ComputeGridVoxel(int x, int y, int z);
+	void  UploadBatch();
 
 	bool  IsGridPointComputed(int x, int y, int z);
 	bool  IsGridVoxelComputed(int x, int y, int z);
@@ -81,7 +96,8 @@ protected:
 	int    m_nNumVertices;
 	int    m_nNumIndices;
     int    m_nNumBalls;
-    SBall  m_Balls[MAX_BALLS];
+    SBall  m_Balls[MAX_BALLS];          // moved by Update
+    SBall  m_SurfaceBalls[MAX_BALLS];   // what Polygonise reads, set by SetSurfaceBalls
     
     std::vector<SVertex>        m_pVertices;  // vertices data
     std::vector<unsigned short> m_pIndices;   // indices data
@@ -90,8 +106,19 @@ protected:
     std::vector<glm::vec2> m_pTextureAttribute;   // texture data
     std::vector<glm::vec3> m_pNormalAttribute;    // normal data
     
-    GLuint m_vao;
-    CVertexBufferObjectIndexed m_vbo;
+    // the surface is uploaded in pieces of at most MAX_INDICES indices, the buffers of a piece are kept
+    // for the next polygonisation
+    struct SBatch
+    {
+        GLuint vao;
+        CVertexBufferObjectIndexed *pVbo;
+        GLsizei numIndices;
+    };
+    std::vector<SBatch> m_batches;
+    GLuint m_nNumBatches;       // the pieces of the current surface
+    GLboolean m_bSurfaceDirty;  // the surface balls moved since the last polygonisation
+    
+    GLuint m_nUpdates, m_nPolygonisations, m_nDraws;    // since BeginFrame, m_nUpdates counts SetSurfaceBalls
     
     std::map<std::string, TextureType>m_textureFiles;
     std::vector<CTexture*> m_textures;
@@ -1,5 +1,6 @@
 
 #include "Plane.h"
+#include "../window/GLState.h"
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
 
@@ -46,7 +47,7 @@ void CPlane::Create(const std::string &directory, const std::map<std::string, Te
     
     // Use VAO to store state associated with vertices
     glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     // Create a VBO
     m_vbo.Create();
@@ -127,26 +128,8 @@ void CPlane::Create(const std::string &directory, const std::map<std::string, Te
     // Upload the VBO to the GPU
     m_vbo.UploadDataToGPU(GL_STATIC_DRAW);
     
-    // Set the vertex attribute locations
-    GLsizei istride = 4*sizeof(glm::vec3)+sizeof(glm::vec2);
-    
-    // Vertex positions
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, istride, 0);
-    // Texture coordinates
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, istride, (void*)sizeof(glm::vec3));
-    // Normal vectors
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, istride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)));
-    
-    // Tangents
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, istride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)));
-    
-    // Bitangents
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, istride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)+sizeof(glm::vec3)));
+    // laid out as Vertex, the same attributes as the meshes of the geometry arena
+    CGeometryArena::SetVertexAttributes(VertexLayout::Standard);
     
 }
 
@@ -163,7 +146,7 @@ void CPlane::Transform(const glm::vec3 & position, const glm::vec3 & rotation, c
 // Render the plane as a triangle strip
 void CPlane::Render(const GLboolean &useTexture)
 {
-	glBindVertexArray(m_vao);
+	CGLState::Instance().BindVertexArray(m_vao);
     if (useTexture){
         for (GLuint i = 0; i < m_textures.size(); ++i){
             m_textures[i]->BindTexture2DToTextureType();
@@ -173,6 +156,24 @@ void CPlane::Render(const GLboolean &useTexture)
     glDrawArrays(GL_TRIANGLE_STRIP, 0, m_totalVertices);
 }
 
+// The plane is flat in y and centred on the origin
+GLboolean CPlane::GetBounds(glm::vec3 &min, glm::vec3 &max) const
+{
+    min = glm::vec3(-m_width / 2.0f, 0.0f, -m_height / 2.0f);
+    max = glm::vec3(m_width / 2.0f, 0.0f, m_height / 2.0f);
+    return true;
+}
+
+// Both triangles face up like the plane, from below it hides nothing
+GLboolean CPlane::GetOccluder(std::vector<glm::vec3> &triangles) const
+{
+    glm::vec3 min, max;
+    GetBounds(min, max);
+    triangles.insert(triangles.end(), { glm::vec3(min.x, 0.0f, min.z), glm::vec3(max.x, 0.0f, max.z), glm::vec3(max.x, 0.0f, min.z),
+                                        glm::vec3(min.x, 0.0f, min.z), glm::vec3(min.x, 0.0f, max.z), glm::vec3(max.x, 0.0f, max.z) });
+    return true;
+}
+
 // Release resources
 void CPlane::Release()
 {
@@ -182,7 +183,7 @@ void CPlane::Release()
     }
     m_textures.clear();
     
-    glDeleteVertexArrays(1, &m_vao);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vao);
     
     m_vbo.Release();
 }
@@ -15,6 +15,8 @@ public:
                    const glm::vec3 & scale = glm::vec3(1, 1, 1));
    
     void Render(const GLboolean &useTexture = true);
+    GLboolean GetBounds(glm::vec3 &min, glm::vec3 &max) const override;
+    GLboolean GetOccluder(std::vector<glm::vec3> &triangles) const override;
     void Release();
 private:
     
@@ -7,6 +7,7 @@
 //
 
 #include "Quad.h"
+#include "../window/GLState.h"
 
 CQuad::CQuad()
 {
@@ -43,7 +44,7 @@ void CQuad::Create(const std::string &directory, const std::map<std::string, Tex
     
     // Use VAO to store state associated with vertices
     glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     // Create a VBO
     m_vbo.Create();
@@ -129,27 +130,8 @@ void CQuad::Create(const std::string &directory, const std::map<std::string, Tex
     // Upload the VBO to the GPU
     m_vbo.UploadDataToGPU(GL_STATIC_DRAW);
     
-    // Set the vertex attribute locations
-    GLsizei istride = 4*sizeof(glm::vec3)+sizeof(glm::vec2);
-    
-    // Vertex positions
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, istride, 0);
-    // Texture coordinates
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, istride, (void*)sizeof(glm::vec3));
-    
-    // Normal vectors
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, istride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)));
-    
-    // Tangents
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, istride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)));
-    
-    // Bitangents
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, istride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)+sizeof(glm::vec3)));
+    // laid out as Vertex, the same attributes as the meshes of the geometry arena
+    CGeometryArena::SetVertexAttributes(VertexLayout::Standard);
 
 }
 
@@ -165,7 +147,7 @@ void CQuad::Transform(const glm::vec3 & position, const glm::vec3 & rotation, co
 // Render the quad as a triangle strip
 void CQuad::Render(const GLboolean &useTexture)
 {
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     if (useTexture){
         for (GLuint i = 0; i < m_textures.size(); ++i){
             m_textures[i]->BindTexture2DToTextureType();
@@ -184,7 +166,7 @@ void CQuad::Release()
     }
     m_textures.clear();
     
-    glDeleteVertexArrays(1, &m_vao);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vao);
     
     m_vbo.Release();
 }
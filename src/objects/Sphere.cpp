@@ -7,7 +7,7 @@
 
 CSphere::CSphere()
 {
-    m_vao = 0;
+    m_geometry = 0;
     m_textures = {};
 }
 
@@ -38,12 +38,6 @@ void CSphere::Create(const std::string &directory, const std::map<std::string, T
         // any code including continue, break, return
     }
 
-	glGenVertexArrays(1, &m_vao);
-	glBindVertexArray(m_vao);
-
-	m_vbo.Create();
-	m_vbo.Bind();
-    
     // http://www.songho.ca/opengl/gl_sphere.html
 	// Compute vertex attributes and store in VBO
 	int vertexCount = 0;
@@ -128,30 +122,8 @@ void CSphere::Create(const std::string &directory, const std::map<std::string, T
 		}
 	}
 
-	m_vbo.UploadDataToGPU(GL_STATIC_DRAW);
-
-    // https://stackoverflow.com/questions/22296510/what-does-stride-mean-in-opengles
-    // https://www.opengl.org/discussion_boards/showthread.php/156620-glVertexPointer-Stride
-    // 4 vector3 plus 1 vector2
-	GLsizei stride = (4 * sizeof(glm::vec3))+sizeof(glm::vec2);
-
-	// Vertex positions
-	glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, 0);
-	// Texture coordinates
-	glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)sizeof(glm::vec3));
-	// Normal vectors
-	glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)));
-    
-    // Tangents
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)));
-    // Bitangents
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)+sizeof(glm::vec3)));
-    
+	// 4 vector3 plus 1 vector2 per vertex, the attributes are set up once for every mesh of the layout
+	m_geometry = m_vbo.UploadDataToArena(VertexLayout::Standard);
 }
 
 void CSphere::Transform(const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale) {
@@ -166,16 +138,36 @@ void CSphere::Transform(const glm::vec3 & position, const glm::vec3 & rotation,
 // Render the sphere as a set of triangles
 void CSphere::Render(const GLboolean &useTexture)
 {
-    // bind the VAO (the triangle)
-    glBindVertexArray(m_vao);
-    
     if (useTexture){
         for (GLuint i = 0; i < m_textures.size(); ++i){
             m_textures[i]->BindTexture2DToTextureType();
         }
     }
-    glDrawElements(GL_TRIANGLES, m_numTriangles*3, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    CGeometryArena::Instance().Draw(m_geometry, GL_TRIANGLES);
+}
+
+// Render count instances of the sphere, the textures are bound by whoever groups the instances
+GLboolean CSphere::RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count)
+{
+    CGeometryArena::Instance().DrawInstanced(m_geometry, instances, first, count, GL_TRIANGLES);
+    return true;
+}
+
+// The sphere has a radius of one
+GLboolean CSphere::GetBounds(glm::vec3 &min, glm::vec3 &max) const
+{
+    min = glm::vec3(-1.0f);
+    max = glm::vec3(1.0f);
+    return true;
+}
+
+// Indexed triangles in the geometry arena
+GLboolean CSphere::GetGeometry(GeometryRange &geometry) const
+{
+    if (!CGeometryArena::Instance().GetGeometry(m_geometry, geometry))
+        return false;
+    geometry.mode = GL_TRIANGLES;
+    return true;
 }
 
 // Release memory on the GPU
@@ -187,7 +179,8 @@ void CSphere::Release()
     }
     m_textures.clear();
     
-    glDeleteVertexArrays(1, &m_vao);
+    CGeometryArena::Instance().Free(m_geometry);
+    m_geometry = 0;
     
     m_vbo.Release();
     
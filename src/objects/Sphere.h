@@ -14,11 +14,14 @@ public:
                    const glm::vec3 & scale = glm::vec3(1, 1, 1));
     
     void Render(const GLboolean &useTexture = true);
+    GLboolean RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count) override;
+    GLboolean GetBounds(glm::vec3 &min, glm::vec3 &max) const override;
+    GLboolean GetGeometry(GeometryRange &geometry) const override;
     void Release();
     
 private:
     
-	GLuint m_vao;
+	GLuint m_geometry;      // handle in CGeometryArena
 	CVertexBufferObjectIndexed m_vbo;
     
     std::map<std::string, TextureType> m_textureNames;
@@ -1,5 +1,6 @@
 
 #include "Torus.h"
+#include "../window/GLState.h"
 
 //https://stackoverflow.com/questions/7966362/how-to-draw-a-textured-torus-in-opengl-without-using-glut
 //https://www.opengl.org/archives/resources/code/samples/redbook/torus.c
@@ -13,7 +14,8 @@
 
 CTorus::CTorus()
 {
-    
+    m_outerRadius = 0.0f;
+    m_innerRadius = 0.0f;
 };
 
 CTorus::~CTorus()
@@ -28,6 +30,8 @@ void CTorus::Create(const std::string &directory, const std::map<std::string, Te
                     const float &innerRadius             //tick
                     ) {
     
+    m_outerRadius = outerRadius;
+    m_innerRadius = innerRadius;
     m_textureNames = textureNames;
     m_textures.reserve(textureNames.size());
     
@@ -49,7 +53,7 @@ void CTorus::Create(const std::string &directory, const std::map<std::string, Te
     
     // make and bind the VAO
     glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     m_vbo.Create();
     m_vbo.Bind();
@@ -158,26 +162,8 @@ void CTorus::Create(const std::string &directory, const std::map<std::string, Te
     
     m_vbo.UploadDataToGPU(GL_STATIC_DRAW);
     
-    // 4 vector3 plus 1 vector2
-    GLsizei stride = 4 * sizeof(glm::vec3) + sizeof(glm::vec2);
-    
-    // Vertex positions
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, 0);
-    // Texture coordinates
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)sizeof(glm::vec3));
-    // Normal vectors
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3) + sizeof(glm::vec2)));
-    
-    // Tangents
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)));
-    
-    // Bitangents
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)+sizeof(glm::vec3)));
+    // laid out as Vertex, the same attributes as the meshes of the geometry arena
+    CGeometryArena::SetVertexAttributes(VertexLayout::Standard);
     
 }
 
@@ -193,7 +179,7 @@ void CTorus::Transform(const glm::vec3 & position, const glm::vec3 & rotation, c
 void CTorus::Render(const GLboolean &useTexture)
 {
     // bind the VAO (the triangle)
-    glBindVertexArray(m_vao);
+    CGLState::Instance().BindVertexArray(m_vao);
     if (useTexture){
         for (GLuint i = 0; i < m_textures.size(); ++i){
             m_textures[i]->BindTexture2DToTextureType();
@@ -203,6 +189,38 @@ void CTorus::Render(const GLboolean &useTexture)
     
 }
 
+// Render count instances of the torus, the textures are bound by whoever groups the instances
+GLboolean CTorus::RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count)
+{
+    instances.Bind(m_vao, first);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, m_numTriangles, count);
+    CGLState::Instance().BindVertexArray(0);
+    return true;
+}
+
+// The ring lies in the xy plane, as thick as the inner radius on either side of it
+GLboolean CTorus::GetBounds(glm::vec3 &min, glm::vec3 &max) const
+{
+    float reach = m_outerRadius + m_innerRadius;
+    min = glm::vec3(-reach, -reach, -m_innerRadius);
+    max = glm::vec3(reach, reach, m_innerRadius);
+    return true;
+}
+
+// The torus draws its vertices as one strip
+GLboolean CTorus::GetGeometry(GeometryRange &geometry) const
+{
+    geometry.vertexArray = 0;
+    geometry.vertexBuffer = m_vbo.GetBuffer();
+    geometry.vertexOffset = 0;
+    geometry.vertexSize = m_numTriangles * sizeof(Vertex);
+    geometry.indexBuffer = 0;
+    geometry.indexOffset = 0;
+    geometry.count = m_numTriangles;
+    geometry.mode = GL_TRIANGLE_STRIP;
+    return true;
+}
+
 // Release memory on the GPU 
 void CTorus::Release()
 {
@@ -213,7 +231,7 @@ void CTorus::Release()
     }
     m_textures.clear();
     
-    glDeleteVertexArrays(1, &m_vao);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vao);
     m_vbo.Release();
     
 }
@@ -24,6 +24,9 @@ public:
                    const glm::vec3 & scale = glm::vec3(1, 1, 1));
     
     void Render(const GLboolean &useTexture = true);
+    GLboolean RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count) override;
+    GLboolean GetBounds(glm::vec3 &min, glm::vec3 &max) const override;
+    GLboolean GetGeometry(GeometryRange &geometry) const override;
     void Release();
     
 private:
@@ -33,6 +36,7 @@ private:
     std::map<std::string, TextureType> m_textureNames;
     std::vector<CTexture*> m_textures;
     
+    float m_outerRadius, m_innerRadius;
 };
 
 
@@ -13,7 +13,8 @@
 
 CTorusKnot::CTorusKnot()
 {
-    
+    m_reach = 0.0f;
+    m_geometry = 0;
 };
 
 
@@ -41,6 +42,8 @@ void CTorusKnot:: Create(const std::string &directory,
                          float aQ)             // in: Q parameter of the knot
 {
 
+    // the knot's centre line stays within 1.5 times its scale of the origin, the clumps swell the tube around it
+    m_reach = 1.5f * aScale + aThickness * (1.0f + std::abs(aClumpScale));
     m_textureNames = textureNames;
     m_textures.reserve(textureNames.size());
    
@@ -101,12 +104,6 @@ void CTorusKnot:: Create(const std::string &directory,
      */
     
 
-    glGenVertexArrays(1, &m_vao);
-    glBindVertexArray(m_vao);
-    
-    m_vbo.Create();
-    m_vbo.Bind();
-    
     std::vector<glm::vec3> positions;
     std::vector<glm::vec2> texCoords;
     std::vector<glm::vec3> normals;
@@ -346,29 +343,8 @@ void CTorusKnot:: Create(const std::string &directory,
         m_vbo.AddIndexData(&index, sizeof(unsigned int));
     }
     
-    m_vbo.UploadDataToGPU(GL_STATIC_DRAW);
-    
-    // 4 vector3 plus 1 vector2
-    GLsizei stride = 4*sizeof(glm::vec3)+sizeof(glm::vec2);
-    
-    // Vertex positions
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, 0);
-    // Texture coordinates
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)sizeof(glm::vec3));
-    // Normal vectors
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)));
-    
-    // Tangents
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)));
-    
-    // Bitangents
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(glm::vec3)+sizeof(glm::vec2)+sizeof(glm::vec3)+sizeof(glm::vec3)));
-    
+    // 4 vector3 plus 1 vector2, the same layout as the other static meshes
+    m_geometry = m_vbo.UploadDataToArena(VertexLayout::Standard);
 
 }
 
@@ -383,8 +359,6 @@ void CTorusKnot::Transform(const glm::vec3 & position, const glm::vec3 & rotatio
 
 void CTorusKnot::Render(const GLboolean &useTexture)
 {
-    // bind the VAO (the triangle)
-    glBindVertexArray(m_vao);
     if (useTexture){
         
         for (GLuint i = 0; i < m_textures.size(); ++i){
@@ -392,7 +366,30 @@ void CTorusKnot::Render(const GLboolean &useTexture)
         }
     }
     
-    glDrawElements(GL_TRIANGLE_STRIP, m_numIndices, GL_UNSIGNED_INT, 0);
+    CGeometryArena::Instance().Draw(m_geometry, GL_TRIANGLE_STRIP);
+}
+
+// Render count instances of the torus knot, the textures are bound by whoever groups the instances
+GLboolean CTorusKnot::RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count)
+{
+    CGeometryArena::Instance().DrawInstanced(m_geometry, instances, first, count, GL_TRIANGLE_STRIP);
+    return true;
+}
+
+GLboolean CTorusKnot::GetBounds(glm::vec3 &min, glm::vec3 &max) const
+{
+    min = glm::vec3(-m_reach);
+    max = glm::vec3(m_reach);
+    return true;
+}
+
+// An indexed strip in the geometry arena
+GLboolean CTorusKnot::GetGeometry(GeometryRange &geometry) const
+{
+    if (!CGeometryArena::Instance().GetGeometry(m_geometry, geometry))
+        return false;
+    geometry.mode = GL_TRIANGLE_STRIP;
+    return true;
 }
 
 // Release memory on the GPU 
@@ -404,7 +401,8 @@ void CTorusKnot::Release()
     }
     m_textures.clear();
     
-    glDeleteVertexArrays(1, &m_vao);
+    CGeometryArena::Instance().Free(m_geometry);
+    m_geometry = 0;
     
     m_vbo.Release();
 }
@@ -36,15 +36,20 @@ public:
                    const glm::vec3 & scale = glm::vec3(1, 1, 1));
     
     void Render(const GLboolean &useTexture = true);
+    GLboolean RenderInstanced(CInstanceBuffer &instances, const GLuint &first, const GLsizei &count) override;
+    GLboolean GetBounds(glm::vec3 &min, glm::vec3 &max) const override;
+    GLboolean GetGeometry(GeometryRange &geometry) const override;
     void Release();
 
 private:
     
-    GLuint m_vao, m_numVertices, m_numIndices;
+    GLuint m_geometry, m_numVertices, m_numIndices;     // m_geometry is the handle in CGeometryArena
     CVertexBufferObjectIndexed m_vbo;
     
     std::map<std::string, TextureType> m_textureNames;
     std::vector<CTexture*> m_textures;
+    
+    float m_reach;          // how far the surface gets from the origin
 };
 
 #endif /* TorusKnot_h */
@@ -0,0 +1,102 @@
+#version 400 core
+
+/*
+ Downsample of the bloom mip chain, the 13 tap filter from
+ Next Generation Post Processing in Call of Duty: Advanced Warfare, Jorge Jimenez, 2014
+ http://www.iryoku.com/next-generation-post-processing-in-call-of-duty-advanced-warfare
+ https://learnopengl.com/Guest-Articles/2022/Phys.-Based-Bloom
+ */
+
+// Structure holding material information:  its ambient, diffuse, specular, etc...
+uniform struct Material
+{
+    sampler2D ambientMap;           // 0.   ambient map (albedo map)
+    sampler2D diffuseMap;           // 1.   diffuse map (metallic map)
+    sampler2D specularMap;          // 2.   specular map (roughness map)
+    sampler2D normalMap;            // 3.   normal map
+    sampler2D heightMap;            // 4.   height map
+    sampler2D emissionMap;          // 5.   emission map
+    sampler2D displacementMap;      // 6.   displacment map
+    sampler2D aoMap;                // 7.   ambient oclusion map
+    sampler2D glossinessMap;        // 8.   glossiness map
+    sampler2D opacityMap;           // 9.   opacity map
+    samplerCube shadowMap;          // 10.  shadow cube map
+    sampler2D depthMap;             // 11.  depth map
+    sampler2D noiseMap;             // 12.  noise map
+    sampler2D maskMap;              // 13.  mask map
+    sampler2D lensMap;              // 14.  lens map
+    samplerCube cubeMap;            // 15.  sky box or environment mapping cube map
+    vec4 color;
+    vec4 guiColor;
+    float shininess;
+} material;
+
+in VS_OUT
+{
+    vec2 vTexCoord;    // Texture coordinate
+    vec3 vLocalPosition;
+    vec3 vLocalNormal;
+    vec3 vWorldPosition;
+    vec3 vWorldNormal;
+    vec4 vEyePosition;
+} fs_in;
+
+uniform bool bFirstLevel;       // weights the first level by luma so single bright pixels do not flicker
+
+out vec4 vOutputColour;        // The output colour formely  gl_FragColor
+
+float karisWeight(vec3 c) {
+    float luma = dot(c, vec3(0.2126f, 0.7152f, 0.0722f)) * 0.25f;
+    return 1.0f / (1.0f + luma);
+}
+
+void main()
+{
+    vec2 uv = fs_in.vTexCoord.xy;
+    vec2 texel = 1.0f / vec2(textureSize(material.depthMap, 0)); // texel of the larger source level
+    float x = texel.x;
+    float y = texel.y;
+    
+    // the bilinear taps land between source texels, so 13 fetches cover a 6x6 footprint
+    // a - b - c
+    // - j - k -
+    // d - e - f
+    // - l - m -
+    // g - h - i
+    vec3 a = texture(material.depthMap, uv + vec2(-2.0f * x,  2.0f * y)).rgb;
+    vec3 b = texture(material.depthMap, uv + vec2( 0.0f,      2.0f * y)).rgb;
+    vec3 c = texture(material.depthMap, uv + vec2( 2.0f * x,  2.0f * y)).rgb;
+    vec3 d = texture(material.depthMap, uv + vec2(-2.0f * x,  0.0f)).rgb;
+    vec3 e = texture(material.depthMap, uv).rgb;
+    vec3 f = texture(material.depthMap, uv + vec2( 2.0f * x,  0.0f)).rgb;
+    vec3 g = texture(material.depthMap, uv + vec2(-2.0f * x, -2.0f * y)).rgb;
+    vec3 h = texture(material.depthMap, uv + vec2( 0.0f,     -2.0f * y)).rgb;
+    vec3 i = texture(material.depthMap, uv + vec2( 2.0f * x, -2.0f * y)).rgb;
+    vec3 j = texture(material.depthMap, uv + vec2(-x,  y)).rgb;
+    vec3 k = texture(material.depthMap, uv + vec2( x,  y)).rgb;
+    vec3 l = texture(material.depthMap, uv + vec2(-x, -y)).rgb;
+    vec3 m = texture(material.depthMap, uv + vec2( x, -y)).rgb;
+    
+    // five overlapping boxes, the centre one counts for half
+    vec3 boxes[5];
+    boxes[0] = (j + k + l + m) * 0.125f;
+    boxes[1] = (a + b + d + e) * 0.03125f;
+    boxes[2] = (b + c + e + f) * 0.03125f;
+    boxes[3] = (d + e + g + h) * 0.03125f;
+    boxes[4] = (e + f + h + i) * 0.03125f;
+    
+    vec3 result = vec3(0.0f);
+    if (bFirstLevel) {
+        float weightSum = 0.0f;
+        for (int n = 0; n < 5; ++n) {
+            float weight = karisWeight(boxes[n]) * (n == 0 ? 0.5f : 0.125f);
+            result += boxes[n] / (n == 0 ? 0.5f : 0.125f) * weight;
+            weightSum += weight;
+        }
+        result /= weightSum;
+    } else {
+        for (int n = 0; n < 5; ++n) result += boxes[n];
+    }
+    
+    vOutputColour = vec4(max(result, vec3(0.0001f)), 1.0f);
+}
@@ -1,5 +1,12 @@
 #version 400 core
 
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_HDR
+const bool bHDR = true;
+#else
+const bool bHDR = false;
+#endif
+
 ////https://www.youtube.com/watch?v=LyoSSoYyfVU
 ///https://learnopengl.com/Advanced-Lighting/Bloom
 
@@ -31,7 +38,6 @@ uniform struct HRDLight
 {
     float exposure;
     float gamma;
-    bool bHDR;
 } hrdlight;
 
 in VS_OUT
@@ -63,7 +69,7 @@ void main()
         
         // HDR
         vec3 result = hdrColor.rgb;
-        if(hrdlight.bHDR)
+        if(bHDR)
         {
             // reinhard
             // vec3 result = hdrColor / (hdrColor + vec3(1.0f));
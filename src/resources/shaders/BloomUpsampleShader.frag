@@ -0,0 +1,77 @@
+#version 400 core
+
+/*
+ Upsample of the bloom mip chain with a 3x3 tent filter, the result is blended onto the larger level
+ Next Generation Post Processing in Call of Duty: Advanced Warfare, Jorge Jimenez, 2014
+ https://learnopengl.com/Guest-Articles/2022/Phys.-Based-Bloom
+ */
+
+// Structure holding material information:  its ambient, diffuse, specular, etc...
+uniform struct Material
+{
+    sampler2D ambientMap;           // 0.   ambient map (albedo map)
+    sampler2D diffuseMap;           // 1.   diffuse map (metallic map)
+    sampler2D specularMap;          // 2.   specular map (roughness map)
+    sampler2D normalMap;            // 3.   normal map
+    sampler2D heightMap;            // 4.   height map
+    sampler2D emissionMap;          // 5.   emission map
+    sampler2D displacementMap;      // 6.   displacment map
+    sampler2D aoMap;                // 7.   ambient oclusion map
+    sampler2D glossinessMap;        // 8.   glossiness map
+    sampler2D opacityMap;           // 9.   opacity map
+    samplerCube shadowMap;          // 10.  shadow cube map
+    sampler2D depthMap;             // 11.  depth map
+    sampler2D noiseMap;             // 12.  noise map
+    sampler2D maskMap;              // 13.  mask map
+    sampler2D lensMap;              // 14.  lens map
+    samplerCube cubeMap;            // 15.  sky box or environment mapping cube map
+    vec4 color;
+    vec4 guiColor;
+    float shininess;
+} material;
+
+in VS_OUT
+{
+    vec2 vTexCoord;    // Texture coordinate
+    vec3 vLocalPosition;
+    vec3 vLocalNormal;
+    vec3 vWorldPosition;
+    vec3 vWorldNormal;
+    vec4 vEyePosition;
+} fs_in;
+
+uniform vec2 filterRadius;      // tent radius in texture coordinates of the smaller level
+uniform float weight = 0.5f;   // share of the upsampled level, the blend keeps the rest of the larger one
+
+out vec4 vOutputColour;        // The output colour formely  gl_FragColor
+
+void main()
+{
+    vec2 uv = fs_in.vTexCoord.xy;
+    float x = filterRadius.x;
+    float y = filterRadius.y;
+    
+    // a - b - c
+    // d - e - f
+    // g - h - i
+    vec3 a = texture(material.depthMap, uv + vec2(-x,  y)).rgb;
+    vec3 b = texture(material.depthMap, uv + vec2( 0.0f,  y)).rgb;
+    vec3 c = texture(material.depthMap, uv + vec2( x,  y)).rgb;
+    vec3 d = texture(material.depthMap, uv + vec2(-x,  0.0f)).rgb;
+    vec3 e = texture(material.depthMap, uv).rgb;
+    vec3 f = texture(material.depthMap, uv + vec2( x,  0.0f)).rgb;
+    vec3 g = texture(material.depthMap, uv + vec2(-x, -y)).rgb;
+    vec3 h = texture(material.depthMap, uv + vec2( 0.0f, -y)).rgb;
+    vec3 i = texture(material.depthMap, uv + vec2( x, -y)).rgb;
+    
+    // 1 2 1
+    // 2 4 2  / 16
+    // 1 2 1
+    vec3 result = e * 4.0f;
+    result += (b + d + f + h) * 2.0f;
+    result += (a + c + g + i);
+    result *= 1.0f / 16.0f;
+    
+    // alpha blended with the level underneath, see the blend function set in CGameWindow
+    vOutputColour = vec4(result, weight);
+}
@@ -1,8 +1,20 @@
 #version 410 core
 
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_HDR
+const bool bHDR = true;
+#else
+const bool bHDR = false;
+#endif
+#ifdef USE_FOG
+const bool bUseFog = true;
+#else
+const bool bUseFog = false;
+#endif
+
 // http://www.geeks3d.com/20101008/shader-library-chromatic-aberration-demo-glsl/
 
-uniform struct Camera
+struct Camera
 {
     vec3 position;
     vec3 front;
@@ -10,7 +22,13 @@ uniform struct Camera
     float zfar;
     bool isMoving;
     bool isOrthographic;
-} camera;
+};
+
+// per frame camera, shared by all programs
+layout (std140) uniform CameraBlock
+{
+    Camera camera;
+};
 
 // Structure holding material information:  its ambient, diffuse, specular, etc...
 uniform struct Material
@@ -43,14 +61,12 @@ uniform struct HRDLight
 {
     float exposure;
     float gamma;
-    bool bHDR;
 } hrdlight;
 
 uniform struct Fog {
     float maxDist;
     float minDist;
     vec3 color;
-    bool bUseFog;
 } fog;
 
 in VS_OUT
@@ -152,7 +168,7 @@ void main()
 
     // FOG
     vec3 fogColor = result.xyz;
-    if (fog.bUseFog) {
+    if (bUseFog) {
         //float dist = abs( fs_in.vEyePosition.z );
         float dist = length( fs_in.vEyePosition.xyz );
         float fogFactor = (fog.maxDist - dist) / (fog.maxDist - fog.minDist);
@@ -164,7 +180,7 @@ void main()
     
     // HDR
     vec3 envColor = result.xyz;
-    if(hrdlight.bHDR)
+    if(bHDR)
     {
         // tone mapping with exposure
         envColor = vec3(1.0f) - exp(-envColor * hrdlight.exposure);
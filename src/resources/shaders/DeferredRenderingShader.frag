@@ -1,11 +1,38 @@
 #version 400 core
 
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_DIRECTIONAL_LIGHT
+const bool bUseDirectionalLight = true;
+#else
+const bool bUseDirectionalLight = false;
+#endif
+#ifdef USE_POINT_LIGHT
+const bool bUsePointLight = true;
+#else
+const bool bUsePointLight = false;
+#endif
+#ifdef USE_SPOT_LIGHT
+const bool bUseSpotlight = true;
+#else
+const bool bUseSpotlight = false;
+#endif
+#ifdef USE_SMOOTH_SPOT
+const bool bUseSmoothSpot = true;
+#else
+const bool bUseSmoothSpot = false;
+#endif
+#ifdef USE_BLINN
+const bool bUseBlinn = true;
+#else
+const bool bUseBlinn = false;
+#endif
+
 // https://learnopengl.com/#!Advanced-Lighting/Deferred-Shading
 // https://learnopengl.com/code_viewer_gh.php?code=src/5.advanced_lighting/8.1.deferred_shading/8.1.deferred_shading.fs
 
 #define NUMBER_OF_POINT_LIGHTS 10
 
-uniform struct Camera
+struct Camera
 {
     vec3 position;
     vec3 front;
@@ -13,7 +40,13 @@ uniform struct Camera
     float zfar;
     bool isMoving;
     bool isOrthographic;
-} camera;
+};
+
+// per frame camera, shared by all programs
+layout (std140) uniform CameraBlock
+{
+    Camera camera;
+};
 
 // Structure holding material information:  its ambient, diffuse, specular, etc...
 uniform struct Material
@@ -64,6 +97,7 @@ struct DirectionalLight
 {
     BaseLight base;
     vec3 direction;
+    vec3 position;
 };
 
 struct PointLight
@@ -71,7 +105,7 @@ struct PointLight
     BaseLight base;
     Attenuation attenuation;
     vec3 position;
-    float range;
+    float range; // This returns a radius between roughly 1.0 and 5.0 based on the light's maximum intensity.
 };
 
 struct SpotLight
@@ -82,11 +116,13 @@ struct SpotLight
     float outerCutOff;
 };
 
-uniform DirectionalLight R_directionallight;
-uniform PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
-uniform SpotLight R_spotlight;
-uniform bool bUseBlinn, bUseSmoothSpot;
-uniform bool bUseDirectionalLight, bUsePointLight, bUseSpotlight;
+// per frame lights, shared by all programs
+layout (std140) uniform LightsBlock
+{
+    DirectionalLight R_directionallight;
+    PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
+    SpotLight R_spotlight;
+};
 uniform float coverage;
 
 in VS_OUT
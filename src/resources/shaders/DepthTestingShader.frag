@@ -29,7 +29,7 @@ uniform struct Material
     float uvTiling;
 } material;
 
-uniform struct Camera
+struct Camera
 {
     vec3 position;
     vec3 front;
@@ -37,7 +37,13 @@ uniform struct Camera
     float zfar;
     bool isMoving;
     bool isOrthographic;
-} camera;
+};
+
+// per frame camera, shared by all programs
+layout (std140) uniform CameraBlock
+{
+    Camera camera;
+};
 
 in VS_OUT
 {
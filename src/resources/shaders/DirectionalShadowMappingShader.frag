@@ -1,5 +1,42 @@
 #version 410 core
 
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_DIRECTIONAL_LIGHT
+const bool bUseDirectionalLight = true;
+#else
+const bool bUseDirectionalLight = false;
+#endif
+#ifdef USE_POINT_LIGHT
+const bool bUsePointLight = true;
+#else
+const bool bUsePointLight = false;
+#endif
+#ifdef USE_SPOT_LIGHT
+const bool bUseSpotlight = true;
+#else
+const bool bUseSpotlight = false;
+#endif
+#ifdef USE_SMOOTH_SPOT
+const bool bUseSmoothSpot = true;
+#else
+const bool bUseSmoothSpot = false;
+#endif
+#ifdef USE_BLINN
+const bool bUseBlinn = true;
+#else
+const bool bUseBlinn = false;
+#endif
+#ifdef USE_HDR
+const bool bHDR = true;
+#else
+const bool bHDR = false;
+#endif
+#ifdef USE_FOG
+const bool bUseFog = true;
+#else
+const bool bUseFog = false;
+#endif
+
 // http://glampert.com/2014/01-26/visualizing-the-depth-buffer/
 // https://www.geeks3d.com/20091216/geexlab-how-to-visualize-the-depth-buffer-in-glsl/
 // https://stackoverflow.com/questions/26406120/viewing-depth-buffer-in-opengl
@@ -7,7 +44,7 @@
 
 #define NUMBER_OF_POINT_LIGHTS 10
 
-uniform struct Camera
+struct Camera
 {
     vec3 position;
     vec3 front;
@@ -15,7 +52,13 @@ uniform struct Camera
     float zfar;
     bool isMoving;
     bool isOrthographic;
-} camera;
+};
+
+// per frame camera, shared by all programs
+layout (std140) uniform CameraBlock
+{
+    Camera camera;
+};
 
 uniform struct Shadow
 {
@@ -57,14 +100,12 @@ uniform struct HRDLight
 {
     float exposure;
     float gamma;
-    bool bHDR;
 } hrdlight;
 
 uniform struct Fog {
     float maxDist;
     float minDist;
     vec3 color;
-    bool bUseFog;
 } fog;
 
 // Structure holding light information:  its position, colors, direction etc...
@@ -107,11 +148,13 @@ struct SpotLight
     float outerCutOff;
 };
 
-uniform DirectionalLight R_directionallight;
-uniform PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
-uniform SpotLight R_spotlight;
-uniform bool bUseBlinn, bUseSmoothSpot;
-uniform bool bUseDirectionalLight, bUsePointLight, bUseSpotlight;
+// per frame lights, shared by all programs
+layout (std140) uniform LightsBlock
+{
+    DirectionalLight R_directionallight;
+    PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
+    SpotLight R_spotlight;
+};
 
 in VS_OUT
 {
@@ -274,7 +317,7 @@ void main()
     
     // FOG
     vec3 fogColor = result.xyz;
-    if (fog.bUseFog) {
+    if (bUseFog) {
         //float dist = abs( fs_in.vEyePosition.z );
         float dist = length( fs_in.vEyePosition.xyz );
         float fogFactor = (fog.maxDist - dist) / (fog.maxDist - fog.minDist);
@@ -287,7 +330,7 @@ void main()
     
     // HDR
     vec3 hdrColor = result.xyz;
-    if(hrdlight.bHDR)
+    if(bHDR)
     {
         // tone mapping with exposure
         hdrColor = vec3(1.0f) - exp(-hdrColor * hrdlight.exposure);
@@ -7,10 +7,15 @@ uniform struct Matrices
     mat4 modelMatrix;
     mat4 viewMatrix;
     mat3 normalMatrix;
-   
+} matrices;
+
+// per frame shadow matrices, shared by all programs
+layout (std140) uniform ShadowBlock
+{
     // we use a different projection and view matrix to render the scene from the light's point of view.
     mat4 lightSpaceMatrix;
-} matrices;
+    mat4 shadowMatrices[6];
+};
 
 // Layout of vertex attributes in VBO
 layout (location = 0) in vec3 inPosition;
@@ -50,7 +55,7 @@ void main() {
     vs_out.vWorldPosition = vec3(matrices.modelMatrix * position);
     vs_out.vLocalPosition = inPosition;
     
-    vs_out.vPosLightSpace = matrices.lightSpaceMatrix * matrices.modelMatrix * position;
+    vs_out.vPosLightSpace = lightSpaceMatrix * matrices.modelMatrix * position;
     
     // Transform the vertex spatial position using
     gl_Position = matrices.projMatrix * matrices.viewMatrix * matrices.modelMatrix * position;
@@ -1,4 +1,41 @@
 #version 410 core
+
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_DIRECTIONAL_LIGHT
+const bool bUseDirectionalLight = true;
+#else
+const bool bUseDirectionalLight = false;
+#endif
+#ifdef USE_POINT_LIGHT
+const bool bUsePointLight = true;
+#else
+const bool bUsePointLight = false;
+#endif
+#ifdef USE_SPOT_LIGHT
+const bool bUseSpotlight = true;
+#else
+const bool bUseSpotlight = false;
+#endif
+#ifdef USE_SMOOTH_SPOT
+const bool bUseSmoothSpot = true;
+#else
+const bool bUseSmoothSpot = false;
+#endif
+#ifdef USE_BLINN
+const bool bUseBlinn = true;
+#else
+const bool bUseBlinn = false;
+#endif
+#ifdef USE_HDR
+const bool bHDR = true;
+#else
+const bool bHDR = false;
+#endif
+#ifdef USE_FOG
+const bool bUseFog = true;
+#else
+const bool bUseFog = false;
+#endif
 #define NUMBER_OF_POINT_LIGHTS 10
 
 // Structure holding material information:  its ambient, diffuse, specular, etc...
@@ -28,7 +65,7 @@ uniform struct Material
     bool bUseColor;
 } material;
 
-uniform struct Camera
+struct Camera
 {
     vec3 position;
     vec3 front;
@@ -36,20 +73,24 @@ uniform struct Camera
     float zfar;
     bool isMoving;
     bool isOrthographic;
-} camera;
+};
+
+// per frame camera, shared by all programs
+layout (std140) uniform CameraBlock
+{
+    Camera camera;
+};
 
 uniform struct HRDLight
 {
     float exposure;
     float gamma;
-    bool bHDR;
 } hrdlight;
 
 uniform struct Fog {
     float maxDist;
     float minDist;
     vec3 color;
-    bool bUseFog;
 } fog;
 
 
@@ -74,6 +115,7 @@ struct DirectionalLight
 {
     BaseLight base;
     vec3 direction;
+    vec3 position;
 };
 
 struct PointLight
@@ -92,11 +134,13 @@ struct SpotLight
     float outerCutOff;
 };
 
-uniform DirectionalLight R_directionallight;
-uniform PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
-uniform SpotLight R_spotlight;
-uniform bool bUseBlinn, bUseSmoothSpot;
-uniform bool bUseDirectionalLight, bUsePointLight, bUseSpotlight;
+// per frame lights, shared by all programs
+layout (std140) uniform LightsBlock
+{
+    DirectionalLight R_directionallight;
+    PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
+    SpotLight R_spotlight;
+};
 uniform float minThreshold, maxThreshold;
 
 
@@ -246,7 +290,7 @@ void main()
     
     // FOG
     vec3 fogColor = result.xyz;
-    if (fog.bUseFog) {
+    if (bUseFog) {
         //float dist = abs( fs_in.vEyePosition.z );
         float dist = length( fs_in.vEyePosition.xyz );
         float fogFactor = (fog.maxDist - dist) / (fog.maxDist - fog.minDist);
@@ -259,7 +303,7 @@ void main()
     
     // HDR
     vec3 hdrColor = result.xyz;
-    if(hrdlight.bHDR)
+    if(bHDR)
     {
         // tone mapping with exposure
         hdrColor = vec3(1.0f) - exp(-hdrColor * hrdlight.exposure);
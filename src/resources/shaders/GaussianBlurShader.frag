@@ -44,7 +44,9 @@ in VS_OUT
 uniform bool bHorizontal;
 uniform float intensity = 1.0f;
 uniform float coverage;        // between (0.0f and 1.0f)
-float weight[5] = float[] (0.2270270270f, 0.1945945946f, 0.1216216216f, 0.0540540541f, 0.0162162162f);
+// the 9 tap kernel sampled between texel pairs, bilinear filtering does the other taps for free
+float offset[3] = float[] (0.0f, 1.3846153846f, 3.2307692308f);
+float weight[3] = float[] (0.2270270270f, 0.3162162162f, 0.0702702703f);
 
 /*
 float weight[13] = float[] (
@@ -78,14 +80,14 @@ void main() {
         vec2 tex_offset = 1.0f / textureSize(material.depthMap, 0); // gets size of single texel
         vec3 result = texture(material.depthMap, uv).rgb * weight[0]; // current fragment's contribution
         if(bHorizontal) {
-            for(int i = 1; i < 5; ++i) {
-                result += texture(material.depthMap, uv + vec2(tex_offset.x * i, 0.0f)).rgb * weight[i] * intensity;
-                result += texture(material.depthMap, uv - vec2(tex_offset.x * i, 0.0f)).rgb * weight[i] * intensity;
+            for(int i = 1; i < 3; ++i) {
+                result += texture(material.depthMap, uv + vec2(tex_offset.x * offset[i], 0.0f)).rgb * weight[i] * intensity;
+                result += texture(material.depthMap, uv - vec2(tex_offset.x * offset[i], 0.0f)).rgb * weight[i] * intensity;
             }
         } else {
-            for(int i = 1; i < 5; ++i) {
-                result += texture(material.depthMap, uv + vec2(0.0f, tex_offset.y * i)).rgb * weight[i] * intensity;
-                result += texture(material.depthMap, uv - vec2(0.0f, tex_offset.y * i)).rgb * weight[i] * intensity;
+            for(int i = 1; i < 3; ++i) {
+                result += texture(material.depthMap, uv + vec2(0.0f, tex_offset.y * offset[i])).rgb * weight[i] * intensity;
+                result += texture(material.depthMap, uv - vec2(0.0f, tex_offset.y * offset[i])).rgb * weight[i] * intensity;
             }
         }
         
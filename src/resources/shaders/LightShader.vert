@@ -16,6 +16,17 @@ layout (location = 2) in vec3 inNormal;
 layout (location = 3) in vec3 inTangent;
 layout (location = 4) in vec3 inBiTangent;
 
+#ifdef INSTANCED
+// the model and normal matrix of each instance come from the instance buffer, see CInstanceBuffer
+layout (location = 5) in mat4 inModelMatrix;
+layout (location = 9) in mat3 inNormalMatrix;
+#define MODEL_MATRIX inModelMatrix
+#define NORMAL_MATRIX inNormalMatrix
+#else
+#define MODEL_MATRIX matrices.modelMatrix
+#define NORMAL_MATRIX matrices.normalMatrix
+#endif
+
 out VS_OUT
 {
     vec2 vTexCoord;    // Texture coordinate
@@ -41,16 +52,16 @@ void main() {
     
     // Get the vertex normal and vertex position in eye coordinates
     //mat3 normalMatrix = mat3(transpose(inverse(matrices.modelMatrix)));
-    vs_out.vWorldNormal = matrices.normalMatrix * normal;
-    vs_out.vWorldTangent = matrices.normalMatrix * tangent;
+    vs_out.vWorldNormal = NORMAL_MATRIX * normal;
+    vs_out.vWorldTangent = NORMAL_MATRIX * tangent;
     vs_out.vLocalNormal = normal;
     
-    vs_out.vEyePosition = matrices.viewMatrix * matrices.modelMatrix * position;
-    vs_out.vWorldPosition = vec3(matrices.modelMatrix * position);
+    vs_out.vEyePosition = matrices.viewMatrix * MODEL_MATRIX * position;
+    vs_out.vWorldPosition = vec3(MODEL_MATRIX * position);
     vs_out.vLocalPosition = inPosition;
    
     // Transform the vertex spatial position using
-    gl_Position = matrices.projMatrix * matrices.viewMatrix * matrices.modelMatrix * position;
+    gl_Position = matrices.projMatrix * matrices.viewMatrix * MODEL_MATRIX * position;
 
 }
 
@@ -9,7 +9,7 @@
 // https://learnopengl.com/Advanced-Lighting/Shadows/Shadow-Mapping
 // https://developer.nvidia.com/gpugems/GPUGems3/gpugems3_ch27.html
 
-uniform struct Camera
+struct Camera
 {
     vec3 position;
     vec3 front;
@@ -17,7 +17,13 @@ uniform struct Camera
     float zfar;
     bool isMoving;
     bool isOrthographic;
-} camera;
+};
+
+// per frame camera, shared by all programs
+layout (std140) uniform CameraBlock
+{
+    Camera camera;
+};
 
 // Structure holding material information:  its ambient, diffuse, specular, etc...
 uniform struct Material
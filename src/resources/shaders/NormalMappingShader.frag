@@ -1,5 +1,42 @@
 #version 400 core
 
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_DIRECTIONAL_LIGHT
+const bool bUseDirectionalLight = true;
+#else
+const bool bUseDirectionalLight = false;
+#endif
+#ifdef USE_POINT_LIGHT
+const bool bUsePointLight = true;
+#else
+const bool bUsePointLight = false;
+#endif
+#ifdef USE_SPOT_LIGHT
+const bool bUseSpotlight = true;
+#else
+const bool bUseSpotlight = false;
+#endif
+#ifdef USE_SMOOTH_SPOT
+const bool bUseSmoothSpot = true;
+#else
+const bool bUseSmoothSpot = false;
+#endif
+#ifdef USE_BLINN
+const bool bUseBlinn = true;
+#else
+const bool bUseBlinn = false;
+#endif
+#ifdef USE_HDR
+const bool bHDR = true;
+#else
+const bool bHDR = false;
+#endif
+#ifdef USE_FOG
+const bool bUseFog = true;
+#else
+const bool bUseFog = false;
+#endif
+
 // http://www.geeks3d.com/20130122/normal-mapping-without-precomputed-tangent-space-vectors/
 // https://learnopengl.com/#!Advanced-Lighting/Normal-Mapping
 // http://www.thetenthplanet.de/archives/1180
@@ -9,7 +46,7 @@
 
 precision highp float;
 
-uniform struct Camera
+struct Camera
 {
     vec3 position;
     vec3 front;
@@ -17,7 +54,13 @@ uniform struct Camera
     float zfar;
     bool isMoving;
     bool isOrthographic;
-} camera;
+};
+
+// per frame camera, shared by all programs
+layout (std140) uniform CameraBlock
+{
+    Camera camera;
+};
 
 // Structure holding material information:  its ambient, diffuse, specular, etc...
 uniform struct Material
@@ -50,14 +93,12 @@ uniform struct HRDLight
 {
     float exposure;
     float gamma;
-    bool bHDR;
 } hrdlight;
 
 uniform struct Fog {
     float maxDist;
     float minDist;
     vec3 color;
-    bool bUseFog;
 } fog;
 
 // Structure holding light information:  its position, colors, direction etc...
@@ -81,6 +122,7 @@ struct DirectionalLight
 {
     BaseLight base;
     vec3 direction;
+    vec3 position;
 };
 
 struct PointLight
@@ -88,7 +130,7 @@ struct PointLight
     BaseLight base;
     Attenuation attenuation;
     vec3 position;
-    float range;
+    float range; // This returns a radius between roughly 1.0 and 5.0 based on the light's maximum intensity.
 };
 
 struct SpotLight
@@ -99,11 +141,14 @@ struct SpotLight
     float outerCutOff;
 };
 
-uniform DirectionalLight R_directionallight;
-uniform PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
-uniform SpotLight R_spotlight;
+// per frame lights, shared by all programs
+layout (std140) uniform LightsBlock
+{
+    DirectionalLight R_directionallight;
+    PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
+    SpotLight R_spotlight;
+};
 uniform bUseBlinn, bUseSmoothSpot;
-uniform bool bUseDirectionalLight, bUsePointLight, bUseSpotlight;
 
 in VS_OUT
 {
@@ -239,7 +284,7 @@ void main()
     
     // FOG
     vec3 fogColor = result.xyz;
-    if (fog.bUseFog) {
+    if (bUseFog) {
         //float dist = abs( fs_in.vEyePosition.z );
         float dist = length( fs_in.vEyePosition.xyz );
         float fogFactor = (fog.maxDist - dist) / (fog.maxDist - fog.minDist);
@@ -252,7 +297,7 @@ void main()
     
     // HDR
     vec3 envColor = result.xyz;
-    if(hrdlight.bHDR)
+    if(bHDR)
     {
         // tone mapping with exposure
         envColor = vec3(1.0f) - exp(-envColor * hrdlight.exposure);
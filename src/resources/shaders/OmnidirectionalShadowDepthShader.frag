@@ -1,4 +1,21 @@
 #version 400 core
+
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_DIRECTIONAL_LIGHT
+const bool bUseDirectionalLight = true;
+#else
+const bool bUseDirectionalLight = false;
+#endif
+#ifdef USE_POINT_LIGHT
+const bool bUsePointLight = true;
+#else
+const bool bUsePointLight = false;
+#endif
+#ifdef USE_SPOT_LIGHT
+const bool bUseSpotlight = true;
+#else
+const bool bUseSpotlight = false;
+#endif
 #define NUMBER_OF_POINT_LIGHTS 10
 // https://learnopengl.com/Advanced-Lighting/Shadows/Point-Shadows
 
@@ -11,25 +28,52 @@ uniform struct Shadow
     bool bShowDepth;
 } shadow;
 
+struct BaseLight
+{
+    vec3 color;
+    float intensity;
+    float ambient;
+    float diffuse;
+    float specular;
+};
+
+struct Attenuation
+{
+    float constant;
+    float linear;
+    float exponent;
+};
+
 struct DirectionalLight
 {
+    BaseLight base;
+    vec3 direction;
     vec3 position;
 };
 
 struct PointLight
 {
+    BaseLight base;
+    Attenuation attenuation;
     vec3 position;
+    float range; // This returns a radius between roughly 1.0 and 5.0 based on the light's maximum intensity.
 };
 
 struct SpotLight
 {
     PointLight pointLight;
+    vec3 direction;
+    float cutOff;
+    float outerCutOff;
 };
 
-uniform DirectionalLight R_directionallight;
-uniform PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
-uniform SpotLight R_spotlight;
-uniform bool bUseDirectionalLight, bUsePointLight, bUseSpotlight;
+// per frame lights, shared by all programs
+layout (std140) uniform LightsBlock
+{
+    DirectionalLight R_directionallight;
+    PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
+    SpotLight R_spotlight;
+};
 
 in VS_OUT
 {
@@ -1,4 +1,41 @@
 #version 400 core
+
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_DIRECTIONAL_LIGHT
+const bool bUseDirectionalLight = true;
+#else
+const bool bUseDirectionalLight = false;
+#endif
+#ifdef USE_POINT_LIGHT
+const bool bUsePointLight = true;
+#else
+const bool bUsePointLight = false;
+#endif
+#ifdef USE_SPOT_LIGHT
+const bool bUseSpotlight = true;
+#else
+const bool bUseSpotlight = false;
+#endif
+#ifdef USE_SMOOTH_SPOT
+const bool bUseSmoothSpot = true;
+#else
+const bool bUseSmoothSpot = false;
+#endif
+#ifdef USE_BLINN
+const bool bUseBlinn = true;
+#else
+const bool bUseBlinn = false;
+#endif
+#ifdef USE_HDR
+const bool bHDR = true;
+#else
+const bool bHDR = false;
+#endif
+#ifdef USE_FOG
+const bool bUseFog = true;
+#else
+const bool bUseFog = false;
+#endif
 // https://3dcoat.com/pbr/
 // https://marmoset.co/posts/basic-theory-of-physically-based-rendering/
 // https://marmoset.co/posts/physically-based-rendering-and-you-can-too/
@@ -101,7 +138,7 @@ the linear RGB specular color values can be the following:
 #define NUMBER_OF_POINT_LIGHTS 10
 #define PI 3.14159265359
 
-uniform struct Camera
+struct Camera
 {
     vec3 position;
     vec3 front;
@@ -109,7 +146,13 @@ uniform struct Camera
     float zfar;
     bool isMoving;
     bool isOrthographic;
-} camera;
+};
+
+// per frame camera, shared by all programs
+layout (std140) uniform CameraBlock
+{
+    Camera camera;
+};
 
 // Structure holding PBR material information:  its albedo, metallic, roughness, etc...
 uniform struct Material
@@ -146,7 +189,6 @@ uniform struct Fog {
     float maxDist;
     float minDist;
     vec3 color;
-    bool bUseFog;
 } fog;
 
 // Structure holding hrd light information
@@ -154,7 +196,6 @@ uniform struct HRDLight
 {
     float exposure;
     float gamma;
-    bool bHDR;
 } hrdlight;
 
 // Structure holding light information:  its position, colors, direction etc...
@@ -165,8 +206,6 @@ struct BaseLight
     float ambient;
     float diffuse;
     float specular;
-    float exposure;
-    float gamma;
 };
 
 struct Attenuation
@@ -180,6 +219,7 @@ struct DirectionalLight
 {
     BaseLight base;
     vec3 direction;
+    vec3 position;
 };
 
 struct PointLight
@@ -198,11 +238,14 @@ struct SpotLight
     float outerCutOff;
 };
 
-uniform DirectionalLight R_directionallight;
-uniform PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
-uniform SpotLight R_spotlight;
-uniform bool bUseIrradiance, bUseBlinn, bUseSmoothSpot;
-uniform bool bUseDirectionalLight, bUsePointLight, bUseSpotlight;
+// per frame lights, shared by all programs
+layout (std140) uniform LightsBlock
+{
+    DirectionalLight R_directionallight;
+    PointLight R_pointlight[NUMBER_OF_POINT_LIGHTS];
+    SpotLight R_spotlight;
+};
+uniform bool bUseIrradiance;
 
 in VS_OUT
 {
@@ -444,7 +487,7 @@ void main()
     color += ambient;
     
     // FOG
-    if (fog.bUseFog) {
+    if (bUseFog) {
         /*
          In the above code, we used the absolute value of the z coordinate as the distance from the
          camera. This may cause the fog to look a bit unrealistic in certain situations. To compute a
@@ -474,7 +517,7 @@ void main()
     
     
     // HDR
-    if(hrdlight.bHDR)
+    if(bHDR)
     {
         // tone mapping with exposure
         color = vec3(1.0f) - exp(-color * hrdlight.exposure);
@@ -0,0 +1,137 @@
+#version 400 core
+
+/*
+ Fused pointwise post processing effects. Every effect here only reads the texel it writes, so a run of them
+ in the effect stack is one full screen pass instead of one pass each. The run is generated as PPFX_STACK,
+ the calls in stack order on the colour c, see Game::GetPPFXStackProgram. The bodies follow ColorInversionShader,
+ GrayScaleShader, PosterizationShader, PredatorsThermalVisionShader, VignettingShader and BayerMatrixDitheringShader.
+ */
+
+#ifndef PPFX_STACK
+#define PPFX_STACK
+#endif
+
+// Structure holding material information:  its ambient, diffuse, specular, etc...
+uniform struct Material
+{
+    sampler2D ambientMap;           // 0.   ambient map (albedo map)
+    sampler2D diffuseMap;           // 1.   diffuse map (metallic map)
+    sampler2D specularMap;          // 2.   specular map (roughness map)
+    sampler2D normalMap;            // 3.   normal map
+    sampler2D heightMap;            // 4.   height map
+    sampler2D emissionMap;          // 5.   emission map
+    sampler2D displacementMap;      // 6.   displacment map
+    sampler2D aoMap;                // 7.   ambient oclusion map
+    sampler2D glossinessMap;        // 8.   glossiness map
+    sampler2D opacityMap;           // 9.   opacity map
+    samplerCube shadowMap;          // 10.  shadow cube map
+    sampler2D depthMap;             // 11.  depth map
+    sampler2D noiseMap;             // 12.  noise map
+    sampler2D maskMap;              // 13.  mask map
+    sampler2D lensMap;              // 14.  lens map
+    samplerCube cubeMap;            // 15.  sky box or environment mapping cube map
+    vec4 color;
+    vec4 guiColor;
+    float shininess;
+} material;
+
+in VS_OUT
+{
+    vec2 vTexCoord;    // Texture coordinate
+    vec3 vLocalPosition;
+    vec3 vLocalNormal;
+    vec3 vWorldPosition;
+    vec3 vWorldNormal;
+    vec4 vEyePosition;
+} fs_in;
+
+uniform float coverage;        // between (0.0f and 1.0f)
+
+// Posterization
+uniform float posterizationGamma = 0.6f;
+uniform float posterizationColors = 8.0f;
+
+// Vignetting
+uniform bool vignettingTint, vignettingSepia;
+uniform float vignettingRadius = 0.3f; // [0 - 0.5]
+uniform float vignettingSoftness = 0.25f;
+
+const vec3 SEPIA = vec3(1.2f, 1.0f, 0.8f);
+
+// Bayer Matrix Dithering
+const float ditherStrength = 0.5f;
+const float ditherGamma = 0.6f;
+const float ditherBrightness = 1.4f;
+const float BAYER_8X8[64] = float[](
+    0.015625, 0.515625, 0.140625, 0.640625, 0.046875, 0.546875, 0.171875, 0.671875,
+    0.765625, 0.265625, 0.890625, 0.390625, 0.796875, 0.296875, 0.921875, 0.421875,
+    0.203125, 0.703125, 0.078125, 0.578125, 0.234375, 0.734375, 0.109375, 0.609375,
+    0.953125, 0.453125, 0.828125, 0.328125, 0.984375, 0.484375, 0.859375, 0.359375,
+    0.0625, 0.5625, 0.1875, 0.6875, 0.03125, 0.53125, 0.15625, 0.65625,
+    0.8125, 0.3125, 0.9375, 0.4375, 0.78125, 0.28125, 0.90625, 0.40625,
+    0.25, 0.75, 0.125, 0.625, 0.21875, 0.71875, 0.09375, 0.59375,
+    1.0, 0.5, 0.875, 0.375, 0.96875, 0.46875, 0.84375, 0.34375
+);
+
+out vec4 vOutputColour;		// The output colour formely  gl_FragColor
+
+vec4 colorInversion(vec4 c, vec2 uv) {
+    return vec4(vec3(1.0f) - c.rgb, 1.0f);
+}
+
+vec4 grayScale(vec4 c, vec2 uv) {
+    float average = 0.2126f * c.r + 0.7152f * c.g + 0.0722f * c.b;
+    return vec4(average, average, average, 1.0f);
+}
+
+vec4 posterization(vec4 c, vec2 uv) {
+    vec3 p = pow(c.rgb, vec3(posterizationGamma));
+    p = floor(p * posterizationColors) / posterizationColors;
+    return vec4(pow(p, vec3(1.0f / posterizationGamma)), 1.0f);
+}
+
+vec4 predatorsThermalVision(vec4 c, vec2 uv) {
+    vec3 colors[3] = vec3[](vec3(0.0f, 0.0f, 1.0f), vec3(1.0f, 1.0f, 0.0f), vec3(1.0f, 0.0f, 0.0f));
+    float lum = (c.r + c.g + c.b) / 3.0f;
+    int ix = (lum < 0.5f) ? 0 : 1;
+    return vec4(mix(colors[ix], colors[ix + 1], (lum - float(ix) * 0.5f) / 0.5f), 1.0f);
+}
+
+vec4 vignetting(vec4 c, vec2 uv) {
+    float vignette = 1.0f - smoothstep(vignettingRadius, 1.0f - vignettingSoftness, length(uv - vec2(0.5f)));
+    
+    if (vignettingTint) {
+        c.rgb = mix(c.rgb, c.rgb * vignette, 0.5f);
+        vec3 grayColor = vec3(dot(c.rgb, vec3(0.299f, 0.587f, 0.114f)));
+        c.rgb = mix(c.rgb, vignettingSepia ? grayColor * SEPIA : grayColor, 0.75f);
+    }
+    
+    c.rgb *= vignette;
+    return c;
+}
+
+vec4 bayerMatrixDithering(vec4 c, vec2 uv) {
+    ivec2 p = ivec2(mod(gl_FragCoord.xy, 8.0f));
+    float l = pow(dot(c.rgb, vec3(0.2125f, 0.7154f, 0.0721f)), ditherGamma) - 1.0f/255.0f;
+    float dither = l < BAYER_8X8[p.x + p.y * 8] ? 0.0f : ditherBrightness;
+    return (1.0f - ditherStrength) * c + ditherStrength * vec4(c.rgb * dither, 1.0f);
+}
+
+void main()
+{
+    vec2 uv = fs_in.vTexCoord.xy;
+    vec4 tc = texture(material.ambientMap, uv);
+    
+    if (uv.x < coverage)
+    {
+        vec4 c = tc;
+        PPFX_STACK
+        tc = c;
+    }
+    else if (uv.x < (coverage + 0.003f) && coverage <= (1.0f + 0.003f))
+    {
+        tc = material.guiColor;
+    }
+    
+    vOutputColour = tc;
+}
@@ -0,0 +1,65 @@
+#version 400 core
+
+// Reduced geometry buffer for the half and quarter resolution ssao tiers. Every texel keeps one of the
+// full resolution texels it covers instead of an average, averaged positions and normals belong to no surface.
+
+// Structure holding material information:  its ambient, diffuse, specular, etc...
+uniform struct Material
+{
+    sampler2D ambientMap;           // 0.   ambient map (albedo map)
+    sampler2D diffuseMap;           // 1.   diffuse map (metallic map)
+    sampler2D specularMap;          // 2.   specular map (roughness map)
+    sampler2D normalMap;            // 3.   normal map
+    sampler2D heightMap;            // 4.   height map
+    sampler2D emissionMap;          // 5.   emission map
+    sampler2D displacementMap;      // 6.   displacment map
+    sampler2D aoMap;                // 7.   ambient oclusion map
+    sampler2D glossinessMap;        // 8.   glossiness map
+    sampler2D opacityMap;           // 9.   opacity map
+    samplerCube shadowMap;          // 10.  shadow cube map
+    sampler2D depthMap;             // 11.  depth map
+    sampler2D noiseMap;             // 12.  noise map
+    sampler2D maskMap;              // 13.  mask map
+    sampler2D lensMap;              // 14.  lens map
+    samplerCube cubeMap;            // 15.  sky box or environment mapping cube map
+    vec4 color;
+    float shininess;
+    float uvTiling;
+} material;
+
+in VS_OUT
+{
+    vec2 vTexCoord;    // Texture coordinate
+    vec3 vLocalPosition;
+    vec3 vLocalNormal;
+    vec3 vWorldPosition;
+    vec3 vWorldNormal;
+    vec4 vEyePosition;
+} fs_in;
+
+uniform int footprint = 2;      // full resolution texels across one of these
+
+layout (location = 2) out vec3 vOutputPosition;   // same attachments as the geometry buffer
+layout (location = 3) out vec3 vOutputNormal;
+
+void main()
+{
+    ivec2 size = textureSize(material.displacementMap, 0);
+    ivec2 origin = ivec2(gl_FragCoord.xy) * footprint;
+    
+    // of the corners of the footprint take the one closest to the camera, empty texels have no position
+    vec3 position = vec3(0.0f);
+    vec3 normal = vec3(0.0f, 0.0f, 1.0f);
+    float closest = -1.0e20f;
+    for (int i = 0; i < 4; ++i) {
+        ivec2 texel = min(origin + ivec2(i & 1, i >> 1) * (footprint - 1), size - 1);
+        vec3 corner = texelFetch(material.displacementMap, texel, 0).xyz;
+        if (corner == vec3(0.0f) || corner.z <= closest) continue;
+        closest = corner.z;
+        position = corner;
+        normal = texelFetch(material.normalMap, texel, 0).rgb;
+    }
+    
+    vOutputPosition = position;
+    vOutputNormal = normal;
+}
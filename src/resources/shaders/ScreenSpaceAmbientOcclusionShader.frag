@@ -45,6 +45,9 @@ uniform float radius = 0.5f;
 uniform float bias = 0.025f;
 uniform float width, height;
 uniform float noiseSize = 4.0f;
+uniform int sampleCount = KERNEL_SIZE;  // the cheaper tiers take every n-th sample of the kernel
+uniform int sampleOffset = 0;           // first kernel sample of this frame, the temporal tiers move it every frame
+uniform vec2 noiseOffset = vec2(0.0f);  // moves the noise tiling every frame, in noise texels
 
 out float vOutputColour;        // The output colour formely  gl_FragColor
 
@@ -58,7 +61,7 @@ void main()
     // retrieve data from gbuffer
     vec3 fragPos = texture(material.displacementMap, uv).xyz;                       // displacementMap
     vec3 normal = normalize(texture(material.normalMap, uv).rgb);                   // normalMap
-    vec4 noise = texture(material.noiseMap, uv * noiseScale);                       // noise Map
+    vec4 noise = texture(material.noiseMap, uv * noiseScale + noiseOffset / noiseSize); // noise Map
     vec3 randomVec = normalize(noise.xyz);
     // create TBN change-of-basis matrix: from tangent-space to view-space
     vec3 tangent = normalize(randomVec - normal * dot(randomVec, normal));
@@ -67,10 +70,10 @@ void main()
      
     // iterate over the sample kernel and calculate occlusion factor
     float occlusion = 0.0f;
-    for(int i = 0; i < KERNEL_SIZE; ++i)
+    for(int i = 0; i < sampleCount; ++i)
     {
-        // get sample position
-        vec3 vSample = TBN * samples[i]; // from tangent to view-space
+        // get sample position, a step through the whole kernel so a part of it still reaches every distance
+        vec3 vSample = TBN * samples[(i * KERNEL_SIZE / sampleCount + sampleOffset) % KERNEL_SIZE]; // from tangent to view-space
         vSample = fragPos + vSample * radius; 
         
         // project sample position (to sample texture) (to get position on screen/texture)
@@ -86,7 +89,7 @@ void main()
         float rangeCheck = smoothstep(0.0f, 1.0f, radius / abs(fragPos.z - sampleDepth));
         occlusion += ( (sampleDepth >= vSample.z + bias) ? 1.0f : 0.0f) * rangeCheck;   
     }
-    occlusion = 1.0f - (occlusion / float(KERNEL_SIZE));
+    occlusion = 1.0f - (occlusion / float(sampleCount));
     
     vOutputColour = occlusion;
 }
@@ -0,0 +1,71 @@
+#version 400 core
+
+// Temporal accumulation of the ssao tiers that only take part of the kernel each frame. The occlusion of
+// the previous frames is found by reprojecting the view space position and blended with this frame's. Texels
+// the camera could not see last frame, found by comparing the depth kept with the history, start again.
+
+// Structure holding material information:  its ambient, diffuse, specular, etc...
+uniform struct Material
+{
+    sampler2D ambientMap;           // 0.   ambient map (albedo map)
+    sampler2D diffuseMap;           // 1.   diffuse map (metallic map)
+    sampler2D specularMap;          // 2.   specular map (roughness map)
+    sampler2D normalMap;            // 3.   normal map
+    sampler2D heightMap;            // 4.   height map
+    sampler2D emissionMap;          // 5.   emission map
+    sampler2D displacementMap;      // 6.   displacment map
+    sampler2D aoMap;                // 7.   ambient oclusion map
+    sampler2D glossinessMap;        // 8.   glossiness map
+    sampler2D opacityMap;           // 9.   opacity map
+    samplerCube shadowMap;          // 10.  shadow cube map
+    sampler2D depthMap;             // 11.  depth map
+    sampler2D noiseMap;             // 12.  noise map
+    sampler2D maskMap;              // 13.  mask map
+    sampler2D lensMap;              // 14.  lens map
+    samplerCube cubeMap;            // 15.  sky box or environment mapping cube map
+    vec4 color;
+    float shininess;
+    float uvTiling;
+} material;
+
+in VS_OUT
+{
+    vec2 vTexCoord;    // Texture coordinate
+    vec3 vLocalPosition;
+    vec3 vLocalNormal;
+    vec3 vWorldPosition;
+    vec3 vWorldNormal;
+    vec4 vEyePosition;
+} fs_in;
+
+uniform mat4 projection;
+uniform mat4 viewToPreviousView;    // this frame's view space to the previous frame's
+uniform float blend = 0.125f;       // weight of this frame
+uniform bool bReset;                // no usable history, after a switch or a resize
+
+out vec2 vOutputColour;             // occlusion and view space depth
+
+void main()
+{
+    vec2 uv = fs_in.vTexCoord.xy;
+    
+    float occlusion = texture(material.aoMap, uv).r;                // this frame's occlusion
+    vec3 position = texture(material.displacementMap, uv).xyz;      // reduced position
+    
+    if (bReset || position == vec3(0.0f)) {
+        vOutputColour = vec2(occlusion, position.z);
+        return;
+    }
+    
+    // where the surface was on screen in the previous frame
+    vec4 previous = viewToPreviousView * vec4(position, 1.0f);
+    vec4 clip = projection * previous;
+    vec2 previousUV = clip.xy / clip.w * 0.5f + 0.5f;
+    
+    vec2 history = texture(material.depthMap, previousUV).rg;      // depth map, the history
+    bool onScreen = all(greaterThanEqual(previousUV, vec2(0.0f))) && all(lessThanEqual(previousUV, vec2(1.0f)));
+    bool sameSurface = abs(history.g - previous.z) < 0.05f * abs(previous.z);
+    
+    float accumulated = (onScreen && sameSurface) ? mix(history.r, occlusion, blend) : occlusion;
+    vOutputColour = vec2(accumulated, position.z);
+}
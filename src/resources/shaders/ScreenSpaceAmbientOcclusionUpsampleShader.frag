@@ -0,0 +1,86 @@
+#version 400 core
+
+// Depth aware upsample of the reduced occlusion to the window size. Of the four reduced texels around a
+// pixel the ones on another surface, by depth or by normal, get little weight so the occlusion does not
+// bleed across edges the way a bilinear upsample would.
+
+// Structure holding material information:  its ambient, diffuse, specular, etc...
+uniform struct Material
+{
+    sampler2D ambientMap;           // 0.   ambient map (albedo map)
+    sampler2D diffuseMap;           // 1.   diffuse map (metallic map)
+    sampler2D specularMap;          // 2.   specular map (roughness map)
+    sampler2D normalMap;            // 3.   normal map
+    sampler2D heightMap;            // 4.   height map
+    sampler2D emissionMap;          // 5.   emission map
+    sampler2D displacementMap;      // 6.   displacment map
+    sampler2D aoMap;                // 7.   ambient oclusion map
+    sampler2D glossinessMap;        // 8.   glossiness map
+    sampler2D opacityMap;           // 9.   opacity map
+    samplerCube shadowMap;          // 10.  shadow cube map
+    sampler2D depthMap;             // 11.  depth map
+    sampler2D noiseMap;             // 12.  noise map
+    sampler2D maskMap;              // 13.  mask map
+    sampler2D lensMap;              // 14.  lens map
+    samplerCube cubeMap;            // 15.  sky box or environment mapping cube map
+    vec4 color;
+    float shininess;
+    float uvTiling;
+} material;
+
+in VS_OUT
+{
+    vec2 vTexCoord;    // Texture coordinate
+    vec3 vLocalPosition;
+    vec3 vLocalNormal;
+    vec3 vWorldPosition;
+    vec3 vWorldNormal;
+    vec4 vEyePosition;
+} fs_in;
+
+out float vOutputColour;
+
+void main()
+{
+    vec2 uv = fs_in.vTexCoord.xy;
+    
+    vec3 position = texture(material.displacementMap, uv).xyz;      // full resolution position
+    if (position == vec3(0.0f)) {
+        vOutputColour = 1.0f;   // nothing rendered here, nothing to occlude
+        return;
+    }
+    vec3 normal = normalize(texture(material.normalMap, uv).rgb);   // full resolution normal
+    
+    ivec2 size = textureSize(material.aoMap, 0);
+    vec2 coord = uv * vec2(size) - 0.5f;
+    ivec2 base = ivec2(floor(coord));
+    vec2 f = fract(coord);
+    
+    float occlusion = 0.0f;
+    float total = 0.0f;
+    float nearest = 1.0f;
+    float nearestWeight = -1.0f;
+    for (int i = 0; i < 4; ++i) {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 texel = clamp(base + offset, ivec2(0), size - 1);
+        
+        float ao = texelFetch(material.aoMap, texel, 0).r;                  // reduced occlusion
+        vec3 lowPosition = texelFetch(material.heightMap, texel, 0).xyz;    // height map, reduced position
+        vec3 lowNormal = texelFetch(material.emissionMap, texel, 0).rgb;    // emission map, reduced normal
+        
+        float bilinear = (offset.x == 1 ? f.x : 1.0f - f.x) * (offset.y == 1 ? f.y : 1.0f - f.y);
+        float depthWeight = 1.0f / (0.001f + abs(position.z - lowPosition.z));
+        float normalWeight = lowPosition == vec3(0.0f) ? 0.0f : pow(max(dot(normal, normalize(lowNormal)), 0.0f), 8.0f);
+        float weight = bilinear * depthWeight * normalWeight;
+        
+        occlusion += ao * weight;
+        total += weight;
+        if (bilinear > nearestWeight) {
+            nearestWeight = bilinear;
+            nearest = ao;
+        }
+    }
+    
+    // no reduced texel on this surface, keep the closest one
+    vOutputColour = total > 1.0e-4f ? occlusion / total : nearest;
+}
@@ -1,4 +1,16 @@
 #version 400 core
+
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_HDR
+const bool bHDR = true;
+#else
+const bool bHDR = false;
+#endif
+#ifdef USE_FOG
+const bool bUseFog = true;
+#else
+const bool bUseFog = false;
+#endif
 #define PI 3.14159265359
 
 // Structure holding material information:  its ambient, diffuse, specular, etc...
@@ -35,14 +47,12 @@ uniform struct HRDLight
 {
     float exposure;
     float gamma;
-    bool bHDR;
 } hrdlight;
 
 uniform struct Fog {
     float maxDist;
     float minDist;
     vec3 color;
-    bool bUseFog;
 } fog;
 
 uniform bool bUseEnvCubemap;
@@ -61,7 +71,7 @@ void main()
         
         // HDR
         vec3 envColor = texture(material.cubeMap, fs_in.vLocalPosition).rgb;
-        if(hrdlight.bHDR)
+        if(bHDR)
         {
             // tone mapping with exposure
             envColor = vec3(1.0f) - exp(-envColor * hrdlight.exposure);
@@ -78,7 +88,7 @@ void main()
     }
     
     // FOG
-    if (fog.bUseFog) {
+    if (bUseFog) {
         result = vec4(fog.color, 1.0f);
     }
     
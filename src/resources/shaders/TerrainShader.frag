@@ -1,5 +1,12 @@
 #version 400 core
 
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_HEIGHT_MAP
+const bool bUseHeightMap = true;
+#else
+const bool bUseHeightMap = false;
+#endif
+
 /*   Fragment shader variables
      
      Within the fragment shader we also have access to some interesting variables. GLSL gives us two interesting input variables called gl_FragCoord and gl_FrontFacing.
@@ -30,7 +37,6 @@ uniform struct Material
 } material;
 
 uniform float fMinHeight, fMaxHeight;
-uniform bool bUseHeightMap;
 
 /*
      Then we also need to declare an input interface block in the next shader which is the fragment shader. The block name (VS_OUT) should be the same in the fragment shader, but the instance name (vs_out as used in the vertex shader) can be anything we like - avoiding confusing names like vs_out that actually contains input variables.
@@ -1,5 +1,12 @@
 #version 400 core
 
+// features compiled into each program variant, see ShaderFeature
+#ifdef USE_HDR
+const bool bHDR = true;
+#else
+const bool bHDR = false;
+#endif
+
 ////https://learnopengl.com/code_viewer_gh.php?code=src/5.advanced_lighting/6.hdr/hdr.cpp
 ///https://learnopengl.com/Advanced-Lighting/HDR
 
@@ -31,7 +38,6 @@ uniform struct HRDLight
 {
     float exposure;
     float gamma;
-    bool bHDR;
 } hrdlight;
 
 in VS_OUT
@@ -58,7 +64,7 @@ void main()
     if (uv.x <  coverage )
     {
         // HDR
-        if(hrdlight.bHDR)
+        if(bHDR)
         {
             // reinhard
             // vec3 result = hdrColor / (hdrColor + vec3(1.0f));
@@ -0,0 +1,50 @@
+//
+//  Material.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "Material.h"
+#include "../texture/Texture.h"
+
+CMaterial::CMaterial()
+{
+    m_textures = {};
+}
+
+CMaterial::~CMaterial()
+{
+    Release();
+}
+
+void CMaterial::Create(const std::string &directory, const std::map<std::string, TextureType> &textureNames)
+{
+    m_textures.reserve(textureNames.size());
+    for (auto it = textureNames.begin(); it != textureNames.end(); ++it) {
+        CTexture *pTexture = new CTexture;
+        pTexture->LoadTexture(directory+it->first, it->second, true);
+        pTexture->SetSamplerObjectParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        pTexture->SetSamplerObjectParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        pTexture->SetSamplerObjectParameter(GL_TEXTURE_WRAP_S, GL_REPEAT);
+        pTexture->SetSamplerObjectParameter(GL_TEXTURE_WRAP_T, GL_REPEAT);
+        m_textures.push_back(pTexture);
+    }
+}
+
+void CMaterial::Bind() const
+{
+    for (GLuint i = 0; i < m_textures.size(); ++i){
+        m_textures[i]->BindTexture2DToTextureType();
+    }
+}
+
+void CMaterial::Release()
+{
+    for (GLuint i = 0; i < m_textures.size(); ++i){
+        m_textures[i]->Release();
+        delete m_textures[i];
+    }
+    m_textures.clear();
+}
@@ -0,0 +1,33 @@
+//
+//  Material.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef Material_h
+#define Material_h
+
+#include "../SceneBase.h"
+
+class CTexture;
+
+// A set of textures bound to their texture type units, shared by every scene object that uses it
+// so a texture folder is loaded once however many meshes are drawn with it.
+class CMaterial
+{
+public:
+    CMaterial();
+    ~CMaterial();
+    void Create(const std::string &directory, const std::map<std::string, TextureType> &textureNames);
+    void Bind() const;
+    GLboolean IsTextured() const { return !m_textures.empty(); }
+    void Release();
+private:
+    std::vector<CTexture*> m_textures;
+};
+
+#endif /* Material_h */
@@ -0,0 +1,220 @@
+//
+//  SceneLoader.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "SceneLoader.h"
+#include "SceneStore.h"
+#include "Material.h"
+#include "../mesh/Model.h"
+#include "../objects/Sphere.h"
+#include "../objects/Cube.h"
+#include "../objects/Torus.h"
+#include "../objects/TorusKnot.h"
+#include "../utilities/RenderQueue.h"
+
+static bool TextureTypeFromName(const std::string &name, TextureType &type)
+{
+    static const std::map<std::string, TextureType> types = {
+        { "ambient", TextureType::AMBIENT },
+        { "diffuse", TextureType::DIFFUSE },
+        { "specular", TextureType::SPECULAR },
+        { "normal", TextureType::NORMAL },
+        { "height", TextureType::HEIGHT },
+        { "emission", TextureType::EMISSION },
+        { "displacement", TextureType::DISPLACEMENT },
+        { "ao", TextureType::AO },
+        { "glossiness", TextureType::GLOSSINESS },
+        { "opacity", TextureType::OPACITY },
+        { "albedo", TextureType::ALBEDO },
+        { "metalness", TextureType::METALNESS },
+        { "roughness", TextureType::ROUGHNESS }
+    };
+    auto it = types.find(name);
+    if (it == types.end()) return false;
+    type = it->second;
+    return true;
+}
+
+CSceneLoader::CSceneLoader()
+{
+    m_line = 0;
+    m_programCount = 0;
+}
+
+bool CSceneLoader::Error(const std::string &message)
+{
+    printf("Scene file %s line %u: %s\n", m_file.c_str(), m_line, message.c_str());
+    return false;
+}
+
+bool CSceneLoader::Load(const std::string &file, const std::string &resourcePath, const GLuint &programCount, CSceneStore &store)
+{
+    std::ifstream stream(file);
+    if (!stream.is_open()) {
+        printf("Scene file could not be opened: %s\n", file.c_str());
+        return false;
+    }
+
+    m_file = file;
+    m_resourcePath = resourcePath;
+    m_line = 0;
+    m_programCount = programCount;
+
+    bool bLoaded = true;
+    std::string sLine;
+    while (std::getline(stream, sLine)) {
+        m_line++;
+        std::size_t comment = sLine.find('#');
+        if (comment != std::string::npos) sLine.erase(comment);
+
+        std::istringstream line(sLine);
+        std::string keyword;
+        if (!(line >> keyword)) continue;
+
+        if (keyword == "mesh") bLoaded = ParseMesh(line, store) && bLoaded;
+        else if (keyword == "material") bLoaded = ParseMaterial(line, store) && bLoaded;
+        else if (keyword == "object") bLoaded = ParseObject(line, store) && bLoaded;
+        else if (keyword == "layer") {
+            std::string name;
+            if (!(line >> name) || !store.BeginLayer(name))
+                bLoaded = Error("layer needs a name that is not used yet");
+        }
+        else bLoaded = Error("unknown declaration " + keyword);
+    }
+
+    store.UpdateBounds();
+    return bLoaded;
+}
+
+bool CSceneLoader::ParseMesh(std::istringstream &line, CSceneStore &store)
+{
+    std::string name, kind;
+    if (!(line >> name >> kind)) return Error("mesh needs a name and a kind");
+    if (store.FindMesh(name) >= 0) return Error("mesh " + name + " is declared twice");
+
+    IGameObject *pObject = nullptr;
+    CModel *pModel = nullptr;
+    if (kind == "sphere") {
+        int slices, stacks;
+        if (!(line >> slices >> stacks)) return Error("sphere needs slices and stacks");
+        CSphere *pSphere = new CSphere;
+        pSphere->Create("", {}, slices, stacks);
+        pObject = pSphere;
+    } else if (kind == "cube") {
+        GLfloat size;
+        if (!(line >> size)) return Error("cube needs a size");
+        CCube *pCube = new CCube(size);
+        pCube->Create("", {});
+        pObject = pCube;
+    } else if (kind == "torus") {
+        int radialSegments, circularSegments;
+        float outerRadius, innerRadius;
+        if (!(line >> radialSegments >> circularSegments >> outerRadius >> innerRadius))
+            return Error("torus needs its segments and radii");
+        CTorus *pTorus = new CTorus;
+        pTorus->Create("", {}, radialSegments, circularSegments, outerRadius, innerRadius);
+        pObject = pTorus;
+    } else if (kind == "torusknot") {
+        int steps, facets;
+        float scale, thickness, clumps, clumpOffset, clumpScale, uScale, vScale, p, q;
+        if (!(line >> steps >> facets >> scale >> thickness >> clumps >> clumpOffset >> clumpScale >> uScale >> vScale >> p >> q))
+            return Error("torus knot needs all eleven parameters");
+        CTorusKnot *pTorusKnot = new CTorusKnot;
+        pTorusKnot->Create("", {}, steps, facets, scale, thickness, clumps, clumpOffset, clumpScale, uScale, vScale, p, q);
+        pObject = pTorusKnot;
+    } else if (kind == "model") {
+        std::string file;
+        if (!(line >> file)) return Error("model needs a file");
+        pModel = new CModel;
+        if (!pModel->Create(m_resourcePath+"/"+file, "", {})) {
+            delete pModel;
+            return Error("model " + file + " could not be loaded");
+        }
+        pObject = pModel;
+    } else {
+        return Error("unknown mesh kind " + kind);
+    }
+
+    glm::vec3 boundsMin(0.0f), boundsMax(0.0f);
+    pObject->GetBounds(boundsMin, boundsMax);
+    store.AddMesh(name, pObject, pModel, boundsMin, boundsMax);
+    return true;
+}
+
+bool CSceneLoader::ParseMaterial(std::istringstream &line, CSceneStore &store)
+{
+    std::string name, folder;
+    if (!(line >> name)) return Error("material needs a name");
+    if (store.FindMaterial(name) >= 0) return Error("material " + name + " is declared twice");
+
+    std::map<std::string, TextureType> textureNames;
+    if (line >> folder) {
+        std::string file, typeName;
+        while (line >> file) {
+            if (file == "pbr") {
+                std::string extension;
+                if (!(line >> extension)) return Error("pbr needs a file extension");
+                textureNames["albedo."+extension] = TextureType::ALBEDO;
+                textureNames["metallic."+extension] = TextureType::METALNESS;
+                textureNames["roughness."+extension] = TextureType::ROUGHNESS;
+                textureNames["normal."+extension] = TextureType::NORMAL;
+                textureNames["ao."+extension] = TextureType::AO;
+                textureNames["ambient."+extension] = TextureType::AMBIENT;
+                textureNames["diffuse."+extension] = TextureType::DIFFUSE;
+                textureNames["specular."+extension] = TextureType::SPECULAR;
+                continue;
+            }
+            TextureType type;
+            if (!(line >> typeName) || !TextureTypeFromName(typeName, type))
+                return Error("texture " + file + " needs a known texture type");
+            textureNames[file] = type;
+        }
+    }
+
+    CMaterial *pMaterial = new CMaterial;
+    pMaterial->Create(m_resourcePath+"/"+folder+"/", textureNames);
+    store.AddMaterial(name, pMaterial);
+    return true;
+}
+
+bool CSceneLoader::ParseObject(std::istringstream &line, CSceneStore &store)
+{
+    std::string meshName, materialName, programName;
+    glm::vec3 position, rotation, scale;
+    if (!(line >> meshName >> materialName >> programName
+          >> position.x >> position.y >> position.z
+          >> rotation.x >> rotation.y >> rotation.z
+          >> scale.x >> scale.y >> scale.z))
+        return Error("object needs a mesh, a material, a program, a position, a rotation and a scale");
+
+    GLint mesh = store.FindMesh(meshName);
+    GLint material = store.FindMaterial(materialName);
+    if (mesh < 0) return Error("unknown mesh " + meshName);
+    if (material < 0) return Error("unknown material " + materialName);
+
+    GLint program = -1;
+    if (programName != "scene") {
+        std::istringstream index(programName);
+        if (!(index >> program) || program < 0) return Error("program must be scene or a shader program index");
+        if (static_cast<GLuint>(program) >= m_programCount) return Error("there is no shader program " + programName);
+        // the render queue keys hold the program one up, scene being 0
+        if (static_cast<GLuint>(program) + 1 >= CRenderQueue::GetProgramCount())
+            return Error("shader program " + programName + " does not fit in a render queue key");
+    }
+
+    GLuint flags = SceneFlagBit(SceneFlag::Visible);
+    std::string flag;
+    while (line >> flag) {
+        if (flag == "spin") flags |= SceneFlagBit(SceneFlag::Spin);
+        else if (flag == "occluder") flags |= SceneFlagBit(SceneFlag::Occluder);
+        else if (flag == "hidden") flags &= ~SceneFlagBit(SceneFlag::Visible);
+        else return Error("unknown object flag " + flag);
+    }
+
+    store.AddObject(position, rotation, scale, static_cast<GLuint>(mesh), static_cast<GLuint>(material), program, flags);
+    return true;
+}
@@ -0,0 +1,51 @@
+//
+//  SceneLoader.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef SceneLoader_h
+#define SceneLoader_h
+
+#include "../SceneBase.h"
+
+class CSceneStore;
+
+// Reads a scene file into a scene store, one declaration per line, # starts a comment:
+//
+//  mesh <name> sphere <slices> <stacks>
+//  mesh <name> cube <size>
+//  mesh <name> torus <radial segments> <circular segments> <outer radius> <inner radius>
+//  mesh <name> torusknot <steps> <facets> <scale> <thickness> <clumps> <clump offset> <clump scale> <u scale> <v scale> <p> <q>
+//  mesh <name> model <file>
+//  material <name> [<folder> [pbr <extension>] [<file> <texture type>]...]
+//  layer <name>
+//  object <mesh> <material> <program> <x y z> <rx ry rz> <sx sy sz> [spin] [hidden] [occluder]
+//
+// pbr <extension> stands for the albedo, metallic, roughness, normal, ao, ambient, diffuse and specular maps
+// of the folder. Program is a shader program index below the program count Load is given, or scene for the
+// program the layer is rendered with.
+// Occluders hide the objects of their layer behind them, only meshes with an occluder shape such as cubes count.
+// Files and folders are relative to the resource path.
+class CSceneLoader
+{
+public:
+    CSceneLoader();
+    bool Load(const std::string &file, const std::string &resourcePath, const GLuint &programCount, CSceneStore &store);
+private:
+    bool ParseMesh(std::istringstream &line, CSceneStore &store);
+    bool ParseMaterial(std::istringstream &line, CSceneStore &store);
+    bool ParseObject(std::istringstream &line, CSceneStore &store);
+    bool Error(const std::string &message);
+
+    std::string m_file;
+    std::string m_resourcePath;
+    GLuint m_line;
+    GLuint m_programCount;
+};
+
+#endif /* SceneLoader_h */
@@ -0,0 +1,173 @@
+//
+//  ScenePipeline.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "ScenePipeline.h"
+
+static GLdouble ElapsedMilliseconds(const std::chrono::steady_clock::time_point &from, const std::chrono::steady_clock::time_point &to)
+{
+    return std::chrono::duration<GLdouble, std::milli>(to - from).count();
+}
+
+// the first frame of a mode sets the average, the ones after move it a little, so a hitch does not swamp it
+static void AddSample(GLdouble &average, const GLdouble &value, const GLuint &frames)
+{
+    average = frames == 0 ? value : average + (value - average) * 0.05;
+}
+
+CScenePipeline::CScenePipeline()
+{
+    for (SceneFrame &frame : m_frames) {
+        frame.index = 0;
+        frame.deltaTime = 0.0f;
+        frame.onHeightMap = false;
+        frame.numBalls = 0;
+        frame.transforms = 0;
+        frame.simulated = std::chrono::steady_clock::now();
+        frame.simulationTime = 0.0;
+    }
+    for (ScenePipelineStats &stats : m_stats)
+        stats = ScenePipelineStats{0.0, 0.0, 0.0, 0.0, 0};
+    m_front = 0;
+    m_frameIndex = 0;
+    m_bRunning = false;
+    m_bStop = false;
+    m_bRequested = false;
+    m_bReady = false;
+    m_lastFrameEnd = std::chrono::steady_clock::now();
+    m_lastMode = -1;
+    m_waitTime = 0.0;
+}
+
+CScenePipeline::~CScenePipeline()
+{
+    Stop();
+}
+
+void CScenePipeline::Create(const Simulation &simulation)
+{
+    m_simulation = simulation;
+}
+
+void CScenePipeline::Start()
+{
+    if (m_bRunning || !m_simulation)
+        return;
+
+    m_bStop = false;
+    m_bRequested = false;
+    m_bReady = false;
+    m_bRunning = true;
+    m_thread = std::thread(&CScenePipeline::Run, this);
+}
+
+void CScenePipeline::Stop()
+{
+    if (!m_bRunning)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+    m_bRunning = false;
+
+    // a frame the worker had not begun is dropped, the front frame is still whole
+    if (m_bRequested && m_bReady) m_front = 1 - m_front;
+    m_bRequested = false;
+    m_bReady = false;
+}
+
+const SceneFrame &CScenePipeline::Acquire(const GLfloat &deltaTime, const GLboolean &onHeightMap)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (!m_bRunning) {
+        SceneFrame &frame = m_frames[m_front];
+        frame.index = ++m_frameIndex;
+        frame.deltaTime = deltaTime;
+        frame.onHeightMap = onHeightMap;
+        Simulate(frame);
+        m_waitTime = 0.0;
+        return frame;
+    }
+
+    // the worker is idle until a frame is asked for, so the first one can be made here
+    if (!m_bRequested && m_frames[m_front].index == 0) {
+        m_frames[m_front].index = ++m_frameIndex;
+        m_frames[m_front].deltaTime = deltaTime;
+        m_frames[m_front].onHeightMap = onHeightMap;
+        Simulate(m_frames[m_front]);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_bRequested) {
+            m_condition.wait(lock, [this] { return m_bReady; });
+            m_front = 1 - m_front;
+        }
+
+        SceneFrame &back = m_frames[1 - m_front];
+        back.index = ++m_frameIndex;
+        back.deltaTime = deltaTime;
+        back.onHeightMap = onHeightMap;
+        m_bRequested = true;
+        m_bReady = false;
+    }
+    m_condition.notify_all();
+
+    m_waitTime = ElapsedMilliseconds(start, std::chrono::steady_clock::now());
+    return m_frames[m_front];
+}
+
+void CScenePipeline::EndFrame()
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const GLint mode = m_bRunning ? 1 : 0;
+
+    // the frame the mode changed in belongs to neither
+    if (mode == m_lastMode) {
+        ScenePipelineStats &stats = m_stats[mode];
+        const SceneFrame &frame = m_frames[m_front];
+        AddSample(stats.frameTime, ElapsedMilliseconds(m_lastFrameEnd, now), stats.frames);
+        AddSample(stats.latency, ElapsedMilliseconds(frame.simulated, now), stats.frames);
+        AddSample(stats.simulationTime, frame.simulationTime, stats.frames);
+        AddSample(stats.waitTime, m_waitTime, stats.frames);
+        stats.frames++;
+    }
+
+    m_lastFrameEnd = now;
+    m_lastMode = mode;
+}
+
+void CScenePipeline::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this] { return m_bStop || (m_bRequested && !m_bReady); });
+        if (m_bStop)
+            break;
+
+        // the GL thread leaves the back frame alone until m_bReady is set
+        SceneFrame &frame = m_frames[1 - m_front];
+        lock.unlock();
+        Simulate(frame);
+        lock.lock();
+
+        m_bReady = true;
+        m_condition.notify_all();
+    }
+}
+
+void CScenePipeline::Simulate(SceneFrame &frame)
+{
+    frame.simulated = std::chrono::steady_clock::now();
+    m_simulation(frame);
+    frame.simulationTime = ElapsedMilliseconds(frame.simulated, std::chrono::steady_clock::now());
+}
@@ -0,0 +1,105 @@
+//
+//  ScenePipeline.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef ScenePipeline_h
+#define ScenePipeline_h
+
+#include "../SceneBase.h"
+#include "../objects/Metaballs.h"
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// what a simulation step leaves for the passes of a frame to draw
+struct SceneFrame {
+    // inputs, set on the GL thread when the frame is asked for
+    GLuint index;
+    GLfloat deltaTime;                      // ms
+    GLboolean onHeightMap;
+
+    // set by the simulation
+    std::vector<glm::mat4> worlds;          // of every scene object, on the ground
+    std::vector<glm::mat3> normals;
+    std::vector<GLfloat> groundHeights;
+    SBall balls[MAX_BALLS];
+    GLint numBalls;
+    GLuint transforms;                      // nodes recomputed
+
+    // set by the pipeline
+    std::chrono::steady_clock::time_point simulated;    // when the simulation of the frame started
+    GLdouble simulationTime;                // ms
+};
+
+// averages of the frames a mode rendered, in ms
+struct ScenePipelineStats {
+    GLdouble frameTime;         // from one EndFrame to the next, 1000 / frameTime is the frame rate
+    GLdouble latency;           // from the start of the simulation of a frame to the end of its rendering
+    GLdouble simulationTime;
+    GLdouble waitTime;          // the GL thread waited in Acquire for the simulation
+    GLuint frames;
+};
+
+// Runs the simulation of the scene into one of two frames. Serial, Acquire simulates the frame on the GL thread
+// before it is rendered. Pipelined, a worker simulates the next frame into the back frame while the GL thread
+// renders the front one, Acquire waits for the worker, swaps the two and asks for the next frame. The GL thread
+// never touches the back frame and the worker never touches the front one, the handoff is the only lock taken.
+// The simulation only reads what the GL thread leaves alone, it is given the inputs through the frame.
+class CScenePipeline
+{
+public:
+    typedef std::function<void(SceneFrame &)> Simulation;
+
+    CScenePipeline();
+    ~CScenePipeline();
+
+    // the simulation every frame is made with
+    void Create(const Simulation &simulation);
+
+    // starts the worker, Acquire simulates on the GL thread until then
+    void Start();
+    // waits for the frame being simulated, it becomes the front frame
+    void Stop();
+    GLboolean IsRunning() const { return m_bRunning; }
+
+    // GL thread, the frame to render. Pipelined it was simulated with the inputs of the previous call, so what
+    // is drawn is a frame behind the input
+    const SceneFrame &Acquire(const GLfloat &deltaTime, const GLboolean &onHeightMap);
+    // GL thread, after the last pass of the frame
+    void EndFrame();
+
+    const ScenePipelineStats &GetStats(const GLboolean &pipelined) const { return m_stats[pipelined ? 1 : 0]; }
+
+private:
+    CScenePipeline(const CScenePipeline &) = delete;
+    CScenePipeline &operator=(const CScenePipeline &) = delete;
+
+    void Run();
+    void Simulate(SceneFrame &frame);
+
+    Simulation m_simulation;
+    SceneFrame m_frames[2];
+    GLuint m_front;                     // the frame the passes read
+    GLuint m_frameIndex;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    GLboolean m_bRunning;
+    GLboolean m_bStop;
+    GLboolean m_bRequested;             // the back frame was asked for
+    GLboolean m_bReady;                 // and the worker has finished it
+
+    ScenePipelineStats m_stats[2];      // serial and pipelined
+    std::chrono::steady_clock::time_point m_lastFrameEnd;
+    GLint m_lastMode;                   // of the last EndFrame, -1 before the first one
+    GLdouble m_waitTime;                // of the current frame
+};
+
+#endif /* ScenePipeline_h */
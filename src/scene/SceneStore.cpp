@@ -0,0 +1,148 @@
+//
+//  SceneStore.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "SceneStore.h"
+#include "Material.h"
+
+CSceneStore::CSceneStore()
+{
+    m_currentLayer = "";
+}
+
+CSceneStore::~CSceneStore()
+{
+    Release();
+}
+
+GLuint CSceneStore::AddMesh(const std::string &name, IGameObject *pObject, CModel *pModel, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+{
+    m_meshes.push_back(SceneMesh{name, pObject, pModel, boundsMin, boundsMax});
+    return static_cast<GLuint>(m_meshes.size() - 1);
+}
+
+GLuint CSceneStore::AddMaterial(const std::string &name, CMaterial *pMaterial)
+{
+    m_materials.push_back(pMaterial);
+    m_materialNames.push_back(name);
+    return static_cast<GLuint>(m_materials.size() - 1);
+}
+
+GLint CSceneStore::FindMesh(const std::string &name) const
+{
+    for (GLuint i = 0; i < m_meshes.size(); ++i) {
+        if (m_meshes[i].name == name) return static_cast<GLint>(i);
+    }
+    return -1;
+}
+
+GLint CSceneStore::FindMaterial(const std::string &name) const
+{
+    for (GLuint i = 0; i < m_materialNames.size(); ++i) {
+        if (m_materialNames[i] == name) return static_cast<GLint>(i);
+    }
+    return -1;
+}
+
+bool CSceneStore::BeginLayer(const std::string &name)
+{
+    if (m_layers.find(name) != m_layers.end())
+        return false;
+
+    m_layers[name] = std::make_pair(GetObjectCount(), 0u);
+    m_currentLayer = name;
+    return true;
+}
+
+GLuint CSceneStore::AddObject(const glm::vec3 &position, const glm::vec3 &rotation, const glm::vec3 &scale,
+                              const GLuint &mesh, const GLuint &material, const GLint &program, const GLuint &flags)
+{
+    m_positions.push_back(position);
+    m_rotations.push_back(rotation);
+    m_scales.push_back(scale);
+    m_meshIds.push_back(mesh);
+    m_materialIds.push_back(material);
+    m_programs.push_back(program);
+    m_flags.push_back(flags);
+    m_boundsMin.push_back(position);
+    m_boundsMax.push_back(position);
+
+    auto it = m_layers.find(m_currentLayer);
+    if (it != m_layers.end()) it->second.second++;
+    return GetObjectCount() - 1;
+}
+
+bool CSceneStore::GetLayer(const std::string &name, GLuint &first, GLuint &count) const
+{
+    auto it = m_layers.find(name);
+    if (it == m_layers.end()) {
+        first = count = 0;
+        return false;
+    }
+    first = it->second.first;
+    count = it->second.second;
+    return true;
+}
+
+void CSceneStore::UpdateBounds()
+{
+    const GLuint spin = SceneFlagBit(SceneFlag::Spin);
+    for (GLuint i = 0; i < GetObjectCount(); ++i) {
+        const SceneMesh &mesh = m_meshes[m_meshIds[i]];
+        glm::vec3 centre = (mesh.boundsMin + mesh.boundsMax) * 0.5f;
+        glm::vec3 extent = (mesh.boundsMax - mesh.boundsMin) * 0.5f;
+
+        // spinning objects turn every frame, bound the sphere they sweep instead
+        if (m_flags[i] & spin) {
+            GLfloat radius = glm::length((glm::abs(centre) + extent) * m_scales[i]);
+            m_boundsMin[i] = m_positions[i] - glm::vec3(radius);
+            m_boundsMax[i] = m_positions[i] + glm::vec3(radius);
+            continue;
+        }
+
+        glm::mat4 rotation = glm::mat4(1.0f);
+        rotation = glm::rotate(rotation, glm::radians(m_rotations[i].x), glm::vec3(1.0f, 0.0f, 0.0f));
+        rotation = glm::rotate(rotation, glm::radians(m_rotations[i].y), glm::vec3(0.0f, 1.0f, 0.0f));
+        rotation = glm::rotate(rotation, glm::radians(m_rotations[i].z), glm::vec3(0.0f, 0.0f, 1.0f));
+        glm::mat3 linear = glm::mat3(rotation) * glm::mat3(glm::scale(glm::mat4(1.0f), m_scales[i]));
+
+        // the box of a transformed box reaches |M| times the extent from the transformed centre
+        glm::mat3 absolute;
+        for (GLuint c = 0; c < 3; ++c) absolute[c] = glm::abs(linear[c]);
+        glm::vec3 worldCentre = m_positions[i] + linear * centre;
+        glm::vec3 worldExtent = absolute * extent;
+        m_boundsMin[i] = worldCentre - worldExtent;
+        m_boundsMax[i] = worldCentre + worldExtent;
+    }
+}
+
+void CSceneStore::Clear()
+{
+    m_positions.clear();
+    m_rotations.clear();
+    m_scales.clear();
+    m_meshIds.clear();
+    m_materialIds.clear();
+    m_programs.clear();
+    m_flags.clear();
+    m_boundsMin.clear();
+    m_boundsMax.clear();
+    m_layers.clear();
+    m_currentLayer = "";
+}
+
+void CSceneStore::Release()
+{
+    Clear();
+    for (SceneMesh &mesh : m_meshes)
+        delete mesh.pObject;
+    m_meshes.clear();
+    for (CMaterial *pMaterial : m_materials)
+        delete pMaterial;
+    m_materials.clear();
+    m_materialNames.clear();
+}
@@ -0,0 +1,92 @@
+//
+//  SceneStore.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef SceneStore_h
+#define SceneStore_h
+
+#include "../SceneBase.h"
+
+class CModel;
+class CMaterial;
+
+struct SceneMesh {
+    std::string name;
+    IGameObject *pObject;
+    CModel *pModel;                     // set when the mesh is a model, models render through their own meshes
+    glm::vec3 boundsMin, boundsMax;     // object space
+};
+
+// The scene objects laid out as parallel arrays, object i is the i-th entry of every array. Meshes and
+// materials are shared tables the objects index into. Objects are grouped into named layers, each
+// layer is a contiguous range of the arrays so rendering a layer walks the arrays front to back.
+class CSceneStore
+{
+public:
+    CSceneStore();
+    ~CSceneStore();
+
+    // the store owns the meshes and materials it is given
+    GLuint AddMesh(const std::string &name, IGameObject *pObject, CModel *pModel, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax);
+    GLuint AddMaterial(const std::string &name, CMaterial *pMaterial);
+    GLint FindMesh(const std::string &name) const;
+    GLint FindMaterial(const std::string &name) const;
+
+    // objects added after BeginLayer belong to that layer, a layer can only be begun once
+    bool BeginLayer(const std::string &name);
+    // program is a shader program index, -1 for the program the layer is rendered with
+    GLuint AddObject(const glm::vec3 &position, const glm::vec3 &rotation, const glm::vec3 &scale,
+                     const GLuint &mesh, const GLuint &material, const GLint &program, const GLuint &flags);
+    bool GetLayer(const std::string &name, GLuint &first, GLuint &count) const;
+
+    // world space bounds of every object from its transform and the bounds of its mesh
+    void UpdateBounds();
+
+    GLuint GetObjectCount() const { return static_cast<GLuint>(m_positions.size()); }
+    const std::vector<glm::vec3> &GetPositions() const { return m_positions; }
+    const std::vector<glm::vec3> &GetRotations() const { return m_rotations; }
+    const std::vector<glm::vec3> &GetScales() const { return m_scales; }
+    const std::vector<GLuint> &GetMeshIds() const { return m_meshIds; }
+    const std::vector<GLuint> &GetMaterialIds() const { return m_materialIds; }
+    const std::vector<GLint> &GetPrograms() const { return m_programs; }
+    const std::vector<GLuint> &GetFlags() const { return m_flags; }
+    const std::vector<glm::vec3> &GetBoundsMin() const { return m_boundsMin; }
+    const std::vector<glm::vec3> &GetBoundsMax() const { return m_boundsMax; }
+
+    GLuint GetMeshCount() const { return static_cast<GLuint>(m_meshes.size()); }
+    GLuint GetMaterialCount() const { return static_cast<GLuint>(m_materials.size()); }
+    const SceneMesh &GetMesh(const GLuint &mesh) const { return m_meshes[mesh]; }
+    const CMaterial *GetMaterial(const GLuint &material) const { return m_materials[material]; }
+
+    // removes the objects and layers, meshes and materials stay loaded
+    void Clear();
+    void Release();
+
+private:
+    // transforms
+    std::vector<glm::vec3> m_positions;
+    std::vector<glm::vec3> m_rotations;     // euler angles in degrees, applied x then y then z
+    std::vector<glm::vec3> m_scales;
+    // what to draw and how
+    std::vector<GLuint> m_meshIds;
+    std::vector<GLuint> m_materialIds;
+    std::vector<GLint> m_programs;
+    std::vector<GLuint> m_flags;            // SceneFlagBit bitmask
+    // world space axis aligned bounds
+    std::vector<glm::vec3> m_boundsMin;
+    std::vector<glm::vec3> m_boundsMax;
+
+    std::vector<SceneMesh> m_meshes;
+    std::vector<CMaterial*> m_materials;
+    std::vector<std::string> m_materialNames;
+    std::map<std::string, std::pair<GLuint, GLuint>> m_layers; // first object and count
+    std::string m_currentLayer;
+};
+
+#endif /* SceneStore_h */
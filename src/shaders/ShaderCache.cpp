@@ -0,0 +1,189 @@
+//
+//  ShaderCache.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "ShaderCache.h"
+#include <sys/stat.h>
+
+#define SHADER_CACHE_MAGIC 0x53484243 // "SHBC"
+
+/*   https://www.khronos.org/opengl/wiki/Shader_Compilation#Binary_upload
+ glGetProgramBinary returns the linked program in a driver specific format. Loading it back with glProgramBinary
+ skips compiling and linking, but the driver may still reject it (for example after an update), in which case
+ the link status is false and the program has to be built from source again.
+ */
+
+CShaderCache &CShaderCache::Instance()
+{
+    static CShaderCache instance;
+    return instance;
+}
+
+CShaderCache::CShaderCache()
+{
+    m_driverHash = 0;
+    m_binarySupported = false;
+    m_parallelCompile = false;
+    m_hits = 0;
+    m_misses = 0;
+}
+
+void CShaderCache::Initialise(const std::string &directory)
+{
+    m_directory = directory;
+    mkdir(m_directory.c_str(), 0755);
+    
+    // a binary is only valid for the driver that produced it
+    std::string driver;
+    const GLubyte *strings[] = { glGetString(GL_VENDOR), glGetString(GL_RENDERER), glGetString(GL_VERSION) };
+    for (const GLubyte *str : strings) {
+        if (str != nullptr) driver += reinterpret_cast<const char *>(str);
+    }
+    m_driverHash = Hash(driver);
+    
+    GLint iFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &iFormats);
+    m_binarySupported = iFormats > 0;
+    
+    // KHR_parallel_shader_compile shares its enums with the ARB version
+    GLint iExtensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &iExtensions);
+    GLboolean bKHR = false;
+    for (GLint i = 0; i < iExtensions; ++i) {
+        const char *ext = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+        if (ext != nullptr && strcmp(ext, "GL_KHR_parallel_shader_compile") == 0) {
+            bKHR = true;
+            break;
+        }
+    }
+    
+    if (bKHR) {
+        typedef void (GLAPIENTRY * PFNGLMAXSHADERCOMPILERTHREADSKHRPROC) (GLuint count);
+        PFNGLMAXSHADERCOMPILERTHREADSKHRPROC maxThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+        if (maxThreads != nullptr) maxThreads(0xFFFFFFFF); // let the driver pick the thread count
+        m_parallelCompile = true;
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        m_parallelCompile = true;
+    }
+    
+    std::cout << "Shader cache: " << (m_binarySupported ? "program binaries" : "no program binary formats")
+    << ", " << (m_parallelCompile ? "parallel compile" : "serial compile") << std::endl;
+}
+
+GLboolean CShaderCache::IsBinarySupported() const
+{
+    return m_binarySupported;
+}
+
+GLboolean CShaderCache::IsParallelCompileSupported() const
+{
+    return m_parallelCompile;
+}
+
+GLboolean CShaderCache::LoadProgram(GLuint programID, const GLuint64 &sourceHash)
+{
+    if (!m_binarySupported) {
+        m_misses++;
+        return false;
+    }
+    
+    FILE *fp = fopen(GetFileName(sourceHash).c_str(), "rb");
+    if (!fp) {
+        m_misses++;
+        return false;
+    }
+    
+    GLuint uiMagic = 0;
+    GLuint64 uiKey = 0;
+    GLenum eFormat = 0;
+    GLint iLength = 0;
+    GLboolean bRead =
+    fread(&uiMagic, sizeof(uiMagic), 1, fp) == 1
+    && fread(&uiKey, sizeof(uiKey), 1, fp) == 1
+    && fread(&eFormat, sizeof(eFormat), 1, fp) == 1
+    && fread(&iLength, sizeof(iLength), 1, fp) == 1
+    && uiMagic == SHADER_CACHE_MAGIC
+    && uiKey == (sourceHash ^ m_driverHash)
+    && iLength > 0;
+    
+    std::vector<BYTE> binary;
+    if (bRead) {
+        binary.resize(iLength);
+        bRead = fread(binary.data(), 1, iLength, fp) == (size_t)iLength;
+    }
+    fclose(fp);
+    
+    if (bRead) {
+        glProgramBinary(programID, eFormat, binary.data(), iLength);
+        GLint iLinkStatus = GL_FALSE;
+        glGetProgramiv(programID, GL_LINK_STATUS, &iLinkStatus);
+        if (iLinkStatus == GL_TRUE) {
+            m_hits++;
+            return true;
+        }
+    }
+    
+    // stale or rejected, it gets rebuilt from source and saved again
+    m_misses++;
+    return false;
+}
+
+void CShaderCache::SaveProgram(GLuint programID, const GLuint64 &sourceHash)
+{
+    if (!m_binarySupported) return;
+    
+    GLint iLength = 0;
+    glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &iLength);
+    if (iLength <= 0) return;
+    
+    std::vector<BYTE> binary(iLength);
+    GLenum eFormat = 0;
+    glGetProgramBinary(programID, iLength, &iLength, &eFormat, binary.data());
+    
+    FILE *fp = fopen(GetFileName(sourceHash).c_str(), "wb");
+    if (!fp) {
+        printf("Shader cache could not be written to %s\n", m_directory.c_str());
+        return;
+    }
+    
+    GLuint uiMagic = SHADER_CACHE_MAGIC;
+    GLuint64 uiKey = sourceHash ^ m_driverHash;
+    fwrite(&uiMagic, sizeof(uiMagic), 1, fp);
+    fwrite(&uiKey, sizeof(uiKey), 1, fp);
+    fwrite(&eFormat, sizeof(eFormat), 1, fp);
+    fwrite(&iLength, sizeof(iLength), 1, fp);
+    fwrite(binary.data(), 1, iLength, fp);
+    fclose(fp);
+}
+
+GLuint CShaderCache::GetHits() const
+{
+    return m_hits;
+}
+
+GLuint CShaderCache::GetMisses() const
+{
+    return m_misses;
+}
+
+GLuint64 CShaderCache::Hash(const std::string &data, GLuint64 seed)
+{
+    GLuint64 hash = seed;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string CShaderCache::GetFileName(const GLuint64 &sourceHash) const
+{
+    char sName[32];
+    snprintf(sName, sizeof(sName), "%016llx.bin", (unsigned long long)(sourceHash ^ m_driverHash));
+    return m_directory + "/" + sName;
+}
@@ -0,0 +1,55 @@
+//
+//  ShaderCache.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef ShaderCache_h
+#define ShaderCache_h
+
+#include "../ShadersBase.h"
+#include <atomic>
+
+// Keeps linked program binaries on disk so later launches skip compiling and linking.
+// A binary is keyed by the hash of the program's preprocessed sources and the driver strings,
+// so editing a shader or updating the driver simply misses the cache.
+class CShaderCache
+{
+public:
+    static CShaderCache &Instance();
+    
+    // needs a current context, queries binary formats, driver strings and parallel compile support
+    void Initialise(const std::string &directory);
+    
+    GLboolean IsBinarySupported() const;
+    GLboolean IsParallelCompileSupported() const;
+    
+    // true when a cached binary was loaded into the program and it linked
+    GLboolean LoadProgram(GLuint programID, const GLuint64 &sourceHash);
+    void SaveProgram(GLuint programID, const GLuint64 &sourceHash);
+    
+    GLuint GetHits() const;
+    GLuint GetMisses() const;
+    
+    // 64 bit FNV-1a, pass the previous hash as seed to chain several sources
+    static GLuint64 Hash(const std::string &data, GLuint64 seed = 14695981039346656037ULL);
+    
+private:
+    CShaderCache();
+    CShaderCache(const CShaderCache &) = delete;
+    CShaderCache &operator=(const CShaderCache &) = delete;
+    
+    std::string GetFileName(const GLuint64 &sourceHash) const;
+    
+    std::string m_directory;
+    GLuint64 m_driverHash;
+    GLboolean m_binarySupported;
+    GLboolean m_parallelCompile;
+    std::atomic<GLuint> m_hits, m_misses; // programs are also loaded on the prewarm thread
+};
+
+#endif /* ShaderCache_h */
@@ -0,0 +1,197 @@
+//
+//  ShaderPreprocessor.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "ShaderPreprocessor.h"
+#include <sys/stat.h>
+
+#define MAX_INCLUDE_DEPTH 16
+
+CShaderPreprocessor &CShaderPreprocessor::Instance()
+{
+    static CShaderPreprocessor instance;
+    return instance;
+}
+
+CShaderPreprocessor::CShaderPreprocessor()
+{
+}
+
+GLboolean CShaderPreprocessor::ReadFile(const std::string &path, CachedFile &file)
+{
+    struct stat info;
+    std::ifstream stream(path);
+    if (!stream.is_open() || stat(path.c_str(), &info) != 0) {
+        printf("Shader file could not be opened: %s\n", path.c_str());
+        return false;
+    }
+    
+    file.lines.clear();
+    std::string sLine;
+    while (std::getline(stream, sLine)) {
+        if (!sLine.empty() && sLine.back() == '\r') sLine.pop_back();
+        file.lines.push_back(sLine);
+    }
+    file.modified = info.st_mtime;
+    file.size = info.st_size;
+    return true;
+}
+
+const CShaderPreprocessor::CachedFile *CShaderPreprocessor::GetFile(const std::string &path)
+{
+    auto it = m_files.find(path);
+    if (it != m_files.end())
+        return &it->second;
+    
+    CachedFile file;
+    if (!ReadFile(path, file))
+        return nullptr;
+    
+    file.index = (GLuint)m_fileNames.size();
+    m_fileNames.push_back(path);
+    return &m_files.insert({path, file}).first->second;
+}
+
+bool CShaderPreprocessor::Process(const std::string &file, const std::vector<std::string> &defines,
+                                  std::string &source, std::vector<ShaderSourceLine> &lineMap, std::vector<std::string> &dependencies)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    source.clear();
+    lineMap.clear();
+    dependencies.clear();
+    return Expand(file, false, 0, &defines, source, lineMap, dependencies);
+}
+
+GLboolean CShaderPreprocessor::Expand(const std::string &path, const GLboolean &includePart, const GLuint &depth,
+                                      const std::vector<std::string> *defines,
+                                      std::string &source, std::vector<ShaderSourceLine> &lineMap, std::vector<std::string> &dependencies)
+{
+    if (depth > MAX_INCLUDE_DEPTH) {
+        printf("Shader include depth exceeded in %s, is there an include cycle?\n", path.c_str());
+        return false;
+    }
+    
+    const CachedFile *pFile = GetFile(path);
+    if (pFile == nullptr)
+        return false;
+    
+    if (std::find(dependencies.begin(), dependencies.end(), path) == dependencies.end())
+        dependencies.push_back(path);
+    
+    std::string sDirectory = path.substr(0, path.find_last_of("\\/") + 1);
+    GLboolean bInIncludePart = false;
+    GLboolean bDefinesInjected = defines == nullptr || defines->empty();
+    
+    for (GLuint i = 0; i < pFile->lines.size(); ++i) {
+        const std::string &sLine = pFile->lines[i];
+        std::stringstream ss(sLine);
+        std::string sFirst;
+        ss >> sFirst;
+        
+        if (sFirst == "#include") {
+            std::string sFileName;
+            ss >> sFileName;
+            if (sFileName.size() > 1 && sFileName.front() == '\"' && sFileName.back() == '\"') {
+                sFileName = sFileName.substr(1, sFileName.size() - 2);
+                if (!Expand(sDirectory + sFileName, true, depth + 1, nullptr, source, lineMap, dependencies))
+                    return false;
+            }
+            continue;
+        }
+        if (sFirst == "#include_part") {
+            bInIncludePart = true;
+            continue;
+        }
+        if (sFirst == "#definition_part") {
+            bInIncludePart = false;
+            continue;
+        }
+        if (includePart && !bInIncludePart)
+            continue;
+        
+        source += sLine;
+        source += '\n';
+        lineMap.push_back(ShaderSourceLine{pFile->index, i + 1});
+        
+        // variant defines go right after #version, which has to stay the first statement
+        if (!bDefinesInjected && sFirst == "#version") {
+            for (const std::string &define : *defines) {
+                source += "#define " + define + "\n";
+                lineMap.push_back(ShaderSourceLine{pFile->index, 0});
+            }
+            bDefinesInjected = true;
+        }
+    }
+    
+    if (!bDefinesInjected) {
+        std::string sDefines;
+        std::vector<ShaderSourceLine> definesMap;
+        for (const std::string &define : *defines) {
+            sDefines += "#define " + define + "\n";
+            definesMap.push_back(ShaderSourceLine{pFile->index, 0});
+        }
+        source.insert(0, sDefines);
+        lineMap.insert(lineMap.begin(), definesMap.begin(), definesMap.end());
+    }
+    
+    return true;
+}
+
+std::string CShaderPreprocessor::MapLog(const std::string &log, const std::vector<ShaderSourceLine> &lineMap) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string sResult;
+    sResult.reserve(log.size());
+    
+    for (size_t i = 0; i < log.size(); ++i) {
+        // a single source string is always number 0, followed by ':' or '(' and the line
+        GLboolean bStart = log[i] == '0' && i + 2 < log.size() && (log[i+1] == ':' || log[i+1] == '(')
+        && isdigit((unsigned char)log[i+2]) && (i == 0 || !isdigit((unsigned char)log[i-1]));
+        if (!bStart) {
+            sResult += log[i];
+            continue;
+        }
+        
+        size_t j = i + 2;
+        GLuint line = 0;
+        while (j < log.size() && isdigit((unsigned char)log[j])) {
+            line = line * 10 + (log[j] - '0');
+            j++;
+        }
+        if (line == 0 || line > lineMap.size()) {
+            sResult += log[i];
+            continue;
+        }
+        
+        const ShaderSourceLine &sourceLine = lineMap[line - 1];
+        std::string sFile = m_fileNames[sourceLine.file];
+        sFile = sFile.substr(sFile.find_last_of("\\/") + 1);
+        sResult += sourceLine.line == 0 ? sFile + ":define" : sFile + ":" + std::to_string(sourceLine.line);
+        if (log[i+1] == '(' && j < log.size() && log[j] == ')') j++;
+        i = j - 1;
+    }
+    return sResult;
+}
+
+std::vector<std::string> CShaderPreprocessor::PollChanges()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> changed;
+    for (auto &entry : m_files) {
+        struct stat info;
+        if (stat(entry.first.c_str(), &info) != 0) continue;
+        if (info.st_mtime == entry.second.modified && info.st_size == entry.second.size) continue;
+        
+        // editors often write in several steps, keep the old lines if the file is unreadable right now
+        CachedFile file = entry.second;
+        if (ReadFile(entry.first, file)) {
+            entry.second = file;
+            changed.push_back(entry.first);
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,65 @@
+//
+//  ShaderPreprocessor.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef ShaderPreprocessor_h
+#define ShaderPreprocessor_h
+
+#include "../ShadersBase.h"
+#include <unordered_map>
+#include <mutex>
+
+// where a line of preprocessed source came from, used to translate compiler errors
+struct ShaderSourceLine {
+    GLuint file;    // index into the preprocessor's file names
+    GLuint line;    // 1 based line in that file, 0 for injected defines
+};
+
+// Resolves #include (and #include_part/#definition_part) in memory, injects #defines after #version
+// and remembers every file it read, so edited files can be detected and their shaders rebuilt.
+// Files are parsed once and shared by every shader that includes them. Safe to use from the prewarm thread.
+class CShaderPreprocessor
+{
+public:
+    static CShaderPreprocessor &Instance();
+    
+    // defines are "NAME" or "NAME VALUE", dependencies receive every file the source was built from
+    bool Process(const std::string &file, const std::vector<std::string> &defines,
+                 std::string &source, std::vector<ShaderSourceLine> &lineMap, std::vector<std::string> &dependencies);
+    
+    // rewrites the "0:LINE" and "0(LINE)" references of a compiler log to file:line
+    std::string MapLog(const std::string &log, const std::vector<ShaderSourceLine> &lineMap) const;
+    
+    // re-reads cached files whose size or modification time changed and returns their paths
+    std::vector<std::string> PollChanges();
+    
+private:
+    CShaderPreprocessor();
+    CShaderPreprocessor(const CShaderPreprocessor &) = delete;
+    CShaderPreprocessor &operator=(const CShaderPreprocessor &) = delete;
+    
+    struct CachedFile {
+        std::vector<std::string> lines;
+        time_t modified;
+        off_t size;
+        GLuint index;
+    };
+    
+    const CachedFile *GetFile(const std::string &path);
+    GLboolean ReadFile(const std::string &path, CachedFile &file);
+    GLboolean Expand(const std::string &path, const GLboolean &includePart, const GLuint &depth,
+                     const std::vector<std::string> *defines,
+                     std::string &source, std::vector<ShaderSourceLine> &lineMap, std::vector<std::string> &dependencies);
+    
+    std::unordered_map<std::string, CachedFile> m_files;
+    std::vector<std::string> m_fileNames;
+    mutable std::mutex m_mutex;
+};
+
+#endif /* ShaderPreprocessor_h */
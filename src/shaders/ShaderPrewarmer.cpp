@@ -0,0 +1,159 @@
+//
+//  ShaderPrewarmer.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "ShaderPrewarmer.h"
+#include "ShaderProgram.h"
+
+CShaderPrewarmer &CShaderPrewarmer::Instance()
+{
+    static CShaderPrewarmer instance;
+    return instance;
+}
+
+CShaderPrewarmer::CShaderPrewarmer()
+{
+    m_pWindow = nullptr;
+    m_bRunning = false;
+    m_bStop = false;
+}
+
+void CShaderPrewarmer::Start(GLFWwindow *pSharedWindow)
+{
+    if (m_bRunning || pSharedWindow == nullptr)
+        return;
+
+    m_pWindow = pSharedWindow;
+    m_bStop = false;
+    m_bRunning = true;
+    m_thread = std::thread(&CShaderPrewarmer::Run, this);
+}
+
+void CShaderPrewarmer::Stop()
+{
+    if (!m_bRunning)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+    m_bRunning = false;
+
+    // programs finished after the last Update were never adopted, nothing uses them
+    for (Result &result : m_results)
+        delete result.pBuilt;
+    m_results.clear();
+    m_jobs.clear();
+    m_pending.clear();
+
+    glfwDestroyWindow(m_pWindow);
+    m_pWindow = nullptr;
+}
+
+GLboolean CShaderPrewarmer::IsRunning() const
+{
+    return m_bRunning;
+}
+
+void CShaderPrewarmer::Request(CShaderProgram *pProgram, const GLboolean &urgent)
+{
+    if (pProgram->IsLinked() || pProgram->IsEmpty() || (!m_bRunning && !urgent))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::find(m_failed.begin(), m_failed.end(), pProgram) != m_failed.end())
+        return;
+
+    if (std::find(m_pending.begin(), m_pending.end(), pProgram) != m_pending.end()) {
+        if (!urgent) return;
+
+        // already queued for the background pass, move it to the front unless it is being built
+        auto it = std::find_if(m_jobs.begin(), m_jobs.end(), [pProgram](const Job &job) { return job.pProgram == pProgram; });
+        if (it != m_jobs.end()) {
+            Job job = *it;
+            m_jobs.erase(it);
+            m_jobs.push_front(job);
+        }
+        return;
+    }
+
+    Job job = {pProgram, CShaderProgram::GetFeatures() & pProgram->GetFeatureMask()};
+    m_pending.push_back(pProgram);
+    if (urgent) m_jobs.push_front(job);
+    else m_jobs.push_back(job);
+    m_condition.notify_one();
+}
+
+GLuint CShaderPrewarmer::Update()
+{
+    std::vector<Result> results;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        results.swap(m_results);
+    }
+
+    // no worker, the most urgent program is built here
+    if (!m_bRunning && !m_jobs.empty()) {
+        Job job = m_jobs.front();
+        m_jobs.pop_front();
+        results.push_back(Result{job, Build(job)});
+    }
+
+    for (Result &result : results) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), result.job.pProgram), m_pending.end());
+        if (result.pBuilt == nullptr) {
+            m_failed.push_back(result.job.pProgram);
+            continue;
+        }
+        result.job.pProgram->Adopt(*result.pBuilt, result.job.variant);
+        delete result.pBuilt;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<GLuint>(m_pending.size());
+}
+
+void CShaderPrewarmer::Run()
+{
+    glfwMakeContextCurrent(m_pWindow);
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_bStop || !m_jobs.empty(); });
+            if (m_bStop) break;
+            job = m_jobs.front();
+            m_jobs.pop_front();
+        }
+
+        CShaderProgram *pBuilt = Build(job);
+
+        // the main context may only use the program once this context is done with it
+        glFinish();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results.push_back(Result{job, pBuilt});
+    }
+
+    glfwMakeContextCurrent(nullptr);
+}
+
+CShaderProgram *CShaderPrewarmer::Build(const Job &job)
+{
+    CShaderProgram *pBuilt = new CShaderProgram;
+    if (job.pProgram->Build(job.variant, *pBuilt))
+        return pBuilt;
+
+    printf("Shader program could not be prewarmed, its effect keeps the fallback\n");
+    delete pBuilt;
+    return nullptr;
+}
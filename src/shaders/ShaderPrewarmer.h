@@ -0,0 +1,71 @@
+//
+//  ShaderPrewarmer.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef ShaderPrewarmer_h
+#define ShaderPrewarmer_h
+
+#include "../ShadersBase.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+class CShaderProgram;
+
+// Builds deferred shader programs on a worker thread that owns a hidden context sharing objects
+// with the main one. Finished programs are handed over on the main thread in Update, so a program
+// is never touched by both threads. Without a shared context requested programs are built in
+// Update instead, one per frame, and the background pass is skipped.
+class CShaderPrewarmer
+{
+public:
+    static CShaderPrewarmer &Instance();
+
+    // takes ownership of the hidden window, nullptr keeps everything on the main thread
+    void Start(GLFWwindow *pSharedWindow);
+    void Stop();
+    GLboolean IsRunning() const;
+
+    // urgent programs are needed on screen and go before the background pass
+    void Request(CShaderProgram *pProgram, const GLboolean &urgent);
+
+    // main thread, adopts finished programs and returns how many are still queued
+    GLuint Update();
+
+private:
+    CShaderPrewarmer();
+    CShaderPrewarmer(const CShaderPrewarmer &) = delete;
+    CShaderPrewarmer &operator=(const CShaderPrewarmer &) = delete;
+
+    struct Job {
+        CShaderProgram *pProgram;
+        GLuint variant;
+    };
+    struct Result {
+        Job job;
+        CShaderProgram *pBuilt; // nullptr when the build failed
+    };
+
+    void Run();
+    CShaderProgram *Build(const Job &job);
+
+    GLFWwindow *m_pWindow;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Job> m_jobs;
+    std::vector<Result> m_results;
+    std::vector<CShaderProgram *> m_pending; // queued or building, so nothing is built twice
+    std::vector<CShaderProgram *> m_failed;  // not requested again, the errors were printed once
+    GLboolean m_bRunning;
+    GLboolean m_bStop;
+};
+
+#endif /* ShaderPrewarmer_h */
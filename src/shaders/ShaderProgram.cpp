@@ -7,12 +7,27 @@
 //
 
 #include "ShaderProgram.h"
+#include "ShaderCache.h"
+#include "../window/GLState.h"
+#include "../utilities/UniformBlockType.h"
+#include "../utilities/ShaderFeature.h"
 
 CShaderProgram::CShaderProgram()
 {
+    m_uiProgram = 0;
     m_bLinked = false;
+    m_bLinkPending = false;
+    m_uiSourceHash = CShaderCache::Hash("");
+    m_uiVariant = 0;
+    m_uiFeatureMask = 0;
 }
 
+GLuint CShaderProgram::s_uiFeatures = 0;
+GLuint CShaderProgram::s_uiUploadedBytes = 0;
+GLuint CShaderProgram::s_uiSkippedUploads = 0;
+GLuint CShaderProgram::s_uiFrameUploadedBytes = 0;
+GLuint CShaderProgram::s_uiFrameSkippedUploads = 0;
+
 CShaderProgram::~CShaderProgram()
 {
     Release();
@@ -24,13 +39,22 @@ void CShaderProgram::CreateProgram()
     m_uiProgram = glCreateProgram();
 }
 
-// Adds a compiled shader to a program
+// Adds a loaded shader to a program, it is only compiled if the program is not in the binary cache
 bool CShaderProgram::AddShaderToProgram(CShader* shShader)
 {
     if(!shShader->IsLoaded())
         return false;
     
-    glAttachShader(m_uiProgram, shShader->GetShaderID());
+    m_shaders.push_back(shShader);
+    for (GLuint i = 0; i < static_cast<GLuint>(ShaderFeature::NumberOfFeatures); ++i) {
+        ShaderFeature feature = static_cast<ShaderFeature>(i);
+        if (shShader->References(ShaderFeatureToDefine(feature))) m_uiFeatureMask |= ShaderFeatureBit(feature);
+    }
+    m_shaderFiles.push_back(ShaderFile{shShader->GetFileName(), shShader->GetType(), shShader->GetDefines()});
+    for (const std::string &dependency : shShader->GetDependencies()) {
+        if (!DependsOn(dependency)) m_dependencies.push_back(dependency);
+    }
+    m_uiSourceHash = CShaderCache::Hash(std::to_string(shShader->GetSourceHash()), m_uiSourceHash);
     
     return true;
 }
@@ -38,38 +62,361 @@ bool CShaderProgram::AddShaderToProgram(CShader* shShader)
 // Performs final linkage of the OpenGL shader program
 bool CShaderProgram::LinkProgram()
 {
+    CShaderCache &cache = CShaderCache::Instance();
+    if (cache.LoadProgram(m_uiProgram, m_uiSourceHash)) {
+        m_shaders.clear();
+        OnLinked();
+        return true;
+    }
+    
+    for (CShader *shShader : m_shaders) {
+        shShader->Compile();
+        glAttachShader(m_uiProgram, shShader->GetShaderID());
+    }
+    
+    if (cache.IsBinarySupported())
+        glProgramParameteri(m_uiProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(m_uiProgram);
+    m_bLinkPending = true;
+    
+    // without parallel compilation the first status query blocks anyway
+    if (!cache.IsParallelCompileSupported())
+        return FinishLink();
+    
+    return true;
+}
+
+// Keeps only the shader files, the program is compiled later through Build and Adopt
+void CShaderProgram::DeferLink()
+{
+    m_shaders.clear();
+}
+
+// Returns true while the driver is still compiling and linking in the background
+bool CShaderProgram::IsLinkPending() const
+{
+    return m_bLinkPending;
+}
+
+// Polls the link without blocking when parallel compilation is available
+bool CShaderProgram::IsLinkComplete() const
+{
+    if (!m_bLinkPending || !CShaderCache::Instance().IsParallelCompileSupported())
+        return true;
+    
+    GLint iCompleted = GL_FALSE;
+    glGetProgramiv(m_uiProgram, GL_COMPLETION_STATUS_ARB, &iCompleted);
+    return iCompleted == GL_TRUE;
+}
+
+// Checks the link result, reports errors and stores the binary in the cache
+bool CShaderProgram::FinishLink()
+{
+    if (!m_bLinkPending)
+        return m_bLinked;
+    m_bLinkPending = false;
+    
     int iLinkStatus;
     glGetProgramiv(m_uiProgram, GL_LINK_STATUS, &iLinkStatus);
     
-    if (iLinkStatus == false)
+    for (CShader *shShader : m_shaders) {
+        if (iLinkStatus == GL_FALSE) shShader->CheckCompileStatus();
+        glDetachShader(m_uiProgram, shShader->GetShaderID());
+    }
+    m_shaders.clear();
+    
+    if (iLinkStatus == GL_FALSE)
     {
         char sInfoLog[1024];
-        char sFinalMessage[1536];
         int iLogLength;
         glGetProgramInfoLog(m_uiProgram, 1024, &iLogLength, sInfoLog);
-        printf(sFinalMessage, "Error! Shader program wasn't linked! The linker returned:\n\n%s", sInfoLog);
+        printf("Error! Shader program wasn't linked! The linker returned:\n\n%s\n", sInfoLog);
         return false;
     }
     
-    m_bLinked = iLinkStatus == GL_TRUE;
+    CShaderCache::Instance().SaveProgram(m_uiProgram, m_uiSourceHash);
+    OnLinked();
+    return true;
+}
+
+// Returns true if the program was built from the file, directly or through an include
+bool CShaderProgram::DependsOn(const std::string &file) const
+{
+    return std::find(m_dependencies.begin(), m_dependencies.end(), file) != m_dependencies.end();
+}
+
+// Rebuilds the program from its shader files into the same object, uniforms must be set again
+bool CShaderProgram::Reload()
+{
+    // a deferred program has not been built yet, it picks up the edit when it is
+    if (!m_bLinked)
+        return false;
+    
+    CShaderProgram rebuilt;
+    if (!Build(m_uiVariant, rebuilt)) {
+        printf("Shader program %d was not reloaded, keeping the previous version\n", m_uiProgram);
+        return false;
+    }
+    Adopt(rebuilt, m_uiVariant);
+    return true;
+}
+
+// Takes over a program made by Build, other variants are rebuilt on use
+void CShaderProgram::Adopt(CShaderProgram &built, const GLuint &variant)
+{
+    DeleteProgram();
+    m_uiProgram = built.m_uiProgram;
+    m_bLinked = true;
+    m_uiVariant = variant;
+    m_uniformSlots.swap(built.m_uniformSlots);
+    m_uniformValues.swap(built.m_uniformValues);
+    m_dependencies.swap(built.m_dependencies);
+    built.m_bLinked = false;
+}
+
+bool CShaderProgram::IsLinked() const
+{
     return m_bLinked;
 }
 
+bool CShaderProgram::IsEmpty() const
+{
+    return m_shaderFiles.empty();
+}
+
+// Compiles and links the program's files with the defines of the variant into another program object.
+// Only reads this program, so it can run on the prewarm thread while this one is in use.
+bool CShaderProgram::Build(const GLuint &variant, CShaderProgram &rebuilt)
+{
+    std::vector<CShader> shaders(m_shaderFiles.size());
+    rebuilt.CreateProgram();
+    
+    bool bLoaded = true;
+    for (GLuint i = 0; i < m_shaderFiles.size() && bLoaded; ++i) {
+        std::vector<std::string> defines = m_shaderFiles[i].defines;
+        for (GLuint j = 0; j < static_cast<GLuint>(ShaderFeature::NumberOfFeatures); ++j) {
+            ShaderFeature feature = static_cast<ShaderFeature>(j);
+            if (variant & ShaderFeatureBit(feature)) defines.push_back(ShaderFeatureToDefine(feature));
+        }
+        bLoaded = shaders[i].LoadShader(m_shaderFiles[i].file, m_shaderFiles[i].type, defines)
+        && rebuilt.AddShaderToProgram(&shaders[i]);
+    }
+    if (bLoaded && rebuilt.LinkProgram()) rebuilt.FinishLink();
+    
+    for (GLuint i = 0; i < shaders.size(); ++i)
+        shaders[i].DeleteShader();
+    
+    // never bound, so the state cache does not need to know
+    if (!rebuilt.m_bLinked) {
+        glDeleteProgram(rebuilt.m_uiProgram);
+        return false;
+    }
+    return true;
+}
+
+void CShaderProgram::SetFeatures(const GLuint &features)
+{
+    s_uiFeatures = features;
+}
+
+GLuint CShaderProgram::GetFeatures()
+{
+    return s_uiFeatures;
+}
+
+// Feature bits the program's shaders test for
+GLuint CShaderProgram::GetFeatureMask() const
+{
+    return m_uiFeatureMask;
+}
+
+// Swaps in the variant for the current feature set, building it on first use
+void CShaderProgram::SelectVariant()
+{
+    GLuint uiVariant = s_uiFeatures & m_uiFeatureMask;
+    if (!m_bLinked || uiVariant == m_uiVariant)
+        return;
+    
+    auto it = m_variants.find(uiVariant);
+    if (it == m_variants.end()) {
+        Variant variant = {0, {}};
+        CShaderProgram rebuilt;
+        if (Build(uiVariant, rebuilt)) {
+            variant.program = rebuilt.m_uiProgram;
+            variant.slots.swap(rebuilt.m_uniformSlots);
+            variant.values.swap(rebuilt.m_uniformValues);
+            rebuilt.m_bLinked = false;
+        } else {
+            printf("Shader program %d variant %x failed to build, keeping variant %x\n", m_uiProgram, uiVariant, m_uiVariant);
+        }
+        it = m_variants.insert({uiVariant, variant}).first;
+    }
+    if (it->second.program == 0)
+        return;
+    
+    // park the current variant and take the requested one
+    Variant current = {m_uiProgram, std::move(m_uniformSlots), std::move(m_uniformValues)};
+    m_uiProgram = it->second.program;
+    m_uniformSlots = std::move(it->second.slots);
+    m_uniformValues = std::move(it->second.values);
+    m_variants.erase(it);
+    m_variants[m_uiVariant] = std::move(current);
+    m_uiVariant = uiVariant;
+}
+
+void CShaderProgram::OnLinked()
+{
+    m_bLinked = true;
+    CacheUniformLocations();
+    
+    // attach the shared per frame blocks, blocks the program does not declare are skipped
+    for (GLuint i = 0; i < static_cast<GLuint>(UniformBlockType::NumberOfUniformBlocks); ++i) {
+        UniformBlockType type = static_cast<UniformBlockType>(i);
+        SetUniformBlock(UniformBlockTypeToString(type), i);
+    }
+}
+
+// Reflects all active uniforms once, so setting a uniform never has to ask the driver for a location by name
+void CShaderProgram::CacheUniformLocations()
+{
+    GLint iUniforms = 0, iMaxLength = 0;
+    glGetProgramiv(m_uiProgram, GL_ACTIVE_UNIFORMS, &iUniforms);
+    glGetProgramiv(m_uiProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &iMaxLength);
+    
+    m_uniformValues.clear();
+    
+    std::vector<std::pair<std::string, GLint>> entries;
+    std::vector<GLchar> sName(std::max(iMaxLength, 1));
+    for (GLint i = 0; i < iUniforms; ++i) {
+        GLsizei iLength = 0;
+        GLint iSize = 0;
+        GLenum eType;
+        glGetActiveUniform(m_uiProgram, i, (GLsizei)sName.size(), &iLength, &iSize, &eType, &sName[0]);
+        
+        std::string uniformName(&sName[0], iLength);
+        GLint iLoc = glGetUniformLocation(m_uiProgram, uniformName.c_str());
+        if (iLoc < 0) continue; // uniform block members have no location
+        if (iLoc + iSize > (GLint)m_uniformValues.size()) m_uniformValues.resize(iLoc + iSize);
+        
+        // arrays are reported as "name[0]", cache the plain name and every element
+        if (iSize > 1 || uniformName.back() == ']') {
+            std::string baseName = uniformName.substr(0, uniformName.rfind('['));
+            entries.push_back(std::make_pair(baseName, iLoc));
+            for (GLint j = 0; j < iSize; ++j) {
+                std::string elementName = baseName + "[" + std::to_string(j) + "]";
+                entries.push_back(std::make_pair(elementName, glGetUniformLocation(m_uiProgram, elementName.c_str())));
+            }
+        } else {
+            entries.push_back(std::make_pair(uniformName, iLoc));
+        }
+    }
+    
+    // keep the table at most half full, counting the element names of the arrays
+    GLuint uiSlots = 16;
+    while (uiSlots < (GLuint)entries.size() * 2) uiSlots *= 2;
+    m_uniformSlots.assign(uiSlots, UniformSlot{0, -1, false, std::string()});
+    for (const std::pair<std::string, GLint> &entry : entries)
+        AddUniformLocation(entry.first, entry.second);
+}
+
+void CShaderProgram::AddUniformLocation(const std::string &name, const GLint &location)
+{
+    GLuint uiHash = CUniformName(name).GetHash();
+    GLuint uiMask = (GLuint)m_uniformSlots.size() - 1;
+    for (GLuint i = uiHash & uiMask, uiProbes = 0; uiProbes <= uiMask; i = (i + 1) & uiMask, ++uiProbes) {
+        UniformSlot &slot = m_uniformSlots[i];
+        if (!slot.used) {
+            slot = UniformSlot{uiHash, location, true, name};
+            return;
+        }
+        if (slot.hash == uiHash && slot.name == name)
+            return;
+    }
+    printf("Error! No room left for uniform %s in program %d\n", name.c_str(), m_uiProgram);
+}
+
+// Returns the cached location of a uniform
+GLint CShaderProgram::GetUniformLocation(const CUniformName &name) const
+{
+    if (m_uniformSlots.empty())
+        return -1;
+    
+    GLuint uiHash = name.GetHash();
+    GLuint uiMask = (GLuint)m_uniformSlots.size() - 1;
+    for (GLuint i = uiHash & uiMask, uiProbes = 0; uiProbes <= uiMask; i = (i + 1) & uiMask, ++uiProbes) {
+        const UniformSlot &slot = m_uniformSlots[i];
+        if (!slot.used) return -1;
+        if (slot.hash == uiHash && name.Matches(slot.name)) return slot.location;
+    }
+    return -1;
+}
+
+// Only single values are remembered. Arrays are always sent and forget the elements they cover, so a
+// later per element call is not mistaken for a repeat. Values set while another program is in use go
+// to that program, they are sent without being remembered.
+bool CShaderProgram::UpdateUniformValue(const GLint &location, const void *pData, const GLuint &uiSize, const GLint &iCount)
+{
+    if (location < 0)
+        return false;
+    
+    if (iCount != 1 || location >= (GLint)m_uniformValues.size() || !CGLState::Instance().IsProgramInUse(m_uiProgram)) {
+        for (GLint i = location; i < location + iCount && i < (GLint)m_uniformValues.size(); ++i)
+            m_uniformValues[i].clear();
+        s_uiUploadedBytes += uiSize * iCount;
+        return true;
+    }
+    
+    std::vector<GLubyte> &value = m_uniformValues[location];
+    if (value.size() == uiSize && memcmp(value.data(), pData, uiSize) == 0) {
+        s_uiSkippedUploads++;
+        return false;
+    }
+    
+    const GLubyte *pBytes = static_cast<const GLubyte *>(pData);
+    value.assign(pBytes, pBytes + uiSize);
+    s_uiUploadedBytes += uiSize;
+    return true;
+}
+
+void CShaderProgram::BeginFrame()
+{
+    s_uiFrameUploadedBytes = s_uiUploadedBytes;
+    s_uiFrameSkippedUploads = s_uiSkippedUploads;
+    s_uiUploadedBytes = 0;
+    s_uiSkippedUploads = 0;
+}
+
+GLuint CShaderProgram::GetUploadedBytes()
+{
+    return s_uiFrameUploadedBytes;
+}
+
+GLuint CShaderProgram::GetSkippedUploads()
+{
+    return s_uiFrameSkippedUploads;
+}
+
 // Deletes the program and frees memory on the GPU
 void CShaderProgram::DeleteProgram()
 {
     if(!m_bLinked)
         return;
     m_bLinked = false;
-    glDeleteProgram(m_uiProgram);
+    m_uniformSlots.clear();
+    m_uniformValues.clear();
+    CGLState::Instance().DeleteProgram(m_uiProgram);
+    for (auto &variant : m_variants) {
+        if (variant.second.program != 0) CGLState::Instance().DeleteProgram(variant.second.program);
+    }
+    m_variants.clear();
 }
 
 // Instructs OpenGL to use this program
 void CShaderProgram::UseProgram()
 {
+    SelectVariant();
     if(m_bLinked)
-        glUseProgram(m_uiProgram);
+        CGLState::Instance().UseProgram(m_uiProgram);
 }
 
 // Returns the OpenGL program ID
@@ -86,103 +433,118 @@ void CShaderProgram::SetUniformBlock(std::string uniformName, const GLint &bindi
 {
     //    unsigned int iLoc = glGetUniformBlockIndex(GetProgramID(), uniformName.c_str());
     //    glUniformBlockBinding(GetProgramID(), iLoc, bindingPoint);
-    int iLoc = glGetUniformBlockIndex(m_uiProgram, uniformName.c_str());
+    GLuint iLoc = glGetUniformBlockIndex(m_uiProgram, uniformName.c_str());
+    if (iLoc == GL_INVALID_INDEX) return;
     glUniformBlockBinding(m_uiProgram, iLoc, bindingPoint);
 }
 
 
 // Setting floats
 
-void CShaderProgram::SetUniform(std::string sName, GLfloat * fValues, const GLint & iCount)
+void CShaderProgram::SetUniform(const CUniformName &name, GLfloat * fValues, const GLint & iCount)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform1fv(iLoc, iCount, fValues);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, fValues, sizeof(GLfloat), iCount))
+        glUniform1fv(iLoc, iCount, fValues);
 }
 
-void CShaderProgram::SetUniform(std::string sName, const GLfloat &fValue)
+void CShaderProgram::SetUniform(const CUniformName &name, const GLfloat &fValue)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform1fv(iLoc, 1, &fValue);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, &fValue, sizeof(GLfloat), 1))
+        glUniform1fv(iLoc, 1, &fValue);
 }
 
 // Setting vectors
 
-void CShaderProgram::SetUniform(std::string sName, glm::vec2* vVectors, const GLint & iCount)
+void CShaderProgram::SetUniform(const CUniformName &name, glm::vec2* vVectors, const GLint & iCount)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform2fv(iLoc, iCount, (GLfloat*)vVectors);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, vVectors, sizeof(glm::vec2), iCount))
+        glUniform2fv(iLoc, iCount, (GLfloat*)vVectors);
 }
 
-void CShaderProgram::SetUniform(std::string sName, const glm::vec2 vVector)
+void CShaderProgram::SetUniform(const CUniformName &name, const glm::vec2 vVector)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform2fv(iLoc, 1, (GLfloat*)&vVector);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, &vVector, sizeof(glm::vec2), 1))
+        glUniform2fv(iLoc, 1, (GLfloat*)&vVector);
 }
 
-void CShaderProgram::SetUniform(std::string sName, glm::vec3* vVectors, const GLint & iCount)
+void CShaderProgram::SetUniform(const CUniformName &name, glm::vec3* vVectors, const GLint & iCount)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform3fv(iLoc, iCount, (GLfloat*)vVectors);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, vVectors, sizeof(glm::vec3), iCount))
+        glUniform3fv(iLoc, iCount, (GLfloat*)vVectors);
 }
 
-void CShaderProgram::SetUniform(std::string sName, const glm::vec3 vVector)
+void CShaderProgram::SetUniform(const CUniformName &name, const glm::vec3 vVector)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform3fv(iLoc, 1, (GLfloat*)&vVector);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, &vVector, sizeof(glm::vec3), 1))
+        glUniform3fv(iLoc, 1, (GLfloat*)&vVector);
 }
 
-void CShaderProgram::SetUniform(std::string sName, glm::vec4* vVectors, const GLint & iCount)
+void CShaderProgram::SetUniform(const CUniformName &name, glm::vec4* vVectors, const GLint & iCount)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform4fv(iLoc, iCount, (GLfloat*)vVectors);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, vVectors, sizeof(glm::vec4), iCount))
+        glUniform4fv(iLoc, iCount, (GLfloat*)vVectors);
 }
 
-void CShaderProgram::SetUniform(std::string sName, const glm::vec4 vVector)
+void CShaderProgram::SetUniform(const CUniformName &name, const glm::vec4 vVector)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform4fv(iLoc, 1, (GLfloat*)&vVector);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, &vVector, sizeof(glm::vec4), 1))
+        glUniform4fv(iLoc, 1, (GLfloat*)&vVector);
 }
 
 // Setting 3x3 matrices
 
-void CShaderProgram::SetUniform(std::string sName, glm::mat3* mMatrices, const GLint & iCount)
+void CShaderProgram::SetUniform(const CUniformName &name, glm::mat3* mMatrices, const GLint & iCount)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniformMatrix3fv(iLoc, iCount, false, (GLfloat*)mMatrices);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, mMatrices, sizeof(glm::mat3), iCount))
+        glUniformMatrix3fv(iLoc, iCount, false, (GLfloat*)mMatrices);
 }
 
-void CShaderProgram::SetUniform(std::string sName, const glm::mat3 mMatrix)
+void CShaderProgram::SetUniform(const CUniformName &name, const glm::mat3 mMatrix)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniformMatrix3fv(iLoc, 1, false, (GLfloat*)&mMatrix);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, &mMatrix, sizeof(glm::mat3), 1))
+        glUniformMatrix3fv(iLoc, 1, false, (GLfloat*)&mMatrix);
 }
 
 // Setting 4x4 matrices
 
-void CShaderProgram::SetUniform(std::string sName, glm::mat4* mMatrices, const GLint & iCount)
+void CShaderProgram::SetUniform(const CUniformName &name, glm::mat4* mMatrices, const GLint & iCount)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniformMatrix4fv(iLoc, iCount, false, (GLfloat*)mMatrices);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, mMatrices, sizeof(glm::mat4), iCount))
+        glUniformMatrix4fv(iLoc, iCount, false, (GLfloat*)mMatrices);
 }
 
-void CShaderProgram::SetUniform(std::string sName, const glm::mat4 mMatrix)
+void CShaderProgram::SetUniform(const CUniformName &name, const glm::mat4 mMatrix)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniformMatrix4fv(iLoc, 1, false, (GLfloat*)&mMatrix);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, &mMatrix, sizeof(glm::mat4), 1))
+        glUniformMatrix4fv(iLoc, 1, false, (GLfloat*)&mMatrix);
 }
 
 // Setting integers
 
-void CShaderProgram::SetUniform(std::string sName, GLint * iValues, const GLint & iCount)
+void CShaderProgram::SetUniform(const CUniformName &name, GLint * iValues, const GLint & iCount)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform1iv(iLoc, iCount, iValues);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, iValues, sizeof(GLint), iCount))
+        glUniform1iv(iLoc, iCount, iValues);
 }
 
-void CShaderProgram::SetUniform(std::string sName, const GLint &iValue)
+void CShaderProgram::SetUniform(const CUniformName &name, const GLint &iValue)
 {
-    int iLoc = glGetUniformLocation(m_uiProgram, sName.c_str());
-    glUniform1i(iLoc, iValue);
+    GLint iLoc = GetUniformLocation(name);
+    if (UpdateUniformValue(iLoc, &iValue, sizeof(GLint), 1))
+        glUniform1i(iLoc, iValue);
 }
 
 void CShaderProgram::Release() {
@@ -4,6 +4,8 @@
 #define ShaderProgram_h
 
 #include "Shaders.h"
+#include "UniformName.h"
+#include <unordered_map>
 
 // A class the provides a wrapper around an OpenGL shader program
 class CShaderProgram
@@ -16,43 +18,119 @@ public:
     void DeleteProgram();
     
     bool AddShaderToProgram(CShader* shShader);
+    
+    // Restores the program from the binary cache or starts compiling and linking it.
+    // With parallel compilation the link may still be running, poll IsLinkComplete and call FinishLink.
     bool LinkProgram();
+    // Instead of LinkProgram, the program is built on demand or by the prewarm thread
+    void DeferLink();
+    bool IsLinked() const;
+    // no shaders were added, the program is a placeholder
+    bool IsEmpty() const;
+    bool IsLinkPending() const;
+    bool IsLinkComplete() const;
+    bool FinishLink();
+    
+    // Hot reload, rebuilds the program from its files and keeps the old one if the new one fails
+    bool DependsOn(const std::string &file) const;
+    bool Reload();
+    
+    // Builds the variant into another program object and takes it over, see CShaderPrewarmer
+    bool Build(const GLuint &variant, CShaderProgram &rebuilt);
+    void Adopt(CShaderProgram &built, const GLuint &variant);
+    
+    // Feature set for the frame (ShaderFeature bits), UseProgram switches to the matching variant,
+    // compiling it on first use. Set it before any uniforms of the frame are uploaded.
+    static void SetFeatures(const GLuint &features);
+    static GLuint GetFeatures();
+    GLuint GetFeatureMask() const;
     
     void UseProgram();
     
     uint GetProgramID();
+    
+    // Location cached at link time, -1 when the program has no such active uniform
+    GLint GetUniformLocation(const CUniformName &name) const;
+    
+    // Uniforms keep the last value uploaded to each location, setting the same value again is not sent.
+    // Called once per frame, the counters then report the frame that just finished.
+    static void BeginFrame();
+    static GLuint GetUploadedBytes();
+    static GLuint GetSkippedUploads();
  
     // Setting Uniform Buffer Objects
     void SetUniformBlock(std::string uniformName, const GLint &bindingPoint);
     
     // Setting vectors
-    void SetUniform(std::string sName, glm::vec2* vVectors, const GLint &iCount = 1);
-    void SetUniform(std::string sName, const glm::vec2 vVector);
-    void SetUniform(std::string sName, glm::vec3* vVectors, const GLint &iCount = 1);
-    void SetUniform(std::string sName, const glm::vec3 vVector);
-    void SetUniform(std::string sName, glm::vec4* vVectors, const GLint &iCount = 1);
-    void SetUniform(std::string sName, const glm::vec4 vVector);
+    void SetUniform(const CUniformName &name, glm::vec2* vVectors, const GLint &iCount = 1);
+    void SetUniform(const CUniformName &name, const glm::vec2 vVector);
+    void SetUniform(const CUniformName &name, glm::vec3* vVectors, const GLint &iCount = 1);
+    void SetUniform(const CUniformName &name, const glm::vec3 vVector);
+    void SetUniform(const CUniformName &name, glm::vec4* vVectors, const GLint &iCount = 1);
+    void SetUniform(const CUniformName &name, const glm::vec4 vVector);
     
     // Setting floats
-    void SetUniform(std::string sName, GLfloat* fValues, const GLint & iCount = 1);
-    void SetUniform(std::string sName, const GLfloat &fValue);
+    void SetUniform(const CUniformName &name, GLfloat* fValues, const GLint & iCount = 1);
+    void SetUniform(const CUniformName &name, const GLfloat &fValue);
     
     // Setting 3x3 matrices
-    void SetUniform(std::string sName, glm::mat3* mMatrices, const GLint & iCount = 1);
-    void SetUniform(std::string sName, const glm::mat3 mMatrix);
+    void SetUniform(const CUniformName &name, glm::mat3* mMatrices, const GLint & iCount = 1);
+    void SetUniform(const CUniformName &name, const glm::mat3 mMatrix);
     
     // Setting 4x4 matrices
-    void SetUniform(std::string sName, glm::mat4* mMatrices, const GLint & iCount = 1);
-    void SetUniform(std::string sName, const glm::mat4 mMatrix);
+    void SetUniform(const CUniformName &name, glm::mat4* mMatrices, const GLint & iCount = 1);
+    void SetUniform(const CUniformName &name, const glm::mat4 mMatrix);
     
     // Setting integers
-    void SetUniform(std::string sName, GLint* iValues, const GLint & iCount = 1);
-    void SetUniform(std::string sName, const GLint & iValue);
+    void SetUniform(const CUniformName &name, GLint* iValues, const GLint & iCount = 1);
+    void SetUniform(const CUniformName &name, const GLint & iValue);
     
     void Release();
 private:
+    void OnLinked();
+    void SelectVariant();
+    void CacheUniformLocations();
+    void AddUniformLocation(const std::string &name, const GLint &location);
+    // true when the value has to be sent, remembers it for the next call
+    bool UpdateUniformValue(const GLint &location, const void *pData, const GLuint &uiSize, const GLint &iCount);
+    
     uint m_uiProgram; // ID of program
     bool m_bLinked; // Whether program was linked and is ready to use
+    bool m_bLinkPending; // Whether the driver is still compiling and linking
+    std::vector<CShader*> m_shaders; // Shaders waiting to be compiled and attached
+    
+    // what the program was built from, so it can be rebuilt when one of its files changes
+    struct ShaderFile {
+        std::string file;
+        int type;
+        std::vector<std::string> defines;
+    };
+    std::vector<ShaderFile> m_shaderFiles;
+    std::vector<std::string> m_dependencies;
+    GLuint64 m_uiSourceHash; // Hash of the attached shader sources, the binary cache key
+    
+    // open addressed table of active uniforms, indexed by the name hash, a name is only compared when its hash matches
+    struct UniformSlot {
+        GLuint hash;
+        GLint location;
+        GLboolean used;
+        std::string name;
+    };
+    std::vector<UniformSlot> m_uniformSlots;
+    std::vector<std::vector<GLubyte>> m_uniformValues; // last value sent, indexed by location
+    
+    // variants not in use, keyed by their feature bits, program 0 marks a variant that failed to build
+    struct Variant {
+        GLuint program;
+        std::vector<UniformSlot> slots;
+        std::vector<std::vector<GLubyte>> values;
+    };
+    std::unordered_map<GLuint, Variant> m_variants;
+    GLuint m_uiVariant; // Feature bits of the variant in m_uiProgram
+    GLuint m_uiFeatureMask; // Feature bits the shaders test, other bits do not create variants
+    static GLuint s_uiFeatures;
+    static GLuint s_uiUploadedBytes, s_uiSkippedUploads;
+    static GLuint s_uiFrameUploadedBytes, s_uiFrameSkippedUploads;
 };
 
 
@@ -1,10 +1,14 @@
 
 #include "Shaders.h"
+#include "ShaderCache.h"
 
 
 CShader::CShader()
 {
+    m_uiShader = 0;
     m_bLoaded = false;
+    m_bCompiled = false;
+    m_uiSourceHash = 0;
 }
 CShader::~CShader()
 {
@@ -12,137 +16,129 @@ CShader::~CShader()
 }
 
 // Loads a shader, stored as a text file with filename sFile.  The shader is of type iType (vertex, fragment, geometry, etc.)
-bool CShader::LoadShader(std::string sFile, int iType)
+bool CShader::LoadShader(std::string sFile, int iType, const std::vector<std::string> &defines)
 {
-    std::vector<std::string> sLines;
-    
-    if(!GetLinesFromFile(sFile, false, &sLines)) {
-        char message[1024];
-        printf(message, "Cannot load shader\n%s\n", sFile.c_str());
+    if(!CShaderPreprocessor::Instance().Process(sFile, defines, m_sSource, m_lineMap, m_dependencies)) {
+        printf("Cannot load shader\n%s\n", sFile.c_str());
         return false;
     }
     
-    const char** sProgram = new const char*[(int)sLines.size()];
-    for (int i = 0; i < (int)sLines.size(); i++)
-        sProgram[i] = sLines[i].c_str();
+    m_sFile = sFile;
+    m_iType = iType;
+    m_defines = defines;
+    m_uiSourceHash = CShaderCache::Hash(m_sSource, CShaderCache::Hash(std::to_string(iType)));
+    m_bLoaded = true;
+    
+    return true;
+}
+
+// Starts compiling the shader, the driver may finish it in the background
+void CShader::Compile()
+{
+    if (!m_bLoaded || m_bCompiled)
+        return;
     
-    m_uiShader = glCreateShader(iType);
+    const char* sProgram = m_sSource.c_str();
     
-    glShaderSource(m_uiShader, (int)sLines.size(), sProgram, NULL);
+    m_uiShader = glCreateShader(m_iType);
+    glShaderSource(m_uiShader, 1, &sProgram, NULL);
     glCompileShader(m_uiShader);
-    
-    delete[] sProgram;
+    m_bCompiled = true;
+}
+
+// Waits for the compilation and reports any errors
+bool CShader::CheckCompileStatus()
+{
+    if (!m_bCompiled)
+        return false;
     
     int iCompilationStatus;
     glGetShaderiv(m_uiShader, GL_COMPILE_STATUS, &iCompilationStatus);
     
     if(iCompilationStatus == GL_FALSE)
     {
-        char sInfoLog[1024];
-        char sFinalMessage[1536];
-        int iLogLength;
-        glGetShaderInfoLog(m_uiShader, 1024, &iLogLength, sInfoLog);
+        int iLogLength = 0;
+        glGetShaderiv(m_uiShader, GL_INFO_LOG_LENGTH, &iLogLength);
+        std::vector<GLchar> sInfoLog(std::max(iLogLength, 1), '\0');
+        glGetShaderInfoLog(m_uiShader, (GLsizei)sInfoLog.size(), nullptr, &sInfoLog[0]);
+        std::string sLog = CShaderPreprocessor::Instance().MapLog(&sInfoLog[0], m_lineMap);
         char sShaderType[64];
-        if (iType == GL_VERTEX_SHADER)
+        if (m_iType == GL_VERTEX_SHADER)
             sprintf(sShaderType, "vertex shader");
-        else if (iType == GL_FRAGMENT_SHADER)
+        else if (m_iType == GL_FRAGMENT_SHADER)
             sprintf(sShaderType, "fragment shader");
-        else if (iType == GL_GEOMETRY_SHADER)
+        else if (m_iType == GL_GEOMETRY_SHADER)
             sprintf(sShaderType, "geometry shader");
-        else if (iType == GL_TESS_CONTROL_SHADER)
+        else if (m_iType == GL_TESS_CONTROL_SHADER)
             sprintf(sShaderType, "tesselation control shader");
-        else if (iType == GL_TESS_EVALUATION_SHADER)
+        else if (m_iType == GL_TESS_EVALUATION_SHADER)
             sprintf(sShaderType, "tesselation evaluation shader");
         else
             sprintf(sShaderType, "unknown shader type");
         
-        sprintf(sFinalMessage, "Error in %s!\n%s\nShader file not compiled.  The compiler returned:\n\n%s", sShaderType, sFile.c_str(), sInfoLog);
+        printf("Error in %s!\n%s\nShader file not compiled.  The compiler returned:\n\n%s\n", sShaderType, m_sFile.c_str(), sLog.c_str());
         
         return false;
     }
-    m_iType = iType;
-    m_bLoaded = true;
     
     return true;
 }
 
 
-// Loads a file into a vector of strings (vResult)
-bool CShader::GetLinesFromFile(std::string sFile, bool bIncludePart, std::vector<std::string>* vResult)
-{
-    FILE* fp = fopen(sFile.c_str(), "rt");
-    if(!fp){
-        printf("Image could not be opened\n");
-        return false;
-    }
-    
-    std::string sDirectory;
-    int slashIndex = -1;
-    
-    for (int i = (int)sFile.size()-1; i == 0; i--)
-    {
-        if(sFile[i] == '\\' || sFile[i] == '/')
-        {
-            slashIndex = i;
-            break;
-        }
-    }
-    
-    sDirectory = sFile.substr(0, slashIndex+1);
-    
-    // Get all lines from a file
-    
-    char sLine[255];
-    
-    bool bInIncludePart = false;
-    
-    while(fgets(sLine, 255, fp))
-    {
-        std::stringstream ss(sLine);
-        std::string sFirst;
-        ss >> sFirst;
-        if(sFirst == "#include")
-        {
-            std::string sFileName;
-            ss >> sFileName;
-            if((int)sFileName.size() > 0 && sFileName[0] == '\"' && sFileName[(int)sFileName.size()-1] == '\"')
-            {
-                sFileName = sFileName.substr(1, (int)sFileName.size()-2);
-                GetLinesFromFile(sDirectory+sFileName, true, vResult);
-            }
-        }
-        else if(sFirst == "#include_part")
-            bInIncludePart = true;
-        else if(sFirst == "#definition_part")
-            bInIncludePart = false;
-        else if(!bIncludePart || (bIncludePart && bInIncludePart))
-            vResult->push_back(sLine);
-    }
-    fclose(fp);
-    
-    return true;
-}
-
-
-// Returns true if the shader was loaded and compiled
+// Returns true if the shader source was loaded
 bool CShader::IsLoaded()
 {
     return m_bLoaded;
 }
 
-// Returns the ID of the shader
+// Returns the ID of the shader, 0 until compilation was started
 GLuint CShader::GetShaderID()
 {
     return m_uiShader;
 }
 
+// Returns the hash of the shader type and preprocessed source
+GLuint64 CShader::GetSourceHash()
+{
+    return m_uiSourceHash;
+}
+
+int CShader::GetType()
+{
+    return m_iType;
+}
+
+const std::string &CShader::GetFileName()
+{
+    return m_sFile;
+}
+
+const std::vector<std::string> &CShader::GetDefines()
+{
+    return m_defines;
+}
+
+const std::vector<std::string> &CShader::GetDependencies()
+{
+    return m_dependencies;
+}
+
+// Returns true if the name appears in the preprocessed source, used to find the variant features
+bool CShader::References(const std::string &name)
+{
+    return m_sSource.find(name) != std::string::npos;
+}
+
 // Deletes the shader and frees GPU memory
 void CShader::DeleteShader()
 {
     if(!IsLoaded())
         return;
     m_bLoaded = false;
-    glDeleteShader(m_uiShader);
+    if (m_bCompiled)
+        glDeleteShader(m_uiShader);
+    m_bCompiled = false;
+    m_uiShader = 0;
 }
 
 void CShader::Release() {
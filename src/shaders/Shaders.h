@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../ShadersBase.h"
+#include "ShaderPreprocessor.h"
 
 // A class that provides a wrapper around an OpenGL shader
 class CShader
@@ -9,17 +10,34 @@ public:
 	CShader();
     ~CShader();
 
-	bool LoadShader(std::string sFile, int iType);
+	// defines ("NAME" or "NAME VALUE") are injected after #version, for shader variants
+	bool LoadShader(std::string sFile, int iType, const std::vector<std::string> &defines = std::vector<std::string>());
 	void DeleteShader();
-
-	bool GetLinesFromFile(std::string sFile, bool bIncludePart, std::vector<std::string>* vResult);
+    
+    // Compilation is started on first use and only waited on by CheckCompileStatus,
+    // so programs restored from the binary cache never compile their shaders
+    void Compile();
+    bool CheckCompileStatus();
 
 	bool IsLoaded();
 	uint GetShaderID();
+    GLuint64 GetSourceHash();
+    int GetType();
+    const std::string &GetFileName();
+    const std::vector<std::string> &GetDefines();
+    const std::vector<std::string> &GetDependencies();
+    bool References(const std::string &name);
 
     void Release();
 private:
 	uint m_uiShader; // ID of shader
 	int m_iType; // GL_VERTEX_SHADER, GL_FRAGMENT_SHADER...
-	bool m_bLoaded; // Whether shader was loaded and compiled
+	bool m_bLoaded; // Whether the shader source was loaded
+    bool m_bCompiled; // Whether compilation was started
+    std::string m_sFile; // Source file, for error messages
+    std::string m_sSource; // Preprocessed source
+    std::vector<std::string> m_defines; // Injected variant defines
+    std::vector<std::string> m_dependencies; // Every file the source was built from
+    std::vector<ShaderSourceLine> m_lineMap; // Origin of every preprocessed line
+    GLuint64 m_uiSourceHash; // Hash of the shader type and preprocessed source
 };
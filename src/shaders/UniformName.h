@@ -0,0 +1,80 @@
+//
+//  UniformName.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef UniformName_h
+#define UniformName_h
+
+#include "../ShadersBase.h"
+
+// A hashed uniform name, used to look up the uniform locations a program cached at link time.
+// Names are hashed with FNV-1a, which can be continued, so "light" + ".base.color" or "lights" + "[2]"
+// hash to the same value as the full name without building the string. The characters are kept in a
+// fixed buffer next to the hash so a lookup can tell two names with the same hash apart.
+class CUniformName
+{
+public:
+    // string literals are hashed at compile time
+    template<std::size_t N>
+    constexpr CUniformName(const char (&name)[N]) : m_hash(FNV_OFFSET), m_name{}, m_length(0) { Append(name, N - 1); }
+    
+    CUniformName(const std::string &name) : m_hash(FNV_OFFSET), m_name{}, m_length(0) { Append(name.c_str(), name.size()); }
+    
+    // prefix followed by a member, e.g. CUniformName(uniformName, ".base.color")
+    template<std::size_t N>
+    constexpr CUniformName(const CUniformName &prefix, const char (&member)[N]) : CUniformName(prefix) { Append(member, N - 1); }
+    
+    // prefix followed by an array index, e.g. CUniformName(pointName, 2) for "R_pointlight[2]"
+    CUniformName(const CUniformName &prefix, GLuint index) : CUniformName(prefix) {
+        char digits[16];
+        GLint count = 0;
+        do {
+            digits[count++] = '0' + (index % 10);
+            index /= 10;
+        } while (index > 0);
+        
+        Append("[", 1);
+        while (count > 0) Append(&digits[--count], 1);
+        Append("]", 1);
+    }
+    
+    constexpr GLuint GetHash() const { return m_hash; }
+    
+    // names longer than the buffer are compared on the characters it holds
+    bool Matches(const std::string &name) const {
+        if (m_length <= MAX_LENGTH)
+            return name.size() == m_length && name.compare(0, m_length, m_name, m_length) == 0;
+        return name.size() == m_length && name.compare(0, MAX_LENGTH, m_name, MAX_LENGTH) == 0;
+    }
+    
+    static constexpr GLuint Hash(const char *name, std::size_t length, GLuint hash) {
+        for (std::size_t i = 0; i < length; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(name[i])) * FNV_PRIME;
+        }
+        return hash;
+    }
+    
+private:
+    static constexpr GLuint FNV_OFFSET = 2166136261u;
+    static constexpr GLuint FNV_PRIME = 16777619u;
+    static constexpr std::size_t MAX_LENGTH = 64;
+    
+    constexpr void Append(const char *name, std::size_t length) {
+        m_hash = Hash(name, length, m_hash);
+        for (std::size_t i = 0; i < length; ++i, ++m_length) {
+            if (m_length < MAX_LENGTH) m_name[m_length] = name[i];
+        }
+    }
+    
+    GLuint m_hash;
+    char m_name[MAX_LENGTH];
+    std::size_t m_length;   // of the whole name, can be more than the buffer holds
+};
+
+#endif /* UniformName_h */
@@ -1,4 +1,5 @@
 #include "Cubemap.h"
+#include "../window/GLState.h"
 
 CCubemap::CCubemap()
 {
@@ -95,7 +96,7 @@ void CCubemap::LoadCubemap(const std::vector<std::string> &cubemapFaces, const T
     
     // Generate an OpenGL texture ID for this texture
     glGenTextures(1, &m_skyTexture);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_skyTexture);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, m_skyTexture);
     
     GLint iWidth, iHeight, iChannels;
     BYTE *data = nullptr;
@@ -107,6 +108,8 @@ void CCubemap::LoadCubemap(const std::vector<std::string> &cubemapFaces, const T
 
         if (data != NULL) delete[] data;
     }
+    CTextureResidency::Instance().Register(m_skyTexture, TextureCategory::Skybox,
+                                           CTextureResidency::EstimateBytes(iWidth, iHeight, GL_RGB, true, 6));
 
     glGenSamplers(1, &m_skySampler);
     glSamplerParameteri(m_skySampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -117,7 +120,7 @@ void CCubemap::LoadCubemap(const std::vector<std::string> &cubemapFaces, const T
     glSamplerParameteri(m_skySampler, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
 }
 
 void CCubemap::LoadHRDCubemap(const int &width, const int &height, const TextureType &type, std::vector <CShaderProgram *> *shaderPrograms, IMaterials *mat, const std::string &equirectangularCubmapPath, const std::string &equirectangularCubmap, const TextureType &equirectangularTexturetype) {
@@ -127,10 +130,10 @@ void CCubemap::LoadHRDCubemap(const int &width, const int &height, const Texture
     
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glClearDepth(1.0f);
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL); // set depth function to less than AND equal for skybox depth trick.
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_FRONT);
+    CGLState::Instance().Enable(GL_DEPTH_TEST);
+    CGLState::Instance().DepthFunc(GL_LEQUAL); // set depth function to less than AND equal for skybox depth trick.
+    CGLState::Instance().Enable(GL_CULL_FACE);
+    CGLState::Instance().CullFace(GL_FRONT);
     
     /*
      To convert an equirectangular image into a cubemap we need to render a (unit) cube and project the equirectangular map on all of the cube's faces from the inside and take 6 images of each of the cube's sides as a cubemap face. The vertex shader of this cube simply renders the cube as is and passes its local position to the fragment shader as a 3D sample vector:
@@ -141,16 +144,18 @@ void CCubemap::LoadHRDCubemap(const int &width, const int &height, const Texture
     glGenFramebuffers(1, &m_envFramebuffer);
     
     // To bind the framebuffer we use glBindFramebuffer:
-    glBindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
     
     // pbr: setup cubemap to render to and attach to framebuffer
     // ---------------------------------------------------------
     glGenTextures(1, &m_envTexture);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_envTexture);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, m_envTexture);
     for (unsigned int i = 0; i < 6; ++i)
     {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, nullptr);
     }
+    CTextureResidency::Instance().Register(m_envTexture, TextureCategory::IBL,
+                                           CTextureResidency::EstimateBytes(width, height, GL_RGB16F, true, 6));
     glGenSamplers(1, &m_envSampler);
     glSamplerParameteri(m_envSampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glSamplerParameteri(m_envSampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -160,7 +165,7 @@ void CCubemap::LoadHRDCubemap(const int &width, const int &height, const Texture
     glSamplerParameteri(m_envSampler, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
     
     /*
      setting up 6 different view matrices facing each side of the cube, given a projection matrix with a fov of 90 degrees to capture the entire face, and render a cube 6 times storing the results in a floating point framebuffer:
@@ -194,8 +199,8 @@ void CCubemap::LoadHRDCubemap(const int &width, const int &height, const Texture
     // Once we've allocated enough memory for the renderbuffer object we can unbind the renderbuffer.
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
     
-    glViewport(0, 0, width, height);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
+    CGLState::Instance().Viewport(0, 0, width, height);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
     
     m_shaderProgram = (*shaderPrograms)[77]; // equirectangularProgram
     mat->SetMaterialUniform(m_shaderProgram, "material", glm::vec4(1.0f), 32.0f, 1.0f, false, glm::vec4(1.0f));
@@ -222,10 +227,10 @@ void CCubemap::LoadHRDCubemap(const int &width, const int &height, const Texture
         m_pEquirectangularCube->Render();
         
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glDepthFunc(GL_LESS);
-    glCullFace(GL_BACK);
-    glDisable(GL_DEPTH_TEST);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
+    CGLState::Instance().DepthFunc(GL_LESS);
+    CGLState::Instance().CullFace(GL_BACK);
+    CGLState::Instance().Disable(GL_DEPTH_TEST);
     
     /*
      
@@ -245,25 +250,27 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
     
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glClearDepth(1.0f);
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL); // set depth function to less than AND equal for skybox depth trick.
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_FRONT);
+    CGLState::Instance().Enable(GL_DEPTH_TEST);
+    CGLState::Instance().DepthFunc(GL_LEQUAL); // set depth function to less than AND equal for skybox depth trick.
+    CGLState::Instance().Enable(GL_CULL_FACE);
+    CGLState::Instance().CullFace(GL_FRONT);
     
     /// Create a framebuffer object and bind it with
     glGenFramebuffers(1, &m_envFramebuffer);
     
     // To bind the framebuffer we use glBindFramebuffer:
-    glBindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
     
     // pbr: setup cubemap to render to and attach to framebuffer
     // ---------------------------------------------------------
     glGenTextures(1, &m_envTexture);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_envTexture);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, m_envTexture);
     for (unsigned int i = 0; i < 6; ++i)
     {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, nullptr);
     }
+    CTextureResidency::Instance().Register(m_envTexture, TextureCategory::IBL,
+                                           CTextureResidency::EstimateBytes(width, height, GL_RGB16F, true, 6));
     glGenSamplers(1, &m_envSampler);
     glSamplerParameteri(m_envSampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glSamplerParameteri(m_envSampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -301,8 +308,8 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
     // Once we've allocated enough memory for the renderbuffer object we can unbind the renderbuffer.
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
     
-    glViewport(0, 0, width, height);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
+    CGLState::Instance().Viewport(0, 0, width, height);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
     
     m_shaderProgram = (*shaderPrograms)[77]; // equirectangularProgram
     mat->SetMaterialUniform(m_shaderProgram, "material", glm::vec4(1.0f), 32.0f, 1.0f, false, glm::vec4(1.0f));
@@ -328,24 +335,26 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
         m_pEquirectangularCube->Render();
         
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
     
     // then let OpenGL generate mipmaps from first mip face (combatting visible dots artifact)
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_envTexture);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, m_envTexture);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
     // pbr: create an irradiance cubemap, and re-scale capture FBO to irradiance scale.
     // --------------------------------------------------------------------------------
-    glBindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
     glBindRenderbuffer(GL_RENDERBUFFER, m_envRenderbuffer);
     
     glGenTextures(1, &m_irrTexture);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_irrTexture);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, m_irrTexture);
     
     for (unsigned int i = 0; i < 6; ++i)
     {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 32, 32, 0, GL_RGB, GL_FLOAT, nullptr);
     }
+    CTextureResidency::Instance().Register(m_irrTexture, TextureCategory::IBL,
+                                           CTextureResidency::EstimateBytes(32, 32, GL_RGB16F, true, 6));
     glGenSamplers(1, &m_irrSampler);
     glSamplerParameteri(m_irrSampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glSamplerParameteri(m_irrSampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -354,7 +363,7 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
     glSamplerParameteri(m_irrSampler, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
     
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 32, 32);
     
@@ -364,8 +373,8 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
     GLint irrTextureUnit = static_cast<GLint>(type); // cubemap
     BindEnvCubemapTexture(irrTextureUnit);
     
-    glViewport(0, 0, 32, 32);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
+    CGLState::Instance().Viewport(0, 0, 32, 32);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
     
     m_irradianceCube = new CEquirectangularCube(1.0f);
     m_irradianceCube->Create("", {});
@@ -389,17 +398,19 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
         m_irradianceCube->Render(false);
         
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
     
     // pbr: create a pre-filter cubemap, and re-scale capture FBO to pre-filter scale.
     // --------------------------------------------------------------------------------
     glGenTextures(1, &m_prefilterTexture);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_prefilterTexture);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, m_prefilterTexture);
     
     for (unsigned int i = 0; i < 6; ++i)
     {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 128, 128, 0, GL_RGB, GL_FLOAT, nullptr);
     }
+    CTextureResidency::Instance().Register(m_prefilterTexture, TextureCategory::IBL,
+                                           CTextureResidency::EstimateBytes(128, 128, GL_RGB16F, true, 6));
     glGenSamplers(1, &m_prefilterSampler);
     glSamplerParameteri(m_prefilterSampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glSamplerParameteri(m_prefilterSampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -408,15 +419,15 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
     glSamplerParameteri(m_prefilterSampler, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     // generate mipmaps for the cubemap so OpenGL automatically allocates the required memory.
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    CGLState::Instance().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
     
     // pbr: run a quasi monte-carlo simulation on the environment lighting to create a prefilter (cube)map.
     // ----------------------------------------------------------------------------------------------------
     GLint prefilterTextureUnit = static_cast<GLint>(type); // cubemap
     BindEnvCubemapTexture(prefilterTextureUnit);
     
-    glViewport(0, 0, 128, 128);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
+    CGLState::Instance().Viewport(0, 0, 128, 128);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
     
     m_prefilterCube = new CEquirectangularCube(1.0f);
     m_prefilterCube->Create("", {});
@@ -433,7 +444,7 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
         glBindRenderbuffer(GL_RENDERBUFFER, m_envRenderbuffer);
         glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
         
-        glViewport(0, 0, mipWidth, mipHeight);
+        CGLState::Instance().Viewport(0, 0, mipWidth, mipHeight);
         
         float roughness = (float)mip / (float)(maxMipLevels - 1);
         m_shaderProgram->UseProgram();
@@ -454,19 +465,21 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
             m_prefilterCube->Render(false);
         }
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
     
     
     // pbr: generate a 2D LUT from the BRDF equations used.
     // ----------------------------------------------------
-    glBindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, m_envFramebuffer);
     glBindRenderbuffer(GL_RENDERBUFFER, m_envRenderbuffer);
     
     glGenTextures(1, &m_brdfLUTTexture);
-    glBindTexture(GL_TEXTURE_2D, m_brdfLUTTexture);
+    CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_brdfLUTTexture);
     
     // pre-allocate enough memory for the LUT texture.
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, width, height, 0, GL_RG, GL_FLOAT, 0);
+    CTextureResidency::Instance().Register(m_brdfLUTTexture, TextureCategory::IBL,
+                                           CTextureResidency::EstimateBytes(width, height, GL_RG16F, false));
     
     // be sure to set wrapping mode to GL_CLAMP_TO_EDGE
     glGenSamplers(1, &m_brdfLUTSampler);
@@ -479,7 +492,7 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_brdfLUTTexture, 0);
     
-    glViewport(0, 0, width, height);
+    CGLState::Instance().Viewport(0, 0, width, height);
     
     m_shaderProgram = (*shaderPrograms)[80]; // m_brdfLUTProgram
     mat->SetMaterialUniform(m_shaderProgram, "material", glm::vec4(1.0f), 32.0f, 1.0f, false, glm::vec4(1.0f));
@@ -492,55 +505,50 @@ void CCubemap::LoadIrradianceCubemap(const int &width, const int &height, const
     m_brdfLUTCube->Transform(glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
     m_brdfLUTCube->Render(false);
     
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    CGLState::Instance().BindFramebuffer(GL_FRAMEBUFFER, 0);
      
-    glDepthFunc(GL_LESS);
-    glCullFace(GL_BACK);
-    glDisable(GL_DEPTH_TEST);
+    CGLState::Instance().DepthFunc(GL_LESS);
+    CGLState::Instance().CullFace(GL_BACK);
+    CGLState::Instance().Disable(GL_DEPTH_TEST);
 }
 
 // Binds texture for rendering
 void CCubemap::BindCubemapTexture(GLint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_skyTexture);
-    glBindSampler(iTextureUnit, m_skySampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_CUBE_MAP, m_skyTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_skySampler);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 }
 
 // Binds a environment mapping texture for rendering
 void CCubemap::BindEnvCubemapTexture(GLint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_envTexture);
-    glBindSampler(iTextureUnit, m_envSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_CUBE_MAP, m_envTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_envSampler);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 }
 
 // Binds irradiance map texture for rendering
 void CCubemap::BindIrrCubemapTexture(GLint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_irrTexture);
-    glBindSampler(iTextureUnit, m_irrSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_CUBE_MAP, m_irrTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_irrSampler);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 }
 
 // Binds prefilter map texture for rendering
 void CCubemap::BindPrefilterCubemapTexture(GLint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_prefilterTexture);
-    glBindSampler(iTextureUnit, m_prefilterSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_CUBE_MAP, m_prefilterTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_prefilterSampler);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 }
 
 // Binds a BRDF texture for rendering
 void CCubemap::BindBRDFLUTTexture(GLint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_3D, m_brdfLUTTexture);
-    glBindSampler(iTextureUnit, m_brdfLUTSampler);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_3D, m_brdfLUTTexture);
+    CGLState::Instance().BindSampler(iTextureUnit, m_brdfLUTSampler);
 }
 
 
@@ -548,27 +556,41 @@ TextureType CCubemap::GetType() const {
     return m_type;
 }
 
+// Remove the cubemaps from the texture residency, before their ids are deleted
+void CCubemap::UnregisterResidency()
+{
+    CTextureResidency &residency = CTextureResidency::Instance();
+    residency.Unregister(m_skyTexture);
+    residency.Unregister(m_envTexture);
+    residency.Unregister(m_irrTexture);
+    residency.Unregister(m_prefilterTexture);
+    residency.Unregister(m_brdfLUTTexture);
+}
+
 // Clear resources
 void CCubemap::Clear()
 {
-    glDeleteSamplers(1, &m_skySampler);
-    glDeleteTextures(1, &m_skyTexture);
+    UnregisterResidency();
     
-    glDeleteSamplers(1, &m_envSampler);
-    glDeleteTextures(1, &m_envTexture);
+    CGLState::Instance().DeleteSamplers(1, &m_skySampler);
+    CGLState::Instance().DeleteTextures(1, &m_skyTexture);
     
-    glDeleteSamplers(1, &m_irrSampler);
-    glDeleteTextures(1, &m_irrTexture);
+    CGLState::Instance().DeleteSamplers(1, &m_envSampler);
+    CGLState::Instance().DeleteTextures(1, &m_envTexture);
     
-    glDeleteSamplers(1, &m_prefilterSampler);
-    glDeleteTextures(1, &m_prefilterTexture);
+    CGLState::Instance().DeleteSamplers(1, &m_irrSampler);
+    CGLState::Instance().DeleteTextures(1, &m_irrTexture);
     
-    glDeleteSamplers(1, &m_brdfLUTSampler);
-    glDeleteTextures(1, &m_brdfLUTTexture);
+    CGLState::Instance().DeleteSamplers(1, &m_prefilterSampler);
+    CGLState::Instance().DeleteTextures(1, &m_prefilterTexture);
     
-    glDeleteTextures(1, &m_envFramebuffer);
-    glDeleteTextures(1, &m_envRenderbuffer);
+    CGLState::Instance().DeleteSamplers(1, &m_brdfLUTSampler);
+    CGLState::Instance().DeleteTextures(1, &m_brdfLUTTexture);
+    
+    CGLState::Instance().DeleteTextures(1, &m_envFramebuffer);
+    CGLState::Instance().DeleteTextures(1, &m_envRenderbuffer);
     m_faces.clear();
+    m_skyTexture = m_envTexture = m_irrTexture = m_prefilterTexture = m_brdfLUTTexture = 0;
     
     if (m_pEquirectangularCube != nullptr) m_pEquirectangularCube = nullptr;
     if (m_irradianceCube != nullptr) m_irradianceCube = nullptr;
@@ -579,23 +601,25 @@ void CCubemap::Clear()
 // Release resources
 void CCubemap::Release()
 {
-    glDeleteSamplers(1, &m_skySampler);
-    glDeleteTextures(1, &m_skyTexture);
+    UnregisterResidency();
+    
+    CGLState::Instance().DeleteSamplers(1, &m_skySampler);
+    CGLState::Instance().DeleteTextures(1, &m_skyTexture);
     
-	glDeleteSamplers(1, &m_envSampler);
-	glDeleteTextures(1, &m_envTexture);
+	CGLState::Instance().DeleteSamplers(1, &m_envSampler);
+	CGLState::Instance().DeleteTextures(1, &m_envTexture);
     
-    glDeleteSamplers(1, &m_irrSampler);
-    glDeleteTextures(1, &m_irrTexture);
+    CGLState::Instance().DeleteSamplers(1, &m_irrSampler);
+    CGLState::Instance().DeleteTextures(1, &m_irrTexture);
     
-    glDeleteSamplers(1, &m_prefilterSampler);
-    glDeleteTextures(1, &m_prefilterTexture);
+    CGLState::Instance().DeleteSamplers(1, &m_prefilterSampler);
+    CGLState::Instance().DeleteTextures(1, &m_prefilterTexture);
     
-    glDeleteSamplers(1, &m_brdfLUTSampler);
-    glDeleteTextures(1, &m_brdfLUTTexture);
+    CGLState::Instance().DeleteSamplers(1, &m_brdfLUTSampler);
+    CGLState::Instance().DeleteTextures(1, &m_brdfLUTTexture);
     
-    glDeleteTextures(1, &m_envFramebuffer);
-    glDeleteTextures(1, &m_envRenderbuffer);
+    CGLState::Instance().DeleteTextures(1, &m_envFramebuffer);
+    CGLState::Instance().DeleteTextures(1, &m_envRenderbuffer);
     m_faces.clear();
     
     delete m_pEquirectangularCube;
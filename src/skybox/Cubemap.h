@@ -24,6 +24,7 @@ public:
     
 private:
     GLboolean LoadTexture(std::string filename, BYTE **bmpBytes, GLint &iWidth, GLint &iHeight);
+    void UnregisterResidency();
 	GLuint m_skyTexture, m_skySampler, m_envTexture, m_envSampler, m_irrTexture, m_irrSampler, m_prefilterTexture, m_prefilterSampler;
     GLuint m_brdfLUTTexture, m_brdfLUTSampler;
     GLuint m_envFramebuffer, m_envRenderbuffer;
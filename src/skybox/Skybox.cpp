@@ -1,4 +1,5 @@
 #include "Skybox.h"
+#include "../window/GLState.h"
 
 // https://stackoverflow.com/questions/11685608/convention-of-faces-in-opengl-cubemapping
 // https://www.flickr.com/groups/353787@N23/pool/page3
@@ -105,7 +106,7 @@ void CSkybox::CreateAttributes(const GLfloat &size) {
     
      
      glGenVertexArrays(1, &m_vao);
-     glBindVertexArray(m_vao);
+     CGLState::Instance().BindVertexArray(m_vao);
      
      m_vbo.Create();
      m_vbo.Bind();
@@ -182,8 +183,8 @@ void CSkybox::Render(const GLboolean &useTexture) {
 // Render the skybox with skybox type
 void CSkybox::Render(const GLboolean &useTexture, const SkyboxType &skyboxType) {
     
-    glDepthMask(GL_FALSE);
-    glBindVertexArray(m_vao);
+    CGLState::Instance().DepthMask(GL_FALSE);
+    CGLState::Instance().BindVertexArray(m_vao);
     
     GLint iTextureUnit = static_cast<GLint>(m_cubemapTexture->GetType());
     
@@ -205,9 +206,9 @@ void CSkybox::Render(const GLboolean &useTexture, const SkyboxType &skyboxType)
     for (int i = 0; i < 6; i++) {
         glDrawArrays(GL_TRIANGLE_STRIP, i*4, 4);
     }
-    glBindVertexArray(0);
+    CGLState::Instance().BindVertexArray(0);
     
-    glDepthMask(GL_TRUE);
+    CGLState::Instance().DepthMask(GL_TRUE);
 }
 
 void CSkybox::BindSkyboxTo(const GLint &textureUnit) {
@@ -239,7 +240,7 @@ std::vector<std::string> CSkybox::GetSkyboxes() const {
 }
 
 void CSkybox::Clear() {
-    glDeleteVertexArrays(1, &m_vao);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vao);
     m_vbo.Release();
     m_cubemapTexture->Clear();
 }
@@ -247,7 +248,7 @@ void CSkybox::Clear() {
 // Release the storage assocaited with the skybox
 void CSkybox::Release()
 {
-    glDeleteVertexArrays(1, &m_vao);
+    CGLState::Instance().DeleteVertexArrays(1, &m_vao);
     m_vbo.Release();
     
     m_cubemapTexture->Release();
@@ -46,13 +46,22 @@
 #define STBI_ASSERT(x)
 #include <stb/stb_image.h>
 #include "Texture.h"
+#include "../window/GLState.h"
 
 CTexture::CTexture()
 {
     m_format = GL_RGB;
+    m_internalFormat = GL_RGB;
     m_path = "";
     m_type = TextureType::AMBIENT;
 	m_mipMapsGenerated = false;
+    m_gammaCorrection = false;
+    m_stbLoaded = false;
+    m_droppedMips = 0;
+    m_textureID = 0;
+    m_hdrTextureID = 0;
+    m_samplerObjectID = 0;
+    m_width = m_height = m_bpp = 0;
 }
 CTexture::~CTexture()
 {
@@ -63,9 +72,9 @@ CTexture::~CTexture()
 void CTexture::CreateFromData(BYTE* data, GLint width, GLint height, GLint bpp, GLenum format, const TextureType &type,
                               GLboolean generateMipMaps, GLboolean gammaCorrection)
 {
-	// Generate an OpenGL texture ID for this texture
-	glGenTextures(1, &m_textureID);
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
+	// Generate an OpenGL texture ID for this texture, streaming back in reuses the existing one
+	if (m_textureID == 0) glGenTextures(1, &m_textureID);
+    CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_textureID);
  
     GLenum internalFormat;
     // We must handle this because of internal format parameter
@@ -87,15 +96,20 @@ void CTexture::CreateFromData(BYTE* data, GLint width, GLint height, GLint bpp,
     glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
     
     if(generateMipMaps)glGenerateMipmap(GL_TEXTURE_2D);
-    glGenSamplers(1, &m_samplerObjectID);
+    if (m_samplerObjectID == 0) glGenSamplers(1, &m_samplerObjectID);
 
     m_path = "";
     m_type = type;
+    m_internalFormat = internalFormat;
 	m_mipMapsGenerated = generateMipMaps;
+    m_gammaCorrection = gammaCorrection;
+    m_stbLoaded = false;
+    m_droppedMips = 0;
 	m_width = width;
 	m_height = height;
 	m_bpp = bpp;
     
+    RegisterResidency(TextureCategory::Generated, false);
 }
 
 // Loads a 2D texture given the filename (sPath).  bGenerateMipMaps will generate a mipmapped texture if true
@@ -137,6 +151,7 @@ GLboolean CTexture::LoadTexture(const std::string &path, const TextureType &type
 
     m_path = path;
     m_type = type;
+    RegisterResidency(TextureCategory::Material, true);
     return true; // Success
 }
 
@@ -144,7 +159,7 @@ GLboolean CTexture::LoadTexture(const std::string &path, const TextureType &type
 // ---------------------------------------------------
 GLuint CTexture::LoadTexture(char const * path, const TextureType &type,
                              const GLboolean &generateMipMaps, GLboolean gammaCorrection) {
-    glGenTextures(1, &m_textureID);
+    if (m_textureID == 0) glGenTextures(1, &m_textureID);
     
     int width, height, nrComponents;
     unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
@@ -177,13 +192,14 @@ GLuint CTexture::LoadTexture(char const * path, const TextureType &type,
             internalFormat = format;
         }
         
-        glBindTexture(GL_TEXTURE_2D, m_textureID);
+        CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_textureID);
         glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
         
         if(generateMipMaps)glGenerateMipmap(GL_TEXTURE_2D);
-        glGenSamplers(1, &m_samplerObjectID);
+        if (m_samplerObjectID == 0) glGenSamplers(1, &m_samplerObjectID);
         
         m_format = format;
+        m_internalFormat = internalFormat;
         stbi_image_free(data);
     }
     else
@@ -195,9 +211,14 @@ GLuint CTexture::LoadTexture(char const * path, const TextureType &type,
     m_path = path;
     m_type = type;
     m_mipMapsGenerated = generateMipMaps;
+    m_gammaCorrection = gammaCorrection;
+    m_stbLoaded = true;
+    m_droppedMips = 0;
     m_width = width;
     m_height = height;
     m_bpp = 0;
+    
+    if (data) RegisterResidency(TextureCategory::Material, true);
                                  
     return m_textureID;
 }
@@ -212,10 +233,12 @@ GLuint CTexture::LoadCustomTexture(GLint width, GLint height, GLboolean generate
     m_height = height;
     m_bpp = 0;
     
+    m_internalFormat = GL_RGB32F;
+    
     // Generate an OpenGL texture ID for this texture
     //GLuint texture;
-    glGenTextures(1, &m_textureID);
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    if (m_textureID == 0) glGenTextures(1, &m_textureID);
+    CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_textureID);
     
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, width, height, 0, m_format, GL_FLOAT, data);
     
@@ -226,6 +249,8 @@ GLuint CTexture::LoadCustomTexture(GLint width, GLint height, GLboolean generate
     
     if(generateMipMaps)glGenerateMipmap(GL_TEXTURE_2D);
     
+    RegisterResidency(TextureCategory::Generated, false);
+    
     return m_textureID;
 }
 
@@ -255,11 +280,15 @@ GLuint CTexture::LoadHDRTexture(char const * path, const TextureType &type, cons
     m_format = GL_RGB;
     if (data)
     {
-        glGenTextures(1, &m_hdrTextureID);
-        glBindTexture(GL_TEXTURE_2D, m_hdrTextureID);
+        if (m_hdrTextureID == 0) glGenTextures(1, &m_hdrTextureID);
+        CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_hdrTextureID);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, m_format, GL_FLOAT, data); // note how we specify the texture's data value to be float
         if(generateMipMaps)glGenerateMipmap(GL_TEXTURE_2D);
-        glGenSamplers(1, &m_samplerObjectID);
+        if (m_samplerObjectID == 0) glGenSamplers(1, &m_samplerObjectID);
+        
+        // hdr maps are only sampled while the environment cubemaps are rendered, they are counted but not evicted
+        CTextureResidency::Instance().Register(m_hdrTextureID, TextureCategory::HDR,
+                                               CTextureResidency::EstimateBytes(width, height, GL_RGB16F, generateMipMaps));
         
         stbi_image_free(data);
     }
@@ -297,66 +326,123 @@ void CTexture::SetSamplerObjectParameterfv(GLenum parameter, const GLfloat * val
 // Binds a texture for rendering
 void CTexture::BindTexture2D(GLint iTextureUnit) const
 {
-	glActiveTexture(GL_TEXTURE0+iTextureUnit);
-	glBindTexture(GL_TEXTURE_2D, m_textureID);
-	glBindSampler(iTextureUnit, m_samplerObjectID);
+	CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_textureID);
+	CGLState::Instance().BindSampler(iTextureUnit, m_samplerObjectID);
+    CTextureResidency::Instance().Touch(m_textureID);
 }
 
 void CTexture::BindTexture2DToTextureType() const
 {
     GLint iTextureUnit = static_cast<GLint>(m_type);
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
-    glBindSampler(iTextureUnit, m_samplerObjectID);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_textureID);
+    CGLState::Instance().BindSampler(iTextureUnit, m_samplerObjectID);
+    CTextureResidency::Instance().Touch(m_textureID);
 }
 
 void CTexture::BindCustomTexture2DToTextureType() const
 {
     GLint iTextureUnit = static_cast<GLint>(m_type);
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_textureID);
+    CTextureResidency::Instance().Touch(m_textureID);
 }
 
 // Binds a hdr texture for rendering
 void CTexture::BindHDRTexture2D(GLint iTextureUnit) const
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_hdrTextureID);
-    glBindSampler(iTextureUnit, m_samplerObjectID);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_hdrTextureID);
+    CGLState::Instance().BindSampler(iTextureUnit, m_samplerObjectID);
 }
 
 void CTexture::BindHDRTexture2DToTextureType() const
 {
     GLint iTextureUnit = static_cast<GLint>(m_type);
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_hdrTextureID);
-    glBindSampler(iTextureUnit, m_hdrTextureID);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_2D, m_hdrTextureID);
+    CGLState::Instance().BindSampler(iTextureUnit, m_hdrTextureID);
 }
 
 // Binds a texture for rendering
 void CTexture::BindTexture3D(GLint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_3D, m_textureID);
-    glBindSampler(iTextureUnit, m_samplerObjectID);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_3D, m_textureID);
+    CGLState::Instance().BindSampler(iTextureUnit, m_samplerObjectID);
     
 }
 
 // Binds a texture for rendering
 void CTexture::BindTextureCubeMap(GLint iTextureUnit)
 {
-    glActiveTexture(GL_TEXTURE0+iTextureUnit);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_textureID);
-    glBindSampler(iTextureUnit, m_samplerObjectID);
+    CGLState::Instance().BindTexture(iTextureUnit, GL_TEXTURE_CUBE_MAP, m_textureID);
+    CGLState::Instance().BindSampler(iTextureUnit, m_samplerObjectID);
+    
+}
+
+// Drops the top mips of a loaded texture by reading back a smaller level and making it the new base level
+GLboolean CTexture::DropMips(const GLuint &count)
+{
+    if (m_textureID == 0 || !m_mipMapsGenerated || count <= m_droppedMips || count > GetMipLevels())
+        return false;
+    
+    GLint level = count - m_droppedMips;
+    GLint width = std::max(m_width >> count, 1);
+    GLint height = std::max(m_height >> count, 1);
+    
+    GLint channels = 1;
+    if (m_format == GL_RGBA || m_format == GL_BGRA) channels = 4;
+    else if (m_format == GL_RGB || m_format == GL_BGR) channels = 3;
+    std::vector<BYTE> data(width * height * channels);
+    
+    CGLState::Instance().BindTexture(GL_TEXTURE_2D, m_textureID);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glGetTexImage(GL_TEXTURE_2D, level, m_format, GL_UNSIGNED_BYTE, &data[0]);
+    glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, width, height, 0, m_format, GL_UNSIGNED_BYTE, &data[0]);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    
+    m_droppedMips = count;
+    CTextureResidency::Instance().Resize(m_textureID, CTextureResidency::EstimateBytes(width, height, m_internalFormat, true), m_droppedMips);
+    return true;
+}
+
+// Streams the full resolution texture back in from disk, into the same texture id
+GLboolean CTexture::Restream()
+{
+    if (m_path.empty() || m_textureID == 0)
+        return false;
     
+    if (m_stbLoaded)
+        return LoadTexture(m_path.c_str(), m_type, m_mipMapsGenerated, m_gammaCorrection) != 0;
+    
+    return LoadTexture(m_path, m_type, m_mipMapsGenerated);
+}
+
+GLuint CTexture::GetMipLevels() const
+{
+    return (GLuint)floor(log2(std::max(std::max(m_width, m_height), 1)));
+}
+
+void CTexture::RegisterResidency(const TextureCategory &category, const GLboolean &evictable)
+{
+    CTextureResidency::Instance().Register(m_textureID, this, category,
+                                           CTextureResidency::EstimateBytes(m_width, m_height, m_internalFormat, m_mipMapsGenerated),
+                                           evictable && !m_path.empty() && m_mipMapsGenerated);
 }
 
 // Frees memory on the GPU of the texture
 void CTexture::Release()
 {
-	glDeleteSamplers(1, &m_samplerObjectID);
-	glDeleteTextures(1, &m_textureID);
-    glDeleteTextures(1, &m_hdrTextureID);
+    CTextureResidency::Instance().Unregister(m_textureID);
+    CTextureResidency::Instance().Unregister(m_hdrTextureID);
+    
+	CGLState::Instance().DeleteSamplers(1, &m_samplerObjectID);
+	CGLState::Instance().DeleteTextures(1, &m_textureID);
+    CGLState::Instance().DeleteTextures(1, &m_hdrTextureID);
+    
+    // ids are reused by the driver, make sure a second release does not delete someone else's texture
+    m_samplerObjectID = 0;
+    m_textureID = 0;
+    m_hdrTextureID = 0;
 }
 
 GLint CTexture::GetWidth() const
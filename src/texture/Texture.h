@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../TextureBase.h"
+#include "TextureResidency.h"
 
 // Class that provides a texture for texture mapping in OpenGL
 class CTexture
@@ -28,6 +29,11 @@ public:
 	void SetSamplerObjectParameterf(GLenum parameter, GLfloat value);
     void SetSamplerObjectParameterfv(GLenum parameter, const GLfloat * value);
     
+    // residency, drop the top mips of a loaded texture or stream it back in from disk
+    GLboolean DropMips(const GLuint &count);
+    GLboolean Restream();
+    GLuint GetMipLevels() const;
+    
 	GLint GetWidth() const;
     GLint GetHeight() const;
     GLint GetBPP() const;
@@ -41,11 +47,15 @@ public:
     ~CTexture();
 private:
     
-    GLenum m_format;
+    void RegisterResidency(const TextureCategory &category, const GLboolean &evictable);
+    
+    GLenum m_format, m_internalFormat;
 	GLint m_width, m_height, m_bpp; // Texture width, height, and bytes per pixel
     GLuint m_textureID, m_hdrTextureID; // Texture id
 	GLuint m_samplerObjectID; // Sampler id
 	GLboolean m_mipMapsGenerated;
+    GLboolean m_gammaCorrection, m_stbLoaded; // how the texture was loaded, so it can be streamed back in the same way
+    GLuint m_droppedMips;
 
     std::string m_path;
     TextureType m_type;
@@ -0,0 +1,234 @@
+//
+//  TextureResidency.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "TextureResidency.h"
+#include "Texture.h"
+
+CTextureResidency &CTextureResidency::Instance()
+{
+    static CTextureResidency instance;
+    return instance;
+}
+
+CTextureResidency::CTextureResidency()
+{
+    for (GLuint i = 0; i < static_cast<GLuint>(TextureCategory::NumberOfCategories); ++i) {
+        m_usage[i] = 0;
+    }
+    m_budget = (GLuint64)TEXTURE_BUDGET * 1024 * 1024;
+    m_frame = 0;
+    m_graceFrames = 60;
+    m_maxDroppedMips = 2;
+    m_maxRestreamsPerFrame = 4;
+    m_evictions = 0;
+    m_restreams = 0;
+}
+
+void CTextureResidency::Register(GLuint textureID, CTexture *pTexture, const TextureCategory &category, const GLuint64 &bytes, const GLboolean &evictable)
+{
+    if (textureID == 0) return;
+    
+    auto it = m_entries.find(textureID);
+    if (it != m_entries.end()) {
+        m_usage[static_cast<int>(it->second.category)] -= it->second.bytes;
+    } else {
+        it = m_entries.insert({textureID, Entry()}).first;
+    }
+    
+    Entry &entry = it->second;
+    entry.pTexture = pTexture;
+    entry.category = category;
+    entry.bytes = bytes;
+    entry.lastBoundFrame = m_frame;
+    entry.droppedMips = 0;
+    entry.evictable = evictable && pTexture != nullptr;
+    entry.evicted = false;
+    entry.requested = false;
+    m_usage[static_cast<int>(category)] += bytes;
+}
+
+void CTextureResidency::Register(GLuint textureID, const TextureCategory &category, const GLuint64 &bytes)
+{
+    Register(textureID, nullptr, category, bytes, false);
+}
+
+void CTextureResidency::Resize(GLuint textureID, const GLuint64 &bytes, const GLuint &droppedMips)
+{
+    auto it = m_entries.find(textureID);
+    if (it == m_entries.end()) return;
+    
+    Entry &entry = it->second;
+    m_usage[static_cast<int>(entry.category)] -= entry.bytes;
+    m_usage[static_cast<int>(entry.category)] += bytes;
+    entry.bytes = bytes;
+    entry.droppedMips = droppedMips;
+}
+
+void CTextureResidency::Unregister(GLuint textureID)
+{
+    auto it = m_entries.find(textureID);
+    if (it == m_entries.end()) return;
+    
+    m_usage[static_cast<int>(it->second.category)] -= it->second.bytes;
+    m_entries.erase(it);
+}
+
+void CTextureResidency::Touch(GLuint textureID)
+{
+    auto it = m_entries.find(textureID);
+    if (it == m_entries.end()) return;
+    
+    Entry &entry = it->second;
+    entry.lastBoundFrame = m_frame;
+    if (entry.droppedMips > 0) entry.requested = true;
+}
+
+void CTextureResidency::Update()
+{
+    ++m_frame;
+    
+    // stream textures that were bound while they were not fully resident back in from disk
+    GLuint restreams = 0;
+    for (auto &it : m_entries) {
+        if (restreams >= m_maxRestreamsPerFrame) break;
+        
+        Entry &entry = it.second;
+        if (!entry.requested) continue;
+        
+        entry.requested = false;
+        if (entry.pTexture->Restream()) {
+            ++restreams;
+            ++m_restreams;
+        }
+    }
+    
+    if (m_budget == 0) return;
+    
+    // evict least recently bound textures until we are back under budget,
+    // dropping top mips everywhere first before anything is fully evicted
+    GLuint steps = 0;
+    while (GetUsage() > m_budget && steps < m_maxRestreamsPerFrame) {
+        auto lru = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            const Entry &entry = it->second;
+            if (!entry.evictable || entry.evicted || entry.requested) continue;
+            if (entry.lastBoundFrame + m_graceFrames > m_frame) continue;
+            
+            if (lru == m_entries.end()
+                || entry.droppedMips < lru->second.droppedMips
+                || (entry.droppedMips == lru->second.droppedMips && entry.lastBoundFrame < lru->second.lastBoundFrame)) {
+                lru = it;
+            }
+        }
+        
+        if (lru == m_entries.end()) break;
+        
+        if (!Evict(lru->first, lru->second)) {
+            lru->second.evictable = false;
+        }
+        ++steps;
+    }
+}
+
+GLboolean CTextureResidency::Evict(GLuint textureID, Entry &entry)
+{
+    if (entry.droppedMips < m_maxDroppedMips) {
+        return entry.pTexture->DropMips(entry.droppedMips + 1);
+    }
+    
+    // keep only the smallest mip, its single texel is the average colour of the image
+    if (!entry.pTexture->DropMips(entry.pTexture->GetMipLevels())) return false;
+    
+    entry.evicted = true;
+    ++m_evictions;
+    return true;
+}
+
+void CTextureResidency::SetBudget(const GLuint64 &bytes)
+{
+    m_budget = bytes;
+}
+
+GLuint64 CTextureResidency::GetBudget() const
+{
+    return m_budget;
+}
+
+GLuint64 CTextureResidency::GetUsage() const
+{
+    GLuint64 usage = 0;
+    for (GLuint i = 0; i < static_cast<GLuint>(TextureCategory::NumberOfCategories); ++i) {
+        usage += m_usage[i];
+    }
+    return usage;
+}
+
+GLuint64 CTextureResidency::GetUsage(const TextureCategory &category) const
+{
+    return m_usage[static_cast<int>(category)];
+}
+
+GLuint CTextureResidency::GetEvictions() const
+{
+    return m_evictions;
+}
+
+GLuint CTextureResidency::GetRestreams() const
+{
+    return m_restreams;
+}
+
+const char * const CTextureResidency::CategoryToString(const TextureCategory &category) const
+{
+    switch(category) {
+        case TextureCategory::Material:
+            return "Material";
+        case TextureCategory::Generated:
+            return "Generated";
+        case TextureCategory::HDR:
+            return "HDR";
+        case TextureCategory::Skybox:
+            return "Skybox";
+        case TextureCategory::IBL:
+            return "IBL";
+        default:
+            return "Unknown";
+    }
+}
+
+GLuint64 CTextureResidency::EstimateBytes(GLint width, GLint height, GLenum internalFormat, GLboolean mipMaps, GLuint faces)
+{
+    GLuint64 bytesPerTexel;
+    switch(internalFormat) {
+        case GL_RED:
+        case GL_R8:
+        case GL_LUMINANCE:
+        case GL_DEPTH_COMPONENT:
+            bytesPerTexel = 1;
+            break;
+        case GL_RG16F:
+            bytesPerTexel = 4;
+            break;
+        case GL_RGB16F:
+        case GL_RGBA16F:
+            bytesPerTexel = 8;
+            break;
+        case GL_RGB32F:
+        case GL_RGBA32F:
+            bytesPerTexel = 16;
+            break;
+        default:
+            // rgb textures are padded to four channels by the driver
+            bytesPerTexel = 4;
+            break;
+    }
+    
+    GLuint64 bytes = (GLuint64)width * (GLuint64)height * bytesPerTexel * faces;
+    if (mipMaps) bytes += bytes / 3;
+    return bytes;
+}
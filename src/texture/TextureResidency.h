@@ -0,0 +1,79 @@
+//
+//  TextureResidency.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef TextureResidency_h
+#define TextureResidency_h
+
+#include "../TextureBase.h"
+#include "../utilities/TextureCategory.h"
+#include <unordered_map>
+
+class CTexture;
+
+// Tracks the GPU memory of every texture allocation and keeps it under a budget.
+// Textures that have not been bound for a while first lose their top mips, then get
+// evicted to a 1x1 placeholder, and are streamed back from disk once they are bound again.
+class CTextureResidency
+{
+public:
+    static CTextureResidency &Instance();
+    
+    // a texture that can be streamed back from disk (pTexture != nullptr and evictable)
+    void Register(GLuint textureID, CTexture *pTexture, const TextureCategory &category, const GLuint64 &bytes, const GLboolean &evictable);
+    // a texture owned by something else (cubemaps, render targets), only counted
+    void Register(GLuint textureID, const TextureCategory &category, const GLuint64 &bytes);
+    void Resize(GLuint textureID, const GLuint64 &bytes, const GLuint &droppedMips);
+    void Unregister(GLuint textureID);
+    
+    // called on every bind, marks the texture as used this frame
+    void Touch(GLuint textureID);
+    // called once per frame, streams requested textures back in and evicts down to the budget
+    void Update();
+    
+    void SetBudget(const GLuint64 &bytes);
+    GLuint64 GetBudget() const;
+    GLuint64 GetUsage() const;
+    GLuint64 GetUsage(const TextureCategory &category) const;
+    GLuint GetEvictions() const;
+    GLuint GetRestreams() const;
+    const char * const CategoryToString(const TextureCategory &category) const;
+    
+    // estimated size of a texture on the GPU, mip chains add a third
+    static GLuint64 EstimateBytes(GLint width, GLint height, GLenum internalFormat, GLboolean mipMaps, GLuint faces = 1);
+    
+private:
+    CTextureResidency();
+    CTextureResidency(const CTextureResidency &) = delete;
+    CTextureResidency &operator=(const CTextureResidency &) = delete;
+    
+    struct Entry {
+        CTexture *pTexture;
+        TextureCategory category;
+        GLuint64 bytes;
+        GLuint64 lastBoundFrame;
+        GLuint droppedMips;
+        GLboolean evictable;
+        GLboolean evicted;
+        GLboolean requested;
+    };
+    
+    GLboolean Evict(GLuint textureID, Entry &entry);
+    
+    std::unordered_map<GLuint, Entry> m_entries;
+    GLuint64 m_usage[static_cast<int>(TextureCategory::NumberOfCategories)];
+    GLuint64 m_budget;
+    GLuint64 m_frame;
+    GLuint m_graceFrames;          // frames a texture must go unbound before it can be evicted
+    GLuint m_maxDroppedMips;       // mips dropped before a texture is fully evicted
+    GLuint m_maxRestreamsPerFrame; // disk loads allowed per frame when streaming back in
+    GLuint m_evictions, m_restreams;
+};
+
+#endif /* TextureResidency_h */
@@ -0,0 +1,69 @@
+//
+//  GPUTimer.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "GPUTimer.h"
+
+CGPUTimer::CGPUTimer()
+{
+    for (GLuint i = 0; i < QUERIES; ++i) {
+        m_queries[i] = 0;
+        m_issued[i] = false;
+    }
+    m_uiNext = 0;
+    m_bCreated = false;
+    m_bActive = false;
+    m_fElapsed = 0.0f;
+}
+
+void CGPUTimer::Begin()
+{
+    if (!m_bCreated) {
+        glGenQueries(QUERIES, m_queries);
+        m_bCreated = true;
+    }
+    Collect();
+
+    // every query is still in flight, this frame is not measured
+    m_bActive = !m_issued[m_uiNext];
+    if (m_bActive) glBeginQuery(GL_TIME_ELAPSED, m_queries[m_uiNext]);
+}
+
+void CGPUTimer::End()
+{
+    if (!m_bActive) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_issued[m_uiNext] = true;
+    m_uiNext = (m_uiNext + 1) % QUERIES;
+    m_bActive = false;
+}
+
+void CGPUTimer::Collect()
+{
+    for (GLuint i = 0; i < QUERIES; ++i) {
+        if (!m_issued[i]) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(m_queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(m_queries[i], GL_QUERY_RESULT, &nanoseconds);
+        m_issued[i] = false;
+
+        GLfloat milliseconds = nanoseconds / 1000000.0f;
+        m_fElapsed = m_fElapsed == 0.0f ? milliseconds : m_fElapsed * 0.9f + milliseconds * 0.1f;
+    }
+}
+
+void CGPUTimer::Release()
+{
+    if (!m_bCreated) return;
+    glDeleteQueries(QUERIES, m_queries);
+    m_bCreated = false;
+    for (GLuint i = 0; i < QUERIES; ++i) m_issued[i] = false;
+}
@@ -0,0 +1,44 @@
+//
+//  GPUTimer.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef GPUTimer_h
+#define GPUTimer_h
+
+#include "../TimerBase.h"
+
+// Times the GL commands issued between Begin and End on the GPU. Results are read a few frames
+// later when they are ready, so the timer never waits for the GPU. Time elapsed queries do not nest,
+// only one timer may be between Begin and End at a time.
+class CGPUTimer
+{
+public:
+    CGPUTimer();
+
+    void Begin();
+    void End();
+
+    // milliseconds, smoothed over the finished measurements, 0 until the first one is ready
+    GLfloat GetElapsed() const { return m_fElapsed; }
+
+    void Release();
+
+private:
+    void Collect();
+
+    static const GLuint QUERIES = 3;
+    GLuint m_queries[QUERIES];
+    GLboolean m_issued[QUERIES];
+    GLuint m_uiNext;
+    GLboolean m_bCreated;
+    GLboolean m_bActive;
+    GLfloat m_fElapsed;
+};
+
+#endif /* GPUTimer_h */
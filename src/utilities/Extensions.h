@@ -13,6 +13,8 @@
 
 #include "../UtilitiesBase.h"
 #include "Colours.h"
+#include "RenderQueue.h"
+#include "TransformHierarchy.h"
 
 template<typename T>
 glm::tvec4<T> tvec4_from_t(const T *arr) {
@@ -32,21 +34,25 @@ class Extensions {
     
 public:
 
+    // furthest first, the order transparent objects are drawn in, positions at the same distance are all kept
     static std::vector<glm::vec3> sortByNearestToCameraFirst(std::vector<glm::vec3> & positions, glm::vec3 &cameraPosition) {
         
+        float furthest = 0.0f;
+        for (unsigned int i = 0; i < positions.size(); i++)
+            furthest = glm::max(furthest, glm::length(cameraPosition - positions[i]));
         
-        std::map<float, glm::vec3> sorted;
+        CRenderQueue queue;
         for (unsigned int i = 0; i < positions.size(); i++)
         {
             float distance = glm::length(cameraPosition - positions[i]);
-            sorted[distance] = positions[i];
+            queue.Push(CRenderQueue::TransparentKey(furthest > 0.0f ? distance / furthest : 0.0f, 0, 0, 0), i);
         }
+        queue.Sort();
         
         std::vector<glm::vec3> result;
-        for(std::map<float,glm::vec3>::reverse_iterator it = sorted.rbegin(); it != sorted.rend(); ++it)
+        for (unsigned int i = 0; i < queue.GetCount(); i++)
         {
-            result.push_back(it->second) ;
-            
+            result.push_back(positions[queue.GetItem(i)]);
         }
         
         return result;
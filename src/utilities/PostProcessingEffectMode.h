@@ -78,5 +78,129 @@ enum class PostProcessingEffectMode {
     NumberOfPPFX,
 };
 
+// the name the hud and the logs show for an effect
+inline const char * PostProcessingEffectModeToString(const PostProcessingEffectMode &mode) {
+    switch(mode) {
+        case PostProcessingEffectMode::PBR:
+        return "Physically Based Rendering";
+        case PostProcessingEffectMode::IBL:
+        return "Image Based Lighting";
+        case PostProcessingEffectMode::BlinnPhong:
+        return "Blinn-Phong Lighting";
+        case PostProcessingEffectMode::ColorInversion:
+        return "Color Inversion";
+        case PostProcessingEffectMode::GrayScale:
+        return "GrayScale";
+        case PostProcessingEffectMode::Kernel:
+        return "Kernel";
+        case PostProcessingEffectMode::KernelBlur:
+        return "Kernel Blur";
+        case PostProcessingEffectMode::SobelEdgeDetection:
+        return "Sobel Edge Detection";
+        case PostProcessingEffectMode::FreiChenEdgeDetection:
+        return "Frei-Chen Edge Detection";
+        case PostProcessingEffectMode::ScreenWave:
+        return "Screen Wave";
+        case PostProcessingEffectMode::Swirl:
+        return "Swirl";
+        case PostProcessingEffectMode::NightVision:
+        return "Night Vision";
+        case PostProcessingEffectMode::LensCircle:
+        return "Lens Circle";
+        case PostProcessingEffectMode::Posterization:
+        return "Posterization";
+        case PostProcessingEffectMode::DreamVision:
+        return "Dream Vision";
+        case PostProcessingEffectMode::Pixelate:
+        return "Pixelate";
+        case PostProcessingEffectMode::Pixelation:
+        return "Pixelation";
+        case PostProcessingEffectMode::KnittedPixelation:
+        return "Knitted Pixelation";
+        case PostProcessingEffectMode::FrostedGlassPixelationEffect:
+        return "Frosted Glass Pixelation Effect";
+        case PostProcessingEffectMode::FrostedGlassScreenWaveEffect:
+        return "Frosted Glass Screen Wave Effect";
+        case PostProcessingEffectMode::Crosshatching:
+        return "Crosshatching";
+        case PostProcessingEffectMode::PredatorsThermalVision:
+        return "Predators Thermal Vision";
+        case PostProcessingEffectMode::Toonify:
+        return "Toonify";
+        case PostProcessingEffectMode::Shockwave:
+        return "Shockwave";
+        case PostProcessingEffectMode::FishEye:
+        return "Fish Eye";
+        case PostProcessingEffectMode::BarrelDistortion:
+        return "Barrel Distortion";
+        case PostProcessingEffectMode::MultiScreenFishEye:
+        return "Multi-Screen Fish Eye";
+        case PostProcessingEffectMode::FishEyeLens:
+        return "Fish Eye Lens";
+        case PostProcessingEffectMode::FishEyeAntiFishEye:
+        return "Fish Eye / Anti-Fish Eye";
+        case PostProcessingEffectMode::GaussianBlur:
+        return "Gaussian Blur";
+        case PostProcessingEffectMode::Blur:
+        return "Blur";
+        case PostProcessingEffectMode::RadialBlur:
+        return "Radial Blur";
+        case PostProcessingEffectMode::MotionBlur:
+        return "Motion Blur";
+        case PostProcessingEffectMode::Vignetting:
+            return "Vignetting";
+        case PostProcessingEffectMode::BrightParts:
+            return "Bright Parts";
+        case PostProcessingEffectMode::Bloom:
+            return "Bloom";
+        case PostProcessingEffectMode::HDRToneMapping:
+            return "HDR Tone Mapping";
+        case PostProcessingEffectMode::LensFlare:
+            return "Lens Flare";
+        case PostProcessingEffectMode::SSAO:
+            return "Screen Space Ambient Occlusion";
+        case PostProcessingEffectMode::FXAA:
+            return "Fast Approximate Anti-Aliasing (FXAA)";
+        case PostProcessingEffectMode::DepthTesting:
+            return "Depth Testing";
+        case PostProcessingEffectMode::DepthMapping:
+            return "Depth Mapping";
+        case PostProcessingEffectMode::DirectionalShadowMapping:
+            return "Directional Shadow Mapping";
+        case PostProcessingEffectMode::OmnidirectionalShadowMapping:
+            return "Omnidirectional Shadow Mapping";
+        case PostProcessingEffectMode::DeferredRendering:
+            return "Deferred Rendering";
+        case PostProcessingEffectMode::RainDrops:
+            return "Rain Drops";
+        case PostProcessingEffectMode::PaletteQuantizationAndDithering:
+            return "Palette Quantization And Dithering";
+        case PostProcessingEffectMode::DistortedTV:
+            return "Distorted TV";
+        case PostProcessingEffectMode::RGBDisplay:
+            return "RGB Display";
+        case PostProcessingEffectMode::RetroParallax:
+            return "Retro Parallax";
+        case PostProcessingEffectMode::MoneyFilter:
+            return "Money Filter";
+        case PostProcessingEffectMode::MicroprismMosaic:
+            return "Microprism Mosaic";
+        case PostProcessingEffectMode::BayerMatrixDithering:
+            return "Bayer Matrix Dithering";
+        case PostProcessingEffectMode::JuliaFreak:
+            return "Julia Freak";
+        case PostProcessingEffectMode::HeartBlend:
+            return "Heart Blend";
+        case PostProcessingEffectMode::EMInterference:
+            return "EM Interference";
+        case PostProcessingEffectMode::CubicLensDistortion:
+            return "Cubic Lens Distortion";
+        case PostProcessingEffectMode::CelShaderish:
+            return "Cel Shaderish";
+        case PostProcessingEffectMode::CartoonVideo:
+            return "Cartoon Video";
+        default: return "";
+    }
+}
 
 #endif /* PostProcessingEffectMode_h */
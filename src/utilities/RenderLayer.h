@@ -0,0 +1,22 @@
+//
+//  RenderLayer.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef RenderLayer_h
+#define RenderLayer_h
+
+// the most significant field of a render queue key, every layer is drawn after the one before it,
+// opaque draws are ordered by state and transparent ones back to front
+enum class RenderLayer {
+    Opaque,
+    Transparent,
+    NumberOfLayers
+};
+
+#endif /* RenderLayer_h */
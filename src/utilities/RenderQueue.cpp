@@ -0,0 +1,142 @@
+//
+//  RenderQueue.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "RenderQueue.h"
+
+/*   http://realtimecollisiondetection.net/blog/?p=86
+ Every draw is one integer whose bit order is the draw order, so sorting the draws is sorting integers.
+ The radix sort takes the keys 8 bits at a time from the least significant end, each pass is a stable counting
+ sort, so after the last one the keys are in order and draws with equal keys keep the order they were pushed in.
+ A pass where every key has the same digit would not move anything and is skipped.
+ */
+
+#define DEPTH_BITS 26
+#define PROGRAM_BITS 10
+#define MATERIAL_BITS 12
+#define MESH_BITS 12
+#define LAYER_SHIFT 60
+
+static GLuint64 Field(const GLuint &value, const GLuint &bits)
+{
+    return static_cast<GLuint64>(value) & ((1ull << bits) - 1);
+}
+
+CRenderQueue::CRenderQueue()
+{
+    m_uiProgramChanges = 0;
+    m_uiMaterialChanges = 0;
+    m_uiMeshChanges = 0;
+    m_uiFrameProgramChanges = 0;
+    m_uiFrameMaterialChanges = 0;
+    m_uiFrameMeshChanges = 0;
+}
+
+GLuint64 CRenderQueue::QuantiseDepth(const GLfloat &depth)
+{
+    // in double, a float rounds the largest depth up to 1 << DEPTH_BITS and it would spill into the next field
+    const GLdouble maxDepth = static_cast<GLdouble>((1u << DEPTH_BITS) - 1);
+    return static_cast<GLuint64>(static_cast<GLdouble>(glm::clamp(depth, 0.0f, 1.0f)) * maxDepth);
+}
+
+GLuint64 CRenderQueue::OpaqueKey(const GLuint &program, const GLuint &material, const GLuint &mesh, const GLfloat &depth)
+{
+    return (static_cast<GLuint64>(RenderLayer::Opaque) << LAYER_SHIFT)
+    | (Field(program, PROGRAM_BITS) << (MATERIAL_BITS + MESH_BITS + DEPTH_BITS))
+    | (Field(material, MATERIAL_BITS) << (MESH_BITS + DEPTH_BITS))
+    | (Field(mesh, MESH_BITS) << DEPTH_BITS)
+    | QuantiseDepth(depth);
+}
+
+GLuint64 CRenderQueue::TransparentKey(const GLfloat &depth, const GLuint &program, const GLuint &material, const GLuint &mesh)
+{
+    // the depth is flipped so the furthest draw has the smallest key
+    const GLuint64 farToNear = ((1ull << DEPTH_BITS) - 1) - QuantiseDepth(depth);
+    return (static_cast<GLuint64>(RenderLayer::Transparent) << LAYER_SHIFT)
+    | (farToNear << (PROGRAM_BITS + MATERIAL_BITS + MESH_BITS))
+    | (Field(program, PROGRAM_BITS) << (MATERIAL_BITS + MESH_BITS))
+    | (Field(material, MATERIAL_BITS) << MESH_BITS)
+    | Field(mesh, MESH_BITS);
+}
+
+RenderLayer CRenderQueue::GetLayer(const GLuint64 &key)
+{
+    return static_cast<RenderLayer>(key >> LAYER_SHIFT);
+}
+
+// below the program the layouts of the two layers only differ by the depth being at the bottom or at the top
+GLuint CRenderQueue::GetProgram(const GLuint64 &key)
+{
+    GLuint shift = GetLayer(key) == RenderLayer::Transparent ? 0 : DEPTH_BITS;
+    return static_cast<GLuint>(Field(static_cast<GLuint>(key >> (shift + MATERIAL_BITS + MESH_BITS)), PROGRAM_BITS));
+}
+
+GLuint CRenderQueue::GetMaterial(const GLuint64 &key)
+{
+    GLuint shift = GetLayer(key) == RenderLayer::Transparent ? 0 : DEPTH_BITS;
+    return static_cast<GLuint>(Field(static_cast<GLuint>(key >> (shift + MESH_BITS)), MATERIAL_BITS));
+}
+
+GLuint CRenderQueue::GetMesh(const GLuint64 &key)
+{
+    GLuint shift = GetLayer(key) == RenderLayer::Transparent ? 0 : DEPTH_BITS;
+    return static_cast<GLuint>(Field(static_cast<GLuint>(key >> shift), MESH_BITS));
+}
+
+GLuint CRenderQueue::GetProgramCount()
+{
+    return 1u << PROGRAM_BITS;
+}
+
+void CRenderQueue::Clear()
+{
+    m_entries.clear();
+}
+
+void CRenderQueue::Push(const GLuint64 &key, const GLuint &item)
+{
+    m_entries.push_back(Entry{key, item});
+}
+
+void CRenderQueue::Sort()
+{
+    const GLuint count = static_cast<GLuint>(m_entries.size());
+    m_scratch.resize(count);
+
+    for (GLuint shift = 0; shift < 64 && count > 1; shift += 8) {
+        GLuint offsets[256] = {0};
+        for (const Entry &entry : m_entries) offsets[(entry.key >> shift) & 0xFF]++;
+        if (offsets[(m_entries[0].key >> shift) & 0xFF] == count) continue;
+
+        GLuint offset = 0;
+        for (GLuint digit = 0; digit < 256; ++digit) {
+            GLuint n = offsets[digit];
+            offsets[digit] = offset;
+            offset += n;
+        }
+        for (const Entry &entry : m_entries) m_scratch[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+        m_entries.swap(m_scratch);
+    }
+
+    // the first draw binds everything, after it only what differs from the draw before
+    for (GLuint i = 0; i < count; ++i) {
+        const GLuint64 key = m_entries[i].key;
+        if (i == 0 || GetProgram(key) != GetProgram(m_entries[i - 1].key)) m_uiProgramChanges++;
+        if (i == 0 || GetMaterial(key) != GetMaterial(m_entries[i - 1].key)) m_uiMaterialChanges++;
+        if (i == 0 || GetMesh(key) != GetMesh(m_entries[i - 1].key)) m_uiMeshChanges++;
+    }
+}
+
+void CRenderQueue::BeginFrame()
+{
+    m_uiFrameProgramChanges = m_uiProgramChanges;
+    m_uiFrameMaterialChanges = m_uiMaterialChanges;
+    m_uiFrameMeshChanges = m_uiMeshChanges;
+    m_uiProgramChanges = 0;
+    m_uiMaterialChanges = 0;
+    m_uiMeshChanges = 0;
+}
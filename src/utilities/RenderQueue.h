@@ -0,0 +1,67 @@
+//
+//  RenderQueue.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef RenderQueue_h
+#define RenderQueue_h
+
+#include "../Common.h"
+#include "RenderLayer.h"
+
+// Draws are pushed as a 64 bit sort key and the item they draw, sorting the keys puts the draws in the order
+// they should be issued. The bits of a key, most significant first:
+//   opaque       layer 4 | program 10 | material 12 | mesh 12 | depth 26
+//   transparent  layer 4 | far to near depth 26 | program 10 | material 12 | mesh 12
+// so opaque draws that share a program, then a material, then a mesh end up next to each other and
+// transparent ones are drawn back to front. Depth is between 0 and 1, larger values are clamped.
+class CRenderQueue
+{
+public:
+    CRenderQueue();
+
+    static GLuint64 OpaqueKey(const GLuint &program, const GLuint &material, const GLuint &mesh, const GLfloat &depth);
+    static GLuint64 TransparentKey(const GLfloat &depth, const GLuint &program, const GLuint &material, const GLuint &mesh);
+
+    static RenderLayer GetLayer(const GLuint64 &key);
+    static GLuint GetProgram(const GLuint64 &key);
+    static GLuint GetMaterial(const GLuint64 &key);
+    static GLuint GetMesh(const GLuint64 &key);
+    // the number of program values a key holds, larger ones are cut to their low bits
+    static GLuint GetProgramCount();
+
+    void Clear();
+    void Push(const GLuint64 &key, const GLuint &item);
+    // stable radix sort on the keys, the state changes of the sorted order are added to the frame's counters
+    void Sort();
+
+    GLuint GetCount() const { return static_cast<GLuint>(m_entries.size()); }
+    GLuint64 GetKey(const GLuint &i) const { return m_entries[i].key; }
+    GLuint GetItem(const GLuint &i) const { return m_entries[i].item; }
+
+    // the counters now report the previous frame
+    void BeginFrame();
+    GLuint GetProgramChanges() const { return m_uiFrameProgramChanges; }
+    GLuint GetMaterialChanges() const { return m_uiFrameMaterialChanges; }
+    GLuint GetMeshChanges() const { return m_uiFrameMeshChanges; }
+
+private:
+    struct Entry {
+        GLuint64 key;
+        GLuint item;
+    };
+
+    static GLuint64 QuantiseDepth(const GLfloat &depth);
+
+    std::vector<Entry> m_entries;
+    std::vector<Entry> m_scratch;       // the other buffer of the radix passes
+    GLuint m_uiProgramChanges, m_uiMaterialChanges, m_uiMeshChanges;
+    GLuint m_uiFrameProgramChanges, m_uiFrameMaterialChanges, m_uiFrameMeshChanges;
+};
+
+#endif /* RenderQueue_h */
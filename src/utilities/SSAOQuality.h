@@ -0,0 +1,58 @@
+//
+//  SSAOQuality.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef SSAOQuality_h
+#define SSAOQuality_h
+
+// quality tiers of the ssao effect, cheaper tiers render the occlusion at a fraction of the window size,
+// the temporal ones take a part of the kernel each frame and accumulate it over the frames before
+enum class SSAOQuality {
+    Full,
+    Half,
+    HalfTemporal,
+    QuarterTemporal,
+    NumberOfTiers
+};
+
+inline const char * SSAOQualityToString(const SSAOQuality &quality) {
+    switch (quality) {
+        case SSAOQuality::Full: return "Full";
+        case SSAOQuality::Half: return "Half";
+        case SSAOQuality::HalfTemporal: return "Half Temporal";
+        case SSAOQuality::QuarterTemporal: return "Quarter Temporal";
+        default: return "";
+    }
+}
+
+// the occlusion is 1/2^level of the window size
+inline unsigned int SSAOQualityLevel(const SSAOQuality &quality) {
+    switch (quality) {
+        case SSAOQuality::Half:
+        case SSAOQuality::HalfTemporal: return 1;
+        case SSAOQuality::QuarterTemporal: return 2;
+        default: return 0;
+    }
+}
+
+// kernel samples taken each frame, out of the 64 in the kernel
+inline unsigned int SSAOQualitySamples(const SSAOQuality &quality) {
+    switch (quality) {
+        case SSAOQuality::Half: return 32;
+        case SSAOQuality::HalfTemporal: return 16;
+        case SSAOQuality::QuarterTemporal: return 8;
+        default: return 64;
+    }
+}
+
+inline bool SSAOQualityTemporal(const SSAOQuality &quality) {
+    return quality == SSAOQuality::HalfTemporal || quality == SSAOQuality::QuarterTemporal;
+}
+
+#endif /* SSAOQuality_h */
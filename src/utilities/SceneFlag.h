@@ -0,0 +1,26 @@
+//
+//  SceneFlag.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef SceneFlag_h
+#define SceneFlag_h
+
+// per object flags of the scene store, an object keeps a bitmask with bit (1 << flag) set for every flag it has
+enum class SceneFlag {
+    Visible,
+    Spin,           // turns around y with the scene's sphere rotation
+    Occluder,       // drawn into the occlusion buffer, the mesh must be solid
+    NumberOfFlags
+};
+
+inline unsigned int SceneFlagBit(const SceneFlag &flag) {
+    return 1u << static_cast<unsigned int>(flag);
+}
+
+#endif /* SceneFlag_h */
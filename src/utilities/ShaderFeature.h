@@ -0,0 +1,47 @@
+//
+//  ShaderFeature.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef ShaderFeature_h
+#define ShaderFeature_h
+
+// features compiled into shader program variants instead of being branched on per fragment,
+// the variant key is a bitmask with bit (1 << feature) set for every enabled feature
+enum class ShaderFeature {
+    DirectionalLight,
+    PointLight,
+    SpotLight,
+    SmoothSpot,
+    Blinn,
+    HDR,
+    Fog,
+    HeightMap,
+    NumberOfFeatures
+};
+
+inline unsigned int ShaderFeatureBit(const ShaderFeature &feature) {
+    return 1u << static_cast<unsigned int>(feature);
+}
+
+// define injected into the shader source when the feature is enabled
+inline const char * ShaderFeatureToDefine(const ShaderFeature &feature) {
+    switch (feature) {
+        case ShaderFeature::DirectionalLight: return "USE_DIRECTIONAL_LIGHT";
+        case ShaderFeature::PointLight: return "USE_POINT_LIGHT";
+        case ShaderFeature::SpotLight: return "USE_SPOT_LIGHT";
+        case ShaderFeature::SmoothSpot: return "USE_SMOOTH_SPOT";
+        case ShaderFeature::Blinn: return "USE_BLINN";
+        case ShaderFeature::HDR: return "USE_HDR";
+        case ShaderFeature::Fog: return "USE_FOG";
+        case ShaderFeature::HeightMap: return "USE_HEIGHT_MAP";
+        default: return "";
+    }
+}
+
+#endif /* ShaderFeature_h */
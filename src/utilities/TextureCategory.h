@@ -0,0 +1,24 @@
+//
+//  TextureCategory.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef TextureCategory_h
+#define TextureCategory_h
+
+// what a texture allocation is used for, residency usage is reported per category
+enum class TextureCategory {
+    Material,       // 2D image maps loaded from disk (albedo, normal, roughness...)
+    Generated,      // 2D textures created from memory (fonts, noise, kernels)
+    HDR,            // equirectangular hdr maps
+    Skybox,         // cubemaps loaded from disk
+    IBL,            // environment, irradiance, prefilter and brdf maps rendered at load time
+    NumberOfCategories
+};
+
+#endif /* TextureCategory_h */
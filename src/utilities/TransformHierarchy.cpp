@@ -0,0 +1,114 @@
+//
+//  TransformHierarchy.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "TransformHierarchy.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define TRANSFORM_HIERARCHY_SSE
+#endif
+
+/*   http://www.songho.ca/opengl/gl_anglestoaxes.html
+ Rx * Ry * Rz written out, so a local matrix costs three sines and cosines instead of three glm::rotate calls that
+ each build an axis angle matrix and multiply it in. The transpose of the inverse of a 3x3 matrix with columns
+ a, b and c has the columns b x c, c x a and a x b divided by the determinant dot(a, b x c).
+ */
+
+// parent * local, each column of the result is the columns of the parent weighted by a column of the local
+static void MultiplyMatrices(const glm::mat4 &parent, const glm::mat4 &local, glm::mat4 &result)
+{
+#ifdef TRANSFORM_HIERARCHY_SSE
+    const GLfloat *p = glm::value_ptr(parent);
+    const GLfloat *l = glm::value_ptr(local);
+    GLfloat *r = glm::value_ptr(result);
+    const __m128 p0 = _mm_loadu_ps(p);
+    const __m128 p1 = _mm_loadu_ps(p + 4);
+    const __m128 p2 = _mm_loadu_ps(p + 8);
+    const __m128 p3 = _mm_loadu_ps(p + 12);
+    for (GLuint c = 0; c < 4; ++c) {
+        const GLfloat *column = l + c * 4;
+        __m128 sum = _mm_add_ps(_mm_mul_ps(p0, _mm_set1_ps(column[0])), _mm_mul_ps(p1, _mm_set1_ps(column[1])));
+        sum = _mm_add_ps(sum, _mm_add_ps(_mm_mul_ps(p2, _mm_set1_ps(column[2])), _mm_mul_ps(p3, _mm_set1_ps(column[3]))));
+        _mm_storeu_ps(r + c * 4, sum);
+    }
+#else
+    result = parent * local;
+#endif
+}
+
+CTransformHierarchy::CTransformHierarchy()
+{
+}
+
+GLuint CTransformHierarchy::Add(const GLint &parent)
+{
+    m_parents.push_back(parent < static_cast<GLint>(m_parents.size()) ? parent : -1);
+    m_positions.push_back(glm::vec3(0.0f));
+    m_rotations.push_back(glm::vec3(0.0f));
+    m_scales.push_back(glm::vec3(1.0f));
+    m_dirty.push_back(1);
+    m_worlds.push_back(glm::mat4(1.0f));
+    m_normals.push_back(glm::mat3(1.0f));
+    return static_cast<GLuint>(m_parents.size() - 1);
+}
+
+void CTransformHierarchy::Clear()
+{
+    m_parents.clear();
+    m_positions.clear();
+    m_rotations.clear();
+    m_scales.clear();
+    m_dirty.clear();
+    m_worlds.clear();
+    m_normals.clear();
+}
+
+void CTransformHierarchy::SetLocal(const GLuint &node, const glm::vec3 &position, const glm::vec3 &rotation, const glm::vec3 &scale)
+{
+    if (m_positions[node] == position && m_rotations[node] == rotation && m_scales[node] == scale)
+        return;
+    m_positions[node] = position;
+    m_rotations[node] = rotation;
+    m_scales[node] = scale;
+    m_dirty[node] = 1;
+}
+
+GLuint CTransformHierarchy::Update()
+{
+    GLuint recomputed = 0;
+    for (GLuint i = 0; i < m_parents.size(); ++i) {
+        const GLint parent = m_parents[i];
+        if (!m_dirty[i] && (parent < 0 || !m_dirty[parent])) continue;
+        m_dirty[i] = 1;
+
+        const glm::vec3 angles = glm::radians(m_rotations[i]);
+        const GLfloat cx = cosf(angles.x), sx = sinf(angles.x);
+        const GLfloat cy = cosf(angles.y), sy = sinf(angles.y);
+        const GLfloat cz = cosf(angles.z), sz = sinf(angles.z);
+        const glm::vec3 &s = m_scales[i];
+        glm::mat4 local;
+        local[0] = glm::vec4(cy * cz, sx * sy * cz + cx * sz, sx * sz - cx * sy * cz, 0.0f) * s.x;
+        local[1] = glm::vec4(-cy * sz, cx * cz - sx * sy * sz, cx * sy * sz + sx * cz, 0.0f) * s.y;
+        local[2] = glm::vec4(sy, -sx * cy, cx * cy, 0.0f) * s.z;
+        local[3] = glm::vec4(m_positions[i], 1.0f);
+
+        if (parent < 0) m_worlds[i] = local;
+        else MultiplyMatrices(m_worlds[parent], local, m_worlds[i]);
+
+        const glm::vec3 a(m_worlds[i][0]), b(m_worlds[i][1]), c(m_worlds[i][2]);
+        const glm::vec3 bc = glm::cross(b, c);
+        const GLfloat determinant = glm::dot(a, bc);
+        const GLfloat inverse = determinant != 0.0f ? 1.0f / determinant : 0.0f;
+        m_normals[i] = glm::mat3(bc * inverse, glm::cross(c, a) * inverse, glm::cross(a, b) * inverse);
+        recomputed++;
+    }
+
+    // every child has seen the flags of its parent by now
+    std::fill(m_dirty.begin(), m_dirty.end(), 0);
+    return recomputed;
+}
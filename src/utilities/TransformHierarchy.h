@@ -0,0 +1,50 @@
+//
+//  TransformHierarchy.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef TransformHierarchy_h
+#define TransformHierarchy_h
+
+#include "../Common.h"
+
+// Position, rotation in degrees and scale of every node next to its world and normal matrices, each kept in
+// its own array. The local matrix is T * Rx * Ry * Rz * S like the Transform of the objects builds it, a child
+// is placed in its parent's space. Setting a node to the values it has already leaves it clean and Update only
+// recomputes the dirty nodes and the ones below them, in one pass over the arrays since parents come first.
+class CTransformHierarchy
+{
+public:
+    CTransformHierarchy();
+
+    // parent is a node added earlier or -1 for a root, returns the node
+    GLuint Add(const GLint &parent = -1);
+    void Clear();
+
+    // the node is only marked dirty when a value changed
+    void SetLocal(const GLuint &node, const glm::vec3 &position, const glm::vec3 &rotation, const glm::vec3 &scale);
+    // returns how many nodes were recomputed
+    GLuint Update();
+
+    const glm::mat4 &GetWorld(const GLuint &node) const { return m_worlds[node]; }
+    // transpose of the inverse of the upper 3x3 of the world matrix, for the normals
+    const glm::mat3 &GetNormal(const GLuint &node) const { return m_normals[node]; }
+    const std::vector<glm::mat4> &GetWorlds() const { return m_worlds; }
+    const std::vector<glm::mat3> &GetNormals() const { return m_normals; }
+    GLint GetParent(const GLuint &node) const { return m_parents[node]; }
+    GLuint GetSize() const { return static_cast<GLuint>(m_parents.size()); }
+
+private:
+    std::vector<GLint> m_parents;
+    std::vector<glm::vec3> m_positions, m_rotations, m_scales;
+    std::vector<GLubyte> m_dirty;       // set by SetLocal, also marks a node moved by Update for its children
+    std::vector<glm::mat4> m_worlds;
+    std::vector<glm::mat3> m_normals;
+};
+
+#endif /* TransformHierarchy_h */
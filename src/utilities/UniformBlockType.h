@@ -0,0 +1,32 @@
+//
+//  UniformBlockType.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef UniformBlockType_h
+#define UniformBlockType_h
+
+// per frame uniform blocks shared by all programs, the binding point is the enum value
+enum class UniformBlockType {
+    Camera,         // CameraBlock
+    Lights,         // LightsBlock
+    Shadow,         // ShadowBlock
+    NumberOfUniformBlocks
+};
+
+// block name as declared in the shaders
+inline const char * UniformBlockTypeToString(const UniformBlockType &type) {
+    switch (type) {
+        case UniformBlockType::Camera: return "CameraBlock";
+        case UniformBlockType::Lights: return "LightsBlock";
+        case UniformBlockType::Shadow: return "ShadowBlock";
+        default: return "";
+    }
+}
+
+#endif /* UniformBlockType_h */
@@ -0,0 +1,20 @@
+//
+//  VertexLayout.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef VertexLayout_h
+#define VertexLayout_h
+
+// the vertex formats of the geometry arena, each one has its own buffers and VAO
+enum class VertexLayout {
+    Standard,           // Vertex, position, texture, normal, tangent and bitangent at locations 0 to 4
+    NumberOfLayouts
+};
+
+#endif /* VertexLayout_h */
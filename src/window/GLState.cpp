@@ -0,0 +1,261 @@
+//
+//  GLState.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "GLState.h"
+
+// value no real call uses, the cached state is unknown
+static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+CGLState &CGLState::Instance()
+{
+    static CGLState instance;
+    return instance;
+}
+
+CGLState::CGLState()
+{
+    m_uiIssued = 0;
+    m_uiFiltered = 0;
+    m_uiFrameIssued = 0;
+    m_uiFrameFiltered = 0;
+    Invalidate();
+}
+
+void CGLState::Invalidate()
+{
+    m_uiProgram = UNKNOWN;
+    m_uiVertexArray = UNKNOWN;
+    m_uiActiveUnit = UNKNOWN;
+    for (GLuint i = 0; i < GL_STATE_TEXTURE_UNITS; ++i) {
+        m_units[i].target = UNKNOWN;
+        m_units[i].texture = UNKNOWN;
+        m_units[i].sampler = UNKNOWN;
+    }
+    m_uiDrawFramebuffer = UNKNOWN;
+    m_uiReadFramebuffer = UNKNOWN;
+    for (GLuint i = 0; i < 4; ++i) {
+        m_viewport[i] = -1;
+        m_blendFunc[i] = UNKNOWN;
+    }
+    m_capabilities.clear();
+    m_depthFunc = UNKNOWN;
+    m_bDepthMask = 0xFF;
+    m_cullFace = UNKNOWN;
+}
+
+GLboolean CGLState::Changed(GLboolean changed)
+{
+    if (changed) m_uiIssued++;
+    else m_uiFiltered++;
+    return changed;
+}
+
+void CGLState::UseProgram(GLuint program)
+{
+    if (!Changed(m_uiProgram != program)) return;
+    m_uiProgram = program;
+    glUseProgram(program);
+}
+
+GLboolean CGLState::IsProgramInUse(GLuint program) const
+{
+    return m_uiProgram == program;
+}
+
+void CGLState::BindVertexArray(GLuint vao)
+{
+    if (!Changed(m_uiVertexArray != vao)) return;
+    m_uiVertexArray = vao;
+    glBindVertexArray(vao);
+}
+
+void CGLState::ActiveTexture(GLuint unit)
+{
+    if (!Changed(m_uiActiveUnit != unit)) return;
+    m_uiActiveUnit = unit;
+    glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void CGLState::BindTexture(GLenum target, GLuint texture)
+{
+    if (m_uiActiveUnit >= GL_STATE_TEXTURE_UNITS) {
+        Changed(true);
+        glBindTexture(target, texture);
+        return;
+    }
+    BindTexture(m_uiActiveUnit, target, texture);
+}
+
+// a unit keeps one binding per target, only the last one bound is remembered so a bind
+// is dropped only when it repeats the latest target and texture of that unit
+void CGLState::BindTexture(GLuint unit, GLenum target, GLuint texture)
+{
+    if (unit >= GL_STATE_TEXTURE_UNITS) {
+        ActiveTexture(unit);
+        Changed(true);
+        glBindTexture(target, texture);
+        return;
+    }
+
+    TextureUnit &textureUnit = m_units[unit];
+    if (!Changed(textureUnit.target != target || textureUnit.texture != texture)) return;
+    if (m_uiActiveUnit != unit) ActiveTexture(unit);
+    textureUnit.target = target;
+    textureUnit.texture = texture;
+    glBindTexture(target, texture);
+}
+
+void CGLState::BindSampler(GLuint unit, GLuint sampler)
+{
+    if (unit < GL_STATE_TEXTURE_UNITS) {
+        if (!Changed(m_units[unit].sampler != sampler)) return;
+        m_units[unit].sampler = sampler;
+    } else {
+        Changed(true);
+    }
+    glBindSampler(unit, sampler);
+}
+
+void CGLState::BindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    GLboolean draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+    GLboolean read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+    if (!Changed((draw && m_uiDrawFramebuffer != framebuffer) || (read && m_uiReadFramebuffer != framebuffer))) return;
+    if (draw) m_uiDrawFramebuffer = framebuffer;
+    if (read) m_uiReadFramebuffer = framebuffer;
+    glBindFramebuffer(target, framebuffer);
+}
+
+void CGLState::Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    if (!Changed(m_viewport[0] != x || m_viewport[1] != y || m_viewport[2] != width || m_viewport[3] != height)) return;
+    m_viewport[0] = x;
+    m_viewport[1] = y;
+    m_viewport[2] = width;
+    m_viewport[3] = height;
+    glViewport(x, y, width, height);
+}
+
+void CGLState::SetCapability(GLenum capability, GLboolean enabled)
+{
+    auto it = m_capabilities.find(capability);
+    if (!Changed(it == m_capabilities.end() || it->second != enabled)) return;
+    m_capabilities[capability] = enabled;
+    if (enabled) glEnable(capability);
+    else glDisable(capability);
+}
+
+void CGLState::Enable(GLenum capability)
+{
+    SetCapability(capability, GL_TRUE);
+}
+
+void CGLState::Disable(GLenum capability)
+{
+    SetCapability(capability, GL_FALSE);
+}
+
+void CGLState::DepthFunc(GLenum func)
+{
+    if (!Changed(m_depthFunc != func)) return;
+    m_depthFunc = func;
+    glDepthFunc(func);
+}
+
+void CGLState::DepthMask(GLboolean flag)
+{
+    if (!Changed(m_bDepthMask != flag)) return;
+    m_bDepthMask = flag;
+    glDepthMask(flag);
+}
+
+void CGLState::CullFace(GLenum mode)
+{
+    if (!Changed(m_cullFace != mode)) return;
+    m_cullFace = mode;
+    glCullFace(mode);
+}
+
+void CGLState::BlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    if (!Changed(m_blendFunc[0] != sfactor || m_blendFunc[1] != dfactor || m_blendFunc[2] != sfactor || m_blendFunc[3] != dfactor)) return;
+    m_blendFunc[0] = m_blendFunc[2] = sfactor;
+    m_blendFunc[1] = m_blendFunc[3] = dfactor;
+    glBlendFunc(sfactor, dfactor);
+}
+
+void CGLState::BlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+{
+    if (!Changed(m_blendFunc[0] != srcRGB || m_blendFunc[1] != dstRGB || m_blendFunc[2] != srcAlpha || m_blendFunc[3] != dstAlpha)) return;
+    m_blendFunc[0] = srcRGB;
+    m_blendFunc[1] = dstRGB;
+    m_blendFunc[2] = srcAlpha;
+    m_blendFunc[3] = dstAlpha;
+    glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
+void CGLState::DeleteProgram(GLuint program)
+{
+    if (m_uiProgram == program) m_uiProgram = UNKNOWN;
+    glDeleteProgram(program);
+}
+
+void CGLState::DeleteVertexArrays(GLsizei n, const GLuint *vaos)
+{
+    for (GLsizei i = 0; i < n; ++i) {
+        if (m_uiVertexArray == vaos[i]) m_uiVertexArray = 0;
+    }
+    glDeleteVertexArrays(n, vaos);
+}
+
+void CGLState::DeleteTextures(GLsizei n, const GLuint *textures)
+{
+    for (GLsizei i = 0; i < n; ++i) {
+        for (GLuint j = 0; j < GL_STATE_TEXTURE_UNITS; ++j) {
+            if (m_units[j].texture == textures[i]) m_units[j].texture = 0;
+        }
+    }
+    glDeleteTextures(n, textures);
+}
+
+void CGLState::DeleteSamplers(GLsizei n, const GLuint *samplers)
+{
+    for (GLsizei i = 0; i < n; ++i) {
+        for (GLuint j = 0; j < GL_STATE_TEXTURE_UNITS; ++j) {
+            if (m_units[j].sampler == samplers[i]) m_units[j].sampler = 0;
+        }
+    }
+    glDeleteSamplers(n, samplers);
+}
+
+void CGLState::DeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+    for (GLsizei i = 0; i < n; ++i) {
+        if (m_uiDrawFramebuffer == framebuffers[i]) m_uiDrawFramebuffer = 0;
+        if (m_uiReadFramebuffer == framebuffers[i]) m_uiReadFramebuffer = 0;
+    }
+    glDeleteFramebuffers(n, framebuffers);
+}
+
+void CGLState::BeginFrame()
+{
+    m_uiFrameIssued = m_uiIssued;
+    m_uiFrameFiltered = m_uiFiltered;
+    m_uiIssued = 0;
+    m_uiFiltered = 0;
+}
+
+GLuint CGLState::GetIssued() const
+{
+    return m_uiFrameIssued;
+}
+
+GLuint CGLState::GetFiltered() const
+{
+    return m_uiFrameFiltered;
+}
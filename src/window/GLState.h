@@ -0,0 +1,93 @@
+//
+//  GLState.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef GLState_h
+#define GLState_h
+
+#include "../WindowBase.h"
+#include <unordered_map>
+
+#define GL_STATE_TEXTURE_UNITS 32
+
+// Shadows the program, vertex array, texture, sampler and framebuffer bindings, the viewport and the
+// fixed function state below, so calls that would not change anything are dropped before they reach
+// the driver. Buffer and image bindings are not shadowed and are made with GL directly.
+class CGLState
+{
+public:
+    static CGLState &Instance();
+
+    void UseProgram(GLuint program);
+    GLboolean IsProgramInUse(GLuint program) const;
+    void BindVertexArray(GLuint vao);
+    // binds on the active unit, used while creating textures
+    void BindTexture(GLenum target, GLuint texture);
+    void BindTexture(GLuint unit, GLenum target, GLuint texture);
+    void BindSampler(GLuint unit, GLuint sampler);
+    void ActiveTexture(GLuint unit);
+    // GL_FRAMEBUFFER sets both the draw and read binding
+    void BindFramebuffer(GLenum target, GLuint framebuffer);
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    void Enable(GLenum capability);
+    void Disable(GLenum capability);
+    void DepthFunc(GLenum func);
+    void DepthMask(GLboolean flag);
+    void CullFace(GLenum mode);
+    void BlendFunc(GLenum sfactor, GLenum dfactor);
+    void BlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+
+    // deleted objects are unbound by GL and their names can be handed out again
+    void DeleteProgram(GLuint program);
+    void DeleteVertexArrays(GLsizei n, const GLuint *vaos);
+    void DeleteTextures(GLsizei n, const GLuint *textures);
+    void DeleteSamplers(GLsizei n, const GLuint *samplers);
+    void DeleteFramebuffers(GLsizei n, const GLuint *framebuffers);
+
+    // forget everything, the next call of each kind is always issued
+    void Invalidate();
+
+    // called once per frame, the counters then report the frame that just finished
+    void BeginFrame();
+    GLuint GetIssued() const;
+    GLuint GetFiltered() const;
+
+private:
+    CGLState();
+    CGLState(const CGLState &) = delete;
+    CGLState &operator=(const CGLState &) = delete;
+
+    // true when the call must be issued, counts it either way
+    GLboolean Changed(GLboolean changed);
+    void SetCapability(GLenum capability, GLboolean enabled);
+
+    struct TextureUnit {
+        GLenum target;
+        GLuint texture;
+        GLuint sampler;
+    };
+
+    GLuint m_uiProgram;
+    GLuint m_uiVertexArray;
+    GLuint m_uiActiveUnit;
+    TextureUnit m_units[GL_STATE_TEXTURE_UNITS];
+    GLuint m_uiDrawFramebuffer, m_uiReadFramebuffer;
+    GLint m_viewport[4];
+    std::unordered_map<GLenum, GLboolean> m_capabilities;
+    GLenum m_depthFunc;
+    GLboolean m_bDepthMask;
+    GLenum m_cullFace;
+    GLenum m_blendFunc[4];
+
+    GLuint m_uiIssued, m_uiFiltered;
+    GLuint m_uiFrameIssued, m_uiFrameFiltered;
+};
+
+#endif /* GLState_h */
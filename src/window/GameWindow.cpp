@@ -1,4 +1,5 @@
 #include "GameWindow.h"
+#include "GLState.h"
 
 #define SIMPLE_OPENGL_CLASS_NAME "simple_openGL_class_name"
 
@@ -96,7 +97,7 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
     // make sure the viewport matches the new window dimensions; note that width and
     // height will be significantly larger than specified on retina displays.
-    glViewport(0, 0, width, height);
+    CGLState::Instance().Viewport(0, 0, width, height);
 }
 
 // Create the game window
@@ -273,14 +274,14 @@ void CGameWindow::SetViewport(){
 
     // returns the framebuffer size, not the window size.
     glfwGetFramebufferSize(m_window, &width, &height);
-    glViewport( 0, 0, width, height);
+    CGLState::Instance().Viewport( 0, 0, width, height);
 
 }
 
 //Get the Current framebuffer Size in pixels and Set the Viewport to it
 void CGameWindow::SetViewport(const int & width, const int & height){
 
-    glViewport( 0, 0, width, height);
+    CGLState::Instance().Viewport( 0, 0, width, height);
 }
 
 
@@ -317,8 +318,8 @@ void CGameWindow::PreRendering(){
      Once the default framebuffer has multisampled buffer attachments, all we need to do to enable multisampling is just call glEnable and we're done. Because the actual multisampling algorithms are implemented in the rasterizer in your OpenGL drivers there's not much else we need to do.
      
      */
-    glEnable(GL_MULTISAMPLE);
-    glEnable(GL_TEXTURE_2D);
+    CGLState::Instance().Enable(GL_MULTISAMPLE);
+    CGLState::Instance().Enable(GL_TEXTURE_2D);
     
     // https://www.ntu.edu.sg/home/ehchua/programming/opengl/CG_Examples.html
     glClearDepth(1.0f); // Set background depth to farthest
@@ -327,13 +328,13 @@ void CGameWindow::PreRendering(){
     //https://learnopengl.com/#!Advanced-OpenGL/Depth-testing
     // Depth testing is done in screen space after the fragment shader has run (and after stencil testing has run). The screen space coordinates relate directly to the viewport defined by OpenGL's glViewport function and can be accessed via GLSL's built-in gl_FragCoord variable in the fragment shader. The x and y components of gl_FragCoord represent the fragment's screen-space coordinates (with (0,0) being the bottom-left corner). The gl_FragCoord also contains a z-component which contains the actual depth value of the fragment. This z value is the value that is compared to the depth buffer's content.
     // Depth testing is disabled by default so to enable depth testing we need to enable it with the GL_DEPTH_TEST option:
-    glEnable(GL_DEPTH_TEST); // enable depth-testing, only draw fragments with a depth value of 1.
+    CGLState::Instance().Enable(GL_DEPTH_TEST); // enable depth-testing, only draw fragments with a depth value of 1.
     //GL_DEPTH_TEST is to be enabled to avoid ugly artifacts that depend on the angle of view and drawing order (otherwise ie. if back of the cube is drawn last, if will appear "above" the front of the cube).
     //So yes, both GL_CULL_FACE and GL_DEPTH_TEST should be enabled.
     
     //OpenGL allows us to disable writing to the depth buffer by setting its depth mask to GL_FALSE: glDepthMask(GL_FALSE).
     // Note that this only has effect if depth testing is enabled.
-    glDepthMask(GL_FALSE);
+    CGLState::Instance().DepthMask(GL_FALSE);
         
     //OpenGL allows us to modify the comparison operators it uses for the depth test. This allows us to control when OpenGL should pass or discard fragments and when to update the depth buffer. We can set the comparison operator (or depth function) by calling glDepthFunc:
     
@@ -343,7 +344,7 @@ void CGameWindow::PreRendering(){
      glDepthFunc(GL_LEQUAL);
      */
     
-    glDepthFunc(GL_LESS); // depth-testing interprets a smaller value as "closer"
+    CGLState::Instance().DepthFunc(GL_LESS); // depth-testing interprets a smaller value as "closer"
     //The function accepts several comparison operators that are listed in the table below:
     /*
      Function    Description
@@ -383,7 +384,7 @@ void CGameWindow::PreRendering(){
     
     // https://learnopengl.com/#!Advanced-OpenGL/Stencil-testing
     // You can enable stencil testing by enabling GL_STENCIL_TEST. From that point on, all rendering calls will influence the stencil buffer in one way or another
-    glEnable(GL_STENCIL_TEST);
+    CGLState::Instance().Enable(GL_STENCIL_TEST);
     
     /*
      Also, just like the depth testing's glDepthMask function, there is an equivalent function for the stencil buffer. The function glStencilMask allows us to set a bitmask that is ANDed with the stencil value about to be written to the buffer. By default this is set to a bitmask of all 1s unaffecting the output, but if we were to set this to 0x00 all the stencil values written to the buffer end up as 0s. This is equivalent to depth testing's glDepthMask(GL_FALSE):
@@ -452,7 +453,7 @@ void CGameWindow::PreRendering(){
     // https://learnopengl.com/#!Advanced-OpenGL/Blending
     //If you want blending to occur after the texture has been applied, then use the OpenGL blending feature. Use this: glEnable (GL_BLEND);
     // To render images with different levels of transparency we have to enable blending. Like most of OpenGL's functionality we can enable blending by enabling GL_BLEND:
-    glEnable (GL_BLEND);
+    CGLState::Instance().Enable(GL_BLEND);
     
     /*
      Blending in OpenGL is done with the following equation:
@@ -487,10 +488,10 @@ void CGameWindow::PreRendering(){
      
      */
     // To get the blending result we have to take the alpha of the source color vector for the source factor and 1−alpha for the destination factor. This translates to the glBlendFunc as follows:
-    glBlendFunc (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    CGLState::Instance().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // It is also possible to set different options for the RGB and alpha channel individually using glBlendFuncSeparate:
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);  // This function sets the RGB components as we've set them previously, but only lets the resulting alpha component be influenced by the source's alpha value.
+    CGLState::Instance().BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);  // This function sets the RGB components as we've set them previously, but only lets the resulting alpha component be influenced by the source's alpha value.
     
     
     /*
@@ -535,7 +536,7 @@ void CGameWindow::PreRendering(){
     // Now that we know how to set the winding order of the vertices we can start using OpenGL's face culling option which is disabled by default.
     // To enable face culling we only have to enable OpenGL's GL_CULL_FACE option:
     
-    glEnable(GL_CULL_FACE);//only front facing poligons are rendered, for faces having a clock wise or counter clock wise order
+    CGLState::Instance().Enable(GL_CULL_FACE);//only front facing poligons are rendered, for faces having a clock wise or counter clock wise order
     // GL_CULL_FACE is to be enabled for performance reasons, as it easily removes half of the triangles to draw, normally without visual artifacts if your geometry is watertight, and CCW.
     
     // OpenGL allows us to change the type of face we want to cull as well. What if we want to cull front faces and not the back faces? We can define this behavior by calling glCullFace:
@@ -553,14 +554,14 @@ void CGameWindow::PreRendering(){
      
      */
     // The initial default value of glCullFace is GL_BACK.
-    glCullFace(GL_BACK);
+    CGLState::Instance().CullFace(GL_BACK);
     
     // Aside from the faces to cull we can also tell OpenGL we'd rather prefer clockwise faces as the front-faces instead of counter-clockwise faces via glFrontFace:
     glFrontFace(GL_CCW); // this allow us to render in counter clockwise maner, by default opengl renders in this counter colockwise manner.
     // The default value is GL_CCW that stands for counter-clockwise ordering with the other option being GL_CW which (obviously) stands for clockwise ordering.
     
     // enable seamless cubemap sampling for lower mip levels in the pre-filter map.
-    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+    CGLState::Instance().Enable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
     
 }
 
@@ -581,8 +582,8 @@ void CGameWindow::ClearBuffers(const ClearBuffersType &bufferType){
         glClearDepth(1.0f); // same as glClear, we are simply specificaly clearing the depthbuffer
         
         // enable depth testing (is disabled for rendering screen-space quad post processing)
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_STENCIL_TEST);
+        CGLState::Instance().Enable(GL_DEPTH_TEST);
+        CGLState::Instance().Enable(GL_STENCIL_TEST);
         
         // comment out if stencil buffer is not used
         // glStencilMask(0xFF); // each bit is written to the stencil buffer as is
@@ -594,14 +595,14 @@ void CGameWindow::ClearBuffers(const ClearBuffersType &bufferType){
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); ////<-- CLEAR WINDOW
         glClearDepth(1.0f); // same as glClear, we are simply specificaly clearing the depthbuffer
         
-        glEnable(GL_DEPTH_TEST);
+        CGLState::Instance().Enable(GL_DEPTH_TEST);
         break;
     case ClearBuffersType::COLORSTENCIL:
         glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT); ////<-- CLEAR WINDOW
         break;
     case ClearBuffersType::DEPTH:
         glClear(GL_DEPTH_BUFFER_BIT); ////<-- CLEAR WINDOW
-        glEnable(GL_DEPTH_TEST);
+        CGLState::Instance().Enable(GL_DEPTH_TEST);
         break;
     }
 }
@@ -612,6 +613,19 @@ void CGameWindow::SwapBuffers(){
     glfwSwapBuffers(m_window);
 }
 
+// a hidden window whose context shares objects with the game window
+GLFWwindow * CGameWindow::CreateSharedContext(){
+    // the other hints are still the ones the game window was created with
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow * window = glfwCreateWindow(1, 1, m_appName.c_str(), nullptr, m_window);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    
+    if (window == nullptr) {
+        fprintf(stderr, "WARNING: could not create a shared context, shaders are built on the main thread\n");
+    }
+    return window;
+}
+
 //Destroy the window, // Deinitialise the window and rendering context
 void CGameWindow::DestroyWindow(){
     glfwMakeContextCurrent(nullptr);
@@ -21,6 +21,8 @@ public:
     int GetWidth() const { return m_width; }
     int GetHeight()  const { return m_height; }
     GLFWwindow * GetWindow() const { return m_window; }
+    // in pixels, larger than the window size on high dpi screens
+    void GetFramebufferSize(int &width, int &height) const { glfwGetFramebufferSize(m_window, &width, &height); }
     
     bool Fullscreen() const { return m_fullscreen; }
     float Ratio() { return (float)m_width / m_height;}
@@ -40,6 +42,8 @@ public:
     void ClearBuffers(const ClearBuffersType &bufferType = ClearBuffersType::COLORDEPTH);
     void SwapBuffers();
     void DestroyWindow();
+    // hidden window whose context shares objects with this one, nullptr when it cannot be made
+    GLFWwindow * CreateSharedContext();
     
     
 private:
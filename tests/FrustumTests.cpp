@@ -0,0 +1,161 @@
+//
+//  FrustumTests.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "Tests.h"
+#include "camera/Camera.h"
+#include "culling/FrustumCuller.h"
+#include <random>
+#include <limits>
+
+// a camera at the origin looking down -z, 90 degrees wide and high, near 1 and far 100
+static void GetTestPlanes(glm::vec4 planes[6])
+{
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    CCamera::ExtractFrustumPlanes(projection * view, planes);
+}
+
+static GLfloat Distance(const glm::vec4 &plane, const glm::vec3 &point)
+{
+    return glm::dot(glm::vec3(plane), point) + plane.w;
+}
+
+static bool IsNear(const glm::vec3 &a, const glm::vec3 &b, const GLfloat &epsilon)
+{
+    return glm::all(glm::lessThanEqual(glm::abs(a - b), glm::vec3(epsilon)));
+}
+
+// the planes of a known frustum face inwards, are unit length and put the points of its sides where they belong
+static void TestPlaneExtraction()
+{
+    glm::vec4 planes[6];
+    GetTestPlanes(planes);
+
+    for (GLuint i = 0; i < 6; ++i) {
+        CHECK(std::abs(glm::length(glm::vec3(planes[i])) - 1.0f) < 1e-5f);
+        CHECK(Distance(planes[i], glm::vec3(0.0f, 0.0f, -50.0f)) > 0.0f);
+    }
+
+    // left, right, bottom, top, near, far, at 90 degrees a side is as far out as it is deep
+    CHECK(IsNear(glm::vec3(planes[0]), glm::normalize(glm::vec3(1.0f, 0.0f, -1.0f)), 1e-5f));
+    CHECK(IsNear(glm::vec3(planes[1]), glm::normalize(glm::vec3(-1.0f, 0.0f, -1.0f)), 1e-5f));
+    CHECK(IsNear(glm::vec3(planes[2]), glm::normalize(glm::vec3(0.0f, 1.0f, -1.0f)), 1e-5f));
+    CHECK(IsNear(glm::vec3(planes[3]), glm::normalize(glm::vec3(0.0f, -1.0f, -1.0f)), 1e-5f));
+    CHECK(IsNear(glm::vec3(planes[4]), glm::vec3(0.0f, 0.0f, -1.0f), 1e-5f));
+    CHECK(IsNear(glm::vec3(planes[5]), glm::vec3(0.0f, 0.0f, 1.0f), 1e-5f));
+
+    // the plane distances are in world units
+    CHECK(std::abs(Distance(planes[4], glm::vec3(0.0f, 0.0f, -3.0f)) - 2.0f) < 1e-4f);
+    CHECK(std::abs(Distance(planes[5], glm::vec3(0.0f, 0.0f, -90.0f)) - 10.0f) < 1e-3f);
+
+    // a point past each side is outside that plane only
+    const glm::vec3 outside[6] = {
+        glm::vec3(-20.0f, 0.0f, -10.0f), glm::vec3(20.0f, 0.0f, -10.0f),
+        glm::vec3(0.0f, -20.0f, -10.0f), glm::vec3(0.0f, 20.0f, -10.0f),
+        glm::vec3(0.0f, 0.0f, -0.5f), glm::vec3(0.0f, 0.0f, -150.0f),
+    };
+    for (GLuint i = 0; i < 6; ++i) {
+        for (GLuint p = 0; p < 6; ++p) {
+            CHECK((Distance(planes[p], outside[i]) < 0.0f) == (p == i));
+        }
+    }
+}
+
+// the four wide batch test agrees with the single box test, for a count that leaves a scalar tail
+static void TestBatch()
+{
+    glm::vec4 planes[6];
+    GetTestPlanes(planes);
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<GLfloat> position(-120.0f, 120.0f);
+    std::uniform_real_distribution<GLfloat> size(0.1f, 20.0f);
+
+    CFrustumCuller batch, single;
+    batch.SetPlanes(planes);
+    single.SetPlanes(planes);
+    batch.Clear();
+
+    const GLuint count = 1001;
+    std::vector<glm::vec3> mins, maxs;
+    for (GLuint i = 0; i < count; ++i) {
+        glm::vec3 min(position(random), position(random), position(random) - 100.0f);
+        glm::vec3 max = min + glm::vec3(size(random), size(random), size(random));
+        mins.push_back(min);
+        maxs.push_back(max);
+        CHECK(batch.AddBox(min, max) == i);
+    }
+    CHECK(batch.GetCount() == count);
+
+    const GLuint visible = batch.Cull();
+    GLuint singleVisible = 0;
+    GLuint mismatches = 0;
+    for (GLuint i = 0; i < count; ++i) {
+        const GLboolean inside = single.TestBox(mins[i], maxs[i]);
+        if (inside) singleVisible++;
+        if (inside != batch.IsVisible(i)) mismatches++;
+    }
+    CHECK(mismatches == 0);
+    CHECK(visible == singleVisible);
+    CHECK(visible > 0 && visible < count);
+
+    // both count every box once, the counters report the frame after BeginFrame
+    batch.BeginFrame();
+    single.BeginFrame();
+    CHECK(batch.GetVisible() == visible && batch.GetCulled() == count - visible);
+    CHECK(single.GetVisible() == visible && single.GetCulled() == count - visible);
+    batch.BeginFrame();
+    CHECK(batch.GetVisible() == 0 && batch.GetCulled() == 0);
+
+    // a sphere is outside once its radius no longer reaches over the plane
+    batch.Clear();
+    batch.AddSphere(glm::vec3(0.0f, 0.0f, 5.0f), 3.0f);
+    batch.AddSphere(glm::vec3(0.0f, 0.0f, 5.0f), 7.0f);
+    batch.AddSphere(glm::vec3(0.0f, 0.0f, -50.0f), 1.0f);
+    batch.AddSphere(glm::vec3(0.0f, 0.0f, -150.0f), 10.0f);
+    batch.AddSphere(glm::vec3(0.0f, 0.0f, -150.0f), 60.0f);
+    CHECK(batch.Cull() == 3);
+    CHECK(!batch.IsVisible(0) && batch.IsVisible(1) && batch.IsVisible(2) && !batch.IsVisible(3) && batch.IsVisible(4));
+}
+
+// the box around a moved box is the one around its eight moved corners
+static void TestTransformBounds()
+{
+    const glm::vec3 min(-1.0f, -2.0f, -0.5f), max(3.0f, 1.0f, 2.0f);
+    const glm::mat4 models[] = {
+        glm::mat4(1.0f),
+        glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, -4.0f, 7.0f)),
+        glm::rotate(glm::mat4(1.0f), glm::radians(30.0f), glm::vec3(0.0f, 1.0f, 0.0f)),
+        glm::scale(glm::mat4(1.0f), glm::vec3(2.0f, 0.5f, 3.0f)),
+        glm::scale(glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(-5.0f, 20.0f, 1.0f)),
+                               glm::radians(75.0f), glm::normalize(glm::vec3(1.0f, 2.0f, -1.0f))),
+                   glm::vec3(1.5f, -2.0f, 0.25f)),
+    };
+
+    for (const glm::mat4 &model : models) {
+        glm::vec3 cornerMin(std::numeric_limits<GLfloat>::max()), cornerMax(-std::numeric_limits<GLfloat>::max());
+        for (GLuint corner = 0; corner < 8; ++corner) {
+            glm::vec3 local((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+            glm::vec3 world = glm::vec3(model * glm::vec4(local, 1.0f));
+            cornerMin = glm::min(cornerMin, world);
+            cornerMax = glm::max(cornerMax, world);
+        }
+
+        glm::vec3 worldMin, worldMax;
+        CFrustumCuller::TransformBounds(model, min, max, worldMin, worldMax);
+        CHECK(IsNear(worldMin, cornerMin, 1e-4f));
+        CHECK(IsNear(worldMax, cornerMax, 1e-4f));
+    }
+}
+
+void FrustumTests()
+{
+    TestPlaneExtraction();
+    TestBatch();
+    TestTransformBounds();
+}
@@ -0,0 +1,151 @@
+//
+//  OcclusionTests.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "Tests.h"
+#include "culling/OcclusionCuller.h"
+
+// a camera at the origin looking down -z with the aspect of the buffer, 90 degrees high, near 1 and far 100
+static glm::mat4 GetTestViewProjection()
+{
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), static_cast<GLfloat>(OCCLUSION_WIDTH) / OCCLUSION_HEIGHT, 1.0f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+// a 10 by 10 wall 10 in front of the camera, facing it. On the 256 by 128 buffer it covers the pixels
+// 96 to 159 across and 32 to 95 up
+static std::vector<glm::vec3> GetWall(const GLboolean &facing = true)
+{
+    const glm::vec3 a(-5.0f, -5.0f, -10.0f), b(5.0f, -5.0f, -10.0f), c(5.0f, 5.0f, -10.0f), d(-5.0f, 5.0f, -10.0f);
+    if (facing) return {a, b, c, a, c, d};
+    return {a, c, b, a, d, c};
+}
+
+static GLfloat GetWallDepth()
+{
+    glm::vec4 clip = GetTestViewProjection() * glm::vec4(0.0f, 0.0f, -10.0f, 1.0f);
+    return clip.z / clip.w * 0.5f + 0.5f;
+}
+
+// the wall fills the pixels it covers with its depth and leaves the rest empty, the same with any number of bands
+static void TestRasterizer()
+{
+    COcclusionCuller culler(OCCLUSION_WIDTH, OCCLUSION_HEIGHT, 1);
+    culler.Begin(GetTestViewProjection());
+    culler.AddOccluder(GetWall(), glm::mat4(1.0f));
+    culler.Rasterize();
+
+    const GLfloat depth = GetWallDepth();
+    GLuint covered = 0;
+    for (GLuint y = 0; y < culler.GetHeight(); ++y) {
+        for (GLuint x = 0; x < culler.GetWidth(); ++x) {
+            const GLboolean inside = x >= 96 && x <= 159 && y >= 32 && y <= 95;
+            const GLfloat z = culler.GetDepth(x, y);
+            if (inside && std::abs(z - depth) < 1e-5f) covered++;
+            if (!inside) CHECK(z == 1.0f);
+        }
+    }
+    CHECK(covered == 64 * 64);
+
+    // the bands of several threads fill the same buffer as one
+    COcclusionCuller banded(OCCLUSION_WIDTH, OCCLUSION_HEIGHT, 4);
+    banded.Begin(GetTestViewProjection());
+    banded.AddOccluder(GetWall(), glm::mat4(1.0f));
+    banded.Rasterize();
+    GLuint differences = 0;
+    for (GLuint y = 0; y < culler.GetHeight(); ++y)
+        for (GLuint x = 0; x < culler.GetWidth(); ++x)
+            if (banded.GetDepth(x, y) != culler.GetDepth(x, y)) differences++;
+    CHECK(differences == 0);
+
+    // the nearer of two occluders is kept, moved by its model matrix
+    culler.Begin(GetTestViewProjection());
+    culler.AddOccluder(GetWall(), glm::mat4(1.0f));
+    culler.AddOccluder(GetWall(), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 5.0f)));
+    culler.Rasterize();
+    CHECK(culler.GetDepth(128, 64) < depth);
+
+    // a wall facing away is not drawn, and neither is one behind the eye
+    culler.Begin(GetTestViewProjection());
+    culler.AddOccluder(GetWall(false), glm::mat4(1.0f));
+    culler.AddOccluder(GetWall(), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 20.0f)));
+    culler.Rasterize();
+    CHECK(culler.GetDepth(128, 64) == 1.0f);
+
+    // the counter reports the triangles drawn in the last frame, the dropped ones are not counted
+    culler.BeginFrame();
+    CHECK(culler.GetTriangles() == 6);
+}
+
+// each texel of a level keeps the furthest depth of the 2x2 block below it, down to a single texel
+static void TestPyramid()
+{
+    COcclusionCuller culler(OCCLUSION_WIDTH, OCCLUSION_HEIGHT, 1);
+    culler.Begin(GetTestViewProjection());
+    culler.AddOccluder(GetWall(), glm::mat4(1.0f));
+    culler.AddOccluder(GetWall(), glm::translate(glm::mat4(1.0f), glm::vec3(-3.0f, 1.0f, 4.0f)));
+    culler.Rasterize();
+
+    CHECK(culler.GetLevelCount() == 9);
+    GLuint mismatches = 0;
+    GLuint width = culler.GetWidth(), height = culler.GetHeight();
+    for (GLuint level = 1; level < culler.GetLevelCount(); ++level) {
+        const GLuint belowWidth = width, belowHeight = height;
+        width = std::max((width + 1) / 2, 1u);
+        height = std::max((height + 1) / 2, 1u);
+        for (GLuint y = 0; y < height; ++y) {
+            for (GLuint x = 0; x < width; ++x) {
+                GLfloat furthest = 0.0f;
+                for (GLuint by = y * 2; by <= std::min(y * 2 + 1, belowHeight - 1); ++by)
+                    for (GLuint bx = x * 2; bx <= std::min(x * 2 + 1, belowWidth - 1); ++bx)
+                        furthest = std::max(furthest, culler.GetDepth(bx, by, level - 1));
+                if (culler.GetDepth(x, y, level) != furthest) mismatches++;
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(width == 1 && height == 1);
+
+    // the walls leave most of the buffer empty, so the top is empty, while a block only the far wall covers,
+    // the pixels 152 to 159 across and 32 to 39 up, keeps its depth
+    CHECK(culler.GetDepth(0, 0, culler.GetLevelCount() - 1) == 1.0f);
+    CHECK(std::abs(culler.GetDepth(152 >> 3, 32 >> 3, 3) - GetWallDepth()) < 1e-5f);
+}
+
+// boxes behind the wall are hidden, the ones in front of it, beside it or bigger than it are not
+static void TestOccludees()
+{
+    COcclusionCuller culler(OCCLUSION_WIDTH, OCCLUSION_HEIGHT, 1);
+    culler.Begin(GetTestViewProjection());
+    culler.AddOccluder(GetWall(), glm::mat4(1.0f));
+    culler.Rasterize();
+
+    CHECK(!culler.IsVisible(glm::vec3(-2.0f, -2.0f, -20.0f), glm::vec3(2.0f, 2.0f, -15.0f)));
+    CHECK(!culler.IsVisible(glm::vec3(-0.5f, -0.5f, -60.0f), glm::vec3(0.5f, 0.5f, -59.0f)));
+    CHECK(culler.IsVisible(glm::vec3(-2.0f, -2.0f, -8.0f), glm::vec3(2.0f, 2.0f, -6.0f)));
+    CHECK(culler.IsVisible(glm::vec3(30.0f, -1.0f, -20.0f), glm::vec3(32.0f, 1.0f, -18.0f)));
+    CHECK(culler.IsVisible(glm::vec3(-20.0f, -2.0f, -30.0f), glm::vec3(20.0f, 2.0f, -25.0f)));
+    CHECK(culler.IsVisible(glm::vec3(-1.0f, -1.0f, -20.0f), glm::vec3(1.0f, 1.0f, 5.0f)));
+    CHECK(culler.IsVisible(glm::vec3(-1.0f, -1.0f, -12.0f), glm::vec3(1.0f, 1.0f, -8.0f)));
+
+    culler.BeginFrame();
+    CHECK(culler.GetTested() == 7);
+    CHECK(culler.GetOccluded() == 2);
+
+    // without occluders nothing is hidden
+    culler.Begin(GetTestViewProjection());
+    culler.Rasterize();
+    CHECK(culler.IsVisible(glm::vec3(-2.0f, -2.0f, -20.0f), glm::vec3(2.0f, 2.0f, -15.0f)));
+}
+
+void OcclusionTests()
+{
+    TestRasterizer();
+    TestPyramid();
+    TestOccludees();
+}
@@ -0,0 +1,157 @@
+//
+//  RangeAllocatorTests.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "Tests.h"
+#include "buffers/RangeAllocator.h"
+
+// ranges are handed out from the front, a range no single block can hold is refused and changes nothing
+static void TestAllocate()
+{
+    CRangeAllocator allocator(100);
+    CHECK(allocator.GetCapacity() == 100 && allocator.GetUsed() == 0 && allocator.GetFree() == 100);
+    CHECK(allocator.GetFreeBlockCount() == 1 && allocator.GetFragmentation() == 0.0f);
+
+    GLuint a, b, c;
+    CHECK(allocator.Allocate(10, a) && a == 0);
+    CHECK(allocator.Allocate(20, b) && b == 10);
+    CHECK(allocator.Allocate(30, c) && c == 30);
+    CHECK(allocator.GetUsed() == 60 && allocator.GetLargestFree() == 40);
+
+    // nothing to hand out
+    GLuint offset = 99;
+    CHECK(!allocator.Allocate(0, offset) && offset == 99);
+
+    // a hole before the end is taken first, the rest of it is left for the next range that fits
+    allocator.Free(b, 20);
+    CHECK(allocator.Allocate(15, offset) && offset == 10);
+    CHECK(allocator.Allocate(5, offset) && offset == 25);
+    CHECK(allocator.GetFreeBlockCount() == 1);
+
+    // the hole of 10 at the front is too small, the block at the end takes the range
+    allocator.Free(a, 10);
+    CHECK(allocator.GetFree() == 50 && allocator.GetLargestFree() == 40);
+    CHECK(allocator.Allocate(25, offset) && offset == 60);
+
+    // 25 are free in the hole of 10 and the 15 at the end, 20 fit in neither
+    CHECK(allocator.GetFree() == 25);
+    offset = 99;
+    CHECK(!allocator.Allocate(20, offset) && offset == 99);
+    CHECK(allocator.GetUsed() == 75 && allocator.GetFreeBlockCount() == 2);
+    CHECK(allocator.Allocate(15, offset) && offset == 85);
+    CHECK(allocator.Allocate(10, offset) && offset == 0);
+
+    // nothing is left
+    CHECK(allocator.GetFree() == 0 && allocator.GetFreeBlockCount() == 0 && allocator.GetFragmentation() == 0.0f);
+    CHECK(!allocator.Allocate(1, offset));
+}
+
+// a freed range joins the free block before it, after it, both or neither
+static void TestFree()
+{
+    // six ranges and 10 free at the end: [0 10) [10 30) [30 60) [60 70) [70 80) [80 90)
+    CRangeAllocator allocator(100);
+    const GLuint sizes[] = {10, 20, 30, 10, 10, 10};
+    GLuint offsets[6];
+    for (GLuint i = 0; i < 6; ++i) CHECK(allocator.Allocate(sizes[i], offsets[i]));
+    CHECK(allocator.GetFreeBlockCount() == 1 && allocator.GetFree() == 10);
+
+    // neither side is free
+    allocator.Free(offsets[1], sizes[1]);
+    CHECK(allocator.GetFreeBlockCount() == 2 && allocator.GetLargestFree() == 20);
+
+    // the block after it is free, at the front of the buffer there is no block before it
+    allocator.Free(offsets[0], sizes[0]);
+    CHECK(allocator.GetFreeBlockCount() == 2 && allocator.GetLargestFree() == 30);
+
+    // neither, between two live ranges
+    allocator.Free(offsets[3], sizes[3]);
+    CHECK(allocator.GetFreeBlockCount() == 3 && allocator.GetLargestFree() == 30);
+
+    // the block before it is free, the range after it is live
+    allocator.Free(offsets[4], sizes[4]);
+    CHECK(allocator.GetFreeBlockCount() == 3 && allocator.GetLargestFree() == 30);
+    CHECK(allocator.GetFree() == 60);
+
+    // free in 30, 20 and 10
+    CHECK(std::abs(allocator.GetFragmentation() - 0.5f) < 1e-6f);
+
+    // both sides are free
+    allocator.Free(offsets[2], sizes[2]);
+    CHECK(allocator.GetFreeBlockCount() == 2 && allocator.GetLargestFree() == 80);
+    allocator.Free(offsets[5], sizes[5]);
+    CHECK(allocator.GetFreeBlockCount() == 1 && allocator.GetUsed() == 0);
+    CHECK(allocator.GetFragmentation() == 0.0f);
+
+    // the merged block is the whole buffer again
+    GLuint offset;
+    CHECK(allocator.Allocate(100, offset) && offset == 0);
+
+    // an empty range changes nothing
+    allocator.Free(50, 0);
+    CHECK(allocator.GetUsed() == 100 && allocator.GetFreeBlockCount() == 0);
+}
+
+// growing extends a free block at the end or adds one after the last range
+static void TestGrow()
+{
+    CRangeAllocator empty;
+    CHECK(empty.GetCapacity() == 0 && empty.GetFreeBlockCount() == 0);
+    GLuint offset;
+    CHECK(!empty.Allocate(1, offset));
+    empty.Grow(0);
+    CHECK(empty.GetCapacity() == 0 && empty.GetFreeBlockCount() == 0);
+
+    // the free block at the end grows
+    CRangeAllocator allocator(100);
+    CHECK(allocator.Allocate(60, offset));
+    allocator.Grow(50);
+    CHECK(allocator.GetCapacity() == 150 && allocator.GetFreeBlockCount() == 1 && allocator.GetLargestFree() == 90);
+    CHECK(allocator.Allocate(90, offset) && offset == 60);
+
+    // a full buffer gets a new block
+    allocator.Grow(20);
+    CHECK(allocator.GetCapacity() == 170 && allocator.GetFreeBlockCount() == 1);
+    CHECK(allocator.Allocate(20, offset) && offset == 150);
+
+    // a hole in the middle is not the end, the new elements are a block of their own
+    allocator.Free(10, 20);
+    allocator.Grow(30);
+    CHECK(allocator.GetFreeBlockCount() == 2 && allocator.GetLargestFree() == 30);
+    CHECK(allocator.Allocate(30, offset) && offset == 170);
+}
+
+// after the ranges were packed to the front the rest of the buffer is one free block
+static void TestReset()
+{
+    CRangeAllocator allocator(100);
+    GLuint offsets[4];
+    for (GLuint i = 0; i < 4; ++i) CHECK(allocator.Allocate(20, offsets[i]));
+    allocator.Free(offsets[0], 20);
+    allocator.Free(offsets[2], 20);
+    CHECK(allocator.GetFreeBlockCount() == 3 && allocator.GetFragmentation() > 0.0f);
+
+    allocator.Reset(40);
+    CHECK(allocator.GetCapacity() == 100 && allocator.GetUsed() == 40);
+    CHECK(allocator.GetFreeBlockCount() == 1 && allocator.GetLargestFree() == 60 && allocator.GetFragmentation() == 0.0f);
+    GLuint offset;
+    CHECK(allocator.Allocate(60, offset) && offset == 40);
+
+    // everything used leaves no free block
+    allocator.Reset(100);
+    CHECK(allocator.GetFree() == 0 && allocator.GetFreeBlockCount() == 0 && allocator.GetFragmentation() == 0.0f);
+    allocator.Reset(0);
+    CHECK(allocator.GetFree() == 100 && allocator.GetFreeBlockCount() == 1);
+}
+
+void RangeAllocatorTests()
+{
+    TestAllocate();
+    TestFree();
+    TestGrow();
+    TestReset();
+}
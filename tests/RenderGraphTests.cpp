@@ -0,0 +1,283 @@
+//
+//  RenderGraphTests.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "Tests.h"
+#include "buffers/PostProcessingGraph.h"
+
+// the settings the game starts with, the stack empty
+static PostProcessingGraphSettings DefaultSettings()
+{
+    return PostProcessingGraphSettings{false, 6, SSAOQuality::Full, {}};
+}
+
+// declares an effect and keeps what every pass was declared with, in the order they were added
+static bool DeclareEffect(CRenderGraph &graph, const PostProcessingGraphSettings &settings, const PostProcessingEffectMode &mode,
+                          std::vector<PostProcessingPass> &passes)
+{
+    passes.clear();
+    CPostProcessingGraph declaration(graph, settings, [&passes](const PostProcessingPass &pass) {
+        passes.push_back(pass);
+        return std::function<void()>();
+    });
+    return declaration.Declare(mode);
+}
+
+// a chain of passes through three targets of one type, the first and the last share a slot once the first is read
+static void TestAliasing()
+{
+    CRenderGraph graph;
+    const GLuint scene = graph.Import("scene", FrameBufferType::Default);
+    const GLuint screen = graph.Import("screen", FrameBufferType::Default);
+    const GLuint a = graph.Create("a", FrameBufferType::HighDynamicRangeLighting);
+    const GLuint b = graph.Create("b", FrameBufferType::HighDynamicRangeLighting);
+    const GLuint c = graph.Create("c", FrameBufferType::HighDynamicRangeLighting);
+    const GLuint half = graph.Create("half", FrameBufferType::HighDynamicRangeLighting, 1);
+    const GLuint unused = graph.Create("unused", FrameBufferType::HighDynamicRangeLighting);
+
+    graph.AddPass("a", {scene}, {a}, nullptr);
+    graph.AddPass("b", {a}, {b}, nullptr);
+    graph.AddPass("unused", {b}, {unused}, nullptr);
+    graph.AddPass("c", {b}, {c}, nullptr);
+    graph.AddPass("half", {c}, {half}, nullptr);
+    graph.AddPass("present", {half}, {screen}, nullptr);
+
+    CHECK(graph.Compile(screen));
+    CHECK(graph.Validate());
+
+    // the pass nothing reads is culled and its target never gets a slot
+    CHECK(graph.GetPassCount() == 6);
+    CHECK((graph.GetSchedule() == std::vector<GLuint>{0, 1, 3, 4, 5}));
+    CHECK(graph.GetSlot(unused) == -1);
+
+    // a and b are both used by the second pass, c comes after the last use of a
+    CHECK(graph.GetSlot(a) == 0);
+    CHECK(graph.GetSlot(b) == 1);
+    CHECK(graph.GetSlot(c) == 0);
+    CHECK(graph.GetSlotCount(FrameBufferType::HighDynamicRangeLighting) == 2);
+
+    // another size is another pool
+    CHECK(graph.GetSlot(half) == 0);
+    CHECK(graph.GetSlotCount(FrameBufferType::HighDynamicRangeLighting, 1) == 1);
+
+    // imported targets are not the graph's to alias
+    CHECK(graph.GetSlot(scene) == -1);
+    CHECK(graph.GetSlot(screen) == -1);
+}
+
+// every effect, with and without the compute convolutions and at every ssao tier, schedules all its passes and ends on the screen
+static void TestEveryEffect()
+{
+    CRenderGraph graph;
+    std::vector<PostProcessingPass> passes;
+    for (GLint compute = 0; compute < 2; compute++) {
+        for (GLint i = 0; i < static_cast<GLint>(PostProcessingEffectMode::NumberOfPPFX); i++) {
+            const PostProcessingEffectMode mode = static_cast<PostProcessingEffectMode>(i);
+            const GLint tiers = mode == PostProcessingEffectMode::SSAO ? static_cast<GLint>(SSAOQuality::NumberOfTiers) : 1;
+            for (GLint tier = 0; tier < tiers; tier++) {
+                PostProcessingGraphSettings settings = DefaultSettings();
+                settings.compute = compute == 1;
+                settings.ssaoQuality = static_cast<SSAOQuality>(tier);
+
+                const bool declared = DeclareEffect(graph, settings, mode, passes);
+                CHECK(declared);
+                CHECK(graph.Validate());
+                if (!declared || passes.empty()) {
+                    printf("  %s, tier %d, compute %d\n", PostProcessingEffectModeToString(mode), tier, compute);
+                    continue;
+                }
+
+                // the passes are all on the way to the screen and the last one writes it
+                CHECK(passes.size() == graph.GetPassCount());
+                CHECK(graph.GetSchedule().size() == graph.GetPassCount());
+                const PostProcessingPass &last = passes[graph.GetSchedule().back()];
+                CHECK(last.writes.size() == 1 && last.writes[0] == 1);
+                CHECK(graph.GetType(0) == CPostProcessingGraph::GetSceneType(mode));
+                for (const PostProcessingPass &pass : passes) CHECK(pass.mode == mode);
+            }
+        }
+    }
+}
+
+// the passes and targets of the effects that take more than one pass
+static void TestEffectPasses()
+{
+    CRenderGraph graph;
+    std::vector<PostProcessingPass> passes;
+    PostProcessingGraphSettings settings = DefaultSettings();
+
+    // six levels down and five back up, each level in a pool of its own
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::GaussianBlur, passes));
+    CHECK(passes.size() == 12);
+    CHECK(passes[0].type == PostProcessingPassType::PyramidDownsample && passes[0].reads[0] == 0);
+    CHECK(passes[6].type == PostProcessingPassType::PyramidUpsample && passes[6].index == 5);
+    CHECK(passes[11].type == PostProcessingPassType::GaussianBlurComposite);
+    for (GLuint level = 1; level <= settings.pyramidLevels; level++)
+        CHECK(graph.GetSlotCount(FrameBufferType::HighDynamicRangeLighting, level) == 1);
+
+    // bloom and lens flare start the chain from the bright parts of the scene
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::Bloom, passes));
+    CHECK(passes[0].sourceIndex == 1 && passes[1].sourceIndex == 0);
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::LensFlare, passes));
+    CHECK(passes.size() == 13);
+
+    // separable convolutions take a pass per direction, the second pass writes the filtered result
+    settings.compute = true;
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::KernelBlur, passes));
+    CHECK(passes.size() == 3);
+    CHECK(passes[0].direction == glm::vec2(1.0f, 0.0f) && !passes[0].last);
+    CHECK(passes[1].direction == glm::vec2(0.0f, 1.0f) && passes[1].last);
+    CHECK(passes[2].type == PostProcessingPassType::ConvolutionPresent);
+    CHECK(graph.GetSlotCount(FrameBufferType::HighDynamicRangeLighting) == 2);
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::SobelEdgeDetection, passes));
+    CHECK(passes.size() == 2 && passes[0].last);
+
+    // without the compute path a convolution is one pass like any other effect
+    settings.compute = false;
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::KernelBlur, passes));
+    CHECK(passes.size() == 1 && passes[0].type == PostProcessingPassType::Effect);
+
+    // the shadow effects render over the scene and composite it
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::DirectionalShadowMapping, passes));
+    CHECK(passes.size() == 3);
+    CHECK(passes[0].type == PostProcessingPassType::LightSpaceDepth);
+    CHECK(passes[2].type == PostProcessingPassType::SceneComposite);
+    CHECK(graph.GetSlotCount(FrameBufferType::DirectionalShadowMapping) == 1);
+}
+
+// the ssao tiers, the occlusion ends up at the window size whatever the size it was taken at
+static void TestOcclusionTiers()
+{
+    CRenderGraph graph;
+    std::vector<PostProcessingPass> passes;
+    PostProcessingGraphSettings settings = DefaultSettings();
+
+    settings.ssaoQuality = SSAOQuality::Full;
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::SSAO, passes));
+    CHECK(passes.size() == 3);
+    CHECK(passes[0].type == PostProcessingPassType::Occlusion && passes[0].samples == 64 && passes[0].level == 0);
+    CHECK(passes[1].type == PostProcessingPassType::OcclusionBlur);
+    CHECK(passes[2].type == PostProcessingPassType::OcclusionLighting);
+    CHECK(graph.GetSlotCount(FrameBufferType::SSAO) == 2);
+
+    settings.ssaoQuality = SSAOQuality::Half;
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::SSAO, passes));
+    CHECK(passes.size() == 5);
+    CHECK(passes[0].type == PostProcessingPassType::OcclusionDownsample && passes[0].level == 1);
+    CHECK(passes[1].samples == 32 && !passes[1].temporal);
+    CHECK(passes[2].type == PostProcessingPassType::OcclusionBlur);
+    CHECK(passes[3].type == PostProcessingPassType::OcclusionUpsample);
+    CHECK(graph.GetSlotCount(FrameBufferType::SSAO, 1) == 2);
+    CHECK(graph.GetSlotCount(FrameBufferType::GeometryBuffer, 1) == 1);
+    CHECK(graph.GetSlotCount(FrameBufferType::SSAO) == 1);
+
+    // the temporal tiers blend into a history that is not the graph's
+    settings.ssaoQuality = SSAOQuality::QuarterTemporal;
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::SSAO, passes));
+    CHECK(passes.size() == 5);
+    CHECK(passes[1].samples == 8 && passes[1].temporal && passes[1].level == 2);
+    CHECK(passes[2].type == PostProcessingPassType::OcclusionTemporal);
+    CHECK(graph.IsImported(passes[2].writes[0]));
+    CHECK(graph.GetSlotCount(FrameBufferType::SSAO, 2) == 1);
+}
+
+// a stack split twice, fused runs on both sides of an effect that reads neighbouring texels
+static void TestStack()
+{
+    CRenderGraph graph;
+    std::vector<PostProcessingPass> passes;
+    PostProcessingGraphSettings settings = DefaultSettings();
+    settings.stack = {PostProcessingEffectMode::GrayScale, PostProcessingEffectMode::Posterization, PostProcessingEffectMode::Kernel,
+        PostProcessingEffectMode::Vignetting, PostProcessingEffectMode::BayerMatrixDithering, PostProcessingEffectMode::Swirl};
+
+    CHECK(CPostProcessingGraph::GetStackRuns(settings.stack).size() == 4);
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::Vignetting, passes));
+    CHECK(graph.Validate());
+    CHECK(graph.GetSchedule().size() == 4);
+    CHECK(passes[0].type == PostProcessingPassType::Stack && passes[0].first && passes[0].effects.size() == 2);
+    CHECK(passes[1].effects == std::vector<PostProcessingEffectMode>{PostProcessingEffectMode::Kernel});
+    CHECK(passes[2].effects.size() == 2);
+    CHECK(passes[3].last && passes[3].writes[0] == 1);
+
+    // three targets between the four passes, only two are alive at once
+    CHECK(graph.GetSlotCount(FrameBufferType::Default) == 2);
+
+    // the stack takes the place of any effect that could be part of it, and leaves the others alone
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::Swirl, passes));
+    CHECK(passes.size() == 4);
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::Bloom, passes));
+    CHECK(passes.back().type == PostProcessingPassType::Bloom);
+
+    // a pointwise stack is one pass
+    settings.stack = {PostProcessingEffectMode::ColorInversion, PostProcessingEffectMode::GrayScale};
+    CHECK(DeclareEffect(graph, settings, PostProcessingEffectMode::GrayScale, passes));
+    CHECK(passes.size() == 1 && passes[0].first && passes[0].last);
+}
+
+// the programs of the scheduled passes of an effect, in the order they first render, as Game::GetPPFXPrograms collects them
+static std::vector<GLuint> EffectPrograms(const PostProcessingGraphSettings &settings, const PostProcessingEffectMode &mode)
+{
+    CRenderGraph graph;
+    std::vector<PostProcessingPass> passes;
+    DeclareEffect(graph, settings, mode, passes);
+
+    std::vector<GLuint> programs;
+    for (GLuint pass : graph.GetSchedule()) {
+        for (GLuint program : passes[pass].programs) {
+            if (std::find(programs.begin(), programs.end(), program) == programs.end()) programs.push_back(program);
+        }
+    }
+    return programs;
+}
+
+// the programs an effect needs come from the passes it declares
+static void TestPrograms()
+{
+    PostProcessingGraphSettings settings = DefaultSettings();
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::PBR) == std::vector<GLuint>{15}));
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::Pixelate) == std::vector<GLuint>{64}));
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::GaussianBlur) == std::vector<GLuint>{87, 88, 41}));
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::LensFlare) == std::vector<GLuint>{87, 88, 48, 49}));
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::MotionBlur) == std::vector<GLuint>{4, 44}));
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::DirectionalShadowMapping) == std::vector<GLuint>{51, 84, 15}));
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::DeferredRendering) == std::vector<GLuint>{55, 4}));
+
+    settings.ssaoQuality = SSAOQuality::Full;
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::SSAO) == std::vector<GLuint>{56, 57, 58}));
+    settings.ssaoQuality = SSAOQuality::Half;
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::SSAO) == std::vector<GLuint>{90, 56, 57, 92, 58}));
+    settings.ssaoQuality = SSAOQuality::HalfTemporal;
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::SSAO) == std::vector<GLuint>{90, 56, 91, 92, 58}));
+
+    // the compute path replaces the fragment program of a convolution
+    settings.compute = true;
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::KernelBlur) == std::vector<GLuint>{89}));
+    settings.compute = false;
+
+    // a fused run generates its program, an effect the stack renders alone needs its own
+    settings.stack = {PostProcessingEffectMode::GrayScale, PostProcessingEffectMode::Posterization, PostProcessingEffectMode::Kernel};
+    CHECK((EffectPrograms(settings, PostProcessingEffectMode::GrayScale) == std::vector<GLuint>{18}));
+
+    // every pass that renders declares what it renders with
+    settings = DefaultSettings();
+    for (GLint i = 0; i < static_cast<GLint>(PostProcessingEffectMode::NumberOfPPFX); i++) {
+        CRenderGraph graph;
+        std::vector<PostProcessingPass> passes;
+        DeclareEffect(graph, settings, static_cast<PostProcessingEffectMode>(i), passes);
+        for (const PostProcessingPass &pass : passes) CHECK(!pass.programs.empty());
+    }
+}
+
+void RenderGraphTests()
+{
+    TestAliasing();
+    TestEveryEffect();
+    TestEffectPasses();
+    TestOcclusionTiers();
+    TestStack();
+    TestPrograms();
+}
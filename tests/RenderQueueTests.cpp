@@ -0,0 +1,166 @@
+//
+//  RenderQueueTests.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "Tests.h"
+#include "utilities/Extensions.h"
+
+// the fields of a key come back as they were packed, in either layer, and values past a field keep their low bits
+static void TestKeys()
+{
+    const GLuint64 opaque = CRenderQueue::OpaqueKey(5, 300, 4000, 0.25f);
+    CHECK(CRenderQueue::GetLayer(opaque) == RenderLayer::Opaque);
+    CHECK(CRenderQueue::GetProgram(opaque) == 5);
+    CHECK(CRenderQueue::GetMaterial(opaque) == 300);
+    CHECK(CRenderQueue::GetMesh(opaque) == 4000);
+
+    const GLuint64 transparent = CRenderQueue::TransparentKey(0.75f, 82, 17, 4095);
+    CHECK(CRenderQueue::GetLayer(transparent) == RenderLayer::Transparent);
+    CHECK(CRenderQueue::GetProgram(transparent) == 82);
+    CHECK(CRenderQueue::GetMaterial(transparent) == 17);
+    CHECK(CRenderQueue::GetMesh(transparent) == 4095);
+
+    // the largest program of a key, one more wraps around to 0
+    const GLuint programs = CRenderQueue::GetProgramCount();
+    CHECK(programs == 1024);
+    CHECK(CRenderQueue::GetProgram(CRenderQueue::OpaqueKey(programs - 1, 0, 0, 0.0f)) == programs - 1);
+    CHECK(CRenderQueue::GetProgram(CRenderQueue::OpaqueKey(programs, 0, 0, 0.0f)) == 0);
+
+    // depth only moves the key within its fields, clamped between 0 and 1
+    CHECK(CRenderQueue::OpaqueKey(1, 2, 3, 0.1f) < CRenderQueue::OpaqueKey(1, 2, 3, 0.2f));
+    CHECK(CRenderQueue::OpaqueKey(1, 2, 3, -1.0f) == CRenderQueue::OpaqueKey(1, 2, 3, 0.0f));
+    CHECK(CRenderQueue::OpaqueKey(1, 2, 3, 2.0f) == CRenderQueue::OpaqueKey(1, 2, 3, 1.0f));
+
+    // the furthest depth stays in its field
+    const GLuint64 furthestOpaque = CRenderQueue::OpaqueKey(1, 2, 2, 1.0f);
+    CHECK(CRenderQueue::GetLayer(furthestOpaque) == RenderLayer::Opaque && CRenderQueue::GetMesh(furthestOpaque) == 2);
+    const GLuint64 furthest = CRenderQueue::TransparentKey(1.0f, 1, 2, 2);
+    CHECK(CRenderQueue::GetLayer(furthest) == RenderLayer::Transparent);
+    CHECK(CRenderQueue::GetProgram(furthest) == 1 && CRenderQueue::GetMaterial(furthest) == 2 && CRenderQueue::GetMesh(furthest) == 2);
+    CHECK(furthest < CRenderQueue::TransparentKey(0.99f, 1, 2, 2));
+}
+
+// the sorted keys agree with a stable sort of the pushed ones, equal keys keep the order they were pushed in
+static void TestStableSort()
+{
+    std::mt19937 random(11);
+    std::uniform_int_distribution<GLuint> small(0, 3);
+    std::uniform_int_distribution<GLuint> depth(0, 2);
+
+    CRenderQueue queue;
+    std::vector<std::pair<GLuint64, GLuint>> expected;
+    for (GLuint i = 0; i < 2000; ++i) {
+        const GLfloat d = depth(random) * 0.5f;
+        const GLuint64 key = small(random) == 0 ? CRenderQueue::TransparentKey(d, small(random), small(random), small(random))
+                                                : CRenderQueue::OpaqueKey(small(random), small(random), small(random), d);
+        queue.Push(key, i);
+        expected.push_back(std::make_pair(key, i));
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const std::pair<GLuint64, GLuint> &a, const std::pair<GLuint64, GLuint> &b) { return a.first < b.first; });
+
+    queue.Sort();
+    CHECK(queue.GetCount() == expected.size());
+    GLuint mismatches = 0;
+    for (GLuint i = 0; i < queue.GetCount(); ++i) {
+        if (queue.GetKey(i) != expected[i].first || queue.GetItem(i) != expected[i].second) mismatches++;
+    }
+    CHECK(mismatches == 0);
+
+    // every key the same skips every pass and leaves the entries where they were
+    queue.Clear();
+    for (GLuint i = 0; i < 5; ++i) queue.Push(CRenderQueue::OpaqueKey(1, 1, 1, 0.5f), i);
+    queue.Sort();
+    for (GLuint i = 0; i < 5; ++i) CHECK(queue.GetItem(i) == i);
+
+    // nothing and a single entry are sorted already
+    queue.Clear();
+    queue.Sort();
+    CHECK(queue.GetCount() == 0);
+    queue.Push(CRenderQueue::OpaqueKey(1, 1, 1, 0.5f), 9);
+    queue.Sort();
+    CHECK(queue.GetCount() == 1 && queue.GetItem(0) == 9);
+}
+
+// opaque draws come first, grouped by program, then material, then mesh, and transparent ones back to front
+static void TestOrder()
+{
+    CRenderQueue queue;
+    queue.Push(CRenderQueue::TransparentKey(0.2f, 1, 1, 1), 0);
+    queue.Push(CRenderQueue::OpaqueKey(2, 1, 1, 0.1f), 1);
+    queue.Push(CRenderQueue::TransparentKey(0.9f, 1, 1, 1), 2);
+    queue.Push(CRenderQueue::OpaqueKey(1, 2, 1, 0.1f), 3);
+    queue.Push(CRenderQueue::OpaqueKey(1, 1, 2, 0.1f), 4);
+    queue.Push(CRenderQueue::TransparentKey(0.5f, 0, 0, 0), 5);
+    queue.Push(CRenderQueue::OpaqueKey(1, 1, 1, 0.9f), 6);
+    queue.Push(CRenderQueue::OpaqueKey(1, 1, 1, 0.3f), 7);
+    queue.Sort();
+
+    // depth only breaks the ties of the same program, material and mesh, a transparent program does not reorder
+    const GLuint order[] = {7, 6, 4, 3, 1, 2, 5, 0};
+    CHECK(queue.GetCount() == 8);
+    for (GLuint i = 0; i < 8; ++i) CHECK(queue.GetItem(i) == order[i]);
+}
+
+// the first draw changes everything, after it only the fields that differ from the draw before are counted
+static void TestStateChanges()
+{
+    CRenderQueue queue;
+    queue.Push(CRenderQueue::OpaqueKey(2, 2, 1, 0.5f), 0);
+    queue.Push(CRenderQueue::OpaqueKey(1, 2, 1, 0.5f), 1);
+    queue.Push(CRenderQueue::OpaqueKey(1, 1, 2, 0.5f), 2);
+    queue.Push(CRenderQueue::OpaqueKey(1, 1, 1, 0.5f), 3);
+    queue.Push(CRenderQueue::OpaqueKey(1, 1, 1, 0.7f), 4);
+    queue.Sort();
+
+    // sorted: 1 1 1, 1 1 1, 1 1 2, 1 2 1, 2 2 1
+    queue.BeginFrame();
+    CHECK(queue.GetProgramChanges() == 2);
+    CHECK(queue.GetMaterialChanges() == 2);
+    CHECK(queue.GetMeshChanges() == 3);
+
+    // the sorts of a frame add up, and a frame without any reports nothing
+    queue.Sort();
+    queue.Sort();
+    queue.BeginFrame();
+    CHECK(queue.GetProgramChanges() == 4);
+    CHECK(queue.GetMaterialChanges() == 4);
+    CHECK(queue.GetMeshChanges() == 6);
+    queue.BeginFrame();
+    CHECK(queue.GetProgramChanges() == 0 && queue.GetMaterialChanges() == 0 && queue.GetMeshChanges() == 0);
+}
+
+// furthest first, and positions as far from the camera as each other are all kept, in the order they were given
+static void TestSortByDistance()
+{
+    glm::vec3 camera(0.0f, 1.0f, 0.0f);
+    std::vector<glm::vec3> positions = {
+        glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 5.0f), glm::vec3(0.0f, 2.0f, 0.0f),
+        glm::vec3(0.0f, 1.0f, -3.0f), glm::vec3(-1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 5.0f),
+    };
+
+    std::vector<glm::vec3> sorted = Extensions::sortByNearestToCameraFirst(positions, camera);
+    const glm::vec3 expected[] = {
+        glm::vec3(0.0f, 1.0f, 5.0f), glm::vec3(0.0f, 1.0f, 5.0f), glm::vec3(0.0f, 1.0f, -3.0f),
+        glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(-1.0f, 1.0f, 0.0f),
+    };
+    CHECK(sorted.size() == positions.size());
+    for (GLuint i = 0; i < sorted.size(); ++i) CHECK(sorted[i] == expected[i]);
+
+    // everything on the camera is at distance 0
+    std::vector<glm::vec3> onCamera = {camera, camera};
+    CHECK(Extensions::sortByNearestToCameraFirst(onCamera, camera).size() == 2);
+}
+
+void RenderQueueTests()
+{
+    TestKeys();
+    TestStableSort();
+    TestOrder();
+    TestStateChanges();
+    TestSortByDistance();
+}
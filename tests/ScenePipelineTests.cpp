@@ -0,0 +1,120 @@
+//
+//  ScenePipelineTests.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "Tests.h"
+#include "scene/ScenePipeline.h"
+
+// fills a frame with its own index and says where and with what it was simulated, slowly enough that the GL
+// thread would catch the worker in the middle of a frame if they ever shared one
+struct TestSimulation {
+    std::mutex mutex;
+    std::vector<std::thread::id> threads;
+    std::vector<GLuint> indices;
+
+    void Simulate(SceneFrame &frame)
+    {
+        frame.groundHeights.assign(4096, 0.0f);
+        for (GLfloat &height : frame.groundHeights) {
+            height = static_cast<GLfloat>(frame.index);
+        }
+        frame.transforms = frame.index;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.push_back(std::this_thread::get_id());
+        indices.push_back(frame.index);
+    }
+};
+
+// every value of the frame is the one its simulation wrote
+static bool IsWhole(const SceneFrame &frame)
+{
+    if (frame.groundHeights.size() != 4096 || frame.transforms != frame.index) return false;
+    for (GLfloat height : frame.groundHeights) {
+        if (height != static_cast<GLfloat>(frame.index)) return false;
+    }
+    return true;
+}
+
+// without the worker a frame is simulated on the calling thread with the inputs it is asked with
+static void TestSerial()
+{
+    TestSimulation simulation;
+    CScenePipeline pipeline;
+    pipeline.Create([&simulation](SceneFrame &frame) { simulation.Simulate(frame); });
+    CHECK(!pipeline.IsRunning());
+
+    for (GLuint i = 1; i <= 3; ++i) {
+        const SceneFrame &frame = pipeline.Acquire(static_cast<GLfloat>(i), i % 2 == 0);
+        CHECK(frame.index == i);
+        CHECK(frame.deltaTime == static_cast<GLfloat>(i));
+        CHECK(frame.onHeightMap == (i % 2 == 0));
+        CHECK(IsWhole(frame));
+        pipeline.EndFrame();
+    }
+    CHECK(simulation.indices.size() == 3);
+    for (std::thread::id thread : simulation.threads) CHECK(thread == std::this_thread::get_id());
+
+    // the first frame of a mode is not counted
+    CHECK(pipeline.GetStats(false).frames == 2);
+    CHECK(pipeline.GetStats(true).frames == 0);
+}
+
+// with the worker the frame handed out was simulated with the inputs of the call before, on the worker, and is
+// whole while the worker writes the next one
+static void TestPipelined()
+{
+    TestSimulation simulation;
+    CScenePipeline pipeline;
+    pipeline.Create([&simulation](SceneFrame &frame) { simulation.Simulate(frame); });
+    pipeline.Start();
+    CHECK(pipeline.IsRunning());
+
+    // the first frame is made by the calling thread, there is nothing to wait for yet
+    const SceneFrame &first = pipeline.Acquire(1.0f, false);
+    CHECK(first.index == 1 && first.deltaTime == 1.0f);
+    CHECK(IsWhole(first));
+    pipeline.EndFrame();
+
+    GLuint incomplete = 0;
+    for (GLuint i = 2; i <= 20; ++i) {
+        const SceneFrame &frame = pipeline.Acquire(static_cast<GLfloat>(i), false);
+        CHECK(frame.index == i);
+        CHECK(frame.deltaTime == static_cast<GLfloat>(i - 1));
+        // the worker is busy with frame i + 1 meanwhile
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        if (!IsWhole(frame)) incomplete++;
+        pipeline.EndFrame();
+    }
+    CHECK(incomplete == 0);
+    CHECK(pipeline.GetStats(true).frames == 19);
+
+    // frame 21 is kept when the worker had begun it before it stopped and dropped otherwise, the next one is
+    // made on this thread again
+    pipeline.Stop();
+    CHECK(!pipeline.IsRunning());
+    const SceneFrame &last = pipeline.Acquire(30.0f, false);
+    CHECK(last.index == 22 && last.deltaTime == 30.0f);
+    CHECK(IsWhole(last));
+
+    std::lock_guard<std::mutex> lock(simulation.mutex);
+    GLuint onWorker = 0;
+    for (GLuint i = 0; i < simulation.indices.size(); ++i) {
+        const GLuint index = simulation.indices[i];
+        if (simulation.threads[i] != std::this_thread::get_id()) onWorker++;
+        else CHECK(index == 1 || index == 22);
+    }
+    CHECK(simulation.indices.size() == 21 || simulation.indices.size() == 22);
+    CHECK(onWorker == simulation.indices.size() - 2);
+}
+
+void ScenePipelineTests()
+{
+    TestSerial();
+    TestPipelined();
+}
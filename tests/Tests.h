@@ -0,0 +1,37 @@
+//
+//  Tests.h
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#pragma once
+
+#ifndef Tests_h
+#define Tests_h
+
+#include <stdio.h>
+
+// checks that failed in the suites run so far
+extern int g_testFailures;
+
+// a failed check prints where it is and the suite carries on
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_testFailures++; \
+        } \
+    } while (0)
+
+// the suites, one per file
+void RenderGraphTests();
+void FrustumTests();
+void OcclusionTests();
+void TransformHierarchyTests();
+void ScenePipelineTests();
+void RenderQueueTests();
+void RangeAllocatorTests();
+
+#endif /* Tests_h */
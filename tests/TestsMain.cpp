@@ -0,0 +1,48 @@
+//
+//  TestsMain.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "Tests.h"
+#include <string.h>
+
+int g_testFailures = 0;
+
+struct TestSuite {
+    const char *name;
+    void (*run)();
+};
+
+static const TestSuite suites[] = {
+    {"RenderGraph", RenderGraphTests},
+    {"Frustum", FrustumTests},
+    {"Occlusion", OcclusionTests},
+    {"TransformHierarchy", TransformHierarchyTests},
+    {"ScenePipeline", ScenePipelineTests},
+    {"RenderQueue", RenderQueueTests},
+    {"RangeAllocator", RangeAllocatorTests},
+};
+
+// runs the suite named on the command line, or all of them, and fails when a check did
+int main(int argc, char **argv)
+{
+    const char *name = argc > 1 ? argv[1] : nullptr;
+    bool found = false;
+    for (const TestSuite &suite : suites) {
+        if (name != nullptr && strcmp(name, suite.name) != 0) continue;
+        found = true;
+
+        const int failures = g_testFailures;
+        suite.run();
+        printf("%s: %s\n", suite.name, g_testFailures == failures ? "passed" : "FAILED");
+    }
+
+    if (!found) {
+        printf("No test suite named %s\n", name);
+        return 1;
+    }
+    return g_testFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+//
+//  TransformHierarchyTests.cpp
+//  ComputerGraphicsWithOpenGL
+//
+//  Created by GEORGE QUENTIN on 18/10/2026.
+//  Copyright © 2019 GEORGE QUENTIN. All rights reserved.
+//
+
+#include "Tests.h"
+#include "utilities/TransformHierarchy.h"
+
+// T * Rx * Ry * Rz * S the way the Transform of the objects builds it, rotations in degrees
+static glm::mat4 GetLocal(const glm::vec3 &position, const glm::vec3 &rotation, const glm::vec3 &scale)
+{
+    glm::mat4 local = glm::translate(glm::mat4(1.0f), position);
+    local = glm::rotate(local, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    local = glm::rotate(local, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    local = glm::rotate(local, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    return glm::scale(local, scale);
+}
+
+static bool IsNear(const glm::mat4 &a, const glm::mat4 &b)
+{
+    for (GLuint c = 0; c < 4; ++c)
+        for (GLuint r = 0; r < 4; ++r)
+            if (std::abs(a[c][r] - b[c][r]) > 1e-4f * std::max(1.0f, std::abs(b[c][r]))) return false;
+    return true;
+}
+
+static bool IsNear(const glm::mat3 &a, const glm::mat3 &b)
+{
+    return IsNear(glm::mat4(a), glm::mat4(b));
+}
+
+// a root, a child of it and a grandchild, each with its own rotation and a scale that is not uniform
+static void TestMatrices()
+{
+    const glm::vec3 positions[3] = {glm::vec3(10.0f, -2.0f, 5.0f), glm::vec3(0.0f, 3.0f, -1.0f), glm::vec3(-4.0f, 0.5f, 2.0f)};
+    const glm::vec3 rotations[3] = {glm::vec3(30.0f, 45.0f, 60.0f), glm::vec3(-20.0f, 110.0f, 5.0f), glm::vec3(0.0f, 0.0f, 90.0f)};
+    const glm::vec3 scales[3] = {glm::vec3(2.0f, 1.0f, 0.5f), glm::vec3(1.0f), glm::vec3(0.25f, 3.0f, 1.5f)};
+
+    CTransformHierarchy hierarchy;
+    const GLuint root = hierarchy.Add();
+    const GLuint child = hierarchy.Add(static_cast<GLint>(root));
+    const GLuint grandchild = hierarchy.Add(static_cast<GLint>(child));
+    CHECK(hierarchy.GetSize() == 3);
+    CHECK(hierarchy.GetParent(root) == -1 && hierarchy.GetParent(child) == 0 && hierarchy.GetParent(grandchild) == 1);
+
+    for (GLuint i = 0; i < 3; ++i) hierarchy.SetLocal(i, positions[i], rotations[i], scales[i]);
+    hierarchy.Update();
+
+    glm::mat4 world(1.0f);
+    for (GLuint i = 0; i < 3; ++i) {
+        world = world * GetLocal(positions[i], rotations[i], scales[i]);
+        CHECK(IsNear(hierarchy.GetWorld(i), world));
+        CHECK(IsNear(hierarchy.GetNormal(i), glm::transpose(glm::inverse(glm::mat3(world)))));
+    }
+
+    // a parent added after the node is not a parent, the node is a root
+    const GLuint orphan = hierarchy.Add(7);
+    CHECK(hierarchy.GetParent(orphan) == -1);
+}
+
+// only the nodes that changed and the ones below them are recomputed
+static void TestDirtyNodes()
+{
+    CTransformHierarchy hierarchy;
+    const GLuint root = hierarchy.Add();
+    const GLuint child = hierarchy.Add(static_cast<GLint>(root));
+    hierarchy.Add(static_cast<GLint>(child));
+    const GLuint other = hierarchy.Add();
+
+    // new nodes start dirty, then nothing changed
+    CHECK(hierarchy.Update() == 4);
+    CHECK(hierarchy.Update() == 0);
+
+    // the values a node has already leave it clean
+    hierarchy.SetLocal(root, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+    CHECK(hierarchy.Update() == 0);
+
+    // a leaf moves alone, a parent takes its children with it
+    hierarchy.SetLocal(other, glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+    CHECK(hierarchy.Update() == 1);
+    hierarchy.SetLocal(child, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+    CHECK(hierarchy.Update() == 2);
+    hierarchy.SetLocal(root, glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 45.0f, 0.0f), glm::vec3(1.0f));
+    CHECK(hierarchy.Update() == 3);
+
+    // the grandchild followed both moves
+    CHECK(IsNear(hierarchy.GetWorld(2),
+                 GetLocal(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 45.0f, 0.0f), glm::vec3(1.0f)) *
+                 GetLocal(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f))));
+
+    hierarchy.Clear();
+    CHECK(hierarchy.GetSize() == 0);
+    CHECK(hierarchy.Update() == 0);
+}
+
+void TransformHierarchyTests()
+{
+    TestMatrices();
+    TestDirtyNodes();
+}